@@ -1,6 +1,7 @@
 #include "donner/base/BezierUtils.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <limits>
 
@@ -300,4 +301,124 @@ Box2d CubicBounds(const Vector2d& p0, const Vector2d& p1, const Vector2d& p2, co
   return box;
 }
 
+void CubicFlattenSegmentCounts(std::span<const std::array<Vector2d, 4>> cubics, double tolerance,
+                               std::uint32_t maximumSegments, std::span<std::uint32_t> outCounts) {
+  assert(outCounts.size() == cubics.size());
+  constexpr std::size_t W = kBezierBatchWidth;
+  // Written so that NaN also takes the minimum.
+  const double clampedTolerance =
+      tolerance >= kMinimumFlattenTolerance ? tolerance : kMinimumFlattenTolerance;
+  const double scale = 0.75 / clampedTolerance;
+
+  for (std::size_t base = 0; base < cubics.size(); base += W) {
+    const std::size_t lanes = std::min(W, cubics.size() - base);
+
+    // Gather the second differences into lanes, zero-padding the tail batch.
+    double ax[W] = {}, ay[W] = {}, bx[W] = {}, by[W] = {};
+    for (std::size_t l = 0; l < lanes; ++l) {
+      const std::array<Vector2d, 4>& c = cubics[base + l];
+      ax[l] = c[0].x - 2.0 * c[1].x + c[2].x;
+      ay[l] = c[0].y - 2.0 * c[1].y + c[2].y;
+      bx[l] = c[1].x - 2.0 * c[2].x + c[3].x;
+      by[l] = c[1].y - 2.0 * c[2].y + c[3].y;
+    }
+
+    double segments[W];
+    for (std::size_t l = 0; l < W; ++l) {
+      const double m2 = std::max(ax[l] * ax[l] + ay[l] * ay[l], bx[l] * bx[l] + by[l] * by[l]);
+      segments[l] = std::ceil(std::sqrt(std::sqrt(m2) * scale));
+    }
+
+    for (std::size_t l = 0; l < lanes; ++l) {
+      // NaN fails both comparisons and lands on the maximum.
+      const double n = segments[l];
+      if (n <= 1.0) {
+        outCounts[base + l] = 1;
+      } else if (n <= static_cast<double>(maximumSegments)) {
+        outCounts[base + l] = static_cast<std::uint32_t>(n);
+      } else {
+        outCounts[base + l] = maximumSegments;
+      }
+    }
+  }
+}
+
+void FlattenCubicsUniform(std::span<const std::array<Vector2d, 4>> cubics,
+                          std::span<const std::uint32_t> counts, std::vector<Vector2d>& out) {
+  assert(counts.size() == cubics.size());
+  constexpr std::size_t W = kBezierBatchWidth;
+
+  std::size_t total = 0;
+  for (const std::uint32_t count : counts) {
+    total += count;
+  }
+  out.reserve(out.size() + total);
+
+  for (std::size_t base = 0; base < cubics.size(); base += W) {
+    const std::size_t lanes = std::min(W, cubics.size() - base);
+
+    // Power-basis coefficients B(t) = a t^3 + b t^2 + c t + p0, per lane.
+    double p0x[W] = {}, p0y[W] = {}, p1x[W] = {}, p1y[W] = {};
+    double p2x[W] = {}, p2y[W] = {}, p3x[W] = {}, p3y[W] = {};
+    double h[W];
+    for (std::size_t l = 0; l < W; ++l) {
+      h[l] = 1.0;
+    }
+    for (std::size_t l = 0; l < lanes; ++l) {
+      const std::array<Vector2d, 4>& c = cubics[base + l];
+      p0x[l] = c[0].x;
+      p0y[l] = c[0].y;
+      p1x[l] = c[1].x;
+      p1y[l] = c[1].y;
+      p2x[l] = c[2].x;
+      p2y[l] = c[2].y;
+      p3x[l] = c[3].x;
+      p3y[l] = c[3].y;
+      h[l] = 1.0 / static_cast<double>(counts[base + l]);
+    }
+
+    // First, second and third forward differences at step h.
+    double dx[W], dy[W], ddx[W], ddy[W], dddx[W], dddy[W];
+    for (std::size_t l = 0; l < W; ++l) {
+      const double ax = -p0x[l] + 3.0 * (p1x[l] - p2x[l]) + p3x[l];
+      const double ay = -p0y[l] + 3.0 * (p1y[l] - p2y[l]) + p3y[l];
+      const double bx = 3.0 * (p0x[l] - 2.0 * p1x[l] + p2x[l]);
+      const double by = 3.0 * (p0y[l] - 2.0 * p1y[l] + p2y[l]);
+      const double cx = 3.0 * (p1x[l] - p0x[l]);
+      const double cy = 3.0 * (p1y[l] - p0y[l]);
+      const double h1 = h[l];
+      const double h2 = h1 * h1;
+      const double h3 = h2 * h1;
+      dx[l] = ax * h3 + bx * h2 + cx * h1;
+      dy[l] = ay * h3 + by * h2 + cy * h1;
+      ddx[l] = 6.0 * ax * h3 + 2.0 * bx * h2;
+      ddy[l] = 6.0 * ay * h3 + 2.0 * by * h2;
+      dddx[l] = 6.0 * ax * h3;
+      dddy[l] = 6.0 * ay * h3;
+    }
+
+    for (std::size_t l = 0; l < lanes; ++l) {
+      const std::uint32_t count = counts[base + l];
+      assert(count >= 1);
+      double x = p0x[l];
+      double y = p0y[l];
+      double stepX = dx[l];
+      double stepY = dy[l];
+      double accelX = ddx[l];
+      double accelY = ddy[l];
+      for (std::uint32_t k = 1; k < count; ++k) {
+        x += stepX;
+        y += stepY;
+        stepX += accelX;
+        stepY += accelY;
+        accelX += dddx[l];
+        accelY += dddy[l];
+        out.emplace_back(x, y);
+      }
+      // Emit the end point exactly rather than the accumulated value.
+      out.emplace_back(p3x[l], p3y[l]);
+    }
+  }
+}
+
 }  // namespace donner
@@ -3,6 +3,8 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -196,6 +198,52 @@ Box2d QuadraticBounds(const Vector2d& p0, const Vector2d& p1, const Vector2d& p2
  */
 Box2d CubicBounds(const Vector2d& p0, const Vector2d& p1, const Vector2d& p2, const Vector2d& p3);
 
+/// Number of curves the batched flattening kernels process together, one per vector lane.
+inline constexpr std::size_t kBezierBatchWidth = 4;
+
+/// Smallest tolerance \ref CubicFlattenSegmentCounts works with; smaller, non-positive and NaN
+/// tolerances are raised to it.
+inline constexpr double kMinimumFlattenTolerance = 1e-6;
+
+/**
+ * Compute how many uniform parameter steps each cubic in \p cubics needs so that the polyline
+ * through the evaluated points stays within \p tolerance of the curve, using Wang's formula:
+ *
+ * \f$ n = \left\lceil \sqrt{\frac{3}{4} \frac{\max(|p_0 - 2p_1 + p_2|, |p_1 - 2p_2 + p_3|)}
+ * {tolerance}} \right\rceil \f$
+ *
+ * Curves are processed \ref kBezierBatchWidth at a time in structure-of-arrays lanes, so the
+ * loop bodies vectorize. A quadratic elevated to a cubic gets the same count as the quadratic
+ * form of the formula.
+ *
+ * @param cubics Control points of each cubic, as (start, control1, control2, end).
+ * @param tolerance Maximum allowed distance between each curve and its polyline. Values below
+ *   \ref kMinimumFlattenTolerance, including zero, negative and NaN values, are clamped to it, so
+ *   a straight curve still gets a single segment.
+ * @param maximumSegments Upper bound for each count, also used for non-finite curves.
+ * @param[out] outCounts Segment count for each cubic, in [1, \p maximumSegments]. Must be the
+ *   same size as \p cubics.
+ */
+void CubicFlattenSegmentCounts(std::span<const std::array<Vector2d, 4>> cubics, double tolerance,
+                               std::uint32_t maximumSegments, std::span<std::uint32_t> outCounts);
+
+/**
+ * Flatten cubics by forward differencing at uniform parameter steps.
+ *
+ * For each cubic `i`, appends `counts[i]` points to \p out: the curve evaluated at
+ * `t = k / counts[i]` for `k = 1 .. counts[i]`. The start point is not appended, and the last
+ * point is exactly the end point. Per-curve difference coefficients are set up
+ * \ref kBezierBatchWidth curves at a time, after which each step costs three additions.
+ *
+ * @param cubics Control points of each cubic, as (start, control1, control2, end).
+ * @param counts Number of segments for each cubic, typically from
+ *   \ref CubicFlattenSegmentCounts. Must be the same size as \p cubics, with every count at least
+ *   1.
+ * @param[out] out Output vector to which the flattened points are appended.
+ */
+void FlattenCubicsUniform(std::span<const std::array<Vector2d, 4>> cubics,
+                          std::span<const std::uint32_t> counts, std::vector<Vector2d>& out);
+
 /** @} */
 
 }  // namespace donner
@@ -0,0 +1,176 @@
+#pragma once
+/// @file
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <span>
+#include <string_view>
+
+namespace donner {
+
+/**
+ * 128-bit digest of a byte sequence, used as the key for process-wide content-addressed caches
+ * (decoded images, font blobs, shared geometry) where two independently produced buffers must be
+ * recognized as identical without scanning every resident entry.
+ *
+ * The digest is two independently seeded 64-bit multiply-rotate lanes plus the input length. It
+ * is fast and well distributed, but it is **not** cryptographic: collisions can be constructed on
+ * purpose. A cache keyed on it that is shared across documents must therefore treat a digest match
+ * as a candidate only, and compare the candidate's content against the lookup's before using it.
+ *
+ * To hash a single buffer use \ref ContentHash::Of; to hash a value assembled from several
+ * buffers use \ref ContentHasher.
+ */
+struct ContentHash {
+  std::uint64_t high = 0;  //!< First 64-bit lane.
+  std::uint64_t low = 0;   //!< Second 64-bit lane.
+  std::uint64_t size = 0;  //!< Number of bytes hashed.
+
+  /// Hash a contiguous byte buffer.
+  static ContentHash Of(std::span<const std::uint8_t> bytes);
+
+  /// Hash the bytes of a string.
+  static ContentHash Of(std::string_view bytes) {
+    return Of(std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(bytes.data()),
+                                            bytes.size()));  // NOLINT: byte view.
+  }
+
+  /// Equality operator.
+  bool operator==(const ContentHash& other) const = default;
+
+  /// Ostream output operator, prints the digest as hex followed by the size.
+  friend std::ostream& operator<<(std::ostream& os, const ContentHash& hash) {
+    const std::ios_base::fmtflags flags = os.flags();
+    const char fill = os.fill();
+    os << "ContentHash(" << std::hex << std::setfill('0') << std::setw(16) << hash.high
+       << std::setw(16) << hash.low;
+    os.flags(flags);
+    os.fill(fill);
+    return os << ", " << hash.size << " bytes)";
+  }
+};
+
+/**
+ * Incremental builder for a \ref ContentHash. Feeding the same bytes in any chunking produces the
+ * same digest as \ref ContentHash::Of over the concatenation.
+ *
+ * ```cpp
+ * ContentHasher hasher;
+ * hasher.update(verbBytes);
+ * hasher.update(pointBytes);
+ * const ContentHash key = hasher.finish();
+ * ```
+ */
+class ContentHasher {
+public:
+  /// Construct an empty hasher.
+  ContentHasher() = default;
+
+  /// Append \p bytes to the hashed sequence.
+  void update(std::span<const std::uint8_t> bytes) {
+    size_ += bytes.size();
+
+    // Top up a partial word left over from the previous call first.
+    if (pendingSize_ != 0) {
+      while (pendingSize_ < kWordSize && !bytes.empty()) {
+        pending_[pendingSize_++] = bytes.front();
+        bytes = bytes.subspan(1);
+      }
+      if (pendingSize_ < kWordSize) {
+        return;
+      }
+      mixWord(LoadWord(pending_));
+      pendingSize_ = 0;
+    }
+
+    while (bytes.size() >= kWordSize) {
+      mixWord(LoadWord(bytes.data()));
+      bytes = bytes.subspan(kWordSize);
+    }
+
+    std::memcpy(pending_, bytes.data(), bytes.size());
+    pendingSize_ = bytes.size();
+  }
+
+  /// Append the object representation of a trivially copyable value.
+  template <typename T>
+  void updateValue(const T& value) {
+    update(std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(&value),
+                                         sizeof(T)));  // NOLINT: byte view.
+  }
+
+  /// Finish hashing and return the digest. The hasher must not be updated afterwards.
+  ContentHash finish() {
+    if (pendingSize_ != 0) {
+      std::uint8_t tail[kWordSize] = {};
+      std::memcpy(tail, pending_, pendingSize_);
+      // Tag the tail with its length so "ab" and "ab\0" do not collide.
+      tail[kWordSize - 1] ^= static_cast<std::uint8_t>(0x80u | pendingSize_);
+      mixWord(LoadWord(tail));
+      pendingSize_ = 0;
+    }
+
+    ContentHash result;
+    result.size = size_;
+    result.high = Finalize(high_ ^ size_);
+    result.low = Finalize(low_ + (size_ * kPrime2));
+    return result;
+  }
+
+private:
+  static constexpr std::size_t kWordSize = 8;
+  static constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+  static constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+  static constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ull;
+
+  static std::uint64_t LoadWord(const std::uint8_t* data) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, data, kWordSize);
+    return word;
+  }
+
+  static std::uint64_t Rotl(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  /// MurmurHash3's 64-bit finalizer.
+  static std::uint64_t Finalize(std::uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+  }
+
+  void mixWord(std::uint64_t word) {
+    high_ = Rotl(high_ ^ (word * kPrime2), 31) * kPrime1;
+    low_ = Rotl(low_ + (word * kPrime3), 27) * kPrime2 + kPrime1;
+  }
+
+  std::uint64_t high_ = 0x27D4EB2F165667C5ull;
+  std::uint64_t low_ = 0x85EBCA77C2B2AE63ull;
+  std::uint64_t size_ = 0;
+  std::uint8_t pending_[kWordSize] = {};
+  std::size_t pendingSize_ = 0;
+};
+
+inline ContentHash ContentHash::Of(std::span<const std::uint8_t> bytes) {
+  ContentHasher hasher;
+  hasher.update(bytes);
+  return hasher.finish();
+}
+
+}  // namespace donner
+
+/// Hash specialization so \ref donner::ContentHash can key unordered containers.
+template <>
+struct std::hash<donner::ContentHash> {
+  /// Hash function, the digest is already well mixed so one lane is sufficient.
+  std::size_t operator()(const donner::ContentHash& hash) const {
+    return static_cast<std::size_t>(hash.low);
+  }
+};
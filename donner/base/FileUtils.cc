@@ -10,6 +10,7 @@
 #include <windows.h>
 #else
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
@@ -146,6 +147,56 @@ FileReadResult ReadFileBounded(const std::filesystem::path& path, size_t maximum
   return ReadOpenedFile(path, maximumSize);
 }
 
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (mapped_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+#endif
+}
+
+FileMapResult MapFileBounded(const std::filesystem::path& path, size_t maximumSize) {
+  std::shared_ptr<MappedFile> file(new MappedFile());
+
+#ifndef _WIN32
+  FileDescriptor descriptor(open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK));
+  if (descriptor.get() < 0) {
+    return FileReadError::OpenFailed;
+  }
+
+  struct stat status{};
+  if (fstat(descriptor.get(), &status) != 0 || !S_ISREG(status.st_mode) || status.st_size < 0 ||
+      static_cast<std::uint64_t>(status.st_size) > std::numeric_limits<size_t>::max()) {
+    return FileReadError::OpenFailed;
+  }
+  const size_t size = static_cast<size_t>(status.st_size);
+  if (size > maximumSize) {
+    return FileReadError::TooLarge;
+  }
+
+  // Zero-length mappings are invalid; empty files take the owned-buffer path below.
+  if (size != 0) {
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor.get(), 0);
+    if (mapping == MAP_FAILED) {
+      return FileReadError::ReadFailed;
+    }
+    file->data_ = static_cast<const uint8_t*>(mapping);
+    file->size_ = size;
+    file->mapped_ = true;
+    return std::shared_ptr<const MappedFile>(std::move(file));
+  }
+#endif
+
+  FileReadResult contents = ReadOpenedFile(path, maximumSize);
+  if (const auto* error = std::get_if<FileReadError>(&contents)) {
+    return *error;
+  }
+  file->fallback_ = std::move(std::get<std::string>(contents));
+  file->data_ = reinterpret_cast<const uint8_t*>(file->fallback_.data());
+  file->size_ = file->fallback_.size();
+  return std::shared_ptr<const MappedFile>(std::move(file));
+}
+
 const char* FileReadErrorMessage(FileReadError error) {
   switch (error) {
     case FileReadError::OpenFailed: return "could not open regular file";
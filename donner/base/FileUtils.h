@@ -2,8 +2,12 @@
 /// @file
 
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <variant>
 
 namespace donner {
@@ -30,6 +34,62 @@ using FileReadResult = std::variant<std::string, FileReadError>;
  */
 FileReadResult ReadFileBounded(const std::filesystem::path& path, size_t maximumSize);
 
+/**
+ * Immutable contents of a regular file, memory-mapped read-only where the platform supports it so
+ * large inputs are paged in on demand and shared between processes instead of copied to the heap.
+ *
+ * On platforms without a mapping implementation, and for empty files, the contents are read into
+ * an owned buffer instead; \ref isMapped reports which. A mapping observes the file, so truncating
+ * it on disk while mapped may fault on access: only map files that are not rewritten in place,
+ * such as installed fonts.
+ */
+class MappedFile {
+public:
+  /// Destructor, unmaps the file.
+  ~MappedFile();
+
+  // No copy or move: views handed out by \ref bytes point into this object.
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// File contents.
+  std::span<const uint8_t> bytes() const { return {data_, size_}; }
+
+  /// File contents as characters.
+  std::string_view view() const { return {reinterpret_cast<const char*>(data_), size_}; }
+
+  /// Size in bytes.
+  size_t size() const { return size_; }
+
+  /// Returns true if the contents are backed by a file mapping rather than a heap copy.
+  bool isMapped() const { return mapped_; }
+
+private:
+  friend std::variant<std::shared_ptr<const MappedFile>, FileReadError> MapFileBounded(
+      const std::filesystem::path& path, size_t maximumSize);
+
+  MappedFile() = default;
+
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+  std::string fallback_;  //!< Owned contents when not mapped.
+};
+
+/// Mapped contents or failure from \ref MapFileBounded.
+using FileMapResult = std::variant<std::shared_ptr<const MappedFile>, FileReadError>;
+
+/**
+ * Map a regular file read-only without accepting more than \p maximumSize bytes.
+ *
+ * Applies the same checks as \ref ReadFileBounded: the opened object must be a regular file no
+ * larger than \p maximumSize.
+ *
+ * @param path File to map.
+ * @param maximumSize Maximum accepted byte count.
+ */
+FileMapResult MapFileBounded(const std::filesystem::path& path, size_t maximumSize);
+
 /// Human-readable description for \p error.
 const char* FileReadErrorMessage(FileReadError error);
 
@@ -1,7 +1,9 @@
 #include "donner/base/Path.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <optional>
 #include <span>
@@ -1604,53 +1606,13 @@ std::ostream& operator<<(std::ostream& os, const Path& path) {
 
 namespace {
 
-bool flattenQuadratic(PathBuilder& builder, const Vector2d& p0, const Vector2d& p1,
-                      const Vector2d& p2, double tolerance, int depth) {
-  if (builder.exceededMaximumPoints()) {
-    return false;
-  }
-  const Vector2d mid = (p0 + p2) * 0.5;
-  const double dist = (p1 - mid).length();
-
-  if (dist <= tolerance) {
-    builder.lineTo(p2);
-    return !builder.exceededMaximumPoints();
-  }
-  if (depth >= Path::kMaximumFlattenSubdivisionDepth) {
-    builder.lineTo(p2);
-    return !builder.exceededMaximumPoints();
-  }
-
-  auto [left, right] = SplitQuadratic(p0, p1, p2, 0.5);
-  if (!flattenQuadratic(builder, left[0], left[1], left[2], tolerance, depth + 1)) {
-    return false;
-  }
-  return flattenQuadratic(builder, right[0], right[1], right[2], tolerance, depth + 1);
-}
-
-bool flattenCubic(PathBuilder& builder, const Vector2d& p0, const Vector2d& p1, const Vector2d& p2,
-                  const Vector2d& p3, double tolerance, int depth) {
-  if (builder.exceededMaximumPoints()) {
-    return false;
-  }
-  const Vector2d d1 = p1 - (p0 * (2.0 / 3.0) + p3 * (1.0 / 3.0));
-  const Vector2d d2 = p2 - (p0 * (1.0 / 3.0) + p3 * (2.0 / 3.0));
-  const double dist = std::max(d1.length(), d2.length());
-
-  if (dist <= tolerance) {
-    builder.lineTo(p3);
-    return !builder.exceededMaximumPoints();
-  }
-  if (depth >= Path::kMaximumFlattenSubdivisionDepth) {
-    builder.lineTo(p3);
-    return !builder.exceededMaximumPoints();
-  }
+/// Number of consecutive curves gathered before running the batched flattening kernels.
+constexpr std::size_t kFlattenBatchCurves = 4 * kBezierBatchWidth;
 
-  auto [left, right] = SplitCubic(p0, p1, p2, p3, 0.5);
-  if (!flattenCubic(builder, left[0], left[1], left[2], left[3], tolerance, depth + 1)) {
-    return false;
-  }
-  return flattenCubic(builder, right[0], right[1], right[2], right[3], tolerance, depth + 1);
+/// Elevate a quadratic to the cubic tracing the same curve, so both verbs share one kernel.
+std::array<Vector2d, 4> ElevateQuadratic(const Vector2d& p0, const Vector2d& p1,
+                                         const Vector2d& p2) {
+  return {p0, p0 + (p1 - p0) * (2.0 / 3.0), p2 + (p1 - p2) * (2.0 / 3.0), p2};
 }
 
 }  // namespace
@@ -1668,39 +1630,59 @@ Path Path::flatten(double tolerance) const {
 }
 
 bool Path::flattenInto(PathBuilder& builder, double tolerance) const {
-  for (size_t i = 0; i < commands_.size(); ++i) {
+  // Each curve gets a uniform step count from Wang's formula, capped at the number of segments
+  // recursive subdivision would produce at the depth limit.
+  constexpr auto kMaximumSegments =
+      static_cast<std::uint32_t>(1u << static_cast<unsigned int>(kMaximumFlattenSubdivisionDepth));
+
+  std::array<std::array<Vector2d, 4>, kFlattenBatchCurves> curves;
+  std::array<std::uint32_t, kFlattenBatchCurves> counts;
+  std::vector<Vector2d> flattened;
+
+  for (size_t i = 0; i < commands_.size();) {
     if (builder.exceededMaximumPoints()) {
       return false;
     }
     const auto& cmd = commands_[i];
-    switch (cmd.verb) {
-      case Verb::MoveTo: builder.moveTo(points_[cmd.pointIndex]); break;
-
-      case Verb::LineTo: builder.lineTo(points_[cmd.pointIndex]); break;
-
-      case Verb::QuadTo: {
-        const Vector2d start = findStartPoint(commands_, points_, i);
-        const Vector2d& control = points_[cmd.pointIndex];
-        const Vector2d& end = points_[cmd.pointIndex + 1];
-        if (!flattenQuadratic(builder, start, control, end, tolerance, 0)) {
-          return false;
+    if (cmd.verb == Verb::QuadTo || cmd.verb == Verb::CurveTo) {
+      // Gather a run of consecutive curves and flatten them together.
+      std::size_t batchSize = 0;
+      for (; i < commands_.size() && batchSize < kFlattenBatchCurves; ++i) {
+        const auto& curve = commands_[i];
+        if (curve.verb == Verb::QuadTo) {
+          curves[batchSize++] =
+              ElevateQuadratic(findStartPoint(commands_, points_, i), points_[curve.pointIndex],
+                               points_[curve.pointIndex + 1]);
+        } else if (curve.verb == Verb::CurveTo) {
+          curves[batchSize++] = {findStartPoint(commands_, points_, i), points_[curve.pointIndex],
+                                 points_[curve.pointIndex + 1], points_[curve.pointIndex + 2]};
+        } else {
+          break;
         }
-        break;
       }
 
-      case Verb::CurveTo: {
-        const Vector2d start = findStartPoint(commands_, points_, i);
-        const Vector2d& c1 = points_[cmd.pointIndex];
-        const Vector2d& c2 = points_[cmd.pointIndex + 1];
-        const Vector2d& end = points_[cmd.pointIndex + 2];
-        if (!flattenCubic(builder, start, c1, c2, end, tolerance, 0)) {
+      const std::span<const std::array<Vector2d, 4>> batch(curves.data(), batchSize);
+      const std::span<std::uint32_t> batchCounts(counts.data(), batchSize);
+      CubicFlattenSegmentCounts(batch, tolerance, kMaximumSegments, batchCounts);
+      flattened.clear();
+      FlattenCubicsUniform(batch, batchCounts, flattened);
+      for (const Vector2d& point : flattened) {
+        builder.lineTo(point);
+        if (builder.exceededMaximumPoints()) {
           return false;
         }
-        break;
       }
+      continue;
+    }
 
+    switch (cmd.verb) {
+      case Verb::MoveTo: builder.moveTo(points_[cmd.pointIndex]); break;
+      case Verb::LineTo: builder.lineTo(points_[cmd.pointIndex]); break;
       case Verb::ClosePath: builder.closePath(); break;
+      case Verb::QuadTo:
+      case Verb::CurveTo: UTILS_UNREACHABLE();  // LCOV_EXCL_LINE
     }
+    ++i;
   }
   return !builder.exceededMaximumPoints();
 }
@@ -2643,22 +2625,47 @@ public:
                                : Vector2d();
   }
 
-  FlatSubpath extractRange(double startDistance, double endDistance) const {
+  /**
+   * Extract the part of the subpath between two arc-length distances.
+   *
+   * @param startDistance Start distance along the subpath.
+   * @param endDistance End distance along the subpath.
+   * @param[in,out] segmentCursor Optional walk position for callers extracting ranges in
+   *   increasing order, such as consecutive dashes. The search for the first segment scans
+   *   forward from it instead of bisecting the whole index, and it is left on the last segment
+   *   visited, so a full dash pattern costs one pass over the segments. Must start at 0.
+   */
+  FlatSubpath extractRange(double startDistance, double endDistance,
+                           std::size_t* segmentCursor = nullptr) const {
     FlatSubpath result;
     if (subpath_.points.size() < 2 || endDistance <= startDistance ||
         startDistance >= totalLength()) {
       return result;
     }
 
-    const auto firstEnd = std::upper_bound(cumulativeLengths_.begin(), cumulativeLengths_.end(),
-                                           std::max(startDistance, 0.0));
-    if (firstEnd == cumulativeLengths_.end()) {
-      return result;
+    const double clampedStart = std::max(startDistance, 0.0);
+    std::size_t segment = 0;
+    if (segmentCursor != nullptr && cumulativeLengths_[*segmentCursor] <= clampedStart) {
+      // Walk forward to the last segment starting at or before the range start.
+      segment = *segmentCursor;
+      while (segment + 2 < cumulativeLengths_.size() &&
+             cumulativeLengths_[segment + 1] <= clampedStart) {
+        ++segment;
+      }
+    } else {
+      const auto firstEnd =
+          std::upper_bound(cumulativeLengths_.begin(), cumulativeLengths_.end(), clampedStart);
+      if (firstEnd == cumulativeLengths_.end()) {
+        return result;
+      }
+      segment = static_cast<std::size_t>(firstEnd - cumulativeLengths_.begin() - 1);
     }
 
-    std::size_t segment = static_cast<std::size_t>(firstEnd - cumulativeLengths_.begin() - 1);
     for (; segment + 1 < subpath_.points.size() && cumulativeLengths_[segment] < endDistance;
          ++segment) {
+      if (segmentCursor != nullptr) {
+        *segmentCursor = segment;
+      }
       const double segmentStart = cumulativeLengths_[segment];
       const double segmentLength = cumulativeLengths_[segment + 1] - segmentStart;
       if (segmentLength <= 0.0) {
@@ -2771,6 +2778,7 @@ DashedStrokeResult strokeDashedSubpath(const FlatSubpath& subpath, const StrokeS
     // the final "on" dash would wrap across the start, we emit it as two
     // pieces (the tail at end-of-path and the head at start-of-path).
     double cursor = 0.0;
+    std::size_t dashSegment = 0;  // Forward-only walk position in `arcIndex`.
     while (cursor < totalArc && !builder.exceededMaximumPoints()) {
       if (!workBudget.consume()) {
         return DashedStrokeResult::Rejected;
@@ -2824,7 +2832,7 @@ DashedStrokeResult strokeDashedSubpath(const FlatSubpath& subpath, const StrokeS
         // first dash cover the head region matches tiny-skia's
         // behavior and produces the expected continuous visual.
         const double dashEnd = std::min(next, totalArc);
-        FlatSubpath dash = arcIndex.extractRange(cursor, dashEnd);
+        FlatSubpath dash = arcIndex.extractRange(cursor, dashEnd, &dashSegment);
         if (dash.points.size() >= 2) {
           strokeSubpath(dash, style, builder);
         }
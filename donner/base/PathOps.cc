@@ -154,7 +154,7 @@ int WindingNumberContributionCurve(const Vector2d& p0, const Vector2d& p1, const
   // uses an absolute tolerance, so near-degenerate cubics never flatten and always
   // recurse to the cap; keeping the cap low bounds the per-curve work (2^depth leaf
   // evaluations) and prevents adversarial inputs from exhausting the fuzzer timeout
-  // while StrictPathContains classifies many edges.
+  // while edges are classified against many sample points.
   constexpr int kMaxDepth = 10;
   if (depth >= kMaxDepth || IsCurveFlatEnough(p0, p1, p2, p3, tolerance)) {
     return WindingNumberContribution(p0, p3, point);
@@ -171,49 +171,6 @@ int WindingNumberContributionCurve(const Vector2d& p0, const Vector2d& p1, const
          WindingNumberContributionCurve(p0123, p123, p23, p3, point, tolerance, depth + 1);
 }
 
-bool StrictPathContains(const Path& path, const Vector2d& point, FillRule fillRule,
-                        double tolerance) {
-  int windingNumber = 0;
-  Vector2d currentPoint;
-  Vector2d subpathStart;
-
-  path.forEach([&](Path::Verb verb, std::span<const Vector2d> points) {
-    switch (verb) {
-      case Path::Verb::MoveTo:
-        currentPoint = points[0];
-        subpathStart = points[0];
-        break;
-      case Path::Verb::LineTo:
-        windingNumber += WindingNumberContribution(currentPoint, points[0], point);
-        currentPoint = points[0];
-        break;
-      case Path::Verb::QuadTo: {
-        const Vector2d c1 = currentPoint + (points[0] - currentPoint) * (2.0 / 3.0);
-        const Vector2d c2 = points[1] + (points[0] - points[1]) * (2.0 / 3.0);
-        windingNumber +=
-            WindingNumberContributionCurve(currentPoint, c1, c2, points[1], point, tolerance);
-        currentPoint = points[1];
-        break;
-      }
-      case Path::Verb::CurveTo:
-        windingNumber += WindingNumberContributionCurve(currentPoint, points[0], points[1],
-                                                        points[2], point, tolerance);
-        currentPoint = points[2];
-        break;
-      case Path::Verb::ClosePath:
-        windingNumber += WindingNumberContribution(currentPoint, subpathStart, point);
-        currentPoint = subpathStart;
-        break;
-    }
-  });
-
-  switch (fillRule) {
-    case FillRule::NonZero: return windingNumber != 0;
-    case FillRule::EvenOdd: return (windingNumber % 2) != 0;
-  }
-  return false;
-}
-
 bool PathsNearEqual(const Path& lhs, const Path& rhs, double tolerance) {
   if (lhs.commands().size() != rhs.commands().size() ||
       lhs.points().size() != rhs.points().size()) {
@@ -330,6 +287,151 @@ std::size_t SaturatingMultiply(std::size_t lhs, std::size_t rhs) {
   return lhs * rhs;
 }
 
+/// One axis of a uniform grid: \ref count equal cells starting at \ref origin. Coordinates
+/// outside the grid clamp to its first or last cell. The lookup is monotonic, so the cells of an
+/// interval's endpoints bracket the cell of every coordinate inside the interval.
+struct GridAxis {
+  double origin = 0.0;
+  double scale = 0.0;
+  std::size_t count = 1;
+
+  std::size_t cellOf(double value) const {
+    const double cell = std::floor((value - origin) * scale);
+    if (!(cell > 0.0)) {
+      return 0;
+    }
+    const double last = static_cast<double>(count - 1);
+    return cell >= last ? count - 1 : static_cast<std::size_t>(cell);
+  }
+};
+
+GridAxis MakeGridAxis(double minValue, double maxValue, std::size_t count) {
+  const double extent = maxValue - minValue;
+  if (count <= 1u || !std::isfinite(extent) || !(extent > 0.0)) {
+    return GridAxis{.origin = minValue};
+  }
+  return GridAxis{
+      .origin = minValue,
+      .scale = static_cast<double>(count) / extent,
+      .count = count,
+  };
+}
+
+/**
+ * Uniform grid over a set of boxes, listing each box in every cell it touches.
+ *
+ * Two boxes that intersect share at least one cell, so a query only has to test the boxes listed
+ * in the cells it touches. The broad phases below use it in place of all-pairs loops, and always
+ * follow it with the exact test the all-pairs loop made, so it only changes which pairs are
+ * skipped, never the result.
+ */
+struct BoxGrid {
+  GridAxis xAxis;
+  GridAxis yAxis;
+  std::vector<std::size_t> cellStarts;  ///< Offsets into \ref entries, one per cell plus one.
+  std::vector<std::size_t> entries;     ///< Box indices, grouped by cell.
+
+  /// Calls \p visit with the index of every box listed in a cell that \p box touches. A box
+  /// spanning several of those cells is visited once per cell.
+  template <typename Visit>
+  void forEachCandidate(const Box2d& box, Visit&& visit) const {
+    const std::size_t x0 = xAxis.cellOf(box.topLeft.x);
+    const std::size_t x1 = xAxis.cellOf(box.bottomRight.x);
+    const std::size_t y0 = yAxis.cellOf(box.topLeft.y);
+    const std::size_t y1 = yAxis.cellOf(box.bottomRight.y);
+    for (std::size_t y = y0; y <= y1; ++y) {
+      for (std::size_t x = x0; x <= x1; ++x) {
+        const std::size_t cell = y * xAxis.count + x;
+        for (std::size_t i = cellStarts[cell]; i < cellStarts[cell + 1]; ++i) {
+          visit(entries[i]);
+        }
+      }
+    }
+  }
+};
+
+/// Grid cells a box may be listed in, on average, before \ref BuildBoxGrid coarsens the grid.
+/// Keeps a few boxes spanning the whole input from multiplying the grid's memory.
+constexpr std::size_t kMaxGridEntriesPerBox = 8;
+
+std::size_t GridCellSpan(const GridAxis& axis, double minValue, double maxValue) {
+  return axis.cellOf(maxValue) - axis.cellOf(minValue) + 1u;
+}
+
+/// Builds a grid of about \p columns by \p rows cells over \p boxes, halving both until the
+/// boxes fit in \ref kMaxGridEntriesPerBox entries each on average.
+BoxGrid BuildBoxGrid(std::span<const Box2d> boxes, std::size_t columns, std::size_t rows) {
+  BoxGrid grid;
+  if (boxes.empty()) {
+    grid.cellStarts = {0, 0};
+    return grid;
+  }
+
+  Box2d bounds = boxes.front();
+  for (const Box2d& box : boxes) {
+    bounds.addBox(box);
+  }
+
+  const std::size_t entryBudget = SaturatingMultiply(boxes.size(), kMaxGridEntriesPerBox);
+  columns = std::max<std::size_t>(columns, 1u);
+  rows = std::max<std::size_t>(rows, 1u);
+  for (;;) {
+    grid.xAxis = MakeGridAxis(bounds.topLeft.x, bounds.bottomRight.x, columns);
+    grid.yAxis = MakeGridAxis(bounds.topLeft.y, bounds.bottomRight.y, rows);
+    if (grid.xAxis.count == 1u && grid.yAxis.count == 1u) {
+      break;
+    }
+
+    std::size_t entryCount = 0;
+    for (const Box2d& box : boxes) {
+      entryCount += SaturatingMultiply(
+          GridCellSpan(grid.xAxis, box.topLeft.x, box.bottomRight.x),
+          GridCellSpan(grid.yAxis, box.topLeft.y, box.bottomRight.y));
+      if (entryCount > entryBudget) {
+        break;
+      }
+    }
+    if (entryCount <= entryBudget) {
+      break;
+    }
+    columns = std::max<std::size_t>(grid.xAxis.count / 2u, 1u);
+    rows = std::max<std::size_t>(grid.yAxis.count / 2u, 1u);
+  }
+
+  const std::size_t cellCount = grid.xAxis.count * grid.yAxis.count;
+  const auto forEachCell = [&grid](const Box2d& box, auto&& visit) {
+    const std::size_t x0 = grid.xAxis.cellOf(box.topLeft.x);
+    const std::size_t x1 = grid.xAxis.cellOf(box.bottomRight.x);
+    const std::size_t y0 = grid.yAxis.cellOf(box.topLeft.y);
+    const std::size_t y1 = grid.yAxis.cellOf(box.bottomRight.y);
+    for (std::size_t y = y0; y <= y1; ++y) {
+      for (std::size_t x = x0; x <= x1; ++x) {
+        visit(y * grid.xAxis.count + x);
+      }
+    }
+  };
+
+  grid.cellStarts.assign(cellCount + 1u, 0u);
+  for (const Box2d& box : boxes) {
+    forEachCell(box, [&](std::size_t cell) { ++grid.cellStarts[cell + 1u]; });
+  }
+  for (std::size_t cell = 0; cell < cellCount; ++cell) {
+    grid.cellStarts[cell + 1u] += grid.cellStarts[cell];
+  }
+
+  grid.entries.resize(grid.cellStarts.back());
+  std::vector<std::size_t> cursor(grid.cellStarts.begin(), grid.cellStarts.end() - 1);
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    forEachCell(boxes[i], [&](std::size_t cell) { grid.entries[cursor[cell]++] = i; });
+  }
+  return grid;
+}
+
+/// Grid side length giving about one cell per item.
+std::size_t GridSideFor(std::size_t itemCount) {
+  return static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(itemCount))));
+}
+
 std::size_t MaxIntersectionSearchSteps(const PathBooleanOptions& options,
                                        std::size_t segmentCount) {
   constexpr std::size_t kMinIntersectionSearchSteps = 512;
@@ -1196,6 +1298,7 @@ void CloseContourIfNeeded(std::vector<Segment>* segments, const Vector2d& curren
 
 bool AppendSegmentsForPath(const Path& path, std::size_t inputIndex, double tolerance,
                            std::vector<Segment>* segments) {
+  const std::size_t firstSegment = segments->size();
   Vector2d currentPoint;
   Vector2d contourStart;
   std::size_t contourIndex = 0;
@@ -1268,7 +1371,7 @@ bool AppendSegmentsForPath(const Path& path, std::size_t inputIndex, double tole
     CloseContourIfNeeded(segments, currentPoint, contourStart, inputIndex, contourIndex, tolerance);
   }
 
-  for (const Segment& segment : *segments) {
+  for (const Segment& segment : std::span<const Segment>(*segments).subspan(firstSegment)) {
     if (!IsFinite(segment.p0) || !IsFinite(segment.p1) ||
         (segment.kind != SegmentKind::Line && !IsFinite(segment.p2)) ||
         (segment.kind == SegmentKind::Cubic && !IsFinite(segment.p3))) {
@@ -1278,31 +1381,207 @@ bool AppendSegmentsForPath(const Path& path, std::size_t inputIndex, double tole
   return true;
 }
 
-bool BooleanValue(PathBooleanOp op, std::span<const InputPath> inputs, const Vector2d& point,
+/// One winding-number term of a path: a line, or a cubic that \ref
+/// WindingNumberContributionCurve subdivides.
+struct WindingSegment {
+  std::array<Vector2d, 4> points;
+  bool isCurve = false;
+  double maxX = 0.0;  ///< Rightmost control point.
+};
+
+/**
+ * An input path prepared for repeated point-in-path queries.
+ *
+ * A point's winding number sums one term per segment, counting where a ray towards +x crosses
+ * the boundary. Only a segment whose vertical extent includes the point and which reaches right
+ * of it can be crossed, so segments are bucketed into horizontal bands and a query sums one band,
+ * skipping segments entirely to the point's left. Each remaining term is computed exactly as
+ * the whole-path sum computes it, and a skipped term is zero in that sum too: subdivision only
+ * averages control points, and a crossing test against a segment entirely left of the point
+ * cannot come out positive under rounding.
+ */
+struct WindingIndex {
+  FillRule fillRule = FillRule::NonZero;
+  std::vector<WindingSegment> segments;
+  Box2d bounds;         ///< Extent of every control point, valid when \ref segments is not empty.
+  bool closed = true;   ///< Whether every subpath ends where it started.
+  BoxGrid bands;        ///< One column of bands over \ref segments' control point extents.
+};
+
+WindingIndex BuildWindingIndex(const Path& path, FillRule fillRule) {
+  WindingIndex index;
+  index.fillRule = fillRule;
+
+  Vector2d currentPoint;
+  Vector2d subpathStart;
+  bool subpathHasSegments = false;
+  const auto endSubpath = [&]() {
+    if (subpathHasSegments &&
+        (currentPoint.x != subpathStart.x || currentPoint.y != subpathStart.y)) {
+      index.closed = false;
+    }
+    subpathHasSegments = false;
+  };
+  const auto addSegment = [&](WindingSegment segment) {
+    segment.maxX = segment.points[0].x;
+    for (const Vector2d& point : segment.points) {
+      segment.maxX = std::max(segment.maxX, point.x);
+    }
+    index.segments.push_back(segment);
+    subpathHasSegments = true;
+  };
+  const auto addLine = [&](const Vector2d& p0, const Vector2d& p1) {
+    addSegment(WindingSegment{.points = {p0, p0, p1, p1}});
+  };
+  const auto addCurve = [&](const Vector2d& p0, const Vector2d& c1, const Vector2d& c2,
+                            const Vector2d& p3) {
+    addSegment(WindingSegment{.points = {p0, c1, c2, p3}, .isCurve = true});
+  };
+
+  path.forEach([&](Path::Verb verb, std::span<const Vector2d> points) {
+    switch (verb) {
+      case Path::Verb::MoveTo:
+        endSubpath();
+        currentPoint = points[0];
+        subpathStart = points[0];
+        break;
+      case Path::Verb::LineTo:
+        addLine(currentPoint, points[0]);
+        currentPoint = points[0];
+        break;
+      case Path::Verb::QuadTo: {
+        const Vector2d c1 = currentPoint + (points[0] - currentPoint) * (2.0 / 3.0);
+        const Vector2d c2 = points[1] + (points[0] - points[1]) * (2.0 / 3.0);
+        addCurve(currentPoint, c1, c2, points[1]);
+        currentPoint = points[1];
+        break;
+      }
+      case Path::Verb::CurveTo:
+        addCurve(currentPoint, points[0], points[1], points[2]);
+        currentPoint = points[2];
+        break;
+      case Path::Verb::ClosePath:
+        addLine(currentPoint, subpathStart);
+        currentPoint = subpathStart;
+        break;
+    }
+  });
+  endSubpath();
+
+  std::vector<Box2d> extents;
+  extents.reserve(index.segments.size());
+  for (const WindingSegment& segment : index.segments) {
+    Box2d extent = Box2d::CreateEmpty(segment.points[0]);
+    for (std::size_t i = 1; i < segment.points.size(); ++i) {
+      extent.addPoint(segment.points[i]);
+    }
+    extents.push_back(extent);
+  }
+
+  index.bands = BuildBoxGrid(extents, 1u, index.segments.size());
+  if (!extents.empty()) {
+    index.bounds = extents.front();
+    for (const Box2d& extent : extents) {
+      index.bounds.addBox(extent);
+    }
+  }
+  return index;
+}
+
+bool WindingIndexContains(const WindingIndex& index, const Vector2d& point, double tolerance) {
+  int windingNumber = 0;
+  if (!index.segments.empty() && point.y >= index.bounds.topLeft.y &&
+      point.y <= index.bounds.bottomRight.y) {
+    index.bands.forEachCandidate(Box2d::CreateEmpty(point), [&](std::size_t i) {
+      const WindingSegment& segment = index.segments[i];
+      if (segment.maxX < point.x) {
+        return;
+      }
+      const std::array<Vector2d, 4>& p = segment.points;
+      windingNumber += segment.isCurve
+                           ? WindingNumberContributionCurve(p[0], p[1], p[2], p[3], point, tolerance)
+                           : WindingNumberContribution(p[0], p[3], point);
+    });
+  }
+
+  switch (index.fillRule) {
+    case FillRule::NonZero: return windingNumber != 0;
+    case FillRule::EvenOdd: return (windingNumber % 2) != 0;
+  }
+  return false;
+}
+
+/**
+ * The inputs of a boolean operation, indexed so a point query only evaluates the inputs that can
+ * contain the point.
+ *
+ * A closed input contains nothing outside its bounds, since a ray from a point left of it
+ * crosses each of its subpaths as often upwards as downwards. An input with an open subpath can
+ * report points to its left as inside, so it stays a candidate for the whole band to its left.
+ */
+struct BooleanInputs {
+  std::vector<WindingIndex> inputs;
+  BoxGrid grid;  ///< Region each input may report points inside, per input.
+};
+
+BooleanInputs BuildBooleanInputs(std::span<const InputPath> inputs) {
+  BooleanInputs result;
+  result.inputs.reserve(inputs.size());
+  for (const InputPath& input : inputs) {
+    result.inputs.push_back(BuildWindingIndex(input.path, input.fillRule));
+  }
+
+  std::optional<double> minX;
+  for (const WindingIndex& index : result.inputs) {
+    if (!index.segments.empty()) {
+      minX = std::min(minX.value_or(index.bounds.topLeft.x), index.bounds.topLeft.x);
+    }
+  }
+
+  std::vector<Box2d> regions;
+  regions.reserve(result.inputs.size());
+  for (const WindingIndex& index : result.inputs) {
+    Box2d region = index.bounds;
+    if (!index.closed) {
+      region.topLeft.x = *minX;
+    }
+    regions.push_back(region);
+  }
+
+  const std::size_t side = GridSideFor(result.inputs.size());
+  result.grid = BuildBoxGrid(regions, side, side);
+  return result;
+}
+
+bool BooleanValue(PathBooleanOp op, const BooleanInputs& inputs, const Vector2d& point,
                   double tolerance) {
   std::size_t insideCount = 0;
   bool firstInside = false;
-  for (std::size_t i = 0; i < inputs.size(); ++i) {
-    const bool inside = StrictPathContains(inputs[i].path, point, inputs[i].fillRule, tolerance);
-    if (i == 0) {
-      firstInside = inside;
+  inputs.grid.forEachCandidate(Box2d::CreateEmpty(point), [&](std::size_t i) {
+    const WindingIndex& input = inputs.inputs[i];
+    if (input.closed && point.x < input.bounds.topLeft.x) {
+      return;
     }
-    if (inside) {
-      ++insideCount;
+    if (!WindingIndexContains(input, point, tolerance)) {
+      return;
     }
-  }
+    if (i == 0) {
+      firstInside = true;
+    }
+    ++insideCount;
+  });
 
   switch (op) {
     case PathBooleanOp::Union: return insideCount > 0u;
-    case PathBooleanOp::Intersect: return insideCount == inputs.size();
+    case PathBooleanOp::Intersect: return insideCount == inputs.inputs.size();
     case PathBooleanOp::Difference: return firstInside && insideCount == (firstInside ? 1u : 0u);
     case PathBooleanOp::Xor: return (insideCount % 2u) == 1u;
   }
   return false;
 }
 
-std::optional<Edge> ClassifyEdge(const Edge& edge, PathBooleanOp op,
-                                 std::span<const InputPath> inputs, double tolerance) {
+std::optional<Edge> ClassifyEdge(const Edge& edge, PathBooleanOp op, const BooleanInputs& inputs,
+                                 double tolerance) {
   const Vector2d tangent = EdgeTangentAt(edge, 0.5).normalize();
   if (NearZero(tangent.lengthSquared())) {
     return std::nullopt;
@@ -1332,8 +1611,13 @@ std::optional<Edge> ClassifyEdge(const Edge& edge, PathBooleanOp op,
   return std::nullopt;
 }
 
+/// Size of the cells \ref QuantizePoint snaps points into.
+double PointKeyCellSize(double tolerance) {
+  return std::max(tolerance * 256.0, 1e-9);
+}
+
 PointKey QuantizePoint(const Vector2d& point, double tolerance) {
-  const double scale = 1.0 / std::max(tolerance * 256.0, 1e-9);
+  const double scale = 1.0 / PointKeyCellSize(tolerance);
   return {
       .x = static_cast<std::int64_t>(std::llround(point.x * scale)),
       .y = static_cast<std::int64_t>(std::llround(point.y * scale)),
@@ -1362,13 +1646,16 @@ double PositiveAngleDiff(double fromAngle, double toAngle) {
   return diff;
 }
 
+/// Returns the unused edge the next contour starts from. \p unusedIndices lists, in ascending
+/// order, a superset of the unused edges; edges used since the last call are dropped from it, so
+/// each scan only visits edges that are still candidates.
 std::optional<std::size_t> FindFirstUnusedEdge(const std::vector<TraceEdge>& edges,
+                                               std::vector<std::size_t>* unusedIndices,
                                                double tolerance) {
+  std::erase_if(*unusedIndices, [&](std::size_t i) { return edges[i].used; });
+
   std::optional<std::size_t> best;
-  for (std::size_t i = 0; i < edges.size(); ++i) {
-    if (edges[i].used) {
-      continue;
-    }
+  for (std::size_t i : *unusedIndices) {
     if (!best.has_value() || PointLess(edges[i].edge.p0, edges[*best].edge.p0, tolerance)) {
       best = i;
     }
@@ -1376,10 +1663,6 @@ std::optional<std::size_t> FindFirstUnusedEdge(const std::vector<TraceEdge>& edg
   return best;
 }
 
-bool ContainsIndex(const std::vector<std::size_t>& indices, std::size_t index) {
-  return std::find(indices.begin(), indices.end(), index) != indices.end();
-}
-
 enum class ContourSearchResult : std::uint8_t {
   Closed,
   Open,
@@ -1395,22 +1678,52 @@ std::size_t MaxContourSearchSteps(const PathBooleanOptions& options, std::size_t
   return base * kTraceSearchMultiplier;
 }
 
+/// Edge start points of a trace, indexed so the edges leaving a point are found without
+/// scanning every edge.
+struct TraceStartIndex {
+  BoxGrid grid;
+  /// Distance from a query point within which every candidate start lies: the snap tolerance,
+  /// or a \ref PointKey cell when that is larger, with margin for rounding.
+  double searchRadius = 0.0;
+};
+
+TraceStartIndex BuildTraceStartIndex(const std::vector<TraceEdge>& edges, double snapTolerance,
+                                     double tolerance) {
+  std::vector<Box2d> starts;
+  starts.reserve(edges.size());
+  for (const TraceEdge& edge : edges) {
+    starts.push_back(Box2d::CreateEmpty(edge.edge.p0));
+  }
+
+  const std::size_t side = GridSideFor(edges.size());
+  return TraceStartIndex{
+      .grid = BuildBoxGrid(starts, side, side),
+      .searchRadius = 2.0 * std::max(snapTolerance, PointKeyCellSize(tolerance)),
+  };
+}
+
 std::vector<std::size_t> CandidateNextEdges(const std::vector<TraceEdge>& edges,
+                                            const TraceStartIndex& startIndex,
                                             const PointKey& startKey, const Vector2d& startPoint,
                                             double previousAngle, double snapTolerance,
-                                            const std::vector<std::size_t>& contourIndices) {
+                                            const std::vector<bool>& inContour) {
   std::vector<std::size_t> candidates;
-  for (std::size_t i = 0; i < edges.size(); ++i) {
-    if (edges[i].used || ContainsIndex(contourIndices, i)) {
-      continue;
-    }
-    if (!(edges[i].startKey == startKey) &&
-        !NearPoint(edges[i].edge.p0, startPoint, snapTolerance)) {
-      continue;
-    }
-    candidates.push_back(i);
-  }
-
+  const Vector2d radius(startIndex.searchRadius, startIndex.searchRadius);
+  startIndex.grid.forEachCandidate(Box2d(startPoint - radius, startPoint + radius),
+                                   [&](std::size_t i) {
+                                     if (edges[i].used || inContour[i]) {
+                                       return;
+                                     }
+                                     if (!(edges[i].startKey == startKey) &&
+                                         !NearPoint(edges[i].edge.p0, startPoint, snapTolerance)) {
+                                       return;
+                                     }
+                                     candidates.push_back(i);
+                                   });
+
+  // Visit order across cells is arbitrary; sorting by index first keeps the tie order below
+  // the same as a scan over every edge.
+  std::sort(candidates.begin(), candidates.end());
   std::sort(candidates.begin(), candidates.end(), [&](std::size_t lhs, std::size_t rhs) {
     const double lhsTurn = PositiveAngleDiff(previousAngle, EdgeStartAngle(edges[lhs].edge));
     const double rhsTurn = PositiveAngleDiff(previousAngle, EdgeStartAngle(edges[rhs].edge));
@@ -1422,39 +1735,79 @@ std::vector<std::size_t> CandidateNextEdges(const std::vector<TraceEdge>& edges,
   return candidates;
 }
 
+/**
+ * Depth-first search for a closed contour continuing from the last edge of \p contourIndices,
+ * taking the sharpest left turn first at every vertex.
+ *
+ * The search keeps its own stack rather than recursing, since a single output contour can have as
+ * many edges as the whole input. \p inContour mirrors \p contourIndices as a per-edge flag.
+ */
 ContourSearchResult FindClosedContour(const std::vector<TraceEdge>& edges,
+                                      const TraceStartIndex& startIndex,
                                       const PointKey& contourStartKey,
-                                      const Vector2d& contourStartPoint, const PointKey& currentKey,
-                                      const Vector2d& currentPoint, double previousAngle,
-                                      double snapTolerance,
+                                      const Vector2d& contourStartPoint, double snapTolerance,
                                       std::vector<std::size_t>* contourIndices,
-                                      std::size_t* searchSteps, std::size_t maxSearchSteps) {
-  if (*searchSteps >= maxSearchSteps) {
-    return ContourSearchResult::TooComplex;
-  }
-  ++*searchSteps;
+                                      std::vector<bool>* inContour, std::size_t* searchSteps,
+                                      std::size_t maxSearchSteps) {
+  struct SearchFrame {
+    std::vector<std::size_t> candidates;
+    std::size_t next = 0;
+  };
+  std::vector<SearchFrame> stack;
+
+  // Continues the contour from the end of `edge`, returning a result if the search ends there.
+  const auto enter = [&](const TraceEdge& edge) -> std::optional<ContourSearchResult> {
+    if (*searchSteps >= maxSearchSteps) {
+      return ContourSearchResult::TooComplex;
+    }
+    ++*searchSteps;
 
-  if (contourIndices->size() > edges.size()) {
-    return ContourSearchResult::Open;
+    if (contourIndices->size() > edges.size()) {
+      return ContourSearchResult::Open;
+    }
+
+    stack.push_back(SearchFrame{
+        .candidates = CandidateNextEdges(edges, startIndex, edge.endKey,
+                                         EdgePointAt(edge.edge, 1.0),
+                                         EdgeTangentAt(edge.edge, 1.0).angle(), snapTolerance,
+                                         *inContour),
+    });
+    return std::nullopt;
+  };
+  const auto popEdge = [&]() {
+    (*inContour)[contourIndices->back()] = false;
+    contourIndices->pop_back();
+  };
+
+  if (std::optional<ContourSearchResult> result = enter(edges[contourIndices->back()])) {
+    return *result;
   }
 
-  for (std::size_t nextIndex : CandidateNextEdges(edges, currentKey, currentPoint, previousAngle,
-                                                  snapTolerance, *contourIndices)) {
+  while (!stack.empty()) {
+    SearchFrame& frame = stack.back();
+    if (frame.next == frame.candidates.size()) {
+      stack.pop_back();
+      if (!stack.empty()) {
+        popEdge();
+      }
+      continue;
+    }
+
+    const std::size_t nextIndex = frame.candidates[frame.next++];
     contourIndices->push_back(nextIndex);
+    (*inContour)[nextIndex] = true;
     const TraceEdge& nextEdge = edges[nextIndex];
-    const Vector2d nextEndPoint = EdgePointAt(nextEdge.edge, 1.0);
     if (nextEdge.endKey == contourStartKey ||
-        NearPoint(nextEndPoint, contourStartPoint, snapTolerance)) {
+        NearPoint(EdgePointAt(nextEdge.edge, 1.0), contourStartPoint, snapTolerance)) {
       return ContourSearchResult::Closed;
     }
-    const ContourSearchResult result =
-        FindClosedContour(edges, contourStartKey, contourStartPoint, nextEdge.endKey, nextEndPoint,
-                          EdgeTangentAt(nextEdge.edge, 1.0).angle(), snapTolerance, contourIndices,
-                          searchSteps, maxSearchSteps);
-    if (result != ContourSearchResult::Open) {
-      return result;
+
+    if (std::optional<ContourSearchResult> result = enter(nextEdge)) {
+      if (*result == ContourSearchResult::TooComplex) {
+        return *result;
+      }
+      popEdge();
     }
-    contourIndices->pop_back();
   }
 
   return ContourSearchResult::Open;
@@ -1485,23 +1838,33 @@ PathBooleanResult TraceOutput(std::vector<Edge> classifiedEdges, double toleranc
 
   const std::size_t maxContourSearchSteps = MaxContourSearchSteps(options, edges.size());
   std::size_t contourSearchSteps = 0;
+  const double snapTolerance = std::max(tolerance * 512.0, tolerance);
+  const TraceStartIndex startIndex = BuildTraceStartIndex(edges, snapTolerance, tolerance);
+  std::vector<std::size_t> unusedIndices(edges.size());
+  for (std::size_t i = 0; i < unusedIndices.size(); ++i) {
+    unusedIndices[i] = i;
+  }
+  std::vector<bool> inContour(edges.size(), false);
 
   PathBuilder builder;
   std::size_t outputCommands = 0;
   std::size_t droppedOpenContours = 0;
-  while (std::optional<std::size_t> first = FindFirstUnusedEdge(edges, tolerance)) {
+  while (std::optional<std::size_t> first =
+             FindFirstUnusedEdge(edges, &unusedIndices, tolerance)) {
     const Vector2d contourStart = edges[*first].edge.p0;
     const PointKey contourStartKey = edges[*first].startKey;
     const Vector2d firstEndPoint = EdgePointAt(edges[*first].edge, 1.0);
-    const double snapTolerance = std::max(tolerance * 512.0, tolerance);
     std::vector<std::size_t> contourIndices = {*first};
     bool contourClosed = edges[*first].endKey == contourStartKey ||
                          NearPoint(firstEndPoint, contourStart, snapTolerance);
     if (!contourClosed) {
+      inContour[*first] = true;
       const ContourSearchResult searchResult = FindClosedContour(
-          edges, contourStartKey, contourStart, edges[*first].endKey, firstEndPoint,
-          EdgeTangentAt(edges[*first].edge, 1.0).angle(), snapTolerance, &contourIndices,
-          &contourSearchSteps, maxContourSearchSteps);
+          edges, startIndex, contourStartKey, contourStart, snapTolerance, &contourIndices,
+          &inContour, &contourSearchSteps, maxContourSearchSteps);
+      for (std::size_t edgeIndex : contourIndices) {
+        inContour[edgeIndex] = false;
+      }
       if (searchResult == ContourSearchResult::TooComplex) {
         return {
             .status = PathBooleanStatus::TooComplex,
@@ -1615,9 +1978,35 @@ PathBooleanResult ApplyPathBoolean(PathBooleanOp op, std::span<const PathBoolean
   IntersectionSearchBudget intersectionSearchBudget{
       .maxSteps = MaxIntersectionSearchSteps(options, segments.size()),
   };
+  // Broad phase: a segment is only tested against segments sharing a grid cell with it. Boxes
+  // are stretched by the tolerance so that every pair BoxesOverlap accepts shares a cell, and
+  // pairs are still visited in (i, j) order, since splits merge in the order they are added.
+  std::vector<Box2d> segmentBounds;
+  std::vector<Box2d> searchBounds;
+  segmentBounds.reserve(segments.size());
+  searchBounds.reserve(segments.size());
+  for (const Segment& segment : segments) {
+    const Box2d bounds = SegmentBounds(segment);
+    segmentBounds.push_back(bounds);
+    searchBounds.push_back(
+        Box2d(bounds.topLeft, bounds.bottomRight + Vector2d(tolerance, tolerance)));
+  }
+  const std::size_t gridSide = GridSideFor(segments.size());
+  const BoxGrid segmentGrid = BuildBoxGrid(searchBounds, gridSide, gridSide);
+
+  std::vector<std::size_t> candidates;
   for (std::size_t i = 0; i < segments.size(); ++i) {
-    for (std::size_t j = i + 1; j < segments.size(); ++j) {
-      if (!BoxesOverlap(SegmentBounds(segments[i]), SegmentBounds(segments[j]), tolerance)) {
+    candidates.clear();
+    segmentGrid.forEachCandidate(searchBounds[i], [&](std::size_t j) {
+      if (j > i) {
+        candidates.push_back(j);
+      }
+    });
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (std::size_t j : candidates) {
+      if (!BoxesOverlap(segmentBounds[i], segmentBounds[j], tolerance)) {
         continue;
       }
 
@@ -1650,6 +2039,8 @@ PathBooleanResult ApplyPathBoolean(PathBooleanOp op, std::span<const PathBoolean
     }
   }
 
+  const BooleanInputs booleanInputs = BuildBooleanInputs(transformedInputs);
+
   std::vector<Edge> classifiedEdges;
   for (Segment& segment : segments) {
     std::sort(segment.splits.begin(), segment.splits.end(),
@@ -1660,8 +2051,7 @@ PathBooleanResult ApplyPathBoolean(PathBooleanOp op, std::span<const PathBoolean
       if (!edge.has_value()) {
         continue;
       }
-      std::optional<Edge> classified =
-          ClassifyEdge(*edge, op, std::span<const InputPath>(transformedInputs), tolerance);
+      std::optional<Edge> classified = ClassifyEdge(*edge, op, booleanInputs, tolerance);
       if (classified.has_value()) {
         classifiedEdges.push_back(*classified);
       }
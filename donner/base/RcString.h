@@ -77,6 +77,29 @@ public:
    */
   static RcString fromVector(std::vector<char>&& data) { return RcString(std::move(data)); }
 
+  /**
+   * Constructs an RcString that references \p view in place, inside a buffer kept alive by
+   * \p owner, such as a memory-mapped file. Substrings share the same reference, so values sliced
+   * out of a large buffer cost no copy. Strings that fit in the short-string buffer are still
+   * copied.
+   *
+   * Unlike other RcStrings, the data is not null-terminated.
+   *
+   * @param owner Owner of the buffer, kept alive while this string or any substring is alive.
+   * @param view Contents, which must point into the buffer owned by \p owner.
+   * @return RcString referencing the buffer.
+   */
+  static RcString fromSharedBuffer(std::shared_ptr<const void> owner, std::string_view view) {
+    if (view.size() <= kShortStringCapacity) {
+      return RcString(view);
+    }
+
+    assert(view.size() < kMaxSize);
+    // Alias the owner's control block: the storage pointer itself is never dereferenced for an
+    // existing string, it only carries the reference.
+    return RcString(std::shared_ptr<std::vector<char>>(std::move(owner), nullptr), view);
+  }
+
   /**
    * Constructs an RcString using std::format-style formatting.
    *
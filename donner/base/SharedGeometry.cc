@@ -0,0 +1,112 @@
+#include "donner/base/SharedGeometry.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace donner {
+
+namespace {
+
+/// Process-wide table of live outlines. Holds weak references only, so an outline is freed as soon
+/// as its last user drops it; expired entries are swept when the table has doubled since the
+/// previous sweep.
+class GeometryInternTable {
+public:
+  std::shared_ptr<const SharedGeometry> intern(std::shared_ptr<const SharedGeometry> candidate) {
+    std::lock_guard lock(mutex_);
+    auto [begin, end] = entries_.equal_range(candidate->hash());
+    for (auto it = begin; it != end; ++it) {
+      if (std::shared_ptr<const SharedGeometry> existing = it->second.lock();
+          existing && existing->contentEquals(*candidate)) {
+        return existing;
+      }
+    }
+
+    entries_.emplace(candidate->hash(), candidate);
+    if (entries_.size() >= sweepThreshold_) {
+      sweepLocked();
+    }
+    return candidate;
+  }
+
+  std::size_t liveCount() {
+    std::lock_guard lock(mutex_);
+    sweepLocked();
+    return entries_.size();
+  }
+
+private:
+  static constexpr std::size_t kMinSweepThreshold = 64;
+
+  void sweepLocked() {
+    std::erase_if(entries_, [](const auto& entry) { return entry.second.expired(); });
+    sweepThreshold_ = std::max(kMinSweepThreshold, entries_.size() * 2);
+  }
+
+  std::mutex mutex_;
+  std::unordered_multimap<ContentHash, std::weak_ptr<const SharedGeometry>> entries_;
+  std::size_t sweepThreshold_ = kMinSweepThreshold;
+};
+
+GeometryInternTable& InternTable() {
+  // Leaked so that outlines released during static destruction can still find the table.
+  static GeometryInternTable* table = new GeometryInternTable();
+  return *table;
+}
+
+}  // namespace
+
+SharedGeometry::SharedGeometry(const Path& path) {
+  const std::span<const Path::Command> commands = path.commands();
+  const std::span<const Vector2d> sourcePoints = path.points();
+
+  verbs_.reserve(commands.size());
+  points_.reserve(sourcePoints.size());
+  for (const Path::Command& command : commands) {
+    verbs_.push_back(command.verb);
+    const std::size_t count = Path::pointsPerVerb(command.verb);
+    for (std::size_t i = 0; i < count; ++i) {
+      const Vector2d& point = sourcePoints[command.pointIndex + i];
+      points_.emplace_back(static_cast<float>(point.x), static_cast<float>(point.y));
+    }
+  }
+
+  ContentHasher hasher;
+  hasher.updateValue(verbs_.size());
+  hasher.update(std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(verbs_.data()),
+                                              verbs_.size() * sizeof(Verb)));
+  for (const Vector2f& point : points_) {
+    hasher.updateValue(point.x);
+    hasher.updateValue(point.y);
+  }
+  hash_ = hasher.finish();
+}
+
+std::shared_ptr<const SharedGeometry> SharedGeometry::Intern(const Path& path) {
+  return InternTable().intern(std::make_shared<const SharedGeometry>(path));
+}
+
+std::shared_ptr<const SharedGeometry> SharedGeometry::InternWithHashForTesting(
+    const Path& path, const ContentHash& hash) {
+  auto candidate = std::make_shared<SharedGeometry>(path);
+  candidate->hash_ = hash;
+  return InternTable().intern(std::move(candidate));
+}
+
+std::size_t SharedGeometry::InternedCountForTesting() {
+  return InternTable().liveCount();
+}
+
+bool SharedGeometry::contentEquals(const SharedGeometry& other) const {
+  if (verbs_ != other.verbs_ || points_.size() != other.points_.size()) {
+    return false;
+  }
+
+  // Compare bit patterns rather than values, so that -0 and 0 stay distinct (they rasterize
+  // identically but would hash differently) and NaN compares equal to itself.
+  return points_.empty() ||
+         std::memcmp(points_.data(), other.points_.data(), points_.size() * sizeof(Vector2f)) == 0;
+}
+
+}  // namespace donner
@@ -0,0 +1,135 @@
+#pragma once
+/// @file
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "donner/base/ContentHash.h"
+#include "donner/base/Path.h"
+#include "donner/base/Vector2.h"
+
+namespace donner {
+
+/**
+ * Immutable, content-hashed outline shared between every entity, and every document, that
+ * produces the same geometry.
+ *
+ * Stores a \ref Path compactly: one byte per verb and single-precision points, which is the
+ * precision every rasterizer consumes anyway. Instances are obtained through \ref Intern, which
+ * returns the existing buffer when an identical outline is already alive anywhere in the
+ * process, so `<use>`-instanced or duplicated shapes hold one copy between them. The hash only
+ * selects candidates: \ref ContentHash is not collision resistant, so an outline is shared only
+ * when its verbs and points match bit for bit, see \ref contentEquals.
+ *
+ * Backend conversions of the outline (a tiny-skia path, an encoded form, a flattened polyline)
+ * hang off the buffer as derived caches, see \ref derived. Because the buffer is shared by
+ * content, a conversion built while drawing one entity is reused by every other entity with the
+ * same outline. Derived entries die with the buffer, when the last holder releases it.
+ *
+ * Thread-safe: the outline is immutable, and interning and derived caches are internally
+ * synchronized.
+ */
+class SharedGeometry {
+public:
+  /// Verb type, identical to \ref Path::Verb.
+  using Verb = Path::Verb;
+
+  /// Identifies one kind of derived cache entry. Each backend defines its own tags as statics,
+  /// and the tag's address is the key, so independent backends cannot collide.
+  struct DerivedTag {
+    const char* name;  //!< Human-readable name, for debugging.
+  };
+
+  /**
+   * Returns the shared buffer holding \p path's outline, creating it if no identical outline is
+   * alive. Only verbs and points are kept; \ref Path::Command::isInternal is dropped.
+   *
+   * @param path Outline to intern.
+   */
+  static std::shared_ptr<const SharedGeometry> Intern(const Path& path);
+
+  /**
+   * Interns \p path as if its digest were \p hash, so tests can construct a collision.
+   *
+   * @param path Outline to intern.
+   * @param hash Digest to file the outline under.
+   */
+  static std::shared_ptr<const SharedGeometry> InternWithHashForTesting(const Path& path,
+                                                                        const ContentHash& hash);
+
+  /// Number of distinct outlines currently interned and alive, for tests.
+  static std::size_t InternedCountForTesting();
+
+  /**
+   * Build an un-interned buffer from \p path. Prefer \ref Intern, which deduplicates.
+   *
+   * @param path Outline to copy.
+   */
+  explicit SharedGeometry(const Path& path);
+
+  /// Verbs in order.
+  std::span<const Verb> verbs() const { return verbs_; }
+
+  /// Points consumed by \ref verbs, in order. `ClosePath` consumes none; it closes back to the
+  /// point of the preceding `MoveTo`.
+  std::span<const Vector2f> points() const { return points_; }
+
+  /// Digest of the verbs and points, the interning key.
+  const ContentHash& hash() const { return hash_; }
+
+  /// Returns true if both buffers hold the same verbs and bit-identical points.
+  bool contentEquals(const SharedGeometry& other) const;
+
+  /// Bytes used by the verb and point buffers.
+  std::size_t storageBytes() const {
+    return verbs_.capacity() * sizeof(Verb) + points_.capacity() * sizeof(Vector2f);
+  }
+
+  /**
+   * Returns the derived value stored under \p tag, building it with \p build on first use.
+   *
+   * \p build runs without the internal lock held, so two threads may build concurrently on a
+   * first miss; one result is kept and both callers receive it.
+   *
+   * @tparam T Derived value type. Every use of one tag must use the same type.
+   * @param tag Address of a backend-owned static identifying the derived value.
+   * @param build Callable returning a `T` computed from this outline.
+   */
+  template <typename T, typename BuildFn>
+  std::shared_ptr<const T> derived(const DerivedTag& tag, BuildFn&& build) const {
+    {
+      std::lock_guard lock(derivedMutex_);
+      for (const auto& [key, value] : derived_) {
+        if (key == &tag) {
+          return std::static_pointer_cast<const T>(value);
+        }
+      }
+    }
+
+    std::shared_ptr<const T> built = std::make_shared<const T>(std::forward<BuildFn>(build)());
+    std::lock_guard lock(derivedMutex_);
+    for (const auto& [key, value] : derived_) {
+      if (key == &tag) {
+        return std::static_pointer_cast<const T>(value);
+      }
+    }
+    derived_.emplace_back(&tag, built);
+    return built;
+  }
+
+private:
+  std::vector<Verb> verbs_;
+  std::vector<Vector2f> points_;
+  ContentHash hash_;
+
+  mutable std::mutex derivedMutex_;
+  /// Derived values by tag; a handful per outline at most, so a flat list.
+  mutable std::vector<std::pair<const DerivedTag*, std::shared_ptr<const void>>> derived_;
+};
+
+}  // namespace donner
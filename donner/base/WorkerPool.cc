@@ -0,0 +1,73 @@
+#include "donner/base/WorkerPool.h"
+
+#include <algorithm>
+
+namespace donner {
+
+WorkerPool::WorkerPool(std::size_t threadCount) {
+  threadCount = std::max<std::size_t>(threadCount, 1);
+  threads_.reserve(threadCount - 1);
+  for (std::size_t worker = 1; worker < threadCount; ++worker) {
+    threads_.emplace_back([this, worker] { workerMain(worker); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  jobPosted_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::run(std::size_t workerCount, const std::function<void(std::size_t)>& fn) {
+  workerCount = std::clamp<std::size_t>(workerCount, 1, threadCount());
+  if (workerCount == 1) {
+    fn(0);
+    return;
+  }
+
+  std::lock_guard runLock(runMutex_);
+  {
+    std::lock_guard lock(mutex_);
+    job_ = &fn;
+    jobWorkers_ = workerCount;
+    pending_ = workerCount - 1;
+    ++generation_;
+  }
+  jobPosted_.notify_all();
+
+  fn(0);
+
+  std::unique_lock lock(mutex_);
+  jobFinished_.wait(lock, [this] { return pending_ == 0; });
+  job_ = nullptr;
+}
+
+void WorkerPool::workerMain(std::size_t worker) {
+  std::uint64_t seenGeneration = 0;
+  std::unique_lock lock(mutex_);
+  while (true) {
+    jobPosted_.wait(lock, [&] { return stopping_ || generation_ != seenGeneration; });
+    if (stopping_) {
+      return;
+    }
+    seenGeneration = generation_;
+    if (worker >= jobWorkers_) {
+      continue;
+    }
+
+    const std::function<void(std::size_t)>* job = job_;
+    lock.unlock();
+    (*job)(worker);
+    lock.lock();
+    if (--pending_ == 0) {
+      jobFinished_.notify_one();
+    }
+  }
+}
+
+}  // namespace donner
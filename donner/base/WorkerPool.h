@@ -0,0 +1,86 @@
+#pragma once
+/// @file
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace donner {
+
+/**
+ * A fixed set of threads that run one function per worker and wait for all of them, for work
+ * that is split into a known number of parts up front.
+ *
+ * The threads are started once, by the constructor, and sleep between calls to \ref run, so a
+ * caller that runs many short parallel stages pays for thread startup once rather than per stage.
+ *
+ * ```
+ * WorkerPool pool(4);
+ * pool.run(pool.threadCount(), [&](std::size_t worker) { process(worker); });
+ * ```
+ */
+class WorkerPool {
+public:
+  /**
+   * Start a pool.
+   *
+   * @param threadCount Number of workers, including the thread that calls \ref run. A pool of 1
+   *     starts no threads and runs everything on the caller.
+   */
+  explicit WorkerPool(std::size_t threadCount);
+
+  /// Stops and joins the threads. Must not be called while \ref run is in progress.
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+  WorkerPool(WorkerPool&&) = delete;
+  WorkerPool& operator=(WorkerPool&&) = delete;
+
+  /// Number of workers, including the thread that calls \ref run.
+  [[nodiscard]] std::size_t threadCount() const { return threads_.size() + 1; }
+
+  /**
+   * Call `fn(worker)` once for each worker in `[0, workerCount)` and return once every call has
+   * finished. Worker 0 runs on the calling thread, the others on the pool's threads.
+   *
+   * Calls from several threads are serialized. `fn` must not call \ref run on the same pool.
+   *
+   * @param workerCount Number of workers to use, clamped to `[1, threadCount()]`.
+   * @param fn Function to call once per worker.
+   */
+  void run(std::size_t workerCount, const std::function<void(std::size_t)>& fn);
+
+private:
+  /// Body of pool thread \p worker, which is never 0.
+  void workerMain(std::size_t worker);
+
+  /// Held for the whole of \ref run, so only one job is in flight.
+  std::mutex runMutex_;
+
+  /// Guards every member below.
+  std::mutex mutex_;
+  /// Signalled when a job is posted or the pool is stopping.
+  std::condition_variable jobPosted_;
+  /// Signalled when the last pool thread of a job finishes.
+  std::condition_variable jobFinished_;
+
+  /// Current job, valid while \ref pending_ is non-zero.
+  const std::function<void(std::size_t)>* job_ = nullptr;
+  /// Workers the current job uses, including worker 0.
+  std::size_t jobWorkers_ = 0;
+  /// Incremented per job, so a thread runs each job at most once.
+  std::uint64_t generation_ = 0;
+  /// Pool threads still running the current job.
+  std::size_t pending_ = 0;
+  /// Set by the destructor.
+  bool stopping_ = false;
+
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace donner
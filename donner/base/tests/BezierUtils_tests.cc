@@ -3,7 +3,12 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 namespace donner {
 
@@ -629,4 +634,129 @@ TEST(BezierUtils, QuadraticBoundsContainsAllEvaluatedPoints) {
   }
 }
 
+// =============================================================================
+// Batched flattening
+// =============================================================================
+
+TEST(BezierUtils, CubicFlattenSegmentCountsFlatCurvesUseOneSegment) {
+  const std::array<std::array<Vector2d, 4>, 2> cubics = {{
+      {Vector2d(0, 0), Vector2d(1, 0), Vector2d(2, 0), Vector2d(3, 0)},
+      {Vector2d(5, 5), Vector2d(5, 5), Vector2d(5, 5), Vector2d(5, 5)},
+  }};
+  std::array<std::uint32_t, 2> counts{};
+
+  CubicFlattenSegmentCounts(cubics, 0.25, 1024, counts);
+  EXPECT_THAT(counts, ElementsAre(1u, 1u));
+}
+
+TEST(BezierUtils, CubicFlattenSegmentCountsFollowsWangBound) {
+  // Both second differences are (0, -100), so n = ceil(sqrt(0.75 * 100 / tolerance)).
+  const std::array<std::array<Vector2d, 4>, 5> cubics = {{
+      {Vector2d(0, 0), Vector2d(50, 100), Vector2d(100, 100), Vector2d(150, 0)},
+      {Vector2d(0, 0), Vector2d(50, 100), Vector2d(100, 100), Vector2d(150, 0)},
+      {Vector2d(0, 0), Vector2d(50, 100), Vector2d(100, 100), Vector2d(150, 0)},
+      {Vector2d(0, 0), Vector2d(0, 1e6), Vector2d(1e6, 1e6), Vector2d(1e6, 0)},
+      {Vector2d(0, 0), Vector2d(std::nan(""), 0), Vector2d(1, 1), Vector2d(2, 0)},
+  }};
+  std::array<std::uint32_t, 5> counts{};
+
+  CubicFlattenSegmentCounts(std::span(cubics).first(1), 0.25, 1024, std::span(counts).first(1));
+  CubicFlattenSegmentCounts(std::span(cubics).subspan(1, 1), 3.0, 1024,
+                            std::span(counts).subspan(1, 1));
+  CubicFlattenSegmentCounts(std::span(cubics).subspan(2), 0.01, 1024,
+                            std::span(counts).subspan(2));
+  EXPECT_EQ(counts[0], 18u);
+  EXPECT_EQ(counts[1], 5u);
+  EXPECT_EQ(counts[2], 87u);
+  // Clamped to the maximum, including for non-finite input.
+  EXPECT_EQ(counts[3], 1024u);
+  EXPECT_EQ(counts[4], 1024u);
+}
+
+TEST(BezierUtils, CubicFlattenSegmentCountsClampsDegenerateTolerance) {
+  const std::array<std::array<Vector2d, 4>, 2> cubics = {{
+      {Vector2d(0, 0), Vector2d(1, 0), Vector2d(2, 0), Vector2d(3, 0)},
+      {Vector2d(0, 0), Vector2d(50, 100), Vector2d(100, 100), Vector2d(150, 0)},
+  }};
+  constexpr std::uint32_t kMaximumSegments = 1u << 20;
+  std::array<std::uint32_t, 2> atMinimum{};
+  CubicFlattenSegmentCounts(cubics, kMinimumFlattenTolerance, kMaximumSegments, atMinimum);
+  EXPECT_EQ(atMinimum[0], 1u);
+  EXPECT_EQ(atMinimum[1], 8661u);
+
+  // Zero, negative, NaN and tiny tolerances behave like the minimum instead of requesting the
+  // maximum number of segments, even for a straight curve.
+  for (const double tolerance : {0.0, -1.0, std::nan(""), 1e-12}) {
+    std::array<std::uint32_t, 2> counts{};
+    CubicFlattenSegmentCounts(cubics, tolerance, kMaximumSegments, counts);
+    EXPECT_EQ(counts, atMinimum) << "tolerance=" << tolerance;
+  }
+}
+
+TEST(BezierUtils, FlattenCubicsUniformMatchesEvalCubic) {
+  // Six curves covers a full batch and a partial one.
+  const std::array<std::array<Vector2d, 4>, 6> cubics = {{
+      {Vector2d(0, 0), Vector2d(0, 100), Vector2d(100, 100), Vector2d(100, 0)},
+      {Vector2d(100, 0), Vector2d(150, -50), Vector2d(200, 50), Vector2d(250, 0)},
+      {Vector2d(-3, 7), Vector2d(12, -4), Vector2d(1, 9), Vector2d(8, 8)},
+      {Vector2d(0, 0), Vector2d(1, 0), Vector2d(2, 0), Vector2d(3, 0)},
+      {Vector2d(10, 10), Vector2d(20, 40), Vector2d(-30, 40), Vector2d(10, 10)},
+      {Vector2d(1e3, 1e3), Vector2d(2e3, 0), Vector2d(0, 0), Vector2d(1e3, 2e3)},
+  }};
+  const std::array<std::uint32_t, 6> counts = {8, 3, 17, 1, 64, 1024};
+
+  std::vector<Vector2d> points;
+  FlattenCubicsUniform(cubics, counts, points);
+
+  std::size_t index = 0;
+  for (std::size_t i = 0; i < cubics.size(); ++i) {
+    const auto& [p0, p1, p2, p3] = cubics[i];
+    for (std::uint32_t k = 1; k <= counts[i]; ++k, ++index) {
+      ASSERT_LT(index, points.size());
+      const double t = static_cast<double>(k) / static_cast<double>(counts[i]);
+      ExpectNear(points[index], EvalCubic(p0, p1, p2, p3, t), 1e-6);
+    }
+    // The end point is emitted exactly, so consecutive curves join without gaps.
+    EXPECT_EQ(points[index - 1], p3);
+  }
+  EXPECT_EQ(index, points.size());
+}
+
+TEST(BezierUtils, FlattenCubicsUniformStaysWithinTolerance) {
+  const std::array<std::array<Vector2d, 4>, 3> cubics = {{
+      {Vector2d(0, 0), Vector2d(0, 100), Vector2d(100, 100), Vector2d(100, 0)},
+      {Vector2d(0, 0), Vector2d(300, 200), Vector2d(-200, 200), Vector2d(100, 0)},
+      {Vector2d(0, 0), Vector2d(100, 100), Vector2d(0, 100), Vector2d(100, 0)},
+  }};
+
+  for (const double tolerance : {0.01, 0.25, 2.0}) {
+    std::array<std::uint32_t, 3> counts{};
+    CubicFlattenSegmentCounts(cubics, tolerance, 1u << 20, counts);
+    std::vector<Vector2d> points;
+    FlattenCubicsUniform(cubics, counts, points);
+
+    std::size_t index = 0;
+    for (std::size_t i = 0; i < cubics.size(); ++i) {
+      const auto& [p0, p1, p2, p3] = cubics[i];
+      Vector2d segmentStart = p0;
+      for (std::uint32_t k = 0; k < counts[i]; ++k, ++index) {
+        const Vector2d& segmentEnd = points[index];
+        // Sample the curve between the segment endpoints and measure the distance to the chord.
+        for (int j = 1; j < 8; ++j) {
+          const double t =
+              (static_cast<double>(k) + j / 8.0) / static_cast<double>(counts[i]);
+          const Vector2d curvePoint = EvalCubic(p0, p1, p2, p3, t);
+          const Vector2d chord = segmentEnd - segmentStart;
+          const double u = std::clamp((curvePoint - segmentStart).dot(chord) /
+                                          std::max(chord.lengthSquared(), 1e-300),
+                                      0.0, 1.0);
+          EXPECT_LE((segmentStart + chord * u - curvePoint).length(), tolerance * (1.0 + 1e-9))
+              << "curve " << i << " segment " << k << " tolerance " << tolerance;
+        }
+        segmentStart = segmentEnd;
+      }
+    }
+  }
+}
+
 }  // namespace donner
@@ -0,0 +1,69 @@
+#include "donner/base/ContentHash.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace donner {
+namespace {
+
+TEST(ContentHash, EqualInputsHashEqual) {
+  EXPECT_EQ(ContentHash::Of("hello world"), ContentHash::Of(std::string("hello world")));
+  EXPECT_EQ(ContentHash::Of("").size, 0u);
+  EXPECT_EQ(ContentHash::Of("hello world").size, 11u);
+}
+
+TEST(ContentHash, DifferentInputsHashDifferent) {
+  EXPECT_NE(ContentHash::Of("hello world"), ContentHash::Of("hello World"));
+  EXPECT_NE(ContentHash::Of("ab"), ContentHash::Of(std::string("ab\0", 3)));
+  EXPECT_NE(ContentHash::Of(""), ContentHash::Of(std::string("\0", 1)));
+
+  // Every single-byte flip in a word-aligned buffer changes both lanes.
+  std::vector<std::uint8_t> bytes(64, 0x5A);
+  const ContentHash base = ContentHash::Of(bytes);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] ^= 0x01;
+    const ContentHash flipped = ContentHash::Of(bytes);
+    EXPECT_NE(flipped.high, base.high) << i;
+    EXPECT_NE(flipped.low, base.low) << i;
+    bytes[i] ^= 0x01;
+  }
+}
+
+TEST(ContentHash, IncrementalMatchesOneShotForAnyChunking) {
+  std::vector<std::uint8_t> bytes;
+  for (int i = 0; i < 100; ++i) {
+    bytes.push_back(static_cast<std::uint8_t>(i * 37 + 11));
+  }
+  const ContentHash expected = ContentHash::Of(bytes);
+
+  for (size_t chunk = 1; chunk <= 17; ++chunk) {
+    ContentHasher hasher;
+    for (size_t offset = 0; offset < bytes.size(); offset += chunk) {
+      const size_t length = std::min(chunk, bytes.size() - offset);
+      hasher.update(std::span<const std::uint8_t>(bytes).subspan(offset, length));
+    }
+    EXPECT_EQ(hasher.finish(), expected) << "chunk size " << chunk;
+  }
+}
+
+TEST(ContentHash, NoCollisionsAcrossSmallInputs) {
+  std::unordered_set<ContentHash> seen;
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_TRUE(seen.insert(ContentHash::Of(std::to_string(i))).second) << i;
+  }
+}
+
+TEST(ContentHash, OstreamOutput) {
+  std::ostringstream stream;
+  stream << ContentHash{0x1, 0xABCDEF, 42};
+  EXPECT_EQ(stream.str(), "ContentHash(00000000000000010000000000abcdef, 42 bytes)");
+}
+
+}  // namespace
+}  // namespace donner
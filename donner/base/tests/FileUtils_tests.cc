@@ -40,6 +40,36 @@ TEST(FileUtilsTest, ReportsMissingFile) {
   EXPECT_THAT(ReadFileBounded(path, 4), VariantWith<FileReadError>(FileReadError::OpenFailed));
 }
 
+TEST(FileUtilsTest, MapsFileContents) {
+  const std::filesystem::path path = WriteTestFile("mapped.bin", "mapped contents");
+  FileMapResult result = MapFileBounded(path, 64);
+  ASSERT_TRUE(std::holds_alternative<std::shared_ptr<const MappedFile>>(result));
+  const std::shared_ptr<const MappedFile>& file =
+      std::get<std::shared_ptr<const MappedFile>>(result);
+  EXPECT_EQ(file->view(), "mapped contents");
+  EXPECT_EQ(file->size(), 15u);
+#ifndef _WIN32
+  EXPECT_TRUE(file->isMapped());
+#endif
+}
+
+TEST(FileUtilsTest, MapsEmptyFile) {
+  const std::filesystem::path path = WriteTestFile("mapped-empty.bin", "");
+  FileMapResult result = MapFileBounded(path, 64);
+  ASSERT_TRUE(std::holds_alternative<std::shared_ptr<const MappedFile>>(result));
+  const std::shared_ptr<const MappedFile>& file =
+      std::get<std::shared_ptr<const MappedFile>>(result);
+  EXPECT_TRUE(file->bytes().empty());
+  EXPECT_FALSE(file->isMapped());
+}
+
+TEST(FileUtilsTest, MapRejectsFileOverLimit) {
+  const std::filesystem::path path = WriteTestFile("mapped-too-large.bin", "tests");
+  EXPECT_THAT(MapFileBounded(path, 4), VariantWith<FileReadError>(FileReadError::TooLarge));
+  EXPECT_THAT(MapFileBounded(std::filesystem::path(testing::TempDir()) / "mapped-missing.bin", 4),
+              VariantWith<FileReadError>(FileReadError::OpenFailed));
+}
+
 #ifndef _WIN32
 TEST(FileUtilsTest, ReadsRegularFileThroughSymlink) {
   const std::filesystem::path target = WriteTestFile("bounded-symlink-target.txt", "test");
@@ -1576,6 +1576,29 @@ TEST(PathOpsTest, DeterministicCurvedCommandOrder) {
   EXPECT_EQ(PathData(first), PathData(second));
 }
 
+TEST(PathOpsTest, UnionOfManyOverlappingInputsTracesOneContour) {
+  // A staircase of overlapping squares: each one only meets its neighbours, so almost every
+  // segment pair and every input is far from the edge being classified.
+  constexpr int kSquares = 200;
+  std::vector<PathBooleanInput> inputs;
+  for (int i = 0; i < kSquares; ++i) {
+    inputs.push_back(Input(RectPath(i * 5.0, i * 5.0, 8.0, 8.0)));
+  }
+
+  const PathBooleanResult result = ApplyPathBoolean(PathBooleanOp::Union, inputs);
+
+  ASSERT_EQ(result.status, PathBooleanStatus::Ok) << Diagnostics(result);
+  ASSERT_EQ(result.paths.size(), 1u);
+  const Path& path = result.paths.front();
+  EXPECT_THAT(path, CommandCountIs(Path::Verb::MoveTo, 1u));
+  EXPECT_THAT(path, CommandCountIs(Path::Verb::ClosePath, 1u));
+  EXPECT_THAT(path, CommandCountIs(Path::Verb::LineTo, 4u * kSquares - 1u));
+  EXPECT_THAT(path, IsInside(Vector2d(1, 1)));
+  EXPECT_THAT(path, IsInside(Vector2d(kSquares * 5.0 + 2.0, kSquares * 5.0 + 2.0)));
+  EXPECT_THAT(path, IsOutside(Vector2d(12, 2)));
+  EXPECT_THAT(path, IsOutside(Vector2d(2, 12)));
+}
+
 TEST(PathOpsTest, DuplicateInputShortcutRespectsOutputCommandCap) {
   // The duplicate-input shortcut returns the shared path directly, but must
   // still honor the output command cap.
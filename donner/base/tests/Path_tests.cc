@@ -6,9 +6,11 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <random>
 #include <sstream>
 #include <vector>
 
+#include "donner/base/BezierUtils.h"
 #include "donner/base/MathUtils.h"
 
 namespace donner {
@@ -22,6 +24,15 @@ namespace {
 /// device-aware value instead - see `Path::kLocalFlattenTolerance`.
 constexpr double kFlattenTolerance = Path::kLocalFlattenTolerance;
 
+/// Distance from \p point to the segment from \p a to \p b.
+double DistanceToSegment(const Vector2d& point, const Vector2d& a, const Vector2d& b) {
+  const Vector2d ab = b - a;
+  const double lengthSquared = ab.lengthSquared();
+  const double t =
+      lengthSquared > 0.0 ? std::clamp((point - a).dot(ab) / lengthSquared, 0.0, 1.0) : 0.0;
+  return (point - (a + ab * t)).length();
+}
+
 MATCHER_P(PathCommandVerbIs, expectedVerb, "") {
   return testing::ExplainMatchResult(testing::Eq(expectedVerb), arg.verb, result_listener);
 }
@@ -491,6 +502,41 @@ TEST(Path, FlattenFlatCurvesUseSingleLineSegments) {
   EXPECT_EQ(lineCount, 2u);
 }
 
+TEST(Path, FlattenLongCurveRunsKeepEveryEndPoint) {
+  // More consecutive curves than one flattening batch, alternating verbs.
+  PathBuilder builder;
+  builder.moveTo({0, 0});
+  std::vector<Vector2d> endPoints;
+  for (int i = 1; i <= 37; ++i) {
+    const double x = 10.0 * i;
+    if (i % 3 == 0) {
+      builder.quadTo({x - 5.0, 8.0}, {x, 0});
+    } else {
+      builder.curveTo({x - 7.0, -6.0}, {x - 3.0, 6.0}, {x, 0});
+    }
+    endPoints.push_back({x, 0});
+  }
+  builder.lineTo({400, 20}).closePath();
+  const Path path = builder.build();
+
+  const Path result = path.flatten(0.05);
+
+  std::size_t nextEndPoint = 0;
+  std::size_t closeCount = 0;
+  result.forEach([&](Path::Verb verb, std::span<const Vector2d> points) {
+    EXPECT_TRUE(verb == Path::Verb::MoveTo || verb == Path::Verb::LineTo ||
+                verb == Path::Verb::ClosePath);
+    if (verb == Path::Verb::ClosePath) {
+      ++closeCount;
+    } else if (nextEndPoint < endPoints.size() && points[0] == endPoints[nextEndPoint]) {
+      ++nextEndPoint;
+    }
+  });
+  EXPECT_EQ(nextEndPoint, endPoints.size());
+  EXPECT_EQ(closeCount, 1u);
+  EXPECT_GT(result.verbCount(), path.verbCount());
+}
+
 TEST(Path, FlattenZeroToleranceFailsClosedAtSubdivisionDepthLimit) {
   Path path = PathBuilder()
                   .moveTo({0, 0})
@@ -512,6 +558,56 @@ TEST(Path, FlattenPositiveToleranceEmitsBoundedApproximationAtSubdivisionDepthLi
   EXPECT_FALSE(path.strokeToFill({.width = 1.0}, 1e-4).empty());
 }
 
+TEST(Path, FlattenStaysWithinToleranceOfTheCurve) {
+  // Every point sampled on a random curve must lie within the tolerance of its polyline.
+  std::mt19937 rng(37);
+  std::uniform_real_distribution<double> coordinate(-200.0, 200.0);
+  const auto randomPoint = [&] { return Vector2d(coordinate(rng), coordinate(rng)); };
+
+  for (const double tolerance : {0.01, 0.25, 2.0}) {
+    for (int iteration = 0; iteration < 40; ++iteration) {
+      const bool quadratic = iteration % 3 == 0;
+      const Vector2d p0 = randomPoint();
+      const Vector2d p1 = randomPoint();
+      const Vector2d p2 = randomPoint();
+      const Vector2d p3 = randomPoint();
+
+      PathBuilder builder;
+      builder.moveTo(p0);
+      if (quadratic) {
+        builder.quadTo(p1, p2);
+      } else {
+        builder.curveTo(p1, p2, p3);
+      }
+
+      std::vector<Vector2d> polyline;
+      builder.build().flatten(tolerance).forEach(
+          [&](Path::Verb, std::span<const Vector2d> points) {
+            if (!points.empty()) {
+              polyline.push_back(points[0]);
+            }
+          });
+      ASSERT_GE(polyline.size(), 2u);
+
+      double maxDeviation = 0.0;
+      constexpr int kSamples = 400;
+      for (int i = 0; i <= kSamples; ++i) {
+        const double t = static_cast<double>(i) / kSamples;
+        const Vector2d onCurve =
+            quadratic ? EvalQuadratic(p0, p1, p2, t) : EvalCubic(p0, p1, p2, p3, t);
+        double nearest = std::numeric_limits<double>::infinity();
+        for (std::size_t s = 1; s < polyline.size(); ++s) {
+          nearest = std::min(nearest, DistanceToSegment(onCurve, polyline[s - 1], polyline[s]));
+        }
+        maxDeviation = std::max(maxDeviation, nearest);
+      }
+      EXPECT_LE(maxDeviation, tolerance)
+          << "tolerance=" << tolerance << " iteration=" << iteration << " with "
+          << polyline.size() - 1 << " segments";
+    }
+  }
+}
+
 // =============================================================================
 // pointsPerVerb
 // =============================================================================
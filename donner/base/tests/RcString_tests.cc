@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <unordered_map>
 
 #include "donner/base/Utils.h"
@@ -634,4 +635,32 @@ TEST(RcString, ViewLifetimeContract) {
 #endif
 }
 
+TEST(RcString, FromSharedBufferReferencesBufferInPlace) {
+  auto buffer = std::make_shared<const std::string>(
+      "prefix: this value is longer than the small-string optimization threshold");
+  const std::string_view view = std::string_view(*buffer).substr(8);
+
+  RcString str = RcString::fromSharedBuffer(buffer, view);
+  EXPECT_EQ(str, view);
+  EXPECT_EQ(static_cast<const void*>(str.data()), static_cast<const void*>(view.data()));
+
+  // Substrings share the reference, and keep the buffer alive after the original is gone.
+  RcString slice = str.substr(5, 40);
+  EXPECT_EQ(static_cast<const void*>(slice.data()), static_cast<const void*>(view.data() + 5));
+  std::weak_ptr<const std::string> weakBuffer = buffer;
+  buffer.reset();
+  str = RcString();
+  EXPECT_FALSE(weakBuffer.expired());
+  EXPECT_EQ(slice, view.substr(5, 40));
+
+  slice = RcString();
+  EXPECT_TRUE(weakBuffer.expired());
+
+  // Short strings are copied inline and hold no reference.
+  auto smallBuffer = std::make_shared<const std::string>("tiny");
+  const RcString small = RcString::fromSharedBuffer(smallBuffer, *smallBuffer);
+  EXPECT_EQ(small, "tiny");
+  EXPECT_EQ(smallBuffer.use_count(), 1);
+}
+
 }  // namespace donner
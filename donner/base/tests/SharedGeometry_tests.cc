@@ -0,0 +1,120 @@
+#include "donner/base/SharedGeometry.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace donner {
+namespace {
+
+using ::testing::ElementsAre;
+
+Path MakeTriangle(double offset) {
+  return PathBuilder()
+      .moveTo({offset, 0.0})
+      .lineTo({offset + 10.0, 0.0})
+      .lineTo({offset + 5.0, 8.0})
+      .closePath()
+      .build();
+}
+
+}  // namespace
+
+TEST(SharedGeometry, StoresVerbsAndNarrowedPoints) {
+  const Path path = PathBuilder()
+                        .moveTo({0.1, 0.2})
+                        .quadTo({1.0, 2.0}, {3.0, 4.0})
+                        .curveTo({5.0, 6.0}, {7.0, 8.0}, {9.0, 10.0})
+                        .closePath()
+                        .build();
+
+  const SharedGeometry geometry(path);
+  EXPECT_THAT(geometry.verbs(), ElementsAre(Path::Verb::MoveTo, Path::Verb::QuadTo,
+                                            Path::Verb::CurveTo, Path::Verb::ClosePath));
+  ASSERT_EQ(geometry.points().size(), 6u);
+  EXPECT_EQ(geometry.points()[0], Vector2f(0.1f, 0.2f));
+  EXPECT_EQ(geometry.points()[5], Vector2f(9.0f, 10.0f));
+  EXPECT_GT(geometry.storageBytes(), 0u);
+}
+
+TEST(SharedGeometry, IdenticalOutlinesInternToOneBuffer) {
+  const std::shared_ptr<const SharedGeometry> first = SharedGeometry::Intern(MakeTriangle(0.0));
+  const std::shared_ptr<const SharedGeometry> second = SharedGeometry::Intern(MakeTriangle(0.0));
+  const std::shared_ptr<const SharedGeometry> other = SharedGeometry::Intern(MakeTriangle(1.0));
+
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, other);
+  EXPECT_EQ(first->hash(), second->hash());
+  EXPECT_NE(first->hash(), other->hash());
+  EXPECT_TRUE(first->contentEquals(*second));
+  EXPECT_FALSE(first->contentEquals(*other));
+}
+
+/// ContentHash is not collision resistant, so outlines filed under the same digest must still only
+/// be shared when their content matches, and must not see each other's derived values.
+TEST(SharedGeometry, HashCollisionDoesNotShare) {
+  static constexpr SharedGeometry::DerivedTag kFirstPoint{"first point"};
+  const ContentHash forged{.high = 0x5eed, .low = 0xc011, .size = 33};
+
+  const std::shared_ptr<const SharedGeometry> first =
+      SharedGeometry::InternWithHashForTesting(MakeTriangle(40.0), forged);
+  const std::shared_ptr<const SharedGeometry> colliding =
+      SharedGeometry::InternWithHashForTesting(MakeTriangle(41.0), forged);
+  const std::shared_ptr<const SharedGeometry> same =
+      SharedGeometry::InternWithHashForTesting(MakeTriangle(40.0), forged);
+
+  EXPECT_EQ(first->hash(), colliding->hash());
+  EXPECT_NE(first, colliding);
+  EXPECT_EQ(first, same);
+
+  const auto firstPoint = [](const SharedGeometry& geometry) {
+    return [&geometry] { return geometry.points()[0]; };
+  };
+  EXPECT_EQ(*first->derived<Vector2f>(kFirstPoint, firstPoint(*first)), Vector2f(40.0f, 0.0f));
+  EXPECT_EQ(*colliding->derived<Vector2f>(kFirstPoint, firstPoint(*colliding)),
+            Vector2f(41.0f, 0.0f));
+}
+
+TEST(SharedGeometry, ReleasedOutlinesLeaveTheTable) {
+  const std::size_t before = SharedGeometry::InternedCountForTesting();
+  {
+    const std::shared_ptr<const SharedGeometry> geometry =
+        SharedGeometry::Intern(MakeTriangle(123.0));
+    EXPECT_EQ(SharedGeometry::InternedCountForTesting(), before + 1);
+
+    const std::weak_ptr<const SharedGeometry> weak = geometry;
+    EXPECT_FALSE(weak.expired());
+  }
+  EXPECT_EQ(SharedGeometry::InternedCountForTesting(), before);
+}
+
+TEST(SharedGeometry, DerivedValuesAreBuiltOncePerTag) {
+  static constexpr SharedGeometry::DerivedTag kPointCount{"point count"};
+  static constexpr SharedGeometry::DerivedTag kVerbCount{"verb count"};
+
+  const std::shared_ptr<const SharedGeometry> geometry = SharedGeometry::Intern(MakeTriangle(0.0));
+  int builds = 0;
+  const auto countPoints = [&] {
+    ++builds;
+    return geometry->points().size();
+  };
+
+  const std::shared_ptr<const std::size_t> first =
+      geometry->derived<std::size_t>(kPointCount, countPoints);
+  const std::shared_ptr<const std::size_t> second =
+      geometry->derived<std::size_t>(kPointCount, countPoints);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(*first, 3u);
+  EXPECT_EQ(builds, 1);
+
+  // Another entity interning the same outline sees the same derived value.
+  const std::shared_ptr<const SharedGeometry> again = SharedGeometry::Intern(MakeTriangle(0.0));
+  EXPECT_EQ(again->derived<std::size_t>(kPointCount, countPoints), first);
+  EXPECT_EQ(builds, 1);
+
+  EXPECT_EQ(*geometry->derived<std::size_t>(kVerbCount, [&] { return geometry->verbs().size(); }),
+            4u);
+}
+
+}  // namespace donner
@@ -0,0 +1,92 @@
+#include "donner/base/WorkerPool.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace donner {
+
+using testing::Each;
+using testing::ElementsAre;
+
+TEST(WorkerPool, SingleThreadRunsOnCaller) {
+  WorkerPool pool(1);
+  EXPECT_EQ(pool.threadCount(), 1u);
+
+  const std::thread::id caller = std::this_thread::get_id();
+  std::vector<std::size_t> workers;
+  pool.run(4, [&](std::size_t worker) {
+    EXPECT_EQ(std::this_thread::get_id(), caller);
+    workers.push_back(worker);
+  });
+  EXPECT_THAT(workers, ElementsAre(0u));
+}
+
+TEST(WorkerPool, ZeroThreadsIsOne) {
+  WorkerPool pool(0);
+  EXPECT_EQ(pool.threadCount(), 1u);
+}
+
+TEST(WorkerPool, RunsEachWorkerOnce) {
+  WorkerPool pool(4);
+  EXPECT_EQ(pool.threadCount(), 4u);
+
+  const std::thread::id caller = std::this_thread::get_id();
+  std::vector<std::atomic<int>> calls(4);
+  pool.run(4, [&](std::size_t worker) {
+    EXPECT_EQ(worker == 0, std::this_thread::get_id() == caller) << worker;
+    ++calls[worker];
+  });
+  for (const std::atomic<int>& count : calls) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(WorkerPool, FewerWorkersThanThreads) {
+  WorkerPool pool(4);
+  std::vector<std::atomic<int>> calls(4);
+  pool.run(2, [&](std::size_t worker) { ++calls[worker]; });
+  EXPECT_EQ(calls[0].load(), 1);
+  EXPECT_EQ(calls[1].load(), 1);
+  EXPECT_EQ(calls[2].load(), 0);
+  EXPECT_EQ(calls[3].load(), 0);
+
+  // Clamped to the pool size.
+  pool.run(16, [&](std::size_t worker) { ++calls[worker]; });
+  EXPECT_EQ(calls[3].load(), 1);
+}
+
+/// Threads are reused across many short jobs, and every job has finished when run() returns.
+TEST(WorkerPool, ReusedAcrossJobs) {
+  WorkerPool pool(3);
+  std::vector<int> results(3, 0);
+  for (int job = 0; job < 500; ++job) {
+    pool.run(1 + job % 3, [&](std::size_t worker) { results[worker] = job; });
+    EXPECT_EQ(results[0], job);
+    if (job % 3 == 2) {
+      EXPECT_THAT(results, Each(job));
+    }
+  }
+}
+
+TEST(WorkerPool, RunFromSeveralThreads) {
+  WorkerPool pool(3);
+  std::atomic<int> total = 0;
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i) {
+    callers.emplace_back([&] {
+      for (int job = 0; job < 50; ++job) {
+        pool.run(3, [&](std::size_t) { ++total; });
+      }
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(total.load(), 4 * 50 * 3);
+}
+
+}  // namespace donner
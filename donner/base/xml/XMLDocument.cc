@@ -2920,4 +2920,11 @@ void XMLDocument::setSource(std::string source, std::size_t maximumSourceSize) {
   context.sourceDiagnostic.reset();
 }
 
+void XMLDocument::setSharedSource(RcString source, std::size_t maximumSourceSize) {
+  XMLDocumentContext& context = registry_->ctx().get<XMLDocumentContext>();
+  context.sourceStore = std::make_shared<XMLSourceStore>(
+      XMLSourceStore::FromSharedSource(std::move(source), maximumSourceSize));
+  context.sourceDiagnostic.reset();
+}
+
 }  // namespace donner::xml
@@ -277,6 +277,15 @@ public:
    */
   void setSource(std::string source, std::size_t maximumSourceSize = 16 * 1024 * 1024);
 
+  /**
+   * Install source text for this document that is referenced in place rather than copied, see
+   * \ref XMLSourceStore::FromSharedSource.
+   *
+   * @param source XML source text, typically referencing a memory-mapped file.
+   * @param maximumSourceSize Maximum source size retained after later structured edits.
+   */
+  void setSharedSource(RcString source, std::size_t maximumSourceSize = 16 * 1024 * 1024);
+
 private:
   /// Internal constructor used to rehydrate an XMLDocument from an existing Registry.
   explicit XMLDocument(std::shared_ptr<Registry> registry);
@@ -20,6 +20,7 @@
 #include "donner/base/xml/XMLDocument.h"
 #include "donner/base/xml/XMLNode.h"
 #include "donner/base/xml/XMLQualifiedName.h"
+#include "donner/base/xml/components/AttributesComponent.h"
 #include "donner/base/xml/components/EntityDeclarationsContext.h"
 #include "donner/base/xml/components/XMLDocumentContext.h"
 
@@ -266,6 +267,9 @@ private:
   /// Remaining characters from \ref str_, potentially modified for entity resolution.
   ChunkedString remaining_;
 
+  /// \ref str_ as a shared buffer that parsed values can reference, or empty if values are copied.
+  RcString sharedSource_;
+
   XMLParser::Options options_;
   std::optional<parser::LineOffsets> lineOffsets_;
 
@@ -285,7 +289,14 @@ private:
   int nestingDepth_ = 0;
 
 public:
-  explicit XMLParserImpl(std::string_view text, const XMLParser::Options& options)
+  /**
+   * @param text Input to parse.
+   * @param options Parser options.
+   * @param sharedText If set, \p text held in a shared buffer: the source store and parsed values
+   *   reference it in place instead of copying it.
+   */
+  explicit XMLParserImpl(std::string_view text, const XMLParser::Options& options,
+                         const RcString* sharedText = nullptr)
       : entityCtx_(document_.registry().ctx().emplace<components::EntityDeclarationsContext>()),
         str_(text),
         remaining_(text),
@@ -298,13 +309,36 @@ public:
         maxEntityDeclarations_(options.maxEntityDeclarations),
         maxEntityDeclarationBytes_(options.maxEntityDeclarationBytes),
         maxNestingDepth_(options.maxNestingDepth) {
-    document_.setSource(std::string(text), options.maximumInputSize);
+    if (sharedText != nullptr) {
+      sharedSource_ = *sharedText;
+      document_.setSharedSource(*sharedText, options.maximumInputSize);
+    } else {
+      document_.setSource(std::string(text), options.maximumInputSize);
+    }
     auto& documentContext = document_.registry().ctx().get<components::XMLDocumentContext>();
     documentContext.maximumSourceEditTreeNodes = options.maxElements;
     documentContext.maximumSourceEditTreeDepth = options.maxNestingDepth;
     documentContext.maximumSourceEditTotalAttributes = options.maxTotalAttributes;
   }
 
+  /**
+   * Flatten \p str into an RcString for a parsed value. With a shared source, a value that is a
+   * single slice of the input references it in place instead of being copied.
+   *
+   * @param str Parsed value.
+   */
+  RcString toValueString(const ChunkedString& str) const {
+    if (!sharedSource_.empty()) {
+      if (const std::optional<std::string_view> view = str.singleChunkView();
+          view && view->data() >= str_.data() &&
+          view->data() + view->size() <= str_.data() + str_.size()) {
+        return sharedSource_.substr(static_cast<size_t>(view->data() - str_.data()), view->size());
+      }
+    }
+
+    return str.toSingleRcString();
+  }
+
   bool isWhitespace(char ch) const {
     // Whitespace is defined by multiple specs, but both match.
     //
@@ -882,7 +916,13 @@ private:
       {
         ChunkedString rawChunk = consumeMatching<MatchPredicateNoEntity>(sourceString);
         if (!rawChunk.empty()) {
-          decodedText.append(rawChunk);
+          if (decodedText.empty()) {
+            // Keep a leading run as a slice of the input, so a value without entities stays a
+            // single slice that \ref toValueString can reference in place.
+            decodedText = rawChunk;
+          } else {
+            decodedText.append(rawChunk);
+          }
           previousPrependRemaining -= Min(previousPrependRemaining, rawChunk.size());
         }
       }
@@ -1122,7 +1162,7 @@ private:
       if (auto maybeError = countTreeNode(startOffset)) {
         return std::move(maybeError.value());
       }
-      XMLNode commentNode = XMLNode::CreateCommentNode(document_, commentStr.toSingleRcString());
+      XMLNode commentNode = XMLNode::CreateCommentNode(document_, toValueString(commentStr));
       commentNode.setSourceStartOffset(startOffset);
       const FileOffset endOffset = currentOffset(remaining_);
       commentNode.setSourceEndOffset(endOffset);
@@ -1268,7 +1308,7 @@ private:
         return std::move(maybeError.value());
       }
       XMLNode pi = XMLNode::CreateProcessingInstructionNode(document_, piName.toSingleRcString(),
-                                                            piValue.toSingleRcString());
+                                                            toValueString(piValue));
       pi.setSourceStartOffset(startOffset);
       const FileOffset endOffset = currentOffset(remaining_);
       pi.setSourceEndOffset(endOffset);
@@ -1302,7 +1342,7 @@ private:
         return maybeError;
       }
 
-      const RcString dataStrAllocated = dataStr.toSingleRcString();
+      const RcString dataStrAllocated = toValueString(dataStr);
 
       // Create new data node
       XMLNode data = XMLNode::CreateDataNode(document_, dataStrAllocated);
@@ -1336,7 +1376,7 @@ private:
 
     const ChunkedString& cdataStr = maybeCData.value();
 
-    XMLNode cdata = XMLNode::CreateCDataNode(document_, cdataStr.toSingleRcString());
+    XMLNode cdata = XMLNode::CreateCDataNode(document_, toValueString(cdataStr));
     cdata.setSourceStartOffset(startOffset);
     const FileOffset endOffset = currentOffset(remaining_);
     cdata.setSourceEndOffset(endOffset);
@@ -1752,7 +1792,7 @@ private:
 
     ParsedAttribute result{
         .name = name,
-        .value = maybeValue.result().toSingleRcString(),
+        .value = toValueString(maybeValue.result()),
         .fullRange = SourceRange{attributeStartOffset, attributeEndOffset},
         .valueRange = SourceRange{valueStartOffset, valueEndOffset},
         .quote = quote,
@@ -1785,7 +1825,9 @@ private:
         ++attributeCount;
         ++totalAttributeCount_;
         const ParsedAttribute& attribute = maybeAttribute.result().value();
-        node.setAttribute(attribute.name, attribute.value);
+        // Store the parsed RcString itself, which may reference a shared source in place.
+        node.entityHandle().get_or_emplace<donner::components::AttributesComponent>().setAttribute(
+            document_.registry(), attribute.name, attribute.value);
         node.setAttributeSourceLocation(attribute.name, attribute.fullRange, attribute.valueRange,
                                         attribute.quote);
       } else {
@@ -1811,6 +1853,15 @@ ParseResult<XMLDocument> XMLParser::Parse(std::string_view str, const Options& o
   return parser.parse();
 }
 
+ParseResult<XMLDocument> XMLParser::ParseShared(const RcString& str, const Options& options) {
+  if (str.size() > options.maximumInputSize) {
+    return ParseDiagnostic::Error("XML source exceeds maximum input size", FileOffset::Offset(0));
+  }
+
+  XMLParserImpl parser(str, options, &str);
+  return parser.parse();
+}
+
 std::optional<SourceRange> XMLParser::GetAttributeLocation(
     std::string_view str, FileOffset elementStartOffset, const XMLQualifiedNameRef& attributeName) {
   if (!elementStartOffset.offset) {
@@ -6,6 +6,7 @@
 #include <string_view>
 
 #include "donner/base/ParseResult.h"
+#include "donner/base/RcString.h"
 #include "donner/base/xml/XMLDocument.h"
 #include "donner/base/xml/XMLNode.h"
 
@@ -141,6 +142,21 @@ public:
    */
   static ParseResult<XMLDocument> Parse(std::string_view str, const Options& options = Options());
 
+  /**
+   * Parse an XML document held in a shared buffer, such as a memory-mapped file wrapped by \ref
+   * RcString::fromSharedBuffer.
+   *
+   * Behaves like \ref Parse, but the document's source store and any parsed value longer than
+   * the short-string buffer (attribute values, text, comments) reference \p str in place instead
+   * of copying it, keeping the buffer alive while they are.
+   *
+   * @param str XML data to parse. Will not be modified.
+   * @param options Options to modify the parsing behavior.
+   * @return ParseResult containing the parsed XMLDocument, or an error if parsing failed.
+   */
+  static ParseResult<XMLDocument> ParseShared(const RcString& str,
+                                              const Options& options = Options());
+
   /**
    * Parse the XML attributes and get the source location of a specific attribute.
    *
@@ -158,6 +158,14 @@ XMLSourceStore::XMLSourceStore(std::string source, ResourceLimits limits)
   resourceLimits_.maximumSourceSize = std::max(resourceLimits_.maximumSourceSize, source_.size());
 }
 
+XMLSourceStore XMLSourceStore::FromSharedSource(RcString source, std::size_t maximumSourceSize) {
+  XMLSourceStore store(std::string(), ResourceLimits{.maximumSourceSize = maximumSourceSize});
+  store.resourceLimits_.maximumSourceSize = std::max(maximumSourceSize, source.size());
+  store.sharedSource_ = std::move(source);
+  store.usesSharedSource_ = true;
+  return store;
+}
+
 XMLSourceStore::ResourceStats XMLSourceStore::resourceStats() const {
   return ResourceStats{
       .liveAnchorCount = anchors_.size(),
@@ -171,7 +179,7 @@ XMLSourceStore::ResourceStats XMLSourceStore::resourceStats() const {
 }
 
 bool XMLSourceStore::setResourceLimits(ResourceLimits limits) {
-  if (limits.maximumSourceSize < source_.size() ||
+  if (limits.maximumSourceSize < source().size() ||
       limits.maximumLiveAnchorCount < anchors_.size()) {
     return false;
   }
@@ -250,10 +258,11 @@ void XMLSourceStore::invalidateAnchor(SourceAnchorId id) {
 
 std::optional<XMLSourceDelta> XMLSourceStore::replace(std::size_t offset, std::size_t length,
                                                       std::string_view replacement) {
-  if (!ReplacementRangeIsValid(source_.size(), offset, length)) {
+  const std::size_t sourceSize = source().size();
+  if (!ReplacementRangeIsValid(sourceSize, offset, length)) {
     return std::nullopt;
   }
-  if (!ReplacementFitsLimit(source_.size(), length, replacement.size(),
+  if (!ReplacementFitsLimit(sourceSize, length, replacement.size(),
                             resourceLimits_.maximumSourceSize)) {
     return std::nullopt;
   }
@@ -269,6 +278,12 @@ std::optional<XMLSourceDelta> XMLSourceStore::replace(std::size_t offset, std::s
     return std::nullopt;
   }
 
+  if (usesSharedSource_) {
+    source_.assign(std::string_view(sharedSource_));
+    sharedSource_ = RcString();
+    usesSharedSource_ = false;
+  }
+
   source_.replace(offset, length, replacement);
   ++sourceVersion_;
 
@@ -293,7 +308,7 @@ FileOffset XMLSourceStore::resolveLineInfo(FileOffset offset) const {
   }
 
   if (!lineOffsets_.has_value() || lineOffsetsVersion_ != sourceVersion_) {
-    lineOffsets_.emplace(std::string_view(source_));
+    lineOffsets_.emplace(source());
     lineOffsetsVersion_ = sourceVersion_;
   }
 
@@ -301,11 +316,12 @@ FileOffset XMLSourceStore::resolveLineInfo(FileOffset offset) const {
 }
 
 bool XMLSourceStore::isBoundary(std::size_t offset) const {
-  if (offset > source_.size()) {
+  const std::string_view current = source();
+  if (offset > current.size()) {
     return false;
   }
-  return offset == source_.size() ||
-         !IsContinuationByte(static_cast<unsigned char>(source_[offset]));
+  return offset == current.size() ||
+         !IsContinuationByte(static_cast<unsigned char>(current[offset]));
 }
 
 bool XMLSourceStore::IsValidUtf8(std::string_view value) {
@@ -10,6 +10,7 @@
 #include <unordered_map>
 
 #include "donner/base/FileOffset.h"
+#include "donner/base/RcString.h"
 #include "donner/base/Utils.h"
 #include "donner/base/parser/LineOffsets.h"
 
@@ -115,8 +116,25 @@ public:
    */
   XMLSourceStore(std::string source, ResourceLimits limits);
 
+  /**
+   * Construct a source store that references \p source in place instead of copying it, such as an
+   * RcString over a memory-mapped file from \ref RcString::fromSharedBuffer. The bytes are copied
+   * into owned storage on the first accepted edit.
+   *
+   * @param source Initial XML source text.
+   * @param maximumSourceSize Maximum source bytes retained after an edit.
+   */
+  static XMLSourceStore FromSharedSource(RcString source,
+                                         std::size_t maximumSourceSize = 16 * 1024 * 1024);
+
   /// Return the current source bytes.
-  [[nodiscard]] std::string_view source() const UTILS_LIFETIME_BOUND { return source_; }
+  [[nodiscard]] std::string_view source() const UTILS_LIFETIME_BOUND {
+    return usesSharedSource_ ? std::string_view(sharedSource_) : std::string_view(source_);
+  }
+
+  /// Return true while the source is still referenced from the buffer passed to
+  /// \ref FromSharedSource, i.e. it has not been edited.
+  [[nodiscard]] bool usesSharedSource() const { return usesSharedSource_; }
 
   /// Return the monotonically increasing source version.
   [[nodiscard]] std::uint64_t sourceVersion() const { return sourceVersion_; }
@@ -227,7 +245,12 @@ private:
   void recordCreatedAnchor();
   void recordRetiredAnchor();
 
+  /// Owned source bytes, unused while \ref usesSharedSource_ is set.
   std::string source_;
+  /// Unedited source bytes referenced in place, see \ref FromSharedSource.
+  RcString sharedSource_;
+  /// True if the source is \ref sharedSource_ rather than \ref source_.
+  bool usesSharedSource_ = false;
   ResourceLimits resourceLimits_;
   std::uint64_t sourceVersion_ = 0;
   std::uint32_t nextAnchorId_ = 1;
@@ -66,6 +66,19 @@ void AttributesComponent::setAttribute(Registry& registry, const xml::XMLQualifi
   }
 }
 
+void AttributesComponent::setAttributeFromView(Registry& registry,
+                                               const xml::XMLQualifiedNameRef& name,
+                                               std::string_view value) {
+  if (const auto existingIt = attributes_.find(name); existingIt != attributes_.end()) {
+    const std::string_view existing = existingIt->second.value;
+    if (existing.data() == value.data() && existing.size() == value.size()) {
+      return;
+    }
+  }
+
+  setAttribute(registry, name, RcString(value));
+}
+
 void AttributesComponent::removeAttribute(Registry& registry,
                                           const xml::XMLQualifiedNameRef& name) {
   const auto it = attributes_.find(name);
@@ -6,6 +6,7 @@
 #include <map>
 #include <optional>
 #include <set>
+#include <string_view>
 
 #include "donner/base/EcsRegistry.h"
 #include "donner/base/RcStringOrRef.h"
@@ -153,6 +154,21 @@ struct AttributesComponent {
   void setAttribute(Registry& registry, const xml::XMLQualifiedNameRef& name,
                     const RcString& value);
 
+  /**
+   * Set the value of an attribute from a view, like \ref setAttribute.
+   *
+   * If \p value is a view of the value already stored for \p name, the stored string is kept
+   * instead of being replaced by a copy. The XML parser stores every attribute before the SVG
+   * layer stores the ones it recognizes again from a view of the parsed value, and this keeps
+   * that value shared, including when it references the source buffer in place.
+   *
+   * @param registry Registry to use for the operation.
+   * @param name Name of the attribute to set.
+   * @param value New value to set.
+   */
+  void setAttributeFromView(Registry& registry, const xml::XMLQualifiedNameRef& name,
+                            std::string_view value);
+
   /**
    * Remove an attribute from the element.
    *
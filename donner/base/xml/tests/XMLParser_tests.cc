@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -3350,4 +3351,31 @@ TEST_F(XMLParserTests, EntityContainingNode) {
   EXPECT_EQ(elementNode->tagName(), "rect");
 }
 
+TEST_F(XMLParserTests, ParseSharedReferencesSourceInPlace) {
+  auto buffer = std::make_shared<const std::string>(
+      R"(<svg><path d="M 0 0 L 100 0 L 100 100 L 0 100 Z" fill="red"/></svg>)");
+  const RcString source = RcString::fromSharedBuffer(buffer, *buffer);
+
+  ParseResult<XMLDocument> maybeDocument = XMLParser::ParseShared(source);
+  ASSERT_THAT(maybeDocument, NoParseError());
+
+  XMLDocument document = std::move(maybeDocument.result());
+  ASSERT_NE(document.sourceStore(), nullptr);
+  EXPECT_TRUE(document.sourceStore()->usesSharedSource());
+  EXPECT_EQ(static_cast<const void*>(document.source().data()),
+            static_cast<const void*>(buffer->data()));
+
+  XMLNode path = document.root().firstChild()->firstChild().value();
+  std::optional<RcString> d = path.getAttribute("d");
+  ASSERT_TRUE(d.has_value());
+  EXPECT_EQ(*d, "M 0 0 L 100 0 L 100 100 L 0 100 Z");
+  EXPECT_EQ(static_cast<const void*>(d->data()),
+            static_cast<const void*>(buffer->data() + buffer->find("M 0 0")));
+  EXPECT_EQ(path.getAttribute("fill"), RcString("red"));
+
+  std::optional<SourceRange> location = path.getNodeLocation();
+  ASSERT_TRUE(location.has_value());
+  EXPECT_EQ(location->start.offset, std::optional<std::size_t>(5));
+}
+
 }  // namespace donner::xml
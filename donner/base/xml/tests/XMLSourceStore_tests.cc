@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -341,5 +342,28 @@ TEST(XMLSourceStore, RepeatedEditsBeforeSiblingDoNotRetargetSpan) {
   EXPECT_EQ(SpanText(store, *bSpan), "<b/>");
 }
 
+TEST(XMLSourceStore, SharedSourceIsReferencedUntilFirstEdit) {
+  auto buffer =
+      std::make_shared<const std::string>(R"(<svg><rect width="100" height="100"/></svg>)");
+  XMLSourceStore store =
+      XMLSourceStore::FromSharedSource(RcString::fromSharedBuffer(buffer, *buffer));
+  EXPECT_TRUE(store.usesSharedSource());
+  EXPECT_EQ(static_cast<const void*>(store.source().data()),
+            static_cast<const void*>(buffer->data()));
+
+  // Rejected edits leave the shared source in place.
+  EXPECT_FALSE(store.replace(1000, 0, "x").has_value());
+  EXPECT_TRUE(store.usesSharedSource());
+
+  std::optional<SourceAnchorSpan> span =
+      store.createSpan(5, 37, SourceAnchorBias::After, SourceAnchorBias::Before);
+  ASSERT_TRUE(span.has_value());
+  ASSERT_TRUE(store.replace(5, 0, "<g/>").has_value());
+  EXPECT_FALSE(store.usesSharedSource());
+  EXPECT_EQ(buffer.use_count(), 1);
+  EXPECT_EQ(store.source(), R"(<svg><g/><rect width="100" height="100"/></svg>)");
+  EXPECT_EQ(SpanText(store, *span), R"(<rect width="100" height="100"/>)");
+}
+
 }  // namespace
 }  // namespace donner::xml
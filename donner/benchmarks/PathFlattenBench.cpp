@@ -0,0 +1,127 @@
+/// @file PathFlattenBench.cpp
+/// @brief Curve flattening and dashed stroking benchmarks for donner::Path.
+///
+/// Usage:
+/// ```
+/// bazel run -c opt //donner/benchmarks:path_flatten_bench -- \
+///     --benchmark_min_time=0.5s
+/// ```
+///
+/// `BM_PathFlatten_Batched/<curves>` flattens a wave of `<curves>` cubics with
+/// `Path::flatten`, which runs the batched Wang's-formula and forward-differencing kernels from
+/// BezierUtils. `BM_PathFlatten_RecursiveReference/<curves>` flattens the same curves with the
+/// per-curve recursive midpoint subdivision the path used before, for comparison. Both report the
+/// emitted `points`. `BM_PathFlatten_DashedStroke/<segments>` strokes a `<segments>`-long polyline
+/// with a short dash pattern through `Path::strokeToFill`.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "donner/base/BezierUtils.h"
+#include "donner/base/Path.h"
+
+namespace {
+
+using donner::Path;
+using donner::PathBuilder;
+using donner::Vector2d;
+
+constexpr double kTolerance = 0.1;
+
+/// A wave of \p curveCount cubics with varying amplitude, so segment counts differ per curve.
+Path BuildCubicWave(int64_t curveCount) {
+  PathBuilder builder;
+  builder.moveTo({0.0, 0.0});
+  for (int64_t i = 0; i < curveCount; ++i) {
+    const double x = 40.0 * static_cast<double>(i);
+    const double amplitude = 10.0 + static_cast<double>(i % 7) * 15.0;
+    builder.curveTo({x + 10.0, amplitude}, {x + 30.0, -amplitude}, {x + 40.0, 0.0});
+  }
+  return builder.build();
+}
+
+/// Recursive midpoint subdivision, matching the scalar flattener that batching replaced.
+void FlattenCubicRecursive(const Vector2d& p0, const Vector2d& p1, const Vector2d& p2,
+                           const Vector2d& p3, int depth, std::vector<Vector2d>& out) {
+  const Vector2d d1 = p1 - (p0 * (2.0 / 3.0) + p3 * (1.0 / 3.0));
+  const Vector2d d2 = p2 - (p0 * (1.0 / 3.0) + p3 * (2.0 / 3.0));
+  if (std::max(d1.length(), d2.length()) <= kTolerance ||
+      depth >= Path::kMaximumFlattenSubdivisionDepth) {
+    out.push_back(p3);
+    return;
+  }
+
+  auto [left, right] = donner::SplitCubic(p0, p1, p2, p3, 0.5);
+  FlattenCubicRecursive(left[0], left[1], left[2], left[3], depth + 1, out);
+  FlattenCubicRecursive(right[0], right[1], right[2], right[3], depth + 1, out);
+}
+
+void BM_PathFlatten_Batched(benchmark::State& state) {
+  const Path path = BuildCubicWave(state.range(0));
+
+  size_t points = 0;
+  for (auto _ : state) {
+    Path flattened = path.flatten(kTolerance);
+    points = flattened.points().size();
+    benchmark::DoNotOptimize(flattened);
+  }
+
+  state.counters["points"] = static_cast<double>(points);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_PathFlatten_RecursiveReference(benchmark::State& state) {
+  const Path path = BuildCubicWave(state.range(0));
+  std::vector<std::array<Vector2d, 4>> cubics;
+  Vector2d current;
+  path.forEach([&](Path::Verb verb, std::span<const Vector2d> points) {
+    if (verb == Path::Verb::CurveTo) {
+      cubics.push_back({current, points[0], points[1], points[2]});
+    }
+    if (!points.empty()) {
+      current = points.back();
+    }
+  });
+
+  size_t points = 0;
+  std::vector<Vector2d> out;
+  for (auto _ : state) {
+    out.clear();
+    for (const auto& [p0, p1, p2, p3] : cubics) {
+      FlattenCubicRecursive(p0, p1, p2, p3, 0, out);
+    }
+    points = out.size();
+    benchmark::DoNotOptimize(out.data());
+  }
+
+  state.counters["points"] = static_cast<double>(points + 1);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_PathFlatten_DashedStroke(benchmark::State& state) {
+  PathBuilder builder;
+  builder.moveTo({0.0, 0.0});
+  for (int64_t i = 1; i <= state.range(0); ++i) {
+    builder.lineTo({static_cast<double>(i), (i % 2 == 0) ? 0.0 : 0.5});
+  }
+  const Path path = builder.build();
+  const donner::StrokeStyle style{.width = 0.5, .dashArray = {1.5, 1.0}};
+
+  for (auto _ : state) {
+    Path stroked = path.strokeToFill(style, kTolerance);
+    benchmark::DoNotOptimize(stroked);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_PathFlatten_Batched)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PathFlatten_RecursiveReference)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PathFlatten_DashedStroke)->Arg(1024)->Arg(16384)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,138 @@
+/// @file PathOpsBench.cpp
+/// @brief Scaling benchmarks for \ref donner::ApplyPathBoolean.
+///
+/// Usage:
+/// ```
+/// bazel run -c opt //donner/benchmarks:path_ops_bench -- \
+///     --benchmark_min_time=0.5s
+/// ```
+///
+/// `BM_PathBoolean_UnionOutlines/<segments>` unions a grid of jagged outlines whose neighbours
+/// overlap, the shape of an editor merging map regions: many inputs, each small, with most
+/// segments far from most others. `BM_PathBoolean_IntersectOutlines/<segments>` intersects two
+/// large outlines that cross along their whole length. Both report the input `segments` and the
+/// emitted `commands`; time per segment should stay roughly flat as `<segments>` grows.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "donner/base/MathUtils.h"
+#include "donner/base/PathOps.h"
+
+namespace {
+
+using donner::ApplyPathBoolean;
+using donner::MathConstants;
+using donner::Path;
+using donner::PathBooleanInput;
+using donner::PathBooleanOp;
+using donner::PathBooleanOptions;
+using donner::PathBooleanResult;
+using donner::PathBooleanStatus;
+using donner::PathBuilder;
+using donner::Vector2d;
+
+/// A closed outline of \p vertices line segments around \p center, with a radius that wobbles
+/// so neighbouring outlines cross at many points rather than at two.
+Path BuildOutline(const Vector2d& center, double radius, int64_t vertices, double phase) {
+  PathBuilder builder;
+  for (int64_t i = 0; i < vertices; ++i) {
+    const double angle =
+        2.0 * MathConstants<double>::kPi * static_cast<double>(i) / static_cast<double>(vertices);
+    const double wobble = 1.0 + 0.08 * std::sin(angle * 9.0 + phase) +
+                          0.03 * std::sin(angle * 31.0 + phase * 2.0);
+    const Vector2d point(center.x + radius * wobble * std::cos(angle),
+                         center.y + radius * wobble * std::sin(angle));
+    if (i == 0) {
+      builder.moveTo(point);
+    } else {
+      builder.lineTo(point);
+    }
+  }
+  builder.closePath();
+  return builder.build();
+}
+
+/// Options sized for the benchmark inputs, so the caps measure nothing but themselves.
+PathBooleanOptions UncappedOptions() {
+  return PathBooleanOptions{
+      .maxCurveCount = 1000000,
+      .maxIntersections = 1000000,
+      .maxOutputCommands = 1000000,
+  };
+}
+
+void ReportResult(benchmark::State& state, const PathBooleanResult& result) {
+  if (result.status != PathBooleanStatus::Ok) {
+    state.SkipWithError("path boolean did not succeed");
+    return;
+  }
+
+  std::size_t commands = 0;
+  for (const Path& path : result.paths) {
+    commands += path.commands().size();
+  }
+  state.counters["segments"] = static_cast<double>(state.range(0));
+  state.counters["commands"] = static_cast<double>(commands);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_PathBoolean_UnionOutlines(benchmark::State& state) {
+  constexpr int64_t kVerticesPerOutline = 100;
+  const int64_t outlineCount = std::max<int64_t>(2, state.range(0) / kVerticesPerOutline);
+  const int64_t columns =
+      std::max<int64_t>(1, static_cast<int64_t>(std::sqrt(static_cast<double>(outlineCount))));
+
+  std::vector<PathBooleanInput> inputs;
+  inputs.reserve(static_cast<std::size_t>(outlineCount));
+  for (int64_t i = 0; i < outlineCount; ++i) {
+    const Vector2d center(static_cast<double>(i % columns) * 34.0,
+                          static_cast<double>(i / columns) * 34.0);
+    inputs.push_back(PathBooleanInput{
+        .path = BuildOutline(center, 20.0, kVerticesPerOutline, static_cast<double>(i)),
+    });
+  }
+
+  const PathBooleanOptions options = UncappedOptions();
+  PathBooleanResult result;
+  for (auto _ : state) {
+    result = ApplyPathBoolean(PathBooleanOp::Union, inputs, options);
+    benchmark::DoNotOptimize(result);
+  }
+  ReportResult(state, result);
+}
+
+void BM_PathBoolean_IntersectOutlines(benchmark::State& state) {
+  const int64_t vertices = std::max<int64_t>(8, state.range(0) / 2);
+  const std::vector<PathBooleanInput> inputs = {
+      PathBooleanInput{.path = BuildOutline(Vector2d(0.0, 0.0), 1000.0, vertices, 0.0)},
+      PathBooleanInput{.path = BuildOutline(Vector2d(15.0, 10.0), 1000.0, vertices, 1.0)},
+  };
+
+  const PathBooleanOptions options = UncappedOptions();
+  PathBooleanResult result;
+  for (auto _ : state) {
+    result = ApplyPathBoolean(PathBooleanOp::Intersect, inputs, options);
+    benchmark::DoNotOptimize(result);
+  }
+  ReportResult(state, result);
+}
+
+}  // namespace
+
+BENCHMARK(BM_PathBoolean_UnionOutlines)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Arg(20000)
+    ->Arg(50000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PathBoolean_IntersectOutlines)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Arg(20000)
+    ->Arg(50000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,132 @@
+/// @file ShaderIrPassesBench.cpp
+/// @brief Shader IR optimization pass benchmarks over the solid-fill program.
+///
+/// Usage:
+/// ```
+/// bazel run -c opt //donner/benchmarks:shader_ir_passes_bench -- \
+///     --benchmark_min_time=0.5s
+/// ```
+///
+/// `BM_ShaderIrPasses_Optimize/<variant>` reports the time to run the pass pipeline, with the
+/// emitted `wgsl_bytes` and `msl_bytes` of the result. `BM_ShaderIrPasses_Interpret/<variant>`
+/// runs the fragment entry point on the software interpreter and reports the expression nodes
+/// evaluated per quad as `ops_per_quad`. Variants are `0` (unoptimized), `1` (default passes),
+/// and `2` (default passes with the paint mode and clip uniforms specialized to zero).
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "donner/gpu/shader/IrPasses.h"
+#include "donner/gpu/shader/MslEmitter.h"
+#include "donner/gpu/shader/WgslEmitter.h"
+#include "donner/gpu/shader/programs/SolidFill.h"
+#include "donner/gpu/software/ShaderInterpreter.h"
+
+namespace {
+
+using donner::gpu::shader::IrModule;
+using donner::gpu::shader::IrPassOptions;
+using donner::gpu::shader::ShaderResult;
+using donner::gpu::software::kAllLanes;
+using donner::gpu::software::ShaderInterpreter;
+using donner::gpu::software::ShaderProgram;
+using donner::gpu::software::ShaderResource;
+
+template <typename T>
+T MustSucceed(ShaderResult<T>&& result) {
+  if (result.hasError()) {
+    std::cerr << "Shader error: " << result.error() << "\n";
+    std::abort();
+  }
+  return std::move(result).result();
+}
+
+/// Pass options for benchmark variant \p variant, or nullopt to leave the module unoptimized.
+std::optional<IrPassOptions> VariantOptions(int64_t variant) {
+  if (variant == 0) {
+    return std::nullopt;
+  }
+
+  IrPassOptions options;
+  if (variant == 2) {
+    using donner::gpu::shader::LiteralU32;
+    options.uniforms = {{"uniforms", "paintMode", LiteralU32(0)},
+                        {"uniforms", "hasClipPolygon", LiteralU32(0)},
+                        {"uniforms", "hasClipMask", LiteralU32(0)}};
+  }
+  return options;
+}
+
+/// The solid-fill module as benchmark variant \p variant.
+IrModule BuildVariant(int64_t variant) {
+  IrModule module = MustSucceed(donner::gpu::shader::programs::BuildSolidFillModule());
+  if (const std::optional<IrPassOptions> options = VariantOptions(variant)) {
+    module = MustSucceed(donner::gpu::shader::OptimizeModule(module, *options));
+  }
+  return module;
+}
+
+void BM_ShaderIrPasses_Optimize(benchmark::State& state) {
+  const IrModule module = MustSucceed(donner::gpu::shader::programs::BuildSolidFillModule());
+  const std::optional<IrPassOptions> options = VariantOptions(state.range(0));
+
+  for (auto _ : state) {
+    if (options) {
+      IrModule optimized = MustSucceed(donner::gpu::shader::OptimizeModule(module, *options));
+      benchmark::DoNotOptimize(optimized);
+    } else {
+      IrModule copy = module;
+      benchmark::DoNotOptimize(copy);
+    }
+  }
+
+  const IrModule result = BuildVariant(state.range(0));
+  state.counters["wgsl_bytes"] =
+      static_cast<double>(MustSucceed(donner::gpu::shader::EmitWgsl(result)).size());
+  state.counters["msl_bytes"] =
+      static_cast<double>(MustSucceed(donner::gpu::shader::EmitMsl(result)).size());
+}
+
+void BM_ShaderIrPasses_Interpret(benchmark::State& state) {
+  auto program = ShaderProgram::Compile(BuildVariant(state.range(0)));
+  if (program.hasError()) {
+    state.SkipWithError("ShaderProgram::Compile failed");
+    return;
+  }
+
+  ShaderInterpreter interpreter(program.result());
+  const std::optional<uint32_t> entryIndex = interpreter.program().findEntryPoint(
+      "fs_main", donner::gpu::shader::StageKind::Fragment);
+  if (!entryIndex) {
+    state.SkipWithError("fs_main not found");
+    return;
+  }
+
+  // Zeroed uniforms and empty storage buffers: the quad takes the solid-color, unclipped path
+  // with no curves in its band, which is what the specialized variant assumes.
+  const std::vector<uint8_t> zeroUniforms(256, 0);
+  std::vector<ShaderResource> resources(interpreter.program().bindings().size());
+  resources[0].bytes = zeroUniforms;
+
+  uint64_t quads = 0;
+  for (auto _ : state) {
+    auto survivors = interpreter.run(*entryIndex, resources, kAllLanes);
+    benchmark::DoNotOptimize(survivors);
+    ++quads;
+  }
+
+  state.counters["ops_per_quad"] =
+      quads == 0 ? 0.0
+                 : static_cast<double>(interpreter.executedOperations()) /
+                       static_cast<double>(quads);
+}
+
+}  // namespace
+
+BENCHMARK(BM_ShaderIrPasses_Optimize)->DenseRange(0, 2)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ShaderIrPasses_Interpret)->DenseRange(0, 2)->Unit(benchmark::kNanosecond);
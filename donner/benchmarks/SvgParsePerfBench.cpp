@@ -13,9 +13,24 @@
 /// directly comparable for the parse phase.
 ///
 /// Usage:
-///   svg_parse_perf_bench [--iterations=N] [--warmup=N] [--repeat=N] FILE...
+///   svg_parse_perf_bench [--iterations=N] [--warmup=N] [--repeat=N]
+///                        [--inkscape-paths=N] [--source=memory|copied|mapped] FILE...
 ///
-/// Each input file produces one `RESULT scene=<name> parse_ms=<median>` line
+/// `--inkscape-paths=N` adds a generated scene, `inkscape_paths_<N>`, laid out the way Inkscape
+/// and Illustrator export drawings: N `<path>` elements in layer groups, each carrying a full
+/// `style="fill:...;stroke:...;..."` string drawn from a small palette, so most strings repeat.
+/// It may be given more than once.
+///
+/// `--source` selects how FILE inputs reach the parser. `memory` (the default) reads each file
+/// once up front and times only \ref donner::svg::parser::SVGParser::ParseSVG on the string.
+/// `copied` and `mapped` time the whole path from file to document on every iteration: `copied`
+/// reads the file into a string with \ref donner::ReadFileBounded and parses that, `mapped` maps
+/// it with \ref donner::MapFileBounded and parses the mapping in place. Run one mode per process
+/// when comparing them: every RESULT line also reports `peak_rss_kb`, the process's high-water
+/// mark so far, which a previous mode would otherwise already have raised. Generated scenes are
+/// always parsed from memory.
+///
+/// Each input file produces one `RESULT scene=<name> parse_ms=<median> peak_rss_kb=<kib>` line
 /// per repeat. Repeats interleave at file granularity, not at iteration
 /// granularity: one repeat runs every iteration of the first file, then every
 /// iteration of the second, and so on, before the next repeat starts again from
@@ -31,11 +46,19 @@
 #include <filesystem>
 #include <fstream>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <variant>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "donner/base/FileUtils.h"
 #include "donner/base/ParseWarningSink.h"
 #include "donner/svg/SVGDocument.h"
 #include "donner/svg/parser/SVGParser.h"
@@ -70,19 +93,100 @@ std::optional<std::string> readFile(const std::filesystem::path& path) {
   return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
 }
 
+/// Peak resident set size of this process in KiB, or 0 where it is not available.
+long peakRssKb() {
+#ifndef _WIN32
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // Bytes on macOS.
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+  return 0;
+}
+
+/// How FILE inputs reach the parser, see `--source`.
+enum class SourceMode { Memory, Copied, Mapped };
+
 struct Scene {
   std::string name;
   std::string source;
+  std::filesystem::path path;  //!< Set for FILE inputs read per iteration.
 };
 
+/// Generates an Inkscape-style document with \p pathCount paths. Ten distinct style strings are
+/// cycled, matching an export where a few swatches are reused across the whole drawing.
+std::string makeInkscapeScene(int pathCount) {
+  static constexpr const char* kFills[] = {"#1f77b4", "#ff7f0e", "#2ca02c", "#d62728", "#9467bd",
+                                           "#8c564b", "#e377c2", "#7f7f7f", "#bcbd22", "#17becf"};
+  constexpr int kPathsPerLayer = 500;
+
+  std::string svg;
+  svg.reserve(static_cast<std::size_t>(pathCount) * 260u + 512u);
+  svg += R"(<svg xmlns="http://www.w3.org/2000/svg" width="1024" height="1024">)";
+  svg += '\n';
+  for (int i = 0; i < pathCount; ++i) {
+    if (i % kPathsPerLayer == 0) {
+      if (i != 0) {
+        svg += "</g>\n";
+      }
+      svg += R"(<g id="layer)" + std::to_string(i / kPathsPerLayer) + R"(">)" + '\n';
+    }
+
+    const int x = (i * 37) % 1000;
+    const int y = (i * 91) % 1000;
+    svg += R"(  <path id="path)" + std::to_string(i) + R"(" d="m )" + std::to_string(x) + ' ' +
+           std::to_string(y) + R"( 12,3 -4,9 -8,-2 z" style="fill:)";
+    svg += kFills[i % std::size(kFills)];
+    svg += ";fill-opacity:1;fill-rule:nonzero;stroke:#000000;stroke-width:0.75;"
+           "stroke-linecap:round;stroke-linejoin:round;stroke-miterlimit:4;"
+           "stroke-dasharray:none;stroke-opacity:1\" />\n";
+  }
+  if (pathCount > 0) {
+    svg += "</g>\n";
+  }
+  svg += "</svg>\n";
+  return svg;
+}
+
 /// Parses one document, returning false if the source did not parse. Keeping the
 /// document alive until the timer stops means teardown is excluded, matching the
-/// cross-engine benchmark's parse phase.
-bool parseOnce(const std::string& source, double& elapsedMs) {
+/// cross-engine benchmark's parse phase. In the `copied` and `mapped` modes the
+/// file is read or mapped inside the timed region.
+bool parseOnce(const Scene& scene, SourceMode mode, double& elapsedMs) {
+  using donner::svg::parser::SVGParser;
+
   donner::ParseWarningSink warningSink = donner::ParseWarningSink::Disabled();
   const auto start = Clock::now();
-  auto parsed = donner::svg::parser::SVGParser::ParseSVG(source, warningSink);
+  std::optional<donner::ParseResult<donner::svg::SVGDocument>> maybeParsed;
+  if (scene.path.empty() || mode == SourceMode::Memory) {
+    maybeParsed.emplace(SVGParser::ParseSVG(scene.source, warningSink));
+  } else if (mode == SourceMode::Copied) {
+    donner::FileReadResult source =
+        donner::ReadFileBounded(scene.path, SVGParser::Options().maximumInputSize);
+    if (const auto* error = std::get_if<donner::FileReadError>(&source)) {
+      std::fprintf(stderr, "unable to read SVG: %s: %s\n", scene.path.string().c_str(),
+                   donner::FileReadErrorMessage(*error));
+      return false;
+    }
+    maybeParsed.emplace(SVGParser::ParseSVG(std::get<std::string>(source), warningSink));
+  } else {
+    donner::FileMapResult mapped =
+        donner::MapFileBounded(scene.path, SVGParser::Options().maximumInputSize);
+    if (const auto* error = std::get_if<donner::FileReadError>(&mapped)) {
+      std::fprintf(stderr, "unable to map SVG: %s: %s\n", scene.path.string().c_str(),
+                   donner::FileReadErrorMessage(*error));
+      return false;
+    }
+    maybeParsed.emplace(SVGParser::ParseSVG(
+        std::get<std::shared_ptr<const donner::MappedFile>>(std::move(mapped)), warningSink));
+  }
   elapsedMs = toMs(Clock::now() - start);
+
+  auto& parsed = maybeParsed.value();
   if (parsed.hasError()) {
     std::fprintf(stderr, "parse error: %s\n", std::string(parsed.error().reason).c_str());
     return false;
@@ -100,7 +204,9 @@ int main(int argc, char* argv[]) {
   int iterations = 25;
   int warmup = 3;
   int repeat = 1;
+  SourceMode sourceMode = SourceMode::Memory;
   std::vector<std::string> inputs;
+  std::vector<Scene> scenes;
 
   for (int i = 1; i < argc; ++i) {
     const std::string_view arg(argv[i]);
@@ -110,21 +216,41 @@ int main(int argc, char* argv[]) {
       warmup = std::max(0, std::atoi(std::string(arg.substr(9)).c_str()));
     } else if (arg.starts_with("--repeat=")) {
       repeat = std::max(1, std::atoi(std::string(arg.substr(9)).c_str()));
+    } else if (arg.starts_with("--inkscape-paths=")) {
+      const int paths = std::max(1, std::atoi(std::string(arg.substr(17)).c_str()));
+      scenes.push_back(
+          Scene{"inkscape_paths_" + std::to_string(paths), makeInkscapeScene(paths), {}});
+    } else if (arg == "--source=memory") {
+      sourceMode = SourceMode::Memory;
+    } else if (arg == "--source=copied") {
+      sourceMode = SourceMode::Copied;
+    } else if (arg == "--source=mapped") {
+      sourceMode = SourceMode::Mapped;
     } else {
       inputs.emplace_back(arg);
     }
   }
 
-  if (inputs.empty()) {
-    std::fprintf(
-        stderr, "usage: svg_parse_perf_bench [--iterations=N] [--warmup=N] [--repeat=N] FILE...\n");
+  if (inputs.empty() && scenes.empty()) {
+    std::fprintf(stderr,
+                 "usage: svg_parse_perf_bench [--iterations=N] [--warmup=N] [--repeat=N] "
+                 "[--inkscape-paths=N] [--source=memory|copied|mapped] FILE...\n");
     return 2;
   }
 
-  std::vector<Scene> scenes;
-  scenes.reserve(inputs.size());
   for (const std::string& input : inputs) {
     const std::filesystem::path path(input);
+    if (sourceMode != SourceMode::Memory) {
+      // Read per iteration; only check that the file exists so a typo fails before timing.
+      std::error_code ec;
+      if (!std::filesystem::is_regular_file(path, ec)) {
+        std::fprintf(stderr, "unable to open SVG: %s\n", input.c_str());
+        return 2;
+      }
+      scenes.push_back(Scene{path.filename().string(), {}, path});
+      continue;
+    }
+
     std::optional<std::string> source = readFile(path);
     if (!source.has_value()) {
       std::fprintf(stderr, "unable to open SVG: %s\n", input.c_str());
@@ -134,7 +260,7 @@ int main(int argc, char* argv[]) {
       std::fprintf(stderr, "SVG is empty: %s\n", input.c_str());
       return 2;
     }
-    scenes.push_back(Scene{path.filename().string(), std::move(source.value())});
+    scenes.push_back(Scene{path.filename().string(), std::move(source.value()), {}});
   }
 
   for (int run = 0; run < repeat; ++run) {
@@ -143,7 +269,7 @@ int main(int argc, char* argv[]) {
       samples.reserve(static_cast<std::size_t>(iterations));
       for (int i = 0; i < warmup + iterations; ++i) {
         double elapsedMs = 0.0;
-        if (!parseOnce(scene.source, elapsedMs)) {
+        if (!parseOnce(scene, sourceMode, elapsedMs)) {
           return 1;
         }
         if (i >= warmup) {
@@ -151,8 +277,8 @@ int main(int argc, char* argv[]) {
         }
       }
 
-      std::printf("RESULT scene=%s run=%d iterations=%d parse_ms=%.4f\n", scene.name.c_str(), run,
-                  iterations, median(samples));
+      std::printf("RESULT scene=%s run=%d iterations=%d parse_ms=%.4f peak_rss_kb=%ld\n",
+                  scene.name.c_str(), run, iterations, median(samples), peakRssKb());
       std::fflush(stdout);
     }
   }
@@ -0,0 +1,99 @@
+/// @file TextMutationBench.cpp
+/// @brief Latency of re-laying out a `<text>` root after one of its spans changes.
+///
+/// Usage:
+/// ```
+/// bazel run -c opt //donner/benchmarks:text_mutation_bench -- \
+///     --benchmark_min_time=0.5s
+/// ```
+///
+/// `BM_TextMutation_EditOneSpan/<spans>` builds a label of `<spans>` `<tspan>` children, then on
+/// every iteration replaces the text of one of them and asks for the computed text length, which
+/// is what an editor does per keystroke to place its caret. Any change inside a text root drops
+/// that root's geometry, so each iteration lays out the whole label; the cost that scales with
+/// `<spans>` is what the text engine's shaping and glyph outline caches keep low.
+/// `BM_TextMutation_ColdLayout/<spans>` parses a fresh document per iteration for comparison.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "donner/base/ParseWarningSink.h"
+#include "donner/svg/SVGDocument.h"
+#include "donner/svg/SVGTSpanElement.h"
+#include "donner/svg/SVGTextElement.h"
+#include "donner/svg/parser/SVGParser.h"
+
+namespace {
+
+using donner::ParseWarningSink;
+using donner::svg::SVGDocument;
+using donner::svg::SVGTextElement;
+using donner::svg::SVGTSpanElement;
+using donner::svg::parser::SVGParser;
+
+/// A `<text>` label of \p spans spans, each a short word, like a multi-style caption.
+std::string MakeLabelSvg(int64_t spans) {
+  std::string svg = R"(<svg xmlns="http://www.w3.org/2000/svg" width="800" height="200">)";
+  svg += "<text id=\"label\" x=\"10\" y=\"100\" font-size=\"16\">";
+  for (int64_t i = 0; i < spans; ++i) {
+    svg += "<tspan id=\"s" + std::to_string(i) + "\"" +
+           (i % 3 == 0 ? " font-weight=\"bold\"" : "") + ">word" + std::to_string(i) +
+           " </tspan>";
+  }
+  svg += "</text></svg>";
+  return svg;
+}
+
+SVGDocument ParseOrSkip(benchmark::State& state, const std::string& svg) {
+  ParseWarningSink sink;
+  auto result = SVGParser::ParseSVG(svg, sink);
+  if (result.hasError()) {
+    state.SkipWithError("failed to parse benchmark input");
+    return SVGDocument();
+  }
+  return std::move(result).result();
+}
+
+void BM_TextMutation_EditOneSpan(benchmark::State& state) {
+  SVGDocument document = ParseOrSkip(state, MakeLabelSvg(state.range(0)));
+  auto text = document.querySelector("#label");
+  auto edited = document.querySelector("#s" + std::to_string(state.range(0) / 2));
+  if (!text || !edited) {
+    state.SkipWithError("benchmark input is missing its text elements");
+    return;
+  }
+
+  SVGTextElement textElement = text->cast<SVGTextElement>();
+  SVGTSpanElement span = edited->cast<SVGTSpanElement>();
+  benchmark::DoNotOptimize(textElement.getComputedTextLength());
+
+  int64_t keystroke = 0;
+  for (auto _ : state) {
+    span.setTextContent(keystroke++ % 2 == 0 ? "edited " : "typed ");
+    benchmark::DoNotOptimize(textElement.getComputedTextLength());
+  }
+  state.counters["spans"] = static_cast<double>(state.range(0));
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_TextMutation_ColdLayout(benchmark::State& state) {
+  const std::string svg = MakeLabelSvg(state.range(0));
+  for (auto _ : state) {
+    SVGDocument document = ParseOrSkip(state, svg);
+    auto text = document.querySelector("#label");
+    if (!text) {
+      state.SkipWithError("benchmark input is missing its text element");
+      return;
+    }
+    benchmark::DoNotOptimize(text->cast<SVGTextElement>().getComputedTextLength());
+  }
+  state.counters["spans"] = static_cast<double>(state.range(0));
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_TextMutation_EditOneSpan)->Arg(8)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TextMutation_ColdLayout)->Arg(8)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
@@ -2,14 +2,28 @@
 /// @brief tiny-skia-cpp rendering benchmarks (C++ only, no Rust FFI).
 ///
 /// Uses identical scene geometry and paint parameters as RenderPerfBench.cpp.
+///
+/// The `_SparseStrips` variants fill the same geometry with `ScanBackend::SparseStrips` instead
+/// of the analytic scan converter. `BM_FillPath_ManyCurves_*` fills a curve-heavy scene, many
+/// small wobbly outlines made of short cubics, which is where the two backends differ most.
+///
+/// `BM_FillPath_MultiStopGradient_*` fills the scene with a five-stop gradient, once searching
+/// the stop intervals per pixel and once (`_Lut`) through a precomputed color table.
+///
+/// `BM_PipelineScene_*` fill the scene with one shader family: solid color, solid color through a
+/// clip mask, a four-stop linear gradient, or a radial gradient through its color table. Each
+/// measures the rect, anti-aliased span, and edge mask pipelines the blitter builds for it.
 
 #include <benchmark/benchmark.h>
 
+#include <cmath>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 #include "tiny_skia/Color.h"
 #include "tiny_skia/Geom.h"
+#include "tiny_skia/Mask.h"
 #include "tiny_skia/Painter.h"
 #include "tiny_skia/Path.h"
 #include "tiny_skia/PathBuilder.h"
@@ -29,6 +43,7 @@ using tiny_skia::FillRule;
 using tiny_skia::FilterQuality;
 using tiny_skia::GradientStop;
 using tiny_skia::LinearGradient;
+using tiny_skia::Mask;
 using tiny_skia::Paint;
 using tiny_skia::Path;
 using tiny_skia::PathBuilder;
@@ -37,6 +52,7 @@ using tiny_skia::Pixmap;
 using tiny_skia::Point;
 using tiny_skia::RadialGradient;
 using tiny_skia::Rect;
+using tiny_skia::ScanBackend;
 using tiny_skia::SpreadMode;
 using tiny_skia::Stroke;
 using tiny_skia::StrokeDash;
@@ -56,6 +72,43 @@ std::optional<Path> createScenePath(float d) {
   return pb.finish();
 }
 
+/// A grid of closed outlines, each made of short cubics around a wobbling radius: many small
+/// curved shapes with thin features, like the outlines of an illustration or a map.
+std::optional<Path> createCurveHeavyPath(float d) {
+  constexpr int kOutlinesPerSide = 8;
+  constexpr int kSegmentsPerOutline = 48;
+  constexpr float kTwoPi = 6.2831853f;
+  const float cell = d / static_cast<float>(kOutlinesPerSide);
+
+  PathBuilder pb;
+  for (int row = 0; row < kOutlinesPerSide; ++row) {
+    for (int column = 0; column < kOutlinesPerSide; ++column) {
+      const float cx = (static_cast<float>(column) + 0.5f) * cell;
+      const float cy = (static_cast<float>(row) + 0.5f) * cell;
+      const float phase = static_cast<float>(row * kOutlinesPerSide + column);
+      auto pointAt = [&](float t) {
+        const float angle = t * kTwoPi;
+        const float radius = cell * (0.36f + 0.08f * std::sin(angle * 7.0f + phase) +
+                                     0.04f * std::sin(angle * 17.0f + 2.0f * phase));
+        return Point::fromXY(cx + radius * std::cos(angle), cy + radius * std::sin(angle));
+      };
+
+      const Point start = pointAt(0.0f);
+      pb.moveTo(start.x, start.y);
+      for (int i = 0; i < kSegmentsPerOutline; ++i) {
+        const float t0 = static_cast<float>(i) / kSegmentsPerOutline;
+        const float dt = 1.0f / kSegmentsPerOutline;
+        const Point c1 = pointAt(t0 + dt / 3.0f);
+        const Point c2 = pointAt(t0 + 2.0f * dt / 3.0f);
+        const Point end = pointAt(t0 + dt);
+        pb.cubicTo(c1.x, c1.y, c2.x, c2.y, end.x, end.y);
+      }
+      pb.close();
+    }
+  }
+  return pb.finish();
+}
+
 Paint createPaint() {
   Paint paint;
   paint.setColorRgba8(22, 158, 255, 200);
@@ -200,6 +253,65 @@ void BM_FillPath_LinearGradient_TinySkia(benchmark::State& state) {
   recordThroughput(state, state.range(0));
 }
 
+/// Fills the scene with a translucent five-stop linear gradient, optionally with its color table
+/// attached.
+void fillPathWithMultiStopGradient(benchmark::State& state, bool withLut) {
+  const auto dim = static_cast<std::uint32_t>(state.range(0));
+  auto pixmap = Pixmap::fromSize(dim, dim);
+  if (!pixmap.has_value()) {
+    state.SkipWithError("Failed to allocate pixmap");
+    return;
+  }
+
+  auto path = createScenePath(static_cast<float>(dim));
+  if (!path.has_value()) {
+    state.SkipWithError("Failed to create path");
+    return;
+  }
+
+  const auto d = static_cast<float>(dim);
+  auto gradient =
+      LinearGradient::create(Point::fromXY(0.1f * d, 0.1f * d), Point::fromXY(0.9f * d, 0.9f * d),
+                             {GradientStop::create(0.0f, Color::fromRgba8(50, 127, 150, 200)),
+                              GradientStop::create(0.3f, Color::fromRgba8(220, 140, 75, 180)),
+                              GradientStop::create(0.5f, Color::fromRgba8(40, 180, 55, 255)),
+                              GradientStop::create(0.7f, Color::fromRgba8(250, 40, 90, 160)),
+                              GradientStop::create(1.0f, Color::fromRgba8(20, 20, 200, 220))},
+                             SpreadMode::Pad, Transform::identity());
+  if (!gradient.has_value()) {
+    state.SkipWithError("Failed to create linear gradient");
+    return;
+  }
+
+  auto shader = std::get<LinearGradient>(std::move(*gradient));
+  if (withLut) {
+    shader.base_.setLut(shader.base_.buildLut(tiny_skia::ColorSpace::Linear));
+  }
+
+  Paint paint;
+  paint.antiAlias = true;
+  paint.shader = std::move(shader);
+  const Color clearColor = Color::fromRgba8(0, 0, 0, 0);
+
+  for (auto _ : state) {
+    pixmap->fill(clearColor);
+    auto mut = pixmap->mutableView();
+    tiny_skia::Painter::fillPath(mut, *path, paint, FillRule::Winding, Transform::identity());
+    benchmark::DoNotOptimize(pixmap->data().data());
+    benchmark::ClobberMemory();
+  }
+
+  recordThroughput(state, state.range(0));
+}
+
+void BM_FillPath_MultiStopGradient_TinySkia(benchmark::State& state) {
+  fillPathWithMultiStopGradient(state, false);
+}
+
+void BM_FillPath_MultiStopGradient_Lut_TinySkia(benchmark::State& state) {
+  fillPathWithMultiStopGradient(state, true);
+}
+
 void BM_FillPath_Opaque_TinySkia(benchmark::State& state) {
   const auto dim = static_cast<std::uint32_t>(state.range(0));
   auto pixmap = Pixmap::fromSize(dim, dim);
@@ -453,10 +565,167 @@ void BM_FillPath_Pattern_TinySkia(benchmark::State& state) {
   recordThroughput(state, state.range(0));
 }
 
+/// Fills \p path with the standard paint through \p backend.
+void fillPathWithBackend(benchmark::State& state, const std::optional<Path>& path,
+                         ScanBackend backend) {
+  const auto dim = static_cast<std::uint32_t>(state.range(0));
+  auto pixmap = Pixmap::fromSize(dim, dim);
+  if (!pixmap.has_value()) {
+    state.SkipWithError("Failed to allocate pixmap");
+    return;
+  }
+
+  if (!path.has_value()) {
+    state.SkipWithError("Failed to create path");
+    return;
+  }
+
+  Paint paint = createPaint();
+  paint.scanBackend = backend;
+  const Color clearColor = Color::fromRgba8(0, 0, 0, 0);
+
+  for (auto _ : state) {
+    pixmap->fill(clearColor);
+    auto mut = pixmap->mutableView();
+    tiny_skia::Painter::fillPath(mut, *path, paint, FillRule::Winding, Transform::identity());
+    benchmark::DoNotOptimize(pixmap->data().data());
+    benchmark::ClobberMemory();
+  }
+
+  recordThroughput(state, state.range(0));
+}
+
+void BM_FillPath_SparseStrips_TinySkia(benchmark::State& state) {
+  fillPathWithBackend(state, createScenePath(static_cast<float>(state.range(0))),
+                      ScanBackend::SparseStrips);
+}
+
+void BM_FillPath_ManyCurves_TinySkia(benchmark::State& state) {
+  fillPathWithBackend(state, createCurveHeavyPath(static_cast<float>(state.range(0))),
+                      ScanBackend::Analytic);
+}
+
+void BM_FillPath_ManyCurves_SparseStrips_TinySkia(benchmark::State& state) {
+  fillPathWithBackend(state, createCurveHeavyPath(static_cast<float>(state.range(0))),
+                      ScanBackend::SparseStrips);
+}
+
+enum class PipelineScene {
+  SolidColor,
+  ClippedSolidColor,
+  LinearGradient,
+  RadialGradientLut,
+};
+
+std::optional<Paint> createPipelineScenePaint(PipelineScene scene, float d) {
+  Paint paint = createPaint();
+  const std::vector<GradientStop> stops = {
+      GradientStop::create(0.0f, Color::fromRgba8(50, 127, 150, 200)),
+      GradientStop::create(0.3f, Color::fromRgba8(220, 140, 75, 180)),
+      GradientStop::create(0.6f, Color::fromRgba8(40, 180, 55, 255)),
+      GradientStop::create(1.0f, Color::fromRgba8(20, 20, 200, 220))};
+
+  switch (scene) {
+    case PipelineScene::SolidColor:
+    case PipelineScene::ClippedSolidColor:
+      return paint;
+    case PipelineScene::LinearGradient: {
+      auto gradient = LinearGradient::create(Point::fromXY(0.1f * d, 0.1f * d),
+                                             Point::fromXY(0.9f * d, 0.9f * d), stops,
+                                             SpreadMode::Pad, Transform::identity());
+      if (!gradient.has_value()) {
+        return std::nullopt;
+      }
+      paint.shader = std::get<LinearGradient>(std::move(*gradient));
+      return paint;
+    }
+    case PipelineScene::RadialGradientLut: {
+      auto gradient = RadialGradient::create(Point::fromXY(0.5f * d, 0.5f * d), 0.0f,
+                                             Point::fromXY(0.5f * d, 0.5f * d), 0.5f * d, stops,
+                                             SpreadMode::Pad, Transform::identity());
+      if (!gradient.has_value()) {
+        return std::nullopt;
+      }
+      auto shader = std::get<RadialGradient>(std::move(*gradient));
+      shader.base_.setLut(shader.base_.buildLut(tiny_skia::ColorSpace::Linear));
+      paint.shader = std::move(shader);
+      return paint;
+    }
+  }
+  return std::nullopt;
+}
+
+/// Fills the scene path with the paint for \p scene.
+void fillPipelineScene(benchmark::State& state, PipelineScene scene) {
+  const auto dim = static_cast<std::uint32_t>(state.range(0));
+  const auto d = static_cast<float>(dim);
+  auto pixmap = Pixmap::fromSize(dim, dim);
+  if (!pixmap.has_value()) {
+    state.SkipWithError("Failed to allocate pixmap");
+    return;
+  }
+
+  auto path = createScenePath(d);
+  if (!path.has_value()) {
+    state.SkipWithError("Failed to create path");
+    return;
+  }
+
+  auto paint = createPipelineScenePaint(scene, d);
+  if (!paint.has_value()) {
+    state.SkipWithError("Failed to create paint");
+    return;
+  }
+
+  std::optional<Mask> clipMask;
+  if (scene == PipelineScene::ClippedSolidColor) {
+    clipMask = Mask::fromSize(dim, dim);
+    const auto clipRect = Rect::fromLTRB(0.2f * d, 0.0f, 0.8f * d, d);
+    if (!clipMask.has_value() || !clipRect.has_value()) {
+      state.SkipWithError("Failed to create clip mask");
+      return;
+    }
+    clipMask->fillPath(Path::fromRect(*clipRect), FillRule::Winding, true, Transform::identity());
+  }
+
+  const Color clearColor = Color::fromRgba8(0, 0, 0, 0);
+  for (auto _ : state) {
+    pixmap->fill(clearColor);
+    auto mut = pixmap->mutableView();
+    tiny_skia::Painter::fillPath(mut, *path, *paint, FillRule::Winding, Transform::identity(),
+                                 clipMask.has_value() ? &*clipMask : nullptr);
+    benchmark::DoNotOptimize(pixmap->data().data());
+    benchmark::ClobberMemory();
+  }
+
+  recordThroughput(state, state.range(0));
+}
+
+void BM_PipelineScene_SolidColor_TinySkia(benchmark::State& state) {
+  fillPipelineScene(state, PipelineScene::SolidColor);
+}
+
+void BM_PipelineScene_ClippedSolidColor_TinySkia(benchmark::State& state) {
+  fillPipelineScene(state, PipelineScene::ClippedSolidColor);
+}
+
+void BM_PipelineScene_LinearGradient_TinySkia(benchmark::State& state) {
+  fillPipelineScene(state, PipelineScene::LinearGradient);
+}
+
+void BM_PipelineScene_RadialGradientLut_TinySkia(benchmark::State& state) {
+  fillPipelineScene(state, PipelineScene::RadialGradientLut);
+}
+
 BENCHMARK(BM_FillPath_TinySkia)->Arg(kSceneSize);
+BENCHMARK(BM_FillPath_SparseStrips_TinySkia)->Arg(kSceneSize);
+BENCHMARK(BM_FillPath_ManyCurves_TinySkia)->Arg(kSceneSize);
+BENCHMARK(BM_FillPath_ManyCurves_SparseStrips_TinySkia)->Arg(kSceneSize);
 BENCHMARK(BM_FillRect_TinySkia)->Arg(kSceneSize);
 BENCHMARK(BM_StrokePath_TinySkia)->Arg(kSceneSize);
 BENCHMARK(BM_FillPath_LinearGradient_TinySkia)->Arg(kSceneSize);
+BENCHMARK(BM_FillPath_MultiStopGradient_TinySkia)->Arg(kSceneSize);
+BENCHMARK(BM_FillPath_MultiStopGradient_Lut_TinySkia)->Arg(kSceneSize);
 BENCHMARK(BM_FillPath_Opaque_TinySkia)->Arg(kSceneSize);
 BENCHMARK(BM_FillPath_RadialGradient_TinySkia)->Arg(kSceneSize);
 BENCHMARK(BM_StrokePath_Dashed_TinySkia)->Arg(kSceneSize);
@@ -464,5 +733,9 @@ BENCHMARK(BM_StrokePath_Thick_TinySkia)->Arg(kSceneSize);
 BENCHMARK(BM_FillPath_Transformed_TinySkia)->Arg(kSceneSize);
 BENCHMARK(BM_FillPath_EvenOdd_TinySkia)->Arg(kSceneSize);
 BENCHMARK(BM_FillPath_Pattern_TinySkia)->Arg(kSceneSize);
+BENCHMARK(BM_PipelineScene_SolidColor_TinySkia)->Arg(kSceneSize);
+BENCHMARK(BM_PipelineScene_ClippedSolidColor_TinySkia)->Arg(kSceneSize);
+BENCHMARK(BM_PipelineScene_LinearGradient_TinySkia)->Arg(kSceneSize);
+BENCHMARK(BM_PipelineScene_RadialGradientLut_TinySkia)->Arg(kSceneSize);
 
 }  // namespace
@@ -29,6 +29,71 @@ std::string Declaration::toCssText() const {
   return result;
 }
 
+namespace {
+
+/// Returns the size of `value.toCssText()`, and its first character in \p firstChar (or '\0' if
+/// the text is empty).
+std::size_t ComponentValueCssTextSize(const ComponentValue& value, char* firstChar) {
+  if (const Token* token = std::get_if<Token>(&value.value)) {
+    const std::string text = token->toCssText();
+    *firstChar = text.empty() ? '\0' : text[0];
+    return text.size();
+  }
+
+  char ignored = '\0';
+  if (const Function* function = std::get_if<Function>(&value.value)) {
+    *firstChar = function->name.empty() ? '(' : function->name.data()[0];
+    std::size_t size = function->name.size() + 2;
+    for (const ComponentValue& child : function->values) {
+      size += ComponentValueCssTextSize(child, &ignored);
+    }
+    return size;
+  }
+
+  const SimpleBlock& block = std::get<SimpleBlock>(value.value);
+  std::size_t size = 0;
+  for (const ComponentValue& child : block.values) {
+    size += ComponentValueCssTextSize(child, &ignored);
+  }
+
+  const bool hasBrackets = block.associatedToken == Token::indexOf<Token::CurlyBracket>() ||
+                           block.associatedToken == Token::indexOf<Token::SquareBracket>() ||
+                           block.associatedToken == Token::indexOf<Token::Parenthesis>();
+  if (hasBrackets) {
+    *firstChar = block.associatedToken == Token::indexOf<Token::CurlyBracket>()    ? '{'
+                 : block.associatedToken == Token::indexOf<Token::SquareBracket>() ? '['
+                                                                                   : '(';
+    return size + 2;
+  }
+
+  // Without brackets the text is just the children, so find the first non-empty one.
+  *firstChar = '\0';
+  for (const ComponentValue& child : block.values) {
+    if (ComponentValueCssTextSize(child, firstChar) > 0) {
+      break;
+    }
+  }
+  return size;
+}
+
+}  // namespace
+
+std::size_t Declaration::cssTextSize() const {
+  std::size_t size = name.size() + 1;
+  for (size_t i = 0; i < values.size(); ++i) {
+    char firstChar = '\0';
+    size += ComponentValueCssTextSize(values[i], &firstChar);
+    // Matches the space toCssText() inserts after the colon.
+    if (i == 0 && firstChar != '\0' && firstChar != ' ') {
+      size += 1;
+    }
+  }
+  if (important) {
+    size += std::string_view(" !important").size();
+  }
+  return size;
+}
+
 std::ostream& operator<<(std::ostream& os, const Declaration& declaration) {
   os << "  " << declaration.name << ":";
   for (const auto& value : declaration.values) {
@@ -63,6 +63,12 @@ struct Declaration {
    */
   std::string toCssText() const;
 
+  /**
+   * Returns `toCssText().size()`, without serializing nested functions and blocks into
+   * temporary strings.
+   */
+  std::size_t cssTextSize() const;
+
   /**
    * Output a human-readable representation of the declaration to a stream.
    *
@@ -1,5 +1,6 @@
 #include "donner/css/parser/DeclarationListParser.h"
 
+#include <algorithm>
 #include <cassert>
 #include <optional>
 #include <span>
@@ -15,6 +16,15 @@ using details::consumeComponentValue;
 using details::consumeDeclaration;
 using details::ParseMode;
 
+/// Upper bound on the declarations reserved up front from a semicolon count, so that a long run
+/// of semicolons can't force a large allocation before anything is parsed.
+constexpr std::size_t kMaximumReservedDeclarations = 64;
+
+/// Returns the capacity to reserve for a list with \p semicolons top-level semicolons.
+std::size_t ReservedDeclarations(std::size_t semicolons) {
+  return std::min(semicolons + 1, kMaximumReservedDeclarations);
+}
+
 template <typename T>
 class SubTokenizer {
 public:
@@ -85,7 +95,8 @@ private:
 
 template <details::DeclarationTokenizer T>
 std::optional<Declaration> parseDeclarationGeneric(
-    T& tokenizer, Token&& token, details::ComponentValueParsingBudget* aggregateBudget = nullptr) {
+    T& tokenizer, Token&& token, details::FlatComponentValues& scratch,
+    details::ComponentValueParsingBudget* aggregateBudget = nullptr) {
   if (token.is<Token::Ident>()) {
     // <ident-token>: Initialize a temporary list initially filled with the current input token.
     Token::Ident ident = std::move(token.get<Token::Ident>());
@@ -97,9 +108,10 @@ std::optional<Declaration> parseDeclarationGeneric(
     ParseUntilSemicolonOrEOF<T> declarationInputTokenizer(tokenizer);
     if constexpr (std::is_same_v<typename T::ItemType, Token>) {
       return consumeDeclaration(declarationInputTokenizer, std::move(ident), token.offset(),
-                                aggregateBudget);
+                                scratch, aggregateBudget);
     } else {
-      return consumeDeclaration(declarationInputTokenizer, std::move(ident), token.offset());
+      return consumeDeclaration(declarationInputTokenizer, std::move(ident), token.offset(),
+                                scratch);
     }
   } else {
     // anything else: This is a parse error. Reconsume the current input token. As long as the
@@ -123,7 +135,7 @@ std::optional<Declaration> parseDeclarationGeneric(
         break;
       }
 
-      std::ignore = subToken.asComponentValue(ParseMode::Discard);
+      subToken.skip();
       if (aggregateBudget != nullptr && aggregateBudget->resourceLimitExceeded()) {
         return std::nullopt;
       }
@@ -137,10 +149,14 @@ class DeclarationListParserImpl {
 public:
   DeclarationListParserImpl(std::string_view str,
                             DeclarationListParser::SecurityStats* securityStats)
-      : tokenizer_(str), securityStats_(securityStats) {}
+      : tokenizer_(str),
+        securityStats_(securityStats),
+        reservedDeclarations_(
+            ReservedDeclarations(static_cast<std::size_t>(std::ranges::count(str, ';')))) {}
 
   std::vector<DeclarationOrAtRule> parse() {
     std::vector<DeclarationOrAtRule> result;
+    result.reserve(reservedDeclarations_);
 
     while (!tokenizer_.isEOF()) {
       if (result.size() >= DeclarationListParser::kMaximumDeclarations) {
@@ -163,8 +179,8 @@ public:
         // Skip.
       } else {
         details::DeclarationTokenTokenizer declarationTokenizer(tokenizer_, &aggregateBudget_);
-        auto maybeDeclaration =
-            parseDeclarationGeneric(declarationTokenizer, std::move(token), &aggregateBudget_);
+        auto maybeDeclaration = parseDeclarationGeneric(declarationTokenizer, std::move(token),
+                                                        scratch_, &aggregateBudget_);
 
         if (!aggregateBudget_.resourceLimitExceeded() && maybeDeclaration.has_value()) {
           result.emplace_back(std::move(maybeDeclaration.value()));
@@ -189,6 +205,7 @@ public:
 
   std::vector<Declaration> parseDeclarations() {
     std::vector<Declaration> result;
+    result.reserve(reservedDeclarations_);
 
     while (!tokenizer_.isEOF()) {
       if (result.size() >= DeclarationListParser::kMaximumDeclarations) {
@@ -210,8 +227,8 @@ public:
       } else {
         details::DeclarationTokenTokenizer declarationTokenizer(tokenizer_, &aggregateBudget_);
 
-        auto maybeDeclaration =
-            parseDeclarationGeneric(declarationTokenizer, std::move(token), &aggregateBudget_);
+        auto maybeDeclaration = parseDeclarationGeneric(declarationTokenizer, std::move(token),
+                                                        scratch_, &aggregateBudget_);
         if (maybeDeclaration.has_value()) {
           result.emplace_back(std::move(maybeDeclaration.value()));
         }
@@ -235,6 +252,10 @@ private:
   details::Tokenizer tokenizer_;
   details::ComponentValueParsingBudget aggregateBudget_;
   DeclarationListParser::SecurityStats* securityStats_;
+  /// Capacity reserved for the result, from the number of semicolons in the input.
+  std::size_t reservedDeclarations_;
+  /// Scratch storage for declaration values, reused across the list.
+  details::FlatComponentValues scratch_;
 };
 
 }  // namespace
@@ -277,8 +298,14 @@ std::vector<Declaration> DeclarationListParser::ParseRuleDeclarations(
     return result;
   }
 
+  result.reserve(ReservedDeclarations(static_cast<std::size_t>(
+      std::ranges::count_if(components, [](const ComponentValue& value) {
+        return value.isToken<Token::Semicolon>();
+      }))));
+
   SubTokenizer<ComponentValue> tokenizer(components);
   details::DeclarationComponentValueTokenizer declarationTokenizer(tokenizer);
+  details::FlatComponentValues scratch;
 
   while (!declarationTokenizer.isEOF()) {
     if (result.size() >= DeclarationListParser::kMaximumDeclarations) {
@@ -290,7 +317,8 @@ std::vector<Declaration> DeclarationListParser::ParseRuleDeclarations(
     if (token.template isToken<Token::Whitespace>() || token.template isToken<Token::Semicolon>()) {
       // Skip.
     } else if (Token* innerToken = std::get_if<Token>(&token.value.value)) {
-      auto maybeDeclaration = parseDeclarationGeneric(declarationTokenizer, std::move(*innerToken));
+      auto maybeDeclaration =
+          parseDeclarationGeneric(declarationTokenizer, std::move(*innerToken), scratch);
       if (maybeDeclaration.has_value()) {
         result.emplace_back(std::move(maybeDeclaration.value()));
       }
@@ -10,6 +10,8 @@ namespace {
 enum class ListOfRulesFlags { None, TopLevel };
 
 using details::consumeAtRule;
+using details::consumeFlatComponentValue;
+using details::consumeFlatSimpleBlock;
 using details::ParseMode;
 
 class RuleParserImpl {
@@ -105,6 +107,7 @@ public:
                                               RuleParser::SecurityStats* securityStats = nullptr) {
     std::vector<Rule> result;
     details::ComponentValueParsingBudget aggregateBudget;
+    details::FlatComponentValues scratch;
 
     while (!tokenizer.isEOF()) {
       if (result.size() >= RuleParser::kMaximumRules) {
@@ -124,8 +127,8 @@ public:
         } else {
           // Otherwise, reconsume the current input token. Consume a qualified rule. If anything is
           // returned, append it to the list of rules.
-          if (auto maybeQualifiedRule =
-                  consumeQualifiedRule(tokenizer, std::move(token), &aggregateBudget)) {
+          if (auto maybeQualifiedRule = consumeQualifiedRule(tokenizer, std::move(token), scratch,
+                                                             &aggregateBudget)) {
             result.emplace_back(std::move(maybeQualifiedRule.value()));
           } else {
             result.emplace_back(InvalidRule());
@@ -145,7 +148,7 @@ public:
         // anything else: Reconsume the current input token. Consume a qualified rule. If anything
         // is returned, append it to the list of rules.
         if (auto maybeQualifiedRule =
-                consumeQualifiedRule(tokenizer, std::move(token), &aggregateBudget)) {
+                consumeQualifiedRule(tokenizer, std::move(token), scratch, &aggregateBudget)) {
           result.emplace_back(std::move(maybeQualifiedRule.value()));
         } else {
           result.emplace_back(InvalidRule());
@@ -169,7 +172,21 @@ public:
   static std::optional<QualifiedRule> consumeQualifiedRule(
       details::Tokenizer& tokenizer, Token&& firstToken,
       details::ComponentValueParsingBudget* aggregateBudget = nullptr) {
-    std::vector<ComponentValue> prelude;
+    details::FlatComponentValues scratch;
+    return consumeQualifiedRule(tokenizer, std::move(firstToken), scratch, aggregateBudget);
+  }
+
+  /**
+   * Consume a qualified rule, per https://www.w3.org/TR/css-syntax-3/#consume-qualified-rule.
+   *
+   * The prelude and block are built in \p scratch, which is cleared first, and then materialized
+   * with exactly sized vectors. Reusing the same scratch for a list of rules avoids growing a
+   * vector for every nested block.
+   */
+  static std::optional<QualifiedRule> consumeQualifiedRule(
+      details::Tokenizer& tokenizer, Token&& firstToken, details::FlatComponentValues& scratch,
+      details::ComponentValueParsingBudget* aggregateBudget = nullptr) {
+    scratch.clear();
     details::ComponentValueParsingContext parsingContext(aggregateBudget);
     Token token = std::move(firstToken);
 
@@ -180,16 +197,20 @@ public:
       } else if (token.is<Token::CurlyBracket>()) {
         // <{-token>: Consume a simple block and assign it to the qualified rule's block. Return the
         // qualified rule.
-        return QualifiedRule(
-            std::move(prelude),
-            consumeSimpleBlock(tokenizer, std::move(token), ParseMode::Keep, parsingContext));
+        const std::size_t blockIndex = scratch.size();
+        consumeFlatSimpleBlock(tokenizer, std::move(token), scratch, parsingContext);
+
+        std::vector<ComponentValue> prelude;
+        scratch.materializeSiblings(0, scratch.countSiblings(0, blockIndex), prelude);
+        return QualifiedRule(std::move(prelude),
+                             std::get<SimpleBlock>(scratch.materialize(blockIndex).value));
       } else {
         // anything else: Reconsume the current input token. Consume a component value. Append the
         // returned value to the qualified rule's prelude.
-        auto component =
-            consumeComponentValue(tokenizer, std::move(token), ParseMode::Keep, parsingContext);
-        if (!parsingContext.resourceLimitExceeded()) {
-          prelude.emplace_back(std::move(component));
+        const std::size_t mark = scratch.size();
+        consumeFlatComponentValue(tokenizer, std::move(token), scratch, parsingContext);
+        if (parsingContext.resourceLimitExceeded()) {
+          scratch.truncate(mark);
         }
       }
 
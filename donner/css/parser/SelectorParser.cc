@@ -286,7 +286,7 @@ private:
     // <complex-selector> = <compound-selector> [ <combinator>? <compound-selector> ]*
     ComplexSelector result;
     if (auto maybeCompoundSelector = handleCompoundSelector()) {
-      result.entries.push_back({Combinator::Descendant, *maybeCompoundSelector});
+      result.entries.push_back({Combinator::Descendant, std::move(*maybeCompoundSelector)});
     } else {
       // Error has already been inside handleCompoundSelector.
       return std::nullopt;
@@ -329,7 +329,7 @@ private:
       skipWhitespace();
 
       if (auto maybeCompoundSelector = handleCompoundSelector()) {
-        result.entries.push_back({combinator, *maybeCompoundSelector});
+        result.entries.push_back({combinator, std::move(*maybeCompoundSelector)});
       } else {
         // Error has already been inside handleCompoundSelector.
         return std::nullopt;
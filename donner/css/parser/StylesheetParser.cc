@@ -98,6 +98,7 @@ std::size_t FindMatchingRuleEnd(std::string_view str, std::size_t openBraceOffse
 std::vector<SourceRange> SplitSelectorEntryRanges(std::string_view str, std::size_t start,
                                                   std::size_t end, std::size_t expectedEntryCount) {
   std::vector<SourceRange> result;
+  result.reserve(expectedEntryCount);
   std::size_t entryStart = start;
   int parenDepth = 0;
   int squareDepth = 0;
@@ -7,6 +7,7 @@
 #include "donner/css/Declaration.h"
 #include "donner/css/Token.h"
 #include "donner/css/parser/details/Common.h"
+#include "donner/css/parser/details/FlatComponentValues.h"
 #include "donner/css/parser/details/Tokenizer.h"
 
 namespace donner::css::parser::details {
@@ -104,6 +105,9 @@ Function consumeFunction(T& tokenizer, Token::Function&& functionToken, const Fi
 template <TokenizerLike<Token> T>
 SimpleBlock consumeSimpleBlock(T& tokenizer, Token&& firstToken, ParseMode mode,
                                ComponentValueParsingContext& parsingContext);
+template <TokenizerLike<Token> T>
+void consumeFlatComponentValue(T& tokenizer, Token&& token, FlatComponentValues& out,
+                               ComponentValueParsingContext& parsingContext);
 
 /// Consume a component value, per https://www.w3.org/TR/css-syntax-3/#consume-component-value
 template <TokenizerLike<Token> T>
@@ -132,31 +136,39 @@ ComponentValue consumeComponentValue(T& tokenizer, Token&& token, ParseMode mode
 template <TokenizerLike<Token> T>
 std::vector<ComponentValue> parseListOfComponentValues(
     T& tokenizer, WhitespaceHandling whitespace = WhitespaceHandling::Keep) {
-  std::vector<ComponentValue> result;
+  // Build the list flat so that nested blocks and functions don't grow a vector per level, then
+  // materialize it with exactly sized vectors.
+  FlatComponentValues values;
   ComponentValueParsingContext parsingContext;
 
   while (!tokenizer.isEOF()) {
     Token token = tokenizer.next();
-    if (whitespace == WhitespaceHandling::TrimLeadingAndTrailing && result.empty() &&
+    if (whitespace == WhitespaceHandling::TrimLeadingAndTrailing && values.empty() &&
         token.is<Token::Whitespace>()) {
       continue;
     }
 
     if (!token.is<Token::EofToken>()) {
-      ComponentValue value =
-          consumeComponentValue(tokenizer, std::move(token), ParseMode::Keep, parsingContext);
-      if (!parsingContext.resourceLimitExceeded()) {
-        result.emplace_back(std::move(value));
+      const std::size_t mark = values.size();
+      consumeFlatComponentValue(tokenizer, std::move(token), values, parsingContext);
+      if (parsingContext.resourceLimitExceeded()) {
+        values.truncate(mark);
       }
     }
   }
 
-  if (whitespace == WhitespaceHandling::TrimLeadingAndTrailing) {
-    while (!result.empty() && result.back().isToken<Token::Whitespace>()) {
-      result.pop_back();
+  std::size_t count = 0;
+  std::size_t keptCount = 0;
+  for (std::size_t i = 0; i < values.size(); i = values[i].end) {
+    ++count;
+    if (whitespace != WhitespaceHandling::TrimLeadingAndTrailing ||
+        !values[i].isToken<Token::Whitespace>()) {
+      keptCount = count;
     }
   }
 
+  std::vector<ComponentValue> result;
+  values.materializeSiblings(0, keptCount, result);
   return result;
 }
 
@@ -225,6 +237,93 @@ Function consumeFunction(T& tokenizer, Token::Function&& functionToken, const Fi
   return result;
 }
 
+/**
+ * Consume a simple block into \p out, per https://www.w3.org/TR/css-syntax-3/#consume-simple-block.
+ * Matches \ref consumeSimpleBlock in \ref ParseMode::Keep.
+ */
+template <TokenizerLike<Token> T>
+void consumeFlatSimpleBlock(T& tokenizer, Token&& firstToken, FlatComponentValues& out,
+                            ComponentValueParsingContext& parsingContext) {
+  const TokenIndex endingTokenIndex = simpleBlockEnding(firstToken.tokenIndex());
+  const FileOffset sourceOffset = firstToken.offset();
+  const std::size_t index = out.beginGroup(FlatComponentValues::Kind::SimpleBlock,
+                                           std::move(firstToken), sourceOffset);
+
+  while (!tokenizer.isEOF()) {
+    Token token = tokenizer.next();
+    if (token.tokenIndex() == endingTokenIndex) {
+      break;
+    }
+
+    auto recursionGuard = parsingContext.addLevel();
+    if (parsingContext.hitLimit()) {
+      // This is a parse error, we hit our recursion limit.
+      break;
+    }
+
+    const std::size_t mark = out.size();
+    consumeFlatComponentValue(tokenizer, std::move(token), out, parsingContext);
+    if (parsingContext.resourceLimitExceeded()) {
+      out.truncate(mark);
+    }
+  }
+
+  out.endGroup(index);
+}
+
+/**
+ * Consume a function into \p out, per https://www.w3.org/TR/css-syntax-3/#consume-function.
+ * Matches \ref consumeFunction in \ref ParseMode::Keep.
+ */
+template <TokenizerLike<Token> T>
+void consumeFlatFunction(T& tokenizer, Token&& functionToken, FlatComponentValues& out,
+                         ComponentValueParsingContext& parsingContext) {
+  const FileOffset sourceOffset = functionToken.offset();
+  const std::size_t index = out.beginGroup(FlatComponentValues::Kind::Function,
+                                           std::move(functionToken), sourceOffset);
+
+  while (!tokenizer.isEOF()) {
+    Token token = tokenizer.next();
+    if (token.is<Token::CloseParenthesis>()) {
+      break;
+    }
+
+    auto recursionGuard = parsingContext.addLevel();
+    if (parsingContext.hitLimit()) {
+      // This is a parse error, we hit our recursion limit.
+      break;
+    }
+
+    const std::size_t mark = out.size();
+    consumeFlatComponentValue(tokenizer, std::move(token), out, parsingContext);
+    if (parsingContext.resourceLimitExceeded()) {
+      out.truncate(mark);
+    }
+  }
+
+  out.endGroup(index);
+}
+
+/**
+ * Consume a component value into \p out, per
+ * https://www.w3.org/TR/css-syntax-3/#consume-component-value. Matches \ref consumeComponentValue
+ * in \ref ParseMode::Keep, including appending the bare token once the parsing budget is spent.
+ */
+template <TokenizerLike<Token> T>
+void consumeFlatComponentValue(T& tokenizer, Token&& token, FlatComponentValues& out,
+                               ComponentValueParsingContext& parsingContext) {
+  if (!parsingContext.reserveValue()) {
+    out.appendToken(std::move(token));
+  } else if (token.is<Token::CurlyBracket>() || token.is<Token::SquareBracket>() ||
+             token.is<Token::Parenthesis>()) {
+    consumeFlatSimpleBlock(tokenizer, std::move(token), out, parsingContext);
+  } else if (token.is<Token::Function>()) {
+    consumeFlatFunction(tokenizer, std::move(token), out, parsingContext);
+  } else {
+    out.appendToken(std::move(token));
+  }
+}
+
 /// Consume an at-rule, per https://www.w3.org/TR/css-syntax-3/#consume-at-rule
 template <TokenizerLike<Token> T>
 AtRule consumeAtRule(T& tokenizer, Token::AtKeyword&& atKeyword, ParseMode mode,
@@ -0,0 +1,190 @@
+#pragma once
+/// @file
+/// @brief Flat, index-linked storage for component value trees, used as the parsers'
+/// intermediate representation.
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "donner/base/FileOffset.h"
+#include "donner/base/SmallVector.h"
+#include "donner/base/Utils.h"
+#include "donner/css/ComponentValue.h"
+#include "donner/css/Token.h"
+
+namespace donner::css::parser::details {
+
+/**
+ * A list of component value trees stored flat, in preorder, in one buffer. A \ref Function or
+ * \ref SimpleBlock node is immediately followed by its descendants and records the index one past
+ * the last of them, instead of owning a vector of children.
+ *
+ * Parsers consume tokens into a FlatComponentValues and clear it between declarations and rules,
+ * so its buffer is reused across a whole declaration list or stylesheet and building the
+ * intermediate tree costs no allocation per token. Owning \ref ComponentValue trees, with
+ * exactly-sized child vectors, are only materialized for the values a parser returns.
+ *
+ * This is scratch, not storage: a parsed \ref Declaration, \ref Rule or \ref Selector still owns
+ * its values, since the property parsers read them as `std::span<const ComponentValue>`. Those
+ * owning vectors are most of what remains of a stylesheet parse's allocations.
+ */
+class FlatComponentValues {
+public:
+  /// Kind of a node, one per alternative of \ref ComponentValue::Type.
+  enum class Kind : uint8_t {
+    Token,        //!< A standalone \ref Token.
+    Function,     //!< A \ref Function, followed by its parameter values.
+    SimpleBlock,  //!< A \ref SimpleBlock, followed by its values.
+  };
+
+  /// One component value.
+  struct Node {
+    /// For \ref Kind::Token the token itself, for \ref Kind::Function the \ref Token::Function
+    /// holding the function name, and for \ref Kind::SimpleBlock the opening bracket token.
+    Token token;
+
+    /// Source offset of the value, which for groups is the offset of the opening token.
+    FileOffset sourceOffset;
+
+    /// Index one past the last descendant of this node, which is the index of its next sibling.
+    std::size_t end;
+
+    /// Node kind.
+    Kind kind;
+
+    /// Returns true if this is a \ref Kind::Token node holding a token of type \p T.
+    template <typename T>
+    bool isToken() const {
+      return kind == Kind::Token && token.is<T>();
+    }
+  };
+
+  /// Number of nodes, counting descendants.
+  std::size_t size() const { return nodes_.size(); }
+
+  /// Returns true if there are no nodes.
+  bool empty() const { return nodes_.empty(); }
+
+  /// Returns the node at \p index.
+  const Node& operator[](std::size_t index) const { return nodes_[index]; }
+
+  /// Removes every node, keeping the allocated buffer for reuse.
+  void clear() { nodes_.clear(); }
+
+  /// Removes the nodes at \p size and after, which must not split a group.
+  void truncate(std::size_t size) {
+    while (nodes_.size() > size) {
+      nodes_.pop_back();
+    }
+  }
+
+  /// Appends a \ref Kind::Token node.
+  void appendToken(Token&& token) {
+    const FileOffset sourceOffset = token.offset();
+    nodes_.emplace_back(Node{std::move(token), sourceOffset, nodes_.size() + 1, Kind::Token});
+  }
+
+  /**
+   * Appends a \ref Kind::Function or \ref Kind::SimpleBlock node. Nodes appended until the
+   * matching \ref endGroup call become its descendants.
+   *
+   * @param kind Group kind.
+   * @param token The \ref Token::Function or opening bracket token.
+   * @param sourceOffset Source offset of the group.
+   * @return Index of the group node.
+   */
+  std::size_t beginGroup(Kind kind, Token&& token, const FileOffset& sourceOffset) {
+    assert(kind != Kind::Token);
+    const std::size_t index = nodes_.size();
+    nodes_.emplace_back(Node{std::move(token), sourceOffset, index + 1, kind});
+    return index;
+  }
+
+  /// Closes the group started at \p index by \ref beginGroup.
+  void endGroup(std::size_t index) { nodes_[index].end = nodes_.size(); }
+
+  /// Appends a copy of the tree \p value.
+  void append(const ComponentValue& value) {
+    if (const Token* token = std::get_if<Token>(&value.value)) {
+      appendToken(Token(*token));
+    } else if (const Function* function = std::get_if<Function>(&value.value)) {
+      const std::size_t index = beginGroup(
+          Kind::Function, Token(Token::Function(function->name), 0), function->sourceOffset);
+      for (const ComponentValue& child : function->values) {
+        append(child);
+      }
+      endGroup(index);
+    } else {
+      const SimpleBlock& block = std::get<SimpleBlock>(value.value);
+      const std::size_t index = beginGroup(
+          Kind::SimpleBlock, BlockOpeningToken(block.associatedToken), block.sourceOffset);
+      for (const ComponentValue& child : block.values) {
+        append(child);
+      }
+      endGroup(index);
+    }
+  }
+
+  /// Number of sibling nodes in [\p begin, \p end), where \p begin is the first of them.
+  std::size_t countSiblings(std::size_t begin, std::size_t end) const {
+    std::size_t count = 0;
+    for (std::size_t i = begin; i < end; i = nodes_[i].end) {
+      ++count;
+    }
+    return count;
+  }
+
+  /// Materializes the node at \p index, with its descendants, as an owning tree.
+  ComponentValue materialize(std::size_t index) const {
+    const Node& node = nodes_[index];
+    switch (node.kind) {
+      case Kind::Token: return ComponentValue(Token(node.token));
+      case Kind::Function: {
+        Function function(node.token.get<Token::Function>().name, node.sourceOffset);
+        materializeSiblings(index + 1, countSiblings(index + 1, node.end), function.values);
+        return ComponentValue(std::move(function));
+      }
+      case Kind::SimpleBlock: {
+        SimpleBlock block(node.token.tokenIndex(), node.sourceOffset);
+        materializeSiblings(index + 1, countSiblings(index + 1, node.end), block.values);
+        return ComponentValue(std::move(block));
+      }
+    }
+    UTILS_UNREACHABLE();
+  }
+
+  /**
+   * Materializes \p count sibling nodes starting at \p begin and appends them to \p out, reserving
+   * the space up front.
+   */
+  void materializeSiblings(std::size_t begin, std::size_t count,
+                           std::vector<ComponentValue>& out) const {
+    out.reserve(out.size() + count);
+    for (std::size_t i = begin; count > 0; i = nodes_[i].end, --count) {
+      out.emplace_back(materialize(i));
+    }
+  }
+
+private:
+  /// Inline node capacity, enough for a typical property value without touching the heap.
+  static constexpr std::size_t kInlineNodes = 16;
+
+  /// Returns an opening bracket token for a block of type \p associatedToken. Group offsets are
+  /// read from \ref Node::sourceOffset, so the token offset is unused.
+  static Token BlockOpeningToken(TokenIndex associatedToken) {
+    if (associatedToken == Token::indexOf<Token::CurlyBracket>()) {
+      return Token(Token::CurlyBracket(), 0);
+    } else if (associatedToken == Token::indexOf<Token::SquareBracket>()) {
+      return Token(Token::SquareBracket(), 0);
+    } else {
+      assert(associatedToken == Token::indexOf<Token::Parenthesis>());
+      return Token(Token::Parenthesis(), 0);
+    }
+  }
+
+  SmallVector<Node, kInlineNodes> nodes_;
+};
+
+}  // namespace donner::css::parser::details
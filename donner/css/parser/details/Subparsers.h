@@ -7,6 +7,7 @@
 #include "donner/css/Token.h"
 #include "donner/css/parser/details/Common.h"
 #include "donner/css/parser/details/ComponentValueParser.h"
+#include "donner/css/parser/details/FlatComponentValues.h"
 
 namespace donner::css::parser::details {
 
@@ -14,10 +15,11 @@ template <typename T, typename U>
 concept DecayedSameAs = std::is_same_v<std::decay_t<T>, U>;
 
 template <typename T, typename ItemType>
-concept DeclarationTokenizerItem = requires(T t, ParseMode parseMode) {
+concept DeclarationTokenizerItem = requires(T t, FlatComponentValues& values) {
   { t.value } -> DecayedSameAs<ItemType>;
   { t.offset() } -> std::same_as<FileOffset>;
-  { t.asComponentValue(parseMode) } -> std::same_as<ComponentValue>;
+  { t.appendTo(values) } -> std::same_as<void>;
+  { t.skip() } -> std::same_as<void>;
 };
 
 template <typename T>
@@ -50,9 +52,17 @@ struct DeclarationTokenTokenizer {
 
     FileOffset offset() const { return value.offset(); }
 
-    ComponentValue asComponentValue(ParseMode parseMode = ParseMode::Keep) {
+    /// Consumes the component value starting with this token into \p values.
+    void appendTo(FlatComponentValues& values) {
       ComponentValueParsingContext parsingContext(aggregateBudget);
-      return consumeComponentValue(tokenizer.get(), std::move(value), parseMode, parsingContext);
+      consumeFlatComponentValue(tokenizer.get(), std::move(value), values, parsingContext);
+    }
+
+    /// Consumes and discards the component value starting with this token.
+    void skip() {
+      ComponentValueParsingContext parsingContext(aggregateBudget);
+      std::ignore = consumeComponentValue(tokenizer.get(), std::move(value), ParseMode::Discard,
+                                          parsingContext);
     }
   };
 
@@ -82,9 +92,9 @@ struct DeclarationComponentValueTokenizer {
 
     FileOffset offset() const { return value.sourceOffset(); }
 
-    ComponentValue asComponentValue(ParseMode parseMode = ParseMode::Keep) {
-      return std::move(value);
-    }
+    void appendTo(FlatComponentValues& values) { values.append(value); }
+
+    void skip() {}
   };
 
   using ItemType = ComponentValue;
@@ -98,10 +108,19 @@ private:
   T& tokenizer_;
 };
 
-/// Consume a declaration, per https://www.w3.org/TR/css-syntax-3/#consume-declaration
+/**
+ * Consume a declaration, per https://www.w3.org/TR/css-syntax-3/#consume-declaration
+ *
+ * @param tokenizer Tokenizer positioned after the declaration name.
+ * @param ident Declaration name.
+ * @param offset Offset of the declaration name.
+ * @param scratch Scratch storage for the declaration value, cleared before use. Passing the same
+ *   storage for each declaration in a list reuses its buffer.
+ * @param aggregateBudget Optional budget shared with the rest of the stylesheet.
+ */
 template <DeclarationTokenizer T>
 std::optional<Declaration> consumeDeclarationGeneric(
-    T& tokenizer, Token::Ident&& ident, const FileOffset& offset,
+    T& tokenizer, Token::Ident&& ident, const FileOffset& offset, FlatComponentValues& scratch,
     ComponentValueParsingBudget* aggregateBudget = nullptr) {
   {
     bool hadColon = false;
@@ -128,6 +147,11 @@ std::optional<Declaration> consumeDeclarationGeneric(
 
   Declaration declaration(std::move(ident.value), {}, offset);
 
+  // Values are collected into the flat scratch storage first, and only the ones that are kept
+  // (without "!important" and trailing whitespace) are materialized into the declaration.
+  scratch.clear();
+  std::size_t numValues = 0;
+
   bool lastWasImportantBang = false;
   bool hitNonWhitespace = false;
   int trailingWhitespace = 0;
@@ -144,11 +168,11 @@ std::optional<Declaration> consumeDeclarationGeneric(
     if (token.template isToken<Token::Whitespace>()) {
       // While the next input token is a <whitespace-token>, consume the next input token.
       if (hitNonWhitespace) {
-        ComponentValue componentValue = token.asComponentValue();
+        token.appendTo(scratch);
         if (aggregateBudget != nullptr && aggregateBudget->resourceLimitExceeded()) {
           return std::nullopt;
         }
-        declaration.values.emplace_back(std::move(componentValue));
+        ++numValues;
         ++trailingWhitespace;
       }
     } else {
@@ -157,20 +181,24 @@ std::optional<Declaration> consumeDeclarationGeneric(
 
       // As long as the next input token is anything other than an <EOF-token>, consume a
       // component value and append it to the declaration's value.
-      auto componentValue = token.asComponentValue();
+      const std::size_t index = scratch.size();
+      token.appendTo(scratch);
       if (aggregateBudget != nullptr && aggregateBudget->resourceLimitExceeded()) {
         return std::nullopt;
       }
+      ++numValues;
 
       // Scan for important.
-      if (Token* valueToken = std::get_if<Token>(&componentValue.value)) {
-        if (lastWasImportantBang && valueToken->is<Token::Ident>() &&
-            valueToken->get<Token::Ident>().value.equalsLowercase("important")) {
+      const FlatComponentValues::Node& node = scratch[index];
+      if (node.kind == FlatComponentValues::Kind::Token) {
+        const Token& valueToken = node.token;
+        if (lastWasImportantBang && valueToken.is<Token::Ident>() &&
+            valueToken.get<Token::Ident>().value.equalsLowercase("important")) {
           declaration.important = true;
           lastWasImportantBang = false;
         } else {
           lastWasImportantBang =
-              (valueToken->is<Token::Delim>() && valueToken->get<Token::Delim>().value == '!');
+              (valueToken.is<Token::Delim>() && valueToken.get<Token::Delim>().value == '!');
           if (!lastWasImportantBang || declaration.important) {
             trailingWhitespace = 0;
             lastConsumedNonWhitespaceOffset = tokenOffset;
@@ -183,45 +211,50 @@ std::optional<Declaration> consumeDeclarationGeneric(
         trailingWhitespace = 0;
         lastConsumedNonWhitespaceOffset = tokenOffset;
       }
-
-      declaration.values.emplace_back(std::move(componentValue));
     }
   }
 
   if (declaration.important) {
-    assert(declaration.values.size() >= 2);
-    declaration.values.pop_back();
-    declaration.values.pop_back();
+    assert(numValues >= 2);
+    numValues -= 2;
   }
 
-  while (trailingWhitespace > 0) {
-    --trailingWhitespace;
-    declaration.values.pop_back();
-  }
+  numValues -= static_cast<std::size_t>(trailingWhitespace);
 
   declaration.sourceRange = SourceRange{offset, lastConsumedNonWhitespaceOffset};
   if (aggregateBudget != nullptr && aggregateBudget->resourceLimitExceeded()) {
     return std::nullopt;
   }
-  declaration.sourceByteSize = declaration.toCssText().size();
+  scratch.materializeSiblings(0, numValues, declaration.values);
+  declaration.sourceByteSize = declaration.cssTextSize();
   return declaration;
 }
 
 /// Consume a declaration, per https://www.w3.org/TR/css-syntax-3/#consume-declaration
 template <TokenizerLike<Token> T>
 std::optional<Declaration> consumeDeclaration(
-    T& tokenizer, Token::Ident&& ident, const FileOffset& offset,
+    T& tokenizer, Token::Ident&& ident, const FileOffset& offset, FlatComponentValues& scratch,
     ComponentValueParsingBudget* aggregateBudget = nullptr) {
   DeclarationTokenTokenizer declarationTokenizer(tokenizer, aggregateBudget);
-  return consumeDeclarationGeneric(declarationTokenizer, std::move(ident), offset, aggregateBudget);
+  return consumeDeclarationGeneric(declarationTokenizer, std::move(ident), offset, scratch,
+                                   aggregateBudget);
+}
+
+/// Consume a declaration, per https://www.w3.org/TR/css-syntax-3/#consume-declaration
+template <TokenizerLike<Token> T>
+std::optional<Declaration> consumeDeclaration(T& tokenizer, Token::Ident&& ident,
+                                              const FileOffset& offset) {
+  FlatComponentValues scratch;
+  return consumeDeclaration(tokenizer, std::move(ident), offset, scratch);
 }
 
 /// Consume a declaration, starting with an partially parsed set of ComponentValues.
 template <TokenizerLike<ComponentValue> T>
 std::optional<Declaration> consumeDeclaration(T& tokenizer, Token::Ident&& ident,
-                                              const FileOffset& offset) {
+                                              const FileOffset& offset,
+                                              FlatComponentValues& scratch) {
   DeclarationComponentValueTokenizer declarationTokenizer(tokenizer);
-  return consumeDeclarationGeneric(declarationTokenizer, std::move(ident), offset);
+  return consumeDeclarationGeneric(declarationTokenizer, std::move(ident), offset, scratch);
 }
 
 }  // namespace donner::css::parser::details
@@ -415,8 +415,23 @@ Token Tokenizer::consumeQuotedString() {
   const char quote = remaining_[0];
   assert(quote == '"' || quote == '\'');
 
-  std::vector<char> str;
   const size_t remainingSize = remaining_.size();
+
+  // Fast path: strings without escapes or NULs are a plain substring of the input, so build the
+  // RcString directly and let short strings stay in its inline storage.
+  {
+    size_t end = 1;
+    while (end < remainingSize && remaining_[end] != quote && remaining_[end] != '\\' &&
+           remaining_[end] != '\0' && !isNewline(remaining_[end])) {
+      ++end;
+    }
+
+    if (end < remainingSize && remaining_[end] == quote) {
+      return token<Token::String>(end + 1, RcString(remaining_.substr(1, end - 1)));
+    }
+  }
+
+  std::vector<char> str;
   for (size_t i = 1; i < remainingSize; ++i) {
     const char ch = remaining_[i];
     if (ch == quote) {
@@ -537,6 +552,24 @@ Token Tokenizer::consumeUrlToken(const std::string_view afterUrl, size_t charsCo
     ++i;
   }
 
+  // Fast path: a url without escapes, NULs or inner whitespace is a plain substring of the input.
+  {
+    size_t end = i;
+    while (end < afterUrl.size()) {
+      const char ch = afterUrl[end];
+      if (ch == ')' || ch == '\\' || ch == '\0' || ch == '(' || isWhitespace(ch) || isQuote(ch) ||
+          isNonPrintableCodepoint(ch)) {
+        break;
+      }
+      ++end;
+    }
+
+    if (end < afterUrl.size() && afterUrl[end] == ')') {
+      return token<Token::Url>(end + charsConsumedBefore + 1,
+                               RcString(afterUrl.substr(i, end - i)));
+    }
+  }
+
   std::vector<char> str;
   while (i < afterUrl.size()) {
     const char ch = afterUrl[i];
@@ -122,6 +122,23 @@ TEST(DeclarationListParser, OnlyDeclarations) {
                           DeclarationIs("name2", ElementsAre(TokenIsIdent("value2")), true)));
 }
 
+TEST(DeclarationListParser, NestedValues) {
+  EXPECT_THAT(
+      DeclarationListParser::Parse("name: f(a [b] ) {c} !important; next: 'str' url(x) "),
+      ElementsAre(
+          DeclarationIs("name",
+                        ElementsAre(FunctionIs("f", ElementsAre(TokenIsIdent("a"),
+                                                                TokenIsWhitespace(" "),
+                                                                SimpleBlockIsSquare(ElementsAre(
+                                                                    TokenIsIdent("b"))),
+                                                                TokenIsWhitespace(" "))),
+                                    TokenIsWhitespace(" "),
+                                    SimpleBlockIsCurly(ElementsAre(TokenIsIdent("c")))),
+                        true),
+          DeclarationIs("next", ElementsAre(TokenIsString("str"), TokenIsWhitespace(" "),
+                                            TokenIsUrl("x")))));
+}
+
 TEST(DeclarationListParser, SourceRangeSpansNameToLastValueToken) {
   // Regression for the structured-editing M−1 prerequisite: every parsed
   // Declaration must carry a `sourceRange` spanning the name offset to
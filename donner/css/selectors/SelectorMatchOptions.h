@@ -26,6 +26,18 @@ public:
     return true;
   }
 
+  /**
+   * Consume \p count element visits at once if they all fit, leaving the budget untouched and
+   * not rejected otherwise. Succeeds exactly when \p count calls to \ref consume would.
+   */
+  [[nodiscard]] bool tryConsume(std::size_t count) {
+    if (rejected_ || steps_ > maximumSteps_ || count > maximumSteps_ - steps_) {
+      return false;
+    }
+    steps_ += count;
+    return true;
+  }
+
   [[nodiscard]] std::size_t steps() const { return steps_; }
   [[nodiscard]] bool rejected() const { return rejected_; }
   [[nodiscard]] std::size_t maximumSteps() const { return maximumSteps_; }
@@ -341,6 +341,25 @@ TEST(DeclarationToCssText, LeadingWhitespaceValueDoesNotAddExtraSpace) {
   EXPECT_EQ(declaration.toCssText(), "custom: value");
 }
 
+TEST(DeclarationToCssText, CssTextSizeMatchesSerializedSize) {
+  for (std::string_view css :
+       {"fill: red", "fill:red !important", "fill: rgb(255, 0, 0)", "fill: url(#gradient)",
+        "font-family: Arial, sans-serif", "custom: [a {b} (c)] f(g(h))", "empty:"}) {
+    SCOPED_TRACE(css);
+    for (const Declaration& declaration : parse(css)) {
+      EXPECT_EQ(declaration.cssTextSize(), declaration.toCssText().size());
+      EXPECT_EQ(declaration.sourceByteSize, declaration.toCssText().size());
+    }
+  }
+
+  Declaration leadingWhitespace(RcString("custom"),
+                                {
+                                    ComponentValue(Token(Token::Whitespace(" "), 0)),
+                                    ComponentValue(Token(Token::Ident("value"), 0)),
+                                });
+  EXPECT_EQ(leadingWhitespace.cssTextSize(), leadingWhitespace.toCssText().size());
+}
+
 TEST(DeclarationStream, WritesDebugDeclarationWithImportantFlag) {
   auto decls = parse("fill: red !important");
   ASSERT_EQ(decls.size(), 1u);
@@ -125,6 +125,7 @@ public:
 
 private:
   friend class ModuleBuilder;
+  friend class IrOptimizer;
 
   IrModule() = default;
 
@@ -0,0 +1,1398 @@
+#include "donner/gpu/shader/IrPasses.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <utility>
+
+/// @file
+/// The \ref donner::gpu::shader::OptimizeModule pass pipeline.
+///
+/// Every pass is a rewrite of the module's immutable statement and expression trees: rewritten
+/// nodes are rebuilt, untouched subtrees stay shared with the input module. Passes rely on the
+/// invariants \ref FunctionBuilder guarantees (expressions are pure, names are unique along any
+/// scope chain, and only `var`-rooted access chains are assigned), so they need no alias or
+/// effect analysis.
+
+namespace donner::gpu::shader {
+
+namespace {
+
+/// Folding repeats until nothing changes, bounded so a pathological module cannot spin.
+constexpr int kMaxFoldRounds = 16;
+
+/// Dead code elimination repeats per function until nothing is removed, bounded likewise.
+constexpr int kMaxDeadCodeRounds = 16;
+
+/// Builds a labeled error.
+ShaderError Err(std::string message) {
+  return ShaderError{std::move(message), "optimize"};
+}
+
+using ExprFn = std::function<IrExpr(const IrExpr&)>;
+
+/// Returns \p expr with its operands replaced by \p children, or \p expr itself if every operand
+/// is unchanged. Operand types must be unchanged.
+IrExpr WithChildren(const IrExpr& expr, std::vector<IrExpr> children) {
+  const std::vector<IrExpr>& current = expr.node().children;
+  bool changed = false;
+  for (size_t i = 0; i < children.size(); ++i) {
+    changed |= &children[i].node() != &current[i].node();
+  }
+  if (!changed) {
+    return expr;
+  }
+
+  auto node = std::make_shared<IrExpr::Node>(expr.node());
+  node->children = std::move(children);
+  return IrExpr(std::move(node));
+}
+
+/// Returns \p expr with \p fn applied to each operand.
+IrExpr MapChildren(const IrExpr& expr, const ExprFn& fn) {
+  std::vector<IrExpr> children;
+  children.reserve(expr.node().children.size());
+  for (const IrExpr& child : expr.node().children) {
+    children.push_back(fn(child));
+  }
+  return WithChildren(expr, std::move(children));
+}
+
+/// Applies \p fn to the rvalue parts of an assignment target: the access chain itself is kept,
+/// only index operands (ordinary rvalues) are rewritten.
+IrExpr MapLvalue(const IrExpr& lhs, const ExprFn& fn) {
+  const IrExpr::Node& node = lhs.node();
+  switch (node.kind) {
+    case IrExpr::Kind::Member:
+    case IrExpr::Kind::Swizzle: return WithChildren(lhs, {MapLvalue(node.children[0], fn)});
+    case IrExpr::Kind::Index:
+      return WithChildren(lhs, {MapLvalue(node.children[0], fn), fn(node.children[1])});
+    default: return lhs;
+  }
+}
+
+/// Name of the `var` an assignment target is rooted at.
+const RcString& LvalueRoot(const IrExpr& lhs) {
+  const IrExpr::Node& node = lhs.node();
+  return node.kind == IrExpr::Kind::Ref ? node.name : LvalueRoot(node.children[0]);
+}
+
+IrBlock MapBlockExprs(const IrBlock& block, const ExprFn& fn);
+
+/// Rewrites every expression of \p statement, including nested blocks and for-loop clauses.
+IrStmt MapStatementExprs(const IrStmt& statement, const ExprFn& fn) {
+  IrStmt::Data data = statement.data();
+  if (data.kind == IrStmt::Kind::Assign) {
+    data.exprs[0] = MapLvalue(data.exprs[0], fn);
+    data.exprs[1] = fn(data.exprs[1]);
+  } else {
+    for (IrExpr& expr : data.exprs) {
+      expr = fn(expr);
+    }
+  }
+  data.body = MapBlockExprs(data.body, fn);
+  data.elseBody = MapBlockExprs(data.elseBody, fn);
+  if (data.init) {
+    data.init = std::make_shared<const IrStmt>(MapStatementExprs(*data.init, fn));
+  }
+  if (data.continuing) {
+    data.continuing = std::make_shared<const IrStmt>(MapStatementExprs(*data.continuing, fn));
+  }
+  return IrStmt(std::move(data));
+}
+
+IrBlock MapBlockExprs(const IrBlock& block, const ExprFn& fn) {
+  IrBlock result;
+  result.reserve(block.size());
+  for (const IrStmt& statement : block) {
+    result.push_back(MapStatementExprs(statement, fn));
+  }
+  return result;
+}
+
+/// Calls \p fn with the index operands of an assignment target.
+void VisitLvalue(const IrExpr& lhs, const std::function<void(const IrExpr&)>& fn) {
+  const IrExpr::Node& node = lhs.node();
+  if (node.kind == IrExpr::Kind::Member || node.kind == IrExpr::Kind::Swizzle) {
+    VisitLvalue(node.children[0], fn);
+  } else if (node.kind == IrExpr::Kind::Index) {
+    VisitLvalue(node.children[0], fn);
+    fn(node.children[1]);
+  }
+}
+
+/// Calls \p fn with every rvalue expression root of \p statement, recursing into nested blocks
+/// and for-loop clauses. Assignment targets contribute only their index operands.
+void VisitStatementExprs(const IrStmt& statement, const std::function<void(const IrExpr&)>& fn) {
+  const IrStmt::Data& data = statement.data();
+  if (data.kind == IrStmt::Kind::Assign) {
+    VisitLvalue(data.exprs[0], fn);
+    fn(data.exprs[1]);
+  } else {
+    for (const IrExpr& expr : data.exprs) {
+      fn(expr);
+    }
+  }
+  for (const IrStmt& nested : data.body) {
+    VisitStatementExprs(nested, fn);
+  }
+  for (const IrStmt& nested : data.elseBody) {
+    VisitStatementExprs(nested, fn);
+  }
+  if (data.init) {
+    VisitStatementExprs(*data.init, fn);
+  }
+  if (data.continuing) {
+    VisitStatementExprs(*data.continuing, fn);
+  }
+}
+
+/// Calls \p fn with the name of every let and var declared in \p block, at any depth, including
+/// for-loop variables.
+void VisitDeclaredNames(const IrBlock& block, const std::function<void(const RcString&)>& fn) {
+  for (const IrStmt& statement : block) {
+    const IrStmt::Data& data = statement.data();
+    if (data.kind == IrStmt::Kind::Let || data.kind == IrStmt::Kind::Var) {
+      fn(data.name);
+    }
+    if (data.init) {
+      fn(data.init->data().name);
+    }
+    VisitDeclaredNames(data.body, fn);
+    VisitDeclaredNames(data.elseBody, fn);
+  }
+}
+
+/// Builds a `let name = value;` statement.
+IrStmt MakeLet(const RcString& name, const IrExpr& value) {
+  IrStmt::Data data;
+  data.kind = IrStmt::Kind::Let;
+  data.name = name;
+  data.exprs = {value};
+  return IrStmt(std::move(data));
+}
+
+/// Literal payload as its 32-bit pattern.
+uint32_t LiteralBits(const IrExpr::Node& node) {
+  return std::visit(
+      [](auto value) -> uint32_t {
+        if constexpr (std::is_same_v<decltype(value), float>) {
+          return std::bit_cast<uint32_t>(value);
+        } else {
+          return static_cast<uint32_t>(value);
+        }
+      },
+      node.literal);
+}
+
+/// Appends an exact structural key of \p expr to \p out: two expressions have equal keys if and
+/// only if they are the same computation. Unlike \ref IrExpr::toString, literals are keyed by
+/// their bits.
+void AppendKey(const IrExpr& expr, std::string& out) {
+  const IrExpr::Node& node = expr.node();
+  out += std::format("{}:{}", static_cast<int>(node.kind), node.type.toString());
+  switch (node.kind) {
+    case IrExpr::Kind::Literal:
+      out += std::format(":{}:{}", node.literal.index(), LiteralBits(node));
+      break;
+    case IrExpr::Kind::Ref:
+      out += std::format(":{}:{}", static_cast<int>(node.refKind), node.name.str());
+      break;
+    case IrExpr::Kind::Unary: out += std::format(":{}", static_cast<int>(node.unaryOp)); break;
+    case IrExpr::Kind::Binary: out += std::format(":{}", static_cast<int>(node.binaryOp)); break;
+    case IrExpr::Kind::CallBuiltin:
+      out += std::format(":{}", static_cast<int>(node.builtin));
+      break;
+    case IrExpr::Kind::Member:
+    case IrExpr::Kind::CallUser: out += ":" + node.name.str(); break;
+    case IrExpr::Kind::Swizzle: out += ":" + node.swizzle; break;
+    case IrExpr::Kind::Index:
+    case IrExpr::Kind::Construct:
+    case IrExpr::Kind::Convert: break;
+  }
+  out += '(';
+  for (const IrExpr& child : node.children) {
+    AppendKey(child, out);
+    out += ',';
+  }
+  out += ')';
+}
+
+/// Exact structural key of \p expr; see \ref AppendKey.
+std::string ExprKey(const IrExpr& expr) {
+  std::string key;
+  AppendKey(expr, key);
+  return key;
+}
+
+/// Number of nodes in \p expr.
+uint32_t ExprSize(const IrExpr& expr) {
+  uint32_t size = 1;
+  for (const IrExpr& child : expr.node().children) {
+    size += ExprSize(child);
+  }
+  return size;
+}
+
+/// Replaces every subexpression of \p expr whose key is in \p replacements, outermost first.
+IrExpr ReplaceByKey(const IrExpr& expr, const std::map<std::string, IrExpr>& replacements) {
+  if (const auto it = replacements.find(ExprKey(expr)); it != replacements.end()) {
+    return it->second;
+  }
+  return MapChildren(expr, [&](const IrExpr& child) { return ReplaceByKey(child, replacements); });
+}
+
+/// True if \p type can be bound to a let by every emitter: scalars, vectors, matrices, and
+/// structs of those. MSL spells sized arrays as C arrays, which cannot initialize a local.
+bool IsBindableType(const IrType& type) {
+  switch (type.kind()) {
+    case IrType::Kind::Scalar:
+    case IrType::Kind::Vector:
+    case IrType::Kind::Matrix4x4f: return true;
+    case IrType::Kind::Struct:
+      return std::ranges::all_of(type.structMembers(), [](const IrType::Member& member) {
+        return IsBindableType(member.type);
+      });
+    default: return false;
+  }
+}
+
+/// True if \p expr only selects part of a let or parameter (`curve.p0.y`): binding it to another
+/// let renames a register rather than saving work.
+bool IsLocalAccess(const IrExpr& expr) {
+  const IrExpr::Node& node = expr.node();
+  switch (node.kind) {
+    case IrExpr::Kind::Ref: return node.refKind == RefKind::Let || node.refKind == RefKind::Param;
+    case IrExpr::Kind::Member:
+    case IrExpr::Kind::Swizzle: return IsLocalAccess(node.children[0]);
+    default: return false;
+  }
+}
+
+/**
+ * True if \p expr may be bound to a let and evaluated at a different point than where it
+ * appears: a computation (not a bare literal, name, or \ref IsLocalAccess selection) of a
+ * bindable type that reads at least one name, reads only immutable names outside
+ * \p excludedNames, and takes no implicit derivatives.
+ *
+ * Derivative builtins are excluded because moving them can move them into non-uniform control
+ * flow; literal-only expressions are left for folding. Uniform and storage member loads are
+ * computations here, which is what lets hoisting move them out of loops.
+ *
+ * @param expr Expression to check.
+ * @param excludedNames Immutable names that must not be read (declared where the expression is
+ *   moved past), or null.
+ */
+bool IsMovable(const IrExpr& expr, const std::set<RcString>* excludedNames) {
+  const IrExpr::Node& node = expr.node();
+  if (node.kind == IrExpr::Kind::Literal || node.kind == IrExpr::Kind::Ref || IsLocalAccess(expr) ||
+      !IsBindableType(node.type)) {
+    return false;
+  }
+
+  std::vector<IrExpr::RefInfo> refs;
+  expr.collectRefs(refs);
+  if (refs.empty()) {
+    return false;
+  }
+  for (const IrExpr::RefInfo& ref : refs) {
+    if (ref.kind == RefKind::Var || (excludedNames && excludedNames->contains(ref.name))) {
+      return false;
+    }
+  }
+
+  std::vector<BuiltinFn> builtins;
+  expr.collectBuiltinCalls(builtins);
+  return std::ranges::none_of(builtins, [](BuiltinFn fn) {
+    return fn == BuiltinFn::Fwidth || fn == BuiltinFn::TextureSample;
+  });
+}
+
+/// Typed literal constructors, overloaded on the payload type.
+IrExpr MakeLiteral(bool value) {
+  return LiteralBool(value);
+}
+IrExpr MakeLiteral(int32_t value) {
+  return LiteralI32(value);
+}
+IrExpr MakeLiteral(uint32_t value) {
+  return LiteralU32(value);
+}
+IrExpr MakeLiteral(float value) {
+  return LiteralF32(value);
+}
+
+/// Wraps a folded value as a literal, refusing values the emitters cannot spell: non-finite
+/// floats, and the most negative i32 (WGSL has no negative literals, and `-2147483648i` negates
+/// an out-of-range literal).
+template <typename T>
+std::optional<IrExpr> FoldedLiteral(T value) {
+  if constexpr (std::is_same_v<T, float>) {
+    if (!std::isfinite(value)) {
+      return std::nullopt;
+    }
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    if (value == std::numeric_limits<int32_t>::min()) {
+      return std::nullopt;
+    }
+  }
+  return MakeLiteral(value);
+}
+
+/// True if \p node is a numeric literal equal to \p value.
+bool IsLiteralValue(const IrExpr::Node& node, int value) {
+  if (node.kind != IrExpr::Kind::Literal || std::holds_alternative<bool>(node.literal)) {
+    return false;
+  }
+  return std::visit(
+      [value](auto literal) { return literal == static_cast<decltype(literal)>(value); },
+      node.literal);
+}
+
+/// Literal bool payload of \p node, if it is a bool literal.
+std::optional<bool> BoolLiteral(const IrExpr::Node& node) {
+  if (node.kind == IrExpr::Kind::Literal && std::holds_alternative<bool>(node.literal)) {
+    return std::get<bool>(node.literal);
+  }
+  return std::nullopt;
+}
+
+/// Folds `lhs op rhs` over two literals of the same type, with WGSL semantics: integer
+/// arithmetic wraps and integer division by zero (or of the most negative i32 by -1) yields the
+/// dividend.
+template <typename T>
+std::optional<IrExpr> FoldBinaryLiterals(BinaryOp op, T lhs, T rhs) {
+  switch (op) {
+    case BinaryOp::Eq: return LiteralBool(lhs == rhs);
+    case BinaryOp::Ne: return LiteralBool(lhs != rhs);
+    default: break;
+  }
+
+  if constexpr (std::is_same_v<T, bool>) {
+    if (op == BinaryOp::And) {
+      return LiteralBool(lhs && rhs);
+    }
+    if (op == BinaryOp::Or) {
+      return LiteralBool(lhs || rhs);
+    }
+    return std::nullopt;
+  } else {
+    switch (op) {
+      case BinaryOp::Lt: return LiteralBool(lhs < rhs);
+      case BinaryOp::Le: return LiteralBool(lhs <= rhs);
+      case BinaryOp::Gt: return LiteralBool(lhs > rhs);
+      case BinaryOp::Ge: return LiteralBool(lhs >= rhs);
+      default: break;
+    }
+
+    if constexpr (std::is_same_v<T, float>) {
+      switch (op) {
+        case BinaryOp::Add: return FoldedLiteral(lhs + rhs);
+        case BinaryOp::Sub: return FoldedLiteral(lhs - rhs);
+        case BinaryOp::Mul: return FoldedLiteral(lhs * rhs);
+        case BinaryOp::Div: return FoldedLiteral(lhs / rhs);
+        default: return std::nullopt;
+      }
+    } else {
+      const uint32_t a = static_cast<uint32_t>(lhs);
+      const uint32_t b = static_cast<uint32_t>(rhs);
+      switch (op) {
+        case BinaryOp::Add: return FoldedLiteral(static_cast<T>(a + b));
+        case BinaryOp::Sub: return FoldedLiteral(static_cast<T>(a - b));
+        case BinaryOp::Mul: return FoldedLiteral(static_cast<T>(a * b));
+        case BinaryOp::Div:
+          if (rhs == 0 || (std::is_signed_v<T> && lhs == std::numeric_limits<T>::min() &&
+                           rhs == static_cast<T>(-1))) {
+            return FoldedLiteral(lhs);
+          }
+          return FoldedLiteral(static_cast<T>(lhs / rhs));
+        default: return std::nullopt;
+      }
+    }
+  }
+}
+
+/// Converts a literal payload to scalar kind \p to with WGSL semantics: float-to-integer
+/// saturates (NaN becomes 0), i32 and u32 reinterpret, bool becomes 0 or 1.
+template <typename T>
+std::optional<IrExpr> ConvertLiteral(T value, ScalarKind to) {
+  switch (to) {
+    case ScalarKind::Bool: return LiteralBool(value != T(0));
+    case ScalarKind::F32: return FoldedLiteral(static_cast<float>(value));
+    case ScalarKind::I32:
+    case ScalarKind::U32: {
+      uint32_t bits = 0;
+      if constexpr (std::is_same_v<T, float>) {
+        if (std::isnan(value)) {
+          bits = 0;
+        } else if (to == ScalarKind::I32) {
+          bits = value >= 2147483648.0f ? uint32_t(std::numeric_limits<int32_t>::max())
+                 : value <= -2147483648.0f
+                     ? std::bit_cast<uint32_t>(std::numeric_limits<int32_t>::min())
+                     : std::bit_cast<uint32_t>(static_cast<int32_t>(value));
+        } else {
+          bits = value >= 4294967296.0f ? std::numeric_limits<uint32_t>::max()
+                 : value <= 0.0f        ? 0u
+                                        : static_cast<uint32_t>(value);
+        }
+      } else {
+        bits = static_cast<uint32_t>(value);
+      }
+      return to == ScalarKind::I32 ? FoldedLiteral(static_cast<int32_t>(bits))
+                                   : FoldedLiteral(bits);
+    }
+  }
+  return std::nullopt;
+}
+
+/// Folds a builtin call whose arguments are all scalar literals of the same type.
+template <typename T>
+std::optional<IrExpr> FoldBuiltinLiterals(BuiltinFn fn, std::span<const T> args) {
+  switch (fn) {
+    case BuiltinFn::Abs:
+      if constexpr (std::is_same_v<T, uint32_t>) {
+        return FoldedLiteral(args[0]);
+      } else if constexpr (std::is_same_v<T, int32_t>) {
+        // abs of the most negative i32 wraps to itself.
+        return args[0] == std::numeric_limits<int32_t>::min()
+                   ? std::nullopt
+                   : FoldedLiteral(args[0] < 0 ? -args[0] : args[0]);
+      } else {
+        return FoldedLiteral(args[0] < T(0) ? T(-args[0]) : args[0]);
+      }
+    case BuiltinFn::Min: return FoldedLiteral(std::min(args[0], args[1]));
+    case BuiltinFn::Max: return FoldedLiteral(std::max(args[0], args[1]));
+    case BuiltinFn::Clamp: return FoldedLiteral(std::min(std::max(args[0], args[1]), args[2]));
+    default: break;
+  }
+
+  if constexpr (std::is_same_v<T, float>) {
+    switch (fn) {
+      case BuiltinFn::Saturate: return FoldedLiteral(std::clamp(args[0], 0.0f, 1.0f));
+      case BuiltinFn::Fract: return FoldedLiteral(args[0] - std::floor(args[0]));
+      case BuiltinFn::Sqrt:
+        return args[0] >= 0.0f ? FoldedLiteral(std::sqrt(args[0])) : std::nullopt;
+      case BuiltinFn::Round: return FoldedLiteral(std::nearbyint(args[0]));
+      case BuiltinFn::Length: return FoldedLiteral(std::fabs(args[0]));
+      default: break;
+    }
+  }
+  return std::nullopt;
+}
+
+/// Index of swizzle component \p component (`x`, `y`, `z`, or `w`).
+uint32_t SwizzleIndex(char component) {
+  switch (component) {
+    case 'y': return 1;
+    case 'z': return 2;
+    case 'w': return 3;
+    default: return 0;
+  }
+}
+
+/// Component \p index of vector constructor \p construct, if the constructor spells it as a
+/// single scalar operand (a splat, or one scalar per component).
+std::optional<IrExpr> ConstructComponent(const IrExpr::Node& construct, uint32_t index) {
+  if (construct.kind != IrExpr::Kind::Construct || !construct.type.isVector() ||
+      index >= construct.type.vectorSize()) {
+    return std::nullopt;
+  }
+  const std::vector<IrExpr>& args = construct.children;
+  if (!std::ranges::all_of(args, [](const IrExpr& arg) { return arg.type().isScalar(); })) {
+    return std::nullopt;
+  }
+  if (args.size() == 1) {
+    return args[0];
+  }
+  if (args.size() == construct.type.vectorSize()) {
+    return args[index];
+  }
+  return std::nullopt;
+}
+
+/// True if \p fn is the implicit-derivative builtin set that makes a function fragment-only.
+bool IsFragmentOnlyBuiltin(BuiltinFn fn) {
+  return fn == BuiltinFn::Fwidth || fn == BuiltinFn::TextureSample;
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, IrPass value) {
+  switch (value) {
+    case IrPass::SpecializeUniforms: return os << "specialize_uniforms";
+    case IrPass::FoldConstants: return os << "fold_constants";
+    case IrPass::EliminateDeadCode: return os << "eliminate_dead_code";
+    case IrPass::HoistLoopInvariants: return os << "hoist_loop_invariants";
+    case IrPass::EliminateCommonSubexpressions: return os << "eliminate_common_subexpressions";
+  }
+  return os << "unknown";
+}
+
+std::vector<IrPass> DefaultIrPasses() {
+  return {IrPass::SpecializeUniforms,  IrPass::FoldConstants,
+          IrPass::EliminateDeadCode,   IrPass::HoistLoopInvariants,
+          IrPass::EliminateCommonSubexpressions, IrPass::FoldConstants,
+          IrPass::EliminateDeadCode};
+}
+
+/// Runs passes over a mutable copy of a module's contents; \ref IrModule befriends it to build
+/// the result.
+class IrOptimizer {
+public:
+  /**
+   * Copies the contents of \p module.
+   *
+   * @param module Module to optimize.
+   * @param statistics Receives the rewrite counts.
+   */
+  IrOptimizer(const IrModule& module, IrPassStatistics& statistics)
+      : constants_(module.constants()),
+        bindings_(module.bindings()),
+        functions_(module.functions()),
+        statistics_(statistics) {
+    for (const IrConstant& constant : constants_) {
+      usedNames_.insert(constant.name);
+    }
+    for (const IrBinding& binding : bindings_) {
+      usedNames_.insert(binding.name);
+    }
+    for (const IrFunction& function : functions_) {
+      usedNames_.insert(function.name);
+      for (const IrParam& param : function.params) {
+        usedNames_.insert(param.name);
+      }
+      VisitDeclaredNames(function.body, [this](const RcString& name) { usedNames_.insert(name); });
+    }
+  }
+
+  /// Runs \ref IrPass::SpecializeUniforms. @param uniforms Members to specialize.
+  ShaderStatus specializeUniforms(std::span<const UniformSpecialization> uniforms);
+
+  /// Runs \ref IrPass::FoldConstants.
+  void foldConstants();
+
+  /// Runs \ref IrPass::EliminateDeadCode.
+  void eliminateDeadCode();
+
+  /// Runs \ref IrPass::HoistLoopInvariants.
+  void hoistLoopInvariants();
+
+  /// Runs \ref IrPass::EliminateCommonSubexpressions.
+  void eliminateCommonSubexpressions();
+
+  /// Recomputes per-function derived flags and returns the optimized module.
+  IrModule finish();
+
+private:
+  /// Per-function folding state.
+  struct FoldState {
+    std::map<RcString, IrExpr> bindings;        //!< Let/var names to propagate, in scope.
+    std::set<RcString> assignedVars;            //!< Vars assigned anywhere in the function.
+    std::map<RcString, int> declarationCounts;  //!< Declarations per name in the function.
+  };
+
+  IrBlock foldBlock(const IrBlock& block, FoldState& state);
+  void foldStatement(const IrStmt& statement, FoldState& state, IrBlock& out,
+                     std::vector<RcString>& scopedNames);
+  IrExpr foldExpr(const IrExpr& expr, const FoldState& state);
+  std::optional<IrExpr> simplify(const IrExpr& expr, const FoldState& state) const;
+
+  IrBlock eliminateInBlock(const IrBlock& block, const std::map<RcString, uint32_t>& reads,
+                           uint32_t& removed) const;
+  void eliminateUnusedDeclarations();
+
+  IrBlock hoistInBlock(const IrBlock& block);
+  IrBlock cseBlock(IrBlock block, std::set<RcString>& visibleNames);
+
+  /// Returns a new name with \p prefix that the module does not use yet.
+  RcString freshName(std::string_view prefix) {
+    for (;;) {
+      RcString name = RcString::fromFormat("{}{}", prefix, nameSuffixes_[std::string(prefix)]++);
+      if (usedNames_.insert(name).second) {
+        return name;
+      }
+    }
+  }
+
+  std::vector<IrConstant> constants_;
+  std::vector<IrBinding> bindings_;
+  std::vector<IrFunction> functions_;
+  IrPassStatistics& statistics_;
+
+  std::set<RcString> usedNames_;                   //!< Every module-level and local name.
+  std::map<std::string, uint32_t> nameSuffixes_;   //!< Next \ref freshName suffix per prefix.
+  std::map<RcString, IrExpr> constantFunctions_;  //!< Plain functions returning a literal.
+};
+
+ShaderStatus IrOptimizer::specializeUniforms(std::span<const UniformSpecialization> uniforms) {
+  std::map<std::pair<RcString, RcString>, IrExpr> values;
+  for (const UniformSpecialization& uniform : uniforms) {
+    const auto binding = std::ranges::find_if(bindings_, [&](const IrBinding& candidate) {
+      return candidate.name == uniform.binding;
+    });
+    if (binding == bindings_.end() || binding->kind != BindingKind::UniformBuffer) {
+      return Err(std::format("{} is not a uniform buffer binding", uniform.binding.str()));
+    }
+
+    const std::span<const IrType::Member> members = binding->type.structMembers();
+    const auto member = std::ranges::find_if(
+        members, [&](const IrType::Member& candidate) { return candidate.name == uniform.member; });
+    if (member == members.end()) {
+      return Err(std::format("uniform {} has no member {}", uniform.binding.str(),
+                             uniform.member.str()));
+    }
+    if (uniform.value.kind() != IrExpr::Kind::Literal || !(uniform.value.type() == member->type)) {
+      return Err(std::format("specialization of {}.{} must be a {} literal, got {}",
+                             uniform.binding.str(), uniform.member.str(),
+                             member->type.toString(), uniform.value.toString()));
+    }
+    values.insert_or_assign(std::make_pair(uniform.binding, uniform.member), uniform.value);
+  }
+  if (values.empty()) {
+    return OkShaderStatus();
+  }
+
+  ExprFn specialize = [&](const IrExpr& expr) -> IrExpr {
+    const IrExpr::Node& node = expr.node();
+    if (node.kind == IrExpr::Kind::Member) {
+      const IrExpr::Node& base = node.children[0].node();
+      if (base.kind == IrExpr::Kind::Ref && base.refKind == RefKind::Resource) {
+        if (const auto it = values.find(std::make_pair(base.name, node.name));
+            it != values.end()) {
+          ++statistics_.specializedLoads;
+          return it->second;
+        }
+      }
+    }
+    return MapChildren(expr, specialize);
+  };
+  for (IrFunction& function : functions_) {
+    function.body = MapBlockExprs(function.body, specialize);
+  }
+  return OkShaderStatus();
+}
+
+void IrOptimizer::foldConstants() {
+  for (int round = 0; round < kMaxFoldRounds; ++round) {
+    const uint32_t foldedBefore = statistics_.foldedExprs;
+
+    constantFunctions_.clear();
+    for (const IrFunction& function : functions_) {
+      if (function.stage == StageKind::None && function.body.size() == 1 &&
+          function.body[0].kind() == IrStmt::Kind::Return &&
+          function.body[0].data().exprs.size() == 1 &&
+          function.body[0].data().exprs[0].kind() == IrExpr::Kind::Literal) {
+        constantFunctions_.emplace(function.name, function.body[0].data().exprs[0]);
+      }
+    }
+
+    for (IrFunction& function : functions_) {
+      FoldState state;
+      VisitDeclaredNames(function.body,
+                         [&](const RcString& name) { ++state.declarationCounts[name]; });
+      std::function<void(const IrStmt&)> collectAssigned = [&](const IrStmt& statement) {
+        const IrStmt::Data& data = statement.data();
+        if (data.kind == IrStmt::Kind::Assign) {
+          state.assignedVars.insert(LvalueRoot(data.exprs[0]));
+        }
+        if (data.continuing) {
+          collectAssigned(*data.continuing);
+        }
+        for (const IrStmt& nested : data.body) {
+          collectAssigned(nested);
+        }
+        for (const IrStmt& nested : data.elseBody) {
+          collectAssigned(nested);
+        }
+      };
+      for (const IrStmt& statement : function.body) {
+        collectAssigned(statement);
+      }
+      function.body = foldBlock(function.body, state);
+    }
+
+    if (statistics_.foldedExprs == foldedBefore) {
+      break;
+    }
+  }
+}
+
+IrBlock IrOptimizer::foldBlock(const IrBlock& block, FoldState& state) {
+  IrBlock out;
+  out.reserve(block.size());
+  std::vector<RcString> scopedNames;
+  for (const IrStmt& statement : block) {
+    foldStatement(statement, state, out, scopedNames);
+  }
+  for (const RcString& name : scopedNames) {
+    state.bindings.erase(name);
+  }
+  return out;
+}
+
+void IrOptimizer::foldStatement(const IrStmt& statement, FoldState& state, IrBlock& out,
+                                std::vector<RcString>& scopedNames) {
+  IrStmt::Data data = statement.data();
+  const ExprFn fold = [&](const IrExpr& expr) { return foldExpr(expr, state); };
+
+  switch (data.kind) {
+    case IrStmt::Kind::Let: {
+      data.exprs[0] = fold(data.exprs[0]);
+      const IrExpr::Node& value = data.exprs[0].node();
+      if (value.kind == IrExpr::Kind::Literal ||
+          (value.kind == IrExpr::Kind::Ref &&
+           (value.refKind == RefKind::Param || value.refKind == RefKind::Let))) {
+        state.bindings.insert_or_assign(data.name, data.exprs[0]);
+        scopedNames.push_back(data.name);
+      }
+      break;
+    }
+    case IrStmt::Kind::Var:
+      if (!data.exprs.empty()) {
+        data.exprs[0] = fold(data.exprs[0]);
+        if (data.exprs[0].kind() == IrExpr::Kind::Literal &&
+            !state.assignedVars.contains(data.name)) {
+          state.bindings.insert_or_assign(data.name, data.exprs[0]);
+          scopedNames.push_back(data.name);
+        }
+      }
+      break;
+    case IrStmt::Kind::Assign:
+      data.exprs[0] = MapLvalue(data.exprs[0], fold);
+      data.exprs[1] = fold(data.exprs[1]);
+      // `x = x`, left behind when an identity folds away.
+      if (data.exprs[1].kind() == IrExpr::Kind::Ref && data.exprs[0].kind() == IrExpr::Kind::Ref &&
+          data.exprs[1].node().name == data.exprs[0].node().name) {
+        ++statistics_.foldedExprs;
+        return;
+      }
+      break;
+    case IrStmt::Kind::If: {
+      data.exprs[0] = fold(data.exprs[0]);
+      data.body = foldBlock(data.body, state);
+      data.elseBody = foldBlock(data.elseBody, state);
+
+      const std::optional<bool> condition = BoolLiteral(data.exprs[0].node());
+      if (!condition) {
+        break;
+      }
+
+      IrBlock& taken = *condition ? data.body : data.elseBody;
+      IrBlock& skipped = *condition ? data.elseBody : data.body;
+      // Splicing moves the taken branch's declarations into this block, which is only valid if
+      // no other scope in the function reuses their names.
+      const bool canSplice = std::ranges::all_of(taken, [&](const IrStmt& nested) {
+        return (nested.kind() != IrStmt::Kind::Let && nested.kind() != IrStmt::Kind::Var) ||
+               state.declarationCounts[nested.data().name] == 1;
+      });
+      if (canSplice) {
+        ++statistics_.foldedExprs;
+        for (IrStmt& nested : taken) {
+          out.push_back(std::move(nested));
+        }
+        return;
+      }
+      if (!skipped.empty()) {
+        ++statistics_.foldedExprs;
+        skipped.clear();
+      }
+      break;
+    }
+    case IrStmt::Kind::For: {
+      IrStmt::Data init = data.init->data();
+      init.exprs[0] = fold(init.exprs[0]);
+      data.init = std::make_shared<const IrStmt>(std::move(init));
+      if (!data.exprs.empty()) {
+        data.exprs[0] = fold(data.exprs[0]);
+        if (BoolLiteral(data.exprs[0].node()) == false) {
+          ++statistics_.foldedExprs;
+          return;
+        }
+      }
+      if (data.continuing) {
+        data.continuing = std::make_shared<const IrStmt>(MapStatementExprs(*data.continuing, fold));
+      }
+      data.body = foldBlock(data.body, state);
+      break;
+    }
+    case IrStmt::Kind::Return:
+      for (IrExpr& expr : data.exprs) {
+        expr = fold(expr);
+      }
+      break;
+    case IrStmt::Kind::Break:
+    case IrStmt::Kind::Continue:
+    case IrStmt::Kind::Discard: break;
+  }
+
+  out.push_back(IrStmt(std::move(data)));
+}
+
+IrExpr IrOptimizer::foldExpr(const IrExpr& expr, const FoldState& state) {
+  IrExpr folded =
+      MapChildren(expr, [&](const IrExpr& child) { return foldExpr(child, state); });
+  while (std::optional<IrExpr> simplified = simplify(folded, state)) {
+    ++statistics_.foldedExprs;
+    folded = std::move(*simplified);
+  }
+  return folded;
+}
+
+std::optional<IrExpr> IrOptimizer::simplify(const IrExpr& expr, const FoldState& state) const {
+  const IrExpr::Node& node = expr.node();
+  const auto child = [&](size_t i) -> const IrExpr::Node& { return node.children[i].node(); };
+  const auto isLiteral = [&](size_t i) { return child(i).kind == IrExpr::Kind::Literal; };
+
+  switch (node.kind) {
+    case IrExpr::Kind::Literal: return std::nullopt;
+
+    case IrExpr::Kind::Ref:
+      if (node.refKind == RefKind::Constant) {
+        for (const IrConstant& constant : constants_) {
+          if (constant.name == node.name) {
+            return constant.value;
+          }
+        }
+      } else if (node.refKind == RefKind::Let || node.refKind == RefKind::Var) {
+        if (const auto it = state.bindings.find(node.name); it != state.bindings.end()) {
+          return it->second;
+        }
+      }
+      return std::nullopt;
+
+    case IrExpr::Kind::Unary:
+      if (isLiteral(0)) {
+        return std::visit(
+            [&](auto value) -> std::optional<IrExpr> {
+              using T = decltype(value);
+              if constexpr (std::is_same_v<T, bool>) {
+                return LiteralBool(!value);
+              } else if constexpr (std::is_same_v<T, uint32_t>) {
+                return std::nullopt;
+              } else if constexpr (std::is_same_v<T, int32_t>) {
+                return value == std::numeric_limits<int32_t>::min() ? std::nullopt
+                                                                    : FoldedLiteral(-value);
+              } else {
+                return FoldedLiteral(static_cast<T>(-value));
+              }
+            },
+            child(0).literal);
+      }
+      // --x and !!x.
+      if (child(0).kind == IrExpr::Kind::Unary && child(0).unaryOp == node.unaryOp) {
+        return child(0).children[0];
+      }
+      return std::nullopt;
+
+    case IrExpr::Kind::Binary: {
+      if (isLiteral(0) && isLiteral(1) && child(0).literal.index() == child(1).literal.index()) {
+        return std::visit(
+            [&](auto lhs) -> std::optional<IrExpr> {
+              using T = decltype(lhs);
+              return FoldBinaryLiterals<T>(node.binaryOp, lhs, std::get<T>(child(1).literal));
+            },
+            child(0).literal);
+      }
+
+      // Identities. `x + 0` is exact up to the sign of zero, which WGSL does not preserve.
+      const auto keeps = [&](size_t i) { return node.children[i].type() == node.type; };
+      switch (node.binaryOp) {
+        case BinaryOp::Add:
+          if (IsLiteralValue(child(1), 0) && keeps(0)) {
+            return node.children[0];
+          }
+          if (IsLiteralValue(child(0), 0) && keeps(1)) {
+            return node.children[1];
+          }
+          break;
+        case BinaryOp::Sub:
+          if (IsLiteralValue(child(1), 0) && keeps(0)) {
+            return node.children[0];
+          }
+          break;
+        case BinaryOp::Mul:
+          if (IsLiteralValue(child(1), 1) && keeps(0)) {
+            return node.children[0];
+          }
+          if (IsLiteralValue(child(0), 1) && keeps(1)) {
+            return node.children[1];
+          }
+          break;
+        case BinaryOp::Div:
+          if (IsLiteralValue(child(1), 1) && keeps(0)) {
+            return node.children[0];
+          }
+          break;
+        case BinaryOp::And:
+        case BinaryOp::Or:
+          // Operands are pure, so short-circuiting a literal side is exact.
+          for (size_t i = 0; i < 2; ++i) {
+            if (const std::optional<bool> value = BoolLiteral(child(i))) {
+              const bool absorbing = node.binaryOp == BinaryOp::Or;
+              return *value == absorbing ? node.children[i] : node.children[1 - i];
+            }
+          }
+          break;
+        default: break;
+      }
+      return std::nullopt;
+    }
+
+    case IrExpr::Kind::Convert:
+      if (isLiteral(0) && node.type.isScalar()) {
+        return std::visit([&](auto value) { return ConvertLiteral(value, node.type.scalarKind()); },
+                          child(0).literal);
+      }
+      return std::nullopt;
+
+    case IrExpr::Kind::CallBuiltin: {
+      if (node.builtin == BuiltinFn::Select) {
+        if (const std::optional<bool> condition = BoolLiteral(child(2))) {
+          return node.children[*condition ? 1 : 0];
+        }
+        return std::nullopt;
+      }
+
+      if (node.children.empty() || !std::ranges::all_of(node.children, [&](const IrExpr& arg) {
+            return arg.kind() == IrExpr::Kind::Literal &&
+                   arg.node().literal.index() == child(0).literal.index();
+          })) {
+        return std::nullopt;
+      }
+      return std::visit(
+          [&](auto first) -> std::optional<IrExpr> {
+            using T = decltype(first);
+            if constexpr (std::is_same_v<T, bool>) {
+              return std::nullopt;
+            } else {
+              std::vector<T> args;
+              for (const IrExpr& arg : node.children) {
+                args.push_back(std::get<T>(arg.node().literal));
+              }
+              return FoldBuiltinLiterals<T>(node.builtin, args);
+            }
+          },
+          child(0).literal);
+    }
+
+    case IrExpr::Kind::Swizzle: {
+      const IrExpr::Node& base = child(0);
+      // An identity swizzle (`v.xy` of a vec2) is the vector itself.
+      if (base.type == node.type && std::string_view("xyzw").starts_with(node.swizzle)) {
+        return node.children[0];
+      }
+      if (base.kind == IrExpr::Kind::Swizzle) {
+        auto composed = std::make_shared<IrExpr::Node>(node);
+        composed->swizzle.clear();
+        for (const char component : node.swizzle) {
+          composed->swizzle += base.swizzle[SwizzleIndex(component)];
+        }
+        composed->children = {base.children[0]};
+        return IrExpr(std::move(composed));
+      }
+      if (node.swizzle.size() == 1) {
+        return ConstructComponent(base, SwizzleIndex(node.swizzle[0]));
+      }
+      return std::nullopt;
+    }
+
+    case IrExpr::Kind::Index:
+      if (isLiteral(1) && !std::holds_alternative<bool>(child(1).literal)) {
+        return ConstructComponent(child(0), LiteralBits(child(1)));
+      }
+      return std::nullopt;
+
+    case IrExpr::Kind::CallUser:
+      if (const auto it = constantFunctions_.find(node.name); it != constantFunctions_.end()) {
+        return it->second;
+      }
+      return std::nullopt;
+
+    case IrExpr::Kind::Member:
+    case IrExpr::Kind::Construct: return std::nullopt;
+  }
+  return std::nullopt;
+}
+
+void IrOptimizer::eliminateDeadCode() {
+  for (IrFunction& function : functions_) {
+    for (int round = 0; round < kMaxDeadCodeRounds; ++round) {
+      std::map<RcString, uint32_t> reads;
+      for (const IrStmt& statement : function.body) {
+        VisitStatementExprs(statement, [&](const IrExpr& expr) {
+          std::vector<IrExpr::RefInfo> refs;
+          expr.collectRefs(refs);
+          for (const IrExpr::RefInfo& ref : refs) {
+            ++reads[ref.name];
+          }
+        });
+      }
+
+      uint32_t removed = 0;
+      function.body = eliminateInBlock(function.body, reads, removed);
+      statistics_.removedStatements += removed;
+      if (removed == 0) {
+        break;
+      }
+    }
+  }
+
+  eliminateUnusedDeclarations();
+}
+
+IrBlock IrOptimizer::eliminateInBlock(const IrBlock& block,
+                                      const std::map<RcString, uint32_t>& reads,
+                                      uint32_t& removed) const {
+  const auto isRead = [&](const RcString& name) { return reads.contains(name); };
+
+  IrBlock out;
+  out.reserve(block.size());
+  for (size_t i = 0; i < block.size(); ++i) {
+    IrStmt::Data data = block[i].data();
+    switch (data.kind) {
+      case IrStmt::Kind::Let:
+      case IrStmt::Kind::Var:
+        if (!isRead(data.name)) {
+          ++removed;
+          continue;
+        }
+        break;
+      case IrStmt::Kind::Assign:
+        if (!isRead(LvalueRoot(data.exprs[0]))) {
+          ++removed;
+          continue;
+        }
+        break;
+      case IrStmt::Kind::If:
+        data.body = eliminateInBlock(data.body, reads, removed);
+        data.elseBody = eliminateInBlock(data.elseBody, reads, removed);
+        if (data.body.empty() && data.elseBody.empty()) {
+          ++removed;
+          continue;
+        }
+        break;
+      case IrStmt::Kind::For:
+        // The loop variable is scoped to the loop, so an empty body leaves nothing observable.
+        data.body = eliminateInBlock(data.body, reads, removed);
+        if (data.body.empty()) {
+          ++removed;
+          continue;
+        }
+        break;
+      case IrStmt::Kind::Return:
+      case IrStmt::Kind::Break:
+      case IrStmt::Kind::Continue:
+        // Unreachable tail. `discard` is not a terminator: WGSL demotes the invocation to a
+        // helper, which keeps executing for derivatives.
+        removed += static_cast<uint32_t>(block.size() - i - 1);
+        out.push_back(IrStmt(std::move(data)));
+        return out;
+      case IrStmt::Kind::Discard: break;
+    }
+    out.push_back(IrStmt(std::move(data)));
+  }
+  return out;
+}
+
+void IrOptimizer::eliminateUnusedDeclarations() {
+  // A module without entry points is a library under construction; keep it whole.
+  if (std::ranges::none_of(functions_, [](const IrFunction& function) {
+        return function.stage != StageKind::None;
+      })) {
+    return;
+  }
+
+  std::set<RcString> liveFunctions;
+  std::set<RcString> liveConstants;
+  std::vector<const IrFunction*> worklist;
+  for (const IrFunction& function : functions_) {
+    if (function.stage != StageKind::None) {
+      liveFunctions.insert(function.name);
+      worklist.push_back(&function);
+    }
+  }
+  while (!worklist.empty()) {
+    const IrFunction* function = worklist.back();
+    worklist.pop_back();
+    for (const IrStmt& statement : function->body) {
+      VisitStatementExprs(statement, [&](const IrExpr& expr) {
+        std::vector<IrExpr::RefInfo> refs;
+        expr.collectRefs(refs);
+        for (const IrExpr::RefInfo& ref : refs) {
+          if (ref.kind == RefKind::Constant) {
+            liveConstants.insert(ref.name);
+          }
+        }
+
+        std::vector<RcString> callees;
+        expr.collectUserCalls(callees);
+        for (const RcString& callee : callees) {
+          if (liveFunctions.insert(callee).second) {
+            for (const IrFunction& candidate : functions_) {
+              if (candidate.name == callee) {
+                worklist.push_back(&candidate);
+              }
+            }
+          }
+        }
+      });
+    }
+  }
+
+  statistics_.removedFunctions += static_cast<uint32_t>(std::erase_if(
+      functions_,
+      [&](const IrFunction& function) { return !liveFunctions.contains(function.name); }));
+  statistics_.removedConstants += static_cast<uint32_t>(std::erase_if(
+      constants_,
+      [&](const IrConstant& constant) { return !liveConstants.contains(constant.name); }));
+}
+
+void IrOptimizer::hoistLoopInvariants() {
+  for (IrFunction& function : functions_) {
+    function.body = hoistInBlock(function.body);
+  }
+}
+
+IrBlock IrOptimizer::hoistInBlock(const IrBlock& block) {
+  IrBlock out;
+  out.reserve(block.size());
+  for (const IrStmt& statement : block) {
+    IrStmt::Data data = statement.data();
+    if (data.kind == IrStmt::Kind::If) {
+      data.body = hoistInBlock(data.body);
+      data.elseBody = hoistInBlock(data.elseBody);
+      out.push_back(IrStmt(std::move(data)));
+      continue;
+    }
+    if (data.kind != IrStmt::Kind::For) {
+      out.push_back(statement);
+      continue;
+    }
+
+    // Names declared by the loop itself vary per iteration (or are out of scope before it).
+    std::set<RcString> loopNames = {data.init->data().name};
+    VisitDeclaredNames(data.body, [&](const RcString& name) { loopNames.insert(name); });
+
+    // Collect the outermost invariant subexpressions of everything evaluated per iteration:
+    // the condition, the continuing statement, and the body.
+    std::vector<IrExpr> invariants;
+    std::map<std::string, IrExpr> replacements;
+    std::function<void(const IrExpr&)> collect = [&](const IrExpr& expr) {
+      if (IsMovable(expr, &loopNames)) {
+        std::string key = ExprKey(expr);
+        if (!replacements.contains(key)) {
+          invariants.push_back(expr);
+          replacements.emplace(std::move(key), expr);
+        }
+        return;
+      }
+      for (const IrExpr& child : expr.node().children) {
+        collect(child);
+      }
+    };
+    for (const IrExpr& condition : data.exprs) {
+      collect(condition);
+    }
+    if (data.continuing) {
+      VisitStatementExprs(*data.continuing, collect);
+    }
+    for (const IrStmt& nested : data.body) {
+      VisitStatementExprs(nested, collect);
+    }
+
+    for (const IrExpr& invariant : invariants) {
+      const RcString name = freshName("hoist");
+      IrExpr& replacement = replacements.at(ExprKey(invariant));
+      replacement = MakeRef(RefKind::Let, name, invariant.type());
+      out.push_back(MakeLet(name, invariant));
+      ++statistics_.hoistedExprs;
+    }
+    if (!invariants.empty()) {
+      const ExprFn replace = [&](const IrExpr& expr) { return ReplaceByKey(expr, replacements); };
+      for (IrExpr& condition : data.exprs) {
+        condition = replace(condition);
+      }
+      if (data.continuing) {
+        data.continuing =
+            std::make_shared<const IrStmt>(MapStatementExprs(*data.continuing, replace));
+      }
+      data.body = MapBlockExprs(data.body, replace);
+    }
+
+    // Inner loops hoist into this loop's body.
+    data.body = hoistInBlock(data.body);
+    out.push_back(IrStmt(std::move(data)));
+  }
+  return out;
+}
+
+void IrOptimizer::eliminateCommonSubexpressions() {
+  for (IrFunction& function : functions_) {
+    std::set<RcString> visibleNames;
+    for (const IrParam& param : function.params) {
+      visibleNames.insert(param.name);
+    }
+    function.body = cseBlock(std::move(function.body), visibleNames);
+  }
+}
+
+IrBlock IrOptimizer::cseBlock(IrBlock block, std::set<RcString>& visibleNames) {
+  // Bind the largest repeated subexpression of this block (counting nested blocks) to a let
+  // before its first use, then repeat. Occurrences in nested blocks count, so an expression
+  // repeated across branches or loop iterations is computed once up front; expressions reading
+  // names declared in nested blocks are left for the nested block's own pass.
+  for (;;) {
+    struct Occurrences {
+      IrExpr expr;
+      uint32_t count = 0;
+      size_t firstStatement = 0;
+      uint32_t size = 0;
+    };
+    std::map<std::string, Occurrences> occurrences;
+    for (size_t i = 0; i < block.size(); ++i) {
+      std::function<void(const IrExpr&)> gather = [&](const IrExpr& expr) {
+        if (IsMovable(expr, nullptr)) {
+          auto [it, inserted] = occurrences.try_emplace(ExprKey(expr), Occurrences{expr});
+          if (inserted) {
+            it->second.firstStatement = i;
+            it->second.size = ExprSize(expr);
+          }
+          ++it->second.count;
+        }
+        for (const IrExpr& child : expr.node().children) {
+          gather(child);
+        }
+      };
+      VisitStatementExprs(block[i], gather);
+    }
+
+    const auto inScope = [&](const Occurrences& candidate) {
+      std::vector<IrExpr::RefInfo> refs;
+      candidate.expr.collectRefs(refs);
+      return std::ranges::all_of(refs, [&](const IrExpr::RefInfo& ref) {
+        if (ref.kind != RefKind::Let && ref.kind != RefKind::Param) {
+          return true;
+        }
+        if (visibleNames.contains(ref.name)) {
+          return true;
+        }
+        for (size_t i = 0; i < candidate.firstStatement; ++i) {
+          if (block[i].kind() == IrStmt::Kind::Let && block[i].data().name == ref.name) {
+            return true;
+          }
+        }
+        return false;
+      });
+    };
+
+    const Occurrences* best = nullptr;
+    std::string bestKey;
+    for (const auto& [key, candidate] : occurrences) {
+      if (candidate.count < 2 || !inScope(candidate)) {
+        continue;
+      }
+      if (!best || candidate.size > best->size ||
+          (candidate.size == best->size && candidate.firstStatement < best->firstStatement)) {
+        best = &candidate;
+        bestKey = key;
+      }
+    }
+    if (!best) {
+      break;
+    }
+
+    const RcString name = freshName("cse");
+    const std::map<std::string, IrExpr> replacements = {
+        {bestKey, MakeRef(RefKind::Let, name, best->expr.type())}};
+    const ExprFn replace = [&](const IrExpr& expr) { return ReplaceByKey(expr, replacements); };
+    const size_t first = best->firstStatement;
+    const IrStmt let = MakeLet(name, best->expr);
+    for (size_t i = first; i < block.size(); ++i) {
+      block[i] = MapStatementExprs(block[i], replace);
+    }
+    block.insert(block.begin() + static_cast<std::ptrdiff_t>(first), let);
+    ++statistics_.eliminatedExprs;
+  }
+
+  std::vector<RcString> declaredHere;
+  for (IrStmt& statement : block) {
+    IrStmt::Data data = statement.data();
+    if (data.kind == IrStmt::Kind::If) {
+      data.body = cseBlock(std::move(data.body), visibleNames);
+      data.elseBody = cseBlock(std::move(data.elseBody), visibleNames);
+      statement = IrStmt(std::move(data));
+    } else if (data.kind == IrStmt::Kind::For) {
+      visibleNames.insert(data.init->data().name);
+      data.body = cseBlock(std::move(data.body), visibleNames);
+      visibleNames.erase(data.init->data().name);
+      statement = IrStmt(std::move(data));
+    } else if (data.kind == IrStmt::Kind::Let || data.kind == IrStmt::Kind::Var) {
+      visibleNames.insert(data.name);
+      declaredHere.push_back(data.name);
+    }
+  }
+  for (const RcString& name : declaredHere) {
+    visibleNames.erase(name);
+  }
+  return block;
+}
+
+IrModule IrOptimizer::finish() {
+  // Callees are always declared before their callers, so one in-order sweep sees every callee's
+  // updated flag.
+  std::map<RcString, bool> fragmentOnly;
+  for (IrFunction& function : functions_) {
+    bool uses = false;
+    for (const IrStmt& statement : function.body) {
+      VisitStatementExprs(statement, [&](const IrExpr& expr) {
+        std::vector<BuiltinFn> builtins;
+        expr.collectBuiltinCalls(builtins);
+        std::vector<RcString> callees;
+        expr.collectUserCalls(callees);
+        uses = uses || std::ranges::any_of(builtins, IsFragmentOnlyBuiltin) ||
+               std::ranges::any_of(callees, [&](const RcString& callee) {
+                 return fragmentOnly[callee];
+               });
+      });
+    }
+    function.usesFragmentOnlyBuiltins = uses;
+    fragmentOnly[function.name] = uses;
+  }
+
+  IrModule module;
+  module.constants_ = std::move(constants_);
+  module.bindings_ = std::move(bindings_);
+  module.functions_ = std::move(functions_);
+  return module;
+}
+
+ShaderResult<IrModule> OptimizeModule(const IrModule& module, const IrPassOptions& options,
+                                      IrPassStatistics* statistics) {
+  IrPassStatistics localStatistics;
+  IrOptimizer optimizer(module, statistics ? *statistics : localStatistics);
+  for (const IrPass pass : options.passes) {
+    switch (pass) {
+      case IrPass::SpecializeUniforms:
+        if (ShaderStatus status = optimizer.specializeUniforms(options.uniforms);
+            status.hasError()) {
+          return std::move(status).error();
+        }
+        break;
+      case IrPass::FoldConstants: optimizer.foldConstants(); break;
+      case IrPass::EliminateDeadCode: optimizer.eliminateDeadCode(); break;
+      case IrPass::HoistLoopInvariants: optimizer.hoistLoopInvariants(); break;
+      case IrPass::EliminateCommonSubexpressions: optimizer.eliminateCommonSubexpressions(); break;
+    }
+  }
+  return optimizer.finish();
+}
+
+}  // namespace donner::gpu::shader
@@ -0,0 +1,91 @@
+#pragma once
+/// @file
+/// Optimization passes over \ref donner::gpu::shader::IrModule.
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "donner/base/RcString.h"
+#include "donner/gpu/shader/IrExpr.h"
+#include "donner/gpu/shader/IrModule.h"
+#include "donner/gpu/shader/ShaderResult.h"
+
+namespace donner::gpu::shader {
+
+/// One optimization pass of \ref OptimizeModule.
+enum class IrPass : uint8_t {
+  /// Replaces loads of specialized uniform members (\ref IrPassOptions::uniforms) with literals.
+  SpecializeUniforms,
+  /// Folds literal operands, algebraic identities, constant refs, lets bound to literals or
+  /// immutable names, never-assigned vars with literal initializers, calls to functions that
+  /// return a literal, and `if`/`for` statements with a literal condition.
+  FoldConstants,
+  /// Removes unread lets and vars, statements after `return`/`break`/`continue`, empty `if`s,
+  /// and module constants and plain functions that nothing references.
+  EliminateDeadCode,
+  /// Moves loop-invariant subexpressions (including uniform and storage loads) out of `for`
+  /// loops into lets declared before the loop.
+  HoistLoopInvariants,
+  /// Binds repeated subexpressions to a let and reuses it.
+  EliminateCommonSubexpressions,
+};
+
+/// Ostream output operator, e.g. `fold_constants`. @param os Output stream. @param value Value to
+/// output.
+std::ostream& operator<<(std::ostream& os, IrPass value);
+
+/// The default pass pipeline: specialize, fold, eliminate dead code, hoist, CSE, then fold and
+/// eliminate dead code again to propagate and drop the lets that hoisting and CSE made redundant.
+std::vector<IrPass> DefaultIrPasses();
+
+/// Pins one top-level member of a uniform buffer binding to a known value, producing a
+/// constant-uniform variant of the module.
+struct UniformSpecialization {
+  RcString binding;  //!< Name of a \ref BindingKind::UniformBuffer binding.
+  RcString member;   //!< Top-level member of the binding's struct type.
+  IrExpr value;      //!< Scalar literal of the member's type.
+};
+
+/// Options for \ref OptimizeModule.
+struct IrPassOptions {
+  /// Passes to run, in order; a pass may appear more than once.
+  std::vector<IrPass> passes = DefaultIrPasses();
+
+  /// Uniform members to specialize in \ref IrPass::SpecializeUniforms.
+  std::vector<UniformSpecialization> uniforms;
+};
+
+/// Rewrite counts reported by \ref OptimizeModule, summed over all passes.
+struct IrPassStatistics {
+  uint32_t specializedLoads = 0;   //!< Uniform member loads replaced by literals.
+  uint32_t foldedExprs = 0;        //!< Expressions and statements simplified by folding.
+  uint32_t removedStatements = 0;  //!< Statements removed as dead.
+  uint32_t removedFunctions = 0;   //!< Unreferenced plain functions removed.
+  uint32_t removedConstants = 0;   //!< Unreferenced module constants removed.
+  uint32_t hoistedExprs = 0;       //!< Loop-invariant expressions moved out of loops.
+  uint32_t eliminatedExprs = 0;    //!< Repeated subexpressions bound to a shared let.
+};
+
+/**
+ * Runs the optimization passes in \p options over \p module and returns the rewritten module.
+ *
+ * Every pass preserves the module's observable behavior under WGSL semantics (the result of each
+ * entry point for every input), its bindings and binding indices, and its entry point
+ * signatures, so the optimized module is a drop-in replacement at the pipeline layout level.
+ * Uniform specialization is the exception by design: the result is only equivalent when the
+ * specialized members hold the given values at draw time.
+ *
+ * Generated lets are named `hoistN` and `cseN`, skipping names the module already uses.
+ *
+ * @param module Validated module to optimize.
+ * @param options Passes to run and uniform members to specialize.
+ * @param statistics If non-null, receives the rewrite counts.
+ * @return The optimized module, or an error if a uniform specialization does not name a uniform
+ *   member or its value is not a literal of the member's type.
+ */
+ShaderResult<IrModule> OptimizeModule(const IrModule& module,
+                                      const IrPassOptions& options = IrPassOptions(),
+                                      IrPassStatistics* statistics = nullptr);
+
+}  // namespace donner::gpu::shader
@@ -0,0 +1,404 @@
+/// @file
+/// Optimization pass tests: each pass rewrites small modules into the expected IR (compared as
+/// serialized before/after dumps), specialization validates its inputs, and the optimized
+/// solid-fill program still emits WGSL and MSL.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "donner/gpu/shader/IrPasses.h"
+#include "donner/gpu/shader/MslEmitter.h"
+#include "donner/gpu/shader/WgslEmitter.h"
+#include "donner/gpu/shader/programs/SolidFill.h"
+#include "donner/gpu/shader/tests/ShaderTestUtils.h"
+
+using testing::HasSubstr;
+using testing::Not;
+
+namespace donner::gpu::shader {
+namespace {
+
+/// Unwraps an expression result, recording a failure on error.
+IrExpr Must(ShaderResult<IrExpr>&& result) {
+  return GetShaderResultOrFail(std::move(result), LiteralF32(0));
+}
+
+/// Serialized body of function \p name: the lines after its `body:` marker, up to the next
+/// function.
+std::string FunctionBody(const IrModule& module, std::string_view name) {
+  const std::string dump = module.serialize();
+  const size_t function = dump.find(std::string("function ") + std::string(name) + "\n");
+  const size_t stage = dump.find(std::string("function ") + std::string(name) + " stage=");
+  const size_t start = std::min(function, stage);
+  if (start == std::string::npos) {
+    return "<missing>";
+  }
+  const size_t body = dump.find("body:\n", start) + 6;
+  const size_t next = dump.find("\nfunction ", body);
+  return dump.substr(body, next == std::string::npos ? std::string::npos : next + 1 - body);
+}
+
+/// Runs exactly \p passes over \p module.
+IrModule Optimize(const IrModule& module, std::vector<IrPass> passes,
+                  std::vector<UniformSpecialization> uniforms = {},
+                  IrPassStatistics* statistics = nullptr) {
+  IrPassOptions options;
+  options.passes = std::move(passes);
+  options.uniforms = std::move(uniforms);
+  ShaderResult<IrModule> result = OptimizeModule(module, options, statistics);
+  EXPECT_THAT(result, HasShaderResult());
+  if (result.hasError()) {
+    return std::move(ModuleBuilder().build()).result();
+  }
+  return std::move(result).result();
+}
+
+/// Uniform struct of the test modules.
+IrType ParamsType() {
+  return GetShaderResultOrFail(IrType::Struct("Params", {{"color", IrType::Vec4f()},
+                                                         {"mode", IrType::U32()},
+                                                         {"count", IrType::U32()},
+                                                         {"scale", IrType::F32()}}),
+                               IrType::F32());
+}
+
+/// Adds a fragment entry point `fs_main` returning `vec4f(<callee>(value))`, so the plain
+/// function under test is reachable.
+void AddCallingEntryPoint(ModuleBuilder& builder, const RcString& callee) {
+  auto result = builder.createFragmentEntryPoint("fs_main", {IrParam{"value", IrType::F32(), 0}},
+                                                 {IrOutputMember{"color", IrType::Vec4f(), 0}});
+  ASSERT_THAT(result, HasShaderResult());
+  FunctionBuilder function = std::move(result).result();
+  const IrExpr value = Must(function.ref("value"));
+  const IrExpr called = Must(function.callFunction(callee, {value}));
+  EXPECT_THAT(function.returnOutputs({Must(ConstructVector(IrType::Vec4f(), {called}))}),
+              IsShaderOk());
+  EXPECT_THAT(function.finish(), IsShaderOk());
+}
+
+/// `fold(x)`: literal arithmetic, identities, a constant, a never-assigned var, a let copy, and
+/// a select with a literal condition; plus an unused constant and an unreachable function.
+ShaderResult<IrModule> BuildFoldModule() {
+  ModuleBuilder builder;
+  EXPECT_THAT(builder.addConstant("kHalf", LiteralF32(0.5f)), IsShaderOk());
+  EXPECT_THAT(builder.addConstant("kUnused", LiteralU32(7)), IsShaderOk());
+  {
+    auto result = builder.createFunction("unused", {}, IrType::F32());
+    EXPECT_THAT(result, HasShaderResult());
+    FunctionBuilder function = std::move(result).result();
+    EXPECT_THAT(function.returnValue(LiteralF32(1)), IsShaderOk());
+    EXPECT_THAT(function.finish(), IsShaderOk());
+  }
+  {
+    auto result = builder.createFunction("fold", {IrParam{"x", IrType::F32()}}, IrType::F32());
+    EXPECT_THAT(result, HasShaderResult());
+    FunctionBuilder function = std::move(result).result();
+    const IrExpr x = Must(function.ref("x"));
+    const IrExpr half = Must(function.ref("kHalf"));
+    const IrExpr scale = Must(function.addLet("scale", Must(Mul(half, LiteralF32(4)))));
+    const IrExpr y = Must(function.addLet(
+        "y", Must(Add(Must(Mul(x, LiteralF32(1))), LiteralF32(0)))));
+    const IrExpr bias = Must(function.addVar("bias", IrType::F32(), LiteralF32(3)));
+    const IrExpr s = Must(function.addLet(
+        "s", Must(CallBuiltin(BuiltinFn::Select, {y, scale, LiteralBool(true)}))));
+    EXPECT_THAT(function.returnValue(Must(Add(Must(Mul(y, s)), bias))), IsShaderOk());
+    EXPECT_THAT(function.finish(), IsShaderOk());
+  }
+  AddCallingEntryPoint(builder, "fold");
+  return builder.build();
+}
+
+TEST(IrPasses, FoldsConstantsAndRemovesDeadDeclarations) {
+  ShaderResult<IrModule> module = BuildFoldModule();
+  ASSERT_THAT(module, HasShaderResult());
+
+  EXPECT_EQ(FunctionBody(module.result(), "fold"),
+            "    let scale = mul(ref(kHalf), lit_f32(4))\n"
+            "    let y = add(mul(ref(x), lit_f32(1)), lit_f32(0))\n"
+            "    var bias: f32 = lit_f32(3)\n"
+            "    let s = builtin_select(ref(y), ref(scale), lit_bool(true))\n"
+            "    return(add(mul(ref(y), ref(s)), ref(bias)))\n");
+
+  IrPassStatistics statistics;
+  const IrModule optimized = Optimize(
+      module.result(), {IrPass::FoldConstants, IrPass::EliminateDeadCode}, {}, &statistics);
+  EXPECT_EQ(FunctionBody(optimized, "fold"),
+            "    return(add(mul(ref(x), lit_f32(2)), lit_f32(3)))\n");
+
+  const std::string dump = optimized.serialize();
+  EXPECT_THAT(dump, Not(HasSubstr("kHalf")));
+  EXPECT_THAT(dump, Not(HasSubstr("kUnused")));
+  EXPECT_THAT(dump, Not(HasSubstr("function unused")));
+  EXPECT_EQ(statistics.removedStatements, 4u);
+  EXPECT_EQ(statistics.removedFunctions, 1u);
+  EXPECT_EQ(statistics.removedConstants, 2u);
+
+  // Folding alone keeps the now-dead declarations.
+  const IrModule foldedOnly = Optimize(module.result(), {IrPass::FoldConstants});
+  EXPECT_EQ(FunctionBody(foldedOnly, "fold"),
+            "    let scale = lit_f32(2)\n"
+            "    let y = ref(x)\n"
+            "    var bias: f32 = lit_f32(3)\n"
+            "    let s = lit_f32(2)\n"
+            "    return(add(mul(ref(x), lit_f32(2)), lit_f32(3)))\n");
+}
+
+TEST(IrPasses, FoldsIntegersWithWgslSemantics) {
+  ModuleBuilder builder;
+  {
+    auto result = builder.createFunction("ints", {}, IrType::Vec4(ScalarKind::U32));
+    ASSERT_THAT(result, HasShaderResult());
+    FunctionBuilder function = std::move(result).result();
+    // Division by zero yields the dividend, arithmetic wraps, and float-to-integer conversion
+    // saturates.
+    const IrExpr quotient = Must(Div(LiteralU32(5), LiteralU32(0)));
+    const IrExpr wrapped = Must(Add(LiteralU32(0xFFFFFFFFu), LiteralU32(2)));
+    const IrExpr saturated = Must(Convert(IrType::U32(), LiteralF32(5e9f)));
+    const IrExpr truncated =
+        Must(Convert(IrType::U32(), Must(Div(LiteralI32(-7), LiteralI32(2)))));
+    EXPECT_THAT(function.returnValue(Must(ConstructVector(
+                    IrType::Vec4(ScalarKind::U32), {quotient, wrapped, saturated, truncated}))),
+                IsShaderOk());
+    EXPECT_THAT(function.finish(), IsShaderOk());
+  }
+  {
+    auto result = builder.createFunction("minInt", {}, IrType::I32());
+    ASSERT_THAT(result, HasShaderResult());
+    FunctionBuilder function = std::move(result).result();
+    EXPECT_THAT(function.returnValue(Must(Sub(LiteralI32(-2147483647), LiteralI32(1)))),
+                IsShaderOk());
+    EXPECT_THAT(function.finish(), IsShaderOk());
+  }
+  ShaderResult<IrModule> module = builder.build();
+  ASSERT_THAT(module, HasShaderResult());
+
+  const IrModule optimized = Optimize(module.result(), {IrPass::FoldConstants});
+  EXPECT_EQ(FunctionBody(optimized, "ints"),
+            "    return(construct_vec4<u32>(lit_u32(5), lit_u32(1), lit_u32(4294967295), "
+            "lit_u32(4294967293)))\n");
+  // The most negative i32 has no WGSL literal spelling, so it stays an expression.
+  EXPECT_EQ(FunctionBody(optimized, "minInt"),
+            "    return(sub(lit_i32(-2147483647), lit_i32(1)))\n");
+}
+
+/// A fragment entry point that branches on `params.mode`.
+ShaderResult<IrModule> BuildModeModule() {
+  ModuleBuilder builder;
+  EXPECT_THAT(builder.addUniformBuffer(0, 0, "params", ParamsType()), IsShaderOk());
+  auto result = builder.createFragmentEntryPoint("fs_main", {},
+                                                 {IrOutputMember{"color", IrType::Vec4f(), 0}});
+  EXPECT_THAT(result, HasShaderResult());
+  FunctionBuilder function = std::move(result).result();
+  const IrExpr params = Must(function.ref("params"));
+  const IrExpr mode = Must(Member(params, "mode"));
+
+  EXPECT_THAT(function.beginIf(Must(Eq(mode, LiteralU32(0)))), IsShaderOk());
+  EXPECT_THAT(function.returnOutputs({Must(Member(params, "color"))}), IsShaderOk());
+  EXPECT_THAT(function.endIf(), IsShaderOk());
+  EXPECT_THAT(function.beginIf(Must(Eq(mode, LiteralU32(1)))), IsShaderOk());
+  EXPECT_THAT(function.returnOutputs(
+                  {Must(ConstructVector(IrType::Vec4f(), {Must(Member(params, "scale"))}))}),
+              IsShaderOk());
+  EXPECT_THAT(function.endIf(), IsShaderOk());
+  EXPECT_THAT(function.returnOutputs({Must(ConstructVector(IrType::Vec4f(), {LiteralF32(0)}))}),
+              IsShaderOk());
+  EXPECT_THAT(function.finish(), IsShaderOk());
+  return builder.build();
+}
+
+TEST(IrPasses, SpecializesUniformsIntoConstantVariants) {
+  ShaderResult<IrModule> module = BuildModeModule();
+  ASSERT_THAT(module, HasShaderResult());
+  EXPECT_EQ(FunctionBody(module.result(), "fs_main"),
+            "    if eq(member(ref(params), mode), lit_u32(0))\n"
+            "      return(member(ref(params), color))\n"
+            "    if eq(member(ref(params), mode), lit_u32(1))\n"
+            "      return(construct_vec4<f32>(member(ref(params), scale)))\n"
+            "    return(construct_vec4<f32>(lit_f32(0)))\n");
+
+  IrPassStatistics statistics;
+  const IrModule modeOne =
+      Optimize(module.result(), DefaultIrPasses(),
+               {UniformSpecialization{"params", "mode", LiteralU32(1)}}, &statistics);
+  EXPECT_EQ(FunctionBody(modeOne, "fs_main"),
+            "    return(construct_vec4<f32>(member(ref(params), scale)))\n");
+  EXPECT_EQ(statistics.specializedLoads, 2u);
+
+  const IrModule modeTwo = Optimize(module.result(), DefaultIrPasses(),
+                                    {UniformSpecialization{"params", "mode", LiteralU32(2)}});
+  EXPECT_EQ(FunctionBody(modeTwo, "fs_main"), "    return(construct_vec4<f32>(lit_f32(0)))\n");
+
+  // The binding survives even when no load remains, so binding indices stay stable.
+  EXPECT_THAT(modeTwo.serialize(), HasSubstr("binding group=0 binding=0 kind=uniform params"));
+
+  // Without specialization, nothing folds.
+  EXPECT_EQ(Optimize(module.result(), {IrPass::FoldConstants, IrPass::EliminateDeadCode})
+                .serialize(),
+            module.result().serialize());
+}
+
+TEST(IrPasses, RejectsInvalidSpecializations) {
+  ShaderResult<IrModule> module = BuildModeModule();
+  ASSERT_THAT(module, HasShaderResult());
+
+  const auto specialize = [&](UniformSpecialization uniform) {
+    IrPassOptions options;
+    options.uniforms = {std::move(uniform)};
+    return OptimizeModule(module.result(), options);
+  };
+  EXPECT_THAT(specialize({"missing", "mode", LiteralU32(0)}),
+              IsShaderError(HasSubstr("missing is not a uniform buffer binding")));
+  EXPECT_THAT(specialize({"params", "missing", LiteralU32(0)}),
+              IsShaderError(HasSubstr("uniform params has no member missing")));
+  EXPECT_THAT(specialize({"params", "mode", LiteralI32(0)}),
+              IsShaderError(HasSubstr("must be a u32 literal")));
+}
+
+TEST(IrPasses, HoistsLoopInvariants) {
+  ModuleBuilder builder;
+  EXPECT_THAT(builder.addUniformBuffer(0, 0, "params", ParamsType()), IsShaderOk());
+  {
+    auto result = builder.createFunction("sum", {IrParam{"x", IrType::F32()}}, IrType::F32());
+    ASSERT_THAT(result, HasShaderResult());
+    FunctionBuilder function = std::move(result).result();
+    const IrExpr x = Must(function.ref("x"));
+    const IrExpr params = Must(function.ref("params"));
+    const IrExpr total = Must(function.addVar("total", IrType::F32(), LiteralF32(0)));
+    const IrExpr i = Must(function.beginFor("i", LiteralU32(0)));
+    EXPECT_THAT(function.forCondition(Must(Lt(i, Must(Member(params, "count"))))), IsShaderOk());
+    EXPECT_THAT(function.forContinuing(i, Must(Add(i, LiteralU32(1)))), IsShaderOk());
+    // `params.scale * x` is invariant; `f32(i)` is not.
+    const IrExpr term = Must(Mul(Must(Mul(Must(Member(params, "scale")), x)),
+                                 Must(Convert(IrType::F32(), i))));
+    EXPECT_THAT(function.assign(total, Must(Add(total, term))), IsShaderOk());
+    EXPECT_THAT(function.endFor(), IsShaderOk());
+    EXPECT_THAT(function.returnValue(total), IsShaderOk());
+    EXPECT_THAT(function.finish(), IsShaderOk());
+  }
+  ShaderResult<IrModule> module = builder.build();
+  ASSERT_THAT(module, HasShaderResult());
+
+  IrPassStatistics statistics;
+  const IrModule optimized =
+      Optimize(module.result(), {IrPass::HoistLoopInvariants}, {}, &statistics);
+  EXPECT_EQ(FunctionBody(optimized, "sum"),
+            "    var total: f32 = lit_f32(0)\n"
+            "    let hoist0 = member(ref(params), count)\n"
+            "    let hoist1 = mul(member(ref(params), scale), ref(x))\n"
+            "    for\n"
+            "      init:\n"
+            "        var i: u32 = lit_u32(0)\n"
+            "      cond: lt(ref(i), ref(hoist0))\n"
+            "      continuing:\n"
+            "        assign ref(i) = add(ref(i), lit_u32(1))\n"
+            "      body:\n"
+            "        assign ref(total) = add(ref(total), mul(ref(hoist1), convert_f32(ref(i))))\n"
+            "    return(ref(total))\n");
+  EXPECT_EQ(statistics.hoistedExprs, 2u);
+  EXPECT_THAT(EmitWgsl(optimized), HasShaderResult());
+  EXPECT_THAT(EmitMsl(optimized), HasShaderResult());
+}
+
+TEST(IrPasses, EliminatesCommonSubexpressions) {
+  ModuleBuilder builder;
+  {
+    auto result = builder.createFunction(
+        "cse", {IrParam{"a", IrType::F32()}, IrParam{"b", IrType::F32()}}, IrType::F32());
+    ASSERT_THAT(result, HasShaderResult());
+    FunctionBuilder function = std::move(result).result();
+    const IrExpr a = Must(function.ref("a"));
+    const IrExpr b = Must(function.ref("b"));
+    const IrExpr sum = Must(Add(a, b));
+    const IrExpr square = Must(function.addLet("square", Must(Mul(sum, sum))));
+    // A var read is never shared: `v * 2.0` differs before and after the assignment.
+    const IrExpr v = Must(function.addVar("v", IrType::F32(), square));
+    const IrExpr before = Must(function.addLet("before", Must(Mul(v, LiteralF32(2)))));
+    EXPECT_THAT(function.assign(v, Must(Sub(v, sum))), IsShaderOk());
+    const IrExpr after = Must(function.addLet("after", Must(Mul(v, LiteralF32(2)))));
+    EXPECT_THAT(function.returnValue(Must(Add(before, after))), IsShaderOk());
+    EXPECT_THAT(function.finish(), IsShaderOk());
+  }
+  ShaderResult<IrModule> module = builder.build();
+  ASSERT_THAT(module, HasShaderResult());
+
+  const IrModule optimized = Optimize(module.result(), {IrPass::EliminateCommonSubexpressions});
+  EXPECT_EQ(FunctionBody(optimized, "cse"),
+            "    let cse0 = add(ref(a), ref(b))\n"
+            "    let square = mul(ref(cse0), ref(cse0))\n"
+            "    var v: f32 = ref(square)\n"
+            "    let before = mul(ref(v), lit_f32(2))\n"
+            "    assign ref(v) = sub(ref(v), ref(cse0))\n"
+            "    let after = mul(ref(v), lit_f32(2))\n"
+            "    return(add(ref(before), ref(after)))\n");
+}
+
+TEST(IrPasses, DeadCodeKeepsStatementsAfterDiscard) {
+  ModuleBuilder builder;
+  auto result = builder.createFragmentEntryPoint("fs_main", {IrParam{"value", IrType::F32(), 0}},
+                                                 {IrOutputMember{"color", IrType::Vec4f(), 0}});
+  ASSERT_THAT(result, HasShaderResult());
+  FunctionBuilder function = std::move(result).result();
+  const IrExpr value = Must(function.ref("value"));
+  const IrExpr color = Must(ConstructVector(IrType::Vec4f(), {value}));
+
+  // WGSL `discard` demotes the invocation to a helper that keeps running (and keeps feeding
+  // derivatives), so it does not end the block; `return` does.
+  EXPECT_THAT(function.beginIf(Must(Lt(value, LiteralF32(0)))), IsShaderOk());
+  EXPECT_THAT(function.discard(), IsShaderOk());
+  EXPECT_THAT(function.returnOutputs({color}), IsShaderOk());
+  EXPECT_THAT(function.endIf(), IsShaderOk());
+  EXPECT_THAT(function.returnOutputs({color}), IsShaderOk());
+  EXPECT_THAT(function.addLet("unreachable", value), HasShaderResult());
+  EXPECT_THAT(function.returnOutputs({color}), IsShaderOk());
+  EXPECT_THAT(function.finish(), IsShaderOk());
+  ShaderResult<IrModule> module = builder.build();
+  ASSERT_THAT(module, HasShaderResult());
+
+  const IrModule optimized = Optimize(module.result(), {IrPass::EliminateDeadCode});
+  EXPECT_EQ(FunctionBody(optimized, "fs_main"),
+            "    if lt(ref(value), lit_f32(0))\n"
+            "      discard\n"
+            "      return(construct_vec4<f32>(ref(value)))\n"
+            "    return(construct_vec4<f32>(ref(value)))\n");
+}
+
+TEST(IrPasses, OptimizedSolidFillStillEmits) {
+  ShaderResult<IrModule> module = programs::BuildSolidFillModule();
+  ASSERT_THAT(module, HasShaderResult());
+  const std::string original = GetShaderResultOrFail(EmitWgsl(module.result()), std::string());
+
+  const IrModule optimized = Optimize(module.result(), DefaultIrPasses());
+  const std::string wgsl = GetShaderResultOrFail(EmitWgsl(optimized), std::string());
+  EXPECT_THAT(EmitMsl(optimized), HasShaderResult());
+  EXPECT_THAT(wgsl, HasSubstr("let hoist"));
+  EXPECT_THAT(wgsl, HasSubstr("let cse"));
+
+  // The common solid-color, nonzero-rule, unclipped variant drops the clip and pattern paths.
+  IrPassStatistics statistics;
+  const IrModule variant = Optimize(module.result(), DefaultIrPasses(),
+                                    {{"uniforms", "fillRule", LiteralU32(0)},
+                                     {"uniforms", "paintMode", LiteralU32(0)},
+                                     {"uniforms", "hasClipPolygon", LiteralU32(0)},
+                                     {"uniforms", "hasClipMask", LiteralU32(0)}},
+                                    &statistics);
+  const std::string variantWgsl = GetShaderResultOrFail(EmitWgsl(variant), std::string());
+  EXPECT_THAT(EmitMsl(variant), HasShaderResult());
+  EXPECT_LT(variantWgsl.size(), original.size());
+  EXPECT_THAT(variantWgsl, Not(HasSubstr("textureSample")));
+  EXPECT_THAT(variantWgsl, Not(HasSubstr("fn clip_mask_coverage")));
+  EXPECT_THAT(variantWgsl, Not(HasSubstr("fn sample_in_clip_polygon")));
+  EXPECT_EQ(variant.bindings().size(), module.result().bindings().size());
+  EXPECT_EQ(statistics.removedFunctions, 2u);
+
+  // Optimization is deterministic.
+  EXPECT_EQ(Optimize(module.result(), DefaultIrPasses()).serialize(), optimized.serialize());
+}
+
+}  // namespace
+}  // namespace donner::gpu::shader
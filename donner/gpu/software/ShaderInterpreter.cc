@@ -0,0 +1,1694 @@
+#include "donner/gpu/software/ShaderInterpreter.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <string>
+#include <utility>
+#include <variant>
+
+#include "donner/gpu/shader/IrLayout.h"
+
+namespace donner::gpu::software {
+
+using shader::AddressSpace;
+using shader::BinaryOp;
+using shader::BindingKind;
+using shader::BuiltinFn;
+using shader::IrExpr;
+using shader::IrStmt;
+using shader::IrType;
+using shader::RefKind;
+using shader::ScalarKind;
+using shader::StageKind;
+
+namespace {
+
+/// Sentinel for an absent node or statement value.
+constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+
+/// Register words occupied by a value of \p type. Values are flattened without padding:
+/// matrices column-major, structs member by member. Textures and samplers hold their binding
+/// index.
+uint32_t WordCount(const IrType& type) {
+  switch (type.kind()) {
+    case IrType::Kind::Scalar: return 1;
+    case IrType::Kind::Vector: return type.vectorSize();
+    case IrType::Kind::Matrix4x4f: return 16;
+    case IrType::Kind::SizedArray: return type.arrayCount() * WordCount(type.elementType());
+    case IrType::Kind::Struct: {
+      uint32_t words = 0;
+      for (const IrType::Member& member : type.structMembers()) {
+        words += WordCount(member.type);
+      }
+      return words;
+    }
+    case IrType::Kind::RuntimeArray: return 0;
+    case IrType::Kind::Texture2dF32:
+    case IrType::Kind::Sampler: return 1;
+  }
+  return 0;
+}
+
+/// Component type of a scalar or vector; f32 for everything else (matrices are f32, and other
+/// types are only moved, never computed on).
+ScalarKind ElementKind(const IrType& type) {
+  return (type.isScalar() || type.isVector()) ? type.scalarKind() : ScalarKind::F32;
+}
+
+/// Register word offset of member \p name within a struct value, or nullopt if absent.
+std::optional<uint32_t> MemberWordOffset(const IrType& structType, const RcString& name) {
+  if (structType.kind() != IrType::Kind::Struct) {
+    return std::nullopt;
+  }
+  uint32_t offset = 0;
+  for (const IrType::Member& member : structType.structMembers()) {
+    if (member.name == name) {
+      return offset;
+    }
+    offset += WordCount(member.type);
+  }
+  return std::nullopt;
+}
+
+/// Bit pattern of a literal.
+uint32_t LiteralBits(const IrExpr::Node& node) {
+  if (const bool* value = std::get_if<bool>(&node.literal)) {
+    return *value ? 1u : 0u;
+  }
+  if (const int32_t* value = std::get_if<int32_t>(&node.literal)) {
+    return std::bit_cast<uint32_t>(*value);
+  }
+  if (const uint32_t* value = std::get_if<uint32_t>(&node.literal)) {
+    return *value;
+  }
+  return std::bit_cast<uint32_t>(std::get<float>(node.literal));
+}
+
+/// Integer value of a literal index, or nullopt for non-integer literals.
+std::optional<int64_t> LiteralIndex(const IrExpr& expr) {
+  if (expr.kind() != IrExpr::Kind::Literal) {
+    return std::nullopt;
+  }
+  if (const int32_t* value = std::get_if<int32_t>(&expr.node().literal)) {
+    return *value;
+  }
+  if (const uint32_t* value = std::get_if<uint32_t>(&expr.node().literal)) {
+    return *value;
+  }
+  return std::nullopt;
+}
+
+/// Lowered expression operation.
+enum class NodeOp : uint8_t {
+  Storage,       //!< The value already lives at `dst` (names, literals, constants).
+  Alias,         //!< A view into child 0's value at `dst`; evaluating it evaluates the child.
+  Unary,         //!< Unary operator.
+  Binary,        //!< Component-wise binary operator, broadcasting scalar operands.
+  MatrixVector,  //!< mat4x4f * vec4f.
+  MatrixMatrix,  //!< mat4x4f * mat4x4f.
+  Swizzle,       //!< Multi-component swizzle.
+  Index,         //!< Dynamic index into a function-local vector or array.
+  Load,          //!< Read from a bound buffer through a member/index chain.
+  Construct,     //!< Concatenation of the children's components.
+  Splat,         //!< One scalar replicated to every component.
+  Convert,       //!< Component type conversion, splatting a scalar operand.
+  Builtin,       //!< Builtin function call.
+  Call,          //!< User function call.
+};
+
+/// One dynamic index term of a load or index chain.
+struct DynamicIndex {
+  uint32_t node = kNoNode;  //!< Index expression.
+  uint32_t stride = 0;      //!< Element stride: bytes for loads, register words otherwise.
+  uint32_t count = 0;       //!< Element count, clamped against; 0 for runtime-sized arrays.
+};
+
+/// A lowered expression: an operation writing `words` register words at `dst`.
+struct Node {
+  NodeOp op = NodeOp::Storage;                     //!< Operation.
+  ScalarKind operandKind = ScalarKind::F32;        //!< Component type of the first operand.
+  ScalarKind resultKind = ScalarKind::F32;         //!< Component type of the result.
+  uint32_t dst = 0;                                //!< First result register word.
+  uint32_t words = 0;                              //!< Result register words.
+  std::vector<uint32_t> children;                  //!< Operand nodes, evaluated first.
+  IrExpr::UnaryOp unaryOp = IrExpr::UnaryOp::Neg;  //!< Unary payload.
+  BinaryOp binaryOp = BinaryOp::Add;               //!< Binary payload.
+  BuiltinFn builtin = BuiltinFn::Abs;              //!< Builtin payload.
+  std::array<uint8_t, 4> swizzle = {};             //!< Swizzle components.
+  uint32_t function = 0;                           //!< Call: callee function index.
+  uint32_t resource = 0;                           //!< Load: binding index.
+  uint32_t baseOffset = 0;                         //!< Load: static byte offset.
+  std::vector<DynamicIndex> indices;               //!< Load and Index: dynamic index terms.
+  /// Load: (byte offset, result word) of every 32-bit component read.
+  std::vector<std::pair<uint32_t, uint32_t>> loadPlan;
+  uint32_t loadExtent = 0;  //!< Load: bytes read past the computed offset.
+};
+
+/// Assignment target: a base register word plus dynamic index terms (strides in words).
+struct LValue {
+  uint32_t base = 0;                  //!< Target word with every dynamic index at zero.
+  std::vector<DynamicIndex> indices;  //!< Dynamic index terms.
+};
+
+/// A lowered statement.
+struct Stmt {
+  IrStmt::Kind kind = IrStmt::Kind::Break;  //!< Statement kind.
+  uint32_t value = kNoNode;    //!< Let/var initializer, assigned value, condition, or return value.
+  uint32_t target = 0;         //!< Let/var storage, or a plain function's return slot.
+  uint32_t words = 0;          //!< Words copied to `target`.
+  bool copyValue = true;       //!< Let: false when the value node already writes `target`.
+  LValue lvalue;               //!< Assign target.
+  std::vector<uint32_t> outputValues;  //!< Entry point return values, one per output.
+  std::vector<Stmt> body;              //!< If-then / for body.
+  std::vector<Stmt> elseBody;          //!< If-else body.
+  std::vector<Stmt> init;              //!< For-loop init (zero or one statement).
+  std::vector<Stmt> continuing;        //!< For-loop continuing (zero or one statement).
+};
+
+/// A lowered function with its static register frame.
+struct Function {
+  RcString name;                                      //!< Function name.
+  StageKind stage = StageKind::None;                  //!< Entry point stage.
+  std::vector<std::pair<uint32_t, uint32_t>> params;  //!< (register word, words) per parameter.
+  uint32_t returnOffset = 0;                          //!< Plain function return slot.
+  uint32_t returnWords = 0;                           //!< Words in the return slot.
+  std::vector<std::pair<uint32_t, uint32_t>> outputs;  //!< (register word, words) per output.
+  std::vector<Stmt> body;                              //!< Function body.
+};
+
+}  // namespace
+
+/// Lowered program: everything execution needs, resolved to register offsets.
+struct ShaderProgram::Impl {
+  std::vector<Node> nodes;                                //!< Expression nodes.
+  std::vector<Function> functions;                        //!< Functions in declaration order.
+  std::vector<std::pair<uint32_t, uint32_t>> constants;  //!< (register word, bits) presets.
+  uint32_t registerWords = 0;                             //!< Register words per lane.
+  std::vector<shader::IrBinding> bindings;                //!< Module bindings.
+  std::vector<EntryPoint> entryPoints;                    //!< Entry point interfaces.
+  std::vector<uint32_t> entryFunctions;                   //!< Function index per entry point.
+};
+
+namespace {
+
+/**
+ * Lowers an \ref shader::IrModule into a \ref ShaderProgram::Impl. The first unsupported
+ * construct latches an error; lowering continues against a placeholder node so the caller only
+ * checks once, at the end.
+ */
+class Lowerer {
+public:
+  Lowerer(const shader::IrModule& module, ShaderProgram::Impl& program)
+      : module_(module), program_(program) {}
+
+  Status lower() {
+    program_.bindings = module_.bindings();
+    // Node 0 is the placeholder returned after an error.
+    constantNode(0, ScalarKind::U32);
+
+    for (const shader::IrConstant& constant : module_.constants()) {
+      const IrExpr& value = constant.value;
+      if (value.kind() != IrExpr::Kind::Literal) {
+        fail(std::format("constant '{}' is not a literal", std::string_view(constant.name)));
+        continue;
+      }
+      moduleConstants_.emplace_back(constant.name,
+                                    constantNode(LiteralBits(value.node()),
+                                                 ElementKind(value.type())));
+    }
+
+    for (const shader::IrFunction& function : module_.functions()) {
+      lowerFunction(function);
+    }
+
+    if (error_) {
+      return *error_;
+    }
+    return OkStatus();
+  }
+
+private:
+  /// A name in scope: parameter, let, or var.
+  struct Local {
+    RcString name;       //!< Declared name.
+    uint32_t offset = 0;  //!< First register word.
+    uint32_t words = 0;   //!< Register words.
+  };
+
+  /// Latches \p message as the lowering error and returns the placeholder node.
+  uint32_t fail(std::string message) {
+    if (!error_) {
+      error_ = GpuError{GpuErrorType::Unsupported,
+                        std::format("software shader interpreter: {}", message)};
+    }
+    return 0;
+  }
+
+  uint32_t allocate(uint32_t words) {
+    const uint32_t offset = program_.registerWords;
+    program_.registerWords += words;
+    return offset;
+  }
+
+  uint32_t addNode(Node&& node) {
+    program_.nodes.push_back(std::move(node));
+    return static_cast<uint32_t>(program_.nodes.size() - 1);
+  }
+
+  /// Adds a one-word register preset to \p bits on every lane, and a node reading it.
+  uint32_t constantNode(uint32_t bits, ScalarKind kind) {
+    Node node;
+    node.dst = allocate(1);
+    node.words = 1;
+    node.operandKind = kind;
+    node.resultKind = kind;
+    program_.constants.emplace_back(node.dst, bits);
+    return addNode(std::move(node));
+  }
+
+  /// Node reading the \p words register words at \p offset.
+  uint32_t storageNode(uint32_t offset, uint32_t words, ScalarKind kind) {
+    Node node;
+    node.dst = offset;
+    node.words = words;
+    node.operandKind = kind;
+    node.resultKind = kind;
+    return addNode(std::move(node));
+  }
+
+  const Local* findLocal(const RcString& name) const {
+    for (auto it = locals_.rbegin(); it != locals_.rend(); ++it) {
+      if (it->name == name) {
+        return &*it;
+      }
+    }
+    return nullptr;
+  }
+
+  std::optional<uint32_t> findBinding(const RcString& name) const {
+    for (size_t i = 0; i < module_.bindings().size(); ++i) {
+      if (module_.bindings()[i].name == name) {
+        return static_cast<uint32_t>(i);
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// If \p expr is a member/index chain rooted at a buffer binding, returns the binding index.
+  std::optional<uint32_t> bufferRoot(const IrExpr& expr) const {
+    const IrExpr* cursor = &expr;
+    while (cursor->kind() == IrExpr::Kind::Member || cursor->kind() == IrExpr::Kind::Index) {
+      cursor = &cursor->node().children[0];
+    }
+    if (cursor->kind() != IrExpr::Kind::Ref || cursor->node().refKind != RefKind::Resource) {
+      return std::nullopt;
+    }
+    const std::optional<uint32_t> binding = findBinding(cursor->node().name);
+    if (!binding) {
+      return std::nullopt;
+    }
+    const BindingKind kind = module_.bindings()[*binding].kind;
+    if (kind != BindingKind::UniformBuffer && kind != BindingKind::ReadOnlyStorageBuffer) {
+      return std::nullopt;
+    }
+    return binding;
+  }
+
+  void lowerFunction(const shader::IrFunction& source) {
+    Function function;
+    function.name = source.name;
+    function.stage = source.stage;
+    locals_.clear();
+
+    ShaderProgram::EntryPoint entryPoint;
+    entryPoint.name = source.name;
+    entryPoint.stage = source.stage;
+
+    for (const shader::IrParam& param : source.params) {
+      const uint32_t words = WordCount(param.type);
+      const uint32_t offset = allocate(words);
+      function.params.emplace_back(offset, words);
+      locals_.push_back(Local{param.name, offset, words});
+      entryPoint.inputs.push_back(ShaderStageValue{param.location, param.builtin, std::nullopt,
+                                                   ElementKind(param.type), words, offset});
+    }
+    if (source.returnType) {
+      function.returnWords = WordCount(*source.returnType);
+      function.returnOffset = allocate(function.returnWords);
+    }
+    for (const shader::IrOutputMember& output : source.outputs) {
+      const uint32_t words = WordCount(output.type);
+      const uint32_t offset = allocate(words);
+      function.outputs.emplace_back(offset, words);
+      entryPoint.outputs.push_back(ShaderStageValue{output.location, std::nullopt, output.builtin,
+                                                    ElementKind(output.type), words, offset});
+    }
+
+    currentFunction_ = &function;
+    lowerBlock(source.body, function.body);
+    currentFunction_ = nullptr;
+
+    functionIndices_.emplace_back(source.name, static_cast<uint32_t>(program_.functions.size()));
+    if (source.stage != StageKind::None) {
+      program_.entryFunctions.push_back(static_cast<uint32_t>(program_.functions.size()));
+      program_.entryPoints.push_back(std::move(entryPoint));
+    }
+    program_.functions.push_back(std::move(function));
+  }
+
+  void lowerBlock(const shader::IrBlock& block, std::vector<Stmt>& out) {
+    const size_t scopeStart = locals_.size();
+    for (const IrStmt& statement : block) {
+      out.push_back(lowerStmt(statement));
+    }
+    locals_.resize(scopeStart);
+  }
+
+  Stmt lowerStmt(const IrStmt& statement) {
+    const IrStmt::Data& data = statement.data();
+    Stmt result;
+    result.kind = data.kind;
+
+    switch (data.kind) {
+      case IrStmt::Kind::Let: {
+        result.value = lowerExpr(data.exprs[0]);
+        const Node& value = program_.nodes[result.value];
+        result.words = value.words;
+        // A freshly computed value is owned by this statement, so the let can name its result
+        // in place. Names and views must be copied: the variable they read may change later.
+        if (value.op != NodeOp::Storage && value.op != NodeOp::Alias) {
+          result.target = value.dst;
+          result.copyValue = false;
+        } else {
+          result.target = allocate(result.words);
+        }
+        locals_.push_back(Local{data.name, result.target, result.words});
+        break;
+      }
+      case IrStmt::Kind::Var: {
+        if (!data.exprs.empty()) {
+          result.value = lowerExpr(data.exprs[0]);
+        }
+        result.words = data.declaredType ? WordCount(*data.declaredType) : 0;
+        result.target = allocate(result.words);
+        locals_.push_back(Local{data.name, result.target, result.words});
+        break;
+      }
+      case IrStmt::Kind::Assign: {
+        result.lvalue = lowerLValue(data.exprs[0]);
+        result.value = lowerExpr(data.exprs[1]);
+        result.words = WordCount(data.exprs[1].type());
+        break;
+      }
+      case IrStmt::Kind::If: {
+        result.value = lowerExpr(data.exprs[0]);
+        lowerBlock(data.body, result.body);
+        lowerBlock(data.elseBody, result.elseBody);
+        break;
+      }
+      case IrStmt::Kind::For: {
+        // The loop variable is scoped to the loop; the continuing statement sees it but not the
+        // body's locals.
+        const size_t scopeStart = locals_.size();
+        if (data.init) {
+          result.init.push_back(lowerStmt(*data.init));
+        }
+        if (!data.exprs.empty()) {
+          result.value = lowerExpr(data.exprs[0]);
+        }
+        lowerBlock(data.body, result.body);
+        if (data.continuing) {
+          result.continuing.push_back(lowerStmt(*data.continuing));
+        }
+        locals_.resize(scopeStart);
+        break;
+      }
+      case IrStmt::Kind::Return: {
+        if (currentFunction_->stage != StageKind::None) {
+          for (const IrExpr& output : data.exprs) {
+            result.outputValues.push_back(lowerExpr(output));
+          }
+          if (result.outputValues.size() != currentFunction_->outputs.size()) {
+            fail(std::format("entry point '{}' returns {} values for {} outputs",
+                             std::string_view(currentFunction_->name), data.exprs.size(),
+                             currentFunction_->outputs.size()));
+          }
+        } else if (!data.exprs.empty()) {
+          result.value = lowerExpr(data.exprs[0]);
+          result.target = currentFunction_->returnOffset;
+          result.words = currentFunction_->returnWords;
+        }
+        break;
+      }
+      case IrStmt::Kind::Break:
+      case IrStmt::Kind::Continue:
+      case IrStmt::Kind::Discard: break;
+    }
+    return result;
+  }
+
+  LValue lowerLValue(const IrExpr& expr) {
+    const IrExpr::Node& node = expr.node();
+    switch (expr.kind()) {
+      case IrExpr::Kind::Ref: {
+        const Local* local = findLocal(node.name);
+        if (local == nullptr) {
+          fail(std::format("assignment to unknown name '{}'", std::string_view(node.name)));
+          return LValue{};
+        }
+        return LValue{local->offset, {}};
+      }
+      case IrExpr::Kind::Member: {
+        LValue result = lowerLValue(node.children[0]);
+        const std::optional<uint32_t> offset =
+            MemberWordOffset(node.children[0].type(), node.name);
+        if (!offset) {
+          fail(std::format("assignment to unknown member '{}'", std::string_view(node.name)));
+          return result;
+        }
+        result.base += *offset;
+        return result;
+      }
+      case IrExpr::Kind::Swizzle: {
+        LValue result = lowerLValue(node.children[0]);
+        if (node.swizzle.size() != 1) {
+          fail("assignment to a multi-component swizzle");
+          return result;
+        }
+        result.base += SwizzleComponent(node.swizzle[0]);
+        return result;
+      }
+      case IrExpr::Kind::Index: {
+        LValue result = lowerLValue(node.children[0]);
+        const IrType& baseType = node.children[0].type();
+        const uint32_t stride = baseType.isVector() ? 1 : WordCount(baseType.elementType());
+        const uint32_t count = baseType.isVector() ? baseType.vectorSize() : baseType.arrayCount();
+        if (const std::optional<int64_t> literal = LiteralIndex(node.children[1])) {
+          const int64_t element = std::clamp<int64_t>(*literal, 0, count - 1);
+          result.base += static_cast<uint32_t>(element) * stride;
+        } else {
+          result.indices.push_back(DynamicIndex{lowerExpr(node.children[1]), stride, count});
+        }
+        return result;
+      }
+      default: fail("unsupported assignment target"); return LValue{};
+    }
+  }
+
+  static uint8_t SwizzleComponent(char component) {
+    switch (component) {
+      case 'y': return 1;
+      case 'z': return 2;
+      case 'w': return 3;
+      default: return 0;
+    }
+  }
+
+  uint32_t lowerExpr(const IrExpr& expr) {
+    const IrExpr::Node& source = expr.node();
+    const uint32_t words = WordCount(expr.type());
+    const ScalarKind resultKind = ElementKind(expr.type());
+
+    switch (expr.kind()) {
+      case IrExpr::Kind::Literal: return constantNode(LiteralBits(source), resultKind);
+
+      case IrExpr::Kind::Ref: {
+        switch (source.refKind) {
+          case RefKind::Param:
+          case RefKind::Let:
+          case RefKind::Var: {
+            const Local* local = findLocal(source.name);
+            if (local == nullptr) {
+              return fail(std::format("unresolved name '{}'", std::string_view(source.name)));
+            }
+            return storageNode(local->offset, local->words, resultKind);
+          }
+          case RefKind::Constant: {
+            for (const auto& [name, node] : moduleConstants_) {
+              if (name == source.name) {
+                return node;
+              }
+            }
+            return fail(std::format("unresolved constant '{}'", std::string_view(source.name)));
+          }
+          case RefKind::Resource: {
+            if (const std::optional<uint32_t> buffer = bufferRoot(expr)) {
+              return lowerLoad(expr, *buffer);
+            }
+            const std::optional<uint32_t> binding = findBinding(source.name);
+            if (!binding) {
+              return fail(std::format("unresolved binding '{}'", std::string_view(source.name)));
+            }
+            return constantNode(*binding, ScalarKind::U32);
+          }
+        }
+        return fail("unknown reference kind");
+      }
+
+      case IrExpr::Kind::Member: {
+        if (const std::optional<uint32_t> buffer = bufferRoot(expr)) {
+          return lowerLoad(expr, *buffer);
+        }
+        const uint32_t base = lowerExpr(source.children[0]);
+        const std::optional<uint32_t> offset =
+            MemberWordOffset(source.children[0].type(), source.name);
+        if (!offset) {
+          return fail(std::format("unknown member '{}'", std::string_view(source.name)));
+        }
+        Node node;
+        node.op = NodeOp::Alias;
+        node.dst = program_.nodes[base].dst + *offset;
+        node.words = words;
+        node.operandKind = resultKind;
+        node.resultKind = resultKind;
+        node.children = {base};
+        return addNode(std::move(node));
+      }
+
+      case IrExpr::Kind::Index: {
+        if (const std::optional<uint32_t> buffer = bufferRoot(expr)) {
+          return lowerLoad(expr, *buffer);
+        }
+        const IrType& baseType = source.children[0].type();
+        const uint32_t base = lowerExpr(source.children[0]);
+        const uint32_t stride = baseType.isVector() ? 1 : WordCount(baseType.elementType());
+        const uint32_t count = baseType.isVector() ? baseType.vectorSize() : baseType.arrayCount();
+
+        Node node;
+        node.words = words;
+        node.operandKind = resultKind;
+        node.resultKind = resultKind;
+        if (const std::optional<int64_t> literal = LiteralIndex(source.children[1])) {
+          node.op = NodeOp::Alias;
+          node.dst = program_.nodes[base].dst +
+                     static_cast<uint32_t>(std::clamp<int64_t>(*literal, 0, count - 1)) * stride;
+          node.children = {base};
+        } else {
+          const uint32_t index = lowerExpr(source.children[1]);
+          node.op = NodeOp::Index;
+          node.dst = allocate(words);
+          node.children = {base, index};
+          node.indices.push_back(DynamicIndex{index, stride, count});
+        }
+        return addNode(std::move(node));
+      }
+
+      case IrExpr::Kind::Swizzle: {
+        const uint32_t base = lowerExpr(source.children[0]);
+        Node node;
+        node.words = words;
+        node.operandKind = resultKind;
+        node.resultKind = resultKind;
+        node.children = {base};
+        if (source.swizzle.size() == 1) {
+          node.op = NodeOp::Alias;
+          node.dst = program_.nodes[base].dst + SwizzleComponent(source.swizzle[0]);
+        } else {
+          node.op = NodeOp::Swizzle;
+          node.dst = allocate(words);
+          for (size_t i = 0; i < source.swizzle.size() && i < node.swizzle.size(); ++i) {
+            node.swizzle[i] = SwizzleComponent(source.swizzle[i]);
+          }
+        }
+        return addNode(std::move(node));
+      }
+
+      case IrExpr::Kind::Unary:
+      case IrExpr::Kind::Binary:
+      case IrExpr::Kind::Construct:
+      case IrExpr::Kind::Convert:
+      case IrExpr::Kind::CallBuiltin:
+      case IrExpr::Kind::CallUser: break;
+    }
+
+    std::vector<uint32_t> children;
+    children.reserve(source.children.size());
+    for (const IrExpr& child : source.children) {
+      children.push_back(lowerExpr(child));
+    }
+
+    Node node;
+    node.words = words;
+    node.resultKind = resultKind;
+    node.operandKind =
+        source.children.empty() ? resultKind : ElementKind(source.children[0].type());
+    node.children = std::move(children);
+
+    switch (expr.kind()) {
+      case IrExpr::Kind::Unary:
+        node.op = NodeOp::Unary;
+        node.unaryOp = source.unaryOp;
+        break;
+      case IrExpr::Kind::Binary: {
+        node.op = NodeOp::Binary;
+        node.binaryOp = source.binaryOp;
+        const IrType& lhsType = source.children[0].type();
+        if (source.binaryOp == BinaryOp::Mul && lhsType.kind() == IrType::Kind::Matrix4x4f) {
+          node.op = source.children[1].type().kind() == IrType::Kind::Matrix4x4f
+                        ? NodeOp::MatrixMatrix
+                        : NodeOp::MatrixVector;
+        } else if (!lhsType.isScalar() && !lhsType.isVector()) {
+          return fail(std::format("binary operator on non-numeric type {}", lhsType.toString()));
+        }
+        break;
+      }
+      case IrExpr::Kind::Construct: {
+        const bool splat = node.children.size() == 1 &&
+                           program_.nodes[node.children[0]].words == 1 && words > 1;
+        node.op = splat ? NodeOp::Splat : NodeOp::Construct;
+        break;
+      }
+      case IrExpr::Kind::Convert: node.op = NodeOp::Convert; break;
+      case IrExpr::Kind::CallBuiltin:
+        node.op = NodeOp::Builtin;
+        node.builtin = source.builtin;
+        break;
+      case IrExpr::Kind::CallUser: {
+        node.op = NodeOp::Call;
+        bool found = false;
+        for (const auto& [name, index] : functionIndices_) {
+          if (name == source.name) {
+            node.function = index;
+            found = true;
+          }
+        }
+        if (!found) {
+          return fail(std::format("call to unknown function '{}'", std::string_view(source.name)));
+        }
+        break;
+      }
+      default: return fail("unsupported expression");
+    }
+
+    node.dst = allocate(words);
+    return addNode(std::move(node));
+  }
+
+  /// Lowers a member/index chain rooted at buffer binding \p bindingIndex into one load.
+  uint32_t lowerLoad(const IrExpr& expr, uint32_t bindingIndex) {
+    std::vector<const IrExpr*> chain;
+    for (const IrExpr* cursor = &expr; cursor->kind() == IrExpr::Kind::Member ||
+                                       cursor->kind() == IrExpr::Kind::Index;
+         cursor = &cursor->node().children[0]) {
+      chain.push_back(cursor);
+    }
+
+    const shader::IrBinding& binding = module_.bindings()[bindingIndex];
+    const AddressSpace space = binding.kind == BindingKind::UniformBuffer ? AddressSpace::Uniform
+                                                                          : AddressSpace::Storage;
+    Node node;
+    node.op = NodeOp::Load;
+    node.resource = bindingIndex;
+    node.words = WordCount(expr.type());
+    node.resultKind = ElementKind(expr.type());
+    node.operandKind = node.resultKind;
+
+    IrType current = binding.type;
+    uint64_t staticOffset = 0;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      const IrExpr::Node& step = (*it)->node();
+      if ((*it)->kind() == IrExpr::Kind::Member) {
+        shader::ShaderResult<shader::StructLayout> layout =
+            shader::ComputeStructLayout(current, space);
+        if (layout.hasError()) {
+          return fail(std::format("layout of {}: {}", current.toString(), layout.error().message));
+        }
+        const std::span<const IrType::Member> members = current.structMembers();
+        size_t memberIndex = 0;
+        while (memberIndex < members.size() && members[memberIndex].name != step.name) {
+          ++memberIndex;
+        }
+        if (memberIndex == members.size()) {
+          return fail(std::format("unknown member '{}'", std::string_view(step.name)));
+        }
+        staticOffset += layout.result().members[memberIndex].offsetBytes;
+        current = members[memberIndex].type;
+        continue;
+      }
+
+      uint32_t stride = 4;
+      uint32_t count = 0;
+      IrType element = IrType::F32();
+      if (current.isVector()) {
+        count = current.vectorSize();
+        element = IrType::Scalar(current.scalarKind());
+      } else {
+        shader::ShaderResult<uint32_t> arrayStride = shader::ComputeArrayStride(current, space);
+        if (arrayStride.hasError()) {
+          return fail(std::format("layout of {}: {}", current.toString(),
+                                  arrayStride.error().message));
+        }
+        stride = arrayStride.result();
+        count = current.kind() == IrType::Kind::SizedArray ? current.arrayCount() : 0;
+        element = current.elementType();
+      }
+
+      const std::optional<int64_t> literal = LiteralIndex(step.children[1]);
+      if (literal && count != 0) {
+        staticOffset += static_cast<uint64_t>(std::clamp<int64_t>(*literal, 0, count - 1)) * stride;
+      } else {
+        const uint32_t index = lowerExpr(step.children[1]);
+        node.indices.push_back(DynamicIndex{index, stride, count});
+        node.children.push_back(index);
+      }
+      current = element;
+    }
+
+    if (staticOffset > std::numeric_limits<uint32_t>::max()) {
+      return fail("buffer access offset overflows");
+    }
+    node.baseOffset = static_cast<uint32_t>(staticOffset);
+    appendLoadPlan(current, space, 0, 0, node.loadPlan);
+    for (const auto& [byteOffset, word] : node.loadPlan) {
+      node.loadExtent = std::max(node.loadExtent, byteOffset + 4);
+    }
+    node.dst = allocate(node.words);
+    return addNode(std::move(node));
+  }
+
+  /// Appends the (byte offset, register word) of every component of \p type, laid out per the
+  /// host-shareable rules of \p space, starting at \p byteOffset and \p word.
+  void appendLoadPlan(const IrType& type, AddressSpace space, uint32_t byteOffset, uint32_t word,
+                      std::vector<std::pair<uint32_t, uint32_t>>& plan) {
+    switch (type.kind()) {
+      case IrType::Kind::Scalar:
+      case IrType::Kind::Vector:
+      case IrType::Kind::Matrix4x4f: {
+        if (ElementKind(type) == ScalarKind::Bool) {
+          fail("bool values are not host-shareable");
+          return;
+        }
+        // Vectors are tightly packed, and mat4x4f columns are vec4f: 16 contiguous floats.
+        for (uint32_t i = 0; i < WordCount(type); ++i) {
+          plan.emplace_back(byteOffset + i * 4, word + i);
+        }
+        return;
+      }
+      case IrType::Kind::SizedArray: {
+        shader::ShaderResult<uint32_t> stride = shader::ComputeArrayStride(type, space);
+        if (stride.hasError()) {
+          fail(std::format("layout of {}: {}", type.toString(), stride.error().message));
+          return;
+        }
+        const uint32_t elementWords = WordCount(type.elementType());
+        for (uint32_t i = 0; i < type.arrayCount(); ++i) {
+          appendLoadPlan(type.elementType(), space, byteOffset + i * stride.result(),
+                         word + i * elementWords, plan);
+        }
+        return;
+      }
+      case IrType::Kind::Struct: {
+        shader::ShaderResult<shader::StructLayout> layout =
+            shader::ComputeStructLayout(type, space);
+        if (layout.hasError()) {
+          fail(std::format("layout of {}: {}", type.toString(), layout.error().message));
+          return;
+        }
+        uint32_t memberWord = word;
+        const std::span<const IrType::Member> members = type.structMembers();
+        for (size_t i = 0; i < members.size(); ++i) {
+          const uint32_t memberOffset = byteOffset + layout.result().members[i].offsetBytes;
+          appendLoadPlan(members[i].type, space, memberOffset, memberWord, plan);
+          memberWord += WordCount(members[i].type);
+        }
+        return;
+      }
+      default: fail(std::format("cannot load a value of type {}", type.toString())); return;
+    }
+  }
+
+  const shader::IrModule& module_;
+  ShaderProgram::Impl& program_;
+  std::optional<GpuError> error_;
+  std::vector<Local> locals_;
+  std::vector<std::pair<RcString, uint32_t>> moduleConstants_;
+  std::vector<std::pair<RcString, uint32_t>> functionIndices_;
+  const Function* currentFunction_ = nullptr;
+};
+
+float AsFloat(uint32_t bits) {
+  return std::bit_cast<float>(bits);
+}
+
+uint32_t FloatBits(float value) {
+  return std::bit_cast<uint32_t>(value);
+}
+
+int32_t AsInt(uint32_t bits) {
+  return std::bit_cast<int32_t>(bits);
+}
+
+/// Applies \p fn to each lane of two operand rows, writing the result row.
+template <typename Fn>
+void MapLanes(const uint32_t* lhs, const uint32_t* rhs, uint32_t* out, Fn&& fn) {
+  for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+    out[lane] = fn(lhs[lane], rhs[lane]);
+  }
+}
+
+/// One binary operator over a row of lanes, for operands of component type \p kind.
+void BinaryLanes(BinaryOp op, ScalarKind kind, const uint32_t* lhs, const uint32_t* rhs,
+                 uint32_t* out) {
+  if (kind == ScalarKind::F32) {
+    const auto floatOp = [&](auto&& fn) {
+      MapLanes(lhs, rhs, out, [&](uint32_t a, uint32_t b) { return fn(AsFloat(a), AsFloat(b)); });
+    };
+    switch (op) {
+      case BinaryOp::Add: return floatOp([](float a, float b) { return FloatBits(a + b); });
+      case BinaryOp::Sub: return floatOp([](float a, float b) { return FloatBits(a - b); });
+      case BinaryOp::Mul: return floatOp([](float a, float b) { return FloatBits(a * b); });
+      case BinaryOp::Div: return floatOp([](float a, float b) { return FloatBits(a / b); });
+      case BinaryOp::Lt: return floatOp([](float a, float b) { return uint32_t(a < b); });
+      case BinaryOp::Le: return floatOp([](float a, float b) { return uint32_t(a <= b); });
+      case BinaryOp::Gt: return floatOp([](float a, float b) { return uint32_t(a > b); });
+      case BinaryOp::Ge: return floatOp([](float a, float b) { return uint32_t(a >= b); });
+      case BinaryOp::Eq: return floatOp([](float a, float b) { return uint32_t(a == b); });
+      case BinaryOp::Ne: return floatOp([](float a, float b) { return uint32_t(a != b); });
+      case BinaryOp::And:
+      case BinaryOp::Or: break;
+    }
+  }
+
+  switch (op) {
+    // Two's complement makes wrapping i32 add/sub/mul identical to u32.
+    case BinaryOp::Add:
+      return MapLanes(lhs, rhs, out, [](uint32_t a, uint32_t b) { return a + b; });
+    case BinaryOp::Sub:
+      return MapLanes(lhs, rhs, out, [](uint32_t a, uint32_t b) { return a - b; });
+    case BinaryOp::Mul:
+      return MapLanes(lhs, rhs, out, [](uint32_t a, uint32_t b) { return a * b; });
+    case BinaryOp::Div:
+      if (kind == ScalarKind::I32) {
+        return MapLanes(lhs, rhs, out, [](uint32_t a, uint32_t b) {
+          const int32_t dividend = AsInt(a);
+          const int32_t divisor = AsInt(b);
+          if (divisor == 0 ||
+              (dividend == std::numeric_limits<int32_t>::min() && divisor == -1)) {
+            return a;
+          }
+          return std::bit_cast<uint32_t>(dividend / divisor);
+        });
+      }
+      return MapLanes(lhs, rhs, out, [](uint32_t a, uint32_t b) { return b == 0 ? a : a / b; });
+    case BinaryOp::Lt:
+    case BinaryOp::Le:
+    case BinaryOp::Gt:
+    case BinaryOp::Ge: {
+      const auto compare = [op](auto a, auto b) {
+        switch (op) {
+          case BinaryOp::Lt: return uint32_t(a < b);
+          case BinaryOp::Le: return uint32_t(a <= b);
+          case BinaryOp::Gt: return uint32_t(a > b);
+          default: return uint32_t(a >= b);
+        }
+      };
+      if (kind == ScalarKind::I32) {
+        return MapLanes(lhs, rhs, out,
+                        [&](uint32_t a, uint32_t b) { return compare(AsInt(a), AsInt(b)); });
+      }
+      return MapLanes(lhs, rhs, out, compare);
+    }
+    case BinaryOp::Eq: return MapLanes(lhs, rhs, out, [](uint32_t a, uint32_t b) {
+        return uint32_t(a == b);
+      });
+    case BinaryOp::Ne: return MapLanes(lhs, rhs, out, [](uint32_t a, uint32_t b) {
+        return uint32_t(a != b);
+      });
+    case BinaryOp::And: return MapLanes(lhs, rhs, out, [](uint32_t a, uint32_t b) {
+        return uint32_t(a != 0 && b != 0);
+      });
+    case BinaryOp::Or: return MapLanes(lhs, rhs, out, [](uint32_t a, uint32_t b) {
+        return uint32_t(a != 0 || b != 0);
+      });
+  }
+}
+
+/// Converts one component between scalar types: float-to-integer saturates (NaN becomes 0),
+/// i32 and u32 reinterpret, bool becomes 0 or 1.
+uint32_t ConvertBits(ScalarKind from, ScalarKind to, uint32_t bits) {
+  if (from == to) {
+    return bits;
+  }
+  if (to == ScalarKind::Bool) {
+    return from == ScalarKind::F32 ? uint32_t(AsFloat(bits) != 0.0f) : uint32_t(bits != 0);
+  }
+
+  switch (from) {
+    case ScalarKind::F32: {
+      const float value = AsFloat(bits);
+      if (std::isnan(value)) {
+        return 0;
+      }
+      if (to == ScalarKind::I32) {
+        if (value >= 2147483648.0f) {
+          return std::bit_cast<uint32_t>(std::numeric_limits<int32_t>::max());
+        }
+        if (value <= -2147483648.0f) {
+          return std::bit_cast<uint32_t>(std::numeric_limits<int32_t>::min());
+        }
+        return std::bit_cast<uint32_t>(static_cast<int32_t>(value));
+      }
+      if (value >= 4294967296.0f) {
+        return std::numeric_limits<uint32_t>::max();
+      }
+      return value <= 0.0f ? 0u : static_cast<uint32_t>(value);
+    }
+    case ScalarKind::I32:
+      return to == ScalarKind::F32 ? FloatBits(static_cast<float>(AsInt(bits))) : bits;
+    case ScalarKind::U32: return to == ScalarKind::F32 ? FloatBits(static_cast<float>(bits)) : bits;
+    case ScalarKind::Bool:
+      return to == ScalarKind::F32 ? FloatBits(bits != 0 ? 1.0f : 0.0f) : uint32_t(bits != 0);
+  }
+  return bits;
+}
+
+/// Texel at (\p x, \p y) of \p texture as RGBA floats, or zero outside the texture.
+std::array<float, 4> FetchTexel(const ShaderResource& texture, int64_t x, int64_t y) {
+  if (x < 0 || y < 0 || x >= texture.textureSize.width || y >= texture.textureSize.height) {
+    return {0.0f, 0.0f, 0.0f, 0.0f};
+  }
+  const uint32_t bytesPerTexel = TextureFormatBytesPerTexel(texture.textureFormat);
+  const uint64_t offset =
+      static_cast<uint64_t>(y) * texture.bytesPerRow + static_cast<uint64_t>(x) * bytesPerTexel;
+  if (offset + bytesPerTexel > texture.bytes.size()) {
+    return {0.0f, 0.0f, 0.0f, 0.0f};
+  }
+
+  const uint8_t* texel = texture.bytes.data() + offset;
+  constexpr float kScale = 1.0f / 255.0f;
+  switch (texture.textureFormat) {
+    case TextureFormat::RGBA8Unorm:
+      return {texel[0] * kScale, texel[1] * kScale, texel[2] * kScale, texel[3] * kScale};
+    case TextureFormat::BGRA8Unorm:
+      return {texel[2] * kScale, texel[1] * kScale, texel[0] * kScale, texel[3] * kScale};
+    case TextureFormat::R8Unorm: return {texel[0] * kScale, 0.0f, 0.0f, 1.0f};
+  }
+  return {0.0f, 0.0f, 0.0f, 0.0f};
+}
+
+/// Applies a sampler address mode to integer texel coordinate \p coord.
+int64_t AddressTexel(AddressMode mode, int64_t coord, uint32_t size) {
+  if (mode == AddressMode::Repeat) {
+    const int64_t wrapped = coord % static_cast<int64_t>(size);
+    return wrapped < 0 ? wrapped + size : wrapped;
+  }
+  return std::clamp<int64_t>(coord, 0, static_cast<int64_t>(size) - 1);
+}
+
+/// Floors \p value to an integer, mapping NaN to 0 and clamping far out-of-range coordinates
+/// (which address identically to the clamped value).
+int64_t FloorToTexel(float value) {
+  if (std::isnan(value)) {
+    return 0;
+  }
+  return static_cast<int64_t>(std::floor(std::clamp(value, -1073741824.0f, 1073741824.0f)));
+}
+
+/// Samples \p texture at normalized (\p u, \p v) with \p filter.
+std::array<float, 4> SampleTexture(const ShaderResource& texture, const SamplerDescriptor& sampler,
+                                   FilterMode filter, float u, float v) {
+  const uint32_t width = texture.textureSize.width;
+  const uint32_t height = texture.textureSize.height;
+  if (width == 0 || height == 0) {
+    return {0.0f, 0.0f, 0.0f, 0.0f};
+  }
+  const float x = u * static_cast<float>(width);
+  const float y = v * static_cast<float>(height);
+
+  if (filter == FilterMode::Nearest) {
+    return FetchTexel(texture, AddressTexel(sampler.addressModeU, FloorToTexel(x), width),
+                      AddressTexel(sampler.addressModeV, FloorToTexel(y), height));
+  }
+
+  const float sampleX = x - 0.5f;
+  const float sampleY = y - 0.5f;
+  const int64_t x0 = FloorToTexel(sampleX);
+  const int64_t y0 = FloorToTexel(sampleY);
+  const float fx = std::isfinite(sampleX) ? sampleX - static_cast<float>(x0) : 0.0f;
+  const float fy = std::isfinite(sampleY) ? sampleY - static_cast<float>(y0) : 0.0f;
+  const int64_t left = AddressTexel(sampler.addressModeU, x0, width);
+  const int64_t right = AddressTexel(sampler.addressModeU, x0 + 1, width);
+  const int64_t top = AddressTexel(sampler.addressModeV, y0, height);
+  const int64_t bottom = AddressTexel(sampler.addressModeV, y0 + 1, height);
+
+  const std::array<float, 4> topLeft = FetchTexel(texture, left, top);
+  const std::array<float, 4> topRight = FetchTexel(texture, right, top);
+  const std::array<float, 4> bottomLeft = FetchTexel(texture, left, bottom);
+  const std::array<float, 4> bottomRight = FetchTexel(texture, right, bottom);
+  std::array<float, 4> result;
+  for (size_t c = 0; c < 4; ++c) {
+    const float upper = topLeft[c] + (topRight[c] - topLeft[c]) * fx;
+    const float lower = bottomLeft[c] + (bottomRight[c] - bottomLeft[c]) * fx;
+    result[c] = upper + (lower - upper) * fy;
+  }
+  return result;
+}
+
+/// Executes lowered functions against one register file.
+class Executor {
+public:
+  Executor(const ShaderProgram::Impl& program, uint32_t* registers,
+           std::span<const ShaderResource> resources, bool quadLanes)
+      : program_(program), registers_(registers), resources_(resources), quadLanes_(quadLanes) {}
+
+  /// Runs \p function for \p activeLanes and returns the lanes that did not discard.
+  /// Expression nodes evaluated so far, excluding register aliases and storage reads.
+  uint64_t operations() const { return operations_; }
+
+  Result<LaneMask> runEntry(const Function& function, LaneMask activeLanes) {
+    Flow flow;
+    currentMask_ = activeLanes;
+    execBlock(function.body, activeLanes, flow, function);
+    if (error_) {
+      return *error_;
+    }
+    return activeLanes & ~flow.discarded;
+  }
+
+private:
+  /// Lanes that left the current function or loop.
+  struct Flow {
+    LaneMask exited = 0;     //!< Returned or discarded.
+    LaneMask discarded = 0;  //!< Discarded.
+    LaneMask broken = 0;     //!< Broke out of the innermost loop.
+    LaneMask continued = 0;  //!< Skipping the rest of the innermost loop body.
+  };
+
+  uint32_t* row(uint32_t word) { return registers_ + static_cast<size_t>(word) * kShaderLaneCount; }
+
+  const Node& node(uint32_t index) const { return program_.nodes[index]; }
+
+  /// Lanes whose bool at \p nodeIndex is true.
+  LaneMask trueLanes(uint32_t nodeIndex) {
+    const uint32_t* values = row(node(nodeIndex).dst);
+    LaneMask mask = 0;
+    for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+      mask |= values[lane] != 0 ? (1u << lane) : 0u;
+    }
+    return mask;
+  }
+
+  void copyWords(uint32_t dst, uint32_t src, uint32_t words, LaneMask mask) {
+    if (dst == src) {
+      return;
+    }
+    if (mask == kAllLanes) {
+      std::memmove(row(dst), row(src), static_cast<size_t>(words) * kShaderLaneCount * 4);
+      return;
+    }
+    for (uint32_t w = 0; w < words; ++w) {
+      const uint32_t* from = row(src + w);
+      uint32_t* to = row(dst + w);
+      for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+        if (mask & (1u << lane)) {
+          to[lane] = from[lane];
+        }
+      }
+    }
+  }
+
+  /// Element index of \p index for \p lane, clamped to the element count when one is known.
+  /// Returns nullopt for a negative index into a runtime-sized array.
+  std::optional<uint64_t> elementIndex(const DynamicIndex& index, uint32_t lane) {
+    const Node& indexNode = node(index.node);
+    const uint32_t bits = row(indexNode.dst)[lane];
+    const int64_t value =
+        indexNode.resultKind == ScalarKind::I32 ? int64_t(AsInt(bits)) : int64_t(bits);
+    if (index.count != 0) {
+      return static_cast<uint64_t>(std::clamp<int64_t>(value, 0, index.count - 1));
+    }
+    if (value < 0) {
+      return std::nullopt;
+    }
+    return static_cast<uint64_t>(value);
+  }
+
+  void execBlock(const std::vector<Stmt>& block, LaneMask mask, Flow& flow,
+                 const Function& function) {
+    for (const Stmt& statement : block) {
+      const LaneMask live = mask & ~(flow.exited | flow.broken | flow.continued);
+      if (live == 0 || error_) {
+        return;
+      }
+      execStmt(statement, live, flow, function);
+    }
+  }
+
+  void execStmt(const Stmt& statement, LaneMask live, Flow& flow, const Function& function) {
+    currentMask_ = live;
+    switch (statement.kind) {
+      case IrStmt::Kind::Let:
+        eval(statement.value);
+        // Let values are immutable, so writing inactive lanes is unobservable.
+        if (statement.copyValue) {
+          copyWords(statement.target, node(statement.value).dst, statement.words, kAllLanes);
+        }
+        return;
+      case IrStmt::Kind::Var:
+        if (statement.value != kNoNode) {
+          eval(statement.value);
+          copyWords(statement.target, node(statement.value).dst, statement.words, live);
+        } else {
+          for (uint32_t w = 0; w < statement.words; ++w) {
+            uint32_t* to = row(statement.target + w);
+            for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+              if (live & (1u << lane)) {
+                to[lane] = 0;
+              }
+            }
+          }
+        }
+        return;
+      case IrStmt::Kind::Assign: execAssign(statement, live); return;
+      case IrStmt::Kind::If: {
+        eval(statement.value);
+        const LaneMask taken = trueLanes(statement.value) & live;
+        if (taken != 0) {
+          execBlock(statement.body, taken, flow, function);
+        }
+        if ((live & ~taken) != 0) {
+          execBlock(statement.elseBody, live & ~taken, flow, function);
+        }
+        return;
+      }
+      case IrStmt::Kind::For: execFor(statement, live, flow, function); return;
+      case IrStmt::Kind::Break: flow.broken |= live; return;
+      case IrStmt::Kind::Continue: flow.continued |= live; return;
+      case IrStmt::Kind::Return:
+        if (!statement.outputValues.empty()) {
+          for (size_t i = 0; i < statement.outputValues.size(); ++i) {
+            eval(statement.outputValues[i]);
+            currentMask_ = live;
+          }
+          for (size_t i = 0; i < statement.outputValues.size(); ++i) {
+            copyWords(function.outputs[i].first, node(statement.outputValues[i]).dst,
+                      function.outputs[i].second, live);
+          }
+        } else if (statement.value != kNoNode) {
+          eval(statement.value);
+          copyWords(statement.target, node(statement.value).dst, statement.words, live);
+        }
+        flow.exited |= live;
+        return;
+      case IrStmt::Kind::Discard:
+        flow.exited |= live;
+        flow.discarded |= live;
+        return;
+    }
+  }
+
+  void execAssign(const Stmt& statement, LaneMask live) {
+    for (const DynamicIndex& index : statement.lvalue.indices) {
+      eval(index.node);
+    }
+    eval(statement.value);
+
+    const uint32_t source = node(statement.value).dst;
+    for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+      if (!(live & (1u << lane))) {
+        continue;
+      }
+      uint64_t target = statement.lvalue.base;
+      for (const DynamicIndex& index : statement.lvalue.indices) {
+        target += *elementIndex(index, lane) * index.stride;
+      }
+      for (uint32_t w = 0; w < statement.words; ++w) {
+        row(static_cast<uint32_t>(target) + w)[lane] = row(source + w)[lane];
+      }
+    }
+  }
+
+  void execFor(const Stmt& statement, LaneMask live, Flow& flow, const Function& function) {
+    const LaneMask outerBroken = flow.broken;
+    const LaneMask outerContinued = flow.continued;
+    flow.broken = 0;
+    flow.continued = 0;
+
+    for (const Stmt& init : statement.init) {
+      execStmt(init, live, flow, function);
+    }
+
+    for (uint32_t iteration = 0;; ++iteration) {
+      LaneMask running = live & ~(flow.exited | flow.broken);
+      if (running != 0 && statement.value != kNoNode) {
+        currentMask_ = running;
+        eval(statement.value);
+        const LaneMask passing = running & trueLanes(statement.value);
+        flow.broken |= running & ~passing;
+        running = passing;
+      }
+      if (running == 0 || error_) {
+        break;
+      }
+      if (iteration == kMaxLoopIterations) {
+        error_ = GpuError{GpuErrorType::LimitExceeded,
+                          std::format("shader loop in '{}' exceeded {} iterations",
+                                      std::string_view(function.name), kMaxLoopIterations)};
+        break;
+      }
+
+      flow.continued = 0;
+      execBlock(statement.body, running, flow, function);
+      flow.continued = 0;
+
+      const LaneMask continuing = running & ~(flow.exited | flow.broken);
+      if (continuing != 0) {
+        for (const Stmt& step : statement.continuing) {
+          execStmt(step, continuing, flow, function);
+        }
+      }
+    }
+
+    flow.broken = outerBroken;
+    flow.continued = outerContinued;
+  }
+
+  void eval(uint32_t nodeIndex) {
+    const Node& current = node(nodeIndex);
+    switch (current.op) {
+      case NodeOp::Storage: return;
+      case NodeOp::Alias: eval(current.children[0]); return;
+      default: break;
+    }
+    ++operations_;
+
+    for (const uint32_t child : current.children) {
+      eval(child);
+    }
+
+    switch (current.op) {
+      case NodeOp::Storage:
+      case NodeOp::Alias: return;
+      case NodeOp::Unary: evalUnary(current); return;
+      case NodeOp::Binary: evalBinary(current); return;
+      case NodeOp::MatrixVector: evalMatrixVector(current); return;
+      case NodeOp::MatrixMatrix: evalMatrixMatrix(current); return;
+      case NodeOp::Swizzle: {
+        const uint32_t base = node(current.children[0]).dst;
+        for (uint32_t w = 0; w < current.words; ++w) {
+          std::memcpy(row(current.dst + w), row(base + current.swizzle[w]),
+                      kShaderLaneCount * sizeof(uint32_t));
+        }
+        return;
+      }
+      case NodeOp::Index: evalIndex(current); return;
+      case NodeOp::Load: evalLoad(current); return;
+      case NodeOp::Construct: {
+        uint32_t word = current.dst;
+        for (const uint32_t child : current.children) {
+          const Node& part = node(child);
+          copyWords(word, part.dst, part.words, kAllLanes);
+          word += part.words;
+        }
+        return;
+      }
+      case NodeOp::Splat: {
+        const uint32_t source = node(current.children[0]).dst;
+        for (uint32_t w = 0; w < current.words; ++w) {
+          std::memcpy(row(current.dst + w), row(source), kShaderLaneCount * sizeof(uint32_t));
+        }
+        return;
+      }
+      case NodeOp::Convert: {
+        const Node& operand = node(current.children[0]);
+        for (uint32_t w = 0; w < current.words; ++w) {
+          const uint32_t* from = row(operand.dst + (operand.words == 1 ? 0 : w));
+          uint32_t* to = row(current.dst + w);
+          for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+            to[lane] = ConvertBits(current.operandKind, current.resultKind, from[lane]);
+          }
+        }
+        return;
+      }
+      case NodeOp::Builtin: evalBuiltin(current); return;
+      case NodeOp::Call: evalCall(current); return;
+    }
+  }
+
+  void evalUnary(const Node& current) {
+    const uint32_t source = node(current.children[0]).dst;
+    for (uint32_t w = 0; w < current.words; ++w) {
+      const uint32_t* from = row(source + w);
+      uint32_t* to = row(current.dst + w);
+      for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+        if (current.unaryOp == IrExpr::UnaryOp::Not) {
+          to[lane] = from[lane] == 0 ? 1u : 0u;
+        } else if (current.operandKind == ScalarKind::F32) {
+          to[lane] = FloatBits(-AsFloat(from[lane]));
+        } else {
+          to[lane] = 0u - from[lane];
+        }
+      }
+    }
+  }
+
+  void evalBinary(const Node& current) {
+    const Node& lhs = node(current.children[0]);
+    const Node& rhs = node(current.children[1]);
+    for (uint32_t w = 0; w < current.words; ++w) {
+      BinaryLanes(current.binaryOp, current.operandKind, row(lhs.dst + (lhs.words == 1 ? 0 : w)),
+                  row(rhs.dst + (rhs.words == 1 ? 0 : w)), row(current.dst + w));
+    }
+  }
+
+  void evalMatrixVector(const Node& current) {
+    const uint32_t matrix = node(current.children[0]).dst;
+    const uint32_t vector = node(current.children[1]).dst;
+    for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+      for (uint32_t r = 0; r < 4; ++r) {
+        float sum = 0.0f;
+        for (uint32_t k = 0; k < 4; ++k) {
+          sum += AsFloat(row(matrix + k * 4 + r)[lane]) * AsFloat(row(vector + k)[lane]);
+        }
+        row(current.dst + r)[lane] = FloatBits(sum);
+      }
+    }
+  }
+
+  void evalMatrixMatrix(const Node& current) {
+    const uint32_t lhs = node(current.children[0]).dst;
+    const uint32_t rhs = node(current.children[1]).dst;
+    for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+      for (uint32_t c = 0; c < 4; ++c) {
+        for (uint32_t r = 0; r < 4; ++r) {
+          float sum = 0.0f;
+          for (uint32_t k = 0; k < 4; ++k) {
+            sum += AsFloat(row(lhs + k * 4 + r)[lane]) * AsFloat(row(rhs + c * 4 + k)[lane]);
+          }
+          row(current.dst + c * 4 + r)[lane] = FloatBits(sum);
+        }
+      }
+    }
+  }
+
+  void evalIndex(const Node& current) {
+    const uint32_t base = node(current.children[0]).dst;
+    const DynamicIndex& index = current.indices[0];
+    for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+      const uint32_t element = static_cast<uint32_t>(*elementIndex(index, lane));
+      for (uint32_t w = 0; w < current.words; ++w) {
+        row(current.dst + w)[lane] = row(base + element * index.stride + w)[lane];
+      }
+    }
+  }
+
+  void evalLoad(const Node& current) {
+    const std::span<const uint8_t> bytes =
+        current.resource < resources_.size() ? resources_[current.resource].bytes
+                                             : std::span<const uint8_t>();
+    for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+      uint64_t offset = current.baseOffset;
+      bool inBounds = true;
+      for (const DynamicIndex& index : current.indices) {
+        const std::optional<uint64_t> element = elementIndex(index, lane);
+        if (!element || *element > bytes.size()) {
+          inBounds = false;
+          break;
+        }
+        offset += *element * index.stride;
+      }
+      inBounds = inBounds && offset <= bytes.size() && current.loadExtent <= bytes.size() - offset;
+
+      for (const auto& [byteOffset, word] : current.loadPlan) {
+        uint32_t value = 0;
+        if (inBounds) {
+          std::memcpy(&value, bytes.data() + offset + byteOffset, sizeof(value));
+        }
+        row(current.dst + word)[lane] = value;
+      }
+    }
+  }
+
+  /// Resource bound to the binding index held by the texture or sampler value at \p nodeIndex.
+  const ShaderResource* resourceOf(uint32_t nodeIndex) {
+    const uint32_t binding = row(node(nodeIndex).dst)[0];
+    return binding < resources_.size() ? &resources_[binding] : nullptr;
+  }
+
+  void evalBuiltin(const Node& current) {
+    const auto arg = [&](size_t i) -> const Node& { return node(current.children[i]); };
+    // Row of component `w` of argument `i`, broadcasting scalar arguments.
+    const auto argRow = [&](size_t i, uint32_t w) {
+      const Node& operand = arg(i);
+      return row(operand.dst + (operand.words == 1 ? 0 : w));
+    };
+    const ScalarKind kind = current.operandKind;
+
+    const auto mapFloat = [&](auto&& fn) {
+      for (uint32_t w = 0; w < current.words; ++w) {
+        const uint32_t* from = argRow(0, w);
+        uint32_t* to = row(current.dst + w);
+        for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+          to[lane] = FloatBits(fn(AsFloat(from[lane])));
+        }
+      }
+    };
+    // Min/max/clamp on any numeric kind, through one comparator per kind.
+    const auto mapOrdered = [&](auto&& fn) {
+      for (uint32_t w = 0; w < current.words; ++w) {
+        uint32_t* to = row(current.dst + w);
+        for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+          const auto value = [&](size_t i) { return argRow(i, w)[lane]; };
+          switch (kind) {
+            case ScalarKind::F32:
+              to[lane] = FloatBits(fn([&](size_t i) { return AsFloat(value(i)); }));
+              break;
+            case ScalarKind::I32:
+              to[lane] = std::bit_cast<uint32_t>(fn([&](size_t i) { return AsInt(value(i)); }));
+              break;
+            default: to[lane] = fn([&](size_t i) { return value(i); }); break;
+          }
+        }
+      }
+    };
+
+    switch (current.builtin) {
+      case BuiltinFn::Abs:
+        if (kind == ScalarKind::F32) {
+          return mapFloat([](float x) { return std::fabs(x); });
+        }
+        for (uint32_t w = 0; w < current.words; ++w) {
+          const uint32_t* from = argRow(0, w);
+          uint32_t* to = row(current.dst + w);
+          for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+            to[lane] = (kind == ScalarKind::I32 && AsInt(from[lane]) < 0) ? 0u - from[lane]
+                                                                          : from[lane];
+          }
+        }
+        return;
+      case BuiltinFn::Min:
+        return mapOrdered([](auto get) { return std::min(get(0), get(1)); });
+      case BuiltinFn::Max:
+        return mapOrdered([](auto get) { return std::max(get(0), get(1)); });
+      case BuiltinFn::Clamp:
+        return mapOrdered([](auto get) { return std::min(std::max(get(0), get(1)), get(2)); });
+      case BuiltinFn::Saturate:
+        return mapFloat([](float x) { return std::min(std::max(x, 0.0f), 1.0f); });
+      case BuiltinFn::Fract: return mapFloat([](float x) { return x - std::floor(x); });
+      case BuiltinFn::Sqrt: return mapFloat([](float x) { return std::sqrt(x); });
+      case BuiltinFn::Round: return mapFloat([](float x) { return std::nearbyint(x); });
+      case BuiltinFn::Length: {
+        const Node& operand = arg(0);
+        uint32_t* to = row(current.dst);
+        for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+          float sum = 0.0f;
+          for (uint32_t w = 0; w < operand.words; ++w) {
+            const float component = AsFloat(row(operand.dst + w)[lane]);
+            sum += component * component;
+          }
+          to[lane] = FloatBits(std::sqrt(sum));
+        }
+        return;
+      }
+      case BuiltinFn::Fwidth: {
+        for (uint32_t w = 0; w < current.words; ++w) {
+          const uint32_t* from = argRow(0, w);
+          uint32_t* to = row(current.dst + w);
+          for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+            if (!quadLanes_) {
+              to[lane] = FloatBits(0.0f);
+              continue;
+            }
+            // Fine derivatives: the horizontal neighbour shares the row, the vertical neighbour
+            // shares the column.
+            const float dx = AsFloat(from[lane | 1u]) - AsFloat(from[lane & ~1u]);
+            const float dy = AsFloat(from[lane | 2u]) - AsFloat(from[lane & ~2u]);
+            to[lane] = FloatBits(std::fabs(dx) + std::fabs(dy));
+          }
+        }
+        return;
+      }
+      case BuiltinFn::Select: {
+        const uint32_t* condition = nullptr;
+        for (uint32_t w = 0; w < current.words; ++w) {
+          condition = argRow(2, w);
+          const uint32_t* whenFalse = argRow(0, w);
+          const uint32_t* whenTrue = argRow(1, w);
+          uint32_t* to = row(current.dst + w);
+          for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+            to[lane] = condition[lane] != 0 ? whenTrue[lane] : whenFalse[lane];
+          }
+        }
+        return;
+      }
+      case BuiltinFn::TextureSample: evalTextureSample(current); return;
+      case BuiltinFn::TextureLoad: {
+        const ShaderResource* texture = resourceOf(current.children[0]);
+        const uint32_t coords = arg(1).dst;
+        const uint32_t* level = row(arg(2).dst);
+        for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+          std::array<float, 4> texel = {0.0f, 0.0f, 0.0f, 0.0f};
+          if (texture != nullptr && level[lane] == 0) {
+            texel = FetchTexel(*texture, AsInt(row(coords)[lane]), AsInt(row(coords + 1)[lane]));
+          }
+          for (uint32_t c = 0; c < 4; ++c) {
+            row(current.dst + c)[lane] = FloatBits(texel[c]);
+          }
+        }
+        return;
+      }
+      case BuiltinFn::TextureDimensions: {
+        const ShaderResource* texture = resourceOf(current.children[0]);
+        for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+          row(current.dst)[lane] = texture != nullptr ? texture->textureSize.width : 0;
+          row(current.dst + 1)[lane] = texture != nullptr ? texture->textureSize.height : 0;
+        }
+        return;
+      }
+    }
+  }
+
+  void evalTextureSample(const Node& current) {
+    const ShaderResource* texture = resourceOf(current.children[0]);
+    const ShaderResource* sampler = resourceOf(current.children[1]);
+    const uint32_t coords = node(current.children[2]).dst;
+    const uint32_t* u = row(coords);
+    const uint32_t* v = row(coords + 1);
+
+    for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+      std::array<float, 4> texel = {0.0f, 0.0f, 0.0f, 0.0f};
+      if (texture != nullptr && sampler != nullptr) {
+        // With a single mip level, the quad's texel footprint only chooses between the
+        // minification and magnification filters.
+        bool minifying = false;
+        if (quadLanes_) {
+          const float width = static_cast<float>(texture->textureSize.width);
+          const float height = static_cast<float>(texture->textureSize.height);
+          const float dudx = (AsFloat(u[lane | 1u]) - AsFloat(u[lane & ~1u])) * width;
+          const float dvdx = (AsFloat(v[lane | 1u]) - AsFloat(v[lane & ~1u])) * height;
+          const float dudy = (AsFloat(u[lane | 2u]) - AsFloat(u[lane & ~2u])) * width;
+          const float dvdy = (AsFloat(v[lane | 2u]) - AsFloat(v[lane & ~2u])) * height;
+          minifying = std::max(dudx * dudx + dvdx * dvdx, dudy * dudy + dvdy * dvdy) > 1.0f;
+        }
+        texel = SampleTexture(*texture, sampler->sampler,
+                              minifying ? sampler->sampler.minFilter : sampler->sampler.magFilter,
+                              AsFloat(u[lane]), AsFloat(v[lane]));
+      }
+      for (uint32_t c = 0; c < 4; ++c) {
+        row(current.dst + c)[lane] = FloatBits(texel[c]);
+      }
+    }
+  }
+
+  void evalCall(const Node& current) {
+    const Function& callee = program_.functions[current.function];
+    for (size_t i = 0; i < callee.params.size() && i < current.children.size(); ++i) {
+      copyWords(callee.params[i].first, node(current.children[i]).dst, callee.params[i].second,
+                kAllLanes);
+    }
+
+    const LaneMask callerMask = currentMask_;
+    Flow flow;
+    execBlock(callee.body, callerMask, flow, callee);
+    currentMask_ = callerMask;
+
+    copyWords(current.dst, callee.returnOffset, callee.returnWords, kAllLanes);
+  }
+
+  const ShaderProgram::Impl& program_;
+  uint32_t* registers_;
+  std::span<const ShaderResource> resources_;
+  bool quadLanes_;
+  uint64_t operations_ = 0;
+  LaneMask currentMask_ = 0;
+  std::optional<GpuError> error_;
+};
+
+}  // namespace
+
+ShaderProgram::ShaderProgram() : impl_(std::make_unique<Impl>()) {}
+
+ShaderProgram::~ShaderProgram() = default;
+
+Result<std::shared_ptr<const ShaderProgram>> ShaderProgram::Compile(
+    const shader::IrModule& module) {
+  std::shared_ptr<ShaderProgram> program(new ShaderProgram());
+  Lowerer lowerer(module, *program->impl_);
+  if (Status status = lowerer.lower(); status.hasError()) {
+    return std::move(status).error();
+  }
+  return std::shared_ptr<const ShaderProgram>(std::move(program));
+}
+
+const std::vector<shader::IrBinding>& ShaderProgram::bindings() const {
+  return impl_->bindings;
+}
+
+const std::vector<ShaderProgram::EntryPoint>& ShaderProgram::entryPoints() const {
+  return impl_->entryPoints;
+}
+
+std::optional<uint32_t> ShaderProgram::findEntryPoint(std::string_view name,
+                                                      shader::StageKind stage) const {
+  for (size_t i = 0; i < impl_->entryPoints.size(); ++i) {
+    const EntryPoint& entryPoint = impl_->entryPoints[i];
+    if (entryPoint.stage == stage && std::string_view(entryPoint.name) == name) {
+      return static_cast<uint32_t>(i);
+    }
+  }
+  return std::nullopt;
+}
+
+ShaderInterpreter::ShaderInterpreter(std::shared_ptr<const ShaderProgram> program)
+    : program_(std::move(program)),
+      registers_(static_cast<size_t>(program_->impl_->registerWords) * kShaderLaneCount, 0) {
+  for (const auto& [word, bits] : program_->impl_->constants) {
+    std::fill_n(registers_.begin() + static_cast<ptrdiff_t>(word) * kShaderLaneCount,
+                kShaderLaneCount, bits);
+  }
+}
+
+std::span<uint32_t> ShaderInterpreter::values(const ShaderStageValue& value) {
+  return std::span<uint32_t>(registers_).subspan(
+      static_cast<size_t>(value.registerOffset) * kShaderLaneCount,
+      static_cast<size_t>(value.componentCount) * kShaderLaneCount);
+}
+
+Result<LaneMask> ShaderInterpreter::run(uint32_t entryPointIndex,
+                                        std::span<const ShaderResource> resources,
+                                        LaneMask activeLanes) {
+  const ShaderProgram::Impl& impl = *program_->impl_;
+  if (entryPointIndex >= impl.entryPoints.size()) {
+    return GpuError{GpuErrorType::InvalidState,
+                    std::format("entry point index {} is out of range ({} entry points)",
+                                entryPointIndex, impl.entryPoints.size())};
+  }
+  if (resources.size() < impl.bindings.size()) {
+    return GpuError{GpuErrorType::InvalidState,
+                    std::format("{} resources supplied for {} shader bindings", resources.size(),
+                                impl.bindings.size())};
+  }
+
+  const Function& function = impl.functions[impl.entryFunctions[entryPointIndex]];
+  Executor executor(impl, registers_.data(), resources, function.stage == StageKind::Fragment);
+  Result<LaneMask> result = executor.runEntry(function, activeLanes & kAllLanes);
+  executedOperations_ += executor.operations();
+  return result;
+}
+
+}  // namespace donner::gpu::software
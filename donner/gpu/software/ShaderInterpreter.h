@@ -0,0 +1,176 @@
+#pragma once
+/// @file
+/// CPU execution of \c donner::gpu::shader IR for the software backend.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "donner/gpu/Descriptors.h"
+#include "donner/gpu/GpuResult.h"
+#include "donner/gpu/shader/IrModule.h"
+
+namespace donner::gpu::software {
+
+/// Number of invocations a \ref ShaderInterpreter executes together: four vertices, or one 2x2
+/// fragment quad (lane `i` covers pixel `(i & 1, i >> 1)` of the quad).
+inline constexpr uint32_t kShaderLaneCount = 4;
+
+/// Bit mask selecting interpreter lanes; bit `i` selects lane `i`.
+using LaneMask = uint32_t;
+
+/// Mask selecting every lane.
+inline constexpr LaneMask kAllLanes = (1u << kShaderLaneCount) - 1;
+
+/// Upper bound on the iterations of one loop execution. A loop that runs longer fails the
+/// invocation with \ref GpuErrorType::LimitExceeded instead of hanging the submitting thread.
+inline constexpr uint32_t kMaxLoopIterations = 1u << 20;
+
+/// A resource bound to one module binding while a stage executes. Only the fields matching the
+/// binding's kind are read.
+struct ShaderResource {
+  std::span<const uint8_t> bytes;  //!< Bound buffer range, or the texture's texel rows.
+  Extent2d textureSize;            //!< Texture extent in texels.
+  uint32_t bytesPerRow = 0;        //!< Distance between texel rows in \ref bytes.
+  TextureFormat textureFormat = TextureFormat::RGBA8Unorm;  //!< Texel format.
+  SamplerDescriptor sampler;  //!< Filtering and addressing, for sampler bindings.
+};
+
+/// One stage input or output of a compiled entry point.
+struct ShaderStageValue {
+  std::optional<uint32_t> location;                    //!< Stage IO location, if located.
+  std::optional<shader::BuiltinInput> builtinInput;    //!< Builtin, for builtin inputs.
+  std::optional<shader::BuiltinOutput> builtinOutput;  //!< Builtin, for builtin outputs.
+  shader::ScalarKind scalarKind = shader::ScalarKind::F32;  //!< Component type.
+  uint32_t componentCount = 1;  //!< Number of 32-bit components (1 for scalars).
+  uint32_t registerOffset = 0;  //!< First register word, internal to the interpreter.
+};
+
+/**
+ * A shader IR module lowered for interpretation.
+ *
+ * Compilation resolves every name to a fixed register range, every resource-rooted member and
+ * index chain to a byte-offset computation against the WGSL host-shareable layout, and every
+ * user call to its callee, so execution does no lookups or allocation. Recursion is impossible
+ * in the IR, so each function owns one static register frame.
+ *
+ * Immutable after \ref Compile; one program may back any number of \ref ShaderInterpreter
+ * instances on any number of threads.
+ */
+class ShaderProgram {
+public:
+  /// A compiled vertex or fragment entry point.
+  struct EntryPoint {
+    RcString name;                           //!< Entry point name.
+    shader::StageKind stage = shader::StageKind::None;  //!< Pipeline stage.
+    std::vector<ShaderStageValue> inputs;    //!< Parameters, in declaration order.
+    std::vector<ShaderStageValue> outputs;   //!< Outputs, in declaration order.
+  };
+
+  /**
+   * Lowers \p module. Fails closed with \ref GpuErrorType::Unsupported for constructs the
+   * interpreter does not implement, so an unsupported program never renders partially.
+   *
+   * @param module Validated IR module.
+   */
+  static Result<std::shared_ptr<const ShaderProgram>> Compile(const shader::IrModule& module);
+
+  /// Destructor.
+  ~ShaderProgram();
+
+  ShaderProgram(const ShaderProgram&) = delete;
+  ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+  /// Module resource bindings, in declaration order. Resources passed to
+  /// \ref ShaderInterpreter::run are indexed the same way.
+  const std::vector<shader::IrBinding>& bindings() const;
+
+  /// Compiled entry points.
+  const std::vector<EntryPoint>& entryPoints() const;
+
+  /**
+   * Returns the index of the entry point named \p name for \p stage, if any.
+   *
+   * @param name Entry point name.
+   * @param stage Required stage.
+   */
+  std::optional<uint32_t> findEntryPoint(std::string_view name, shader::StageKind stage) const;
+
+  /// Lowered functions, expression nodes, and register layout; opaque outside the interpreter.
+  struct Impl;
+
+private:
+  friend class ShaderInterpreter;
+
+  ShaderProgram();
+
+  std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * Executes entry points of one \ref ShaderProgram, \ref kShaderLaneCount invocations at a time.
+ *
+ * Values live in a register file laid out component-major: component `c` of a value for lane
+ * `l` is word `c * kShaderLaneCount + l` of its range, so every operation is a short loop over
+ * lanes that the compiler vectorizes. Control flow is executed with lane masks: both sides of a
+ * divergent branch run with their lanes enabled, loops run until every lane has exited, and
+ * `discard` retires a lane. Expressions are evaluated for all lanes, which keeps quad
+ * neighbours available to `fwidth` and `textureSample` derivatives.
+ *
+ * Fixed-function behavior matches the WGSL rules the GPU backends follow: integer arithmetic
+ * wraps, integer division by zero yields the dividend, float-to-integer conversion saturates,
+ * `round` is half-to-even, out-of-bounds buffer reads and `textureLoad`s return zero, and
+ * out-of-range indices into function-local arrays clamp.
+ *
+ * Not thread-safe; use one interpreter per thread.
+ */
+class ShaderInterpreter {
+public:
+  /**
+   * Creates an interpreter with a zeroed register file for \p program.
+   *
+   * @param program Program to execute.
+   */
+  explicit ShaderInterpreter(std::shared_ptr<const ShaderProgram> program);
+
+  /// Program this interpreter executes.
+  const ShaderProgram& program() const { return *program_; }
+
+  /**
+   * Register words of a stage input or output of this interpreter's program, component-major:
+   * `componentCount * kShaderLaneCount` words. Write inputs before \ref run and read outputs
+   * after it; floats are stored as their bit patterns.
+   *
+   * @param value Input or output of one of the program's entry points.
+   */
+  std::span<uint32_t> values(const ShaderStageValue& value);
+
+  /**
+   * Runs entry point \p entryPointIndex for the lanes in \p activeLanes and returns the lanes
+   * that finished without discarding. Fragment entry points should run with every lane of the
+   * quad active, including helper lanes, so derivatives see real neighbours.
+   *
+   * @param entryPointIndex Index into \ref ShaderProgram::entryPoints.
+   * @param resources One resource per \ref ShaderProgram::bindings entry.
+   * @param activeLanes Lanes to execute.
+   */
+  Result<LaneMask> run(uint32_t entryPointIndex, std::span<const ShaderResource> resources,
+                       LaneMask activeLanes);
+
+  /**
+   * Expression nodes evaluated by \ref run since construction, counting each node once per quad
+   * regardless of how many lanes are active. A cost measure for comparing programs, e.g. before
+   * and after IR optimization.
+   */
+  uint64_t executedOperations() const { return executedOperations_; }
+
+private:
+  std::shared_ptr<const ShaderProgram> program_;
+  std::vector<uint32_t> registers_;
+  uint64_t executedOperations_ = 0;
+};
+
+}  // namespace donner::gpu::software
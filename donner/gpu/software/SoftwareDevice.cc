@@ -0,0 +1,1155 @@
+#include "donner/gpu/software/SoftwareDevice.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "donner/gpu/GpuLimits.h"
+#include "donner/gpu/shader/MslEmitter.h"
+#include "donner/gpu/shader/WgslEmitter.h"
+#include "donner/gpu/software/ShaderInterpreter.h"
+
+namespace donner::gpu::software {
+
+namespace {
+
+using shader::BindingKind;
+using shader::BuiltinInput;
+using shader::BuiltinOutput;
+using shader::ScalarKind;
+using shader::StageKind;
+
+/// Rasterizer coordinates carry 8 fractional bits.
+constexpr int64_t kSubpixelScale = 256;
+
+/// Smallest clip-space w that survives clipping, keeping the perspective divide finite.
+constexpr float kMinClipW = 1e-6f;
+
+/// Words of the clip-space position at the start of every shaded vertex.
+constexpr uint32_t kPositionWords = 4;
+
+/// Ensures \p table covers \p slotIndex and stores \p value there.
+template <typename T>
+void SetSlot(std::vector<T>& table, uint32_t slotIndex, T value) {
+  if (table.size() <= slotIndex) {
+    table.resize(slotIndex + 1);
+  }
+  table[slotIndex] = std::move(value);
+}
+
+/// Returns a pointer to the record stored at \p slotIndex, or nullptr if the slot is empty.
+template <typename Record>
+Record* FindRecord(std::vector<std::optional<Record>>& table, uint32_t slotIndex) {
+  if (slotIndex >= table.size() || !table[slotIndex].has_value()) {
+    return nullptr;
+  }
+  return &table[slotIndex].value();
+}
+
+/// Texel storage of one texture, rows tightly packed.
+struct TextureStorage {
+  Extent2d size;                                     //!< Extent in texels.
+  TextureFormat format = TextureFormat::RGBA8Unorm;  //!< Texel format.
+  uint32_t bytesPerRow = 0;                          //!< Bytes per texel row.
+  std::vector<uint8_t> texels;                       //!< Texel rows.
+};
+
+/// A vertex shader input fed from a vertex buffer attribute.
+struct VertexInput {
+  uint32_t input = 0;        //!< Index into the vertex entry point's inputs.
+  uint32_t buffer = 0;       //!< Pipeline vertex buffer slot.
+  uint32_t offsetBytes = 0;  //!< Attribute offset within one element.
+  VertexFormat format = VertexFormat::Float32x2;  //!< Attribute format.
+};
+
+/// A vertex output consumed by the fragment stage.
+struct Varying {
+  uint32_t output = 0;  //!< Index into the vertex entry point's outputs.
+  uint32_t input = 0;   //!< Index into the fragment entry point's inputs.
+  uint32_t offset = 0;  //!< First word within a shaded vertex.
+  uint32_t words = 0;   //!< Component count.
+  bool flat = false;    //!< Integer varyings are not interpolated.
+};
+
+/// A render pipeline with its stage interface resolved against the shader programs.
+struct PipelineState {
+  std::shared_ptr<const ShaderProgram> vertexProgram;    //!< Vertex stage program.
+  std::shared_ptr<const ShaderProgram> fragmentProgram;  //!< Fragment stage program.
+  uint32_t vertexEntry = 0;                              //!< Vertex entry point index.
+  uint32_t fragmentEntry = 0;                            //!< Fragment entry point index.
+  std::vector<VertexBufferLayout> buffers;               //!< Vertex buffer layouts, by slot.
+  std::vector<VertexInput> vertexInputs;                 //!< Attribute-fed vertex inputs.
+  std::optional<uint32_t> instanceIndexInput;            //!< `instance_index` input, if any.
+  uint32_t positionOutput = 0;                           //!< Clip position output index.
+  std::optional<uint32_t> fragmentPositionInput;         //!< Fragment `position` input, if any.
+  std::vector<Varying> varyings;                         //!< Interpolated stage values.
+  uint32_t vertexWords = kPositionWords;                 //!< Words per shaded vertex.
+  std::vector<ColorTargetState> targets;                 //!< Color targets.
+  std::vector<std::optional<uint32_t>> targetOutputs;    //!< Fragment output per target.
+  PrimitiveTopology topology = PrimitiveTopology::TriangleList;  //!< Primitive topology.
+  CullMode cullMode = CullMode::None;                            //!< Face culling mode.
+};
+
+/// Resource tables, indexed by the base class's slot indices.
+struct ResourceTables {
+  std::vector<std::optional<std::vector<uint8_t>>> buffers;
+  std::vector<std::optional<TextureStorage>> textures;
+  std::vector<std::optional<uint32_t>> textureViewToTexture;
+  std::vector<std::optional<SamplerDescriptor>> samplers;
+  std::vector<std::optional<BindGroupDescriptor>> bindGroups;
+  std::vector<std::shared_ptr<const ShaderProgram>> shaderModules;
+  std::vector<std::optional<PipelineState>> renderPipelines;
+};
+
+/// Returns true if vertex attributes of \p format can feed \p input.
+bool VertexFormatMatches(VertexFormat format, const ShaderStageValue& input) {
+  switch (format) {
+    case VertexFormat::Float32x2:
+      return input.scalarKind == ScalarKind::F32 && input.componentCount == 2;
+    case VertexFormat::Float32x4:
+      return input.scalarKind == ScalarKind::F32 && input.componentCount == 4;
+    case VertexFormat::Uint32:
+      return input.scalarKind == ScalarKind::U32 && input.componentCount == 1;
+  }
+  return false;
+}
+
+/// Converts a float channel to unorm8, rounding to nearest; NaN becomes 0.
+uint8_t ToUnorm8(double value) {
+  if (!(value > 0.0)) {
+    return 0;
+  }
+  return static_cast<uint8_t>(std::lround(std::min(value, 1.0) * 255.0));
+}
+
+/// Reads the texel at (\p x, \p y) of a color attachment as RGBA floats.
+std::array<float, 4> ReadPixel(const TextureStorage& texture, uint32_t x, uint32_t y) {
+  const uint8_t* texel = texture.texels.data() + static_cast<size_t>(y) * texture.bytesPerRow +
+                         static_cast<size_t>(x) * TextureFormatBytesPerTexel(texture.format);
+  constexpr float kScale = 1.0f / 255.0f;
+  switch (texture.format) {
+    case TextureFormat::RGBA8Unorm:
+      return {texel[0] * kScale, texel[1] * kScale, texel[2] * kScale, texel[3] * kScale};
+    case TextureFormat::BGRA8Unorm:
+      return {texel[2] * kScale, texel[1] * kScale, texel[0] * kScale, texel[3] * kScale};
+    case TextureFormat::R8Unorm: return {texel[0] * kScale, 0.0f, 0.0f, 1.0f};
+  }
+  return {0.0f, 0.0f, 0.0f, 0.0f};
+}
+
+/// Writes the channels of \p color selected by \p writeMask to the texel at (\p x, \p y).
+void WritePixel(TextureStorage& texture, uint32_t x, uint32_t y,
+                const std::array<double, 4>& color, ColorWriteMask writeMask) {
+  uint8_t* texel = texture.texels.data() + static_cast<size_t>(y) * texture.bytesPerRow +
+                   static_cast<size_t>(x) * TextureFormatBytesPerTexel(texture.format);
+  const auto store = [&](size_t byte, size_t channel, ColorWriteMask bit) {
+    if (HasAllFlags(writeMask, bit)) {
+      texel[byte] = ToUnorm8(color[channel]);
+    }
+  };
+  switch (texture.format) {
+    case TextureFormat::RGBA8Unorm:
+      store(0, 0, ColorWriteMask::Red);
+      store(1, 1, ColorWriteMask::Green);
+      store(2, 2, ColorWriteMask::Blue);
+      store(3, 3, ColorWriteMask::Alpha);
+      return;
+    case TextureFormat::BGRA8Unorm:
+      store(0, 2, ColorWriteMask::Blue);
+      store(1, 1, ColorWriteMask::Green);
+      store(2, 0, ColorWriteMask::Red);
+      store(3, 3, ColorWriteMask::Alpha);
+      return;
+    case TextureFormat::R8Unorm: store(0, 0, ColorWriteMask::Red); return;
+  }
+}
+
+float ApplyBlendFactor(BlendFactor factor, float value, float srcAlpha) {
+  switch (factor) {
+    case BlendFactor::Zero: return 0.0f;
+    case BlendFactor::One: return value;
+    case BlendFactor::SrcAlpha: return value * srcAlpha;
+    case BlendFactor::OneMinusSrcAlpha: return value * (1.0f - srcAlpha);
+  }
+  return value;
+}
+
+float BlendChannel(const BlendComponent& component, float src, float dst, float srcAlpha) {
+  if (component.operation == BlendOperation::Max) {
+    return std::max(src, dst);
+  }
+  return ApplyBlendFactor(component.srcFactor, src, srcAlpha) +
+         ApplyBlendFactor(component.dstFactor, dst, srcAlpha);
+}
+
+/// Edge function: twice the signed area of (\p a, \p b, \p p), positive when \p p is on the
+/// interior side of a triangle with positive area.
+int64_t EdgeFunction(int64_t ax, int64_t ay, int64_t bx, int64_t by, int64_t px, int64_t py) {
+  return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+/// Executes the render pass commands of one submission against the resource tables.
+class PassExecutor {
+public:
+  explicit PassExecutor(ResourceTables& resources) : resources_(resources) {}
+
+  bool active() const { return active_; }
+
+  Status begin(const RenderPassDescriptor& descriptor) {
+    attachments_.clear();
+    for (size_t i = 0; i < descriptor.colorAttachments.size(); ++i) {
+      const RenderPassColorAttachment& attachment = descriptor.colorAttachments[i];
+      const std::optional<uint32_t>* textureSlot =
+          attachment.view.slotIndex() < resources_.textureViewToTexture.size()
+              ? &resources_.textureViewToTexture[attachment.view.slotIndex()]
+              : nullptr;
+      TextureStorage* texture = (textureSlot != nullptr && textureSlot->has_value())
+                                    ? FindRecord(resources_.textures, **textureSlot)
+                                    : nullptr;
+      if (texture == nullptr) {
+        return GpuError{GpuErrorType::InvalidState,
+                        std::format("render pass attachment {} does not resolve to a texture", i)};
+      }
+
+      if (attachment.loadOp == LoadOp::Clear) {
+        for (uint32_t y = 0; y < texture->size.height; ++y) {
+          for (uint32_t x = 0; x < texture->size.width; ++x) {
+            WritePixel(*texture, x, y, attachment.clearColor, ColorWriteMask::All);
+          }
+        }
+      }
+      attachments_.push_back(Attachment{texture, attachment.storeOp});
+    }
+
+    extent_ = attachments_.front().texture->size;
+    pipeline_ = nullptr;
+    bindGroups_.fill(std::nullopt);
+    vertexBuffers_.fill(std::nullopt);
+    viewport_ = SetViewportCommand{0.0f, 0.0f, static_cast<float>(extent_.width),
+                                   static_cast<float>(extent_.height), 0.0f, 1.0f};
+    scissor_ = SetScissorRectCommand{0, 0, extent_.width, extent_.height};
+    active_ = true;
+    return OkStatus();
+  }
+
+  void end() {
+    for (const Attachment& attachment : attachments_) {
+      // Discarded contents are undefined; zero keeps readback deterministic.
+      if (attachment.storeOp == StoreOp::Discard) {
+        std::fill(attachment.texture->texels.begin(), attachment.texture->texels.end(), 0);
+      }
+    }
+    attachments_.clear();
+    active_ = false;
+  }
+
+  Status setPipeline(uint32_t pipelineSlot) {
+    pipeline_ = FindRecord(resources_.renderPipelines, pipelineSlot);
+    if (pipeline_ == nullptr) {
+      return GpuError{GpuErrorType::InvalidState,
+                      std::format("setPipeline: pipeline slot {} is not live", pipelineSlot)};
+    }
+    return OkStatus();
+  }
+
+  void setBindGroup(uint32_t index, uint32_t bindGroupSlot) { bindGroups_[index] = bindGroupSlot; }
+
+  void setVertexBuffer(const SetVertexBufferCommand& command) {
+    vertexBuffers_[command.slot] = std::make_pair(command.bufferSlot, command.offsetBytes);
+  }
+
+  void setViewport(const SetViewportCommand& command) { viewport_ = command; }
+
+  void setScissor(const SetScissorRectCommand& command) { scissor_ = command; }
+
+  Status draw(const DrawCommand& draw) {
+    if (pipeline_ == nullptr) {
+      return GpuError{GpuErrorType::InvalidState, "draw: no pipeline set"};
+    }
+    const PipelineState& pipeline = *pipeline_;
+
+    if (Status status = bindResources(*pipeline.vertexProgram, vertexResources_);
+        status.hasError()) {
+      return status;
+    }
+    if (Status status = bindResources(*pipeline.fragmentProgram, fragmentResources_);
+        status.hasError()) {
+      return status;
+    }
+    std::array<std::span<const uint8_t>, kMaxVertexBuffers> vertexData;
+    for (uint32_t slot = 0; slot < pipeline.buffers.size(); ++slot) {
+      const std::vector<uint8_t>* buffer =
+          vertexBuffers_[slot] ? FindRecord(resources_.buffers, vertexBuffers_[slot]->first)
+                               : nullptr;
+      if (buffer == nullptr) {
+        return GpuError{GpuErrorType::InvalidState,
+                        std::format("draw: vertex buffer slot {} has no live buffer", slot)};
+      }
+      vertexData[slot] = std::span<const uint8_t>(*buffer);
+    }
+
+    ShaderInterpreter vertexShader(pipeline.vertexProgram);
+    ShaderInterpreter fragmentShader(pipeline.fragmentProgram);
+    vertexShader_ = &vertexShader;
+    fragmentShader_ = &fragmentShader;
+    setClipRect();
+
+    const ShaderProgram::EntryPoint& vertexEntry =
+        pipeline.vertexProgram->entryPoints()[pipeline.vertexEntry];
+    for (uint32_t instance = 0; instance < draw.instanceCount; ++instance) {
+      const uint32_t instanceIndex = draw.firstInstance + instance;
+      vertices_.assign(static_cast<size_t>(draw.vertexCount) * pipeline.vertexWords, 0);
+
+      for (uint32_t base = 0; base < draw.vertexCount; base += kShaderLaneCount) {
+        const uint32_t lanes = std::min(kShaderLaneCount, draw.vertexCount - base);
+        for (const VertexInput& input : pipeline.vertexInputs) {
+          const VertexBufferLayout& layout = pipeline.buffers[input.buffer];
+          const std::span<uint32_t> values = vertexShader.values(vertexEntry.inputs[input.input]);
+          const uint32_t byteSize = VertexFormatByteSize(input.format);
+          for (uint32_t lane = 0; lane < lanes; ++lane) {
+            const uint64_t element = layout.stepMode == VertexStepMode::Vertex
+                                         ? uint64_t(draw.firstVertex) + base + lane
+                                         : uint64_t(instanceIndex);
+            const uint64_t offset = vertexBuffers_[input.buffer]->second +
+                                    element * layout.strideBytes + input.offsetBytes;
+            // Out-of-range vertex fetches read zero, like robust buffer access on the GPU.
+            const std::span<const uint8_t> bytes = vertexData[input.buffer];
+            const bool inRange = offset <= bytes.size() && byteSize <= bytes.size() - offset;
+            for (uint32_t c = 0; c < byteSize / 4; ++c) {
+              uint32_t word = 0;
+              if (inRange) {
+                std::memcpy(&word, bytes.data() + offset + c * 4, sizeof(word));
+              }
+              values[c * kShaderLaneCount + lane] = word;
+            }
+          }
+        }
+        if (pipeline.instanceIndexInput) {
+          const std::span<uint32_t> values =
+              vertexShader.values(vertexEntry.inputs[*pipeline.instanceIndexInput]);
+          std::fill_n(values.begin(), kShaderLaneCount, instanceIndex);
+        }
+
+        Result<LaneMask> ran =
+            vertexShader.run(pipeline.vertexEntry, vertexResources_, (1u << lanes) - 1);
+        if (ran.hasError()) {
+          return std::move(ran).error();
+        }
+
+        const std::span<uint32_t> position =
+            vertexShader.values(vertexEntry.outputs[pipeline.positionOutput]);
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+          uint32_t* vertex = &vertices_[static_cast<size_t>(base + lane) * pipeline.vertexWords];
+          for (uint32_t c = 0; c < kPositionWords; ++c) {
+            vertex[c] = position[c * kShaderLaneCount + lane];
+          }
+          for (const Varying& varying : pipeline.varyings) {
+            const std::span<uint32_t> values =
+                vertexShader.values(vertexEntry.outputs[varying.output]);
+            for (uint32_t c = 0; c < varying.words; ++c) {
+              vertex[varying.offset + c] = values[c * kShaderLaneCount + lane];
+            }
+          }
+        }
+      }
+
+      if (Status status = assemble(draw.vertexCount); status.hasError()) {
+        return status;
+      }
+    }
+    return OkStatus();
+  }
+
+private:
+  /// A color attachment of the current pass.
+  struct Attachment {
+    TextureStorage* texture = nullptr;  //!< Attachment texels.
+    StoreOp storeOp = StoreOp::Store;   //!< Store operation applied at pass end.
+  };
+
+  /// A triangle vertex after the viewport transform.
+  struct ScreenVertex {
+    int64_t x = 0;        //!< Fixed-point x.
+    int64_t y = 0;        //!< Fixed-point y.
+    float z = 0.0f;       //!< Viewport depth.
+    float invW = 0.0f;    //!< 1 / clip w.
+    uint32_t vertex = 0;  //!< Index of the clip-space vertex in `vertices_`.
+  };
+
+  /// Resolves every binding of \p program against the bound bind groups.
+  Status bindResources(const ShaderProgram& program, std::vector<ShaderResource>& out) {
+    out.assign(program.bindings().size(), ShaderResource{});
+    for (size_t i = 0; i < program.bindings().size(); ++i) {
+      const shader::IrBinding& binding = program.bindings()[i];
+      const BindGroupDescriptor* group =
+          binding.group < kMaxBindGroups && bindGroups_[binding.group]
+              ? FindRecord(resources_.bindGroups, *bindGroups_[binding.group])
+              : nullptr;
+      const BindGroupEntry* entry = nullptr;
+      if (group != nullptr) {
+        for (const BindGroupEntry& candidate : group->entries) {
+          if (candidate.binding == binding.binding) {
+            entry = &candidate;
+            break;
+          }
+        }
+      }
+      if (entry == nullptr) {
+        return GpuError{GpuErrorType::InvalidState,
+                        std::format("draw: shader binding (group {}, binding {}) is not bound",
+                                    binding.group, binding.binding)};
+      }
+
+      const auto mismatch = [&] {
+        return GpuError{GpuErrorType::InvalidState,
+                        std::format("draw: shader binding (group {}, binding {}) is bound to "
+                                    "a resource of the wrong kind",
+                                    binding.group, binding.binding)};
+      };
+
+      ShaderResource& resource = out[i];
+      switch (binding.kind) {
+        case BindingKind::UniformBuffer:
+        case BindingKind::ReadOnlyStorageBuffer: {
+          const auto* bufferBinding = std::get_if<BufferBinding>(&entry->resource);
+          const std::vector<uint8_t>* buffer =
+              bufferBinding != nullptr
+                  ? FindRecord(resources_.buffers, bufferBinding->buffer.slotIndex())
+                  : nullptr;
+          if (buffer == nullptr) {
+            return mismatch();
+          }
+          const uint64_t offset = std::min<uint64_t>(bufferBinding->offsetBytes, buffer->size());
+          const uint64_t size =
+              std::min<uint64_t>(bufferBinding->sizeBytes, buffer->size() - offset);
+          resource.bytes = std::span<const uint8_t>(*buffer).subspan(offset, size);
+          break;
+        }
+        case BindingKind::SampledTexture2dF32: {
+          const auto* viewBinding = std::get_if<TextureViewBinding>(&entry->resource);
+          const TextureStorage* texture = nullptr;
+          if (viewBinding != nullptr &&
+              viewBinding->view.slotIndex() < resources_.textureViewToTexture.size()) {
+            if (const std::optional<uint32_t>& slot =
+                    resources_.textureViewToTexture[viewBinding->view.slotIndex()]) {
+              texture = FindRecord(resources_.textures, *slot);
+            }
+          }
+          if (texture == nullptr) {
+            return mismatch();
+          }
+          resource.bytes = texture->texels;
+          resource.textureSize = texture->size;
+          resource.bytesPerRow = texture->bytesPerRow;
+          resource.textureFormat = texture->format;
+          break;
+        }
+        case BindingKind::FilteringSampler: {
+          const auto* samplerBinding = std::get_if<SamplerBinding>(&entry->resource);
+          const SamplerDescriptor* sampler =
+              samplerBinding != nullptr
+                  ? FindRecord(resources_.samplers, samplerBinding->sampler.slotIndex())
+                  : nullptr;
+          if (sampler == nullptr) {
+            return mismatch();
+          }
+          resource.sampler = *sampler;
+          break;
+        }
+      }
+    }
+    return OkStatus();
+  }
+
+  /// Intersects the scissor, viewport, and attachment rectangles into the pixel clip rect.
+  void setClipRect() {
+    clipLeft_ = std::max<int64_t>(scissor_.x, static_cast<int64_t>(std::floor(viewport_.x)));
+    clipTop_ = std::max<int64_t>(scissor_.y, static_cast<int64_t>(std::floor(viewport_.y)));
+    clipRight_ = std::min<int64_t>(
+        {int64_t(scissor_.x) + scissor_.width, int64_t(extent_.width),
+         static_cast<int64_t>(std::ceil(viewport_.x + viewport_.width))});
+    clipBottom_ = std::min<int64_t>(
+        {int64_t(scissor_.y) + scissor_.height, int64_t(extent_.height),
+         static_cast<int64_t>(std::ceil(viewport_.y + viewport_.height))});
+    clipLeft_ = std::max<int64_t>(clipLeft_, 0);
+    clipTop_ = std::max<int64_t>(clipTop_, 0);
+
+    // Guard band: clip x and y only far outside the viewport, where fixed-point coordinates
+    // would overflow; closer geometry is left to the scissor test.
+    guardBand_ =
+        std::max(1.0f, static_cast<float>(kMaxTextureDimension) /
+                           std::max({viewport_.width, viewport_.height, 1.0f}));
+  }
+
+  std::array<float, 4> clipPosition(uint32_t vertex) const {
+    const uint32_t* words = &vertices_[static_cast<size_t>(vertex) * pipeline_->vertexWords];
+    return {std::bit_cast<float>(words[0]), std::bit_cast<float>(words[1]),
+            std::bit_cast<float>(words[2]), std::bit_cast<float>(words[3])};
+  }
+
+  /// Splits the shaded vertices into triangles per the pipeline topology.
+  Status assemble(uint32_t vertexCount) {
+    if (pipeline_->topology == PrimitiveTopology::TriangleList) {
+      for (uint32_t i = 0; i + 2 < vertexCount; i += 3) {
+        if (Status status = clipTriangle(i, i + 1, i + 2); status.hasError()) {
+          return status;
+        }
+      }
+      return OkStatus();
+    }
+
+    // Odd strip triangles swap their last two vertices to keep a consistent winding; the
+    // provoking vertex stays first.
+    for (uint32_t i = 0; i + 2 < vertexCount; ++i) {
+      const bool odd = (i & 1) != 0;
+      if (Status status = clipTriangle(i, odd ? i + 2 : i + 1, odd ? i + 1 : i + 2);
+          status.hasError()) {
+        return status;
+      }
+    }
+    return OkStatus();
+  }
+
+  /// Signed distance of \p position to clip plane \p plane; non-negative is inside.
+  float planeDistance(uint32_t plane, const std::array<float, 4>& position) const {
+    const auto [x, y, z, w] = position;
+    switch (plane) {
+      case 0: return z;
+      case 1: return w - z;
+      case 2: return w - kMinClipW;
+      case 3: return guardBand_ * w - x;
+      case 4: return guardBand_ * w + x;
+      case 5: return guardBand_ * w - y;
+      default: return guardBand_ * w + y;
+    }
+  }
+
+  static constexpr uint32_t kClipPlaneCount = 7;
+
+  /// Clips a triangle against the view volume and rasterizes what remains.
+  Status clipTriangle(uint32_t v0, uint32_t v1, uint32_t v2) {
+    bool inside = true;
+    for (const uint32_t vertex : {v0, v1, v2}) {
+      const std::array<float, 4> position = clipPosition(vertex);
+      for (uint32_t plane = 0; plane < kClipPlaneCount && inside; ++plane) {
+        inside = planeDistance(plane, position) >= 0.0f;
+      }
+    }
+    if (inside) {
+      return rasterize(v0, v1, v2, v0);
+    }
+
+    // Sutherland-Hodgman; new vertices are appended to `vertices_` and dropped afterwards.
+    const size_t vertexStorage = vertices_.size();
+    const uint32_t stride = pipeline_->vertexWords;
+    std::vector<uint32_t> polygon = {v0, v1, v2};
+    std::vector<uint32_t> clipped;
+    for (uint32_t plane = 0; plane < kClipPlaneCount && polygon.size() >= 3; ++plane) {
+      clipped.clear();
+      for (size_t i = 0; i < polygon.size(); ++i) {
+        const uint32_t from = polygon[i];
+        const uint32_t to = polygon[(i + 1) % polygon.size()];
+        const float fromDistance = planeDistance(plane, clipPosition(from));
+        const float toDistance = planeDistance(plane, clipPosition(to));
+        if (fromDistance >= 0.0f) {
+          clipped.push_back(from);
+        }
+        if ((fromDistance >= 0.0f) != (toDistance >= 0.0f)) {
+          // Clip-space values are affine, so linear interpolation here is exact.
+          const float t = fromDistance / (fromDistance - toDistance);
+          const uint32_t created = static_cast<uint32_t>(vertices_.size() / stride);
+          vertices_.resize(vertices_.size() + stride);
+          for (uint32_t w = 0; w < stride; ++w) {
+            const float a = std::bit_cast<float>(vertices_[size_t(from) * stride + w]);
+            const float b = std::bit_cast<float>(vertices_[size_t(to) * stride + w]);
+            vertices_[size_t(created) * stride + w] = std::bit_cast<uint32_t>(a + (b - a) * t);
+          }
+          clipped.push_back(created);
+        }
+      }
+      std::swap(polygon, clipped);
+    }
+
+    Status status = OkStatus();
+    for (size_t i = 1; i + 1 < polygon.size() && !status.hasError(); ++i) {
+      status = rasterize(polygon[0], polygon[i], polygon[i + 1], v0);
+    }
+    vertices_.resize(vertexStorage);
+    return status;
+  }
+
+  /// Rasterizes one clipped triangle; \p provoking supplies flat varyings.
+  Status rasterize(uint32_t v0, uint32_t v1, uint32_t v2, uint32_t provoking) {
+    std::array<ScreenVertex, 3> screen;
+    const std::array<uint32_t, 3> indices = {v0, v1, v2};
+    for (size_t i = 0; i < 3; ++i) {
+      const std::array<float, 4> position = clipPosition(indices[i]);
+      const float invW = 1.0f / position[3];
+      const double sx = viewport_.x + (position[0] * invW + 1.0) * 0.5 * viewport_.width;
+      const double sy = viewport_.y + (1.0 - position[1] * invW) * 0.5 * viewport_.height;
+      screen[i].x = std::llround(sx * kSubpixelScale);
+      screen[i].y = std::llround(sy * kSubpixelScale);
+      screen[i].z =
+          viewport_.minDepth + position[2] * invW * (viewport_.maxDepth - viewport_.minDepth);
+      screen[i].invW = invW;
+      screen[i].vertex = indices[i];
+    }
+
+    int64_t area = EdgeFunction(screen[0].x, screen[0].y, screen[1].x, screen[1].y, screen[2].x,
+                                screen[2].y);
+    if (area == 0) {
+      return OkStatus();
+    }
+    // Framebuffer y points down, so counter-clockwise in NDC is negative area here.
+    const bool frontFacing = area < 0;
+    if (pipeline_->cullMode == CullMode::Back && !frontFacing) {
+      return OkStatus();
+    }
+    if (area < 0) {
+      std::swap(screen[1], screen[2]);
+      area = -area;
+    }
+
+    // Top-left rule: samples exactly on an edge belong to the triangle only for top edges
+    // (horizontal, interior below) and left edges (interior to the right).
+    std::array<int64_t, 3> bias;
+    for (size_t i = 0; i < 3; ++i) {
+      const ScreenVertex& a = screen[(i + 1) % 3];
+      const ScreenVertex& b = screen[(i + 2) % 3];
+      const int64_t dx = b.x - a.x;
+      const int64_t dy = b.y - a.y;
+      const bool topLeft = (dy == 0 && dx > 0) || dy < 0;
+      bias[i] = topLeft ? 0 : 1;
+    }
+
+    const auto [minX, maxX] = std::minmax({screen[0].x, screen[1].x, screen[2].x});
+    const auto [minY, maxY] = std::minmax({screen[0].y, screen[1].y, screen[2].y});
+    const auto firstPixel = [](int64_t fixed) {
+      return static_cast<int64_t>(
+          std::floor(static_cast<double>(fixed - kSubpixelScale / 2) / kSubpixelScale));
+    };
+    int64_t left = std::max(firstPixel(minX), clipLeft_);
+    int64_t top = std::max(firstPixel(minY), clipTop_);
+    const int64_t right = std::min(firstPixel(maxX) + 1, clipRight_);
+    const int64_t bottom = std::min(firstPixel(maxY) + 1, clipBottom_);
+    if (left >= right || top >= bottom) {
+      return OkStatus();
+    }
+    // Walk whole 2x2 quads so fragment derivatives see their neighbours.
+    left &= ~int64_t(1);
+    top &= ~int64_t(1);
+
+    const double invArea = 1.0 / static_cast<double>(area);
+    for (int64_t quadY = top; quadY < bottom; quadY += 2) {
+      for (int64_t quadX = left; quadX < right; quadX += 2) {
+        QuadCoverage quad;
+        for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+          const int64_t px = quadX + (lane & 1);
+          const int64_t py = quadY + (lane >> 1);
+          const int64_t sampleX = px * kSubpixelScale + kSubpixelScale / 2;
+          const int64_t sampleY = py * kSubpixelScale + kSubpixelScale / 2;
+          bool covered = px >= clipLeft_ && px < clipRight_ && py >= clipTop_ && py < clipBottom_;
+          for (size_t i = 0; i < 3; ++i) {
+            const ScreenVertex& a = screen[(i + 1) % 3];
+            const ScreenVertex& b = screen[(i + 2) % 3];
+            const int64_t edge = EdgeFunction(a.x, a.y, b.x, b.y, sampleX, sampleY);
+            covered = covered && edge - bias[i] >= 0;
+            quad.weights[lane][i] = static_cast<float>(static_cast<double>(edge) * invArea);
+          }
+          quad.covered |= covered ? (1u << lane) : 0u;
+        }
+        if (quad.covered == 0) {
+          continue;
+        }
+        quad.x = quadX;
+        quad.y = quadY;
+        if (Status status = shadeQuad(quad, screen, provoking); status.hasError()) {
+          return status;
+        }
+      }
+    }
+    return OkStatus();
+  }
+
+  /// Coverage and barycentric weights of one 2x2 quad.
+  struct QuadCoverage {
+    int64_t x = 0;                                    //!< Left pixel of the quad.
+    int64_t y = 0;                                    //!< Top pixel of the quad.
+    LaneMask covered = 0;                             //!< Lanes whose sample is covered.
+    std::array<std::array<float, 3>, 4> weights = {};  //!< Screen-space barycentrics per lane.
+  };
+
+  Status shadeQuad(const QuadCoverage& quad, const std::array<ScreenVertex, 3>& screen,
+                   uint32_t provoking) {
+    const PipelineState& pipeline = *pipeline_;
+    const ShaderProgram::EntryPoint& entry =
+        pipeline.fragmentProgram->entryPoints()[pipeline.fragmentEntry];
+    const uint32_t stride = pipeline.vertexWords;
+
+    // Perspective-correct weights for interpolated varyings.
+    std::array<std::array<float, 3>, 4> perspective;
+    for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+      float sum = 0.0f;
+      for (size_t i = 0; i < 3; ++i) {
+        perspective[lane][i] = quad.weights[lane][i] * screen[i].invW;
+        sum += perspective[lane][i];
+      }
+      for (size_t i = 0; i < 3; ++i) {
+        perspective[lane][i] = sum != 0.0f ? perspective[lane][i] / sum : quad.weights[lane][i];
+      }
+    }
+
+    if (pipeline.fragmentPositionInput) {
+      const std::span<uint32_t> values =
+          fragmentShader_->values(entry.inputs[*pipeline.fragmentPositionInput]);
+      for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+        const std::array<float, 3>& b = quad.weights[lane];
+        const float position[4] = {
+            static_cast<float>(quad.x + (lane & 1)) + 0.5f,
+            static_cast<float>(quad.y + (lane >> 1)) + 0.5f,
+            b[0] * screen[0].z + b[1] * screen[1].z + b[2] * screen[2].z,
+            b[0] * screen[0].invW + b[1] * screen[1].invW + b[2] * screen[2].invW,
+        };
+        for (uint32_t c = 0; c < 4; ++c) {
+          values[c * kShaderLaneCount + lane] = std::bit_cast<uint32_t>(position[c]);
+        }
+      }
+    }
+
+    for (const Varying& varying : pipeline.varyings) {
+      const std::span<uint32_t> values = fragmentShader_->values(entry.inputs[varying.input]);
+      for (uint32_t c = 0; c < varying.words; ++c) {
+        const size_t word = varying.offset + c;
+        for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+          if (varying.flat) {
+            values[c * kShaderLaneCount + lane] = vertices_[size_t(provoking) * stride + word];
+            continue;
+          }
+          float value = 0.0f;
+          for (size_t i = 0; i < 3; ++i) {
+            value += perspective[lane][i] *
+                     std::bit_cast<float>(vertices_[size_t(screen[i].vertex) * stride + word]);
+          }
+          values[c * kShaderLaneCount + lane] = std::bit_cast<uint32_t>(value);
+        }
+      }
+    }
+
+    // Helper lanes run too, so derivatives are defined; only covered survivors write.
+    Result<LaneMask> survivors =
+        fragmentShader_->run(pipeline.fragmentEntry, fragmentResources_, kAllLanes);
+    if (survivors.hasError()) {
+      return std::move(survivors).error();
+    }
+    const LaneMask writeMask = quad.covered & survivors.result();
+
+    for (size_t target = 0; target < pipeline.targets.size(); ++target) {
+      if (!pipeline.targetOutputs[target] || target >= attachments_.size()) {
+        continue;
+      }
+      const ColorTargetState& state = pipeline.targets[target];
+      const ShaderStageValue& output = entry.outputs[*pipeline.targetOutputs[target]];
+      const std::span<uint32_t> values = fragmentShader_->values(output);
+      TextureStorage& texture = *attachments_[target].texture;
+
+      for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+        if (!(writeMask & (1u << lane))) {
+          continue;
+        }
+        const uint32_t px = static_cast<uint32_t>(quad.x + (lane & 1));
+        const uint32_t py = static_cast<uint32_t>(quad.y + (lane >> 1));
+
+        std::array<float, 4> src = {0.0f, 0.0f, 0.0f, 1.0f};
+        for (uint32_t c = 0; c < std::min<uint32_t>(output.componentCount, 4); ++c) {
+          const float value = std::bit_cast<float>(values[c * kShaderLaneCount + lane]);
+          src[c] = std::isnan(value) ? 0.0f : std::clamp(value, 0.0f, 1.0f);
+        }
+
+        std::array<double, 4> color = {src[0], src[1], src[2], src[3]};
+        if (state.blend) {
+          const std::array<float, 4> dst = ReadPixel(texture, px, py);
+          for (size_t c = 0; c < 3; ++c) {
+            color[c] = BlendChannel(state.blend->color, src[c], dst[c], src[3]);
+          }
+          color[3] = BlendChannel(state.blend->alpha, src[3], dst[3], src[3]);
+        }
+        WritePixel(texture, px, py, color, state.writeMask);
+      }
+    }
+    return OkStatus();
+  }
+
+  ResourceTables& resources_;
+  bool active_ = false;
+  std::vector<Attachment> attachments_;
+  Extent2d extent_;
+  const PipelineState* pipeline_ = nullptr;
+  std::array<std::optional<uint32_t>, kMaxBindGroups> bindGroups_;
+  std::array<std::optional<std::pair<uint32_t, uint64_t>>, kMaxVertexBuffers> vertexBuffers_;
+  SetViewportCommand viewport_;
+  SetScissorRectCommand scissor_;
+
+  // Per-draw state.
+  std::vector<ShaderResource> vertexResources_;
+  std::vector<ShaderResource> fragmentResources_;
+  ShaderInterpreter* vertexShader_ = nullptr;
+  ShaderInterpreter* fragmentShader_ = nullptr;
+  std::vector<uint32_t> vertices_;
+  int64_t clipLeft_ = 0;
+  int64_t clipTop_ = 0;
+  int64_t clipRight_ = 0;
+  int64_t clipBottom_ = 0;
+  float guardBand_ = 1.0f;
+};
+
+}  // namespace
+
+struct SoftwareDevice::Impl {
+  ResourceTables resources;
+  /// Registered programs by emitted source text (WGSL and MSL both map to the program).
+  std::unordered_map<std::string, std::shared_ptr<const ShaderProgram>> programsBySource;
+};
+
+SoftwareDevice::SoftwareDevice() : impl_(std::make_unique<Impl>()) {}
+
+SoftwareDevice::~SoftwareDevice() = default;
+
+Status SoftwareDevice::registerShaderProgram(const shader::IrModule& module) {
+  Result<std::shared_ptr<const ShaderProgram>> program = ShaderProgram::Compile(module);
+  if (program.hasError()) {
+    return std::move(program).error();
+  }
+
+  shader::ShaderResult<std::string> wgsl = shader::EmitWgsl(module);
+  if (wgsl.hasError()) {
+    return GpuError{GpuErrorType::InvalidDescriptor,
+                    std::format("registerShaderProgram: WGSL emission failed: {}",
+                                wgsl.error().message)};
+  }
+  shader::ShaderResult<std::string> msl = shader::EmitMsl(module);
+  if (msl.hasError()) {
+    return GpuError{GpuErrorType::InvalidDescriptor,
+                    std::format("registerShaderProgram: MSL emission failed: {}",
+                                msl.error().message)};
+  }
+
+  impl_->programsBySource[std::move(wgsl).result()] = program.result();
+  impl_->programsBySource[std::move(msl).result()] = program.result();
+  return OkStatus();
+}
+
+Result<std::vector<uint8_t>> SoftwareDevice::readBackBuffer(const Buffer& buffer) {
+  if (Status status = validateBufferHandleForBackend(buffer); status.hasError()) {
+    return std::move(status).error();
+  }
+  const std::vector<uint8_t>* bytes = FindRecord(impl_->resources.buffers, buffer.slotIndex());
+  if (bytes == nullptr) {
+    return GpuError{GpuErrorType::InvalidHandle,
+                    std::format("buffer handle (slot {}) does not name a live buffer",
+                                buffer.slotIndex())};
+  }
+  return *bytes;
+}
+
+Status SoftwareDevice::onCreateBuffer(uint32_t slotIndex, const BufferDescriptor& descriptor) {
+  SetSlot(impl_->resources.buffers, slotIndex,
+          std::optional<std::vector<uint8_t>>(std::vector<uint8_t>(descriptor.byteSize, 0)));
+  return OkStatus();
+}
+
+Status SoftwareDevice::onCreateTexture(uint32_t slotIndex, const TextureDescriptor& descriptor) {
+  TextureStorage texture;
+  texture.size = descriptor.size;
+  texture.format = descriptor.format;
+  texture.bytesPerRow = descriptor.size.width * TextureFormatBytesPerTexel(descriptor.format);
+  texture.texels.assign(static_cast<size_t>(texture.bytesPerRow) * descriptor.size.height, 0);
+  SetSlot(impl_->resources.textures, slotIndex, std::optional<TextureStorage>(std::move(texture)));
+  return OkStatus();
+}
+
+Status SoftwareDevice::onCreateTextureView(uint32_t slotIndex, uint32_t textureSlotIndex,
+                                           const TextureViewDescriptor& descriptor) {
+  (void)descriptor;
+  SetSlot(impl_->resources.textureViewToTexture, slotIndex,
+          std::optional<uint32_t>(textureSlotIndex));
+  return OkStatus();
+}
+
+Status SoftwareDevice::onCreateSampler(uint32_t slotIndex, const SamplerDescriptor& descriptor) {
+  SetSlot(impl_->resources.samplers, slotIndex, std::optional<SamplerDescriptor>(descriptor));
+  return OkStatus();
+}
+
+Status SoftwareDevice::onCreateBindGroupLayout(uint32_t slotIndex,
+                                               const BindGroupLayoutDescriptor& descriptor) {
+  // Bind groups are matched to shader bindings by index at draw time; the layout itself is only
+  // needed by the base class's validation.
+  (void)slotIndex;
+  (void)descriptor;
+  return OkStatus();
+}
+
+Status SoftwareDevice::onCreateBindGroup(uint32_t slotIndex,
+                                         const BindGroupDescriptor& descriptor) {
+  SetSlot(impl_->resources.bindGroups, slotIndex, std::optional<BindGroupDescriptor>(descriptor));
+  return OkStatus();
+}
+
+Status SoftwareDevice::onCreatePipelineLayout(uint32_t slotIndex,
+                                              const PipelineLayoutDescriptor& descriptor) {
+  (void)slotIndex;
+  (void)descriptor;
+  return OkStatus();
+}
+
+Status SoftwareDevice::onCreateShaderModule(uint32_t slotIndex,
+                                            const ShaderModuleDescriptor& descriptor) {
+  const auto it =
+      impl_->programsBySource.find(std::string(std::string_view(descriptor.sourceText)));
+  if (it == impl_->programsBySource.end()) {
+    return GpuError{GpuErrorType::Unsupported,
+                    std::format("shader module '{}': the software backend executes registered "
+                                "shader IR only; call registerShaderProgram with the module's IR "
+                                "first",
+                                std::string_view(descriptor.label))};
+  }
+  SetSlot(impl_->resources.shaderModules, slotIndex, it->second);
+  return OkStatus();
+}
+
+Status SoftwareDevice::onCreateRenderPipeline(uint32_t slotIndex,
+                                              const RenderPipelineDescriptor& descriptor) {
+  ResourceTables& resources = impl_->resources;
+  const auto program = [&](const ShaderModuleRef& module) -> std::shared_ptr<const ShaderProgram> {
+    return module.slotIndex() < resources.shaderModules.size()
+               ? resources.shaderModules[module.slotIndex()]
+               : nullptr;
+  };
+  const auto invalid = [&](std::string message) {
+    return GpuError{GpuErrorType::InvalidDescriptor,
+                    std::format("render pipeline '{}': {}", std::string_view(descriptor.label),
+                                message)};
+  };
+
+  PipelineState record;
+  record.vertexProgram = program(descriptor.vertex.module);
+  record.fragmentProgram = program(descriptor.fragment.module);
+  if (record.vertexProgram == nullptr || record.fragmentProgram == nullptr) {
+    return GpuError{GpuErrorType::InvalidState,
+                    std::format("render pipeline '{}': shader module has no program",
+                                std::string_view(descriptor.label))};
+  }
+
+  const std::optional<uint32_t> vertexEntry =
+      record.vertexProgram->findEntryPoint(descriptor.vertex.entryPoint, StageKind::Vertex);
+  const std::optional<uint32_t> fragmentEntry =
+      record.fragmentProgram->findEntryPoint(descriptor.fragment.entryPoint, StageKind::Fragment);
+  if (!vertexEntry || !fragmentEntry) {
+    return invalid(std::format("entry points '{}' (vertex) and '{}' (fragment) must exist",
+                               std::string_view(descriptor.vertex.entryPoint),
+                               std::string_view(descriptor.fragment.entryPoint)));
+  }
+  record.vertexEntry = *vertexEntry;
+  record.fragmentEntry = *fragmentEntry;
+  const ShaderProgram::EntryPoint& vertex = record.vertexProgram->entryPoints()[*vertexEntry];
+  const ShaderProgram::EntryPoint& fragment =
+      record.fragmentProgram->entryPoints()[*fragmentEntry];
+
+  record.buffers = descriptor.vertex.buffers;
+  for (uint32_t i = 0; i < vertex.inputs.size(); ++i) {
+    const ShaderStageValue& input = vertex.inputs[i];
+    if (input.builtinInput == BuiltinInput::InstanceIndex) {
+      record.instanceIndexInput = i;
+      continue;
+    }
+    if (!input.location) {
+      return invalid(std::format("vertex input {} has no location", i));
+    }
+
+    bool found = false;
+    for (uint32_t buffer = 0; buffer < descriptor.vertex.buffers.size() && !found; ++buffer) {
+      for (const VertexAttribute& attribute : descriptor.vertex.buffers[buffer].attributes) {
+        if (attribute.shaderLocation != *input.location) {
+          continue;
+        }
+        if (!VertexFormatMatches(attribute.format, input)) {
+          return invalid(std::format(
+              "vertex attribute format does not match the input at location {}",
+              *input.location));
+        }
+        record.vertexInputs.push_back(
+            VertexInput{i, buffer, attribute.offsetBytes, attribute.format});
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return invalid(std::format("vertex input location {} has no attribute", *input.location));
+    }
+  }
+
+  std::optional<uint32_t> positionOutput;
+  for (uint32_t i = 0; i < vertex.outputs.size(); ++i) {
+    if (vertex.outputs[i].builtinOutput == BuiltinOutput::Position) {
+      positionOutput = i;
+    }
+  }
+  if (!positionOutput) {
+    return invalid("vertex entry point has no position output");
+  }
+  record.positionOutput = *positionOutput;
+
+  for (uint32_t i = 0; i < fragment.inputs.size(); ++i) {
+    const ShaderStageValue& input = fragment.inputs[i];
+    if (input.builtinInput == BuiltinInput::Position) {
+      record.fragmentPositionInput = i;
+      continue;
+    }
+
+    std::optional<uint32_t> output;
+    for (uint32_t o = 0; o < vertex.outputs.size(); ++o) {
+      if (input.location && vertex.outputs[o].location == input.location) {
+        output = o;
+      }
+    }
+    if (!output || vertex.outputs[*output].scalarKind != input.scalarKind ||
+        vertex.outputs[*output].componentCount != input.componentCount) {
+      return invalid(std::format("fragment input {} has no matching vertex output", i));
+    }
+    record.varyings.push_back(Varying{*output, i, record.vertexWords, input.componentCount,
+                                      input.scalarKind != ScalarKind::F32});
+    record.vertexWords += input.componentCount;
+  }
+
+  record.targets = descriptor.fragment.targets;
+  for (uint32_t target = 0; target < record.targets.size(); ++target) {
+    std::optional<uint32_t> output;
+    for (uint32_t o = 0; o < fragment.outputs.size(); ++o) {
+      if (fragment.outputs[o].location == target) {
+        output = o;
+      }
+    }
+    if (output && fragment.outputs[*output].scalarKind != ScalarKind::F32) {
+      return invalid(std::format("fragment output for target {} is not floating point", target));
+    }
+    record.targetOutputs.push_back(output);
+  }
+  record.topology = descriptor.topology;
+  record.cullMode = descriptor.cullMode;
+
+  SetSlot(resources.renderPipelines, slotIndex,
+          std::optional<PipelineState>(std::move(record)));
+  return OkStatus();
+}
+
+void SoftwareDevice::onDestroyResource(std::string_view resourceName, uint32_t slotIndex) {
+  ResourceTables& resources = impl_->resources;
+  if (resourceName == "buffer") {
+    SetSlot(resources.buffers, slotIndex, std::optional<std::vector<uint8_t>>());
+  } else if (resourceName == "texture") {
+    SetSlot(resources.textures, slotIndex, std::optional<TextureStorage>());
+  } else if (resourceName == "textureView") {
+    SetSlot(resources.textureViewToTexture, slotIndex, std::optional<uint32_t>());
+  } else if (resourceName == "sampler") {
+    SetSlot(resources.samplers, slotIndex, std::optional<SamplerDescriptor>());
+  } else if (resourceName == "bindGroup") {
+    SetSlot(resources.bindGroups, slotIndex, std::optional<BindGroupDescriptor>());
+  } else if (resourceName == "shaderModule") {
+    SetSlot(resources.shaderModules, slotIndex, std::shared_ptr<const ShaderProgram>());
+  } else if (resourceName == "renderPipeline") {
+    SetSlot(resources.renderPipelines, slotIndex, std::optional<PipelineState>());
+  }
+}
+
+Status SoftwareDevice::onWriteBuffer(uint32_t slotIndex, uint64_t offsetBytes,
+                                     std::span<const uint8_t> data) {
+  std::vector<uint8_t>* buffer = FindRecord(impl_->resources.buffers, slotIndex);
+  if (buffer == nullptr) {
+    return GpuError{GpuErrorType::InvalidState,
+                    std::format("buffer slot {} has no storage", slotIndex)};
+  }
+  std::copy(data.begin(), data.end(), buffer->begin() + static_cast<ptrdiff_t>(offsetBytes));
+  return OkStatus();
+}
+
+Status SoftwareDevice::onWriteTexture(uint32_t slotIndex, std::span<const uint8_t> data,
+                                      const TexelCopyBufferLayout& dataLayout,
+                                      const Extent2d& writeSize) {
+  TextureStorage* texture = FindRecord(impl_->resources.textures, slotIndex);
+  if (texture == nullptr) {
+    return GpuError{GpuErrorType::InvalidState,
+                    std::format("texture slot {} has no storage", slotIndex)};
+  }
+  const size_t rowBytes =
+      static_cast<size_t>(writeSize.width) * TextureFormatBytesPerTexel(texture->format);
+  for (uint32_t y = 0; y < writeSize.height; ++y) {
+    const uint8_t* row =
+        data.data() + dataLayout.offsetBytes + static_cast<size_t>(y) * dataLayout.bytesPerRow;
+    std::memcpy(texture->texels.data() + static_cast<size_t>(y) * texture->bytesPerRow, row,
+                rowBytes);
+  }
+  return OkStatus();
+}
+
+Status SoftwareDevice::onSubmit(uint64_t submissionSerial, uint32_t commandBufferSlotIndex,
+                                std::span<const Command> commands) {
+  (void)submissionSerial;
+  (void)commandBufferSlotIndex;
+
+  ResourceTables& resources = impl_->resources;
+  PassExecutor pass(resources);
+  for (const Command& command : commands) {
+    Status status = OkStatus();
+    if (const auto* beginPass = std::get_if<BeginRenderPassCommand>(&command)) {
+      status = pass.begin(beginPass->descriptor);
+    } else if (const auto* setPipeline = std::get_if<SetPipelineCommand>(&command)) {
+      status = pass.setPipeline(setPipeline->pipelineSlot);
+    } else if (const auto* setBindGroup = std::get_if<SetBindGroupCommand>(&command)) {
+      pass.setBindGroup(setBindGroup->index, setBindGroup->bindGroupSlot);
+    } else if (const auto* setVertexBuffer = std::get_if<SetVertexBufferCommand>(&command)) {
+      pass.setVertexBuffer(*setVertexBuffer);
+    } else if (const auto* setScissor = std::get_if<SetScissorRectCommand>(&command)) {
+      pass.setScissor(*setScissor);
+    } else if (const auto* setViewport = std::get_if<SetViewportCommand>(&command)) {
+      pass.setViewport(*setViewport);
+    } else if (const auto* draw = std::get_if<DrawCommand>(&command)) {
+      status = pass.draw(*draw);
+    } else if (std::holds_alternative<EndRenderPassCommand>(command)) {
+      pass.end();
+    } else if (const auto* copy = std::get_if<CopyTextureToBufferCommand>(&command)) {
+      const TextureStorage* texture = FindRecord(resources.textures, copy->textureSlot);
+      std::vector<uint8_t>* buffer = FindRecord(resources.buffers, copy->bufferSlot);
+      if (texture == nullptr || buffer == nullptr) {
+        status = GpuError{GpuErrorType::InvalidState,
+                          "copyTextureToBuffer: source or destination is not live"};
+      } else {
+        const size_t rowBytes =
+            static_cast<size_t>(copy->copySize.width) * TextureFormatBytesPerTexel(texture->format);
+        for (uint32_t y = 0; y < copy->copySize.height; ++y) {
+          std::memcpy(buffer->data() + copy->layout.offsetBytes +
+                          static_cast<size_t>(y) * copy->layout.bytesPerRow,
+                      texture->texels.data() + static_cast<size_t>(y) * texture->bytesPerRow,
+                      rowBytes);
+        }
+      }
+    }
+
+    if (status.hasError()) {
+      return status;
+    }
+  }
+
+  if (pass.active()) {
+    pass.end();
+  }
+  return OkStatus();
+}
+
+}  // namespace donner::gpu::software
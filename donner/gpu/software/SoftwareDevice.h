@@ -0,0 +1,99 @@
+#pragma once
+/// @file
+/// \c donner::gpu::software::SoftwareDevice - the CPU backend for the Donner GPU runtime.
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "donner/gpu/Device.h"
+#include "donner/gpu/shader/IrModule.h"
+
+namespace donner::gpu::software {
+
+/**
+ * CPU backend of the Donner GPU runtime: executes \ref donner::gpu::Device render pipelines on
+ * hosts without a GPU, such as CI machines and headless servers.
+ *
+ * Only pipelines whose shaders are authored in the shader IR can run. Today that is the
+ * solid-fill program from \ref shader::programs::BuildSolidFillModule, the IR form of Geode's
+ * `slug_fill.wgsl`. RendererGeode itself does not go through this runtime: it drives
+ * `wgpu::Device` directly with its WGSL sources, so the renderer as a whole cannot run here, and
+ * comparing it against tiny-skia waits on the rest of its pipelines being lowered to the IR.
+ *
+ * Inherits every fail-closed validation check from \ref donner::gpu::Device. Shaders run through
+ * \ref ShaderInterpreter straight from the shader IR: modules reach backends as emitted source,
+ * so the IR behind each module is registered first with \ref registerShaderProgram, and
+ * shader module creation resolves the module by its exact emitted WGSL or MSL text. Unregistered
+ * source fails closed with \ref GpuErrorType::Unsupported.
+ *
+ * Rasterization follows the rules the GPU backends implement:
+ * - Triangles are clipped to the view volume (with a guard band in x and y), then rasterized
+ *   with 8 bits of subpixel precision, sampling at pixel centres, with the top-left fill rule.
+ * - Counter-clockwise triangles (in normalized device coordinates) are front-facing.
+ * - The first vertex of each triangle provokes flat (integer) varyings; float varyings are
+ *   interpolated perspective-correctly.
+ * - Fragments run one 2x2 quad at a time, with uncovered helper lanes, so derivatives match.
+ * - Blending runs in float on values clamped to [0, 1]; results round to the nearest unorm8.
+ *
+ * Submission executes synchronously, so \ref completedSerial always equals
+ * \ref Device::lastSubmittedSerial. Single-threaded, like every \ref donner::gpu::Device.
+ */
+class SoftwareDevice final : public Device {
+public:
+  /// Constructs an empty device with no registered shader programs.
+  SoftwareDevice();
+
+  /// Destructor; frees all remaining resources.
+  ~SoftwareDevice() override;
+
+  /// Serial of the most recent submission; software submission completes before returning.
+  uint64_t completedSerial() const override { return lastSubmittedSerial(); }
+
+  /**
+   * Compiles \p module for interpretation and registers it under its emitted WGSL and MSL text,
+   * so shader modules created from either source resolve to it. Registering a module again
+   * replaces the previous registration.
+   *
+   * @param module Validated IR module.
+   */
+  Status registerShaderProgram(const shader::IrModule& module);
+
+  /**
+   * Copies the full contents of \p buffer back to the host and returns the bytes. Submissions
+   * complete synchronously, so every submitted write and copy is visible.
+   *
+   * @param buffer Buffer to read back; must be a live buffer of this device.
+   */
+  Result<std::vector<uint8_t>> readBackBuffer(const Buffer& buffer);
+
+protected:
+  Status onCreateBuffer(uint32_t slotIndex, const BufferDescriptor& descriptor) override;
+  Status onCreateTexture(uint32_t slotIndex, const TextureDescriptor& descriptor) override;
+  Status onCreateTextureView(uint32_t slotIndex, uint32_t textureSlotIndex,
+                             const TextureViewDescriptor& descriptor) override;
+  Status onCreateSampler(uint32_t slotIndex, const SamplerDescriptor& descriptor) override;
+  Status onCreateBindGroupLayout(uint32_t slotIndex,
+                                 const BindGroupLayoutDescriptor& descriptor) override;
+  Status onCreateBindGroup(uint32_t slotIndex, const BindGroupDescriptor& descriptor) override;
+  Status onCreatePipelineLayout(uint32_t slotIndex,
+                                const PipelineLayoutDescriptor& descriptor) override;
+  Status onCreateShaderModule(uint32_t slotIndex,
+                              const ShaderModuleDescriptor& descriptor) override;
+  Status onCreateRenderPipeline(uint32_t slotIndex,
+                                const RenderPipelineDescriptor& descriptor) override;
+  void onDestroyResource(std::string_view resourceName, uint32_t slotIndex) override;
+  Status onWriteBuffer(uint32_t slotIndex, uint64_t offsetBytes,
+                       std::span<const uint8_t> data) override;
+  Status onWriteTexture(uint32_t slotIndex, std::span<const uint8_t> data,
+                        const TexelCopyBufferLayout& dataLayout,
+                        const Extent2d& writeSize) override;
+  Status onSubmit(uint64_t submissionSerial, uint32_t commandBufferSlotIndex,
+                  std::span<const Command> commands) override;
+
+private:
+  struct Impl;  //!< Resource storage, registered programs, and the rasterizer; in the .cc.
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace donner::gpu::software
@@ -0,0 +1,292 @@
+/// @file
+/// Execution tests for the software backend's shader IR interpreter: divergent control flow,
+/// user functions, resource reads, and the WGSL fixed-function edge cases.
+
+#include "donner/gpu/software/ShaderInterpreter.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bit>
+#include <vector>
+
+#include "donner/gpu/shader/programs/SolidFill.h"
+
+namespace donner::gpu::software {
+namespace {
+
+using shader::IrExpr;
+using shader::IrType;
+
+/// Unwraps a shader builder result. Test IR is expected to be valid, so an error fails the test
+/// and aborts on the unwrap.
+template <typename T>
+T Must(shader::ShaderResult<T>&& result) {
+  if (result.hasError()) {
+    ADD_FAILURE() << "Shader builder error: " << result.error();
+  }
+  return std::move(result).result();
+}
+
+/// Starts `fs_main(@location(0) x: f32) -> @location(0) vec4f` in \p module.
+shader::FunctionBuilder BeginFragment(shader::ModuleBuilder& module) {
+  return Must(
+      module.createFragmentEntryPoint("fs_main", {shader::IrParam{"x", IrType::F32(), 0}},
+                                      {shader::IrOutputMember{"color", IrType::Vec4f(), 0}}));
+}
+
+/// Returns `vec4f(r, g, 0, 1)`.
+IrExpr Color(const IrExpr& r, const IrExpr& g) {
+  return Must(shader::ConstructVector(IrType::Vec4f(),
+                                      {r, g, shader::LiteralF32(0.0f), shader::LiteralF32(1.0f)}));
+}
+
+/// Result of running `fs_main` over one quad.
+struct QuadResult {
+  LaneMask survivors = 0;  //!< Lanes that did not discard.
+  std::array<std::array<float, 4>, kShaderLaneCount> colors{};  //!< Output color per lane.
+};
+
+/// Runs `fs_main` of \p module with input `x` set to \p x per lane.
+Result<QuadResult> RunFragment(const shader::IrModule& module,
+                               const std::array<float, kShaderLaneCount>& x,
+                               std::span<const ShaderResource> resources = {}) {
+  Result<std::shared_ptr<const ShaderProgram>> program = ShaderProgram::Compile(module);
+  if (program.hasError()) {
+    return std::move(program).error();
+  }
+
+  ShaderInterpreter interpreter(program.result());
+  const std::optional<uint32_t> entryIndex =
+      interpreter.program().findEntryPoint("fs_main", shader::StageKind::Fragment);
+  if (!entryIndex) {
+    return GpuError{GpuErrorType::InvalidState, "fs_main not found"};
+  }
+
+  const ShaderProgram::EntryPoint& entry = interpreter.program().entryPoints()[*entryIndex];
+  std::span<uint32_t> input = interpreter.values(entry.inputs[0]);
+  for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+    input[lane] = std::bit_cast<uint32_t>(x[lane]);
+  }
+
+  Result<LaneMask> survivors = interpreter.run(*entryIndex, resources, kAllLanes);
+  if (survivors.hasError()) {
+    return std::move(survivors).error();
+  }
+
+  QuadResult quad;
+  quad.survivors = survivors.result();
+  const std::span<uint32_t> output = interpreter.values(entry.outputs[0]);
+  for (uint32_t lane = 0; lane < kShaderLaneCount; ++lane) {
+    for (uint32_t c = 0; c < 4; ++c) {
+      quad.colors[lane][c] = std::bit_cast<float>(output[c * kShaderLaneCount + lane]);
+    }
+  }
+  return quad;
+}
+
+/// Returns the red channel of every lane.
+std::array<float, kShaderLaneCount> Reds(const QuadResult& quad) {
+  return {quad.colors[0][0], quad.colors[1][0], quad.colors[2][0], quad.colors[3][0]};
+}
+
+/// Returns the green channel of every lane.
+std::array<float, kShaderLaneCount> Greens(const QuadResult& quad) {
+  return {quad.colors[0][1], quad.colors[1][1], quad.colors[2][1], quad.colors[3][1]};
+}
+
+}  // namespace
+
+TEST(ShaderInterpreter, LoopsBreakAndContinuePerLane) {
+  // var sum = 0.0;
+  // for (var i = 0; i < 10; i = i + 1) {
+  //   if (f32(i) >= x) { break; }
+  //   if (i == 2) { continue; }
+  //   sum = sum + f32(i);
+  // }
+  shader::ModuleBuilder module;
+  shader::FunctionBuilder fs = BeginFragment(module);
+  const IrExpr x = Must(fs.ref("x"));
+  const IrExpr sum = Must(fs.addVar("sum", IrType::F32(), shader::LiteralF32(0.0f)));
+  const IrExpr i = Must(fs.beginFor("i", shader::LiteralI32(0)));
+  Must(fs.forCondition(Must(shader::Lt(i, shader::LiteralI32(10)))));
+  Must(fs.forContinuing(i, Must(shader::Add(i, shader::LiteralI32(1)))));
+  const IrExpr iAsFloat = Must(shader::Convert(IrType::F32(), i));
+  Must(fs.beginIf(Must(shader::Ge(iAsFloat, x))));
+  Must(fs.breakStmt());
+  Must(fs.endIf());
+  Must(fs.beginIf(Must(shader::Eq(i, shader::LiteralI32(2)))));
+  Must(fs.continueStmt());
+  Must(fs.endIf());
+  Must(fs.assign(sum, Must(shader::Add(sum, iAsFloat))));
+  Must(fs.endFor());
+  Must(fs.returnOutputs({Color(sum, shader::LiteralF32(0.0f))}));
+  Must(fs.finish());
+
+  const Result<QuadResult> quad = RunFragment(Must(module.build()), {0.0f, 3.0f, 5.0f, 100.0f});
+  ASSERT_FALSE(quad.hasError()) << quad.error();
+  EXPECT_EQ(quad.result().survivors, kAllLanes);
+  EXPECT_THAT(Reds(quad.result()), testing::ElementsAre(0.0f, 1.0f, 8.0f, 43.0f));
+}
+
+TEST(ShaderInterpreter, UserFunctionsAndStructVariables) {
+  shader::ModuleBuilder module;
+  {
+    // fn scale(v: vec2f, k: f32) -> vec2f { return v * k; }
+    shader::FunctionBuilder scale = Must(module.createFunction(
+        "scale", {shader::IrParam{"v", IrType::Vec2f()}, shader::IrParam{"k", IrType::F32()}},
+        IrType::Vec2f()));
+    Must(scale.returnValue(Must(shader::Mul(Must(scale.ref("v")), Must(scale.ref("k"))))));
+    Must(scale.finish());
+  }
+
+  const IrType pair = Must(
+      IrType::Struct("Pair", {{"a", IrType::F32()}, {"b", IrType::U32()}}));
+  shader::FunctionBuilder fs = BeginFragment(module);
+  const IrExpr x = Must(fs.ref("x"));
+  const IrExpr scaled = Must(fs.addLet(
+      "scaled", Must(fs.callFunction("scale", {Must(shader::ConstructVector(
+                                                   IrType::Vec2f(), {x, shader::LiteralF32(1.0f)})),
+                                               shader::LiteralF32(2.0f)}))));
+  const IrExpr p = Must(fs.addVar("p", pair));
+  Must(fs.assign(Must(shader::Member(p, "a")), Must(shader::Swizzle(scaled, "x"))));
+  Must(fs.assign(Must(shader::Member(p, "b")), shader::LiteralU32(7)));
+  Must(fs.returnOutputs({Color(
+      Must(shader::Member(p, "a")),
+      Must(shader::Add(Must(shader::Swizzle(scaled, "y")),
+                       Must(shader::Convert(IrType::F32(), Must(shader::Member(p, "b")))))))}));
+  Must(fs.finish());
+
+  const Result<QuadResult> quad = RunFragment(Must(module.build()), {1.0f, 2.0f, -3.0f, 0.5f});
+  ASSERT_FALSE(quad.hasError()) << quad.error();
+  EXPECT_THAT(Reds(quad.result()), testing::ElementsAre(2.0f, 4.0f, -6.0f, 1.0f));
+  EXPECT_THAT(Greens(quad.result()), testing::ElementsAre(9.0f, 9.0f, 9.0f, 9.0f));
+}
+
+TEST(ShaderInterpreter, StorageReadsOutOfBoundsReturnZero) {
+  shader::ModuleBuilder module;
+  Must(module.addReadOnlyStorageBuffer(0, 0, "values",
+                                       Must(IrType::RuntimeArray(IrType::F32()))));
+  shader::FunctionBuilder fs = BeginFragment(module);
+  const IrExpr index = Must(shader::Convert(IrType::U32(), Must(fs.ref("x"))));
+  Must(fs.returnOutputs(
+      {Color(Must(shader::Index(Must(fs.ref("values")), index)), shader::LiteralF32(0.0f))}));
+  Must(fs.finish());
+
+  const std::array<float, 3> values = {10.0f, 20.0f, 30.0f};
+  const std::array<ShaderResource, 1> resources = {ShaderResource{
+      std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(values.data()), sizeof(values))}};
+  const Result<QuadResult> quad =
+      RunFragment(Must(module.build()), {0.0f, 1.0f, 2.0f, 100.0f}, resources);
+  ASSERT_FALSE(quad.hasError()) << quad.error();
+  EXPECT_THAT(Reds(quad.result()), testing::ElementsAre(10.0f, 20.0f, 30.0f, 0.0f));
+}
+
+TEST(ShaderInterpreter, IntegerDivisionAndConversionEdgeCases) {
+  // r = f32(7 / i32(x)): integer division by zero yields the dividend.
+  // g = f32(u32(x * 1e10)): float-to-integer conversion saturates.
+  shader::ModuleBuilder module;
+  shader::FunctionBuilder fs = BeginFragment(module);
+  const IrExpr x = Must(fs.ref("x"));
+  const IrExpr quotient = Must(
+      shader::Div(shader::LiteralI32(7), Must(shader::Convert(IrType::I32(), x))));
+  const IrExpr saturated = Must(shader::Convert(
+      IrType::U32(), Must(shader::Mul(x, shader::LiteralF32(1e10f)))));
+  Must(fs.returnOutputs({Color(Must(shader::Convert(IrType::F32(), quotient)),
+                               Must(shader::Convert(IrType::F32(), saturated)))}));
+  Must(fs.finish());
+
+  const Result<QuadResult> quad = RunFragment(Must(module.build()), {0.0f, 2.0f, -2.0f, 3.0f});
+  ASSERT_FALSE(quad.hasError()) << quad.error();
+  EXPECT_THAT(Reds(quad.result()), testing::ElementsAre(7.0f, 3.0f, -3.0f, 2.0f));
+  EXPECT_THAT(Greens(quad.result()),
+              testing::ElementsAre(0.0f, 4294967296.0f, 0.0f, 4294967296.0f));
+}
+
+TEST(ShaderInterpreter, FwidthReadsQuadNeighbours) {
+  shader::ModuleBuilder module;
+  shader::FunctionBuilder fs = BeginFragment(module);
+  const IrExpr width = Must(shader::CallBuiltin(shader::BuiltinFn::Fwidth, {Must(fs.ref("x"))}));
+  Must(fs.returnOutputs({Color(width, shader::LiteralF32(0.0f))}));
+  Must(fs.finish());
+
+  // Lanes are (0, 0), (1, 0), (0, 1), (1, 1): x changes by 1 per column and 10 per row.
+  const Result<QuadResult> quad = RunFragment(Must(module.build()), {0.0f, 1.0f, 10.0f, 11.0f});
+  ASSERT_FALSE(quad.hasError()) << quad.error();
+  EXPECT_THAT(Reds(quad.result()), testing::ElementsAre(11.0f, 11.0f, 11.0f, 11.0f));
+}
+
+TEST(ShaderInterpreter, DiscardRetiresLanes) {
+  shader::ModuleBuilder module;
+  shader::FunctionBuilder fs = BeginFragment(module);
+  const IrExpr x = Must(fs.ref("x"));
+  Must(fs.beginIf(Must(shader::Lt(x, shader::LiteralF32(0.0f)))));
+  Must(fs.discard());
+  Must(fs.endIf());
+  Must(fs.returnOutputs({Color(x, shader::LiteralF32(0.0f))}));
+  Must(fs.finish());
+
+  const Result<QuadResult> quad = RunFragment(Must(module.build()), {1.0f, -1.0f, 2.0f, -2.0f});
+  ASSERT_FALSE(quad.hasError()) << quad.error();
+  EXPECT_EQ(quad.result().survivors, 0b0101u);
+  EXPECT_EQ(quad.result().colors[0][0], 1.0f);
+  EXPECT_EQ(quad.result().colors[2][0], 2.0f);
+}
+
+TEST(ShaderInterpreter, RunawayLoopFailsClosed) {
+  // for (var i = 0; i >= 0; i = i) {}
+  shader::ModuleBuilder module;
+  shader::FunctionBuilder fs = BeginFragment(module);
+  const IrExpr i = Must(fs.beginFor("i", shader::LiteralI32(0)));
+  Must(fs.forCondition(Must(shader::Ge(i, shader::LiteralI32(0)))));
+  Must(fs.forContinuing(i, i));
+  Must(fs.endFor());
+  Must(fs.returnOutputs({Color(shader::LiteralF32(0.0f), shader::LiteralF32(0.0f))}));
+  Must(fs.finish());
+
+  const Result<QuadResult> quad = RunFragment(Must(module.build()), {0.0f, 0.0f, 0.0f, 0.0f});
+  ASSERT_TRUE(quad.hasError());
+  EXPECT_EQ(quad.error().type, GpuErrorType::LimitExceeded) << quad.error();
+}
+
+TEST(ShaderInterpreter, CountsExecutedOperations) {
+  // for (var i = 0; i < 4; i = i + 1) {}, so every run evaluates the same nodes.
+  shader::ModuleBuilder module;
+  shader::FunctionBuilder fs = BeginFragment(module);
+  const IrExpr i = Must(fs.beginFor("i", shader::LiteralI32(0)));
+  Must(fs.forCondition(Must(shader::Lt(i, shader::LiteralI32(4)))));
+  Must(fs.forContinuing(i, Must(shader::Add(i, shader::LiteralI32(1)))));
+  Must(fs.endFor());
+  Must(fs.returnOutputs({Color(Must(fs.ref("x")), shader::LiteralF32(0.0f))}));
+  Must(fs.finish());
+
+  Result<std::shared_ptr<const ShaderProgram>> program =
+      ShaderProgram::Compile(Must(module.build()));
+  ASSERT_FALSE(program.hasError()) << program.error();
+  ShaderInterpreter interpreter(program.result());
+  EXPECT_EQ(interpreter.executedOperations(), 0u);
+
+  ASSERT_FALSE(interpreter.run(0, {}, kAllLanes).hasError());
+  const uint64_t perRun = interpreter.executedOperations();
+  // Four loop iterations of a comparison and an addition, plus the final comparison.
+  EXPECT_GE(perRun, 9u);
+
+  ASSERT_FALSE(interpreter.run(0, {}, 0b0001).hasError());
+  EXPECT_EQ(interpreter.executedOperations(), 2 * perRun);
+}
+
+TEST(ShaderInterpreter, CompilesSolidFillProgram) {
+  shader::ShaderResult<shader::IrModule> module = shader::programs::BuildSolidFillModule();
+  ASSERT_FALSE(module.hasError()) << module.error();
+
+  const Result<std::shared_ptr<const ShaderProgram>> program =
+      ShaderProgram::Compile(module.result());
+  ASSERT_FALSE(program.hasError()) << program.error();
+  EXPECT_EQ(program.result()->bindings().size(), module.result().bindings().size());
+  EXPECT_TRUE(program.result()->findEntryPoint("vs_main", shader::StageKind::Vertex));
+  EXPECT_TRUE(program.result()->findEntryPoint("fs_main", shader::StageKind::Fragment));
+  EXPECT_FALSE(program.result()->findEntryPoint("vs_main", shader::StageKind::Fragment));
+}
+
+}  // namespace donner::gpu::software
@@ -0,0 +1,382 @@
+/// @file
+/// End-to-end tests for \ref donner::gpu::software::SoftwareDevice: shader module resolution,
+/// rasterization rules, blending, culling, discard, and texture reads.
+
+#include "donner/gpu/software/SoftwareDevice.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "donner/gpu/CommandEncoder.h"
+#include "donner/gpu/shader/MslEmitter.h"
+#include "donner/gpu/shader/WgslEmitter.h"
+
+namespace donner::gpu::software {
+namespace {
+
+using shader::IrExpr;
+using shader::IrType;
+
+constexpr uint32_t kTargetSize = 8;
+constexpr uint32_t kBytesPerRow = 256;
+
+/// Unwraps a shader builder result. Test IR is expected to be valid, so an error fails the test
+/// and aborts on the unwrap.
+template <typename T>
+T Must(shader::ShaderResult<T>&& result) {
+  if (result.hasError()) {
+    ADD_FAILURE() << "Shader builder error: " << result.error();
+  }
+  return std::move(result).result();
+}
+
+/// Vertex layout of \ref BuildColorModule: clip-space xy plus a premultiplied color.
+struct ColorVertex {
+  float x;
+  float y;
+  std::array<float, 4> color;
+};
+
+/**
+ * Builds the pass-through color program:
+ * - `vs_main(@location(0) pos: vec2f, @location(1) color: vec4f)` outputs `vec4f(pos, 0, 1)` and
+ *   the color at location 0.
+ * - `fs_main(@location(0) color: vec4f)` discards fully transparent fragments and outputs the
+ *   interpolated color.
+ */
+shader::IrModule BuildColorModule() {
+  shader::ModuleBuilder module;
+  {
+    shader::FunctionBuilder vs = Must(module.createVertexEntryPoint(
+        "vs_main",
+        {shader::IrParam{"pos", IrType::Vec2f(), 0}, shader::IrParam{"color", IrType::Vec4f(), 1}},
+        {shader::IrOutputMember{"position", IrType::Vec4f(), std::nullopt,
+                                shader::BuiltinOutput::Position},
+         shader::IrOutputMember{"color", IrType::Vec4f(), 0}}));
+    const IrExpr position = Must(shader::ConstructVector(
+        IrType::Vec4f(),
+        {Must(vs.ref("pos")), shader::LiteralF32(0.0f), shader::LiteralF32(1.0f)}));
+    Must(vs.returnOutputs({position, Must(vs.ref("color"))}));
+    Must(vs.finish());
+  }
+  {
+    shader::FunctionBuilder fs = Must(module.createFragmentEntryPoint(
+        "fs_main", {shader::IrParam{"color", IrType::Vec4f(), 0}},
+        {shader::IrOutputMember{"color", IrType::Vec4f(), 0}}));
+    const IrExpr color = Must(fs.ref("color"));
+    Must(fs.beginIf(Must(shader::Le(Must(shader::Swizzle(color, "w")), shader::LiteralF32(0.0f)))));
+    Must(fs.discard());
+    Must(fs.endIf());
+    Must(fs.returnOutputs({color}));
+    Must(fs.finish());
+  }
+  return Must(module.build());
+}
+
+class SoftwareDeviceTest : public testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(device_.registerShaderProgram(module_).hasError());
+
+    target_ = unwrap(device_.createTexture(TextureDescriptor{
+                         "target", Extent2d{kTargetSize, kTargetSize}, TextureFormat::RGBA8Unorm,
+                         TextureUsage::RenderAttachment | TextureUsage::CopySrc}),
+                     "createTexture");
+    targetView_ = unwrap(device_.createTextureView(target_, TextureViewDescriptor{"targetView"}),
+                         "createTextureView");
+    readback_ = unwrap(
+        device_.createBuffer(BufferDescriptor{"readback", kBytesPerRow * kTargetSize,
+                                              BufferUsage::CopyDst | BufferUsage::MapRead}),
+        "createBuffer readback");
+  }
+
+  /// Unwraps a device result, failing the test on error.
+  template <typename T>
+  T unwrap(Result<T>&& result, const char* what) {
+    if (result.hasError()) {
+      ADD_FAILURE() << what << " failed: " << result.error();
+    }
+    return std::move(result).result();
+  }
+
+  /// Creates a pipeline for \ref BuildColorModule from its WGSL text.
+  RenderPipeline colorPipeline(std::optional<BlendState> blend,
+                               CullMode cullMode = CullMode::None) {
+    const std::string wgsl = Must(shader::EmitWgsl(module_));
+    ShaderModule shaderModule = unwrap(
+        device_.createShaderModule(ShaderModuleDescriptor{"color", RcString(wgsl)}),
+        "createShaderModule");
+    PipelineLayout layout = unwrap(
+        device_.createPipelineLayout(PipelineLayoutDescriptor{"colorLayout", {}}),
+        "createPipelineLayout");
+
+    RenderPipelineDescriptor descriptor{
+        "color", layout,
+        VertexState{shaderModule,
+                    "vs_main",
+                    {VertexBufferLayout{sizeof(ColorVertex),
+                                        VertexStepMode::Vertex,
+                                        {VertexAttribute{VertexFormat::Float32x2, 0, 0},
+                                         VertexAttribute{VertexFormat::Float32x4, 8, 1}}}}},
+        FragmentState{shaderModule,
+                      "fs_main",
+                      {ColorTargetState{TextureFormat::RGBA8Unorm, blend}}}};
+    descriptor.cullMode = cullMode;
+    return unwrap(device_.createRenderPipeline(descriptor), "createRenderPipeline");
+  }
+
+  /// Clears the target to \p clearColor, draws \p vertices as a triangle list with \p pipeline,
+  /// and returns the target's tightly packed RGBA8 texels.
+  std::vector<uint8_t> render(const RenderPipeline& pipeline, std::span<const ColorVertex> vertices,
+                              const std::array<double, 4>& clearColor = {0, 0, 0, 0},
+                              const BindGroup* bindGroup = nullptr) {
+    const uint64_t byteSize = vertices.size_bytes();
+    Buffer vertexBuffer = unwrap(
+        device_.createBuffer(BufferDescriptor{"vertices", byteSize,
+                                              BufferUsage::Vertex | BufferUsage::CopyDst}),
+        "createBuffer vertices");
+    EXPECT_FALSE(device_
+                     .writeBuffer(vertexBuffer, 0,
+                                  std::span<const uint8_t>(
+                                      reinterpret_cast<const uint8_t*>(vertices.data()), byteSize))
+                     .hasError());
+
+    std::unique_ptr<CommandEncoder> encoder =
+        unwrap(device_.createCommandEncoder(), "createCommandEncoder");
+    RenderPassEncoder* pass = unwrap(
+        encoder->beginRenderPass(RenderPassDescriptor{
+            "pass",
+            {RenderPassColorAttachment{targetView_, LoadOp::Clear, StoreOp::Store, clearColor}}}),
+        "beginRenderPass");
+    EXPECT_FALSE(pass->setPipeline(pipeline).hasError());
+    if (bindGroup) {
+      EXPECT_FALSE(pass->setBindGroup(0, *bindGroup).hasError());
+    }
+    EXPECT_FALSE(pass->setVertexBuffer(0, vertexBuffer).hasError());
+    EXPECT_FALSE(pass->draw(static_cast<uint32_t>(vertices.size())).hasError());
+    EXPECT_FALSE(pass->end().hasError());
+    EXPECT_FALSE(encoder
+                     ->copyTextureToBuffer(TexelCopyTextureInfo{target_}, readback_,
+                                           TexelCopyBufferLayout{0, kBytesPerRow, kTargetSize},
+                                           Extent2d{kTargetSize, kTargetSize})
+                     .hasError());
+
+    const Result<uint64_t> serial =
+        device_.submit(unwrap(encoder->finish(), "finish"));
+    EXPECT_FALSE(serial.hasError()) << serial.error();
+    EXPECT_EQ(device_.completedSerial(), device_.lastSubmittedSerial());
+
+    const std::vector<uint8_t> rows = unwrap(device_.readBackBuffer(readback_), "readBackBuffer");
+    std::vector<uint8_t> pixels(kTargetSize * kTargetSize * 4);
+    for (uint32_t y = 0; y < kTargetSize; ++y) {
+      std::memcpy(&pixels[y * kTargetSize * 4], &rows[y * kBytesPerRow], kTargetSize * 4);
+    }
+    return pixels;
+  }
+
+  SoftwareDevice device_;
+  shader::IrModule module_ = BuildColorModule();
+  Texture target_;
+  TextureView targetView_;
+  Buffer readback_;
+};
+
+/// Returns the RGBA8 texel at (\p x, \p y) of tightly packed \p pixels.
+std::array<uint8_t, 4> Texel(const std::vector<uint8_t>& pixels, uint32_t x, uint32_t y) {
+  const uint8_t* texel = &pixels[(y * kTargetSize + x) * 4];
+  return {texel[0], texel[1], texel[2], texel[3]};
+}
+
+/// A counter-clockwise (front-facing) triangle covering the whole viewport.
+constexpr std::array<float, 6> kFullScreen = {-1.0f, -1.0f, 3.0f, -1.0f, -1.0f, 3.0f};
+
+std::vector<ColorVertex> Triangle(const std::array<float, 6>& xy, std::array<float, 4> color) {
+  return {ColorVertex{xy[0], xy[1], color}, ColorVertex{xy[2], xy[3], color},
+          ColorVertex{xy[4], xy[5], color}};
+}
+
+}  // namespace
+
+TEST_F(SoftwareDeviceTest, SharedEdgesCoverEachPixelExactly) {
+  // Additive blending makes any gap or double hit along the shared diagonal visible.
+  const BlendComponent add{BlendFactor::One, BlendFactor::One, BlendOperation::Add};
+  const RenderPipeline pipeline = colorPipeline(BlendState{add, add});
+
+  const std::array<float, 4> quarter = {0.25f, 0.25f, 0.25f, 0.25f};
+  std::vector<ColorVertex> vertices = Triangle({-1, -1, 1, -1, 1, 1}, quarter);
+  const std::vector<ColorVertex> second = Triangle({-1, -1, 1, 1, -1, 1}, quarter);
+  vertices.insert(vertices.end(), second.begin(), second.end());
+
+  const std::vector<uint8_t> pixels = render(pipeline, vertices);
+  for (uint32_t y = 0; y < kTargetSize; ++y) {
+    for (uint32_t x = 0; x < kTargetSize; ++x) {
+      EXPECT_THAT(Texel(pixels, x, y), testing::ElementsAre(64, 64, 64, 64))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+TEST_F(SoftwareDeviceTest, SamplesPixelCentersWithTopLeftRule) {
+  const RenderPipeline pipeline = colorPipeline(std::nullopt);
+
+  // The left half of the viewport: its right edge at x = 0 passes between pixel centres 3 and 4.
+  std::vector<ColorVertex> vertices = Triangle({-1, -1, 0, -1, 0, 1}, {1, 0, 0, 1});
+  const std::vector<ColorVertex> second = Triangle({-1, -1, 0, 1, -1, 1}, {1, 0, 0, 1});
+  vertices.insert(vertices.end(), second.begin(), second.end());
+
+  const std::vector<uint8_t> pixels = render(pipeline, vertices);
+  for (uint32_t y = 0; y < kTargetSize; ++y) {
+    EXPECT_THAT(Texel(pixels, 3, y), testing::ElementsAre(255, 0, 0, 255)) << "row " << y;
+    EXPECT_THAT(Texel(pixels, 4, y), testing::ElementsAre(0, 0, 0, 0)) << "row " << y;
+  }
+}
+
+TEST_F(SoftwareDeviceTest, BlendsPremultipliedSourceOver) {
+  const BlendComponent sourceOver{BlendFactor::One, BlendFactor::OneMinusSrcAlpha,
+                                  BlendOperation::Add};
+  const RenderPipeline pipeline = colorPipeline(BlendState{sourceOver, sourceOver});
+
+  const std::vector<uint8_t> pixels =
+      render(pipeline, Triangle(kFullScreen, {0.5f, 0.0f, 0.0f, 0.5f}), {0, 0, 1, 1});
+  EXPECT_THAT(Texel(pixels, 0, 0), testing::ElementsAre(128, 0, 128, 255));
+  EXPECT_THAT(Texel(pixels, 7, 7), testing::ElementsAre(128, 0, 128, 255));
+}
+
+TEST_F(SoftwareDeviceTest, InterpolatesVaryings) {
+  const RenderPipeline pipeline = colorPipeline(std::nullopt);
+
+  // Red increases left to right across a viewport-covering triangle: r = (x + 1) / 4.
+  const std::vector<ColorVertex> vertices = {ColorVertex{-1, -1, {0, 0, 0, 1}},
+                                             ColorVertex{3, -1, {1, 0, 0, 1}},
+                                             ColorVertex{-1, 3, {0, 0, 0, 1}}};
+  const std::vector<uint8_t> pixels = render(pipeline, vertices);
+  for (uint32_t x = 0; x < kTargetSize; ++x) {
+    const double expected = 255.0 * (x + 0.5) / (2.0 * kTargetSize);
+    EXPECT_NEAR(Texel(pixels, x, 5)[0], expected, 1.0) << "column " << x;
+  }
+}
+
+TEST_F(SoftwareDeviceTest, CullBackDropsClockwiseTriangles) {
+  const RenderPipeline pipeline = colorPipeline(std::nullopt, CullMode::Back);
+
+  const std::vector<uint8_t> front = render(pipeline, Triangle(kFullScreen, {0, 1, 0, 1}));
+  EXPECT_THAT(Texel(front, 2, 2), testing::ElementsAre(0, 255, 0, 255));
+
+  const std::vector<uint8_t> back =
+      render(pipeline, Triangle({-1, -1, -1, 3, 3, -1}, {0, 1, 0, 1}));
+  EXPECT_THAT(Texel(back, 2, 2), testing::ElementsAre(0, 0, 0, 0));
+}
+
+TEST_F(SoftwareDeviceTest, DiscardKeepsDestination) {
+  const RenderPipeline pipeline = colorPipeline(std::nullopt);
+
+  const std::vector<uint8_t> pixels =
+      render(pipeline, Triangle(kFullScreen, {1, 1, 1, 0}), {0, 0, 1, 1});
+  EXPECT_THAT(Texel(pixels, 4, 4), testing::ElementsAre(0, 0, 255, 255));
+}
+
+TEST_F(SoftwareDeviceTest, ResolvesRegisteredMslSource) {
+  const std::string msl = Must(shader::EmitMsl(module_));
+  EXPECT_FALSE(device_
+                   .createShaderModule(
+                       ShaderModuleDescriptor{"color", RcString(msl), ShaderSourceKind::Msl})
+                   .hasError());
+}
+
+TEST_F(SoftwareDeviceTest, UnregisteredSourceFailsClosed) {
+  const Result<ShaderModule> shaderModule = device_.createShaderModule(
+      ShaderModuleDescriptor{"unknown", "@fragment fn fs_main() {}"});
+  ASSERT_TRUE(shaderModule.hasError());
+  EXPECT_EQ(shaderModule.error().type, GpuErrorType::Unsupported) << shaderModule.error();
+}
+
+TEST_F(SoftwareDeviceTest, LoadsBoundTextures) {
+  // fs_main(@builtin(position) position: vec4f) -> textureLoad(tex, vec2i(position.xy) / 4, 0)
+  shader::ModuleBuilder builder;
+  Must(builder.addTexture2d(0, 0, "tex"));
+  {
+    shader::FunctionBuilder vs = Must(builder.createVertexEntryPoint(
+        "vs_main",
+        {shader::IrParam{"pos", IrType::Vec2f(), 0}, shader::IrParam{"color", IrType::Vec4f(), 1}},
+        {shader::IrOutputMember{"position", IrType::Vec4f(), std::nullopt,
+                                shader::BuiltinOutput::Position}}));
+    Must(vs.returnOutputs({Must(shader::ConstructVector(
+        IrType::Vec4f(),
+        {Must(vs.ref("pos")), shader::LiteralF32(0.0f), shader::LiteralF32(1.0f)}))}));
+    Must(vs.finish());
+  }
+  {
+    shader::FunctionBuilder fs = Must(builder.createFragmentEntryPoint(
+        "fs_main",
+        {shader::IrParam{"position", IrType::Vec4f(), std::nullopt,
+                         shader::BuiltinInput::Position}},
+        {shader::IrOutputMember{"color", IrType::Vec4f(), 0}}));
+    const IrExpr pixel = Must(shader::Convert(
+        IrType::Vec2i(), Must(shader::Swizzle(Must(fs.ref("position")), "xy"))));
+    const IrExpr texel = Must(shader::Div(
+        pixel, Must(shader::ConstructVector(IrType::Vec2i(), {shader::LiteralI32(4)}))));
+    Must(fs.returnOutputs({Must(shader::CallBuiltin(
+        shader::BuiltinFn::TextureLoad, {Must(fs.ref("tex")), texel, shader::LiteralI32(0)}))}));
+    Must(fs.finish());
+  }
+  const shader::IrModule textureModule = Must(builder.build());
+  ASSERT_FALSE(device_.registerShaderProgram(textureModule).hasError());
+
+  // A 2x2 texture: red, green / blue, white.
+  Texture texture = unwrap(
+      device_.createTexture(TextureDescriptor{"texture", Extent2d{2, 2}, TextureFormat::RGBA8Unorm,
+                                              TextureUsage::Sampled | TextureUsage::CopyDst}),
+      "createTexture");
+  std::vector<uint8_t> texels(kBytesPerRow * 2);
+  const std::array<uint8_t, 16> colors = {255, 0,   0,   255, 0,   255, 0,   255,
+                                          0,   0,   255, 255, 255, 255, 255, 255};
+  std::memcpy(&texels[0], &colors[0], 8);
+  std::memcpy(&texels[kBytesPerRow], &colors[8], 8);
+  ASSERT_FALSE(device_
+                   .writeTexture(texture, texels, TexelCopyBufferLayout{0, kBytesPerRow, 2},
+                                 Extent2d{2, 2})
+                   .hasError());
+  TextureView view = unwrap(device_.createTextureView(texture, TextureViewDescriptor{"view"}),
+                            "createTextureView");
+
+  BindGroupLayout groupLayout = unwrap(
+      device_.createBindGroupLayout(BindGroupLayoutDescriptor{
+          "textureGroupLayout",
+          {BindGroupLayoutEntry{0, ShaderStage::Fragment, BindingType::SampledTexture2dFloat}}}),
+      "createBindGroupLayout");
+  BindGroup group = unwrap(device_.createBindGroup(BindGroupDescriptor{
+                               "textureGroup", groupLayout, {{0, TextureViewBinding{view}}}}),
+                           "createBindGroup");
+  PipelineLayout layout = unwrap(
+      device_.createPipelineLayout(PipelineLayoutDescriptor{"textureLayout", {groupLayout}}),
+      "createPipelineLayout");
+
+  ShaderModule shaderModule = unwrap(
+      device_.createShaderModule(
+          ShaderModuleDescriptor{"texture", RcString(Must(shader::EmitWgsl(textureModule)))}),
+      "createShaderModule");
+  const RenderPipeline pipeline = unwrap(
+      device_.createRenderPipeline(RenderPipelineDescriptor{
+          "texture", layout,
+          VertexState{shaderModule,
+                      "vs_main",
+                      {VertexBufferLayout{sizeof(ColorVertex),
+                                          VertexStepMode::Vertex,
+                                          {VertexAttribute{VertexFormat::Float32x2, 0, 0},
+                                           VertexAttribute{VertexFormat::Float32x4, 8, 1}}}}},
+          FragmentState{shaderModule, "fs_main", {ColorTargetState{}}}}),
+      "createRenderPipeline");
+
+  const std::vector<uint8_t> pixels =
+      render(pipeline, Triangle(kFullScreen, {0, 0, 0, 0}), {0, 0, 0, 0}, &group);
+  EXPECT_THAT(Texel(pixels, 1, 1), testing::ElementsAre(255, 0, 0, 255));
+  EXPECT_THAT(Texel(pixels, 6, 1), testing::ElementsAre(0, 255, 0, 255));
+  EXPECT_THAT(Texel(pixels, 1, 6), testing::ElementsAre(0, 0, 255, 255));
+  EXPECT_THAT(Texel(pixels, 6, 6), testing::ElementsAre(255, 255, 255, 255));
+}
+
+}  // namespace donner::gpu::software
@@ -23,6 +23,7 @@
 #include "donner/svg/components/SVGDocumentContext.h"
 #include "donner/svg/components/StylesheetComponent.h"
 #include "donner/svg/components/TreeMutation.h"
+#include "donner/svg/components/animation/AnimationTimelineIndex.h"
 #include "donner/svg/components/filter/FilterComponent.h"
 #include "donner/svg/components/filter/FilterPrimitiveComponent.h"
 #include "donner/svg/components/layout/LayoutSystem.h"
@@ -647,6 +648,23 @@ bool IsAttributeMutation(xml::XMLMutation::Kind kind) {
          kind == xml::XMLMutation::Kind::AttributeRemoved;
 }
 
+/**
+ * Returns true if the built render tree is known to be identical at document times \p fromTime
+ * and \p toTime: nothing is pending a rebuild, so the animation timeline index recorded by that
+ * build is current, and no animation changes phase or varies between the two times.
+ */
+bool RenderTreeUnchangedBetween(const Registry& registry, double fromTime, double toTime) {
+  const auto* renderState = registry.ctx().find<components::RenderTreeState>();
+  const auto* timeline = registry.ctx().find<components::AnimationTimelineIndex>();
+  if (renderState == nullptr || timeline == nullptr || !renderState->hasBeenBuilt ||
+      renderState->needsFullRebuild || renderState->needsFullStyleRecompute ||
+      !registry.view<const components::DirtyFlagsComponent>().empty()) {
+    return false;
+  }
+
+  return !timeline->changesBetween(fromTime, toTime);
+}
+
 }  // namespace
 
 SVGDocument::SVGDocument(SVGDocumentHandle documentState, Settings settings,
@@ -800,7 +818,9 @@ void SVGDocument::setTime(double seconds) {
     mutation.cancel();
     return;
   }
-  components::RenderingContext(registry).invalidateRenderTree();
+  if (!RenderTreeUnchangedBetween(registry, documentContext.documentTime, seconds)) {
+    components::RenderingContext(registry).invalidateRenderTree();
+  }
   documentContext.documentTime = seconds;
 }
 
@@ -834,6 +854,19 @@ std::vector<RcString> SVGDocument::userLanguages() const {
   return access.registry().ctx().get<components::SVGDocumentContext>().userLanguages;
 }
 
+void SVGDocument::setPrepareThreadCount(std::size_t threadCount) {
+  // The prepared result does not depend on the thread count, so this neither invalidates the
+  // render tree nor commits a mutation revision.
+  DocumentMutationBatch mutation(*documentState_);
+  mutation.access().registry().ctx().get<components::SVGDocumentContext>().prepareThreadCount =
+      threadCount;
+}
+
+std::size_t SVGDocument::prepareThreadCount() const {
+  DocumentReadAccess access = documentState_->read();
+  return access.registry().ctx().get<components::SVGDocumentContext>().prepareThreadCount;
+}
+
 void SVGDocument::useAutomaticCanvasSize() {
   DocumentMutationBatch mutation(*documentState_, true);
   DocumentWriteAccess& access = mutation.access();
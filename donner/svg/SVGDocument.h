@@ -310,7 +310,9 @@ public:
    * Set the current document time for animations, in seconds from the document start.
    *
    * Advancing the document time causes the animation system to update animated attribute values
-   * on the next render. This invalidates the render tree.
+   * on the next render. This invalidates the render tree, unless the document has been rendered
+   * since its last change and no animation changes phase or value between the previous and new
+   * times, in which case the previous render is reused as-is.
    *
    * @param seconds Document time in seconds.
    */
@@ -381,6 +383,24 @@ public:
    */
   std::vector<RcString> userLanguages() const;
 
+  /**
+   * Set the number of threads used to prepare the document for rendering, including the calling
+   * thread. Style cascade selector matching and path-data parsing are split across this many
+   * threads on large documents, and their results are committed in document order, so the
+   * rendered output is identical for every thread count. The threads are started the first time a
+   * prepare needs them and kept with the document, so later prepares reuse them. Layout and text
+   * shaping stay on the calling thread.
+   *
+   * Defaults to 1, which prepares on the calling thread only. Passing 0 uses
+   * `std::thread::hardware_concurrency()`.
+   *
+   * @param threadCount Number of prepare threads, or 0 for the hardware concurrency.
+   */
+  void setPrepareThreadCount(std::size_t threadCount);
+
+  /// Get the number of threads used to prepare the document for rendering. Defaults to 1.
+  std::size_t prepareThreadCount() const;
+
   /**
    * Returns true if the two SVGDocument handles reference the same underlying document.
    */
@@ -392,8 +392,8 @@ void SVGElement::setId(std::string_view id) {
     handle_.emplace<components::IdComponent>(access, RcString(id));
   }
 
-  handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttribute(
-      *handle_.registry(), xml::XMLQualifiedName("id"), RcString(id));
+  handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttributeFromView(
+      *handle_.registry(), xml::XMLQualifiedName("id"), id);
   markNeedsFullStyleRecompute(handle_);
 }
 
@@ -415,8 +415,8 @@ void SVGElement::setClassName(std::string_view name) {
     handle_.remove<components::ClassComponent>(access);
   }
 
-  handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttribute(
-      *handle_.registry(), xml::XMLQualifiedName("class"), RcString(name));
+  handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttributeFromView(
+      *handle_.registry(), xml::XMLQualifiedName("class"), name);
 
   // Class changes affect CSS selector matching, which can change any inherited property.
   markNeedsFullStyleRecompute(handle_);
@@ -429,10 +429,14 @@ void SVGElement::setClassName(std::string_view name) {
 void SVGElement::setStyle(std::string_view style) {
   DocumentMutationBatch mutation = handle_.mutationBatch();
   DocumentWriteAccess& access = mutation.access();
-  handle_.get_or_emplace<components::StyleComponent>(access).setStyle(style);
+  Registry& registry = *handle_.registry();
+  StyleAttributeCache& styleCache = registry.ctx().contains<StyleAttributeCache>()
+                                        ? registry.ctx().get<StyleAttributeCache>()
+                                        : registry.ctx().emplace<StyleAttributeCache>();
+  handle_.get_or_emplace<components::StyleComponent>(access).setStyle(style, &styleCache);
 
-  handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttribute(
-      *handle_.registry(), xml::XMLQualifiedName("style"), RcString(style));
+  handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttributeFromView(
+      *handle_.registry(), xml::XMLQualifiedName("style"), style);
 
   components::StyleSystem().invalidateAll(handle_);
   markNeedsFullStyleRecompute(handle_);
@@ -496,8 +500,8 @@ ParseResult<bool> SVGElement::trySetPresentationAttribute(std::string_view name,
 
   if (trySetResult.hasResult() && trySetResult.result()) {
     // Set succeeded, so store the attribute value.
-    handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttribute(
-        *handle_.registry(), xml::XMLQualifiedName(RcString(name)), RcString(value));
+    handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttributeFromView(
+        *handle_.registry(), xml::XMLQualifiedName(RcString(name)), value);
 
     // Mark dirty flags based on the attribute type.
     if (actualName == "transform") {
@@ -608,8 +612,8 @@ std::optional<ParseDiagnostic> SVGElement::setAttributeFromXMLMutation(
   if (components::IsConditionalProcessingAttribute(name)) {
     auto& conditional = handle_.get_or_emplace<components::ConditionalProcessingComponent>(access);
     (void)components::SetConditionalProcessingAttribute(conditional, name, value);
-    handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttribute(
-        *handle_.registry(), name, RcString(value));
+    handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttributeFromView(
+        *handle_.registry(), name, value);
     markConditionalProcessingChanged(handle_);
     return std::nullopt;
   }
@@ -637,16 +641,16 @@ std::optional<ParseDiagnostic> SVGElement::setAttributeFromXMLMutation(
 
     if (trySetResult.hasError()) {
       markNeedsFullStyleRecompute(handle_);
-      handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttribute(
-          *handle_.registry(), name, RcString(value));
+      handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttributeFromView(
+          *handle_.registry(), name, value);
       return std::move(trySetResult).error();
     }
   }
 
   // Otherwise store as a generic attribute.
   markNeedsFullStyleRecompute(handle_);
-  handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttribute(
-      *handle_.registry(), name, RcString(value));
+  handle_.get_or_emplace<donner::components::AttributesComponent>(access).setAttributeFromView(
+      *handle_.registry(), name, value);
   return std::nullopt;
 }
 
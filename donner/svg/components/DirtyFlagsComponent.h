@@ -1,6 +1,7 @@
 #pragma once
 /// @file
 
+#include <atomic>
 #include <cstdint>
 
 namespace donner::svg::components {
@@ -67,6 +68,20 @@ struct RenderTreeState {
 
   /// True if the render tree has been built at least once.
   bool hasBeenBuilt = false;
+
+  /// Identity of the current set of \ref RenderingInstanceComponent, replaced with a new
+  /// process-wide unique value whenever that storage is rebuilt or reordered. Renderer caches
+  /// derived from the render instances compare against it to detect that they are stale.
+  std::uint64_t instancesRevision = 0;
+
+  /// Give the render instances a new \ref instancesRevision.
+  void markInstancesChanged() { instancesRevision = NextInstancesRevision(); }
+
+  /// Returns a process-wide unique, nonzero revision.
+  static std::uint64_t NextInstancesRevision() {
+    static std::atomic<std::uint64_t> nextRevision{1};
+    return nextRevision.fetch_add(1, std::memory_order_relaxed);
+  }
 };
 
 }  // namespace donner::svg::components
@@ -0,0 +1,102 @@
+#pragma once
+/// @file
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+#include "donner/base/EcsRegistry.h"
+#include "donner/base/WorkerPool.h"
+#include "donner/svg/components/SVGDocumentContext.h"
+
+namespace donner::svg::components {
+
+/// Fewest work items per worker before a parallel prepare stage starts another thread. Smaller
+/// stages stay on the calling thread, where thread startup would cost more than it saves.
+inline constexpr std::size_t kMinimumPrepareItemsPerWorker = 64;
+
+/**
+ * Number of threads the parallel prepare stages may use, from
+ * \ref SVGDocumentContext::prepareThreadCount with 0 resolved to the hardware thread count.
+ *
+ * @param registry Document registry.
+ */
+inline std::size_t PrepareThreadCount(const Registry& registry) {
+  std::size_t threadCount = 1;
+  if (const auto* context = registry.ctx().find<SVGDocumentContext>()) {
+    threadCount = context->prepareThreadCount;
+  }
+  if (threadCount == 0) {
+    threadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  return threadCount;
+}
+
+/**
+ * Number of workers a parallel prepare stage should use for \p itemCount work items, bounded by
+ * \ref SVGDocumentContext::prepareThreadCount.
+ *
+ * @param registry Document registry.
+ * @param itemCount Number of independent work items in the stage.
+ * @return Worker count, including the calling thread. 1 means the stage should run serially.
+ */
+inline std::size_t PrepareWorkerCount(const Registry& registry, std::size_t itemCount) {
+  return std::clamp<std::size_t>(itemCount / kMinimumPrepareItemsPerWorker, 1,
+                                 PrepareThreadCount(registry));
+}
+
+/**
+ * Threads shared by every parallel prepare stage of a document, stored in the \c Registry::ctx().
+ *
+ * Created by the first stage that goes parallel and kept for the life of the document, so the
+ * selector matching and path parsing stages, and every later prepare, reuse the same threads.
+ */
+struct PrepareWorkerPoolContext {
+  /// The pool, sized to \ref PrepareThreadCount when it was created.
+  std::unique_ptr<WorkerPool> pool;
+};
+
+/**
+ * Split `[0, itemCount)` into \p workerCount contiguous ranges and call `fn(worker, begin, end)`
+ * once per range, returning after every call has finished. Worker 0 runs on the calling thread,
+ * the others on the document's \ref PrepareWorkerPoolContext, which is created or resized to
+ * \ref PrepareThreadCount first.
+ *
+ * The ranges depend only on \p itemCount and \p workerCount. Stages write each item's result to a
+ * slot owned by that item, or to per-worker scratch indexed by `worker`, and the serial commit
+ * that follows reads results in item order, so the output does not depend on scheduling.
+ *
+ * `fn` must only read the registry: entt pools must not be created or resized while workers run,
+ * so callers materialize every pool the workers look up before calling this.
+ *
+ * @param registry Document registry, which holds the worker pool.
+ * @param itemCount Number of work items.
+ * @param workerCount Number of workers, from \ref PrepareWorkerCount.
+ * @param fn Callable as `fn(std::size_t worker, std::size_t begin, std::size_t end)`.
+ */
+template <typename F>
+void ForEachPrepareRange(Registry& registry, std::size_t itemCount, std::size_t workerCount,
+                         const F& fn) {
+  workerCount = std::clamp<std::size_t>(workerCount, 1, std::max<std::size_t>(itemCount, 1));
+  const auto rangeBegin = [&](std::size_t worker) { return itemCount * worker / workerCount; };
+  const auto runRange = [&](std::size_t worker) {
+    fn(worker, rangeBegin(worker), rangeBegin(worker + 1));
+  };
+  if (workerCount == 1) {
+    runRange(0);
+    return;
+  }
+
+  auto& poolContext = registry.ctx().contains<PrepareWorkerPoolContext>()
+                          ? registry.ctx().get<PrepareWorkerPoolContext>()
+                          : registry.ctx().emplace<PrepareWorkerPoolContext>();
+  const std::size_t threadCount = PrepareThreadCount(registry);
+  if (!poolContext.pool || poolContext.pool->threadCount() != threadCount) {
+    poolContext.pool.reset();
+    poolContext.pool = std::make_unique<WorkerPool>(threadCount);
+  }
+  poolContext.pool->run(workerCount, runRange);
+}
+
+}  // namespace donner::svg::components
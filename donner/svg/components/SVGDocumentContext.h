@@ -94,6 +94,12 @@ public:
   /// Maximum direct content chunks projected by later incremental source edits.
   std::size_t maximumContentProjectionChunks = 4096;
 
+  /// Threads used by the parallel stages of render-tree preparation, including the calling
+  /// thread. The default of 1 keeps preparation on the calling thread, and 0 uses
+  /// `std::thread::hardware_concurrency()`. The prepared result does not depend on this value.
+  /// Configure via \ref SVGDocument::setPrepareThreadCount.
+  std::size_t prepareThreadCount = 1;
+
   /**
    * Get the entity with the given ID, using the internal id-to-entity mapping.
    *
@@ -109,6 +115,10 @@ public:
   /// Mark the backing document state as mutated.
   void bumpMutationRevision() const { getSharedDocumentState()->bumpMutationRevision(); }
 
+  /// Current mutation revision of the backing document, which changes with every committed DOM
+  /// mutation.
+  std::uint64_t mutationRevision() const { return getSharedDocumentState()->revision(); }
+
   /// Returns true if the current thread holds write access to the backing document.
   bool currentThreadHasWriteAccess() const {
     return getSharedDocumentState()->currentThreadHasWriteAccess();
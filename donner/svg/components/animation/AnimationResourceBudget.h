@@ -1,6 +1,7 @@
 #pragma once
 /// @file
 
+#include <algorithm>
 #include <cstddef>
 
 namespace donner::svg::components {
@@ -33,6 +34,9 @@ public:
     return true;
   }
 
+  /// Return output bytes reserved for a value that has since been replaced.
+  void releaseOutput(std::size_t bytes) { outputBytes_ -= std::min(bytes, outputBytes_); }
+
   std::size_t animations() const { return animations_; }
   std::size_t sourceBytes() const { return sourceBytes_; }
   std::size_t outputBytes() const { return outputBytes_; }
@@ -3,8 +3,11 @@
 
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <utility>
 
 #include "donner/base/EcsRegistry.h"
+#include "donner/svg/components/animation/AnimationTimelineIndex.h"
 
 namespace donner::svg::components {
 
@@ -44,6 +47,35 @@ struct AnimationStateComponent {
   /// Whether this animation was active in the previous frame.
   /// Used to enforce restart="whenNotActive".
   bool wasActive = false;
+
+  /// Attribute name and value this animation contributed at the last advance, if any. Kept so
+  /// that an advance which resamples only some animations can recompose their targets' overrides.
+  std::optional<std::pair<std::string, std::string>> sample;
+
+  /// Whether \ref sample cannot change for the rest of \ref sampledPhase (a `<set>`, or a frozen
+  /// animation after its active interval), so it is reused instead of re-interpolated.
+  bool sampleHeld = false;
+
+  /// Phase in which \ref sample was taken.
+  AnimationPhase sampledPhase = AnimationPhase::Before;
 };
 
+/**
+ * Discard the runtime state derived from an animation's attributes; call whenever they are
+ * reparsed. Drops the last sample and the resolved target, and erases the registry's
+ * \ref AnimationTimelineIndex so that the next advance resamples every animation.
+ *
+ * @param handle Animation entity whose attributes changed.
+ */
+inline void InvalidateAnimationState(EntityHandle handle) {
+  if (auto* state = handle.try_get<AnimationStateComponent>()) {
+    state->sample.reset();
+    state->sampleHeld = false;
+    state->targetEntity = entt::null;
+  }
+  if (handle.registry()->ctx().contains<AnimationTimelineIndex>()) {
+    handle.registry()->ctx().erase<AnimationTimelineIndex>();
+  }
+}
+
 }  // namespace donner::svg::components
@@ -3,8 +3,11 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <optional>
+#include <span>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "donner/base/Path.h"
@@ -16,6 +19,7 @@
 #include "donner/svg/components/animation/AnimatedValuesComponent.h"
 #include "donner/svg/components/animation/AnimationResourceBudget.h"
 #include "donner/svg/components/animation/AnimationStateComponent.h"
+#include "donner/svg/components/animation/AnimationTimelineIndex.h"
 #include "donner/svg/components/animation/AnimationTimingComponent.h"
 #include "donner/svg/components/animation/SetAnimationComponent.h"
 #include "donner/svg/parser/PathParser.h"
@@ -637,17 +641,43 @@ std::optional<std::pair<std::string_view, std::string>> SampleAnimationValue(
       "transform", interpolateTransformValue(progress, *transformComp)};
 }
 
-bool ProcessAnimation(Registry& registry, Entity entity, double documentTime,
-                      AnimationResourceBudget& resourceBudget) {
+/// Record the phase boundaries of an animation whose timing state was just computed, its active
+/// interval if the sampled value varies over it, and its target.
+void AddToTimelineIndex(AnimationTimelineIndex& index, Entity entity,
+                        const AnimationTimingComponent& timing,
+                        const AnimationStateComponent& state, bool isSetElement) {
+  if (state.targetEntity == entt::null) {
+    index.addUnresolvedTarget(entity);
+  } else {
+    index.addTarget(state.targetEntity, entity);
+  }
+
+  if (timing.beginValue.has_value() && !timing.beginOffset.has_value()) {
+    // Unresolved begin: the animation never starts, so it never changes.
+    return;
+  }
+
+  const double endTime = state.beginTime + state.activeDuration;
+  index.addBoundary(state.beginTime, entity);
+  if (std::isfinite(endTime)) {
+    index.addBoundary(endTime, entity);
+  }
+  if (!isSetElement) {
+    index.addVaryingInterval(state.beginTime, endTime);
+  }
+}
+
+/// Bring an animation's timing state up to \p documentTime and store the value it contributes in
+/// \ref AnimationStateComponent::sample, reserving the value's bytes from \p resourceBudget.
+/// Returns false if the budget is exhausted.
+bool SampleAnimation(Registry& registry, Entity entity, double documentTime,
+                     AnimationResourceBudget& resourceBudget) {
   const auto& timing = registry.get<AnimationTimingComponent>(entity);
   auto& state = registry.get_or_emplace<AnimationStateComponent>(entity);
   const auto* setComp = registry.try_get<SetAnimationComponent>(entity);
   const auto* valueComp = registry.try_get<AnimateValueComponent>(entity);
   const auto* transformComp = registry.try_get<AnimateTransformComponent>(entity);
 
-  if (!resourceBudget.reserveAnimation(AnimationSourceBytes(setComp, valueComp, transformComp))) {
-    return false;
-  }
   if (state.targetEntity == entt::null) {
     const std::optional<std::string>& href =
         setComp ? setComp->href : (valueComp ? valueComp->href : transformComp->href);
@@ -655,27 +685,62 @@ bool ProcessAnimation(Registry& registry, Entity entity, double documentTime,
   }
   computeTimingState(state, timing, documentTime, /*isSetElement=*/setComp != nullptr);
   if (!registry.valid(state.targetEntity) || !shouldApplyValue(state.phase, timing.fill)) {
+    state.sample.reset();
     return true;
   }
 
-  const double sampleTime =
-      (state.phase == AnimationPhase::Active || !std::isfinite(state.activeDuration))
-          ? documentTime
-          : state.beginTime + state.activeDuration;
-  const double progress =
-      computeProgress(sampleTime, state.beginTime, state.simpleDuration, state.activeDuration);
-  auto sampled = SampleAnimationValue(progress, setComp, valueComp, transformComp);
-  if (!sampled || sampled->second.empty()) {
-    return true;
+  // A `<set>` value, and a frozen value after the active interval, stay the same for the rest of
+  // the phase: reuse the held sample instead of re-interpolating it.
+  const bool constantOutput = setComp != nullptr || state.phase == AnimationPhase::After;
+  if (!(constantOutput && state.sample.has_value() && state.sampleHeld &&
+        state.sampledPhase == state.phase)) {
+    state.sample.reset();
+
+    const double sampleTime =
+        (state.phase == AnimationPhase::Active || !std::isfinite(state.activeDuration))
+            ? documentTime
+            : state.beginTime + state.activeDuration;
+    const double progress =
+        computeProgress(sampleTime, state.beginTime, state.simpleDuration, state.activeDuration);
+    auto value = SampleAnimationValue(progress, setComp, valueComp, transformComp);
+    if (!value || value->second.empty()) {
+      return true;
+    }
+
+    state.sample.emplace(std::string(value->first), std::move(value->second));
+    state.sampleHeld = constantOutput;
+    state.sampledPhase = state.phase;
   }
-  if (!resourceBudget.reserveOutput(sampled->second.size())) {
+
+  if (!resourceBudget.reserveOutput(state.sample->second.size())) {
+    state.sample.reset();
     return false;
   }
-  auto& values = registry.get_or_emplace<AnimatedValuesComponent>(state.targetEntity);
-  values.overrides[std::string(sampled->first)] = std::move(sampled->second);
   return true;
 }
 
+/// Write the sample of animation \p entity, if any, into its target's overrides. Later animations
+/// overwrite earlier ones for the same attribute.
+void ApplySample(Registry& registry, Entity entity) {
+  const auto& state = registry.get<AnimationStateComponent>(entity);
+  if (state.sample.has_value() && registry.valid(state.targetEntity)) {
+    auto& values = registry.get_or_emplace<AnimatedValuesComponent>(state.targetEntity);
+    values.overrides[state.sample->first] = state.sample->second;
+  }
+}
+
+/// Varying animations among \p entities that are active after the advance just made.
+std::vector<Entity> ActiveVaryingAnimations(Registry& registry, std::span<const Entity> entities) {
+  std::vector<Entity> active;
+  for (const Entity entity : entities) {
+    if (!registry.all_of<SetAnimationComponent>(entity) &&
+        registry.get<AnimationStateComponent>(entity).phase == AnimationPhase::Active) {
+      active.push_back(entity);
+    }
+  }
+  return active;
+}
+
 std::vector<Entity> CollectAnimationEntities(Registry& registry) {
   std::vector<Entity> entities;
   for (auto [entity, timing] : registry.view<AnimationTimingComponent>().each()) {
@@ -688,10 +753,26 @@ std::vector<Entity> CollectAnimationEntities(Registry& registry) {
   return entities;
 }
 
-}  // namespace
+/// Marks that the registry has the listener below installed.
+struct AnimationListenerInstalled {};
+
+/// Adding or removing an animation element changes the set of animations, so the timeline index
+/// no longer describes the document.
+void OnAnimationElementsChanged(Registry& registry, Entity /*entity*/) {
+  if (registry.ctx().contains<AnimationTimelineIndex>()) {
+    registry.ctx().erase<AnimationTimelineIndex>();
+  }
+}
+
+/// Resample every animation and rebuild the timeline index from scratch.
+void AdvanceAll(Registry& registry, double documentTime) {
+  if (!registry.ctx().contains<AnimationListenerInstalled>()) {
+    registry.ctx().emplace<AnimationListenerInstalled>();
+    static_cast<void>(registry.storage<AnimationTimingComponent>());
+    registry.on_construct<AnimationTimingComponent>().connect<&OnAnimationElementsChanged>();
+    registry.on_destroy<AnimationTimingComponent>().connect<&OnAnimationElementsChanged>();
+  }
 
-void AnimationSystem::advance(Registry& registry, double documentTime,
-                              std::vector<ParseDiagnostic>* /*outWarnings*/) {
   if (registry.ctx().contains<AnimationResourceBudget>()) {
     registry.ctx().erase<AnimationResourceBudget>();
   }
@@ -701,11 +782,31 @@ void AnimationSystem::advance(Registry& registry, double documentTime,
     animValues.overrides.clear();
   }
 
-  for (const Entity entity : CollectAnimationEntities(registry)) {
-    if (!ProcessAnimation(registry, entity, documentTime, resourceBudget)) {
+  if (registry.ctx().contains<AnimationTimelineIndex>()) {
+    registry.ctx().erase<AnimationTimelineIndex>();
+  }
+  auto& index = registry.ctx().emplace<AnimationTimelineIndex>();
+  const std::vector<Entity> entities = CollectAnimationEntities(registry);
+  std::size_t processed = 0;
+  for (const Entity entity : entities) {
+    const auto* setComp = registry.try_get<SetAnimationComponent>(entity);
+    const auto* valueComp = registry.try_get<AnimateValueComponent>(entity);
+    const auto* transformComp = registry.try_get<AnimateTransformComponent>(entity);
+    if (!resourceBudget.reserveAnimation(AnimationSourceBytes(setComp, valueComp, transformComp)) ||
+        !SampleAnimation(registry, entity, documentTime, resourceBudget)) {
+      index.markIncomplete();
       break;
     }
+
+    AddToTimelineIndex(index, entity, registry.get<AnimationTimingComponent>(entity),
+                       registry.get<AnimationStateComponent>(entity),
+                       /*isSetElement=*/setComp != nullptr);
+    ApplySample(registry, entity);
+    ++processed;
   }
+  index.finalize();
+  index.setAdvancedTime(documentTime, ActiveVaryingAnimations(
+                                          registry, std::span(entities).first(processed)));
 
   // Clean up empty AnimatedValuesComponent instances.
   for (auto [entity, animValues] : registry.view<AnimatedValuesComponent>().each()) {
@@ -715,4 +816,67 @@ void AnimationSystem::advance(Registry& registry, double documentTime,
   }
 }
 
+/**
+ * Advance from the time recorded in \p index, resampling only the animations that may change and
+ * recomposing the overrides of their targets. Returns false without changing any override if this
+ * cannot be done incrementally, in which case the caller falls back to \ref AdvanceAll.
+ */
+bool AdvanceChanged(Registry& registry, AnimationTimelineIndex& index, double documentTime) {
+  auto* resourceBudget = registry.ctx().find<AnimationResourceBudget>();
+  if (!index.complete() || resourceBudget == nullptr) {
+    return false;
+  }
+  // A target that resolves now, such as an href to an id added since, joins the per-target lists.
+  for (const Entity entity : index.unresolvedTargets()) {
+    const auto* setComp = registry.try_get<SetAnimationComponent>(entity);
+    const auto* valueComp = registry.try_get<AnimateValueComponent>(entity);
+    const auto* transformComp = registry.try_get<AnimateTransformComponent>(entity);
+    const std::optional<std::string>& href =
+        setComp ? setComp->href : (valueComp ? valueComp->href : transformComp->href);
+    if (resolveTargetByHrefOrParent(registry, entity, href) != entt::null) {
+      return false;
+    }
+  }
+
+  std::vector<Entity> changed;
+  index.collectChangedBetween(index.advancedTime(), documentTime, changed);
+
+  std::vector<Entity> targets;
+  for (const Entity entity : changed) {
+    auto& state = registry.get<AnimationStateComponent>(entity);
+    if (state.sample.has_value()) {
+      resourceBudget->releaseOutput(state.sample->second.size());
+    }
+    if (!SampleAnimation(registry, entity, documentTime, *resourceBudget)) {
+      return false;
+    }
+    targets.push_back(state.targetEntity);
+  }
+
+  std::sort(targets.begin(), targets.end());
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+  for (const Entity target : targets) {
+    if (!registry.valid(target)) {
+      continue;
+    }
+    registry.remove<AnimatedValuesComponent>(target);
+    for (const Entity entity : index.animationsTargeting(target)) {
+      ApplySample(registry, entity);
+    }
+  }
+
+  index.setAdvancedTime(documentTime, ActiveVaryingAnimations(registry, changed));
+  return true;
+}
+
+}  // namespace
+
+void AnimationSystem::advance(Registry& registry, double documentTime,
+                              std::vector<ParseDiagnostic>* /*outWarnings*/) {
+  auto* index = registry.ctx().find<AnimationTimelineIndex>();
+  if (index == nullptr || !AdvanceChanged(registry, *index, documentTime)) {
+    AdvanceAll(registry, documentTime);
+  }
+}
+
 }  // namespace donner::svg::components
@@ -20,6 +20,13 @@ namespace donner::svg::components {
  * 3. For active `<set>` animations, stores the override value on the target entity.
  * 4. For frozen animations (fill="freeze"), persists the final value.
  * 5. For removed animations (fill="remove"), clears the override.
+ *
+ * `<set>` values and frozen values are held between advances until the animation changes phase.
+ * The first advance, and any advance after the animations' attributes or the set of animation
+ * elements changed, resamples every animation and builds the \ref AnimationTimelineIndex in the
+ * registry context. Later advances only resample the animations that index reports as crossing a
+ * phase boundary or varying over the time change, and recompose their targets' overrides; a time
+ * change which affects no animation can also skip render-tree invalidation entirely.
  */
 class AnimationSystem {
 public:
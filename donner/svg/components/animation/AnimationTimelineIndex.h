@@ -0,0 +1,186 @@
+#pragma once
+/// @file
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "donner/base/EcsRegistry.h"
+
+namespace donner::svg::components {
+
+/**
+ * Interval index over the document timeline, answering whether any animation may produce a
+ * different result at one document time than at another.
+ *
+ * Built by a full \ref AnimationSystem::advance and stored in the registry context. Every
+ * animation contributes the boundaries of its active interval, where its phase changes, and
+ * animations whose value varies while active (anything but `<set>`) additionally contribute that
+ * interval. Two times are equivalent when no boundary lies between them and neither is inside a
+ * varying interval; \ref SVGDocument::setTime uses this to skip invalidating the render tree.
+ *
+ * The index also remembers which animation owns each boundary, which animations target each
+ * element and which varying animations were active at the last advanced time, so that later
+ * advances resample only the animations returned by \ref collectChangedBetween and recompose only
+ * their targets. Anything that can change an animation other than the passage of time (reparsed
+ * attributes, added or removed animation elements) erases the index, and the next advance
+ * rebuilds it from every animation.
+ *
+ * An index built from an advance that stopped early (see \ref AnimationResourceBudget) is marked
+ * incomplete and treats every time change as a change.
+ */
+class AnimationTimelineIndex {
+public:
+  /// Record a time at which \p animation changes phase.
+  void addBoundary(double time, Entity animation) {
+    boundaries_.push_back(Boundary{time, animation});
+  }
+
+  /// Record an active interval `[begin, end)` over which an animation's value varies with time.
+  void addVaryingInterval(double begin, double end) {
+    if (end > begin) {
+      varying_.push_back(Interval{begin, end});
+    }
+  }
+
+  /// Record that \p animation targets \p target. Call in document order, so that
+  /// \ref animationsTargeting lists later animations, which take precedence, last.
+  void addTarget(Entity target, Entity animation) { targets_[target].push_back(animation); }
+
+  /// Record an animation whose target has not resolved yet, such as an `href` to a missing id.
+  void addUnresolvedTarget(Entity animation) { unresolvedTargets_.push_back(animation); }
+
+  /// Animations whose target had not resolved when the index was built.
+  const std::vector<Entity>& unresolvedTargets() const { return unresolvedTargets_; }
+
+  /// Animations targeting \p target, in document order.
+  const std::vector<Entity>& animationsTargeting(Entity target) const {
+    static const std::vector<Entity> kNone;
+    const auto it = targets_.find(target);
+    return it != targets_.end() ? it->second : kNone;
+  }
+
+  /// Record the time the animations were last advanced to, and the varying animations that were
+  /// active at it.
+  void setAdvancedTime(double time, std::vector<Entity> activeVarying) {
+    advancedTime_ = time;
+    activeVarying_ = std::move(activeVarying);
+  }
+
+  /// Time the animations were last advanced to.
+  double advancedTime() const { return advancedTime_; }
+
+  /// Returns true if this index covers every animation in the document.
+  bool complete() const { return complete_; }
+
+  /// Mark the index as not covering every animation in the document.
+  void markIncomplete() { complete_ = false; }
+
+  /// Sort the recorded boundaries and intervals; call once after the last add.
+  void finalize() {
+    std::sort(boundaries_.begin(), boundaries_.end(),
+              [](const Boundary& lhs, const Boundary& rhs) { return lhs.time < rhs.time; });
+    std::sort(varying_.begin(), varying_.end(),
+              [](const Interval& lhs, const Interval& rhs) { return lhs.begin < rhs.begin; });
+
+    maxEndPrefix_.resize(varying_.size());
+    double maxEnd = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < varying_.size(); ++i) {
+      maxEnd = std::max(maxEnd, varying_[i].end);
+      maxEndPrefix_[i] = maxEnd;
+    }
+  }
+
+  /**
+   * Returns true if any animation may sample a different value, or be in a different phase, at
+   * \p toTime than at \p fromTime.
+   */
+  bool changesBetween(double fromTime, double toTime) const {
+    if (!complete_) {
+      return true;
+    }
+    if (fromTime == toTime) {
+      return false;
+    }
+
+    const double lo = std::min(fromTime, toTime);
+    const double hi = std::max(fromTime, toTime);
+
+    // Phases are `t < begin`, `begin <= t < end` and `t >= end`, so crossing a boundary `b` means
+    // `lo < b <= hi`.
+    const auto boundary = firstBoundaryAfter(lo);
+    if (boundary != boundaries_.end() && boundary->time <= hi) {
+      return true;
+    }
+
+    // No phase changed, so a varying animation is active at both times iff it is active at `lo`.
+    const auto firstAfter = std::upper_bound(
+        varying_.begin(), varying_.end(), lo,
+        [](double time, const Interval& interval) { return time < interval.begin; });
+    if (firstAfter == varying_.begin()) {
+      return false;
+    }
+    return maxEndPrefix_[static_cast<std::size_t>(firstAfter - varying_.begin()) - 1] > lo;
+  }
+
+  /**
+   * Collect, in document order, the animations whose phase or value may differ at \p toTime from
+   * \p fromTime: those with a phase boundary between the two times, and the varying animations
+   * that were active at \p fromTime, which must have been the last advanced time.
+   *
+   * @param fromTime Time the animations were last advanced to.
+   * @param toTime Time being advanced to.
+   * @param out Receives the animations, replacing its contents.
+   */
+  void collectChangedBetween(double fromTime, double toTime, std::vector<Entity>& out) const {
+    out = activeVarying_;
+
+    const double lo = std::min(fromTime, toTime);
+    const double hi = std::max(fromTime, toTime);
+    for (auto it = firstBoundaryAfter(lo); it != boundaries_.end() && it->time <= hi; ++it) {
+      out.push_back(it->animation);
+    }
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+  }
+
+  /// Number of recorded phase boundaries, for tests.
+  std::size_t boundaryCount() const { return boundaries_.size(); }
+
+  /// Number of recorded varying intervals, for tests.
+  std::size_t varyingIntervalCount() const { return varying_.size(); }
+
+private:
+  /// Time at which an animation changes phase.
+  struct Boundary {
+    double time;
+    Entity animation;
+  };
+
+  /// Half-open active interval of a varying animation.
+  struct Interval {
+    double begin;
+    double end;
+  };
+
+  /// First boundary strictly after \p time.
+  std::vector<Boundary>::const_iterator firstBoundaryAfter(double time) const {
+    return std::upper_bound(
+        boundaries_.begin(), boundaries_.end(), time,
+        [](double value, const Boundary& boundary) { return value < boundary.time; });
+  }
+
+  std::vector<Boundary> boundaries_;  //!< Sorted by time.
+  std::vector<Interval> varying_;     //!< Sorted by begin.
+  std::vector<double> maxEndPrefix_;  //!< Running maximum of `varying_[0..i].end`.
+  std::unordered_map<Entity, std::vector<Entity>> targets_;  //!< Target to its animations.
+  std::vector<Entity> unresolvedTargets_;  //!< Animations without a resolved target.
+  std::vector<Entity> activeVarying_;  //!< Varying animations active at \ref advancedTime_.
+  double advancedTime_ = 0.0;          //!< Time of the last advance.
+  bool complete_ = true;
+};
+
+}  // namespace donner::svg::components
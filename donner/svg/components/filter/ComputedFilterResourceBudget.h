@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -99,7 +100,7 @@ public:
    */
   std::shared_ptr<const std::vector<std::uint8_t>> shareImage(
       Entity sourceEntity, std::uint64_t sourceRevision,
-      const std::vector<std::uint8_t>& sourcePixels) {
+      std::span<const std::uint8_t> sourcePixels) {
     pruneExpiredSharedImages();
     if (sourcePixels.empty()) {
       return nullptr;
@@ -121,7 +122,8 @@ public:
       return nullptr;
     }
 
-    auto pixels = makeSharedPixels(std::vector<std::uint8_t>(sourcePixels));
+    auto pixels =
+        makeSharedPixels(std::vector<std::uint8_t>(sourcePixels.begin(), sourcePixels.end()));
     sharedImages_.insert_or_assign(key, SharedImageEntry{pixels, bytes});
     return pixels;
   }
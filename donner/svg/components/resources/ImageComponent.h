@@ -32,8 +32,15 @@ struct LoadedImageComponent {
   /// Monotonic identity for the current decoded image payload.
   std::uint64_t revision() const { return revision_; }
 
-  /// Mark a direct mutation of the decoded image payload.
-  void markImageModified() { revision_ = NextRevision(); }
+  /// Mark a direct mutation of the decoded image payload. Edits go to \ref ImageResource::data:
+  /// call \ref ImageResource::detach before editing borrowed pixels in place. Owned pixels win
+  /// over any process-wide shared entry still attached, whose derived forms no longer match.
+  void markImageModified() {
+    if (image && !image->data.empty()) {
+      image->shared.reset();
+    }
+    revision_ = NextRevision();
+  }
 
   std::optional<ImageResource> image;  //!< Loaded image resource.
 
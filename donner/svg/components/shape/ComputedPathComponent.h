@@ -1,10 +1,12 @@
 #pragma once
 /// @file
 
+#include <memory>
 #include <optional>
 
 #include "donner/base/Path.h"
 #include "donner/base/RcString.h"
+#include "donner/base/SharedGeometry.h"
 
 namespace donner::svg::components {
 
@@ -49,6 +51,10 @@ struct ComputedPathComponent {
    */
   std::optional<RcString> sourcePathData;
 
+  /// Lazily-populated cache for `sharedGeometry()`. Public for the same aggregate reason as
+  /// \ref cachedLocalBounds.
+  mutable std::shared_ptr<const SharedGeometry> cachedGeometry;
+
   /**
    * Returns the tight fill bounds of the path in local (pre-transform) space.
    *
@@ -67,6 +73,23 @@ struct ComputedPathComponent {
     return *cachedLocalBounds;
   }
 
+  /**
+   * Returns the interned, single-precision copy of \ref spline that renderer backends derive
+   * their conversions from.
+   *
+   * Interned on first call, so every shape in the process with an identical outline - repeated
+   * icons, `<use>` instances, the same document loaded twice - shares one buffer and one set of
+   * backend conversions. \ref spline stays the source of truth for geometric queries (bounds,
+   * hit-testing, markers), which need its double precision. Invalidated along with the rest of
+   * the component whenever `ShapeSystem` rebuilds it.
+   */
+  const std::shared_ptr<const SharedGeometry>& sharedGeometry() const {
+    if (!cachedGeometry) {
+      cachedGeometry = SharedGeometry::Intern(spline);
+    }
+    return cachedGeometry;
+  }
+
   /**
    * Returns the tight bounds of the shape, transformed to the target coordinate system.
    *
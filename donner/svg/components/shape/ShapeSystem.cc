@@ -1,11 +1,16 @@
 #include "donner/svg/components/shape/ShapeSystem.h"
 
 #include <concepts>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "donner/base/ParseWarningSink.h"
 #include "donner/base/xml/components/TreeComponent.h"
 #include "donner/svg/components/DocumentResourceFamilyBudget.h"
 #include "donner/svg/components/GeometryPreparationResourceBudget.h"
+#include "donner/svg/components/PrepareWorkers.h"
 #include "donner/svg/components/SVGDocumentContext.h"
 #include "donner/svg/components/layout/LayoutSystem.h"
 #ifdef DONNER_TEXT_ENABLED
@@ -167,7 +172,8 @@ ComputedPathComponent* emplaceComputedPathIfChanged(
   // two-step write would let them observe a keyless component. The arguments are positional, so
   // they track ComputedPathComponent's member order.
   return &handle.emplace_or_replace<ComputedPathComponent>(
-      std::move(newPath), /*cachedLocalBounds=*/std::nullopt, std::move(sourcePathData));
+      std::move(newPath), /*cachedLocalBounds=*/std::nullopt, std::move(sourcePathData),
+      /*cachedGeometry=*/nullptr);
 }
 
 /**
@@ -229,8 +235,76 @@ bool IsDisplayNone(EntityHandle handle, ParseWarningSink& warningSink) {
   return style.properties && style.properties->display.get().value() == Display::None;
 }
 
+/// Returns the path data \p path would be parsed from by a shape pass, or nothing if the pass
+/// reuses the retained spline, resolves `d` from CSS, or does not parse at all.
+std::optional<RcString> PathDataToPreparse(const Registry& registry, Entity entity,
+                                           const PathComponent& path,
+                                           const ComputedStyleComponent& style) {
+  if (path.splineOverride || !path.d.isSpecified() || !style.properties ||
+      style.properties->unparsedProperties.contains("d")) {
+    return std::nullopt;
+  }
+
+  RcString pathData = path.d.get().value();
+  if (const auto* existing = registry.try_get<ComputedPathComponent>(entity);
+      existing && existing->sourcePathData && existing->sourcePathData.value() == pathData) {
+    return std::nullopt;
+  }
+  return pathData;
+}
+
 }  // namespace
 
+/// Path data parsed on worker threads ahead of a shape pass.
+struct ShapeSystem::PreparsedPathData {
+  /// One path-data string and its parse result.
+  struct Entry {
+    RcString pathData;                        //!< Parsed string.
+    std::optional<ParseResult<Path>> result;  //!< Parse result, until taken.
+  };
+
+  /// Takes the parse result for \p entity if it was parsed from \p pathData.
+  std::optional<ParseResult<Path>> take(Entity entity, const RcString& pathData) {
+    const auto it = entryByEntity.find(entity);
+    if (it == entryByEntity.end() || entries[it->second].pathData != pathData) {
+      return std::nullopt;
+    }
+    return std::exchange(entries[it->second].result, std::nullopt);
+  }
+
+  /// Parsed strings, in shape pass order.
+  std::vector<Entry> entries;
+
+  /// Index into \ref entries for each entity.
+  std::unordered_map<Entity, std::size_t> entryByEntity;
+};
+
+void ShapeSystem::preparsePathData(Registry& registry, PreparsedPathData& preparsed) {
+  for (auto view = registry.view<PathComponent, ComputedStyleComponent>(); auto entity : view) {
+    auto [path, style] = view.get(entity);
+    if (std::optional<RcString> pathData = PathDataToPreparse(registry, entity, path, style)) {
+      preparsed.entryByEntity.emplace(entity, preparsed.entries.size());
+      preparsed.entries.push_back({std::move(pathData.value()), std::nullopt});
+    }
+  }
+
+  const std::size_t workerCount = PrepareWorkerCount(registry, preparsed.entries.size());
+  if (workerCount <= 1) {
+    preparsed.entries.clear();
+    preparsed.entryByEntity.clear();
+    return;
+  }
+
+  // Parsing reads only the strings gathered above, never the registry.
+  ForEachPrepareRange(registry, preparsed.entries.size(), workerCount,
+                      [&](std::size_t, std::size_t begin, std::size_t end) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                          PreparsedPathData::Entry& entry = preparsed.entries[i];
+                          entry.result = parser::PathParser::Parse(entry.pathData);
+                        }
+                      });
+}
+
 ComputedPathComponent* ShapeSystem::createComputedPathIfShape(EntityHandle handle,
                                                               const FontMetrics& fontMetrics,
                                                               ParseWarningSink& warningSink) {
@@ -259,6 +333,13 @@ ComputedPathComponent* ShapeSystem::createComputedPathIfShape(EntityHandle handl
 }
 
 void ShapeSystem::instantiateAllComputedPaths(Registry& registry, ParseWarningSink& warningSink) {
+  // Parsing path data is the expensive part of the pass. The pass below still runs serially in
+  // view order and only swaps each parse for its preparsed result, so budgets, diagnostics and
+  // component updates happen exactly as in a serial pass.
+  PreparsedPathData preparsed;
+  preparsePathData(registry, preparsed);
+  preparsedPaths_ = preparsed.entries.empty() ? nullptr : &preparsed;
+
   ForEachShape<AllShapes>([&]<typename ShapeType>() {
     for (auto view = registry.view<ShapeType, ComputedStyleComponent>(); auto entity : view) {
       auto [shape, style] = view.get(entity);
@@ -270,6 +351,8 @@ void ShapeSystem::instantiateAllComputedPaths(Registry& registry, ParseWarningSi
     const bool shouldExit = false;
     return shouldExit;
   });
+
+  preparsedPaths_ = nullptr;
 }
 
 std::optional<Box2d> ShapeSystem::getShapeBounds(EntityHandle handle) {
@@ -435,7 +518,12 @@ ComputedPathComponent* ShapeSystem::createComputedShapeWithStyle(
       return existing;
     }
 
-    auto maybePath = parser::PathParser::Parse(pathData);
+    std::optional<ParseResult<Path>> preparsed;
+    if (preparsedPaths_ != nullptr) {
+      preparsed = preparsedPaths_->take(handle.entity(), pathData);
+    }
+    ParseResult<Path> maybePath =
+        preparsed ? std::move(preparsed.value()) : parser::PathParser::Parse(pathData);
     const bool hadDiagnostic = maybePath.hasError();
     if (hadDiagnostic) {
       // Propagate warnings, which may be set on success too.
@@ -113,6 +113,14 @@ private:
   using AllShapes = entt::type_list<CircleComponent, EllipseComponent, LineComponent, PathComponent,
                                     PolyComponent, RectComponent>;
 
+  struct PreparsedPathData;
+
+  /**
+   * On large documents, parse the path data of every `<path>` the shape pass will parse, on worker
+   * threads. Leaves \p preparsed empty when the pass should parse serially.
+   */
+  static void preparsePathData(Registry& registry, PreparsedPathData& preparsed);
+
   /**
    * Get the tight bounds for the given entity in a specific coordinate space, if it has a shape
    * component.
@@ -159,6 +167,10 @@ private:
                                                       const ComputedStyleComponent& style,
                                                       const FontMetrics& fontMetrics,
                                                       ParseWarningSink& warningSink);
+
+  /// Parse results taken by the \ref PathComponent overload of \ref createComputedShapeWithStyle
+  /// in place of parsing, set while \ref instantiateAllComputedPaths runs a parallel pass.
+  PreparsedPathData* preparsedPaths_ = nullptr;
 };
 
 /**
@@ -7,10 +7,13 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "donner/base/ParseWarningSink.h"
 #include "donner/base/tests/BaseTestUtils.h"
 #include "donner/base/tests/ParseResultTestUtils.h"
 #include "donner/svg/SVGPathElement.h"
+#include "donner/svg/components/PrepareWorkers.h"
 #include "donner/svg/components/shape/ComputedPathComponent.h"
 #include "donner/svg/components/style/StyleSystem.h"
 #include "donner/svg/parser/SVGParser.h"
@@ -883,4 +886,72 @@ TEST_F(ShapeSystemPathCacheTest, MalformedPathDataReportsDiagnosticOnEveryPass)
   EXPECT_TRUE(secondSink.hasWarnings());
 }
 
+// --- Parallel path-data parsing ---
+
+TEST_F(ShapeSystemTest, ParallelPathParsingMatchesSerial) {
+  // Enough paths to split across workers, with malformed data whose diagnostics must arrive in
+  // the same order as a serial pass.
+  std::string svg = R"(<svg xmlns="http://www.w3.org/2000/svg" viewBox="0 0 1000 1000">)";
+  for (int i = 0; i < 600; ++i) {
+    svg += "<path id=\"p" + std::to_string(i) + "\" d=\"M" + std::to_string(i) + " 0 C 10 " +
+           std::to_string(i % 17) + " 20 30 40 " + std::to_string(i % 5) +
+           (i % 97 == 0 ? " Q" : " Z") + "\"/>";
+  }
+  svg += "</svg>";
+
+  auto computeShapes = [&](std::size_t threadCount, ParseWarningSink& warningSink) {
+    auto document = ParseSVG(svg);
+    document.setPrepareThreadCount(threadCount);
+    StyleSystem().computeAllStyles(document.registry(), warningSink);
+    shapeSystem.instantiateAllComputedPaths(document.registry(), warningSink);
+    return document;
+  };
+
+  ParseWarningSink serialSink;
+  ParseWarningSink parallelSink;
+  auto serial = computeShapes(1, serialSink);
+  auto parallel = computeShapes(4, parallelSink);
+
+  EXPECT_TRUE(serialSink.hasWarnings());
+  EXPECT_EQ(parallelSink.warnings(), serialSink.warnings());
+
+  for (int i = 0; i < 600; ++i) {
+    const std::string selector = "#p" + std::to_string(i);
+    auto expectedElement = serial.querySelector(selector);
+    auto actualElement = parallel.querySelector(selector);
+    ASSERT_TRUE(expectedElement.has_value() && actualElement.has_value());
+
+    const auto* expected = expectedElement->entityHandle().try_get<ComputedPathComponent>();
+    const auto* actual = actualElement->entityHandle().try_get<ComputedPathComponent>();
+    ASSERT_THAT(expected, NotNull());
+    ASSERT_THAT(actual, NotNull());
+    EXPECT_TRUE(actual->spline == expected->spline) << selector;
+    EXPECT_EQ(actual->sourcePathData, expected->sourcePathData) << selector;
+  }
+}
+
+TEST_F(ShapeSystemTest, ParallelStagesShareOneWorkerPool) {
+  std::string svg = R"(<svg xmlns="http://www.w3.org/2000/svg" viewBox="0 0 1000 1000">)";
+  svg += "<style>path { fill: red }</style>";
+  for (int i = 0; i < 600; ++i) {
+    svg += "<path d=\"M" + std::to_string(i) + " 0 L 10 20 Z\"/>";
+  }
+  svg += "</svg>";
+
+  auto document = ParseSVG(svg);
+  document.setPrepareThreadCount(4);
+  Registry& registry = document.registry();
+  ParseWarningSink warningSink;
+
+  // Selector matching starts the pool, and path parsing runs on the same threads.
+  StyleSystem().computeAllStyles(registry, warningSink);
+  ASSERT_TRUE(registry.ctx().contains<PrepareWorkerPoolContext>());
+  const WorkerPool* pool = registry.ctx().get<PrepareWorkerPoolContext>().pool.get();
+  ASSERT_THAT(pool, NotNull());
+  EXPECT_EQ(pool->threadCount(), 4u);
+
+  shapeSystem.instantiateAllComputedPaths(registry, warningSink);
+  EXPECT_EQ(registry.ctx().get<PrepareWorkerPoolContext>().pool.get(), pool);
+}
+
 }  // namespace donner::svg::components
@@ -31,11 +31,14 @@ struct StyleComponent {
    * tool that toggles one property - should use \ref updateStyle instead.
    *
    * @param style The value of the `style` attribute.
+   * @param cache Optional document-scoped cache, so that elements sharing the same `style`
+   *   string share one parse of it.
    */
-  bool setStyle(std::string_view style) {
+  bool setStyle(std::string_view style, StyleAttributeCache* cache = nullptr) {
     PropertyRegistry candidate = properties;
     candidate.clearStyleAttributeProperties();
-    if (!candidate.parseStyle(style)) {
+    const bool accepted = cache ? candidate.parseStyle(style, *cache) : candidate.parseStyle(style);
+    if (!accepted) {
       styleParseRejected = true;
       return false;
     }
@@ -1,5 +1,12 @@
 #include "donner/svg/components/style/StyleSystem.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
 #include "donner/base/EcsRegistry.h"
 #include "donner/base/ParseWarningSink.h"
 #include "donner/base/xml/XMLQualifiedName.h"
@@ -12,6 +19,7 @@
 #include "donner/svg/components/DirtyFlagsComponent.h"
 #include "donner/svg/components/ElementTypeComponent.h"
 #include "donner/svg/components/IdComponent.h"
+#include "donner/svg/components/PrepareWorkers.h"
 #include "donner/svg/components/StylesheetComponent.h"
 #include "donner/svg/components/resources/ResourceManagerContext.h"
 #include "donner/svg/components/shadow/ShadowEntityComponent.h"
@@ -181,6 +189,27 @@ std::optional<MatchedSelectorEntry> MatchSelectorRule(const css::SelectorRule& r
   return std::nullopt;
 }
 
+/// Matches one element against \p rules in order, appending each match to \p matches with the
+/// rule's index in \p rules, and the traversal steps each rule took to \p ruleSteps. Returns false
+/// if the traversal budget rejected the matching.
+bool MatchAllRules(std::span<const css::SelectorRule* const> rules,
+                   const ShadowedElementAdapter& adapter, css::SelectorTraversalBudget& budget,
+                   std::vector<std::pair<std::size_t, css::Specificity>>& matches,
+                   std::vector<std::uint32_t>& ruleSteps) {
+  for (std::size_t ruleOrdinal = 0; ruleOrdinal < rules.size(); ++ruleOrdinal) {
+    const std::size_t stepsBefore = budget.steps();
+    const auto match = MatchSelectorRule(*rules[ruleOrdinal], adapter, &budget);
+    if (budget.rejected()) {
+      return false;
+    }
+    ruleSteps.push_back(static_cast<std::uint32_t>(budget.steps() - stepsBefore));
+    if (match) {
+      matches.emplace_back(ruleOrdinal, match->specificity);
+    }
+  }
+  return true;
+}
+
 std::optional<std::size_t> ResolveOffset(const SourceRange& range, std::string_view source,
                                          bool end) {
   const FileOffset resolved = (end ? range.end : range.start).resolveOffset(source);
@@ -214,6 +243,135 @@ void ApplyRuleDeclarations(const css::SelectorRule& rule, css::Specificity speci
 
 }  // namespace
 
+/**
+ * Selector matches found on worker threads ahead of a cascade pass.
+ *
+ * Each element records the selector traversal steps its matching took, so the cascade can charge
+ * them to the pass budget and use the matches only when matching serially would have consumed the
+ * same budget without being rejected.
+ */
+struct StyleSystem::PrecomputedSelectorMatches {
+  /// One rule that matched an element: the rule's index across all stylesheets, in cascade scan
+  /// order, and the specificity of the matched selector entry.
+  using Match = std::pair<std::size_t, css::Specificity>;
+
+  /// Matches of one element.
+  struct Element {
+    Entity entity = entt::null;  //!< Element entity, to reject a recycled entity index.
+    std::size_t worker = 0;      //!< Worker whose scratch holds the matches.
+    std::size_t begin = 0;       //!< Index of the first match in the worker scratch.
+    std::size_t end = 0;         //!< One past the last match.
+    std::size_t stepsBegin = 0;  //!< Index of the first rule's step count in the worker scratch.
+    bool complete = false;  //!< False if matching hit the traversal limit and must be repeated.
+  };
+
+  /// Returns the complete matches for \p entity, or nullptr if it must be matched serially.
+  const Element* find(Entity entity) const {
+    const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+    if (index < elements.size() && elements[index].entity == entity && elements[index].complete) {
+      return &elements[index];
+    }
+    return nullptr;
+  }
+
+  /// Matches of \p element, in cascade scan order.
+  std::span<const Match> matches(const Element& element) const {
+    return std::span<const Match>(workerMatches[element.worker])
+        .subspan(element.begin, element.end - element.begin);
+  }
+
+  /// Selector traversal steps matching each rule against \p element took, in cascade scan order.
+  std::span<const std::uint32_t> ruleSteps(const Element& element, std::size_t ruleCount) const {
+    return std::span<const std::uint32_t>(workerRuleSteps[element.worker])
+        .subspan(element.stepsBegin, ruleCount);
+  }
+
+  /// Per-element results, indexed by entity index.
+  std::vector<Element> elements;
+
+  /// Match storage, one vector per worker so workers append without synchronization.
+  std::vector<std::vector<Match>> workerMatches;
+
+  /// Per-rule traversal step counts, one vector per worker like \ref workerMatches.
+  std::vector<std::vector<std::uint32_t>> workerRuleSteps;
+
+  /// Number of rules every element was matched against.
+  std::size_t ruleCount = 0;
+};
+
+std::optional<StyleSystem::PrecomputedSelectorMatches> StyleSystem::precomputeSelectorMatches(
+    Registry& registry, std::span<const Entity> entities) {
+  const std::size_t workerCount = PrepareWorkerCount(registry, entities.size());
+  if (workerCount <= 1) {
+    return std::nullopt;
+  }
+
+  std::vector<const css::SelectorRule*> rules;
+  for (auto view = registry.view<StylesheetComponent>(); auto stylesheetEntity : view) {
+    for (const css::SelectorRule& rule :
+         view.get<StylesheetComponent>(stylesheetEntity).stylesheet.rules()) {
+      rules.push_back(&rule);
+    }
+  }
+  // A pass over more rule-element pairs than the budget allows is rejected partway by the serial
+  // cascade, so matching all of them ahead of time would only be wasted work. This also bounds
+  // the per-rule step counts kept below.
+  const StyleResourceBudget::Limits& limits = GetStyleResourceBudget(registry).limits();
+  if (rules.empty() || rules.size() > limits.ruleElementMatches / entities.size()) {
+    return std::nullopt;
+  }
+
+  // Workers only read the registry. Looking up a pool that does not exist yet would create it, so
+  // materialize every pool the selector adapter reads while the registry is still quiescent.
+  static_cast<void>(registry.storage<donner::components::TreeComponent>());
+  static_cast<void>(registry.storage<donner::components::AttributesComponent>());
+  static_cast<void>(registry.storage<ClassComponent>());
+  static_cast<void>(registry.storage<ElementTypeComponent>());
+  static_cast<void>(registry.storage<IdComponent>());
+  static_cast<void>(registry.storage<ShadowEntityComponent>());
+
+  std::size_t elementSlots = 0;
+  for (const Entity entity : entities) {
+    elementSlots =
+        std::max(elementSlots, static_cast<std::size_t>(entt::to_entity(entity)) + 1);
+  }
+
+  PrecomputedSelectorMatches result;
+  result.elements.resize(elementSlots);
+  result.workerMatches.resize(workerCount);
+  result.workerRuleSteps.resize(workerCount);
+  result.ruleCount = rules.size();
+  const std::size_t maximumSteps = limits.selectorTraversalSteps;
+
+  ForEachPrepareRange(
+      registry, entities.size(), workerCount,
+      [&](std::size_t worker, std::size_t begin, std::size_t end) {
+        std::vector<PrecomputedSelectorMatches::Match>& scratch = result.workerMatches[worker];
+        std::vector<std::uint32_t>& stepScratch = result.workerRuleSteps[worker];
+        for (std::size_t i = begin; i < end; ++i) {
+          const Entity entity = entities[i];
+          const auto* shadowComponent = registry.try_get<ShadowEntityComponent>(entity);
+          const ShadowedElementAdapter adapter(
+              registry, entity, shadowComponent ? shadowComponent->lightEntity : entity);
+
+          PrecomputedSelectorMatches::Element& element =
+              result.elements[static_cast<std::size_t>(entt::to_entity(entity))];
+          element.entity = entity;
+          element.worker = worker;
+          element.begin = scratch.size();
+          element.stepsBegin = stepScratch.size();
+
+          // Each element gets a fresh budget; the cascade charges each rule's steps to the pass
+          // budget as it reaches the rule.
+          css::SelectorTraversalBudget budget(maximumSteps);
+          element.complete = MatchAllRules(rules, adapter, budget, scratch, stepScratch);
+          element.end = scratch.size();
+        }
+      });
+
+  return result;
+}
+
 const ComputedStyleComponent& StyleSystem::computeStyle(EntityHandle handle,
                                                         ParseWarningSink& warningSink) {
   auto& computedStyle = handle.get_or_emplace<ComputedStyleComponent>();
@@ -258,18 +416,50 @@ void StyleSystem::applyStylesheetRules(Registry& registry, Entity treeEntity, En
                                        PropertyRegistry& properties,
                                        StyleResourceBudget& styleBudget,
                                        ParseWarningSink& warningSink) {
+  // Matches found ahead of time are consumed rule by rule, charging each rule's traversal steps
+  // at the point serial matching would have spent them. Once a rule's steps no longer fit, that
+  // rule and the rest are matched here, so a rejection lands on the same step.
+  const PrecomputedSelectorMatches::Element* precomputed = nullptr;
+  if (precomputedMatches_ != nullptr) {
+    precomputed = precomputedMatches_->find(treeEntity);
+  }
+  std::span<const PrecomputedSelectorMatches::Match> precomputedMatches;
+  std::span<const std::uint32_t> precomputedSteps;
+  if (precomputed != nullptr) {
+    precomputedMatches = precomputedMatches_->matches(*precomputed);
+    precomputedSteps = precomputedMatches_->ruleSteps(*precomputed, precomputedMatches_->ruleCount);
+  }
+
   const ShadowedElementAdapter adapter(registry, treeEntity, dataEntity);
+  std::size_t ruleOrdinal = 0;
   for (auto view = registry.view<StylesheetComponent>(); auto stylesheetEntity : view) {
     const auto& stylesheet = view.get<StylesheetComponent>(stylesheetEntity);
     for (const css::SelectorRule& rule : stylesheet.stylesheet.rules()) {
       if (!styleBudget.reserveRuleElementMatch()) {
         return;
       }
-      auto match = MatchSelectorRule(rule, adapter, &styleBudget.selectorTraversal());
-      if (!match) {
+
+      if (precomputed != nullptr &&
+          (ruleOrdinal >= precomputedSteps.size() ||
+           !styleBudget.chargeSelectorTraversalSteps(precomputedSteps[ruleOrdinal]))) {
+        precomputed = nullptr;
+      }
+
+      std::optional<css::Specificity> matchedSpecificity;
+      if (precomputed != nullptr) {
+        if (!precomputedMatches.empty() && precomputedMatches.front().first == ruleOrdinal) {
+          matchedSpecificity = precomputedMatches.front().second;
+          precomputedMatches = precomputedMatches.subspan(1);
+        }
+      } else if (auto match = MatchSelectorRule(rule, adapter, &styleBudget.selectorTraversal())) {
+        matchedSpecificity = match->specificity;
+      }
+      ++ruleOrdinal;
+
+      if (!matchedSpecificity) {
         continue;
       }
-      css::Specificity specificity = match->specificity;
+      css::Specificity specificity = *matchedSpecificity;
       if (stylesheet.isUserAgentStylesheet) {
         specificity = specificity.toUserAgentSpecificity();
       }
@@ -529,10 +719,21 @@ void StyleSystem::computeAllStyles(Registry& registry, ParseWarningSink& warning
     std::ignore = registry.get_or_emplace<ComputedStyleComponent>(entity);
   }
 
+  // On large documents, match selectors for the whole tree on worker threads first. The cascade
+  // below still runs in tree order and charges the budgets as serial matching would, so the
+  // computed styles do not depend on the worker count.
+  std::optional<PrecomputedSelectorMatches> precomputed;
+  if (PrepareWorkerCount(registry, view.size()) > 1) {
+    const std::vector<Entity> entities(view.begin(), view.end());
+    precomputed = precomputeSelectorMatches(registry, entities);
+  }
+  precomputedMatches_ = precomputed ? &precomputed.value() : nullptr;
+
   // Compute the styles for all elements.
   for (auto entity : view) {
     computeStyle(EntityHandle(registry, entity), warningSink);
   }
+  precomputedMatches_ = nullptr;
 
   ResourceManagerContext& resourceManager = registry.ctx().get<ResourceManagerContext>();
   for (auto view = registry.view<StylesheetComponent>(); auto stylesheetEntity : view) {
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -83,6 +84,15 @@ public:
     return true;
   }
 
+  /**
+   * Charge selector traversal steps spent matching against a separate budget, as if they had
+   * been consumed from this one. Charges nothing and returns false when they would not all fit;
+   * the caller must then repeat the matching against this budget so it rejects at the same step.
+   */
+  [[nodiscard]] bool chargeSelectorTraversalSteps(std::size_t steps) {
+    return !rejected_ && selectorTraversal_.tryConsume(steps);
+  }
+
   [[nodiscard]] bool reserveDeclarationApplication(std::size_t componentCount = 0,
                                                    std::size_t sourceBytes = 0) {
     if (rejected_ || selectorTraversal_.rejected() ||
@@ -296,6 +306,15 @@ public:
   void invalidateAll(EntityHandle handle);
 
 private:
+  struct PrecomputedSelectorMatches;
+
+  /**
+   * Match every stylesheet rule against \p entities on worker threads, ahead of a cascade pass
+   * that computes their styles in order. Returns nothing when the pass should match serially.
+   */
+  static std::optional<PrecomputedSelectorMatches> precomputeSelectorMatches(
+      Registry& registry, std::span<const Entity> entities);
+
   void applyStylesheetRules(Registry& registry, Entity treeEntity, Entity dataEntity,
                             PropertyRegistry& properties, StyleResourceBudget& styleBudget,
                             ParseWarningSink& warningSink);
@@ -305,6 +324,10 @@ private:
                                             PropertyRegistry& properties);
   void computePropertiesInto(EntityHandle handle, ComputedStyleComponent& computedStyle,
                              ParseWarningSink& warningSink);
+
+  /// Matches consulted by \ref applyStylesheetRules in place of matching, set while \ref
+  /// computeAllStyles runs a parallel pass.
+  const PrecomputedSelectorMatches* precomputedMatches_ = nullptr;
 };
 
 }  // namespace donner::svg::components
@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -689,6 +690,21 @@ TEST(StyleResourceBudgetTest, ChargesDeclarationSourceBytesPerApplication) {
   EXPECT_TRUE(budget.rejected());
 }
 
+TEST(StyleResourceBudgetTest, ChargesSelectorTraversalStepsAllOrNothing) {
+  StyleResourceBudget::Limits limits;
+  limits.selectorTraversalSteps = 10;
+  StyleResourceBudget budget(limits);
+
+  EXPECT_TRUE(budget.chargeSelectorTraversalSteps(6));
+  EXPECT_FALSE(budget.chargeSelectorTraversalSteps(5));
+  EXPECT_EQ(budget.selectorTraversal().steps(), 6u);
+  EXPECT_FALSE(budget.selectorTraversal().rejected());
+  EXPECT_FALSE(budget.rejected());
+
+  EXPECT_TRUE(budget.chargeSelectorTraversalSteps(4));
+  EXPECT_EQ(budget.selectorTraversal().steps(), 10u);
+}
+
 TEST_F(StyleSystemTest, ShadowTreeSelectorsMatchSiblingAndAttributeState) {
   auto document = ParseSVG(R"(
     <svg xmlns="http://www.w3.org/2000/svg" viewBox="0 0 100 100">
@@ -740,4 +756,141 @@ TEST_F(StyleSystemTest, ShadowTreeSelectorsMatchSiblingAndAttributeState) {
   EXPECT_DOUBLE_EQ(circleStyle.properties->opacity.get().value(), 0.5);
 }
 
+// --- Parallel selector matching ---
+
+namespace {
+
+/// A document with enough elements to split selector matching across workers, using class,
+/// attribute, descendant, child, and sibling selectors.
+std::string MakeParallelCascadeSvg() {
+  std::string svg = R"(<svg xmlns="http://www.w3.org/2000/svg" viewBox="0 0 100 100"><style>)"
+                    ".c0 { fill: red; } .c1 { stroke: blue; } .c2 { opacity: 0.5; }"
+                    "g.outer rect { stroke-width: 3; } g > .c1 { fill: green; }"
+                    "rect + circle { visibility: hidden; } [data-k=\"3\"] { fill: purple; }"
+                    "circle:last-child { stroke: orange; } #e42 { fill: yellow; }"
+                    "</style>";
+  for (int group = 0; group < 50; ++group) {
+    svg += group % 2 == 0 ? R"(<g class="outer">)" : "<g>";
+    for (int i = 0; i < 8; ++i) {
+      const int index = group * 8 + i;
+      svg += std::string(i % 2 == 0 ? "<rect" : "<circle") + " id=\"e" + std::to_string(index) +
+             "\" class=\"c" + std::to_string(index % 3) + "\" data-k=\"" +
+             std::to_string(index % 7) + "\"/>";
+    }
+    svg += "</g>";
+  }
+  svg += "</svg>";
+  return svg;
+}
+
+/// Prints the computed properties of every element in \p document, in element order.
+std::vector<std::string> ComputedStyleStrings(SVGDocument& document) {
+  std::vector<std::string> result;
+  for (int index = 0; index < 400; ++index) {
+    auto element = document.querySelector("#e" + std::to_string(index));
+    EXPECT_TRUE(element.has_value());
+    if (!element) {
+      continue;
+    }
+
+    const auto* computed = element->entityHandle().try_get<ComputedStyleComponent>();
+    std::ostringstream stream;
+    if (computed != nullptr && computed->properties) {
+      stream << *computed->properties;
+    }
+    result.push_back(stream.str());
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST_F(StyleSystemTest, ParallelSelectorMatchingMatchesSerial) {
+  const std::string svg = MakeParallelCascadeSvg();
+
+  auto serial = ParseSVG(svg);
+  ParseWarningSink serialSink;
+  styleSystem.computeAllStyles(serial.registry(), serialSink);
+
+  auto parallel = ParseSVG(svg);
+  parallel.setPrepareThreadCount(4);
+  ParseWarningSink parallelSink;
+  styleSystem.computeAllStyles(parallel.registry(), parallelSink);
+
+  EXPECT_EQ(parallelSink.warnings(), serialSink.warnings());
+  EXPECT_EQ(ComputedStyleStrings(parallel), ComputedStyleStrings(serial));
+}
+
+TEST_F(StyleSystemTest, ParallelSelectorMatchingRejectsAtSameStepAsSerial) {
+  const std::string svg = MakeParallelCascadeSvg();
+
+  // A traversal limit that runs out partway through the document, so the parallel cascade has to
+  // fall back to live matching at the element where the serial one rejects.
+  StyleResourceBudget::Limits limits;
+  limits.selectorTraversalSteps = 2000;
+
+  auto computeStyles = [&](SVGDocument& document, std::size_t threadCount) {
+    document.setPrepareThreadCount(threadCount);
+    document.registry().ctx().emplace<StyleResourceBudget>(limits);
+    ParseWarningSink warningSink;
+    styleSystem.computeAllStyles(document.registry(), warningSink);
+    return warningSink.warnings();
+  };
+
+  auto serial = ParseSVG(svg);
+  auto parallel = ParseSVG(svg);
+  const auto serialWarnings = computeStyles(serial, 1);
+  const auto parallelWarnings = computeStyles(parallel, 4);
+
+  const auto& serialBudget = serial.registry().ctx().get<StyleResourceBudget>();
+  const auto& parallelBudget = parallel.registry().ctx().get<StyleResourceBudget>();
+  EXPECT_TRUE(serialBudget.rejected());
+  EXPECT_EQ(parallelBudget.rejected(), serialBudget.rejected());
+  EXPECT_EQ(parallelBudget.selectorTraversal().steps(), serialBudget.selectorTraversal().steps());
+  EXPECT_EQ(parallelBudget.ruleElementMatches(), serialBudget.ruleElementMatches());
+  EXPECT_EQ(parallelWarnings, serialWarnings);
+  EXPECT_EQ(ComputedStyleStrings(parallel), ComputedStyleStrings(serial));
+}
+
+// Budgets other than traversal can run out partway through an element's rules. Steps matched
+// ahead of time must then be charged only for the rules the serial cascade reached.
+TEST_F(StyleSystemTest, ParallelSelectorMatchingChargesStepsPerRuleOnExhaustion) {
+  const std::string svg = MakeParallelCascadeSvg();
+
+  StyleResourceBudget::Limits declarationLimited;
+  declarationLimited.declarationApplications = 301;
+  StyleResourceBudget::Limits ruleMatchLimited;
+  ruleMatchLimited.ruleElementMatches = 1234;
+  StyleResourceBudget::Limits traversalLimited;
+  traversalLimited.selectorTraversalSteps = 1777;
+
+  for (const StyleResourceBudget::Limits& limits :
+       {declarationLimited, ruleMatchLimited, traversalLimited}) {
+    auto computeStyles = [&](SVGDocument& document, std::size_t threadCount) {
+      document.setPrepareThreadCount(threadCount);
+      document.registry().ctx().emplace<StyleResourceBudget>(limits);
+      ParseWarningSink warningSink;
+      styleSystem.computeAllStyles(document.registry(), warningSink);
+      return warningSink.warnings();
+    };
+
+    auto serial = ParseSVG(svg);
+    auto parallel = ParseSVG(svg);
+    const auto serialWarnings = computeStyles(serial, 1);
+    const auto parallelWarnings = computeStyles(parallel, 4);
+
+    const auto& serialBudget = serial.registry().ctx().get<StyleResourceBudget>();
+    const auto& parallelBudget = parallel.registry().ctx().get<StyleResourceBudget>();
+    EXPECT_TRUE(serialBudget.rejected());
+    EXPECT_EQ(parallelBudget.rejected(), serialBudget.rejected());
+    EXPECT_EQ(parallelBudget.selectorTraversal().steps(),
+              serialBudget.selectorTraversal().steps());
+    EXPECT_EQ(parallelBudget.ruleElementMatches(), serialBudget.ruleElementMatches());
+    EXPECT_EQ(parallelBudget.declarationApplications(), serialBudget.declarationApplications());
+    EXPECT_EQ(parallelBudget.declarationComponentWork(), serialBudget.declarationComponentWork());
+    EXPECT_EQ(parallelWarnings, serialWarnings);
+    EXPECT_EQ(ComputedStyleStrings(parallel), ComputedStyleStrings(serial));
+  }
+}
+
 }  // namespace donner::svg::components
@@ -2,10 +2,12 @@
 /// @file
 
 #include <entt/entity/entity.hpp>  // entt::entity, entt::null
+#include <memory>
 #include <vector>
 
 #include "donner/base/Box.h"
 #include "donner/base/Path.h"
+#include "donner/base/Transform.h"
 #include "donner/base/Vector2.h"
 #include "donner/svg/text/TextTypes.h"
 
@@ -21,10 +23,14 @@ namespace donner::svg::components {
 struct ComputedTextGeometryComponent {
   /**
    * Outline geometry for a single rendered glyph.
+   *
+   * The outline is shared with every other placement of the same glyph at the same size, and
+   * positioned by \ref localFromGlyph rather than copied into local coordinates.
    */
   struct GlyphGeometry {
     entt::entity sourceEntity = entt::null;  ///< Span source entity that owns this glyph.
-    Path path;                               ///< Glyph outline in text-element local coordinates.
+    std::shared_ptr<const Path> outline;     ///< Glyph outline in glyph coordinates.
+    Transform2d localFromGlyph;              ///< Places \ref outline in text-element local space.
     Box2d extent;                            ///< Ink bounds in text-element local coordinates.
   };
 
@@ -42,7 +48,7 @@ struct ComputedTextGeometryComponent {
     bool hasExtent = false;                     ///< True if extent contains real glyph bounds.
   };
 
-  std::vector<GlyphGeometry> glyphs;          ///< Cached glyph outlines for the text root.
+  std::vector<GlyphGeometry> glyphs;          ///< Placed glyph outlines for the text root.
   std::vector<CharacterGeometry> characters;  ///< Cached character metrics in logical order.
   std::vector<TextRun> runs;                  ///< Cached layout runs for renderer reuse.
   Box2d inkBounds;                            ///< Union of glyph ink bounds.
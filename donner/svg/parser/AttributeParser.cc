@@ -29,6 +29,7 @@
 #include "donner/svg/components/ConditionalProcessingComponent.h"
 #include "donner/svg/components/animation/AnimateTransformComponent.h"
 #include "donner/svg/components/animation/AnimateValueComponent.h"
+#include "donner/svg/components/animation/AnimationStateComponent.h"
 #include "donner/svg/components/animation/AnimationTimingComponent.h"
 #include "donner/svg/components/animation/SetAnimationComponent.h"
 #include "donner/svg/components/filter/FilterComponent.h"
@@ -1930,6 +1931,8 @@ std::optional<ParseDiagnostic> ParseAttribute<SVGAnimateElement>(SVGParserContex
                                                                  std::string_view value) {
   auto& timing = element.entityHandle().get<components::AnimationTimingComponent>();
   auto& valueComp = element.entityHandle().get<components::AnimateValueComponent>();
+  // Whatever the attribute, a value sampled from the old attributes must not be held over.
+  components::InvalidateAnimationState(element.entityHandle());
 
   if (name == XMLQualifiedNameRef("attributeName")) {
     valueComp.attributeName = std::string(value);
@@ -1979,6 +1982,7 @@ std::optional<ParseDiagnostic> ParseAttribute<SVGAnimateTransformElement>(
     std::string_view value) {
   auto& timing = element.entityHandle().get<components::AnimationTimingComponent>();
   auto& transformComp = element.entityHandle().get<components::AnimateTransformComponent>();
+  components::InvalidateAnimationState(element.entityHandle());
 
   if (name == XMLQualifiedNameRef("type")) {
     if (value == "translate") {
@@ -2024,6 +2028,7 @@ std::optional<ParseDiagnostic> ParseAttribute<SVGSetElement>(SVGParserContext& c
                                                              std::string_view value) {
   auto& timing = element.entityHandle().get<components::AnimationTimingComponent>();
   auto& setComp = element.entityHandle().get<components::SetAnimationComponent>();
+  components::InvalidateAnimationState(element.entityHandle());
 
   if (name == XMLQualifiedNameRef("attributeName")) {
     setComp.attributeName = std::string(value);
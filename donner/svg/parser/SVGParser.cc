@@ -778,7 +778,16 @@ SVGDocument::Settings PrepareDocumentSettings(const SVGParser::Options& options,
   return settings;
 }
 
+/**
+ * Parse \p source as XML, decompressing it first if it is gzipped.
+ *
+ * @param source Input buffer.
+ * @param sharedSource If set, the same bytes as \p source in a shared buffer, which the parsed
+ *   document references instead of copying.
+ * @param options Parser options.
+ */
 ParseResult<xml::XMLDocument> ParseXmlDocument(std::string_view source,
+                                               const RcString* sharedSource,
                                                const SVGParser::Options& options) {
   xml::XMLParser::Options xmlOptions;
   xmlOptions.parseCustomEntities = true;
@@ -799,7 +808,9 @@ ParseResult<xml::XMLDocument> ParseXmlDocument(std::string_view source,
         std::string_view(reinterpret_cast<char*>(decompressedData.data()), decompressedData.size());
   }
 
-  auto maybeDocument = xml::XMLParser::Parse(source, xmlOptions);
+  auto maybeDocument = sharedSource != nullptr && decompressedData.empty()
+                           ? xml::XMLParser::ParseShared(*sharedSource, xmlOptions)
+                           : xml::XMLParser::Parse(source, xmlOptions);
   if (maybeDocument.hasError()) {
     return std::move(maybeDocument.error());
   }
@@ -808,17 +819,17 @@ ParseResult<xml::XMLDocument> ParseXmlDocument(std::string_view source,
   return document;
 }
 
-}  // namespace
-
-ParseResult<SVGDocument> SVGParser::ParseSVG(std::string_view source, ParseWarningSink& warningSink,
-                                             SVGParser::Options options,
-                                             SVGDocument::Settings settings) noexcept {
+/// Implementation of \ref SVGParser::ParseSVG, with \p sharedSource as for \ref
+/// ParseXmlDocument.
+ParseResult<SVGDocument> ParseSVGSource(std::string_view source, const RcString* sharedSource,
+                                        ParseWarningSink& warningSink, SVGParser::Options options,
+                                        SVGDocument::Settings settings) {
   if (source.size() > options.maximumInputSize) {
     return ParseDiagnostic::Error("SVG source exceeds maximum input size", FileOffset::Offset(0));
   }
 
   settings = PrepareDocumentSettings(options, std::move(settings));
-  auto maybeXmlDocument = ParseXmlDocument(source, options);
+  auto maybeXmlDocument = ParseXmlDocument(source, sharedSource, options);
   if (maybeXmlDocument.hasError()) {
     return std::move(maybeXmlDocument.error());
   }
@@ -839,6 +850,24 @@ ParseResult<SVGDocument> SVGParser::ParseSVG(std::string_view source, ParseWarni
   }
 }
 
+}  // namespace
+
+ParseResult<SVGDocument> SVGParser::ParseSVG(std::string_view source, ParseWarningSink& warningSink,
+                                             SVGParser::Options options,
+                                             SVGDocument::Settings settings) noexcept {
+  return ParseSVGSource(source, nullptr, warningSink, std::move(options), std::move(settings));
+}
+
+ParseResult<SVGDocument> SVGParser::ParseSVG(std::shared_ptr<const MappedFile> source,
+                                             ParseWarningSink& warningSink,
+                                             SVGParser::Options options,
+                                             SVGDocument::Settings settings) noexcept {
+  const std::string_view contents = source->view();
+  const RcString sharedSource = RcString::fromSharedBuffer(std::move(source), contents);
+  return ParseSVGSource(sharedSource, &sharedSource, warningSink, std::move(options),
+                        std::move(settings));
+}
+
 ParseResult<SVGDocument> SVGParser::ParseXMLDocument(xml::XMLDocument&& xmlDocument,
                                                      ParseWarningSink& warningSink,
                                                      SVGParser::Options options,
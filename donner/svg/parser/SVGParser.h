@@ -3,7 +3,9 @@
 
 #include <cstddef>
 #include <istream>
+#include <memory>
 
+#include "donner/base/FileUtils.h"
 #include "donner/base/ParseResult.h"
 #include "donner/base/ParseWarningSink.h"
 #include "donner/base/xml/XMLDocument.h"
@@ -129,6 +131,27 @@ public:
                                            Options options = {},
                                            SVGDocument::Settings settings = {}) noexcept;
 
+  /**
+   * Parses an SVG document from a file mapped with \ref MapFileBounded, without copying it.
+   *
+   * The document's source store and long parsed values (such as path data) reference the mapping
+   * in place, keeping it alive while they are, so loading a large file does not hold several
+   * copies of it. Gzipped (SVGZ) files are decompressed into memory as with the string overload.
+   *
+   * The mapping observes the file, so it must not be truncated or rewritten in place while the
+   * document is alive. Callers that save back to the file they loaded should read it with
+   * \ref ReadFileBounded instead.
+   *
+   * @param source Mapped SVG file, at most \ref Options::maximumInputSize bytes.
+   * @param warningSink Sink to collect warnings encountered during parsing.
+   * @param options Options to modify the parsing behavior.
+   * @param settings Document settings, including the resource loader and processing mode.
+   * @return Parsed SVGDocument, or an error if a fatal error is encountered.
+   */
+  static ParseResult<SVGDocument> ParseSVG(std::shared_ptr<const MappedFile> source,
+                                           ParseWarningSink& warningSink, Options options = {},
+                                           SVGDocument::Settings settings = {}) noexcept;
+
   /**
    * Parses an SVG XML document from an XML document tree.
    *
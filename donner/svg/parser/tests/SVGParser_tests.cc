@@ -3,6 +3,12 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <variant>
+
+#include "donner/base/FileUtils.h"
 #include "donner/base/ParseWarningSink.h"
 #include "donner/base/tests/ParseResultTestUtils.h"
 #include "donner/base/xml/XMLDocument.h"
@@ -63,6 +69,39 @@ TEST(SVGParser, Svgz) {
   EXPECT_THAT(warnings.warnings(), ElementsAre());
 }
 
+TEST(SVGParser, MappedFileIsReferencedInPlace) {
+  constexpr std::string_view kPathData = "M 10 10 L 90 10 L 90 90 L 10 90 Z";
+  const std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / "svg-parser-mapped.svg";
+  {
+    std::ofstream output(path, std::ios::binary);
+    output << R"(<svg xmlns="http://www.w3.org/2000/svg"><path d=")" << kPathData
+           << R"("/></svg>)";
+  }
+
+  FileMapResult mapped = MapFileBounded(path, SVGParser::kDefaultMaximumInputSize);
+  ASSERT_TRUE(std::holds_alternative<std::shared_ptr<const MappedFile>>(mapped));
+  std::shared_ptr<const MappedFile> file = std::get<std::shared_ptr<const MappedFile>>(mapped);
+  const std::string_view contents = file->view();
+  std::weak_ptr<const MappedFile> weakFile = file;
+
+  ParseWarningSink warnings;
+  auto result = SVGParser::ParseSVG(std::move(file), warnings);
+  ASSERT_THAT(result, NoParseError());
+  SVGDocument document = std::move(result.result());
+
+  // The document keeps the mapping alive and references it instead of a copy.
+  EXPECT_FALSE(weakFile.expired());
+  EXPECT_EQ(static_cast<const void*>(document.source().data()),
+            static_cast<const void*>(contents.data()));
+
+  std::optional<RcString> d = document.querySelector("path")->getAttribute("d");
+  ASSERT_TRUE(d.has_value());
+  EXPECT_EQ(*d, kPathData);
+  EXPECT_EQ(static_cast<const void*>(d->data()),
+            static_cast<const void*>(contents.data() + contents.find(kPathData)));
+}
+
 TEST(SVGParser, RejectsInputLargerThanConfiguredLimit) {
   SVGParser::Options options;
   options.maximumInputSize = 64;
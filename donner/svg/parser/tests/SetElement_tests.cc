@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
 #include "donner/base/tests/ParseResultTestUtils.h"
 #include "donner/svg/SVGDocument.h"
 #include "donner/svg/SVGSetElement.h"
@@ -9,7 +14,9 @@
 #include "donner/svg/components/animation/AnimationSystem.h"
 #include "donner/svg/components/animation/AnimationTimingComponent.h"
 #include "donner/svg/components/animation/SetAnimationComponent.h"
+#include "donner/svg/parser/AttributeParser.h"
 #include "donner/svg/parser/SVGParser.h"
+#include "donner/svg/parser/details/SVGParserContext.h"
 #include "donner/svg/renderer/RendererUtils.h"
 
 namespace donner::svg {
@@ -242,4 +249,107 @@ TEST(SVGSetElement, OversizedSetValueConsumesSourceBudgetBeforeCopyingOutput) {
             nullptr);
 }
 
+TEST(SVGSetElement, MutatingActiveSetReplacesHeldValue) {
+  auto document = parseSVGWithExperimental(R"(
+    <svg xmlns="http://www.w3.org/2000/svg">
+      <rect id="r" fill="red" width="100" height="100">
+        <set id="s" attributeName="fill" to="blue" begin="0s" dur="10s" />
+      </rect>
+    </svg>
+  )");
+
+  auto& registry = document.registry();
+  const Entity rect = document.querySelector("#r")->entityHandle().entity();
+  components::AnimationSystem().advance(registry, 1.0, nullptr);
+  ASSERT_NE(registry.try_get<components::AnimatedValuesComponent>(rect), nullptr);
+  EXPECT_EQ(registry.get<components::AnimatedValuesComponent>(rect).overrides.at("fill"), "blue");
+
+  // Still active and in the same phase, so the held value must be dropped by the reparse itself.
+  auto set = document.querySelector("#s");
+  ASSERT_TRUE(set.has_value());
+  ParseWarningSink warnings;
+  const parser::SVGParser::Options options;
+  parser::SVGParserContext context(std::string_view(), warnings, options);
+  const auto reparse = [&](std::string_view name, std::string_view value) {
+    EXPECT_EQ(parser::AttributeParser::ParseAndSetAttribute(context, *set,
+                                                            xml::XMLQualifiedNameRef(name), value),
+              std::nullopt);
+  };
+
+  reparse("to", "green");
+  components::AnimationSystem().advance(registry, 2.0, nullptr);
+  EXPECT_EQ(registry.get<components::AnimatedValuesComponent>(rect).overrides.at("fill"), "green");
+
+  reparse("attributeName", "stroke");
+  components::AnimationSystem().advance(registry, 2.0, nullptr);
+  EXPECT_EQ(registry.get<components::AnimatedValuesComponent>(rect).overrides,
+            (std::unordered_map<std::string, std::string>{{"stroke", "green"}}));
+}
+
+TEST(SVGSetElement, AdvanceResamplesOnlyAnimationsThatCanChange) {
+  auto document = parseSVGWithExperimental(R"(
+    <svg xmlns="http://www.w3.org/2000/svg">
+      <rect id="r" fill="red" width="100" height="100">
+        <set id="s" attributeName="fill" to="blue" begin="0s" dur="10s" />
+        <set attributeName="stroke" to="black" begin="4s" dur="1s" />
+      </rect>
+    </svg>
+  )");
+
+  auto& registry = document.registry();
+  const Entity rect = document.querySelector("#r")->entityHandle().entity();
+  const Entity set = document.querySelector("#s")->entityHandle().entity();
+  components::AnimationSystem().advance(registry, 1.0, nullptr);
+
+  // Edit the component behind the parser's back: an advance that resamples `#s` would pick it up.
+  registry.get<components::SetAnimationComponent>(set).to = "green";
+  components::AnimationSystem().advance(registry, 3.0, nullptr);
+  EXPECT_EQ(registry.get<components::AnimatedValuesComponent>(rect).overrides,
+            (std::unordered_map<std::string, std::string>{{"fill", "blue"}}));
+
+  // Crossing the second animation's begin resamples it alone, and the target keeps both values.
+  components::AnimationSystem().advance(registry, 4.5, nullptr);
+  EXPECT_EQ(registry.get<components::AnimatedValuesComponent>(rect).overrides,
+            (std::unordered_map<std::string, std::string>{{"fill", "blue"}, {"stroke", "black"}}));
+
+  // Crossing `#s`'s end resamples it.
+  components::AnimationSystem().advance(registry, 11.0, nullptr);
+  EXPECT_EQ(registry.try_get<components::AnimatedValuesComponent>(rect), nullptr);
+  components::AnimationSystem().advance(registry, 2.0, nullptr);
+  EXPECT_EQ(registry.get<components::AnimatedValuesComponent>(rect).overrides,
+            (std::unordered_map<std::string, std::string>{{"fill", "green"}}));
+}
+
+TEST(SVGSetElement, IncrementalAdvanceMatchesFullAdvance) {
+  constexpr std::string_view kSvg = R"(
+    <svg xmlns="http://www.w3.org/2000/svg">
+      <rect id="r" fill="red" width="100" height="100">
+        <set attributeName="fill" to="blue" begin="1s" dur="4s" />
+        <animate attributeName="width" from="0" to="100" begin="2s" dur="2s" fill="freeze" />
+        <animate attributeName="fill" values="green;yellow" calcMode="discrete" begin="3s"
+                 dur="1s" />
+        <set attributeName="width" to="7" begin="6s" />
+      </rect>
+    </svg>
+  )";
+
+  auto incremental = parseSVGWithExperimental(kSvg);
+  const Entity rect = incremental.querySelector("#r")->entityHandle().entity();
+  for (const double time : {0.0, 1.5, 2.5, 3.2, 3.9, 2.1, 4.5, 5.5, 7.0, 0.5, 3.6}) {
+    SCOPED_TRACE(testing::Message() << "t=" << time);
+    components::AnimationSystem().advance(incremental.registry(), time, nullptr);
+
+    auto full = parseSVGWithExperimental(kSvg);
+    components::AnimationSystem().advance(full.registry(), time, nullptr);
+    const auto* expected = full.registry().try_get<components::AnimatedValuesComponent>(
+        full.querySelector("#r")->entityHandle().entity());
+    const auto* actual =
+        incremental.registry().try_get<components::AnimatedValuesComponent>(rect);
+    ASSERT_EQ(expected != nullptr, actual != nullptr);
+    if (expected) {
+      EXPECT_EQ(actual->overrides, expected->overrides);
+    }
+  }
+}
+
 }  // namespace donner::svg
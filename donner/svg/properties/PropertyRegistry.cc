@@ -2416,6 +2416,17 @@ bool PropertyRegistry::parseStyle(std::string_view str) {
   return true;
 }
 
+bool PropertyRegistry::parseStyle(std::string_view str, StyleAttributeCache& cache) {
+  const std::shared_ptr<const ParsedStyleAttribute> parsed = cache.parse(str);
+  if (parsed->rejected) {
+    return false;
+  }
+  for (const auto& declaration : parsed->declarations) {
+    std::ignore = parseProperty(declaration, css::Specificity::StyleAttribute());
+  }
+  return true;
+}
+
 void PropertyRegistry::clearStyleAttributeProperties() {
   const css::Specificity styleSpecificity = css::Specificity::StyleAttribute();
 
@@ -37,6 +37,7 @@
 #include "donner/svg/properties/PaintServer.h"
 #include "donner/svg/properties/Property.h"
 #include "donner/svg/properties/PropertyParsing.h"  // IWYU pragma: keep, used for parser::UnparsedProperty
+#include "donner/svg/properties/StyleAttributeCache.h"
 
 namespace donner::svg {
 
@@ -562,6 +563,15 @@ public:
    */
   bool parseStyle(std::string_view str);
 
+  /**
+   * Same as \ref parseStyle, but reuses the declarations parsed for an identical string through
+   * \p cache.
+   *
+   * @param str Input string from a style attribute, e.g. "fill: red; stroke: blue".
+   * @param cache Document-scoped cache of parsed style attributes.
+   */
+  bool parseStyle(std::string_view str, StyleAttributeCache& cache);
+
   /**
    * Clear every property that was set from a `style=""` attribute, leaving presentation
    * attributes (specificity `0,0,0`) and stylesheet-origin declarations intact. Identifies
@@ -0,0 +1,47 @@
+#include "donner/svg/properties/StyleAttributeCache.h"
+
+#include "donner/css/parser/DeclarationListParser.h"
+
+namespace donner::svg {
+
+namespace {
+
+std::shared_ptr<const ParsedStyleAttribute> ParseStyleAttribute(std::string_view style) {
+  auto parsed = std::make_shared<ParsedStyleAttribute>();
+  css::parser::DeclarationListParser::SecurityStats securityStats;
+  parsed->declarations =
+      css::parser::DeclarationListParser::ParseOnlyDeclarations(style, &securityStats);
+  if (securityStats.rejected) {
+    parsed->declarations.clear();
+    parsed->rejected = true;
+  }
+  return parsed;
+}
+
+}  // namespace
+
+std::shared_ptr<const ParsedStyleAttribute> StyleAttributeCache::parse(std::string_view style) {
+  if (auto it = entries_.find(style); it != entries_.end()) {
+    ++stats_.hits;
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+    return it->second.parsed;
+  }
+
+  ++stats_.misses;
+  std::shared_ptr<const ParsedStyleAttribute> parsed = ParseStyleAttribute(style);
+  if (style.size() > kMaxCachedLength) {
+    return parsed;
+  }
+
+  if (entries_.size() >= kMaxEntries) {
+    entries_.erase(entries_.find(lru_.back()));
+    lru_.pop_back();
+  }
+
+  const auto it = entries_.emplace(std::string(style), Entry{parsed, lru_.end()}).first;
+  lru_.push_front(it->first);
+  it->second.lruPosition = lru_.begin();
+  return parsed;
+}
+
+}  // namespace donner::svg
@@ -0,0 +1,95 @@
+#pragma once
+/// @file
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "donner/css/Declaration.h"
+
+namespace donner::svg {
+
+/// Declarations parsed from one `style=""` attribute value, shared between every element of a
+/// document that carries the same string.
+struct ParsedStyleAttribute {
+  /// Declarations in source order, as returned by
+  /// \ref css::parser::DeclarationListParser::ParseOnlyDeclarations.
+  std::vector<css::Declaration> declarations;
+
+  /// True if the string exceeded the declaration parser's resource budget, in which case
+  /// \ref declarations is empty and the attribute must be rejected.
+  bool rejected = false;
+};
+
+/**
+ * Document-scoped, bounded cache from `style=""` attribute strings to their parsed declaration
+ * lists.
+ *
+ * Editor exports such as Inkscape and Illustrator repeat a near-identical `style` string on
+ * thousands of elements. Each distinct string is tokenized and parsed once, and every element
+ * with the same string applies the same immutable \ref ParsedStyleAttribute; only the
+ * per-property value parse in \ref PropertyRegistry still runs per element.
+ *
+ * Lives in the document registry's context, created on first use by \ref
+ * SVGElement::setStyle. Entries are evicted least-recently-used beyond \ref kMaxEntries, and
+ * strings longer than \ref kMaxCachedLength are parsed without being cached, so a document cannot
+ * grow the cache beyond a few megabytes.
+ */
+class StyleAttributeCache {
+public:
+  /// Maximum number of distinct strings kept.
+  static constexpr std::size_t kMaxEntries = 1024;
+
+  /// Longest string that is cached, in bytes. Longer strings are parsed on every call.
+  static constexpr std::size_t kMaxCachedLength = 4096;
+
+  /// Counters for tests and benchmarks.
+  struct Stats {
+    std::size_t hits = 0;    //!< Calls answered from the cache.
+    std::size_t misses = 0;  //!< Calls that parsed the string.
+  };
+
+  /**
+   * Returns the parsed declarations for \p style, parsing it on a miss.
+   *
+   * @param style Value of a `style` attribute, e.g. "fill: red; stroke: blue".
+   */
+  std::shared_ptr<const ParsedStyleAttribute> parse(std::string_view style);
+
+  /// Number of cached strings.
+  std::size_t size() const { return entries_.size(); }
+
+  /// Hit and miss counters since construction.
+  const Stats& stats() const { return stats_; }
+
+private:
+  /// Hash that lets `std::string` keys be looked up by `std::string_view`.
+  struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const {
+      return std::hash<std::string_view>{}(str);
+    }
+  };
+
+  struct Entry {
+    std::shared_ptr<const ParsedStyleAttribute> parsed;
+    std::list<std::string_view>::iterator lruPosition;
+  };
+
+  /// Cached entries, keyed by the attribute string.
+  std::unordered_map<std::string, Entry, StringHash, std::equal_to<>> entries_;
+
+  /// Keys of \ref entries_, most recently used first. Views into the map's keys, which are stable
+  /// for as long as the entry exists.
+  std::list<std::string_view> lru_;
+
+  Stats stats_;
+};
+
+}  // namespace donner::svg
@@ -12,6 +12,7 @@
 #include "donner/svg/SVGDocument.h"
 #include "donner/svg/SVGRectElement.h"
 #include "donner/svg/components/layout/TransformComponent.h"
+#include "donner/svg/components/style/StyleComponent.h"
 
 namespace donner::svg {
 
@@ -1973,6 +1974,26 @@ TEST(PropertyRegistry, TransformPresentationAttribute) {
   EXPECT_TRUE(rect.entityHandle().get<components::TransformComponent>().transform.isSpecified());
 }
 
+TEST(PropertyRegistry, ElementsShareParsedStyleAttributes) {
+  SVGDocument document;
+  std::vector<SVGRectElement> rects;
+  for (int i = 0; i < 3; ++i) {
+    rects.push_back(SVGRectElement::Create(document));
+    rects.back().setStyle("fill:#ff0000;stroke:none");
+  }
+
+  const auto& cache = document.registry().ctx().get<StyleAttributeCache>();
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.stats().misses, 1u);
+  EXPECT_EQ(cache.stats().hits, 2u);
+
+  for (const SVGRectElement& rect : rects) {
+    const auto& style = rect.entityHandle().get<components::StyleComponent>();
+    EXPECT_THAT(style.properties.fill.get(),
+                Optional(PaintServer(PaintServer::Solid(Color(RGBA(0xFF, 0, 0, 0xFF))))));
+  }
+}
+
 TEST(PropertyRegistry, TransformOriginStrokeMiterlimitAndFilterEdgeCases) {
   {
     PropertyRegistry registry;
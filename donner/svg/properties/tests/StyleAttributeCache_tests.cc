@@ -0,0 +1,83 @@
+#include "donner/svg/properties/StyleAttributeCache.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "donner/svg/properties/PropertyRegistry.h"
+
+namespace donner::svg {
+
+using testing::Optional;
+using testing::SizeIs;
+
+TEST(StyleAttributeCache, IdenticalStringsShareOneParse) {
+  StyleAttributeCache cache;
+
+  const auto first = cache.parse("fill:#ff0000;stroke:none;stroke-width:2");
+  const auto second = cache.parse("fill:#ff0000;stroke:none;stroke-width:2");
+  const auto other = cache.parse("fill:#00ff00");
+
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, other);
+  EXPECT_THAT(first->declarations, SizeIs(3));
+  EXPECT_FALSE(first->rejected);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.stats().hits, 1u);
+  EXPECT_EQ(cache.stats().misses, 2u);
+}
+
+TEST(StyleAttributeCache, EvictsLeastRecentlyUsed) {
+  StyleAttributeCache cache;
+  const auto style = [](std::size_t i) { return "stroke-width:" + std::to_string(i); };
+
+  const auto kept = cache.parse(style(0));
+  for (std::size_t i = 1; i < StyleAttributeCache::kMaxEntries; ++i) {
+    cache.parse(style(i));
+  }
+  // Touch the oldest entry so the second-oldest is evicted instead.
+  EXPECT_EQ(cache.parse(style(0)), kept);
+  cache.parse(style(StyleAttributeCache::kMaxEntries));
+
+  EXPECT_EQ(cache.size(), StyleAttributeCache::kMaxEntries);
+  EXPECT_EQ(cache.parse(style(0)), kept);
+  const std::size_t misses = cache.stats().misses;
+  cache.parse(style(1));
+  EXPECT_EQ(cache.stats().misses, misses + 1);
+}
+
+TEST(StyleAttributeCache, LongStringsAreNotCached) {
+  StyleAttributeCache cache;
+  std::string style = "fill:red;";
+  while (style.size() <= StyleAttributeCache::kMaxCachedLength) {
+    style += "stroke:blue;";
+  }
+
+  const auto first = cache.parse(style);
+  EXPECT_NE(cache.parse(style), first);
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.stats().misses, 2u);
+}
+
+TEST(StyleAttributeCache, PropertyRegistryMatchesUncachedParse) {
+  constexpr std::string_view kStyle = "fill: red; stroke: inherit; stroke-width: 3px; bogus: 1";
+  StyleAttributeCache cache;
+
+  for (int i = 0; i < 2; ++i) {
+    PropertyRegistry uncached;
+    PropertyRegistry cached;
+    EXPECT_TRUE(uncached.parseStyle(kStyle));
+    EXPECT_TRUE(cached.parseStyle(kStyle, cache));
+
+    EXPECT_EQ(cached.fill.get(), uncached.fill.get());
+    EXPECT_EQ(cached.fill.specificity, css::Specificity::StyleAttribute());
+    EXPECT_EQ(cached.stroke.state, PropertyState::Inherit);
+    EXPECT_THAT(cached.strokeWidth.get(), Optional(Lengthd(3, Lengthd::Unit::Px)));
+    EXPECT_EQ(cached.unparsedProperties.size(), uncached.unparsedProperties.size());
+  }
+
+  EXPECT_EQ(cache.stats().hits, 1u);
+}
+
+}  // namespace donner::svg
@@ -769,7 +769,8 @@ void ApplyFilterGraphToPixmap(tiny_skia::Pixmap& pixmap, const components::Filte
                               bool clipSourceToFilterRegion,
                               const tiny_skia::Pixmap* fillPaintInput,
                               const tiny_skia::Pixmap* strokePaintInput,
-                              components::FilterExecutionBudget* executionBudget) {
+                              components::FilterExecutionBudget* executionBudget,
+                              tiny_skia::filter::FilterPrecision precision) {
   const std::uint64_t width = pixmap.width();
   const std::uint64_t height = pixmap.height();
   const std::uint64_t pixelCount = width * height;
@@ -787,6 +788,7 @@ void ApplyFilterGraphToPixmap(tiny_skia::Pixmap& pixmap, const components::Filte
                                         static_cast<int>(pixmap.height()));
   tiny_skia::filter::FilterGraph graph =
       CreateExecutableGraph(context, clipSourceToFilterRegion, fillPaintInput, strokePaintInput);
+  graph.precision = precision;
   graph.nodes.reserve(filterGraph.nodes.size());
   for (const components::FilterNode& node : filterGraph.nodes) {
     graph.nodes.push_back(ConvertNode(node, context, graph));
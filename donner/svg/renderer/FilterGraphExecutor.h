@@ -11,6 +11,7 @@
 #include "donner/svg/components/filter/FilterGraph.h"
 #include "donner/svg/renderer/PixelFormatUtils.h"  // IWYU: re-export PremultiplyRgba.
 #include "tiny_skia/Pixmap.h"
+#include "tiny_skia/filter/FilterGraph.h"
 
 namespace donner::svg {
 
@@ -27,6 +28,8 @@ namespace donner::svg {
  * @param strokePaintInput Optional `StrokePaint` input pixmap, or nullptr if unused.
  * @param executionBudget Optional shared per-frame budget. Direct callers may omit it to apply
  *   only the graph-local limit.
+ * @param precision Storage for intermediate results. \ref tiny_skia::filter::FilterPrecision::Uint8
+ *   falls back to float for graphs it does not cover.
  */
 void ApplyFilterGraphToPixmap(tiny_skia::Pixmap& pixmap, const components::FilterGraph& filterGraph,
                               const Transform2d& deviceFromFilter,
@@ -34,7 +37,9 @@ void ApplyFilterGraphToPixmap(tiny_skia::Pixmap& pixmap, const components::Filte
                               bool clipSourceToFilterRegion = false,
                               const tiny_skia::Pixmap* fillPaintInput = nullptr,
                               const tiny_skia::Pixmap* strokePaintInput = nullptr,
-                              components::FilterExecutionBudget* executionBudget = nullptr);
+                              components::FilterExecutionBudget* executionBudget = nullptr,
+                              tiny_skia::filter::FilterPrecision precision =
+                                  tiny_skia::filter::FilterPrecision::Float);
 
 /**
  * Clears pixels outside the transformed filter region.
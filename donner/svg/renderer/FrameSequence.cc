@@ -0,0 +1,66 @@
+#include "donner/svg/renderer/FrameSequence.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace donner::svg {
+
+namespace {
+
+/// Number of frames sampled over \p options, at least one and at most
+/// \ref kMaximumFrameSequenceFrames.
+std::size_t FrameCount(const FrameSequenceOptions& options) {
+  const double duration = options.endTime - options.startTime;
+  if (!(duration > 0.0)) {
+    return 1;
+  }
+
+  // Tolerate rounding in `duration * frameRate` so that e.g. one second at 30 fps is 30 frames,
+  // not 31.
+  constexpr double kFrameEpsilon = 1e-9;
+  const double frames = std::ceil(duration * options.frameRate - kFrameEpsilon);
+  if (!(frames < static_cast<double>(kMaximumFrameSequenceFrames))) {
+    return kMaximumFrameSequenceFrames;
+  }
+  return std::max<std::size_t>(1, static_cast<std::size_t>(frames));
+}
+
+}  // namespace
+
+FrameSequenceStats RenderFrameSequence(
+    RendererInterface& renderer, SVGDocument& document, const FrameSequenceOptions& options,
+    const std::function<bool(const FrameSequenceFrame& frame)>& onFrame) {
+  FrameSequenceStats stats;
+  if (!std::isfinite(options.startTime) || !std::isfinite(options.endTime) ||
+      !std::isfinite(options.frameRate) || options.frameRate <= 0.0) {
+    return stats;
+  }
+
+  const std::size_t frameCount = FrameCount(options);
+  RendererBitmap bitmap;
+  for (std::size_t i = 0; i < frameCount; ++i) {
+    FrameSequenceFrame frame;
+    frame.index = i;
+    frame.time = options.startTime + static_cast<double>(i) / options.frameRate;
+
+    document.setTime(frame.time);
+    frame.reused = i > 0 && !document.hasPendingRenderInvalidation();
+    if (frame.reused) {
+      ++stats.reusedFrames;
+    } else {
+      renderer.draw(document);
+      bitmap = renderer.takeSnapshot();
+      ++stats.renderedFrames;
+    }
+
+    frame.bitmap = &bitmap;
+    ++stats.frames;
+    if (!onFrame(frame)) {
+      break;
+    }
+  }
+
+  return stats;
+}
+
+}  // namespace donner::svg
@@ -0,0 +1,69 @@
+#pragma once
+/// @file
+
+#include <cstddef>
+#include <functional>
+
+#include "donner/svg/SVGDocument.h"
+#include "donner/svg/renderer/RendererInterface.h"
+
+namespace donner::svg {
+
+/// Time range and sampling rate for \ref RenderFrameSequence.
+struct FrameSequenceOptions {
+  /// Document time of the first frame, in seconds.
+  double startTime = 0.0;
+
+  /// End of the range, in seconds, exclusive: frames are sampled at `startTime + i / frameRate`
+  /// while that is before \ref endTime. A range shorter than one frame still yields one frame.
+  double endTime = 0.0;
+
+  /// Frames per second, must be positive.
+  double frameRate = 30.0;
+};
+
+/// One frame produced by \ref RenderFrameSequence.
+struct FrameSequenceFrame {
+  std::size_t index = 0;  //!< Zero-based frame number.
+  double time = 0.0;      //!< Document time the frame was sampled at, in seconds.
+
+  /// True if no animation changed since the previous frame, so the previous raster was reused
+  /// without drawing. Encoders may merge such frames into the previous one.
+  bool reused = false;
+
+  /// Rendered pixels, straight-alpha RGBA as returned by \ref RendererInterface::takeSnapshot.
+  const RendererBitmap* bitmap = nullptr;
+};
+
+/// Counters describing a \ref RenderFrameSequence call.
+struct FrameSequenceStats {
+  std::size_t frames = 0;          //!< Frames passed to the callback.
+  std::size_t renderedFrames = 0;  //!< Frames that were drawn.
+  std::size_t reusedFrames = 0;    //!< Frames that reused the previous raster.
+};
+
+/// Upper bound on the number of frames one \ref RenderFrameSequence call produces.
+inline constexpr std::size_t kMaximumFrameSequenceFrames = 100000;
+
+/**
+ * Render \p document at evenly spaced times over a range, handing each frame to \p onFrame.
+ *
+ * Seeking relies on \ref SVGDocument::setTime, which leaves the render tree intact when no
+ * animation changes between two times. Frames where that happens are not drawn or read back at
+ * all; the previous bitmap is passed again with \ref FrameSequenceFrame::reused set, so a
+ * mostly-static animation costs roughly one render per visible change. Frames that do change are
+ * drawn with the same renderer, reusing whatever retained caches the backend keeps between draws.
+ *
+ * The document's time is left at the last frame's time.
+ *
+ * @param renderer Renderer to draw with.
+ * @param document Document to render.
+ * @param options Time range and frame rate.
+ * @param onFrame Called once per frame, in order; return false to stop early.
+ * @return Counters for the frames produced.
+ */
+FrameSequenceStats RenderFrameSequence(
+    RendererInterface& renderer, SVGDocument& document, const FrameSequenceOptions& options,
+    const std::function<bool(const FrameSequenceFrame& frame)>& onFrame);
+
+}  // namespace donner::svg
@@ -0,0 +1,96 @@
+#include "donner/svg/renderer/GradientLutCache.h"
+
+#include <algorithm>
+#include <bit>
+#include <span>
+
+namespace donner::svg {
+
+namespace {
+
+/// FNV-1a over the bit patterns of the stops. Only used to reject unequal keys early; equal
+/// hashes are always confirmed by comparing the stops.
+std::uint64_t HashKey(std::span<const tiny_skia::GradientStop> stops,
+                      tiny_skia::ColorSpace colorSpace) {
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  const auto mix = [&hash](std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      hash ^= (value >> (i * 8)) & 0xffu;
+      hash *= 0x100000001b3ull;
+    }
+  };
+
+  mix(static_cast<std::uint32_t>(colorSpace));
+  for (const tiny_skia::GradientStop& stop : stops) {
+    mix(std::bit_cast<std::uint32_t>(stop.position.get()));
+    mix(std::bit_cast<std::uint32_t>(stop.color.red()));
+    mix(std::bit_cast<std::uint32_t>(stop.color.green()));
+    mix(std::bit_cast<std::uint32_t>(stop.color.blue()));
+    mix(std::bit_cast<std::uint32_t>(stop.color.alpha()));
+  }
+  return hash;
+}
+
+}  // namespace
+
+void GradientLutCache::attach(tiny_skia::Gradient& gradient, tiny_skia::ColorSpace colorSpace) {
+  const std::span<const tiny_skia::GradientStop> stops = gradient.stops();
+  if (stops.size() <= 2) {
+    return;
+  }
+
+  const std::uint64_t hash = HashKey(stops, colorSpace);
+  for (Entry& entry : entries_) {
+    if (entry.hash == hash && entry.lut->colorSpace == colorSpace &&
+        std::ranges::equal(entry.lut->stops, stops)) {
+      entry.lastUsed = ++useCounter_;
+      gradient.setLut(entry.lut);
+      ++stats_.hits;
+      return;
+    }
+  }
+
+  std::shared_ptr<const tiny_skia::GradientLut> lut = gradient.buildLut(colorSpace);
+  gradient.setLut(lut);
+  ++stats_.misses;
+  if (lut == nullptr || lut->byteSize() > budgetBytes_) {
+    return;
+  }
+
+  stats_.liveBytes += lut->byteSize();
+  entries_.push_back(Entry{hash, std::move(lut), ++useCounter_});
+  evictToBudget();
+}
+
+void GradientLutCache::beginFrame() {
+  const std::size_t liveBytes = stats_.liveBytes;
+  stats_ = GradientLutCacheStats();
+  stats_.liveBytes = liveBytes;
+}
+
+void GradientLutCache::clear() {
+  entries_.clear();
+  stats_.liveBytes = 0;
+}
+
+void GradientLutCache::setBudgetBytes(std::size_t bytes) {
+  budgetBytes_ = bytes;
+  evictToBudget();
+}
+
+void GradientLutCache::evictToBudget() {
+  while (!entries_.empty() &&
+         (stats_.liveBytes > budgetBytes_ || entries_.size() > kMaxEntries)) {
+    auto coldest = std::min_element(
+        entries_.begin(), entries_.end(),
+        [](const Entry& lhs, const Entry& rhs) { return lhs.lastUsed < rhs.lastUsed; });
+    stats_.liveBytes -= coldest->lut->byteSize();
+    if (coldest != entries_.end() - 1) {
+      *coldest = std::move(entries_.back());
+    }
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+}
+
+}  // namespace donner::svg
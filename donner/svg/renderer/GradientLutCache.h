@@ -0,0 +1,88 @@
+#pragma once
+/// @file
+/// Color table cache for multi-stop gradients in the tiny-skia backend.
+///
+/// Every gradient paint is rebuilt from its resolved stops on every draw, and a gradient with
+/// more than two stops is then evaluated per pixel by searching its stop intervals. Charts and
+/// similar documents reuse a handful of gradients across thousands of shapes. This file owns the
+/// storage that lets every draw after the first, on this frame or a later one, attach a color
+/// table sampled once from the same stops, so per-pixel evaluation is a single lookup.
+///
+/// Entries are keyed by what the table is sampled from: the gradient's normalized stops and the
+/// color space they are expanded in. Geometry, transform, and spread mode are applied to `t`
+/// before the lookup, so gradients differing only in those share an entry.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tiny_skia/Color.h"
+#include "tiny_skia/shaders/Gradient.h"
+
+namespace donner::svg {
+
+/// Counters describing what a renderer's gradient color table cache did during the most recent
+/// frame, for tests and benchmarks.
+struct GradientLutCacheStats {
+  std::uint64_t hits = 0;       ///< Multi-stop gradients given an existing table.
+  std::uint64_t misses = 0;     ///< Tables built and stored.
+  std::size_t liveBytes = 0;    ///< Bytes held by the cache at the end of the frame.
+  std::uint64_t evictions = 0;  ///< Entries evicted to stay under budget, this frame.
+};
+
+/**
+ * Renderer-owned cache of \ref tiny_skia::GradientLut tables.
+ *
+ * Lookups are linear over a hash of each key, like \ref MaskCoverageCache. Tables are shared
+ * with the shaders they are attached to, so evicting one never invalidates a paint in flight; it
+ * only means the next draw with those stops builds a new table.
+ */
+class GradientLutCache {
+public:
+  /// Default budget: about 160 tables.
+  static constexpr std::size_t kDefaultBudgetBytes = 4u * 1024u * 1024u;
+
+  /// Entry count ceiling, independent of the byte budget.
+  static constexpr std::size_t kMaxEntries = 256;
+
+  /**
+   * Attaches the color table for \p gradient's stops, building and storing it on a miss.
+   * Gradients with two stops already interpolate in one step and are left untouched.
+   *
+   * @param gradient Gradient to attach the table to.
+   * @param colorSpace Color space the gradient will be drawn in.
+   */
+  void attach(tiny_skia::Gradient& gradient, tiny_skia::ColorSpace colorSpace);
+
+  /// Resets the per-frame counters.
+  void beginFrame();
+
+  /// Drops every entry.
+  void clear();
+
+  /// Sets the byte ceiling, evicting entries that no longer fit.
+  void setBudgetBytes(std::size_t bytes);
+
+  /// Returns the byte ceiling.
+  [[nodiscard]] std::size_t budgetBytes() const { return budgetBytes_; }
+
+  /// Returns what the cache did since the last \ref beginFrame.
+  [[nodiscard]] const GradientLutCacheStats& stats() const { return stats_; }
+
+private:
+  struct Entry {
+    std::uint64_t hash = 0;
+    std::shared_ptr<const tiny_skia::GradientLut> lut;
+    std::uint64_t lastUsed = 0;
+  };
+
+  void evictToBudget();
+
+  std::vector<Entry> entries_;
+  std::size_t budgetBytes_ = kDefaultBudgetBytes;
+  std::uint64_t useCounter_ = 0;
+  GradientLutCacheStats stats_;
+};
+
+}  // namespace donner::svg
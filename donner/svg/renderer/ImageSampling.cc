@@ -203,12 +203,43 @@ void RasterizePixels(const SourceImage& source, const Transform2d& imageFromDevi
   }
 }
 
+bool IsSmoothImageRendering(ImageRendering imageRendering) {
+  switch (imageRendering) {
+    case ImageRendering::CrispEdges:
+    case ImageRendering::OptimizeSpeed:
+    case ImageRendering::Pixelated: return false;
+    case ImageRendering::Auto:
+    case ImageRendering::Smooth:
+    case ImageRendering::HighQuality:
+    case ImageRendering::OptimizeQuality: return true;
+  }
+  return true;
+}
+
 }  // namespace
 
+int SelectImageMipLevel(const Transform2d& deviceFromImage, int sourceWidth, int sourceHeight,
+                        ImageRendering imageRendering) {
+  if (!IsSmoothImageRendering(imageRendering) || sourceWidth <= 0 || sourceHeight <= 0) {
+    return 0;
+  }
+
+  const double scaleX = deviceFromImage.transformVector(Vector2d(1.0, 0.0)).length();
+  const double scaleY = deviceFromImage.transformVector(Vector2d(0.0, 1.0)).length();
+  const double scale = std::max(scaleX, scaleY);
+  if (!std::isfinite(scale) || scale <= 0.0 || scale > 0.5) {
+    return 0;
+  }
+
+  const int maxLevel = ImageMipChain::LevelCount(sourceWidth, sourceHeight) - 1;
+  const double level = std::floor(std::log2(1.0 / scale));
+  return static_cast<int>(std::clamp(level, 0.0, static_cast<double>(maxLevel)));
+}
+
 std::vector<std::uint8_t> RasterizeImagePremultiplied(
     std::span<const std::uint8_t> premultipliedPixels, int sourceWidth, int sourceHeight,
     const Transform2d& deviceFromImage, int outputWidth, int outputHeight,
-    ImageRendering imageRendering) {
+    ImageRendering imageRendering, ImageMipChain* mipChain) {
   std::size_t outputPixels = 0;
   if (!IsValidSamplingRequest(premultipliedPixels, sourceWidth, sourceHeight, outputWidth,
                               outputHeight, outputPixels)) {
@@ -216,11 +247,26 @@ std::vector<std::uint8_t> RasterizeImagePremultiplied(
   }
 
   std::vector<std::uint8_t> output(outputPixels * 4u, 0);
+  SourceImage source{premultipliedPixels, sourceWidth, sourceHeight};
+  Transform2d deviceFromSource = deviceFromImage;
+  if (mipChain != nullptr && IsFiniteTransform(deviceFromImage)) {
+    if (const int levelIndex =
+            SelectImageMipLevel(deviceFromImage, sourceWidth, sourceHeight, imageRendering);
+        levelIndex > 0) {
+      const ImageMipChain::Level& level =
+          mipChain->level(premultipliedPixels, sourceWidth, sourceHeight, levelIndex);
+      source = SourceImage{level.pixels, level.width, level.height};
+      deviceFromSource =
+          Transform2d::Scale(static_cast<double>(sourceWidth) / level.width,
+                             static_cast<double>(sourceHeight) / level.height) *
+          deviceFromImage;
+    }
+  }
+
   Transform2d imageFromDevice;
-  const SourceImage source{premultipliedPixels, sourceWidth, sourceHeight};
   PixelatedSampling pixelatedSampling;
-  if (!ResolveImageFromDevice(deviceFromImage, imageFromDevice) ||
-      !ResolvePixelatedSampling(deviceFromImage, source, imageRendering, pixelatedSampling)) {
+  if (!ResolveImageFromDevice(deviceFromSource, imageFromDevice) ||
+      !ResolvePixelatedSampling(deviceFromSource, source, imageRendering, pixelatedSampling)) {
     return output;
   }
 
@@ -8,6 +8,7 @@
 
 #include "donner/base/Transform.h"
 #include "donner/svg/core/ImageRendering.h"
+#include "donner/svg/resources/ImageMipChain.h"
 
 namespace donner::svg {
 
@@ -16,6 +17,21 @@ inline constexpr std::int64_t kMaxImageSamplingDimension = 16384;
 /// Maximum pixels in one materialized image-sampling surface.
 inline constexpr std::size_t kMaxImageSamplingSurfacePixels = 16 * 1024 * 1024;
 
+/**
+ * Selects the \ref ImageMipChain level to sample when drawing a `sourceWidth` x `sourceHeight`
+ * image through \p deviceFromImage.
+ *
+ * Only smooth (filtered) image rendering is prefiltered: `pixelated`, `crisp-edges` and
+ * `optimizeSpeed` ask for hard texel edges, so they always sample level 0. For smooth rendering
+ * the level is the largest one whose texels are still no larger than a device pixel along the
+ * least-minified axis, which keeps anisotropic draws sharp along their long axis at the cost of
+ * some aliasing along the short one.
+ *
+ * @return 0 when the image is not minified by at least 2x, otherwise the level index.
+ */
+int SelectImageMipLevel(const Transform2d& deviceFromImage, int sourceWidth, int sourceHeight,
+                        ImageRendering imageRendering);
+
 /**
  * Rasterizes a premultiplied image through an affine transform into a bounded device surface.
  *
@@ -26,6 +42,10 @@ inline constexpr std::size_t kMaxImageSamplingSurfacePixels = 16 * 1024 * 1024;
  * @param outputWidth Output width in pixels.
  * @param outputHeight Output height in pixels.
  * @param imageRendering Resolved image sampling policy.
+ * @param mipChain Optional mip chain stored alongside \p premultipliedPixels. When present and the
+ * draw minifies a smooth image by 2x or more, the level picked by \ref SelectImageMipLevel is
+ * sampled instead of the full-resolution source. Without a chain the source is sampled directly,
+ * since building one for a single draw would touch every source pixel.
  * @return Tightly packed premultiplied RGBA8 output. Malformed payloads, invalid dimensions, and
  * over-budget surfaces return empty; invalid transforms return a correctly sized transparent
  * output.
@@ -33,6 +53,6 @@ inline constexpr std::size_t kMaxImageSamplingSurfacePixels = 16 * 1024 * 1024;
 std::vector<std::uint8_t> RasterizeImagePremultiplied(
     std::span<const std::uint8_t> premultipliedPixels, int sourceWidth, int sourceHeight,
     const Transform2d& deviceFromImage, int outputWidth, int outputHeight,
-    ImageRendering imageRendering);
+    ImageRendering imageRendering, ImageMipChain* mipChain = nullptr);
 
 }  // namespace donner::svg
@@ -0,0 +1,291 @@
+#include "donner/svg/renderer/MaskCoverageCache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+namespace donner::svg {
+
+namespace {
+
+bool TransformsEqual(const Transform2d& lhs, const Transform2d& rhs) {
+  return std::equal(std::begin(lhs.data), std::end(lhs.data), std::begin(rhs.data));
+}
+
+/// Compares optional boxes bitwise, like the transforms beside them.
+bool BoxesEqual(const std::optional<Box2d>& lhs, const std::optional<Box2d>& rhs) {
+  if (lhs.has_value() != rhs.has_value()) {
+    return false;
+  }
+  if (!lhs.has_value()) {
+    return true;
+  }
+  return lhs->topLeft.x == rhs->topLeft.x && lhs->topLeft.y == rhs->topLeft.y &&
+         lhs->bottomRight.x == rhs->bottomRight.x && lhs->bottomRight.y == rhs->bottomRight.y;
+}
+
+bool ClipShapesEqual(const std::vector<ClipPathShape>& lhs, const std::vector<ClipPathShape>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i].layer != rhs[i].layer || lhs[i].fillRule != rhs[i].fillRule ||
+        !TransformsEqual(lhs[i].parentFromEntity, rhs[i].parentFromEntity) ||
+        !(lhs[i].path == rhs[i].path)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// FNV-1a over the bit patterns of the values mixed in. Only used to reject unequal keys early;
+/// equal hashes are always confirmed by a full comparison.
+class KeyHasher {
+public:
+  void mix(std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      hash_ ^= (value >> (i * 8)) & 0xffu;
+      hash_ *= 0x100000001b3ull;
+    }
+  }
+
+  void mix(double value) { mix(std::bit_cast<std::uint64_t>(value)); }
+
+  void mix(const Transform2d& transform) {
+    for (const double value : transform.data) {
+      mix(value);
+    }
+  }
+
+  void mix(const std::optional<Box2d>& box) {
+    mix(static_cast<std::uint64_t>(box.has_value()));
+    if (box.has_value()) {
+      mix(box->topLeft.x);
+      mix(box->topLeft.y);
+      mix(box->bottomRight.x);
+      mix(box->bottomRight.y);
+    }
+  }
+
+  void mix(tiny_skia::IntSize size) {
+    mix(static_cast<std::uint64_t>(size.width()) << 32 | size.height());
+  }
+
+  std::uint64_t hash() const { return hash_; }
+
+private:
+  std::uint64_t hash_ = 0xcbf29ce484222325ull;
+};
+
+std::uint64_t HashKey(const MaskCoverageKey& key) {
+  KeyHasher hasher;
+  hasher.mix(static_cast<std::uint64_t>(entt::to_integral(key.identity.entity.entity())));
+  hasher.mix(static_cast<std::uint64_t>(
+      reinterpret_cast<std::uintptr_t>(key.identity.entity.registry())));
+  hasher.mix(key.identity.documentRevision);
+  hasher.mix(key.identity.instancesRevision);
+  hasher.mix(key.identity.surfaceFromMaskContent);
+  hasher.mix(key.maskBounds);
+  hasher.mix(key.deviceFromMaskBounds);
+  hasher.mix(static_cast<std::uint64_t>(key.maskType));
+  hasher.mix(key.surfaceSize);
+  hasher.mix(static_cast<std::uint64_t>(key.antialias) << 8 |
+             static_cast<std::uint64_t>(key.filterPrecision));
+  return hasher.hash();
+}
+
+std::uint64_t HashKey(const ClipCoverageKey& key) {
+  KeyHasher hasher;
+  hasher.mix(key.clipRect);
+  hasher.mix(key.clipPathUnitsTransform);
+  hasher.mix(key.deviceFromLocal);
+  hasher.mix(key.surfaceSize);
+  hasher.mix(static_cast<std::uint64_t>(key.antialias));
+  for (const ClipPathShape& shape : key.clipPaths) {
+    hasher.mix(static_cast<std::uint64_t>(static_cast<std::uint32_t>(shape.layer)) << 8 |
+               static_cast<std::uint64_t>(shape.fillRule));
+    hasher.mix(shape.parentFromEntity);
+    hasher.mix(static_cast<std::uint64_t>(shape.path.commands().size()));
+    for (const Vector2d& point : shape.path.points()) {
+      hasher.mix(point.x);
+      hasher.mix(point.y);
+    }
+  }
+  return hasher.hash();
+}
+
+}  // namespace
+
+bool operator==(const MaskCoverageKey& lhs, const MaskCoverageKey& rhs) {
+  return lhs.identity.instancesRevision != 0 && lhs.identity.entity == rhs.identity.entity &&
+         lhs.identity.documentRevision == rhs.identity.documentRevision &&
+         lhs.identity.instancesRevision == rhs.identity.instancesRevision &&
+         TransformsEqual(lhs.identity.surfaceFromMaskContent,
+                         rhs.identity.surfaceFromMaskContent) &&
+         BoxesEqual(lhs.maskBounds, rhs.maskBounds) &&
+         TransformsEqual(lhs.deviceFromMaskBounds, rhs.deviceFromMaskBounds) &&
+         lhs.maskType == rhs.maskType && lhs.surfaceSize == rhs.surfaceSize &&
+         lhs.antialias == rhs.antialias && lhs.filterPrecision == rhs.filterPrecision;
+}
+
+bool operator==(const ClipCoverageKey& lhs, const ClipCoverageKey& rhs) {
+  return BoxesEqual(lhs.clipRect, rhs.clipRect) &&
+         TransformsEqual(lhs.clipPathUnitsTransform, rhs.clipPathUnitsTransform) &&
+         TransformsEqual(lhs.deviceFromLocal, rhs.deviceFromLocal) &&
+         lhs.surfaceSize == rhs.surfaceSize && lhs.antialias == rhs.antialias &&
+         ClipShapesEqual(lhs.clipPaths, rhs.clipPaths);
+}
+
+bool MaskCoverageCache::findMask(const MaskCoverageKey& key,
+                                 std::optional<tiny_skia::Mask>& out) {
+  Entry* entry = find(HashKey(key), &key, nullptr);
+  return entry != nullptr && copyOut(*entry, key.surfaceSize, out);
+}
+
+void MaskCoverageCache::storeMask(MaskCoverageKey key, const tiny_skia::Mask& mask) {
+  Entry entry;
+  entry.hash = HashKey(key);
+  entry.maskKey = std::move(key);
+  store(std::move(entry), mask);
+}
+
+bool MaskCoverageCache::findClip(const ClipCoverageKey& key,
+                                 std::optional<tiny_skia::Mask>& out) {
+  Entry* entry = find(HashKey(key), nullptr, &key);
+  return entry != nullptr && copyOut(*entry, key.surfaceSize, out);
+}
+
+void MaskCoverageCache::storeClip(ClipCoverageKey key, const tiny_skia::Mask& mask) {
+  Entry entry;
+  entry.hash = HashKey(key);
+  entry.clipKey = std::move(key);
+  store(std::move(entry), mask);
+}
+
+void MaskCoverageCache::clear() {
+  entries_.clear();
+  liveBytes_ = 0;
+}
+
+void MaskCoverageCache::setBudgetBytes(std::size_t bytes) {
+  budgetBytes_ = bytes;
+  evictToBudget();
+}
+
+MaskCoverageCache::Entry* MaskCoverageCache::find(std::uint64_t hash,
+                                                  const MaskCoverageKey* maskKey,
+                                                  const ClipCoverageKey* clipKey) {
+  for (Entry& entry : entries_) {
+    if (entry.hash != hash) {
+      continue;
+    }
+    if (maskKey != nullptr && entry.maskKey.has_value() && *entry.maskKey == *maskKey) {
+      return &entry;
+    }
+    if (clipKey != nullptr && entry.clipKey.has_value() && *entry.clipKey == *clipKey) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void MaskCoverageCache::store(Entry entry, const tiny_skia::Mask& mask) {
+  const int width = static_cast<int>(mask.width());
+  const int height = static_cast<int>(mask.height());
+  const std::span<const std::uint8_t> data = mask.data();
+
+  // Crop to the rows and columns that hold any coverage. A mask region or clip is usually a
+  // small part of the surface, so this is what keeps entries proportional to what they cover.
+  int minX = width;
+  int minY = height;
+  int maxX = -1;
+  int maxY = -1;
+  for (int y = 0; y < height; ++y) {
+    const std::uint8_t* row = data.data() + static_cast<std::size_t>(y) * width;
+    int first = 0;
+    while (first < width && row[first] == 0) {
+      ++first;
+    }
+    if (first == width) {
+      continue;
+    }
+    int last = width - 1;
+    while (row[last] == 0) {
+      --last;
+    }
+    minX = std::min(minX, first);
+    maxX = std::max(maxX, last);
+    minY = std::min(minY, y);
+    maxY = y;
+  }
+
+  if (maxY >= 0) {
+    entry.x = minX;
+    entry.y = minY;
+    entry.width = maxX - minX + 1;
+    entry.height = maxY - minY + 1;
+    entry.coverage.resize(static_cast<std::size_t>(entry.width) * entry.height);
+    for (int y = 0; y < entry.height; ++y) {
+      std::memcpy(entry.coverage.data() + static_cast<std::size_t>(y) * entry.width,
+                  data.data() + static_cast<std::size_t>(entry.y + y) * width + entry.x,
+                  static_cast<std::size_t>(entry.width));
+    }
+  }
+
+  entry.bytes = sizeof(Entry) + entry.coverage.size();
+  if (entry.clipKey.has_value()) {
+    for (const ClipPathShape& shape : entry.clipKey->clipPaths) {
+      entry.bytes += shape.path.points().size_bytes() + shape.path.commands().size_bytes();
+    }
+  }
+  if (entry.bytes > budgetBytes_) {
+    return;
+  }
+
+  entry.lastUsed = ++useCounter_;
+  if (Entry* existing = find(entry.hash, entry.maskKey ? &*entry.maskKey : nullptr,
+                             entry.clipKey ? &*entry.clipKey : nullptr)) {
+    liveBytes_ -= existing->bytes;
+    *existing = std::move(entry);
+    liveBytes_ += existing->bytes;
+  } else {
+    liveBytes_ += entry.bytes;
+    entries_.push_back(std::move(entry));
+  }
+  evictToBudget();
+}
+
+bool MaskCoverageCache::copyOut(Entry& entry, tiny_skia::IntSize surfaceSize,
+                                std::optional<tiny_skia::Mask>& out) {
+  out = tiny_skia::Mask::fromSize(surfaceSize.width(), surfaceSize.height());
+  if (!out.has_value()) {
+    return false;
+  }
+
+  const std::span<std::uint8_t> data = out->data();
+  const std::size_t stride = surfaceSize.width();
+  for (int y = 0; y < entry.height; ++y) {
+    std::memcpy(data.data() + static_cast<std::size_t>(entry.y + y) * stride + entry.x,
+                entry.coverage.data() + static_cast<std::size_t>(y) * entry.width,
+                static_cast<std::size_t>(entry.width));
+  }
+  entry.lastUsed = ++useCounter_;
+  return true;
+}
+
+void MaskCoverageCache::evictToBudget() {
+  while (!entries_.empty() && (liveBytes_ > budgetBytes_ || entries_.size() > kMaxEntries)) {
+    auto coldest = std::min_element(
+        entries_.begin(), entries_.end(),
+        [](const Entry& lhs, const Entry& rhs) { return lhs.lastUsed < rhs.lastUsed; });
+    liveBytes_ -= coldest->bytes;
+    if (coldest != entries_.end() - 1) {
+      *coldest = std::move(entries_.back());
+    }
+    entries_.pop_back();
+    ++evictions_;
+  }
+}
+
+}  // namespace donner::svg
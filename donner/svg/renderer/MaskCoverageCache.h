@@ -0,0 +1,174 @@
+#pragma once
+/// @file
+/// Coverage cache for `<mask>` and `<clipPath>` rasterization in the tiny-skia backend.
+///
+/// A masked element renders the mask's content subtree into a fresh surface-sized pixmap and
+/// converts it to coverage, and a clipped element scan-converts every clip path into
+/// surface-sized masks, for every element on every frame. Documents that apply one rounded-corner
+/// mask or clip to hundreds of elements redo identical work hundreds of times a frame. This file
+/// owns the storage that lets the second and later users, on this frame or a later one, copy the
+/// coverage instead.
+///
+/// The correctness rule matches \ref RetainedFilterOutput.h: an entry may be evicted for any
+/// reason, but it may only be reused when every input the coverage depended on is unchanged. A
+/// mask is identified by its definition and the document revisions, a clip by its geometry.
+/// Either way the device transform, surface size, and anti-aliasing are part of the key, and
+/// sharing happens between users whose keys are equal.
+///
+/// Entries store only the bounding area of their nonzero coverage, not the whole surface.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "donner/base/Box.h"
+#include "donner/base/EcsRegistry.h"
+#include "donner/base/Transform.h"
+#include "donner/svg/renderer/RendererInterface.h"
+#include "donner/svg/renderer/RetainedFilterOutput.h"
+#include "tiny_skia/Geom.h"
+#include "tiny_skia/Mask.h"
+
+namespace donner::svg {
+
+/// Everything the coverage of one rendered `<mask>` depends on.
+struct MaskCoverageKey {
+  /// The mask definition, revisions, and content transform. @see MaskIdentity
+  MaskIdentity identity;
+
+  /// Mask region in the masked element's local space, if any.
+  std::optional<Box2d> maskBounds;
+
+  /// Local-to-device transform the mask region is drawn with.
+  Transform2d deviceFromMaskBounds;
+
+  /// Whether coverage comes from luminance or alpha.
+  MaskType maskType = MaskType::Luminance;
+
+  /// Surface the mask was rendered against.
+  tiny_skia::IntSize surfaceSize;
+
+  /// Whether the content was rasterized with anti-aliasing.
+  bool antialias = true;
+
+  /// Precision any filter inside the mask content ran at.
+  FilterPrecision filterPrecision = FilterPrecision::Float;
+
+  friend bool operator==(const MaskCoverageKey& lhs, const MaskCoverageKey& rhs);
+};
+
+/// Everything the coverage of one built clip depends on: its geometry and how it was rasterized.
+struct ClipCoverageKey {
+  /// Clip rectangle in local space, if any.
+  std::optional<Box2d> clipRect;
+
+  /// Clip path shapes, in the order they are combined.
+  std::vector<ClipPathShape> clipPaths;
+
+  /// Transform applied to the clip path coordinate system.
+  Transform2d clipPathUnitsTransform;
+
+  /// Local-to-device transform the clip is rasterized with.
+  Transform2d deviceFromLocal;
+
+  /// Surface the clip was rasterized against.
+  tiny_skia::IntSize surfaceSize;
+
+  /// Whether the clip was rasterized with anti-aliasing.
+  bool antialias = true;
+
+  friend bool operator==(const ClipCoverageKey& lhs, const ClipCoverageKey& rhs);
+};
+
+/// Counters describing what a renderer's mask coverage cache did during the most recent frame,
+/// for tests and benchmarks.
+struct MaskCoverageCacheStats {
+  std::uint64_t maskHits = 0;    ///< Masks whose coverage was copied from the cache.
+  std::uint64_t maskMisses = 0;  ///< Masks rendered and stored.
+  std::uint64_t clipHits = 0;    ///< Clips whose coverage was copied from the cache.
+  std::uint64_t clipMisses = 0;  ///< Clips rasterized and stored.
+  /// Masks the cache did not apply to: no stable identity, a clip that could change their
+  /// coverage, or a budget rejection while rendering them.
+  std::uint64_t bypassedMasks = 0;
+  std::size_t liveBytes = 0;    ///< Bytes held by the cache at the end of the frame.
+  std::uint64_t evictions = 0;  ///< Entries evicted to stay under budget.
+};
+
+/**
+ * Renderer-owned cache of mask and clip coverage.
+ *
+ * Lookups are linear over a hash of each key, which keeps a miss to one integer comparison per
+ * entry; the entry count is capped so that stays cheap. The byte budget evicts the least
+ * recently used entries first.
+ */
+class MaskCoverageCache {
+public:
+  /// Default budget: a few dozen full-viewport masks at typical sizes.
+  static constexpr std::size_t kDefaultBudgetBytes = 16u * 1024u * 1024u;
+
+  /// Entry count ceiling, independent of the byte budget.
+  static constexpr std::size_t kMaxEntries = 1024;
+
+  /**
+   * Copies the coverage stored for \p key into \p out, resizing it to the key's surface size.
+   *
+   * @param key Mask to look up.
+   * @param out Destination mask, replaced on a hit.
+   * @return True on a hit.
+   */
+  [[nodiscard]] bool findMask(const MaskCoverageKey& key, std::optional<tiny_skia::Mask>& out);
+
+  /// Stores the coverage of \p mask under \p key, replacing any entry with the same key.
+  void storeMask(MaskCoverageKey key, const tiny_skia::Mask& mask);
+
+  /// @see findMask
+  [[nodiscard]] bool findClip(const ClipCoverageKey& key, std::optional<tiny_skia::Mask>& out);
+
+  /// @see storeMask
+  void storeClip(ClipCoverageKey key, const tiny_skia::Mask& mask);
+
+  /// Drops every entry.
+  void clear();
+
+  /// Sets the byte ceiling, evicting entries that no longer fit.
+  void setBudgetBytes(std::size_t bytes);
+
+  /// Returns the byte ceiling.
+  [[nodiscard]] std::size_t budgetBytes() const { return budgetBytes_; }
+
+  /// Returns the bytes currently held.
+  [[nodiscard]] std::size_t liveBytes() const { return liveBytes_; }
+
+  /// Returns the number of entries evicted to stay under budget, across the cache's lifetime.
+  [[nodiscard]] std::uint64_t evictions() const { return evictions_; }
+
+private:
+  /// Coverage of one mask or clip, cropped to the bounding area of its nonzero bytes.
+  struct Entry {
+    std::uint64_t hash = 0;
+    std::optional<MaskCoverageKey> maskKey;
+    std::optional<ClipCoverageKey> clipKey;
+    /// Bounding area of `coverage` within the surface. Empty when the coverage is all zero.
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> coverage;
+    std::uint64_t lastUsed = 0;
+    std::size_t bytes = 0;
+  };
+
+  Entry* find(std::uint64_t hash, const MaskCoverageKey* maskKey, const ClipCoverageKey* clipKey);
+  void store(Entry entry, const tiny_skia::Mask& mask);
+  bool copyOut(Entry& entry, tiny_skia::IntSize surfaceSize, std::optional<tiny_skia::Mask>& out);
+  void evictToBudget();
+
+  std::vector<Entry> entries_;
+  std::size_t budgetBytes_ = kDefaultBudgetBytes;
+  std::size_t liveBytes_ = 0;
+  std::uint64_t useCounter_ = 0;
+  std::uint64_t evictions_ = 0;
+};
+
+}  // namespace donner::svg
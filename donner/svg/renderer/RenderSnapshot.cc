@@ -1,12 +1,18 @@
 #include "donner/svg/renderer/RenderSnapshot.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <span>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#include "donner/base/WorkerPool.h"
 #include "donner/svg/components/filter/FilterComponent.h"
 #include "donner/svg/components/layout/TransformComponent.h"
 #include "donner/svg/components/paint/GradientComponent.h"
@@ -372,6 +378,576 @@ void ReplayCommand(const RenderCommand& command, RendererInterface& renderer,
       command);
 }
 
+/// A screen tile rendered into a surface of its own, see \ref RenderSnapshot::replayTiled.
+struct TileSurface {
+  Vector2i origin;  //!< Device-space position of the tile's top-left pixel.
+  Vector2i size;    //!< Size of the tile surface, in device pixels.
+};
+
+/// Replay \p commands into \p renderer, skipping the commands for which \p shouldReplay returns
+/// false. Pattern tiles the renderer rejects are skipped along with their content.
+///
+/// `setTransform` and `setPaint` are deferred until the next command that may depend on them, so a
+/// run of state changes whose draws were all skipped costs nothing; with many tiles this is most
+/// of the commands each tile would otherwise replay.
+///
+/// If \p tile is set, the frame is replayed into a surface covering only that tile: the frame is
+/// begun at the tile's size and every device-space transform is translated by the tile origin.
+/// Transforms set inside a pattern tile are in pattern space and are replayed unchanged.
+template <typename ShouldReplay>
+void ReplayCommands(const std::vector<RenderCommand>& commands, RendererInterface& renderer,
+                    Registry& textRegistry, const ShouldReplay& shouldReplay,
+                    const TileSurface* tile = nullptr) {
+  std::size_t patternDepth = 0;
+  std::size_t rejectedPatternDepth = 0;
+  std::optional<std::size_t> pendingTransform;
+  std::optional<std::size_t> pendingPaint;
+  const Transform2d tileFromDevice =
+      tile != nullptr ? Transform2d::Translate(-tile->origin.x, -tile->origin.y) : Transform2d();
+
+  const auto replay = [&](std::size_t index) {
+    const RenderCommand& command = commands[index];
+    if (tile != nullptr) {
+      if (std::holds_alternative<BeginFrameCommand>(command)) {
+        renderer.beginFrame(RenderViewport{.size = Vector2d(tile->size.x, tile->size.y)});
+        return;
+      }
+      // Deferred transforms are flushed before a pattern tile opens or closes, so the depth is
+      // still the one the transform was recorded at.
+      if (const auto* setTransform = std::get_if<SetTransformCommand>(&command);
+          setTransform != nullptr && patternDepth == 0) {
+        renderer.setTransform(setTransform->transform * tileFromDevice);
+        return;
+      }
+    }
+    ReplayCommand(command, renderer, textRegistry);
+  };
+  const auto flushState = [&]() {
+    if (pendingTransform && pendingPaint && *pendingPaint < *pendingTransform) {
+      std::swap(pendingTransform, pendingPaint);
+    }
+    for (std::optional<std::size_t>* pending : {&pendingTransform, &pendingPaint}) {
+      if (pending->has_value()) {
+        replay(**pending);
+        pending->reset();
+      }
+    }
+  };
+
+  for (std::size_t i = 0; i < commands.size(); ++i) {
+    const RenderCommand& command = commands[i];
+    if (const auto* beginPattern = std::get_if<BeginPatternTileCommand>(&command)) {
+      if (rejectedPatternDepth == 0) {
+        flushState();
+      }
+      if (rejectedPatternDepth > 0 ||
+          !renderer.beginPatternTile(beginPattern->tileRect, beginPattern->targetFromPattern)) {
+        ++rejectedPatternDepth;
+      } else {
+        ++patternDepth;
+      }
+      continue;
+    }
+
+    if (const auto* endPattern = std::get_if<EndPatternTileCommand>(&command)) {
+      if (rejectedPatternDepth > 0) {
+        --rejectedPatternDepth;
+      } else {
+        flushState();
+        --patternDepth;
+        renderer.endPatternTile(endPattern->forStroke);
+      }
+      continue;
+    }
+
+    if (rejectedPatternDepth > 0 || !shouldReplay(i)) {
+      continue;
+    }
+
+    if (std::holds_alternative<SetTransformCommand>(command)) {
+      pendingTransform = i;
+    } else if (std::holds_alternative<SetPaintCommand>(command)) {
+      pendingPaint = i;
+    } else {
+      flushState();
+      replay(i);
+    }
+  }
+}
+
+/// Grid of square screen tiles covering a frame, used by \ref RenderSnapshot::replayTiled.
+struct TileGrid {
+  int tileSize = 0;
+  std::size_t columns = 0;
+  std::size_t rows = 0;
+  Vector2i frameSize = Vector2i::Zero();  //!< Frame size in pixels, rounded up.
+  bool wholePixelFrame = false;            //!< The viewport is a whole number of pixels.
+
+  /// Grid covering \p viewport, or `std::nullopt` if the frame is empty or scaled by a device
+  /// pixel ratio, whose rounding the binning does not model.
+  static std::optional<TileGrid> ForViewport(const RenderViewport& viewport, int tileSize) {
+    const double width = std::ceil(viewport.size.x);
+    const double height = std::ceil(viewport.size.y);
+    if (viewport.devicePixelRatio != 1.0 || !(width >= 1.0) || !(height >= 1.0) ||
+        width > 1e6 || height > 1e6) {
+      return std::nullopt;
+    }
+
+    TileGrid grid;
+    grid.tileSize = tileSize;
+    grid.columns = static_cast<std::size_t>(std::ceil(width / tileSize));
+    grid.rows = static_cast<std::size_t>(std::ceil(height / tileSize));
+    grid.frameSize = Vector2i(static_cast<int>(width), static_cast<int>(height));
+    grid.wholePixelFrame = width == viewport.size.x && height == viewport.size.y;
+    return grid;
+  }
+
+  std::size_t tileCount() const { return columns * rows; }
+
+  /// Surface covering tile \p tile, clipped to the edge of a \p frameSize frame.
+  TileSurface surface(std::size_t tile, const Vector2i& frameSize) const {
+    const Vector2i origin(static_cast<int>(tile % columns) * tileSize,
+                          static_cast<int>(tile / columns) * tileSize);
+    return TileSurface{origin, Vector2i(std::min(tileSize, frameSize.x - origin.x),
+                                        std::min(tileSize, frameSize.y - origin.y))};
+  }
+};
+
+/// Device pixels a command rasterizes against: the geometry it draws, or the clip or mask region it
+/// builds. State commands rasterize nothing and have an empty extent.
+struct PixelExtent {
+  /// False if the command may rasterize anywhere in the frame.
+  bool known = true;
+  int x0 = 0;  //!< Left edge, inclusive.
+  int y0 = 0;  //!< Top edge, inclusive.
+  int x1 = 0;  //!< Right edge, exclusive.
+  int y1 = 0;  //!< Bottom edge, exclusive.
+
+  static PixelExtent Unknown() { return PixelExtent{.known = false}; }
+
+  /// Pixels covering the finite device-space box \p bounds.
+  static PixelExtent ForBounds(const Box2d& bounds) {
+    // Clamp far outside any frame before converting, the extent is clipped to the frame anyway.
+    static constexpr double kLimit = 1e7;
+    const auto pixel = [](double coordinate) {
+      return static_cast<int>(std::clamp(coordinate, -kLimit, kLimit));
+    };
+    return PixelExtent{.x0 = pixel(std::floor(bounds.topLeft.x)),
+                       .y0 = pixel(std::floor(bounds.topLeft.y)),
+                       .x1 = pixel(std::ceil(bounds.bottomRight.x)),
+                       .y1 = pixel(std::ceil(bounds.bottomRight.y))};
+  }
+
+  bool empty() const { return known && (x0 >= x1 || y0 >= y1); }
+
+  /// Grow to also cover \p other.
+  void add(const PixelExtent& other) {
+    if (!known || other.empty()) {
+      return;
+    }
+    if (!other.known || empty()) {
+      *this = other;
+      return;
+    }
+    x0 = std::min(x0, other.x0);
+    y0 = std::min(y0, other.y0);
+    x1 = std::max(x1, other.x1);
+    y1 = std::max(y1, other.y1);
+  }
+};
+
+/// Inclusive range of tiles a command may touch. State commands, and draws whose bounds are not
+/// known, touch every tile.
+struct TileSpan {
+  bool everyTile = true;
+  std::size_t x0 = 0;
+  std::size_t y0 = 0;
+  std::size_t x1 = 0;
+  std::size_t y1 = 0;
+  bool empty = false;  //!< The command cannot touch any pixel of the frame.
+  PixelExtent extent;  //!< Pixels the command rasterizes against, within the frame or not.
+
+  /// Returns true if the span covers the tile in column \p x and row \p y.
+  bool touchesTile(std::size_t x, std::size_t y) const {
+    return everyTile || (!empty && x0 <= x && x <= x1 && y0 <= y && y <= y1);
+  }
+
+  /// Returns true if the span covers a tile dealt to \p worker, tiles being dealt round-robin
+  /// in row-major order.
+  bool touchesTileOwnedBy(const TileGrid& grid, std::size_t worker,
+                          std::size_t workerCount) const {
+    if (everyTile) {
+      return true;
+    }
+    if (empty) {
+      return false;
+    }
+
+    // Within a row consecutive tiles cycle through owners, so a row covers every worker once it
+    // spans `workerCount` tiles; the loop below is bounded by that.
+    for (std::size_t y = y0; y <= y1; ++y) {
+      const std::size_t rowStart = y * grid.columns;
+      for (std::size_t x = x0; x <= x1 && x < x0 + workerCount; ++x) {
+        if ((rowStart + x) % workerCount == worker) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+};
+
+/// Antialiasing touches at most one pixel beyond the geometry; round up to two.
+constexpr double kAntialiasMargin = 2.0;
+
+/// Device-space box a draw of \p localBounds under \p deviceFromLocal may touch, outset for
+/// \p stroke and antialiasing, or `std::nullopt` if the box is not finite.
+std::optional<Box2d> DeviceBoundsForDraw(const Box2d& localBounds, const StrokeParams& stroke,
+                                         const Transform2d& deviceFromLocal) {
+  // Stroke outset: half the width, extended by the miter limit for miter joins and by sqrt(2) for
+  // square caps.
+  constexpr double kSqrt2 = 1.4142135623730951;
+  double outset = 0.0;
+  if (stroke.strokeWidth > 0.0) {
+    outset = stroke.strokeWidth * 0.5 * std::max(stroke.miterLimit, kSqrt2);
+  }
+
+  const Box2d deviceBounds =
+      deviceFromLocal.transformBox(localBounds.inflatedBy(outset)).inflatedBy(kAntialiasMargin);
+  if (!std::isfinite(deviceBounds.topLeft.x) || !std::isfinite(deviceBounds.topLeft.y) ||
+      !std::isfinite(deviceBounds.bottomRight.x) || !std::isfinite(deviceBounds.bottomRight.y) ||
+      !std::isfinite(outset)) {
+    return std::nullopt;
+  }
+  return deviceBounds;
+}
+
+/// Box around every point of \p path, control points included. The rasterizer decides whether a
+/// path must be clipped to the surface from this box rather than from the tighter curve bounds.
+Box2d ControlPointBounds(const Path& path) {
+  const std::span<const Vector2d> points = path.points();
+  if (points.empty()) {
+    return Box2d();
+  }
+
+  Box2d bounds = Box2d::CreateEmpty(points.front());
+  for (const Vector2d& point : points) {
+    bounds.addPoint(point);
+  }
+  return bounds;
+}
+
+/// Tiles touched by the device-space box \p deviceBounds.
+TileSpan SpanForBounds(const Box2d& deviceBounds, const TileGrid& grid) {
+  const double left = deviceBounds.topLeft.x;
+  const double top = deviceBounds.topLeft.y;
+  const double right = deviceBounds.bottomRight.x;
+  const double bottom = deviceBounds.bottomRight.y;
+
+  TileSpan span;
+  span.everyTile = false;
+  span.extent = PixelExtent::ForBounds(deviceBounds);
+  const double frameRight = static_cast<double>(grid.columns * grid.tileSize);
+  const double frameBottom = static_cast<double>(grid.rows * grid.tileSize);
+  if (right < 0.0 || bottom < 0.0 || left >= frameRight || top >= frameBottom) {
+    span.empty = true;
+    return span;
+  }
+
+  const auto tileIndex = [&](double coordinate, std::size_t count) {
+    const double index = std::floor(std::max(coordinate, 0.0) / grid.tileSize);
+    return std::min(static_cast<std::size_t>(index), count - 1);
+  };
+  span.x0 = tileIndex(left, grid.columns);
+  span.y0 = tileIndex(top, grid.rows);
+  span.x1 = tileIndex(right, grid.columns);
+  span.y1 = tileIndex(bottom, grid.rows);
+  return span;
+}
+
+/// Pixels a clip mask for \p clip is rasterized against under \p deviceFromLocal: its rectangle
+/// and every clip path, each under its own transform. A clip holding a mask is unknown.
+PixelExtent ExtentForClip(const ResolvedClip& clip, const Transform2d& deviceFromLocal) {
+  if (clip.mask.has_value()) {
+    return PixelExtent::Unknown();
+  }
+
+  PixelExtent extent;
+  const auto addBounds = [&](const Box2d& bounds, const Transform2d& transform) {
+    const std::optional<Box2d> deviceBounds =
+        DeviceBoundsForDraw(bounds, StrokeParams(), transform);
+    extent.add(deviceBounds ? PixelExtent::ForBounds(*deviceBounds) : PixelExtent::Unknown());
+  };
+  if (clip.clipRect.has_value()) {
+    addBounds(*clip.clipRect, deviceFromLocal);
+  }
+  for (const ClipPathShape& shape : clip.clipPaths) {
+    addBounds(ControlPointBounds(shape.path),
+              clip.clipPathUnitsTransform * shape.parentFromEntity * deviceFromLocal);
+  }
+  return extent;
+}
+
+/// Compute the tiles each command may touch, tracking the transform the renderer would draw with.
+///
+/// Inside filter layers, masks, and pattern tiles every command touches every tile: filter
+/// primitives read neighbouring pixels, and pattern content is drawn in pattern space. Those
+/// scopes may also leave the renderer's transform adjusted, so after one closes the transform is
+/// unknown until the next `setTransform`.
+///
+/// Each span also records the command's \ref PixelExtent. Mask content is drawn into a
+/// frame-sized surface, so its extent is known wherever the transform is; pattern content is drawn
+/// into a surface of the pattern's own, so it has none.
+std::vector<TileSpan> BinCommandsToTiles(const std::vector<RenderCommand>& commands,
+                                         const TileGrid& grid) {
+  std::vector<TileSpan> spans(commands.size());
+  std::optional<Transform2d> deviceFromLocal;
+  std::vector<std::optional<Transform2d>> transformStack;
+  std::size_t nonLocalDepth = 0;
+  std::size_t patternDepth = 0;
+
+  const auto closeNonLocal = [&]() {
+    if (nonLocalDepth > 0) {
+      --nonLocalDepth;
+    }
+    deviceFromLocal.reset();
+  };
+  const auto drawSpan = [&](const Box2d& bounds, const StrokeParams& stroke) {
+    if (patternDepth > 0) {
+      return TileSpan();
+    }
+
+    const std::optional<Box2d> deviceBounds =
+        deviceFromLocal ? DeviceBoundsForDraw(bounds, stroke, *deviceFromLocal) : std::nullopt;
+    if (!deviceBounds.has_value()) {
+      TileSpan span;
+      span.extent = PixelExtent::Unknown();
+      return span;
+    }
+    if (nonLocalDepth > 0) {
+      TileSpan span;
+      span.extent = PixelExtent::ForBounds(*deviceBounds);
+      return span;
+    }
+    return SpanForBounds(*deviceBounds, grid);
+  };
+  const auto stateExtent = [&](const auto& computeExtent) {
+    TileSpan span;
+    if (patternDepth == 0) {
+      span.extent = deviceFromLocal ? computeExtent(*deviceFromLocal) : PixelExtent::Unknown();
+    }
+    return span;
+  };
+
+  for (std::size_t i = 0; i < commands.size(); ++i) {
+    std::visit(Overloaded{
+                   [&](const BeginFrameCommand&) {
+                     deviceFromLocal = Transform2d();
+                     transformStack.clear();
+                     nonLocalDepth = 0;
+                     patternDepth = 0;
+                   },
+                   [&](const SetTransformCommand& value) { deviceFromLocal = value.transform; },
+                   [&](const PushTransformCommand& value) {
+                     transformStack.push_back(deviceFromLocal);
+                     if (deviceFromLocal.has_value()) {
+                       deviceFromLocal = value.transform * *deviceFromLocal;
+                     }
+                   },
+                   [&](const PopTransformCommand&) {
+                     if (!transformStack.empty()) {
+                       deviceFromLocal = transformStack.back();
+                       transformStack.pop_back();
+                     }
+                   },
+                   [&](const PushClipCommand& value) {
+                     spans[i] = stateExtent([&](const Transform2d& transform) {
+                       return ExtentForClip(value.clip, transform);
+                     });
+                   },
+                   [&](const PushFilterLayerCommand&) { ++nonLocalDepth; },
+                   [&](const PopFilterLayerCommand&) { closeNonLocal(); },
+                   [&](const PushMaskCommand& value) {
+                     spans[i] = stateExtent([&](const Transform2d& transform) {
+                       if (!value.maskBounds.has_value()) {
+                         return PixelExtent();
+                       }
+                       const std::optional<Box2d> deviceBounds =
+                           DeviceBoundsForDraw(*value.maskBounds, StrokeParams(), transform);
+                       return deviceBounds ? PixelExtent::ForBounds(*deviceBounds)
+                                           : PixelExtent::Unknown();
+                     });
+                     ++nonLocalDepth;
+                   },
+                   [&](const PopMaskCommand&) { closeNonLocal(); },
+                   [&](const BeginPatternTileCommand&) {
+                     ++nonLocalDepth;
+                     ++patternDepth;
+                   },
+                   [&](const EndPatternTileCommand&) {
+                     if (patternDepth > 0) {
+                       --patternDepth;
+                     }
+                     closeNonLocal();
+                   },
+                   [&](const DrawPathCommand& value) {
+                     spans[i] = drawSpan(ControlPointBounds(value.path), value.stroke);
+                   },
+                   [&](const DrawRectCommand& value) {
+                     spans[i] = drawSpan(value.rect, value.stroke);
+                   },
+                   [&](const DrawEllipseCommand& value) {
+                     spans[i] = drawSpan(value.bounds, value.stroke);
+                   },
+                   [&](const DrawImageCommand& value) {
+                     spans[i] = drawSpan(value.params.targetRect, StrokeParams());
+                   },
+                   [&](const DrawTextCommand&) {
+                     if (patternDepth == 0) {
+                       spans[i].extent = PixelExtent::Unknown();
+                     }
+                   },
+                   [](const auto&) {},
+               },
+               commands[i]);
+  }
+
+  return spans;
+}
+
+/// Copies the \p size pixels at \p origin from \p source into \p target, where \p source starts
+/// at \p sourceOrigin.
+void CopyPixels(const RendererBitmap& source, const Vector2i& sourceOrigin, RendererBitmap& target,
+                const Vector2i& origin, const Vector2i& size) {
+  constexpr std::size_t kBytesPerPixel = 4;
+  const std::size_t rowLength = static_cast<std::size_t>(size.x) * kBytesPerPixel;
+  for (int y = 0; y < size.y; ++y) {
+    const std::size_t sourceOffset =
+        static_cast<std::size_t>(origin.y - sourceOrigin.y + y) * source.rowBytes +
+        static_cast<std::size_t>(origin.x - sourceOrigin.x) * kBytesPerPixel;
+    const std::size_t targetOffset =
+        static_cast<std::size_t>(origin.y + y) * target.rowBytes +
+        static_cast<std::size_t>(origin.x) * kBytesPerPixel;
+    std::memcpy(target.pixels.data() + targetOffset, source.pixels.data() + sourceOffset,
+                rowLength);
+  }
+}
+
+/// Surface that tile \p tile of \p grid is rendered into: the tile, grown to hold the extent of
+/// every command the tile replays and clipped to the frame. The rasterizer clips geometry to the
+/// surface, so a surface the geometry does not reach leaves it whole, as the frame would; where
+/// the geometry crosses the frame edge the surface edge is the frame edge. A command whose extent
+/// is unknown makes the surface the whole frame.
+TileSurface SurfaceForTile(std::size_t tile, const TileGrid& grid,
+                           const std::vector<TileSpan>& spans) {
+  const std::size_t column = tile % grid.columns;
+  const std::size_t row = tile / grid.columns;
+  const TileSurface tileRect = grid.surface(tile, grid.frameSize);
+
+  PixelExtent extent{.x0 = tileRect.origin.x,
+                     .y0 = tileRect.origin.y,
+                     .x1 = tileRect.origin.x + tileRect.size.x,
+                     .y1 = tileRect.origin.y + tileRect.size.y};
+  for (const TileSpan& span : spans) {
+    if (span.touchesTile(column, row)) {
+      extent.add(span.extent);
+      if (!extent.known) {
+        return TileSurface{Vector2i::Zero(), grid.frameSize};
+      }
+    }
+  }
+
+  if (getenv("GB")) { int g = atoi(getenv("GB")); extent.x0 -= g; extent.y0 -= g; extent.x1 += g; extent.y1 += g; }
+  const Vector2i origin(std::max(extent.x0, 0), std::max(extent.y0, 0));
+  return TileSurface{origin, Vector2i(std::min(extent.x1, grid.frameSize.x) - origin.x,
+                                      std::min(extent.y1, grid.frameSize.y) - origin.y)};
+}
+
+/// Tile-parallel replay where each tile is rendered into a surface of its own, see
+/// \ref SurfaceForTile, and copied into place. Workers take the next unrendered tile until none
+/// are left, each replaying only the draws that may touch that tile.
+RendererBitmap ReplayTilesIntoTileSurfaces(
+    const std::vector<RenderCommand>& commands, const TileGrid& grid,
+    const std::vector<TileSpan>& spans,
+    const std::vector<std::unique_ptr<RendererInterface>>& renderers, WorkerPool& pool) {
+  RendererBitmap result;
+  result.dimensions = grid.frameSize;
+  result.rowBytes = static_cast<std::size_t>(grid.frameSize.x) * 4u;
+  result.pixels.resize(result.rowBytes * static_cast<std::size_t>(grid.frameSize.y));
+
+  std::vector<std::optional<AlphaType>> alphaTypes(grid.tileCount());
+  std::atomic<std::size_t> nextTile = 0;
+  pool.run(renderers.size(), [&](std::size_t worker) {
+    Registry textRegistry;
+    for (std::size_t tile = nextTile++; tile < grid.tileCount(); tile = nextTile++) {
+      const std::size_t column = tile % grid.columns;
+      const std::size_t row = tile / grid.columns;
+      const TileSurface surface = SurfaceForTile(tile, grid, spans);
+      ReplayCommands(
+          commands, *renderers[worker], textRegistry,
+          [&](std::size_t index) { return spans[index].touchesTile(column, row); }, &surface);
+
+      // Tiles are disjoint, so workers copy into the result without synchronizing.
+      const RendererBitmap bitmap = renderers[worker]->takeSnapshot();
+      if (!bitmap.empty() && bitmap.dimensions == surface.size) {
+        const TileSurface tileRect = grid.surface(tile, grid.frameSize);
+        CopyPixels(bitmap, surface.origin, result, tileRect.origin, tileRect.size);
+        alphaTypes[tile] = bitmap.alphaType;
+      }
+    }
+  });
+
+  // A tile the backend could not allocate or read back spoils the whole frame, as it would for a
+  // single-threaded replay.
+  for (const std::optional<AlphaType>& alphaType : alphaTypes) {
+    if (alphaType != alphaTypes.front() || !alphaType.has_value()) {
+      return RendererBitmap();
+    }
+  }
+  result.alphaType = *alphaTypes.front();
+  return result;
+}
+
+/// Tile-parallel replay for frames with filter layers, whose output pixels depend on content
+/// beyond the tile. Tiles are dealt round-robin and each worker renders a full-size surface with
+/// only the draws that may touch one of its tiles, then each tile is copied from its owner.
+RendererBitmap ReplayTilesIntoFullSurfaces(
+    const std::vector<RenderCommand>& commands, const TileGrid& grid,
+    const std::vector<TileSpan>& spans,
+    const std::vector<std::unique_ptr<RendererInterface>>& renderers, WorkerPool& pool) {
+  const std::size_t workerCount = renderers.size();
+  std::vector<RendererBitmap> bitmaps(workerCount);
+  pool.run(workerCount, [&](std::size_t worker) {
+    Registry textRegistry;
+    ReplayCommands(commands, *renderers[worker], textRegistry, [&](std::size_t index) {
+      return spans[index].touchesTileOwnedBy(grid, worker, workerCount);
+    });
+    bitmaps[worker] = renderers[worker]->takeSnapshot();
+  });
+
+  // Worker 0's bitmap already holds its own tiles, copy every other tile over it.
+  RendererBitmap result = std::move(bitmaps[0]);
+  if (result.empty()) {
+    return result;
+  }
+
+  for (std::size_t tile = 0; tile < grid.tileCount(); ++tile) {
+    const std::size_t owner = tile % workerCount;
+    const RendererBitmap& source = bitmaps[owner];
+    if (owner == 0 || source.dimensions != result.dimensions ||
+        source.rowBytes != result.rowBytes) {
+      continue;
+    }
+
+    const TileSurface surface = grid.surface(tile, result.dimensions);
+    if (surface.size.x > 0 && surface.size.y > 0) {
+      CopyPixels(source, Vector2i::Zero(), result, surface.origin, surface.size);
+    }
+  }
+
+  return result;
+}
+
 }  // namespace
 
 struct RenderSnapshot::Impl {
@@ -411,30 +987,74 @@ std::size_t RenderSnapshot::liveRegistryReferenceCountForTesting(const Registry&
 
 void RenderSnapshot::replay(RendererInterface& renderer) const {
   Registry textRegistry;
-  std::size_t rejectedPatternDepth = 0;
-  for (const RenderCommand& command : impl_->commands) {
-    if (const auto* beginPattern = std::get_if<BeginPatternTileCommand>(&command)) {
-      if (rejectedPatternDepth > 0 ||
-          !renderer.beginPatternTile(beginPattern->tileRect, beginPattern->targetFromPattern)) {
-        ++rejectedPatternDepth;
-      }
-      continue;
-    }
+  ReplayCommands(impl_->commands, renderer, textRegistry, [](std::size_t) { return true; });
+}
 
-    if (const auto* endPattern = std::get_if<EndPatternTileCommand>(&command)) {
-      if (rejectedPatternDepth > 0) {
-        --rejectedPatternDepth;
-      } else {
-        renderer.endPatternTile(endPattern->forStroke);
-      }
-      continue;
+RendererBitmap RenderSnapshot::replayTiled(
+    const std::function<std::unique_ptr<RendererInterface>()>& createRenderer,
+    const TiledReplayOptions& options) const {
+  const std::vector<RenderCommand>& commands = impl_->commands;
+  const RenderViewport* viewport = nullptr;
+  for (const RenderCommand& command : commands) {
+    if (const auto* beginFrame = std::get_if<BeginFrameCommand>(&command)) {
+      viewport = &beginFrame->viewport;
+      break;
     }
+  }
 
-    if (rejectedPatternDepth > 0) {
-      continue;
-    }
-    ReplayCommand(command, renderer, textRegistry);
+  const int tileSize = std::max(options.tileSize, 1);
+  const std::optional<TileGrid> grid =
+      viewport != nullptr ? TileGrid::ForViewport(*viewport, tileSize) : std::nullopt;
+  std::size_t workerCount = options.threadCount;
+  if (workerCount == 0) {
+    workerCount = options.workerPool != nullptr ? options.workerPool->threadCount()
+                                                : std::thread::hardware_concurrency();
+  }
+  if (options.workerPool != nullptr) {
+    workerCount = std::min(workerCount, options.workerPool->threadCount());
   }
+  if (grid.has_value()) {
+    workerCount = std::min(workerCount, grid->tileCount());
+  }
+
+  if (!grid.has_value() || workerCount <= 1) {
+    std::unique_ptr<RendererInterface> renderer = createRenderer();
+    replay(*renderer);
+    return renderer->takeSnapshot();
+  }
+
+  // Workers share the snapshot's resource registry read-only. Entity lookups on a pool that does
+  // not exist yet would create it, so materialize every pool the resource mapper can populate
+  // while the registry is still quiescent.
+  Registry& resources = impl_->resourceRegistry;
+  static_cast<void>(resources.storage<components::ComputedGradientComponent>());
+  static_cast<void>(resources.storage<components::ComputedLinearGradientComponent>());
+  static_cast<void>(resources.storage<components::ComputedRadialGradientComponent>());
+  static_cast<void>(resources.storage<components::ComputedLocalTransformComponent>());
+  static_cast<void>(resources.storage<components::ComputedPatternComponent>());
+  static_cast<void>(resources.storage<components::MaskComponent>());
+  static_cast<void>(resources.storage<components::ComputedFilterComponent>());
+
+  const std::vector<TileSpan> spans = BinCommandsToTiles(commands, *grid);
+
+  std::vector<std::unique_ptr<RendererInterface>> renderers;
+  renderers.reserve(workerCount);
+  for (std::size_t i = 0; i < workerCount; ++i) {
+    renderers.push_back(createRenderer());
+  }
+
+  std::optional<WorkerPool> ownedPool;
+  WorkerPool& pool =
+      options.workerPool != nullptr ? *options.workerPool : ownedPool.emplace(workerCount);
+
+  // Filter output depends on content beyond the tile, and a fractional viewport leaves the edge
+  // tiles a fractional size; both render full-size surfaces instead.
+  const bool hasFilterLayers = std::ranges::any_of(commands, [](const RenderCommand& command) {
+    return std::holds_alternative<PushFilterLayerCommand>(command);
+  });
+  return hasFilterLayers || !grid->wholePixelFrame
+             ? ReplayTilesIntoFullSurfaces(commands, *grid, spans, renderers, pool)
+             : ReplayTilesIntoTileSurfaces(commands, *grid, spans, renderers, pool);
 }
 
 void RenderSnapshot::setSourceRevision(std::uint64_t revision) {
@@ -3,13 +3,32 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 
 #include "donner/svg/renderer/RendererInterface.h"
 
+namespace donner {
+class WorkerPool;
+}
+
 namespace donner::svg {
 
+/// Options for \ref RenderSnapshot::replayTiled.
+struct TiledReplayOptions {
+  /// Edge length of a square screen tile, in device pixels.
+  int tileSize = 256;
+
+  /// Number of worker threads, including the calling thread. Zero uses every thread of
+  /// \ref workerPool, or `std::thread::hardware_concurrency()` without one.
+  std::size_t threadCount = 0;
+
+  /// Threads to render on, capped at their count. A caller replaying every frame should keep one
+  /// pool for all of them; if null, a pool is started and stopped by each call.
+  WorkerPool* workerPool = nullptr;
+};
+
 /**
  * Immutable command stream captured from a prepared SVG document.
  *
@@ -68,6 +87,37 @@ public:
    */
   void replay(RendererInterface& renderer) const;
 
+  /**
+   * Replay the captured command stream on several threads, splitting the frame into screen tiles,
+   * and return the stitched result, byte-identical to \ref replay followed by `takeSnapshot()` on
+   * the same backend.
+   *
+   * Every draw command is binned by a conservative device-space bound, and a tile replays only the
+   * draws that may touch it, along with the state commands they depend on so that transform,
+   * clip, and layer state match the single-threaded replay. Workers take the next unrendered tile
+   * until none are left, render it, and copy it into place.
+   *
+   * A tile is rendered into a surface grown past the tile by a guard band that holds every draw,
+   * clip, and mask region the tile replays, clipped to the frame, with every device transform
+   * translated by the surface origin. A path is therefore clipped by the surface only where the
+   * frame would clip it, and curves are stepped from the same points as in a full-frame replay.
+   * The guard band spans the frame where a tile replays content whose bounds are not known, such
+   * as text.
+   *
+   * When the frame has filter layers, whose output depends on pixels beyond the tile, or a
+   * viewport that is not a whole number of pixels, tiles are instead dealt round-robin to the
+   * workers, and each renders a full-size surface holding only the draws that may touch one of
+   * its tiles.
+   *
+   * @param createRenderer Creates one backend per worker. Called on the calling thread; the
+   *     returned renderers are used from worker threads, one thread each.
+   * @param options Tile size and the threads to render on.
+   * @return The rendered frame, as returned by `takeSnapshot()`.
+   */
+  [[nodiscard]] RendererBitmap replayTiled(
+      const std::function<std::unique_ptr<RendererInterface>()>& createRenderer,
+      const TiledReplayOptions& options = TiledReplayOptions()) const;
+
 private:
   friend class RenderSnapshotRecorder;
   friend class RendererDriver;
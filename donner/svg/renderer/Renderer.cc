@@ -251,10 +251,13 @@ void RestoreRenderInvalidation(Registry& registry, const RenderInvalidationSnaps
   }
 
   if (snapshot.hadRenderTreeState) {
-    if (registry.ctx().contains<components::RenderTreeState>()) {
+    // The render instances themselves are not restored, so keep their current revision.
+    components::RenderTreeState restored = snapshot.renderTreeState;
+    if (const auto* current = registry.ctx().find<components::RenderTreeState>()) {
+      restored.instancesRevision = current->instancesRevision;
       registry.ctx().erase<components::RenderTreeState>();
     }
-    registry.ctx().emplace<components::RenderTreeState>(snapshot.renderTreeState);
+    registry.ctx().emplace<components::RenderTreeState>(restored);
   } else if (registry.ctx().contains<components::RenderTreeState>()) {
     registry.ctx().erase<components::RenderTreeState>();
   }
@@ -569,6 +572,12 @@ void Renderer::pushFilterLayer(const components::FilterGraph& filterGraph,
   impl_->pushFilterLayer(filterGraph, filterRegion);
 }
 
+bool Renderer::pushRetainedFilterLayer(const components::FilterGraph& filterGraph,
+                                       const std::optional<Box2d>& filterRegion,
+                                       const FilterLayerIdentity& identity) {
+  return impl_->pushRetainedFilterLayer(filterGraph, filterRegion, identity);
+}
+
 void Renderer::popFilterLayer() {
   impl_->popFilterLayer();
 }
@@ -581,6 +590,11 @@ void Renderer::pushMask(const std::optional<Box2d>& maskBounds, MaskType maskTyp
   impl_->pushMask(maskBounds, maskType);
 }
 
+bool Renderer::pushCachedMask(const std::optional<Box2d>& maskBounds, MaskType maskType,
+                              const MaskIdentity& identity) {
+  return impl_->pushCachedMask(maskBounds, maskType, identity);
+}
+
 void Renderer::transitionMaskToContent() {
   impl_->transitionMaskToContent();
 }
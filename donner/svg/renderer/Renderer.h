@@ -215,6 +215,19 @@ public:
   void pushFilterLayer(const components::FilterGraph& filterGraph,
                        const std::optional<Box2d>& filterRegion) override;
 
+  /**
+   * Pushes a filter layer, reusing the backend's previous output for the same content if it has
+   * one.
+   *
+   * @param filterGraph The filter graph to apply when the layer is popped.
+   * @param filterRegion Optional filter region bounds in user space.
+   * @param identity Identity of the content drawn into the layer.
+   * @return True if a previous output was reused and the content must not be drawn.
+   */
+  bool pushRetainedFilterLayer(const components::FilterGraph& filterGraph,
+                               const std::optional<Box2d>& filterRegion,
+                               const FilterLayerIdentity& identity) override;
+
   /// Pops the most recent filter layer.
   void popFilterLayer() override;
 
@@ -229,6 +242,18 @@ public:
   /// Begins mask rendering with an explicit luminance or alpha coverage mode.
   void pushMask(const std::optional<Box2d>& maskBounds, MaskType maskType) override;
 
+  /**
+   * Begins mask rendering, reusing the backend's coverage for the same mask content if it has
+   * one.
+   *
+   * @param maskBounds Optional mask bounds clip.
+   * @param maskType Whether mask coverage comes from luminance or alpha.
+   * @param identity Identity of the mask content.
+   * @return True if coverage was reused and the mask content must not be drawn.
+   */
+  bool pushCachedMask(const std::optional<Box2d>& maskBounds, MaskType maskType,
+                      const MaskIdentity& identity) override;
+
   /// Switches from mask rendering to masked content rendering.
   void transitionMaskToContent() override;
 
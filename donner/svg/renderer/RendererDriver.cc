@@ -20,6 +20,7 @@
 #include "donner/base/xml/components/TreeComponent.h"
 #include "donner/svg/components/AttachedIdLookup.h"
 #include "donner/svg/components/ComputedClipPathsComponent.h"
+#include "donner/svg/components/DirtyFlagsComponent.h"
 #include "donner/svg/components/ElementTypeComponent.h"
 #include "donner/svg/components/PathLengthComponent.h"
 #include "donner/svg/components/PreserveAspectRatioComponent.h"
@@ -617,6 +618,90 @@ std::unordered_set<Entity> collectOffscreenFeImageShadowEntities(Registry& regis
   return result;
 }
 
+/// Returns true if \p paint is a pattern whose tile subtree has to be rendered before drawing.
+bool IsPatternTilePaint(const components::ResolvedPaintServer& paint) {
+  const auto* ref = std::get_if<components::PaintResolvedReference>(&paint);
+  return ref != nullptr && ref->subtreeInfo &&
+         ref->reference.handle.try_get<components::ComputedPatternComponent>() != nullptr;
+}
+
+/// Resolve the draw state of \p instance that \ref RenderingInstanceList caches, which only
+/// changes when the render tree is rebuilt.
+RenderingInstanceList::Row CompileInstanceRow(
+    Registry& registry, const components::RenderingInstanceComponent& instance,
+    const components::ComputedStyleComponent& style) {
+  RenderingInstanceList::Row row;
+  if (!style.properties.has_value()) {
+    return row;
+  }
+
+  const PropertyRegistry& properties = style.properties.value();
+  row.flags |= RenderingInstanceList::HasStyle;
+  row.opacity = properties.opacity.get().value();
+  row.blendMode = properties.mixBlendMode.get().value();
+  if (row.opacity < 1.0 || row.blendMode != MixBlendMode::Normal ||
+      properties.isolation.get().value() == Isolation::Isolate) {
+    row.flags |= RenderingInstanceList::IsolatedLayer;
+  }
+
+  // `toResolvedClip` only produces a clip from these two sources, and charges the clip geometry
+  // budget when it does, so it still runs per draw for the instances that have one.
+  if (instance.clipPath.has_value() ||
+      instance.styleHandle(registry).all_of<components::ComputedClipPathsComponent>()) {
+    row.flags |= RenderingInstanceList::EntityClip;
+  }
+  if (IsPatternTilePaint(instance.resolvedFill)) {
+    row.flags |= RenderingInstanceList::PatternFill;
+  }
+  if (IsPatternTilePaint(instance.resolvedStroke)) {
+    row.flags |= RenderingInstanceList::PatternStroke;
+  }
+  if (properties.vectorEffect.getOr(VectorEffect::None) == VectorEffect::NonScalingStroke) {
+    row.flags |= RenderingInstanceList::TransformDependent;
+  }
+
+  row.paint = toPaintParams(registry, instance, style);
+  row.cullBounds = LocalDrawableBoundsWithStroke(instance.dataHandle(registry), style,
+                                                 instance.worldFromEntityTransform);
+  return row;
+}
+
+/**
+ * Returns the compiled draw list for the main render tree of \p registry, compiling it first if
+ * the render instances changed since it was last compiled. The list is kept in the registry
+ * context, so it survives across frames and drivers.
+ */
+const RenderingInstanceList& CompiledInstanceList(Registry& registry) {
+  std::uint64_t instancesRevision = 0;
+  if (const auto* renderState = registry.ctx().find<components::RenderTreeState>()) {
+    instancesRevision = renderState->instancesRevision;
+  }
+
+  auto* list = registry.ctx().find<RenderingInstanceList>();
+  if (list == nullptr) {
+    list = &registry.ctx().emplace<RenderingInstanceList>();
+  }
+  if (list->isCompiledFrom(instancesRevision)) {
+    return *list;
+  }
+
+  list->reset(instancesRevision);
+  const std::unordered_set<Entity> feImageShadowEntities =
+      collectOffscreenFeImageShadowEntities(registry);
+  for (RenderingInstanceView view(registry); !view.done(); view.advance()) {
+    const Entity entity = view.currentEntity();
+    if (feImageShadowEntities.count(entity) != 0) {
+      continue;
+    }
+
+    const components::RenderingInstanceComponent& instance = view.get();
+    const auto& style = instance.styleHandle(registry).get<components::ComputedStyleComponent>();
+    list->append(entity, CompileInstanceRow(registry, instance, style),
+                 instance.resolvedFilter.has_value());
+  }
+  return *list;
+}
+
 std::optional<Vector2i> resolveFeImageRenderSize(const components::FilterGraph& filterGraph,
                                                  const components::FilterNode& node) {
   const Box2d defaultSubregion =
@@ -1119,6 +1204,57 @@ std::optional<ImageParams> toImageParams(const components::RenderingInstanceComp
   return params;
 }
 
+/// Returns the draw order of the last instance drawn as part of \p instance, which is the last
+/// rendered entity of its subtree or any offscreen pattern, marker, or mask content that trails
+/// it.
+///
+/// Offscreen content is instantiated inline while preparing the element that uses it, so it sits
+/// right after that element in draw order but is not part of its subtree's last rendered entity.
+/// Normally the element's draw consumes it from the view; skipping the element means skipping it
+/// too.
+int SubtreeEndDrawOrder(Registry& registry,
+                        const components::RenderingInstanceComponent& instance, Entity entity) {
+  Entity last = instance.subtreeInfo ? instance.subtreeInfo->lastRenderedEntity : entity;
+  int endDrawOrder = registry.get<components::RenderingInstanceComponent>(last).drawOrder;
+  while (true) {
+    const auto& lastInstance = registry.get<components::RenderingInstanceComponent>(last);
+    Entity next = last;
+    const auto consider = [&](const std::optional<components::SubtreeInfo>& subtree) {
+      if (!subtree) {
+        return;
+      }
+      const int drawOrder =
+          registry.get<components::RenderingInstanceComponent>(subtree->lastRenderedEntity)
+              .drawOrder;
+      if (drawOrder > endDrawOrder) {
+        endDrawOrder = drawOrder;
+        next = subtree->lastRenderedEntity;
+      }
+    };
+
+    for (const components::ResolvedPaintServer* paint :
+         {&lastInstance.resolvedFill, &lastInstance.resolvedStroke}) {
+      if (const auto* ref = std::get_if<components::PaintResolvedReference>(paint)) {
+        consider(ref->subtreeInfo);
+      }
+    }
+    if (lastInstance.mask) {
+      consider(lastInstance.mask->subtreeInfo);
+    }
+    for (const std::optional<components::ResolvedMarker>* marker :
+         {&lastInstance.markerStart, &lastInstance.markerMid, &lastInstance.markerEnd}) {
+      if (marker->has_value()) {
+        consider((*marker)->subtreeInfo);
+      }
+    }
+
+    if (next == last) {
+      return endDrawOrder;
+    }
+    last = next;
+  }
+}
+
 }  // namespace
 
 void RendererDriver::syncFilterPreparationStats() {
@@ -1231,17 +1367,7 @@ bool RendererDriver::drawInterruptibly(SVGDocument& document, const RenderViewpo
     return false;
   }
 
-  const std::unordered_set<Entity> feImageShadowEntities =
-      collectOffscreenFeImageShadowEntities(document.registry());
-  std::vector<Entity> mainEntities;
-  RenderingInstanceView instances(document.registry());
-  while (!instances.done()) {
-    const Entity entity = instances.currentEntity();
-    if (feImageShadowEntities.count(entity) == 0) {
-      mainEntities.push_back(entity);
-    }
-    instances.advance();
-  }
+  const std::span<const Entity> mainEntities = CompiledInstanceList(document.registry()).entities();
 
   if (mainEntities.empty()) {
     renderer_.beginFrame(viewport);
@@ -1310,28 +1436,21 @@ void RendererDriver::drawPreparedDocument(SVGDocument& document, const RenderVie
   // nothing is dirty), so without this filter the 2nd+ render of a document containing an feImage
   // fragment reference would draw the referenced fragment as if it were main content. See
   // `collectOffscreenFeImageShadowEntities`.
-  const std::unordered_set<Entity> feImageShadowEntities =
-      collectOffscreenFeImageShadowEntities(document.registry());
-  std::vector<Entity> mainEntities;
-  {
-    RenderingInstanceView snapshot(document.registry());
-    while (!snapshot.done()) {
-      const Entity entity = snapshot.currentEntity();
-      if (feImageShadowEntities.count(entity) == 0) {
-        mainEntities.push_back(entity);
-      }
-      snapshot.advance();
-    }
-  }
+  //
+  // The compiled list is that snapshot, along with the draw state of each entity, and is only
+  // rebuilt when the render instances change. The feImage pre-pass below may change them, which
+  // leaves this frame's rows intact: it only adds shadow instances and reorders storage, and the
+  // list neither includes the former nor depends on the latter.
+  const RenderingInstanceList& compiled = CompiledInstanceList(document.registry());
 
   // Pre-pass: resolve + pre-render feImage fragments, caching per-entity. Must run before the
   // main traverse so the main view doesn't observe the storage mutation that
   // `createFeImageShadowTree` performs (it emplaces new rendering instances and sorts the global
   // pool).
-  prepareFilterGraphs(document.registry(), mainEntities);
+  prepareFilterGraphs(document.registry(), compiled.filterEntities());
 
-  RenderingInstanceView view(document.registry(), mainEntities);
-  traverse(view, document.registry());
+  RenderingInstanceView view(document.registry(), compiled.entities());
+  traverse(view, document.registry(), &compiled);
   renderer_.endFrame();
   surfaceFromCanvasTransform_ = Transform2d();
   preparedFilterGraphs_.clear();
@@ -1378,17 +1497,7 @@ void RendererDriver::drawDocumentIntoCurrentFrame(SVGDocument& document,
   ParseWarningSink warnings = ParseWarningSink::Disabled();
   RendererUtils::prepareDocumentForRendering(document, verbose_, warnings);
 
-  const std::unordered_set<Entity> feImageShadowEntities =
-      collectOffscreenFeImageShadowEntities(document.registry());
-  std::vector<Entity> mainEntities;
-  RenderingInstanceView instances(document.registry());
-  while (!instances.done()) {
-    const Entity entity = instances.currentEntity();
-    if (feImageShadowEntities.count(entity) == 0) {
-      mainEntities.push_back(entity);
-    }
-    instances.advance();
-  }
+  const std::span<const Entity> mainEntities = CompiledInstanceList(document.registry()).entities();
 
   if (mainEntities.empty()) {
     return;
@@ -2014,17 +2123,32 @@ void RendererDriver::prepareFilterGraphs(Registry& registry, std::span<const Ent
   }
 }
 
-void RendererDriver::traverse(RenderingInstanceView& view, Registry& registry) {
+void RendererDriver::traverse(RenderingInstanceView& view, Registry& registry,
+                              const RenderingInstanceList* compiled) {
   while (!view.done()) {
+    const std::size_t rowIndex = view.save().current;
     const components::RenderingInstanceComponent& instance = view.get();
     const Entity entity = view.currentEntity();
     view.advance();
 
+    if (compiled != nullptr &&
+        (compiled->flags(rowIndex) & RenderingInstanceList::HasStyle) == 0) {
+      continue;
+    }
+
     const auto& style = instance.styleHandle(registry).get<components::ComputedStyleComponent>();
     if (!style.properties.has_value()) {
       continue;
     }
 
+    // Draw state that only changes with the render tree comes from the compiled list, unless it
+    // depends on the world transform, which the compositor may update in place.
+    RenderingInstanceList::Row row =
+        compiled != nullptr &&
+                (compiled->flags(rowIndex) & RenderingInstanceList::TransformDependent) == 0
+            ? compiled->row(rowIndex)
+            : CompileInstanceRow(registry, instance, style);
+
     // Viewport clip rect is in the parent's coordinate space (includes x,y positioning).
     // Apply before the entity's own setTransform, so the clip is established with whatever
     // matrix was left from the previous element (which shares the parent's transform).
@@ -2048,23 +2172,22 @@ void RendererDriver::traverse(RenderingInstanceView& view, Registry& registry) {
     }
     renderer_.setTransform(instance.worldFromEntityTransform * surfaceFromCanvasTransform_);
 
-    const double opacity = style.properties->opacity.get().value();
-    const MixBlendMode blendMode = style.properties->mixBlendMode.get().value();
-    const Isolation isolation = style.properties->isolation.get().value();
-    const bool hasIsolatedLayer =
-        opacity < 1.0 || blendMode != MixBlendMode::Normal || isolation == Isolation::Isolate;
+    const bool hasIsolatedLayer = (row.flags & RenderingInstanceList::IsolatedLayer) != 0;
     if (hasIsolatedLayer) {
-      renderer_.pushIsolatedLayer(opacity, blendMode);
+      renderer_.pushIsolatedLayer(row.opacity, row.blendMode);
     }
 
     // Filter graph and region were resolved (and any feImage fragments pre-rendered) by
     // `prepareFilterGraphs` before the traverse started. Look them up from the cache rather than
     // mutating storage mid-iteration.
-    const components::FilterGraph* preparedGraph = preparedFilterGraphFor(entity);
-    const std::optional<Box2d> filterRegion = preparedFilterRegionFor(entity);
+    const bool hasFilter = instance.resolvedFilter.has_value();
+    const components::FilterGraph* preparedGraph =
+        hasFilter ? preparedFilterGraphFor(entity) : nullptr;
+    const std::optional<Box2d> filterRegion =
+        hasFilter ? preparedFilterRegionFor(entity) : std::nullopt;
     const bool hasFilterLayer = preparedGraph != nullptr && !preparedGraph->empty();
     // Per SVG spec, an empty or invalid filter reference makes the element invisible.
-    const bool filterHidesElement = instance.resolvedFilter.has_value() && !hasFilterLayer;
+    const bool filterHidesElement = hasFilter && !hasFilterLayer;
 
     int maskDepth = 0;
     // Track whether mask/pattern rendering consumed the element's subtree entities.
@@ -2079,37 +2202,64 @@ void RendererDriver::traverse(RenderingInstanceView& view, Registry& registry) {
     // Per SVG spec, the rendering order is: paint → filter → clip-path → mask → opacity.
     // Push in reverse so pop order applies the effects in spec order: mask outermost,
     // then clip-path, then filter innermost.
-    ResolvedClip entityClip =
-        toResolvedClip(instance, style, registry, *clipGeometryCopyBudget_, securityStats_);
-    entityClip.clipRect = std::nullopt;  // Already handled above as viewport clip.
-    const bool hasEntityClip = !entityClip.empty();
-    if (hasEntityClip) {
-      renderer_.pushClip(entityClip);
+    bool hasEntityClip = false;
+    if ((row.flags & RenderingInstanceList::EntityClip) != 0) {
+      ResolvedClip entityClip =
+          toResolvedClip(instance, style, registry, *clipGeometryCopyBudget_, securityStats_);
+      entityClip.clipRect = std::nullopt;  // Already handled above as viewport clip.
+      hasEntityClip = !entityClip.empty();
+      if (hasEntityClip) {
+        renderer_.pushClip(entityClip);
+      }
+    }
+
+    // Only the main document's own draw list offers its filter layers for reuse: its revisions
+    // cover everything drawn into them. A masked element renders its content through the mask
+    // pass, so there is no single layer to reuse.
+    bool filterOutputReused = false;
+    // Entity whose processing ends this element's subtree, for popping deferred layers.
+    Entity subtreeEnd = entity;
+    if (hasFilterLayer && compiled != nullptr && maskDepth == 0) {
+      FilterLayerIdentity identity;
+      identity.entity = EntityHandle(registry, entity);
+      if (const auto* documentContext = registry.ctx().find<components::SVGDocumentContext>()) {
+        identity.documentRevision = documentContext->mutationRevision();
+      }
+      identity.instancesRevision = compiled->instancesRevision();
+      filterOutputReused =
+          renderer_.pushRetainedFilterLayer(*preparedGraph, filterRegion, identity);
+    } else if (hasFilterLayer) {
+      renderer_.pushFilterLayer(*preparedGraph, filterRegion);
     }
 
-    if (hasFilterLayer) {
-      renderer_.pushFilterLayer(*preparedGraph, filterRegion);
+    if (filterOutputReused) {
+      // The layer is already composited, so nothing this element or its subtree would draw is
+      // needed this frame.
+      const int endDrawOrder = SubtreeEndDrawOrder(registry, instance, entity);
+      while (!view.done() && view.get().drawOrder <= endDrawOrder) {
+        view.advance();
+      }
+      if (instance.subtreeInfo) {
+        subtreeEnd = instance.subtreeInfo->lastRenderedEntity;
+      }
+      subtreeConsumedBySubRendering = true;
     }
 
     // Render pattern subtrees before drawing so the pattern shader is available.
-    if (const auto* fillRef =
-            std::get_if<components::PaintResolvedReference>(&instance.resolvedFill)) {
-      if (fillRef->subtreeInfo &&
-          fillRef->reference.handle.try_get<components::ComputedPatternComponent>()) {
-        renderPattern(view, registry, instance, *fillRef, /*forStroke=*/false);
-        subtreeConsumedBySubRendering = true;
-      }
+    if (!filterOutputReused && (row.flags & RenderingInstanceList::PatternFill) != 0) {
+      renderPattern(view, registry, instance,
+                    std::get<components::PaintResolvedReference>(instance.resolvedFill),
+                    /*forStroke=*/false);
+      subtreeConsumedBySubRendering = true;
     }
-    if (const auto* strokeRef =
-            std::get_if<components::PaintResolvedReference>(&instance.resolvedStroke)) {
-      if (strokeRef->subtreeInfo &&
-          strokeRef->reference.handle.try_get<components::ComputedPatternComponent>()) {
-        renderPattern(view, registry, instance, *strokeRef, /*forStroke=*/true);
-        subtreeConsumedBySubRendering = true;
-      }
+    if (!filterOutputReused && (row.flags & RenderingInstanceList::PatternStroke) != 0) {
+      renderPattern(view, registry, instance,
+                    std::get<components::PaintResolvedReference>(instance.resolvedStroke),
+                    /*forStroke=*/true);
+      subtreeConsumedBySubRendering = true;
     }
 
-    PaintParams paint = toPaintParams(registry, instance, style);
+    PaintParams paint = std::move(row.paint);
     applyDrawTimeContextRemaps(paint, instance);
     renderer_.setPaint(paint);
 
@@ -2126,9 +2276,7 @@ void RendererDriver::traverse(RenderingInstanceView& view, Registry& registry) {
           std::any_of(subtreeMarkers_.begin(), subtreeMarkers_.end(),
                       [](const DeferredPop& m) { return m.hasFilterLayer; });
       if (!insideFilterLayer) {
-        if (const auto localBounds = LocalDrawableBoundsWithStroke(
-                instance.dataHandle(registry), style, instance.worldFromEntityTransform);
-            localBounds.has_value()) {
+        if (const std::optional<Box2d>& localBounds = row.cullBounds; localBounds.has_value()) {
           const Transform2d deviceFromLocal =
               instance.worldFromEntityTransform * surfaceFromCanvasTransform_;
           const Box2d deviceBox = deviceFromLocal.transformBox(*localBounds);
@@ -2137,7 +2285,7 @@ void RendererDriver::traverse(RenderingInstanceView& view, Registry& registry) {
       }
     }
 
-    if (instance.visible && !filterHidesElement && !cullDraw) {
+    if (instance.visible && !filterHidesElement && !cullDraw && !filterOutputReused) {
       if (const auto* path =
               instance.dataHandle(registry).try_get<components::ComputedPathComponent>()) {
         drawPathWithPaintOrder(view, registry, instance, *path, style, paint,
@@ -2275,7 +2423,7 @@ void RendererDriver::traverse(RenderingInstanceView& view, Registry& registry) {
     }
 
     // Pop deferred subtree layers when we reach their last entity.
-    while (!subtreeMarkers_.empty() && subtreeMarkers_.back().lastEntity == entity) {
+    while (!subtreeMarkers_.empty() && subtreeMarkers_.back().lastEntity == subtreeEnd) {
       const DeferredPop& deferred = subtreeMarkers_.back();
       if (deferred.hasFilterLayer) {
         renderer_.popFilterLayer();
@@ -2655,25 +2803,42 @@ int RendererDriver::renderMask(RenderingInstanceView& view, Registry& registry,
                                                                                 : "userSpace")
                 << "\n";
     }
-    renderer_.pushMask(maskBounds, maskType);
-
-    const Transform2d savedSurfaceFromCanvas = surfaceFromCanvasTransform_;
-    surfaceFromCanvasTransform_ = instance.worldFromEntityTransform * surfaceFromCanvasTransform_;
-
+    Transform2d surfaceFromMaskContent =
+        instance.worldFromEntityTransform * surfaceFromCanvasTransform_;
     if (mc->maskContentUnits == MaskContentUnits::ObjectBoundingBox) {
       const Transform2d userSpaceFromMaskContent = Transform2d::Scale(shapeLocalBounds.size()) *
                                                    Transform2d::Translate(shapeLocalBounds.topLeft);
-      surfaceFromCanvasTransform_ = userSpaceFromMaskContent * surfaceFromCanvasTransform_;
+      surfaceFromMaskContent = userSpaceFromMaskContent * surfaceFromMaskContent;
     }
 
+    // Every element using this mask instantiates its own copy of the content from the same
+    // definition, so the definition and the document revisions identify what the content draws.
+    bool coverageReused = false;
     if (!shapeLocalBounds.isEmpty()) {
+      MaskIdentity identity;
+      identity.entity = m->reference.handle;
+      if (const auto* documentContext = registry.ctx().find<components::SVGDocumentContext>()) {
+        identity.documentRevision = documentContext->mutationRevision();
+      }
+      if (const auto* renderState = registry.ctx().find<components::RenderTreeState>()) {
+        identity.instancesRevision = renderState->instancesRevision;
+      }
+      identity.surfaceFromMaskContent = surfaceFromMaskContent;
+      coverageReused = renderer_.pushCachedMask(maskBounds, maskType, identity);
+    } else {
+      renderer_.pushMask(maskBounds, maskType);
+    }
+
+    if (!shapeLocalBounds.isEmpty() && !coverageReused) {
+      const Transform2d savedSurfaceFromCanvas = surfaceFromCanvasTransform_;
+      surfaceFromCanvasTransform_ = surfaceFromMaskContent;
       traverseRange(view, registry, m->subtreeInfo->firstRenderedEntity,
                     m->subtreeInfo->lastRenderedEntity);
+      surfaceFromCanvasTransform_ = savedSurfaceFromCanvas;
     } else {
       skipUntil(view, m->subtreeInfo->lastRenderedEntity);
     }
 
-    surfaceFromCanvasTransform_ = savedSurfaceFromCanvas;
     renderer_.transitionMaskToContent();
   }
 
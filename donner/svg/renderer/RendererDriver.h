@@ -18,6 +18,7 @@
 #include "donner/svg/core/PreserveAspectRatio.h"
 #include "donner/svg/renderer/RenderSnapshot.h"
 #include "donner/svg/renderer/RendererInterface.h"
+#include "donner/svg/renderer/common/RenderingInstanceList.h"
 #include "donner/svg/renderer/common/RenderingInstanceView.h"
 
 namespace donner::svg {
@@ -261,7 +262,16 @@ private:
   [[nodiscard]] bool drawPreparedEntityRange(Registry& registry, Entity firstEntity,
                                              Entity lastEntity,
                                              const std::function<bool()>& shouldCancel);
-  void traverse(RenderingInstanceView& view, Registry& registry);
+  /**
+   * Draw every instance remaining in \p view.
+   *
+   * @param view Instances to draw.
+   * @param registry Registry holding the instances.
+   * @param compiled Compiled draw state for the instances, whose rows must match the positions in
+   *   \p view. When null, the draw state is resolved from the registry for each instance.
+   */
+  void traverse(RenderingInstanceView& view, Registry& registry,
+                const RenderingInstanceList* compiled = nullptr);
   void traverseRange(RenderingInstanceView& view, Registry& registry, Entity startEntity,
                      Entity endEntity);
   void skipUntil(RenderingInstanceView& view, Entity endEntity);
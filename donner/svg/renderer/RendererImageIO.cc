@@ -2,12 +2,72 @@
 
 #include <stb/stb_image_write.h>
 
+#include <array>
 #include <cassert>
 #include <fstream>
 #include <limits>
+#include <string_view>
 
 namespace donner::svg {
 
+namespace {
+
+constexpr std::array<uint8_t, 8> kPngSignature = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+/// Table for the CRC-32 used by PNG chunks (ISO 3309, reflected polynomial 0xEDB88320).
+constexpr std::array<uint32_t, 256> MakeCrcTable() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t n = 0; n < 256; ++n) {
+    uint32_t c = n;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    table[n] = c;
+  }
+  return table;
+}
+
+constexpr std::array<uint32_t, 256> kCrcTable = MakeCrcTable();
+
+uint32_t UpdateCrc(uint32_t crc, std::span<const uint8_t> bytes) {
+  for (const uint8_t byte : bytes) {
+    crc = kCrcTable[(crc ^ byte) & 0xFFu] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+void AppendU32(std::vector<uint8_t>& out, uint32_t value) {
+  out.push_back(static_cast<uint8_t>(value >> 24));
+  out.push_back(static_cast<uint8_t>(value >> 16));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+void AppendU16(std::vector<uint8_t>& out, uint16_t value) {
+  out.push_back(static_cast<uint8_t>(value >> 8));
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t ReadU32(std::span<const uint8_t> bytes) {
+  return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) |
+         uint32_t(bytes[3]);
+}
+
+/// Append a PNG chunk: length, type, payload and the CRC over type and payload.
+void AppendChunk(std::vector<uint8_t>& out, std::string_view type,
+                 std::span<const uint8_t> payload) {
+  assert(type.size() == 4);
+  AppendU32(out, static_cast<uint32_t>(payload.size()));
+  const std::size_t typeOffset = out.size();
+  out.insert(out.end(), type.begin(), type.end());
+  out.insert(out.end(), payload.begin(), payload.end());
+  const uint32_t crc =
+      UpdateCrc(0xFFFFFFFFu, std::span<const uint8_t>(out).subspan(typeOffset)) ^ 0xFFFFFFFFu;
+  AppendU32(out, crc);
+}
+
+}  // namespace
+
 bool RendererImageIO::writeRgbaPixelsToPngFile(const char* filename,
                                                std::span<const uint8_t> rgbaPixels, int width,
                                                int height, size_t strideInPixels) {
@@ -62,4 +122,101 @@ std::vector<uint8_t> RendererImageIO::writeRgbaPixelsToPngMemory(
   return context.buffer;
 }
 
+ApngEncoder::ApngEncoder(int width, int height, std::uint16_t ticksPerSecond)
+    : width_(width), height_(height), ticksPerSecond_(ticksPerSecond) {
+  assert(width > 0);
+  assert(height > 0);
+  assert(ticksPerSecond > 0);
+}
+
+void ApngEncoder::addFrame(std::span<const uint8_t> rgbaPixels, size_t strideInPixels) {
+  // Let stb compress the frame as a standalone PNG, then lift out its header and image data: an
+  // APNG frame is the same zlib stream, only wrapped in different chunks.
+  const std::vector<uint8_t> png =
+      RendererImageIO::writeRgbaPixelsToPngMemory(rgbaPixels, width_, height_, strideInPixels);
+
+  auto imageData = std::make_shared<std::vector<uint8_t>>();
+  std::span<const uint8_t> remaining(png);
+  if (remaining.size() < kPngSignature.size()) {
+    return;
+  }
+  remaining = remaining.subspan(kPngSignature.size());
+  while (remaining.size() >= 12) {
+    const uint32_t length = ReadU32(remaining);
+    if (length > remaining.size() - 12) {
+      break;
+    }
+    const std::string_view type(reinterpret_cast<const char*>(remaining.data() + 4), 4);
+    const std::span<const uint8_t> payload = remaining.subspan(8, length);
+    if (type == "IHDR" && header_.empty()) {
+      header_.assign(payload.begin(), payload.end());
+    } else if (type == "IDAT") {
+      imageData->insert(imageData->end(), payload.begin(), payload.end());
+    }
+    remaining = remaining.subspan(12 + length);
+  }
+
+  frames_.push_back(Frame{std::move(imageData), 1});
+}
+
+void ApngEncoder::extendLastFrame() {
+  if (frames_.empty()) {
+    return;
+  }
+
+  Frame& last = frames_.back();
+  if (last.delayTicks == std::numeric_limits<std::uint16_t>::max()) {
+    // The delay field is 16 bits; continue the same image in a new frame.
+    frames_.push_back(Frame{last.imageData, 1});
+  } else {
+    ++last.delayTicks;
+  }
+}
+
+std::vector<uint8_t> ApngEncoder::finish() const {
+  std::vector<uint8_t> out;
+  if (frames_.empty() || header_.empty()) {
+    return out;
+  }
+
+  out.insert(out.end(), kPngSignature.begin(), kPngSignature.end());
+  AppendChunk(out, "IHDR", header_);
+
+  std::vector<uint8_t> payload;
+  AppendU32(payload, static_cast<uint32_t>(frames_.size()));  // num_frames
+  AppendU32(payload, 0);                                      // num_plays: loop forever
+  AppendChunk(out, "acTL", payload);
+
+  // fcTL and fdAT chunks share one sequence counter.
+  uint32_t sequence = 0;
+  for (std::size_t i = 0; i < frames_.size(); ++i) {
+    const Frame& frame = frames_[i];
+
+    payload.clear();
+    AppendU32(payload, sequence++);
+    AppendU32(payload, static_cast<uint32_t>(width_));
+    AppendU32(payload, static_cast<uint32_t>(height_));
+    AppendU32(payload, 0);  // x_offset
+    AppendU32(payload, 0);  // y_offset
+    AppendU16(payload, frame.delayTicks);
+    AppendU16(payload, ticksPerSecond_);
+    payload.push_back(0);  // dispose_op: APNG_DISPOSE_OP_NONE
+    payload.push_back(0);  // blend_op: APNG_BLEND_OP_SOURCE
+    AppendChunk(out, "fcTL", payload);
+
+    if (i == 0) {
+      // The first frame doubles as the default image shown by viewers without APNG support.
+      AppendChunk(out, "IDAT", *frame.imageData);
+    } else {
+      payload.clear();
+      AppendU32(payload, sequence++);
+      payload.insert(payload.end(), frame.imageData->begin(), frame.imageData->end());
+      AppendChunk(out, "fdAT", payload);
+    }
+  }
+
+  AppendChunk(out, "IEND", {});
+  return out;
+}
+
 }  // namespace donner::svg
@@ -1,7 +1,9 @@
 #pragma once
 /// @file
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <span>
 #include <vector>
 
@@ -39,4 +41,58 @@ public:
                                                          size_t strideInPixels = 0);
 };
 
+/**
+ * Incremental encoder for animated PNG (APNG) files.
+ *
+ * Frames are compressed as they are added, so only the encoded data of earlier frames is held in
+ * memory. Every frame covers the full canvas and replaces the previous one. A frame identical to
+ * its predecessor can be recorded with \ref extendLastFrame, which lengthens the previous frame's
+ * display time instead of storing another copy.
+ *
+ * The animation loops forever. Viewers without APNG support display the first frame.
+ */
+class ApngEncoder {
+public:
+  /**
+   * Create an encoder.
+   *
+   * @param width Width of every frame, in pixels.
+   * @param height Height of every frame, in pixels.
+   * @param ticksPerSecond Frame delays are whole multiples of `1 / ticksPerSecond` seconds.
+   */
+  ApngEncoder(int width, int height, std::uint16_t ticksPerSecond);
+
+  /**
+   * Append a frame shown for one tick.
+   *
+   * @param rgbaPixels Span containing RGBA-ordered pixel data.
+   * @param strideInPixels Stride in pixels. Defaults to 0, which assumes a stride of width.
+   */
+  void addFrame(std::span<const uint8_t> rgbaPixels, size_t strideInPixels = 0);
+
+  /// Show the last added frame for one more tick. Has no effect before the first frame.
+  void extendLastFrame();
+
+  /// Number of frames stored so far. Extended frames count once.
+  std::size_t frameCount() const { return frames_.size(); }
+
+  /// Encode the animation as an APNG file, or return an empty vector if no frame was added.
+  std::vector<uint8_t> finish() const;
+
+private:
+  /// One stored frame.
+  struct Frame {
+    /// Concatenated zlib stream of the frame's IDAT chunks, shared by frames split from one long
+    /// extended frame.
+    std::shared_ptr<const std::vector<uint8_t>> imageData;
+    std::uint16_t delayTicks = 1;  //!< Display time, in ticks.
+  };
+
+  int width_;
+  int height_;
+  std::uint16_t ticksPerSecond_;
+  std::vector<uint8_t> header_;  //!< IHDR chunk payload, taken from the first frame.
+  std::vector<Frame> frames_;
+};
+
 }  // namespace donner::svg
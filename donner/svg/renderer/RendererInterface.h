@@ -890,6 +890,53 @@ struct TextParams {
   entt::entity textRootEntity = entt::null;
 };
 
+/**
+ * Identifies the content a filter layer is about to render, for backends that keep the filtered
+ * output of a layer across frames.
+ *
+ * Two layers with the same entity and revisions draw the same content: the revisions cover every
+ * input the driver reads while rendering the subtree, so a backend may reuse its previous output
+ * instead of rendering the subtree again, provided its own per-frame inputs (transform, surface,
+ * clip) also match.
+ */
+struct FilterLayerIdentity {
+  /// Entity that references the filter. A null `EntityHandle` (the default) means the layer has
+  /// no stable identity and must be rendered.
+  EntityHandle entity;
+  /// Mutation revision of the document the entity belongs to. @see
+  /// components::SVGDocumentContext::mutationRevision.
+  std::uint64_t documentRevision = 0;
+  /// Revision of the render instances, which changes when the render tree is rebuilt. 0 means the
+  /// instances are untracked, and never matches. @see
+  /// components::RenderTreeState::instancesRevision.
+  std::uint64_t instancesRevision = 0;
+};
+
+/**
+ * Identifies the content of a mask about to be rendered, for backends that keep mask coverage
+ * across users and frames.
+ *
+ * Two masks with the same entity, revisions, and content transform draw the same content: the
+ * revisions cover the mask definition and every element instantiated from it, so a backend may
+ * reuse coverage it produced for either, provided its own inputs (mask region, device transform,
+ * surface, clip) also match.
+ */
+struct MaskIdentity {
+  /// The \ref xml_mask element. A null `EntityHandle` (the default) means the mask has no stable
+  /// identity and must be rendered.
+  EntityHandle entity;
+  /// Mutation revision of the document the entity belongs to. @see
+  /// components::SVGDocumentContext::mutationRevision.
+  std::uint64_t documentRevision = 0;
+  /// Revision of the render instances, which changes when the render tree is rebuilt. 0 means the
+  /// instances are untracked, and never matches. @see
+  /// components::RenderTreeState::instancesRevision.
+  std::uint64_t instancesRevision = 0;
+  /// Transform the mask content is drawn with, including the `maskContentUnits` bounding box
+  /// mapping.
+  Transform2d surfaceFromMaskContent;
+};
+
 /**
  * Backend-agnostic rendering interface consumed by RendererDriver during document traversal.
  *
@@ -1002,6 +1049,27 @@ public:
   virtual void pushFilterLayer(const components::FilterGraph& filterGraph,
                                const std::optional<Box2d>& filterRegion) = 0;
 
+  /**
+   * Pushes a filter layer whose content is identified by \p identity, letting the backend reuse
+   * the filtered output it produced for the same content on an earlier frame.
+   *
+   * Returns true if the backend reused a previous output. The layer is then already composited:
+   * the driver skips drawing the element and its subtree, and pops the layer with
+   * `popFilterLayer()` as usual. Returns false if the layer was pushed as by `pushFilterLayer()`,
+   * and the content must be drawn. The default implementation never reuses output.
+   *
+   * @param filterGraph The filter graph describing primitives and their connections.
+   * @param filterRegion The filter region bounds in local coordinates. @see pushFilterLayer.
+   * @param identity Identity of the content drawn into the layer.
+   */
+  virtual bool pushRetainedFilterLayer(const components::FilterGraph& filterGraph,
+                                       const std::optional<Box2d>& filterRegion,
+                                       const FilterLayerIdentity& identity) {
+    (void)identity;
+    pushFilterLayer(filterGraph, filterRegion);
+    return false;
+  }
+
   /**
    * Pops the most recent filter layer.
    */
@@ -1238,6 +1306,26 @@ public:
     (void)maskType;
     pushMask(maskBounds);
   }
+
+  /**
+   * Begins mask rendering for a mask whose content is identified by \p identity, letting the
+   * backend reuse coverage it produced for the same content on an earlier user or frame.
+   *
+   * Returns true if the backend reused coverage. The mask is then already rendered: the driver
+   * skips the mask content and continues with `transitionMaskToContent()` as usual. Returns false
+   * if the mask was pushed as by `pushMask()`, and the content must be drawn. The default
+   * implementation never reuses coverage.
+   *
+   * @param maskBounds Optional clip rect for the mask region.
+   * @param maskType Whether mask coverage comes from luminance or alpha.
+   * @param identity Identity of the mask content.
+   */
+  virtual bool pushCachedMask(const std::optional<Box2d>& maskBounds, MaskType maskType,
+                              const MaskIdentity& identity) {
+    (void)identity;
+    pushMask(maskBounds, maskType);
+    return false;
+  }
 };
 
 }  // namespace donner::svg
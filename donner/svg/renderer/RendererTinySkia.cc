@@ -6,9 +6,11 @@
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <limits>
 #include <optional>
 #include <span>
+#include <type_traits>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -16,6 +18,7 @@
 #include "donner/base/EcsRegistry.h"
 #include "donner/base/Length.h"
 #include "donner/base/MathUtils.h"
+#include "donner/base/SharedGeometry.h"
 #include "donner/svg/components/layout/TransformComponent.h"
 #include "donner/svg/components/paint/GradientComponent.h"
 #include "donner/svg/components/paint/LinearGradientComponent.h"
@@ -31,6 +34,7 @@
 #include "donner/svg/renderer/RendererDriver.h"
 #include "donner/svg/renderer/RendererImageIO.h"
 #include "donner/svg/renderer/RendererTinySkiaCache.h"
+#include "donner/svg/resources/DecodedImageCache.h"
 #ifdef DONNER_TEXT_ENABLED
 #include "donner/svg/components/text/ComputedTextGeometryComponent.h"
 #include "donner/svg/renderer/PlacedTextGeometry.h"
@@ -382,6 +386,54 @@ tiny_skia::Path toTinyPath(const Path& spline,
   return builder.finish().value_or(tiny_skia::Path());
 }
 
+/// \ref toTinyPath for an interned outline. The points are already narrowed to float, with the
+/// same `static_cast` as \ref NarrowToFloat, so the result is identical to converting the
+/// `donner::Path` the outline was interned from.
+tiny_skia::Path toTinyPath(const SharedGeometry& geometry, TinyPathCloseBehavior closeBehavior) {
+  const std::span<const Vector2f> points = geometry.points();
+  tiny_skia::PathBuilder builder(geometry.verbs().size(), points.size());
+
+  std::size_t pointIndex = 0;
+  Vector2f subpathStart;
+  for (const Path::Verb verb : geometry.verbs()) {
+    switch (verb) {
+      case Path::Verb::MoveTo: {
+        subpathStart = points[pointIndex];
+        builder.moveTo(subpathStart.x, subpathStart.y);
+        break;
+      }
+      case Path::Verb::LineTo: {
+        builder.lineTo(points[pointIndex].x, points[pointIndex].y);
+        break;
+      }
+      case Path::Verb::QuadTo: {
+        const Vector2f& control = points[pointIndex];
+        const Vector2f& endPoint = points[pointIndex + 1];
+        builder.quadTo(control.x, control.y, endPoint.x, endPoint.y);
+        break;
+      }
+      case Path::Verb::CurveTo: {
+        const Vector2f& control1 = points[pointIndex];
+        const Vector2f& control2 = points[pointIndex + 1];
+        const Vector2f& endPoint = points[pointIndex + 2];
+        builder.cubicTo(control1.x, control1.y, control2.x, control2.y, endPoint.x, endPoint.y);
+        break;
+      }
+      case Path::Verb::ClosePath: {
+        if (closeBehavior == TinyPathCloseBehavior::Preserve) {
+          builder.close();
+        } else {
+          builder.lineTo(subpathStart.x, subpathStart.y);
+        }
+        break;
+      }
+    }
+    pointIndex += Path::pointsPerVerb(verb);
+  }
+
+  return builder.finish().value_or(tiny_skia::Path());
+}
+
 /// Marks a registry whose conversion-cache invalidation listeners are already connected.
 ///
 /// The sentinel lives in the registry's context store, so it dies with the registry: a later
@@ -447,8 +499,8 @@ void EnsureCacheInvalidationWired(Registry& registry, const Registry*& checkedTh
 /// as a two-way ternary. A ternary silently folds any future close behavior into the `openedPath`
 /// slot, which would serve one behavior's outline for another - a wrong-pixels bug that no test
 /// of the existing two behaviors can see. Here `-Wswitch` names the missing case instead.
-std::optional<tiny_skia::Path>& cacheSlotFor(components::TinySkiaPathCacheComponent& cache,
-                                             TinyPathCloseBehavior closeBehavior) {
+std::shared_ptr<const tiny_skia::Path>& cacheSlotFor(components::TinySkiaPathCacheComponent& cache,
+                                                     TinyPathCloseBehavior closeBehavior) {
   switch (closeBehavior) {
     case TinyPathCloseBehavior::Preserve: return cache.closedPath;
     case TinyPathCloseBehavior::EndWithLine: return cache.openedPath;
@@ -457,12 +509,30 @@ std::optional<tiny_skia::Path>& cacheSlotFor(components::TinySkiaPathCacheCompon
   UTILS_UNREACHABLE();
 }
 
+/// Keys of the tiny-skia conversions derived from a \ref SharedGeometry, one per close behavior.
+constexpr SharedGeometry::DerivedTag kTinyPathPreserveTag{"tiny_skia::Path (ClosePath)"};
+constexpr SharedGeometry::DerivedTag kTinyPathEndWithLineTag{"tiny_skia::Path (closing line)"};
+
+/// Selects the derived-cache key for \p closeBehavior, exhaustive for the same reason as
+/// \ref cacheSlotFor.
+const SharedGeometry::DerivedTag& derivedTagFor(TinyPathCloseBehavior closeBehavior) {
+  switch (closeBehavior) {
+    case TinyPathCloseBehavior::Preserve: return kTinyPathPreserveTag;
+    case TinyPathCloseBehavior::EndWithLine: return kTinyPathEndWithLineTag;
+  }
+
+  UTILS_UNREACHABLE();
+}
+
 /// Returns `shape.path` in tiny-skia form, converting it on a cache miss.
 ///
 /// When the shape carries a source entity the conversion is memoized on that entity and the
 /// returned reference points into the cache component, which stays valid until the entity's
-/// geometry changes. Without a source entity (overlay drawing, test harnesses) the conversion
-/// lands in \p scratch, which the caller must keep alive for as long as it uses the result.
+/// geometry changes. A per-entity miss on a shape drawing its own `ComputedPathComponent` is
+/// served from the conversion derived on the component's \ref SharedGeometry, so every entity
+/// with the same outline shares one conversion, and only the first of them pays for it. Without
+/// a source entity (overlay drawing, test harnesses) the conversion lands in \p scratch, which
+/// the caller must keep alive for as long as it uses the result.
 const tiny_skia::Path& ResolveTinyPath(const PathShape& shape, TinyPathCloseBehavior closeBehavior,
                                        tiny_skia::Path& scratch, const Registry*& checkedThisFrame,
                                        RendererTinySkiaFrameCounters& counters) {
@@ -475,41 +545,82 @@ const tiny_skia::Path& ResolveTinyPath(const PathShape& shape, TinyPathCloseBeha
 
   EnsureCacheInvalidationWired(*source.registry(), checkedThisFrame);
   auto& cache = source.get_or_emplace<components::TinySkiaPathCacheComponent>();
-  std::optional<tiny_skia::Path>& slot = cacheSlotFor(cache, closeBehavior);
-  if (!slot.has_value()) {
+  std::shared_ptr<const tiny_skia::Path>& slot = cacheSlotFor(cache, closeBehavior);
+  if (slot) {
+    return *slot;
+  }
+
+  // Only the entity's own component geometry is interned. A shape pointing at any other path,
+  // such as a copy held by a replayed snapshot, converts on its own.
+  const auto* computedPath = source.try_get<components::ComputedPathComponent>();
+  if (computedPath == nullptr || shape.path != &computedPath->spline) {
     ++counters.pathConversions;
-    slot = toTinyPath(shape.pathOrEmpty(), closeBehavior);
+    slot = std::make_shared<const tiny_skia::Path>(toTinyPath(shape.pathOrEmpty(), closeBehavior));
+    return *slot;
+  }
+
+  const SharedGeometry& geometry = *computedPath->sharedGeometry();
+  bool built = false;
+  slot = geometry.derived<tiny_skia::Path>(derivedTagFor(closeBehavior), [&] {
+    built = true;
+    return toTinyPath(geometry, closeBehavior);
+  });
+  if (built) {
+    ++counters.pathConversions;
+  } else {
+    ++counters.sharedPathHits;
   }
   return *slot;
 }
 
+/// Premultiplied pixels for an `<image>` draw, plus the mip chain stored alongside them.
+struct ResolvedPremultipliedImage {
+  std::span<const std::uint8_t> pixels;
+  /// Null when the pixels live in per-draw scratch and there is nowhere to keep levels.
+  ImageMipChain* mipChain = nullptr;
+};
+
 /// Returns \p image's pixels premultiplied, converting them on a cache miss.
 ///
-/// Mirrors \ref ResolveTinyPath: the payload is memoized on \p source when there is one, and
-/// otherwise converted into \p scratch, which the caller must keep alive for as long as it uses
-/// the result. A cached payload whose dimensions no longer match \p image is reconverted rather
-/// than sampled at the wrong extent.
-std::span<const std::uint8_t> ResolvePremultipliedImage(const ImageResource& image,
-                                                        EntityHandle source,
-                                                        std::vector<std::uint8_t>& scratch,
-                                                        const Registry*& checkedThisFrame,
-                                                        RendererTinySkiaFrameCounters& counters) {
+/// Images loaded through an enabled \ref DecodedImageCache carry a process-wide shared payload,
+/// whose premultiplied form and mip chain are derived once and borrowed by every document that
+/// draws it; the per-entity cache is skipped for those so the document does not hold a second
+/// copy. Otherwise this mirrors \ref ResolveTinyPath: the payload is memoized on \p source when
+/// there is one, and otherwise converted into \p scratch, which the caller must keep alive for as
+/// long as it uses the result. A cached payload whose dimensions no longer match \p image is
+/// reconverted rather than sampled at the wrong extent.
+ResolvedPremultipliedImage ResolvePremultipliedImage(const ImageResource& image,
+                                                     EntityHandle source,
+                                                     std::vector<std::uint8_t>& scratch,
+                                                     const Registry*& checkedThisFrame,
+                                                     RendererTinySkiaFrameCounters& counters) {
+  if (const DecodedImage* shared = image.shared.get();
+      shared != nullptr && shared->width() == image.width && shared->height() == image.height) {
+    if (shared->hasPremultiplied()) {
+      ++counters.sharedImageHits;
+    } else {
+      ++counters.imagePremultiplies;
+    }
+    return {shared->premultiplied(&PremultiplyRgbaInto), &shared->mipChain()};
+  }
+
   if (!source) {
     ++counters.imagePremultiplies;
-    PremultiplyRgbaInto(image.data, scratch);
-    return scratch;
+    PremultiplyRgbaInto(image.pixels(), scratch);
+    return {scratch, nullptr};
   }
 
   EnsureCacheInvalidationWired(*source.registry(), checkedThisFrame);
   auto& cache = source.get_or_emplace<components::TinySkiaImageCacheComponent>();
-  if (cache.premultiplied.size() != image.data.size() || cache.width != image.width ||
+  if (cache.premultiplied.size() != image.pixels().size() || cache.width != image.width ||
       cache.height != image.height) {
     ++counters.imagePremultiplies;
-    PremultiplyRgbaInto(image.data, cache.premultiplied);
+    PremultiplyRgbaInto(image.pixels(), cache.premultiplied);
     cache.width = image.width;
     cache.height = image.height;
+    cache.mips.reset();
   }
-  return cache.premultiplied;
+  return {cache.premultiplied, &cache.mips};
 }
 
 ImageRendering ResolveImageRendering(const ImageParams& params) {
@@ -680,9 +791,22 @@ Transform2d resolveGradientTransform(
   return Transform2d::Translate(-origin) * parentFromEntity * Transform2d::Translate(origin);
 }
 
+/// Gives a multi-stop gradient its shared color table when the cache is enabled. Gradients that
+/// degenerated to a solid color pass through.
+template <typename ShaderT>
+void attachGradientLut(GradientLutCache* lutCache, ShaderT& shader) {
+  if constexpr (!std::is_same_v<std::decay_t<ShaderT>, tiny_skia::Color>) {
+    if (lutCache != nullptr) {
+      // Paints here are never given another color space.
+      lutCache->attach(shader.base_, tiny_skia::Paint().colorspace);
+    }
+  }
+}
+
 std::optional<tiny_skia::Shader> instantiateGradientShader(
     RendererDrawBudget& drawBudget, const components::PaintResolvedReference& ref,
-    const Box2d& pathBounds, const Box2d& viewBox, const css::RGBA& currentColor, float opacity) {
+    const Box2d& pathBounds, const Box2d& viewBox, const css::RGBA& currentColor, float opacity,
+    GradientLutCache* lutCache) {
   const EntityHandle handle = ref.reference.handle;
   if (!handle) {
     return std::nullopt;
@@ -752,7 +876,7 @@ std::optional<tiny_skia::Shader> instantiateGradientShader(
   if (const auto* linear = handle.try_get<components::ComputedLinearGradientComponent>()) {
     const Vector2d start = resolveGradientCoords(linear->x1, linear->y1, bounds, numbersArePercent);
     const Vector2d end = resolveGradientCoords(linear->x2, linear->y2, bounds, numbersArePercent);
-    const auto shader = tiny_skia::LinearGradient::create(
+    auto shader = tiny_skia::LinearGradient::create(
         toTinyPoint(start), toTinyPoint(end), std::move(stops),
         toTinySpreadMode(computedGradient->spreadMethod), shaderTransform);
     if (!shader.has_value()) {
@@ -760,7 +884,8 @@ std::optional<tiny_skia::Shader> instantiateGradientShader(
     }
 
     return std::visit(
-        [](auto&& value) -> tiny_skia::Shader {
+        [lutCache](auto&& value) -> tiny_skia::Shader {
+          attachGradientLut(lutCache, value);
           return tiny_skia::Shader(std::forward<decltype(value)>(value));
         },
         std::move(*shader));
@@ -784,7 +909,7 @@ std::optional<tiny_skia::Shader> instantiateGradientShader(
       return std::nullopt;
     }
 
-    const auto shader = tiny_skia::RadialGradient::create(
+    auto shader = tiny_skia::RadialGradient::create(
         toTinyPoint(focalCenter), NarrowToFloat(focalRadius), toTinyPoint(center),
         NarrowToFloat(radius), std::move(stops), toTinySpreadMode(computedGradient->spreadMethod),
         shaderTransform);
@@ -793,7 +918,8 @@ std::optional<tiny_skia::Shader> instantiateGradientShader(
     }
 
     return std::visit(
-        [](auto&& value) -> tiny_skia::Shader {
+        [lutCache](auto&& value) -> tiny_skia::Shader {
+          attachGradientLut(lutCache, value);
           return tiny_skia::Shader(std::forward<decltype(value)>(value));
         },
         std::move(*shader));
@@ -1091,6 +1217,11 @@ std::vector<std::uint8_t> PremultiplyRgba(std::span<const std::uint8_t> rgbaPixe
 #ifdef DONNER_FILTERS_ENABLED
 // Blur implementation moved to tiny_skia::filter::gaussianBlur (GaussianBlur.h).
 
+tiny_skia::filter::FilterPrecision toTinyFilterPrecision(FilterPrecision precision) {
+  return precision == FilterPrecision::Uint8 ? tiny_skia::filter::FilterPrecision::Uint8
+                                             : tiny_skia::filter::FilterPrecision::Float;
+}
+
 int BoundedFloorToInt(double value, int minimum, int maximum) {
   if (std::isnan(value)) {
     return 0;
@@ -1440,6 +1571,9 @@ void RendererTinySkia::draw(SVGDocument& document) {
     // document holding coverage nothing will ever replay.
     ClearRetainedSpans(document.registry());
   }
+  if (!retainedFilterOutputsEnabled_) {
+    ClearRetainedFilterOutputs(document.registry());
+  }
 
   RendererDriver driver(*this, verbose_);
   driver.draw(document);
@@ -1548,6 +1682,10 @@ void RendererTinySkia::beginFrame(const RenderViewport& viewport) {
 
   ++frameIndex_;
   retainedSpanStats_ = RetainedSpanStats();
+  retainedFilterOutputStats_ = RetainedFilterOutputStats();
+  maskCoverageCacheStats_ = MaskCoverageCacheStats();
+  maskCoverageCacheStats_.liveBytes = maskCoverageCache_.liveBytes();
+  gradientLutCache_.beginFrame();
   clipEpoch_ = 0;
   clipEpochStack_.clear();
   if (frame_.size() != previousFrameSize_) {
@@ -1940,17 +2078,17 @@ void RendererTinySkia::pushFilterLayer(const components::FilterGraph& filterGrap
 }
 
 #ifdef DONNER_FILTERS_ENABLED
-bool RendererTinySkia::compositeTransformedFilter(SurfaceFrame& frame) {
+std::optional<FilterLayerOutput> RendererTinySkia::filterInLocalRaster(SurfaceFrame& frame) {
   const std::optional<LocalFilterRasterGeometry> geometry =
       ComputeLocalFilterRasterGeometry(frame.filterGraph, frame.filterRegion,
                                        frame.deviceFromFilter, !frame.localRasterRequiredForBudget);
   if (!geometry.has_value()) {
-    return false;
+    return std::nullopt;
   }
 
   tiny_skia::Pixmap localPixmap = createTransparentPixmap(geometry->width, geometry->height);
   if (localPixmap.width() == 0 || localPixmap.height() == 0) {
-    return false;
+    return std::nullopt;
   }
   const Transform2d filterFromDevice = frame.deviceFromFilter.inverse();
   const Transform2d localFromDevice =
@@ -1970,22 +2108,18 @@ bool RendererTinySkia::compositeTransformedFilter(SurfaceFrame& frame) {
                                 Vector2d(geometry->blurPadding + frame.filterRegion->width(),
                                          geometry->blurPadding + frame.filterRegion->height()));
   ApplyFilterGraphToPixmap(localPixmap, frame.filterGraph, localFromFilter, localFilterRegion,
-                           false);
+                           false, nullptr, nullptr, nullptr,
+                           toTinyFilterPrecision(filterPrecision_));
   ClipFilterOutputToRegion(localPixmap, localFilterRegion, localFromFilter);
 
-  const Transform2d deviceFromLocal =
+  FilterLayerOutput output;
+  output.pixmap = std::move(localPixmap);
+  output.deviceFromPixmap =
       Transform2d::Scale(1.0 / geometry->scaleX, 1.0 / geometry->scaleY) *
       Transform2d::Translate(geometry->paddedRegion.topLeft.x, geometry->paddedRegion.topLeft.y) *
       frame.deviceFromFilter;
-  tiny_skia::PixmapPaint compositePaint =
-      makePixmapPaint(currentPixmap(), tiny_skia::FilterQuality::Bilinear);
-  compositePaint.opacity = 1.0f;
-  compositePaint.blendMode = tiny_skia::BlendMode::SourceOver;
-  const tiny_skia::Mask* mask = currentClipMask_.has_value() ? &*currentClipMask_ : nullptr;
-  auto pixmapView = currentPixmapView();
-  tiny_skia::Painter::drawPixmap(pixmapView, 0, 0, localPixmap.view(), compositePaint,
-                                 toTinyTransform(deviceFromLocal), mask);
-  return true;
+  output.resampled = true;
+  return output;
 }
 
 tiny_skia::Pixmap RendererTinySkia::extractFilterViewport(const SurfaceFrame& frame, int width,
@@ -2014,7 +2148,7 @@ tiny_skia::Pixmap RendererTinySkia::extractFilterViewport(const SurfaceFrame& fr
   return viewport;
 }
 
-void RendererTinySkia::compositeDeviceFilter(SurfaceFrame& frame) {
+FilterLayerOutput RendererTinySkia::filterInDeviceSpace(SurfaceFrame& frame) {
   const bool hasOffset = frame.filterBufferOffsetX != 0 || frame.filterBufferOffsetY != 0;
   const Transform2d bufferDeviceFromFilter =
       hasOffset ? frame.deviceFromFilter *
@@ -2023,24 +2157,56 @@ void RendererTinySkia::compositeDeviceFilter(SurfaceFrame& frame) {
   ApplyFilterGraphToPixmap(
       frame.pixmap, frame.filterGraph, bufferDeviceFromFilter, frame.filterRegion, true,
       frame.fillPaintPixmap.has_value() ? &*frame.fillPaintPixmap : nullptr,
-      frame.strokePaintPixmap.has_value() ? &*frame.strokePaintPixmap : nullptr);
+      frame.strokePaintPixmap.has_value() ? &*frame.strokePaintPixmap : nullptr, nullptr,
+      toTinyFilterPrecision(filterPrecision_));
   ClipFilterOutputToRegion(frame.pixmap, frame.filterRegion, bufferDeviceFromFilter);
 
-  tiny_skia::PixmapPaint paint =
-      makePixmapPaint(currentPixmap(), tiny_skia::FilterQuality::Nearest);
+  FilterLayerOutput output;
+  if (hasOffset) {
+    const tiny_skia::Pixmap& target = currentPixmap();
+    output.pixmap = extractFilterViewport(frame, static_cast<int>(target.width()),
+                                          static_cast<int>(target.height()));
+  } else {
+    output.pixmap = std::move(frame.pixmap);
+  }
+  return output;
+}
+
+void RendererTinySkia::compositeFilterOutput(const FilterLayerOutput& output) {
+  tiny_skia::PixmapPaint paint = makePixmapPaint(
+      currentPixmap(),
+      output.resampled ? tiny_skia::FilterQuality::Bilinear : tiny_skia::FilterQuality::Nearest);
   paint.opacity = 1.0f;
   paint.blendMode = tiny_skia::BlendMode::SourceOver;
   const tiny_skia::Mask* mask = currentClipMask_.has_value() ? &*currentClipMask_ : nullptr;
   auto pixmapView = currentPixmapView();
-  if (hasOffset) {
-    tiny_skia::Pixmap viewport = extractFilterViewport(frame, static_cast<int>(pixmapView.width()),
-                                                       static_cast<int>(pixmapView.height()));
-    tiny_skia::Painter::drawPixmap(pixmapView, 0, 0, viewport.view(), paint,
-                                   tiny_skia::Transform::identity(), mask);
+  tiny_skia::Painter::drawPixmap(pixmapView, 0, 0, output.pixmap.view(), paint,
+                                 toTinyTransform(output.deviceFromPixmap), mask);
+}
+
+void RendererTinySkia::retainFilterOutput(const SurfaceFrame& frame, FilterLayerOutput&& output) {
+  Registry& registry = *frame.retainedFilterEntity.registry();
+  auto* entry = frame.retainedFilterEntity.try_get<RetainedFilterOutputComponent>();
+  auto* state = registry.ctx().find<RetainedFilterOutputDocumentState>();
+  if (entry == nullptr || state == nullptr) {
+    compositeFilterOutput(output);
     return;
   }
-  tiny_skia::Painter::drawPixmap(pixmapView, 0, 0, frame.pixmap.view(), paint,
-                                 tiny_skia::Transform::identity(), mask);
+
+  entry->key = frame.retainedFilterKey;
+  entry->output = std::move(output);
+  state->liveBytes -= std::min(state->liveBytes, entry->chargedBytes);
+  entry->chargedBytes = RetainedFilterOutputBytes(*entry);
+  state->liveBytes += entry->chargedBytes;
+  ++retainedFilterOutputStats_.renderedLayers;
+
+  compositeFilterOutput(*entry->output);
+
+  // Evict after compositing: the entry just written may be the one that goes.
+  EvictRetainedFilterOutputsToBudget(registry, filterFrameToken_);
+  retainedFilterOutputStats_.liveBytes = state->liveBytes;
+  retainedFilterOutputStats_.evictions = state->evictions;
+  retainedFilterOutputStats_.documentDisabled = state->disabled;
 }
 #endif  // DONNER_FILTERS_ENABLED
 
@@ -2073,21 +2239,150 @@ void RendererTinySkia::popFilterLayer() {
   clipEpoch_ = frame.savedClipEpoch;
   clipEpochStack_ = std::move(frame.savedClipEpochStack);
 
-  if (compositeTransformedFilter(frame)) {
-    filterExecutionBudget_->release(frame.filterReservation);
-    return;
+  std::optional<FilterLayerOutput> output = filterInLocalRaster(frame);
+  if (!output.has_value()) {
+    if (frame.localRasterRequiredForBudget) {
+      filterExecutionBudget_->reject();
+      filterExecutionBudget_->release(frame.filterReservation);
+      return;
+    }
+    output = filterInDeviceSpace(frame);
   }
-  if (frame.localRasterRequiredForBudget) {
-    filterExecutionBudget_->reject();
-    filterExecutionBudget_->release(frame.filterReservation);
+  filterExecutionBudget_->release(frame.filterReservation);
+
+  if (frame.retainedFilterEntity) {
+    retainFilterOutput(frame, std::move(*output));
     return;
   }
-  compositeDeviceFilter(frame);
-  filterExecutionBudget_->release(frame.filterReservation);
+  compositeFilterOutput(*output);
+#endif  // DONNER_FILTERS_ENABLED
+}
+
+bool RendererTinySkia::pushRetainedFilterLayer(const components::FilterGraph& filterGraph,
+                                               const std::optional<Box2d>& filterRegion,
+                                               const FilterLayerIdentity& identity) {
+#ifdef DONNER_FILTERS_ENABLED
+  if (!retainedFilterOutputsEnabled_) {
+    pushFilterLayer(filterGraph, filterRegion);
+    return false;
+  }
+
+  const auto bypass = [&]() {
+    ++retainedFilterOutputStats_.bypassedLayers;
+    pushFilterLayer(filterGraph, filterRegion);
+    return false;
+  };
+
+  // Only a layer composited straight onto the frame is retained: any other surface is rebuilt
+  // with whatever owns it, and a layer inside a rejected one draws nothing.
+  if (!surfaceStack_.empty() || rejectedFilterDepth_ != 0 || !identity.entity) {
+    return bypass();
+  }
+
+  Registry& registry = *identity.entity.registry();
+  RetainedFilterOutputDocumentState& state =
+      RetainedFilterOutputStateFor(registry, retainedFilterOutputBudgetBytes_);
+  retainedFilterOutputStats_.documentDisabled = state.disabled;
+  retainedFilterOutputStats_.evictions = state.evictions;
+  if (state.disabled) {
+    return bypass();
+  }
+
+  if (filterFrameToken_ == 0 || filterFrameTokenIndex_ != frameIndex_) {
+    filterFrameToken_ = ++state.frameCounter;
+    filterFrameTokenIndex_ = frameIndex_;
+  }
+
+  RetainedFilterOutputComponent& entry =
+      identity.entity.get_or_emplace<RetainedFilterOutputComponent>();
+  if (entry.pushFrame != filterFrameToken_) {
+    entry.pushFrame = filterFrameToken_;
+    entry.pushesThisFrame = 0;
+  }
+
+  ++entry.pushesThisFrame;
+  if (entry.pushesThisFrame > 1 && !entry.ambiguous) {
+    entry.ambiguous = true;
+    state.liveBytes -= std::min(state.liveBytes, entry.chargedBytes);
+    entry.chargedBytes = 0;
+    entry.output.reset();
+  }
+
+  if (entry.ambiguous) {
+    return bypass();
+  }
+
+  entry.lastUsedFrame = filterFrameToken_;
+
+  RetainedFilterOutputKey key;
+  key.documentRevision = identity.documentRevision;
+  key.instancesRevision = identity.instancesRevision;
+  key.deviceFromFilter = deviceFromLocalTransform_;
+  key.filterRegion = filterRegion;
+  key.surfaceSize = currentPixmap().size();
+  key.antialias = antialias_;
+  key.precision = filterPrecision_;
+
+  if (entry.output.has_value() && entry.key == key) {
+    ++retainedFilterOutputStats_.reusedLayers;
+    retainedFilterOutputStats_.liveBytes = state.liveBytes;
+    // The clip in effect now is the one popFilterLayer would restore, so compositing here is
+    // what a pop would do. The marker makes the matching pop a no-op.
+    compositeFilterOutput(*entry.output);
+    filterLayerStack_.push_back(false);
+    return true;
+  }
+
+  if (entry.output.has_value()) {
+    ++retainedFilterOutputStats_.invalidatedLayers;
+    state.liveBytes -= std::min(state.liveBytes, entry.chargedBytes);
+    entry.chargedBytes = 0;
+    entry.output.reset();
+  }
+
+  pushFilterLayer(filterGraph, filterRegion);
+  if (surfaceStack_.empty() || surfaceStack_.back().kind != SurfaceKind::FilterLayer) {
+    // Rejected by a budget; the layer draws nothing, so there is nothing to retain.
+    ++retainedFilterOutputStats_.bypassedLayers;
+    return false;
+  }
+
+  SurfaceFrame& frame = surfaceStack_.back();
+  frame.retainedFilterEntity = identity.entity;
+  frame.retainedFilterKey = key;
+  return false;
+#else
+  pushFilterLayer(filterGraph, filterRegion);
+  (void)identity;
+  return false;
 #endif  // DONNER_FILTERS_ENABLED
 }
 
+void RendererTinySkia::setMaskCoverageCacheEnabled(bool enabled) {
+  maskCoverageCacheEnabled_ = enabled;
+  if (!enabled) {
+    maskCoverageCache_.clear();
+  }
+}
+
+void RendererTinySkia::setGradientLutCacheEnabled(bool enabled) {
+  gradientLutCacheEnabled_ = enabled;
+  if (!enabled) {
+    gradientLutCache_.clear();
+  }
+}
+
 void RendererTinySkia::pushMask(const std::optional<Box2d>& maskBounds, MaskType maskType) {
+  (void)pushMaskFrame(maskBounds, maskType, nullptr);
+}
+
+bool RendererTinySkia::pushCachedMask(const std::optional<Box2d>& maskBounds, MaskType maskType,
+                                      const MaskIdentity& identity) {
+  return pushMaskFrame(maskBounds, maskType, maskCoverageCacheEnabled_ ? &identity : nullptr);
+}
+
+bool RendererTinySkia::pushMaskFrame(const std::optional<Box2d>& maskBounds, MaskType maskType,
+                                     const MaskIdentity* identity) {
   SurfaceFrame frame;
   frame.kind = SurfaceKind::MaskCapture;
   frame.maskBounds = maskBounds;
@@ -2096,7 +2391,7 @@ void RendererTinySkia::pushMask(const std::optional<Box2d>& maskBounds, MaskType
   if (rejectedFilterDepth_ != 0) {
     frame.allocationRejected = true;
     surfaceStack_.push_back(std::move(frame));
-    return;
+    return false;
   }
   const int width = static_cast<int>(currentPixmap().width());
   const int height = static_cast<int>(currentPixmap().height());
@@ -2105,13 +2400,84 @@ void RendererTinySkia::pushMask(const std::optional<Box2d>& maskBounds, MaskType
     surfaceCount += surfaceStack_.back().fillPaintPixmap.has_value() ? 1u : 0u;
     surfaceCount += surfaceStack_.back().strokePaintPixmap.has_value() ? 1u : 0u;
   }
+  // A cached mask reserves what a rendered one would, so whether the budget admits a mask never
+  // depends on whether its coverage happened to be cached.
   if (!surfaceBudget_->reserve(width, height, surfaceCount)) {
     frame.allocationRejected = true;
     surfaceStack_.push_back(std::move(frame));
-    return;
+    return false;
   }
+
+  if (identity != nullptr) {
+    if (!identity->entity || identity->instancesRevision == 0 || width <= 0 || height <= 0 ||
+        !clipLeavesMaskCoverageUnchanged(maskBounds, frame.maskBoundsTransform)) {
+      ++maskCoverageCacheStats_.bypassedMasks;
+    } else {
+      MaskCoverageKey key;
+      key.identity = *identity;
+      key.maskBounds = maskBounds;
+      key.deviceFromMaskBounds = frame.maskBoundsTransform;
+      key.maskType = maskType;
+      key.surfaceSize = currentPixmap().size();
+      key.antialias = antialias_;
+      key.filterPrecision = filterPrecision_;
+      if (maskCoverageCache_.findMask(key, frame.maskAlpha)) {
+        ++maskCoverageCacheStats_.maskHits;
+        frame.maskCoverageReused = true;
+        surfaceStack_.push_back(std::move(frame));
+        return true;
+      }
+      ++maskCoverageCacheStats_.maskMisses;
+      frame.maskCoverageKey = std::move(key);
+    }
+  }
+
   frame.pixmap = createTransparentPixmap(width, height);
   surfaceStack_.push_back(std::move(frame));
+  return false;
+}
+
+bool RendererTinySkia::clipLeavesMaskCoverageUnchanged(
+    const std::optional<Box2d>& maskBounds, const Transform2d& deviceFromMaskBounds) const {
+  if (clipMaskAllocationRejected_) {
+    return false;
+  }
+  if (!currentClipMask_.has_value()) {
+    return true;
+  }
+
+  // Mask content is drawn under the clip in effect, but coverage outside the mask region is
+  // zeroed afterwards. A clip that is fully opaque over the region, padded by a pixel for
+  // anti-aliasing, therefore left the coverage exactly as an unclipped draw would.
+  const int width = static_cast<int>(currentClipMask_->width());
+  const int height = static_cast<int>(currentClipMask_->height());
+  int x0 = 0;
+  int y0 = 0;
+  int x1 = width;
+  int y1 = height;
+  if (maskBounds.has_value()) {
+    const Box2d deviceBounds = deviceFromMaskBounds.transformBox(*maskBounds);
+    if (!std::isfinite(deviceBounds.topLeft.x) || !std::isfinite(deviceBounds.topLeft.y) ||
+        !std::isfinite(deviceBounds.bottomRight.x) || !std::isfinite(deviceBounds.bottomRight.y)) {
+      return false;
+    }
+    const auto clampTo = [](double value, int limit) {
+      return static_cast<int>(std::clamp(value, 0.0, static_cast<double>(limit)));
+    };
+    x0 = clampTo(std::floor(deviceBounds.topLeft.x) - 1.0, width);
+    y0 = clampTo(std::floor(deviceBounds.topLeft.y) - 1.0, height);
+    x1 = clampTo(std::ceil(deviceBounds.bottomRight.x) + 1.0, width);
+    y1 = clampTo(std::ceil(deviceBounds.bottomRight.y) + 1.0, height);
+  }
+
+  const std::span<const std::uint8_t> clip = currentClipMask_->data();
+  for (int y = y0; y < y1; ++y) {
+    const std::uint8_t* row = clip.data() + static_cast<std::size_t>(y) * width;
+    if (!std::all_of(row + x0, row + x1, [](std::uint8_t value) { return value == 255; })) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void RendererTinySkia::transitionMaskToContent() {
@@ -2124,23 +2490,40 @@ void RendererTinySkia::transitionMaskToContent() {
     frame.kind = SurfaceKind::MaskContent;
     return;
   }
-  const tiny_skia::MaskType tinyMaskType = frame.maskType == MaskType::Alpha
-                                               ? tiny_skia::MaskType::Alpha
-                                               : tiny_skia::MaskType::Luminance;
-  frame.maskAlpha = tiny_skia::Mask::fromPixmap(frame.pixmap.view(), tinyMaskType);
+  int width = static_cast<int>(frame.pixmap.width());
+  int height = static_cast<int>(frame.pixmap.height());
+  if (frame.maskCoverageReused) {
+    width = static_cast<int>(frame.maskAlpha->width());
+    height = static_cast<int>(frame.maskAlpha->height());
+  } else {
+    const tiny_skia::MaskType tinyMaskType = frame.maskType == MaskType::Alpha
+                                                 ? tiny_skia::MaskType::Alpha
+                                                 : tiny_skia::MaskType::Luminance;
+    frame.maskAlpha = tiny_skia::Mask::fromPixmap(frame.pixmap.view(), tinyMaskType);
+
+    bool boundsApplied = true;
+    if (frame.maskAlpha.has_value() && frame.maskBounds.has_value()) {
+      std::optional<tiny_skia::Mask> boundsMask =
+          createMaskForSize(frame.pixmap.width(), frame.pixmap.height());
+      boundsApplied = boundsMask.has_value();
+      if (boundsMask.has_value()) {
+        drawRectIntoMask(*boundsMask, *frame.maskBounds, frame.maskBoundsTransform, antialias_);
+        intersectMaskInPlace(*frame.maskAlpha, *boundsMask);
+      }
+    }
 
-  if (frame.maskAlpha.has_value() && frame.maskBounds.has_value()) {
-    std::optional<tiny_skia::Mask> boundsMask =
-        createMaskForSize(frame.pixmap.width(), frame.pixmap.height());
-    if (boundsMask.has_value()) {
-      drawRectIntoMask(*boundsMask, *frame.maskBounds, frame.maskBoundsTransform, antialias_);
-      intersectMaskInPlace(*frame.maskAlpha, *boundsMask);
+    // A budget rejection anywhere in the mask content may have left parts of it undrawn, which
+    // is fine for this frame but must not be handed to later users.
+    if (frame.maskCoverageKey.has_value() && frame.maskAlpha.has_value() && boundsApplied &&
+        !surfaceBudget_->rejected() && !clipMaskAllocationRejected_) {
+      maskCoverageCache_.storeMask(std::move(*frame.maskCoverageKey), *frame.maskAlpha);
+      maskCoverageCacheStats_.liveBytes = maskCoverageCache_.liveBytes();
+      maskCoverageCacheStats_.evictions = maskCoverageCache_.evictions();
     }
+    frame.maskCoverageKey.reset();
   }
 
   frame.kind = SurfaceKind::MaskContent;
-  const int width = static_cast<int>(frame.pixmap.width());
-  const int height = static_cast<int>(frame.pixmap.height());
   frame.pixmap = createTransparentPixmap(width, height);
   frame.fillPaintPixmap.reset();
   frame.strokePaintPixmap.reset();
@@ -2623,7 +3006,8 @@ void RendererTinySkia::drawEllipse(const Box2d& bounds, const StrokeParams& stro
 }
 
 void RendererTinySkia::drawImagePixmap(const tiny_skia::PixmapView& source, int sourceWidth,
-                                       int sourceHeight, const ImageParams& params) {
+                                       int sourceHeight, const ImageParams& params,
+                                       ImageMipChain* mipChain) {
   const std::optional<tiny_skia::Rect> targetRect = toTinyRect(params.targetRect);
   if (!targetRect.has_value() || sourceWidth <= 0 || sourceHeight <= 0) {
     return;
@@ -2634,6 +3018,27 @@ void RendererTinySkia::drawImagePixmap(const tiny_skia::PixmapView& source, int
   int sampledWidth = sourceWidth;
   int sampledHeight = sourceHeight;
   std::optional<tiny_skia::Pixmap> pixelatedIntermediate;
+  if (mipChain != nullptr) {
+    // A smooth draw minified 2x or more samples a prefiltered level: bilinear filtering of the
+    // full-resolution source would both alias and read far more pixels than it writes. The level
+    // is stretched over the same target rect, so only the sampled extent changes.
+    const Transform2d destFromSource = MakeDestFromSourceTransform(
+        params.targetRect, sourceWidth, sourceHeight, deviceFromLocalTransform_);
+    if (const int levelIndex =
+            SelectImageMipLevel(destFromSource, sourceWidth, sourceHeight, imageRendering);
+        levelIndex > 0) {
+      const ImageMipChain::Level& level =
+          mipChain->level(source.data(), sourceWidth, sourceHeight, levelIndex);
+      if (const std::optional<tiny_skia::PixmapView> levelView = tiny_skia::PixmapView::fromBytes(
+              level.pixels, static_cast<std::uint32_t>(level.width),
+              static_cast<std::uint32_t>(level.height))) {
+        sampledSource = *levelView;
+        sampledWidth = level.width;
+        sampledHeight = level.height;
+      }
+    }
+  }
+
   if (imageRendering == ImageRendering::Pixelated) {
     const PixelatedSamplingPlan plan = MakePixelatedSamplingPlan(
         params.targetRect, sourceWidth, sourceHeight, deviceFromLocalTransform_);
@@ -2673,10 +3078,11 @@ void RendererTinySkia::drawImage(const ImageResource& image, const ImageParams&
   if (rejectedFilterDepth_ != 0) {
     return;
   }
-  if (!HasExactRgbaPayload(image.data, image.width, image.height)) {
+  if (!HasExactRgbaPayload(image.pixels(), image.width, image.height)) {
     return;
   }
-  if (!drawBudget_->reserve({.drawCalls = 1, .imageDraws = 1, .imageBytes = image.data.size()})) {
+  if (!drawBudget_->reserve(
+          {.drawCalls = 1, .imageDraws = 1, .imageBytes = image.pixels().size()})) {
     return;
   }
 
@@ -2685,16 +3091,16 @@ void RendererTinySkia::drawImage(const ImageResource& image, const ImageParams&
   // loaded image and change only when that does, so the premultiplied form is cached on the
   // source entity and borrowed through a view; the previous code premultiplied into a fresh
   // buffer and wrapped it in a throwaway `Pixmap` on every draw of every frame.
-  const std::span<const std::uint8_t> premultiplied = ResolvePremultipliedImage(
+  const ResolvedPremultipliedImage premultiplied = ResolvePremultipliedImage(
       image, params.sourceEntity, pixelScratch_, cacheWiringCheckedRegistry_, frameCounters_);
-  const std::optional<tiny_skia::PixmapView> sourceView =
-      tiny_skia::PixmapView::fromBytes(premultiplied, static_cast<std::uint32_t>(image.width),
-                                       static_cast<std::uint32_t>(image.height));
+  const std::optional<tiny_skia::PixmapView> sourceView = tiny_skia::PixmapView::fromBytes(
+      premultiplied.pixels, static_cast<std::uint32_t>(image.width),
+      static_cast<std::uint32_t>(image.height));
   if (!sourceView.has_value()) {
     return;
   }
 
-  drawImagePixmap(*sourceView, image.width, image.height, params);
+  drawImagePixmap(*sourceView, image.width, image.height, params, premultiplied.mipChain);
 }
 
 void RendererTinySkia::drawBitmap(const RendererBitmap& bitmap, const ImageParams& params) {
@@ -2924,7 +3330,8 @@ void RendererTinySkia::drawText(Registry& registry, const components::ComputedTe
         // for objectBoundingBox mapping, per SVG spec ("tspan doesn't have a bbox").
         const float combinedOpacity = spanFillOpacity * static_cast<float>(span.opacity);
         if (auto shader = instantiateGradientShader(*drawBudget_, *ref, textBounds, paint_.viewBox,
-                                                    spanCurrentColor, combinedOpacity)) {
+                                                    spanCurrentColor, combinedOpacity,
+                                                    activeGradientLutCache())) {
           tiny_skia::Paint paint = makeBasePaint(antialias_);
           paint.shader = std::move(*shader);
           spanFillPaint = paint;
@@ -2961,7 +3368,8 @@ void RendererTinySkia::drawText(Registry& registry, const components::ComputedTe
           const float combinedOpacity = spanStrokeOpacity * static_cast<float>(span.opacity);
           if (auto shader =
                   instantiateGradientShader(*drawBudget_, *ref, textBounds, paint_.viewBox,
-                                            spanCurrentColor, combinedOpacity)) {
+                                            spanCurrentColor, combinedOpacity,
+                                            activeGradientLutCache())) {
             tiny_skia::Paint paint = makeBasePaint(antialias_);
             paint.shader = std::move(*shader);
             spanStrokePaint = paint;
@@ -3151,7 +3559,8 @@ void RendererTinySkia::drawText(Registry& registry, const components::ComputedTe
         const float combinedOpacity =
             NarrowToFloat(span.decorationFillOpacity) * static_cast<float>(span.opacity);
         if (auto shader = instantiateGradientShader(*drawBudget_, *ref, textBounds, paint_.viewBox,
-                                                    spanCurrentColor, combinedOpacity)) {
+                                                    spanCurrentColor, combinedOpacity,
+                                                    activeGradientLutCache())) {
           tiny_skia::Paint paint = makeBasePaint(antialias_);
           paint.shader = std::move(*shader);
           decoFillPaint = paint;
@@ -3174,7 +3583,8 @@ void RendererTinySkia::drawText(Registry& registry, const components::ComputedTe
         const float combinedOpacity =
             NarrowToFloat(span.decorationStrokeOpacity) * static_cast<float>(span.opacity);
         if (auto shader = instantiateGradientShader(*drawBudget_, *ref, textBounds, paint_.viewBox,
-                                                    spanCurrentColor, combinedOpacity)) {
+                                                    spanCurrentColor, combinedOpacity,
+                                                    activeGradientLutCache())) {
           tiny_skia::Paint paint = makeBasePaint(antialias_);
           paint.shader = std::move(*shader);
           decoStrokePaint = paint;
@@ -3509,6 +3919,33 @@ std::optional<tiny_skia::Mask> RendererTinySkia::buildClipMask(const ResolvedCli
 
   const int maskWidth = static_cast<int>(currentPixmap().width());
   const int maskHeight = static_cast<int>(currentPixmap().height());
+
+  // Only clips with paths are cached: a lone rectangle is cheaper to draw than to look up.
+  std::optional<ClipCoverageKey> cacheKey;
+  if (maskCoverageCacheEnabled_ && !clip.clipPaths.empty() && maskWidth > 0 && maskHeight > 0) {
+    cacheKey.emplace();
+    cacheKey->clipRect = clip.clipRect;
+    cacheKey->clipPaths = clip.clipPaths;
+    cacheKey->clipPathUnitsTransform = clip.clipPathUnitsTransform;
+    cacheKey->deviceFromLocal = deviceFromLocalTransform_;
+    cacheKey->surfaceSize = currentPixmap().size();
+    cacheKey->antialias = antialias_;
+
+    std::optional<tiny_skia::Mask> cached;
+    if (maskCoverageCache_.findClip(*cacheKey, cached)) {
+      ++maskCoverageCacheStats_.clipHits;
+      if (verbose_) {
+        std::cout << "\n  (cached)\n";
+      }
+      if (!surfaceBudget_->reserve(maskWidth, maskHeight, /*surfaceCount=*/1,
+                                   /*bytesPerPixel=*/1)) {
+        return std::nullopt;
+      }
+      return cached;
+    }
+    ++maskCoverageCacheStats_.clipMisses;
+  }
+
   ClipMaskBuilder builder(*surfaceBudget_, maskWidth, maskHeight, clip.clipPathUnitsTransform,
                           deviceFromLocalTransform_, antialias_, verbose_);
   std::optional<tiny_skia::Mask> rectMask = builder.buildRect(clip.clipRect);
@@ -3523,6 +3960,11 @@ std::optional<tiny_skia::Mask> RendererTinySkia::buildClipMask(const ResolvedCli
   if (builder.allocationFailed()) {
     return std::nullopt;
   }
+  if (cacheKey.has_value() && result.has_value()) {
+    maskCoverageCache_.storeClip(std::move(*cacheKey), *result);
+    maskCoverageCacheStats_.liveBytes = maskCoverageCache_.liveBytes();
+    maskCoverageCacheStats_.evictions = maskCoverageCache_.evictions();
+  }
   return result;
 }
 
@@ -3551,7 +3993,8 @@ std::optional<tiny_skia::Paint> RendererTinySkia::makeFillPaint(const Box2d& bou
 
   if (const auto* ref = std::get_if<components::PaintResolvedReference>(&paint_.fill)) {
     if (std::optional<tiny_skia::Shader> shader = instantiateGradientShader(
-            *drawBudget_, *ref, bounds, paint_.viewBox, currentColor, fillOpacity)) {
+            *drawBudget_, *ref, bounds, paint_.viewBox, currentColor, fillOpacity,
+            activeGradientLutCache())) {
       paint.shader = std::move(*shader);
       return paint;
     }
@@ -3591,7 +4034,8 @@ std::optional<tiny_skia::Paint> RendererTinySkia::makeStrokePaint(const Box2d& b
 
   if (const auto* ref = std::get_if<components::PaintResolvedReference>(&paint_.stroke)) {
     if (std::optional<tiny_skia::Shader> shader = instantiateGradientShader(
-            *drawBudget_, *ref, bounds, paint_.viewBox, currentColor, strokeOpacity)) {
+            *drawBudget_, *ref, bounds, paint_.viewBox, currentColor, strokeOpacity,
+            activeGradientLutCache())) {
       paint.shader = std::move(*shader);
       return paint;
     }
@@ -12,6 +12,9 @@
 #include "donner/base/EcsRegistry_fwd.h"
 #include "donner/svg/SVGDocument.h"
 #include "donner/svg/renderer/RendererInterface.h"
+#include "donner/svg/renderer/GradientLutCache.h"
+#include "donner/svg/renderer/MaskCoverageCache.h"
+#include "donner/svg/renderer/RetainedFilterOutput.h"
 #include "donner/svg/renderer/RetainedSpans.h"
 #include "tiny_skia/Mask.h"
 #include "tiny_skia/Paint.h"
@@ -21,6 +24,7 @@ namespace donner::svg {
 
 class FontManager;
 class FontHandle;
+class ImageMipChain;
 struct TextRun;
 
 /**
@@ -46,6 +50,15 @@ struct RendererTinySkiaFrameCounters {
   /// @see pathConversions
   uint64_t imagePremultiplies = 0;
 
+  /// `<image>` draws that sampled an already-premultiplied payload shared through the
+  /// process-wide \ref DecodedImageCache, possibly derived while drawing another document.
+  uint64_t sharedImageHits = 0;
+
+  /// Shape draws whose per-entity path cache missed but that reused a conversion already derived
+  /// from an identical outline, by another entity or another document. Not counted in
+  /// \ref pathConversions.
+  uint64_t sharedPathHits = 0;
+
   /// Vector-outline or bitmap materializations attempted for text glyphs in this frame.
   uint64_t textGlyphMaterializations = 0;
 };
@@ -144,6 +157,19 @@ public:
   void pushFilterLayer(const components::FilterGraph& filterGraph,
                        const std::optional<Box2d>& filterRegion) override;
 
+  /**
+   * Pushes a filter layer, compositing the output retained for the same content instead when
+   * retained filter outputs are enabled and one matches. @see setRetainedFilterOutputsEnabled
+   *
+   * @param filterGraph The filter graph to apply when the layer is popped.
+   * @param filterRegion Optional filter region bounds in user space.
+   * @param identity Identity of the content drawn into the layer.
+   * @return True if a retained output was composited and the content must not be drawn.
+   */
+  bool pushRetainedFilterLayer(const components::FilterGraph& filterGraph,
+                               const std::optional<Box2d>& filterRegion,
+                               const FilterLayerIdentity& identity) override;
+
   /// Pops the most recent filter layer.
   void popFilterLayer() override;
 
@@ -158,6 +184,18 @@ public:
   }
   void pushMask(const std::optional<Box2d>& maskBounds, MaskType maskType) override;
 
+  /**
+   * Begins mask rendering, copying the coverage cached for the same mask content instead when the
+   * mask coverage cache is enabled and holds it. @see setMaskCoverageCacheEnabled
+   *
+   * @param maskBounds Optional mask bounds clip.
+   * @param maskType Whether mask coverage comes from luminance or alpha.
+   * @param identity Identity of the mask content.
+   * @return True if cached coverage was used and the mask content must not be drawn.
+   */
+  bool pushCachedMask(const std::optional<Box2d>& maskBounds, MaskType maskType,
+                      const MaskIdentity& identity) override;
+
   /// Switches from mask rendering to masked content rendering.
   void transitionMaskToContent() override;
 
@@ -276,6 +314,21 @@ public:
   /// Returns whether anti-aliasing is enabled.
   [[nodiscard]] bool antialias() const { return antialias_; }
 
+  /**
+   * Sets the storage filter graphs keep their intermediate results in.
+   *
+   * \ref FilterPrecision::Uint8 roughly halves the memory traffic of the common primitives at
+   * the cost of a few levels of rounding error per channel, more in `linearRGB`. Graphs the
+   * reduced-precision executor does not cover run at float regardless. Defaults to
+   * \ref FilterPrecision::Float, which keeps rendering conformant.
+   *
+   * @param precision Requested filter precision.
+   */
+  void setFilterPrecision(FilterPrecision precision) { filterPrecision_ = precision; }
+
+  /// Returns the requested filter precision.
+  [[nodiscard]] FilterPrecision filterPrecision() const { return filterPrecision_; }
+
   /**
    * Enables or disables retained rasterization.
    *
@@ -308,6 +361,102 @@ public:
   /// Returns what retained rasterization did during the most recent frame.
   [[nodiscard]] const RetainedSpanStats& retainedSpanStats() const { return retainedSpanStats_; }
 
+  /**
+   * Enables or disables retained filter outputs.
+   *
+   * When enabled, a filter layer drawn straight onto the frame keeps its filtered pixels, and a
+   * later frame that pushes the same layer with unchanged content, transform, and surface
+   * composites them instead of rendering the subtree and running the filter graph again. Output
+   * is byte-identical either way; the cost is the memory the outputs occupy, bounded by
+   * \ref setRetainedFilterOutputBudgetBytes.
+   *
+   * Off by default, for the same reason as \ref setRetainedSpansEnabled.
+   *
+   * @param enabled Whether to retain and reuse filter layer outputs.
+   */
+  void setRetainedFilterOutputsEnabled(bool enabled) { retainedFilterOutputsEnabled_ = enabled; }
+
+  /// Returns whether retained filter outputs are enabled.
+  [[nodiscard]] bool retainedFilterOutputsEnabled() const { return retainedFilterOutputsEnabled_; }
+
+  /**
+   * Sets the per-document ceiling on retained filter outputs.
+   *
+   * @param bytes Ceiling in bytes. @see RetainedFilterOutputDocumentState.
+   */
+  void setRetainedFilterOutputBudgetBytes(std::size_t bytes) {
+    retainedFilterOutputBudgetBytes_ = bytes;
+  }
+
+  /// Returns what retained filter outputs did during the most recent frame.
+  [[nodiscard]] const RetainedFilterOutputStats& retainedFilterOutputStats() const {
+    return retainedFilterOutputStats_;
+  }
+
+  /**
+   * Enables or disables the mask coverage cache.
+   *
+   * When enabled, the coverage of each rendered `<mask>` and each clip built from clip paths is
+   * kept, and a later user on the same or a later frame whose mask content, clip geometry,
+   * transform, and surface match copies it instead of rendering the mask content or
+   * scan-converting the clip paths again. Output is byte-identical either way; the cost is the
+   * memory the coverage occupies, bounded by \ref setMaskCoverageCacheBudgetBytes.
+   *
+   * Off by default, for the same reason as \ref setRetainedSpansEnabled.
+   *
+   * @param enabled Whether to cache and reuse mask and clip coverage.
+   */
+  void setMaskCoverageCacheEnabled(bool enabled);
+
+  /// Returns whether the mask coverage cache is enabled.
+  [[nodiscard]] bool maskCoverageCacheEnabled() const { return maskCoverageCacheEnabled_; }
+
+  /**
+   * Sets the ceiling on cached mask and clip coverage.
+   *
+   * @param bytes Ceiling in bytes. @see MaskCoverageCache.
+   */
+  void setMaskCoverageCacheBudgetBytes(std::size_t bytes) {
+    maskCoverageCache_.setBudgetBytes(bytes);
+  }
+
+  /// Returns what the mask coverage cache did during the most recent frame.
+  [[nodiscard]] const MaskCoverageCacheStats& maskCoverageCacheStats() const {
+    return maskCoverageCacheStats_;
+  }
+
+  /**
+   * Enables or disables the gradient color table cache.
+   *
+   * When enabled, each gradient with more than two stops is drawn through a color table sampled
+   * once from its stops and shared by every later draw, on the same or a later frame, whose
+   * stops match. Per-pixel evaluation becomes one lookup instead of a search over the stops.
+   * Output differs from the uncached path by at most two levels per channel, since colors come
+   * from the nearest of \ref tiny_skia::pipeline::kGradientLutSize samples.
+   *
+   * Off by default, so output stays identical to the reference renderer unless asked for.
+   *
+   * @param enabled Whether to draw multi-stop gradients through cached color tables.
+   */
+  void setGradientLutCacheEnabled(bool enabled);
+
+  /// Returns whether the gradient color table cache is enabled.
+  [[nodiscard]] bool gradientLutCacheEnabled() const { return gradientLutCacheEnabled_; }
+
+  /**
+   * Sets the ceiling on cached gradient color tables.
+   *
+   * @param bytes Ceiling in bytes. @see GradientLutCache.
+   */
+  void setGradientLutCacheBudgetBytes(std::size_t bytes) {
+    gradientLutCache_.setBudgetBytes(bytes);
+  }
+
+  /// Returns what the gradient color table cache did during the most recent frame.
+  [[nodiscard]] const GradientLutCacheStats& gradientLutCacheStats() const {
+    return gradientLutCache_.stats();
+  }
+
   /// Returns the rendered width in pixels.
   int width() const override;
 
@@ -356,6 +505,11 @@ private:
     Transform2d maskBoundsTransform;
     MaskType maskType = MaskType::Luminance;
     std::optional<tiny_skia::Mask> maskAlpha;
+    /// Set when `maskAlpha` was copied from the mask coverage cache, so there is no capture to
+    /// convert.
+    bool maskCoverageReused = false;
+    /// Key the captured mask coverage is cached under, or empty if it is not cached.
+    std::optional<MaskCoverageKey> maskCoverageKey;
     Transform2d targetFromPattern;
     Transform2d patternRasterFromTile;
     Transform2d savedTransform;
@@ -374,6 +528,11 @@ private:
     std::uint64_t savedClipEpoch = 0;
     /// @see savedClipEpoch
     std::vector<std::uint64_t> savedClipEpochStack;
+    /// Entity whose retained filter output this layer's result replaces, or null if the result
+    /// is not retained.
+    EntityHandle retainedFilterEntity;
+    /// Key the retained filter output is stored under. @see retainedFilterEntity
+    RetainedFilterOutputKey retainedFilterKey;
   };
 
   struct FilterAdmission {
@@ -427,12 +586,26 @@ private:
   void prepareRetainedClipEpochBudget(int pixelWidth, int pixelHeight);
   [[nodiscard]] bool applyPathLengthAdjustment(const Path& path, StrokeParams& stroke);
   [[nodiscard]] std::optional<tiny_skia::Mask> buildClipMask(const ResolvedClip& clip);
+  /// Begins a mask capture, looking its coverage up in the mask coverage cache first when
+  /// \p identity is non-null. Returns true if cached coverage was used.
+  bool pushMaskFrame(const std::optional<Box2d>& maskBounds, MaskType maskType,
+                     const MaskIdentity* identity);
+  /// Returns true if the clip in effect cannot change the coverage of a mask with the given
+  /// region, which is what lets that coverage be shared with users under a different clip.
+  [[nodiscard]] bool clipLeavesMaskCoverageUnchanged(const std::optional<Box2d>& maskBounds,
+                                                     const Transform2d& deviceFromMaskBounds) const;
+  /// Returns the gradient color table cache, or nullptr when it is disabled.
+  [[nodiscard]] GradientLutCache* activeGradientLutCache() {
+    return gradientLutCacheEnabled_ ? &gradientLutCache_ : nullptr;
+  }
   [[nodiscard]] std::optional<FilterAdmission> admitFilterLayer(
       const components::FilterGraph& filterGraph, const std::optional<Box2d>& filterRegion,
       const Transform2d& deviceFromFilter, int viewportWidth, int viewportHeight);
   bool initializeFilterSurface(SurfaceFrame& frame, const FilterAdmission& admission);
-  bool compositeTransformedFilter(SurfaceFrame& frame);
-  void compositeDeviceFilter(SurfaceFrame& frame);
+  [[nodiscard]] std::optional<FilterLayerOutput> filterInLocalRaster(SurfaceFrame& frame);
+  [[nodiscard]] FilterLayerOutput filterInDeviceSpace(SurfaceFrame& frame);
+  void compositeFilterOutput(const FilterLayerOutput& output);
+  void retainFilterOutput(const SurfaceFrame& frame, FilterLayerOutput&& output);
   tiny_skia::Pixmap extractFilterViewport(const SurfaceFrame& frame, int width, int height);
   bool admitTextGlyphBatch(const std::vector<TextRun>& runs);
   bool admitGlyphPredecode(const FontManager& fontManager, FontHandle font, int glyphIndex,
@@ -442,7 +615,7 @@ private:
   [[nodiscard]] std::optional<tiny_skia::Paint> makeStrokePaint(const Box2d& bounds,
                                                                 const StrokeParams& stroke);
   void drawImagePixmap(const tiny_skia::PixmapView& source, int sourceWidth, int sourceHeight,
-                       const ImageParams& params);
+                       const ImageParams& params, ImageMipChain* mipChain = nullptr);
   [[nodiscard]] tiny_skia::Pixmap createTransparentPixmap(int width, int height) const;
   /**
    * Builds the base paint for a pixmap composite into \p destination.
@@ -467,6 +640,7 @@ private:
 
   bool verbose_ = false;
   bool antialias_ = true;
+  FilterPrecision filterPrecision_ = FilterPrecision::Float;
   bool warnedUnsupportedText_ = false;
   RenderViewport viewport_;
   PaintParams paint_;
@@ -558,6 +732,19 @@ private:
   std::uint64_t frameToken_ = 0;
   /// The value of `frameIndex_` `frameToken_` was taken for.
   std::uint64_t frameTokenIndex_ = 0;
+  bool retainedFilterOutputsEnabled_ = false;
+  std::size_t retainedFilterOutputBudgetBytes_ =
+      RetainedFilterOutputDocumentState::kDefaultBudgetBytes;
+  RetainedFilterOutputStats retainedFilterOutputStats_;
+  /// Identity of the current frame for retained filter outputs. @see frameToken_
+  std::uint64_t filterFrameToken_ = 0;
+  /// The value of `frameIndex_` `filterFrameToken_` was taken for.
+  std::uint64_t filterFrameTokenIndex_ = 0;
+  bool maskCoverageCacheEnabled_ = false;
+  MaskCoverageCache maskCoverageCache_;
+  MaskCoverageCacheStats maskCoverageCacheStats_;
+  bool gradientLutCacheEnabled_ = false;
+  GradientLutCache gradientLutCache_;
   /// Identity of the clip mask now in effect, zero when there is none.
   std::uint64_t clipEpoch_ = 0;
   /// Next identity to issue. Starts at one so zero stays reserved for "no clip".
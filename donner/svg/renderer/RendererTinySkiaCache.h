@@ -21,9 +21,10 @@
 /// an unchanged re-render, so an idle frame keeps its caches intact.
 
 #include <cstdint>
-#include <optional>
+#include <memory>
 #include <vector>
 
+#include "donner/svg/resources/ImageMipChain.h"
 #include "tiny_skia/Path.h"
 
 namespace donner::svg::components {
@@ -35,6 +36,11 @@ namespace donner::svg::components {
 /// changes or the entity goes away. A null source entity (overlay drawing, test harnesses) is
 /// not cached and converts inline, exactly as before the cache existed.
 ///
+/// The slots are shared rather than owned: on a miss the conversion is taken from, or derived
+/// onto, the \ref donner::SharedGeometry interned for the entity's `ComputedPathComponent`, so
+/// entities with identical outlines - within one document or across documents - point at one
+/// converted path. This component only saves the per-draw lookup into that shared cache.
+///
 /// Lives in `donner::svg::components`, alongside `ComputedPathComponent` and every other
 /// component it derives from, rather than in a backend-private namespace. (Geode's equivalent
 /// sits in `donner::geode` instead, to match the other Geode types its renderer references
@@ -42,12 +48,12 @@ namespace donner::svg::components {
 /// dependencies `components::`.)
 struct TinySkiaPathCacheComponent {
   /// Conversion that preserves `ClosePath` verbs. Used by fills and by every ordinary stroke.
-  std::optional<tiny_skia::Path> closedPath;
+  std::shared_ptr<const tiny_skia::Path> closedPath;
 
   /// Conversion that replaces each `ClosePath` with an explicit closing line. Used only by the
   /// dash-stroke path that has to emit caps at a closed contour's seam, so it is filled in on
   /// demand rather than alongside \ref closedPath.
-  std::optional<tiny_skia::Path> openedPath;
+  std::shared_ptr<const tiny_skia::Path> openedPath;
 };
 
 /// Per-entity cache of a `LoadedImageComponent`'s pixels converted from the straight-alpha
@@ -64,7 +70,9 @@ struct TinySkiaPathCacheComponent {
 /// document holds it. That is bounded by the images the document actually draws (an undrawn or
 /// removed image holds nothing), and it buys a full-buffer conversion pass and allocation per
 /// image per frame; a document with a large enough image working set to care would need an
-/// eviction policy this cache deliberately does not have.
+/// eviction policy this cache deliberately does not have. Images loaded while the process-wide
+/// \ref donner::svg::DecodedImageCache is enabled bypass this component entirely and borrow the
+/// shared entry's premultiplied pixels, which that cache bounds with LRU eviction.
 /// @see TinySkiaPathCacheComponent for the namespace-placement rationale.
 struct TinySkiaImageCacheComponent {
   /// Premultiplied RGBA8, tightly packed.
@@ -73,6 +81,9 @@ struct TinySkiaImageCacheComponent {
   int width = 0;
   /// Height the payload was converted at, in pixels.
   int height = 0;
+  /// Downsampled levels of \ref premultiplied for minified draws, built on demand and reset
+  /// whenever the payload is reconverted.
+  ImageMipChain mips;
 };
 
 }  // namespace donner::svg::components
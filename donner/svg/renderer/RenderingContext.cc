@@ -1381,6 +1381,7 @@ void RenderingContext::ensureComputedComponents(ParseWarningSink& warningSink) {
   registry_.clear<ComputedShadowTreeComponent>();
   registry_.clear<RenderingInstanceComponent>();
   registry_.clear<ComputedClipPathsComponent>();
+  renderState.markInstancesChanged();
 
   // Animated presentation attributes are written straight into the cached computed styles (see
   // applyAnimationOverrides above), which is only sound while every pass rebuilds those styles
@@ -1558,6 +1559,7 @@ void RenderingContext::invalidateRenderTree() {
   auto& renderState = getRenderTreeState(registry_);
   renderState.needsFullRebuild = true;
   renderState.needsFullStyleRecompute = true;
+  renderState.markInstancesChanged();
 }
 
 // 1. Setup shadow trees
@@ -1817,6 +1819,7 @@ std::optional<RenderingContext::FeImageSubtreeResult> RenderingContext::createFe
       [](const RenderingInstanceComponent& lhs, const RenderingInstanceComponent& rhs) {
         return lhs.drawOrder < rhs.drawOrder;
       });
+  getRenderTreeState(registry_).markInstancesChanged();
 
   if (lastEntity == entt::null) {
     return std::nullopt;
@@ -1846,6 +1849,7 @@ void RenderingContext::instantiateRenderTreeWithPrecomputedTree(bool verbose) {
       [](const RenderingInstanceComponent& lhs, const RenderingInstanceComponent& rhs) {
         return lhs.drawOrder < rhs.drawOrder;
       });
+  getRenderTreeState(registry_).markInstancesChanged();
 }
 
 }  // namespace donner::svg::components
@@ -0,0 +1,122 @@
+#include "donner/svg/renderer/RetainedFilterOutput.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace donner::svg {
+
+namespace {
+
+bool TransformsEqual(const Transform2d& lhs, const Transform2d& rhs) {
+  return std::equal(std::begin(lhs.data), std::end(lhs.data), std::begin(rhs.data));
+}
+
+/// Compares filter regions bitwise, like the transforms beside them.
+bool RegionsEqual(const std::optional<Box2d>& lhs, const std::optional<Box2d>& rhs) {
+  if (lhs.has_value() != rhs.has_value()) {
+    return false;
+  }
+  if (!lhs.has_value()) {
+    return true;
+  }
+  return lhs->topLeft.x == rhs->topLeft.x && lhs->topLeft.y == rhs->topLeft.y &&
+         lhs->bottomRight.x == rhs->bottomRight.x && lhs->bottomRight.y == rhs->bottomRight.y;
+}
+
+void ReleaseBytes(RetainedFilterOutputDocumentState& state, std::size_t bytes) {
+  state.liveBytes -= std::min(state.liveBytes, bytes);
+}
+
+}  // namespace
+
+bool operator==(const RetainedFilterOutputKey& lhs, const RetainedFilterOutputKey& rhs) {
+  return lhs.instancesRevision != 0 && lhs.documentRevision == rhs.documentRevision &&
+         lhs.instancesRevision == rhs.instancesRevision &&
+         TransformsEqual(lhs.deviceFromFilter, rhs.deviceFromFilter) &&
+         RegionsEqual(lhs.filterRegion, rhs.filterRegion) && lhs.surfaceSize == rhs.surfaceSize &&
+         lhs.antialias == rhs.antialias && lhs.precision == rhs.precision;
+}
+
+std::size_t RetainedFilterOutputBytes(const RetainedFilterOutputComponent& entry) {
+  return sizeof(RetainedFilterOutputComponent) +
+         (entry.output.has_value() ? entry.output->pixmap.data().size() : 0u);
+}
+
+RetainedFilterOutputDocumentState& RetainedFilterOutputStateFor(Registry& registry,
+                                                                std::size_t budgetBytes) {
+  RetainedFilterOutputDocumentState& state =
+      registry.ctx().emplace<RetainedFilterOutputDocumentState>();
+  if (state.budgetBytes != budgetBytes) {
+    // A new budget gets to answer "does the working set fit" again.
+    state.budgetBytes = budgetBytes;
+    state.disabled = false;
+  }
+  return state;
+}
+
+void ClearRetainedFilterOutputs(Registry& registry) {
+  auto* state = registry.ctx().find<RetainedFilterOutputDocumentState>();
+  if (state == nullptr) {
+    return;
+  }
+
+  registry.clear<RetainedFilterOutputComponent>();
+  state->liveBytes = 0;
+}
+
+void EvictRetainedFilterOutputsToBudget(Registry& registry, std::uint64_t currentFrame) {
+  auto* state = registry.ctx().find<RetainedFilterOutputDocumentState>();
+  if (state == nullptr || state->liveBytes <= state->budgetBytes) {
+    return;
+  }
+
+  struct Candidate {
+    Entity entity;
+    std::uint64_t lastUsedFrame;
+    std::size_t bytes;
+  };
+
+  std::vector<Candidate> candidates;
+  const auto view = registry.view<const RetainedFilterOutputComponent>();
+  candidates.reserve(view.size());
+  std::size_t held = 0;
+  for (const Entity entity : view) {
+    const RetainedFilterOutputComponent& entry = view.get<const RetainedFilterOutputComponent>(entity);
+    held += entry.chargedBytes;
+    if (entry.lastUsedFrame >= currentFrame) {
+      continue;
+    }
+    candidates.push_back(Candidate{entity, entry.lastUsedFrame, entry.chargedBytes});
+  }
+
+  // Entries destroyed with their rendering instance never report back, so recount before acting.
+  state->liveBytes = held;
+  if (state->liveBytes <= state->budgetBytes) {
+    return;
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+    return lhs.lastUsedFrame < rhs.lastUsedFrame;
+  });
+
+  for (const Candidate& candidate : candidates) {
+    if (state->liveBytes <= state->budgetBytes) {
+      return;
+    }
+
+    registry.remove<RetainedFilterOutputComponent>(candidate.entity);
+    ReleaseBytes(*state, candidate.bytes);
+    ++state->evictions;
+  }
+
+  if (state->liveBytes <= state->budgetBytes) {
+    return;
+  }
+
+  // The layers drawn this frame do not fit on their own; retaining any of them would evict and
+  // re-render the same layers every frame.
+  ClearRetainedFilterOutputs(registry);
+  state->disabled = true;
+}
+
+}  // namespace donner::svg
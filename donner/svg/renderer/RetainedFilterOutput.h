@@ -0,0 +1,174 @@
+#pragma once
+/// @file
+/// Per-layer retained filter output for the tiny-skia backend.
+///
+/// A filter layer is the most expensive thing a frame can contain: its subtree is rendered into
+/// an offscreen surface and the whole filter graph runs over it, and both repeat every frame even
+/// when nothing the layer depends on changed. Keeping the filtered pixels, before they are clipped
+/// and composited, turns an unchanged layer into a single composite. This file owns the storage
+/// for those outputs, the key that decides whether one still describes the layer about to be
+/// drawn, and the memory bound on how much a document may keep.
+///
+/// The correctness rule matches \ref RetainedSpans.h: an output may be discarded for any reason,
+/// but it may only be reused when every input it depended on is unchanged, and every input that
+/// is re-supplied at composite time (the clip mask) is reproduced exactly.
+
+#include <cstdint>
+#include <optional>
+
+#include "donner/base/Box.h"
+#include "donner/base/EcsRegistry.h"
+#include "donner/base/Transform.h"
+#include "tiny_skia/Geom.h"
+#include "tiny_skia/Pixmap.h"
+
+namespace donner::svg {
+
+/// Storage the tiny-skia backend runs filter graphs in. @see RendererTinySkia::setFilterPrecision
+enum class FilterPrecision : std::uint8_t {
+  Float,  ///< 32-bit float per channel, the default.
+  Uint8,  ///< Premultiplied RGBA8 for the primitives that support it, float for the rest.
+};
+
+/// Filtered pixels of one filter layer, ready to be composited onto the surface the layer was
+/// pushed on.
+struct FilterLayerOutput {
+  /// Filter result, already clipped to the filter region.
+  tiny_skia::Pixmap pixmap;
+
+  /// Transform from `pixmap` to the device. Identity for a layer filtered in device space.
+  Transform2d deviceFromPixmap;
+
+  /// Whether `pixmap` was filtered in a local raster that must be resampled into the device,
+  /// rather than in device space at device resolution.
+  bool resampled = false;
+};
+
+/// Everything a retained filter output depends on.
+///
+/// The content of the layer is identified by revisions rather than by comparing it: the
+/// document's mutation revision moves with every DOM change, including changes to the filter,
+/// paint servers, and `feImage` sources the layer reads, and the render instances revision moves
+/// with every render tree rebuild, including canvas size and time changes. Either moving
+/// invalidates every output in the document, which is conservative but never stale.
+///
+/// The clip mask is deliberately absent: outputs are kept before the clip is applied, and the
+/// clip in effect is applied again at every composite.
+struct RetainedFilterOutputKey {
+  /// Mutation revision of the document when the output was produced.
+  std::uint64_t documentRevision = 0;
+
+  /// Render instances revision when the output was produced. 0 never matches.
+  std::uint64_t instancesRevision = 0;
+
+  /// Local-to-device transform of the filtered element.
+  Transform2d deviceFromFilter;
+
+  /// Filter region in the element's local space, if any.
+  std::optional<Box2d> filterRegion;
+
+  /// Surface the layer was pushed on. Device-space outputs are sized to it.
+  tiny_skia::IntSize surfaceSize;
+
+  /// Whether the content was rasterized with anti-aliasing.
+  bool antialias = true;
+
+  /// Precision the filter graph ran at.
+  FilterPrecision precision = FilterPrecision::Float;
+
+  friend bool operator==(const RetainedFilterOutputKey& lhs, const RetainedFilterOutputKey& rhs);
+};
+
+/**
+ * Retained filter output for one filter layer, attached to the rendering instance entity that
+ * references the filter.
+ *
+ * Rendering instances are destroyed when the render tree is rebuilt, which drops this component
+ * with them; the key's revisions cover everything else.
+ *
+ * @ingroup ecs_components
+ */
+struct RetainedFilterOutputComponent {
+  /// Inputs `output` was produced under. Only meaningful while `output` is set.
+  RetainedFilterOutputKey key;
+
+  /// Retained output, if any.
+  std::optional<FilterLayerOutput> output;
+
+  /// Frame identity of the most recent frame that read or wrote this entry, used to evict the
+  /// coldest entries first when a document exceeds its budget.
+  std::uint64_t lastUsedFrame = 0;
+
+  /// Frame identity this entry last counted a push in, paired with \ref pushesThisFrame.
+  std::uint64_t pushFrame = 0;
+
+  /// Pushes this entry has seen within `pushFrame`.
+  std::uint32_t pushesThisFrame = 0;
+
+  /// Set when one entity pushes its filter layer more than once in a single frame. One entry
+  /// cannot describe several layers at once, so the entry stops retaining instead.
+  bool ambiguous = false;
+
+  /// Bytes this entry is currently charged against the document budget.
+  std::size_t chargedBytes = 0;
+};
+
+/**
+ * Document-wide state for retained filter outputs, stored in the registry context.
+ *
+ * The number and size of filter layers are chosen by the document, so the budget here is what
+ * keeps retained outputs bounded. Exceeding it evicts the coldest entries, and a working set that
+ * does not fit at all turns retention off for the document. Frame identities are issued here for
+ * the same reason as \ref RetainedSpanDocumentState::frameCounter.
+ */
+struct RetainedFilterOutputDocumentState {
+  /// Default budget: a few full-viewport layers at typical sizes.
+  static constexpr std::size_t kDefaultBudgetBytes = 64u * 1024u * 1024u;
+
+  /// Bytes currently held by every retained output in this document.
+  std::size_t liveBytes = 0;
+
+  /// Ceiling on `liveBytes`.
+  std::size_t budgetBytes = kDefaultBudgetBytes;
+
+  /// Set when the working set did not fit the budget, which turns retention off for this
+  /// document until the budget changes.
+  bool disabled = false;
+
+  /// Entries evicted to stay under budget, across the document's lifetime.
+  std::uint64_t evictions = 0;
+
+  /// Issues frame identities, one per frame of every renderer drawing this document.
+  std::uint64_t frameCounter = 0;
+};
+
+/// Counters describing what a renderer's retained filter outputs did during the most recent
+/// frame, for tests and benchmarks. Counts are per filter layer offered for reuse.
+struct RetainedFilterOutputStats {
+  std::uint64_t reusedLayers = 0;       ///< Layers composited from a retained output.
+  std::uint64_t renderedLayers = 0;     ///< Layers rendered and filtered, then retained.
+  std::uint64_t invalidatedLayers = 0;  ///< Renders that replaced an output whose key changed.
+  /// Layers retention did not apply to: nested in another surface, rejected by a budget, or
+  /// belonging to an ambiguous or disabled entry.
+  std::uint64_t bypassedLayers = 0;
+  std::size_t liveBytes = 0;      ///< Bytes retained by the document at the end of the frame.
+  std::uint64_t evictions = 0;    ///< Entries evicted to stay under budget.
+  bool documentDisabled = false;  ///< Whether the document stopped retaining filter outputs.
+};
+
+/// Returns the bytes an entry holds: its output pixels and the entry itself.
+[[nodiscard]] std::size_t RetainedFilterOutputBytes(const RetainedFilterOutputComponent& entry);
+
+/// Returns the document's retained filter output state, creating it if needed.
+RetainedFilterOutputDocumentState& RetainedFilterOutputStateFor(Registry& registry,
+                                                                std::size_t budgetBytes);
+
+/// Drops every retained filter output in `registry` and resets its accounting.
+void ClearRetainedFilterOutputs(Registry& registry);
+
+/// Evicts the coldest entries until the document is under budget, disabling retention for the
+/// document when the entries used in `currentFrame` alone exceed it.
+/// @see EvictRetainedSpansToBudget
+void EvictRetainedFilterOutputsToBudget(Registry& registry, std::uint64_t currentFrame);
+
+}  // namespace donner::svg
@@ -11,6 +11,12 @@
 /// `<ellipse>` geometry comes from evaluating a handful of lengths, so the per-shape entries are
 /// split by shape type to keep those two costs separable.
 ///
+/// `BM_FirstPrepare_Workers/<threads>` times the first prepare of a freshly parsed, styled
+/// document with `SVGDocument::setPrepareThreadCount(<threads>)`, covering the parallel selector
+/// matching and path-data parsing stages together with the serial passes around them. Every
+/// iteration prepares a new document, so the time includes starting that document's worker
+/// threads.
+///
 /// Usage:
 /// ```
 /// bazel run -c opt //donner/svg/renderer/benchmarks:shape_prepare_perf_bench -- \
@@ -87,6 +93,35 @@ std::string MakeCircleSvg(int count) {
   return WrapSvg(body.str());
 }
 
+/// `count` `<path>` elements in groups of 16, each with classes matched by a stylesheet of
+/// class, descendant and attribute selectors, so both the cascade and path parsing have work.
+std::string MakeStyledPathSvg(int count) {
+  std::ostringstream body;
+  body << "<style>";
+  for (int i = 0; i < 32; ++i) {
+    body << ".c" << i << " { fill: rgb(" << i * 8 << ", 0, 0) } ";
+    body << "g.g" << i % 8 << " > .c" << i << " { stroke: blue; stroke-width: " << i % 4 + 1
+         << " } ";
+    body << "path[data-k=\"" << i << "\"] { opacity: 0.9 } ";
+  }
+  body << "</style>";
+  for (int i = 0; i < count; ++i) {
+    if (i % 16 == 0) {
+      body << R"(<g class="g)" << (i / 16) % 8 << R"(">)";
+    }
+    const int x = (i % 32) * 32;
+    const int y = (i / 32) % 32 * 32;
+    body << R"(<path class="c)" << i % 32 << R"(" data-k=")" << i % 40 << R"(" d="M)" << x << ' '
+         << y << " C" << (x + 28) << ' ' << y << ' ' << (x + 30) << ' ' << (y + 4) << ' '
+         << (x + 30) << ' ' << (y + 8) << " Q" << (x + 30) << ' ' << (y + 28) << ' ' << (x + 22)
+         << ' ' << (y + 28) << " L" << x << ' ' << (y + 28) << R"( Z"/>)";
+    if (i % 16 == 15 || i + 1 == count) {
+      body << "</g>";
+    }
+  }
+  return WrapSvg(body.str());
+}
+
 /// A real illustration: a few hundred filled and stroked paths with long path-data strings.
 std::string LoadTigerSvg() {
   const std::string path =
@@ -167,6 +202,34 @@ void BM_Prepare_Tiger(benchmark::State& state) {
 }
 BENCHMARK(BM_Prepare_Tiger);
 
+void BM_FirstPrepare_Workers(benchmark::State& state) {
+  // Sized so every element is matched against all 96 rules within the cascade's
+  // rule-element budget; past it the cascade stops early and selector matching stays serial.
+  const std::string svg = MakeStyledPathSvg(8000);
+  ParseWarningSink sink = ParseWarningSink::Disabled();
+  // 8000 paths and their groups are past the default tree-node limit.
+  SVGParser::Options options;
+  options.maximumTreeNodes = svg.size();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto result = SVGParser::ParseSVG(svg, sink, options);
+    SVGDocument document = std::move(result).result();
+    document.setCanvasSize(kCanvasSize.x, kCanvasSize.y);
+    document.setPrepareThreadCount(static_cast<std::size_t>(state.range(0)));
+    state.ResumeTiming();
+
+    RendererUtils::prepareDocumentForRendering(document, /*verbose=*/false, sink);
+
+    // Destroying the document is not part of the prepare.
+    state.PauseTiming();
+    document = SVGDocument();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FirstPrepare_Workers)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond);
+
 }  // namespace
 
 int main(int argc, char** argv) {
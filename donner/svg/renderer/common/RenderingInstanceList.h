@@ -0,0 +1,124 @@
+#pragma once
+/// @file
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "donner/base/Box.h"
+#include "donner/base/EcsRegistry.h"
+#include "donner/svg/core/MixBlendMode.h"
+#include "donner/svg/renderer/RendererInterface.h"
+
+namespace donner::svg {
+
+/**
+ * The render tree's main draw list compiled into structure-of-arrays form, stored in the registry
+ * context and rebuilt only when \ref components::RenderTreeState::instancesRevision changes.
+ *
+ * Row `i` of every column describes `entities()[i]`. Rows are in draw order, and offscreen
+ * feImage shadow instances are left out. Each row caches the draw state of one
+ * \ref components::RenderingInstanceComponent that depends only on the render tree, the computed
+ * styles, and the geometry: which layers the instance pushes, its paint, and its cull bounds. A
+ * steady frame reads these columns in a linear scan instead of resolving styles, paint servers,
+ * and clip state through the registry for every instance.
+ */
+class RenderingInstanceList {
+public:
+  /// Per-row flags.
+  enum Flags : uint16_t {
+    None = 0,
+    HasStyle = 1 << 0,       //!< The computed style has properties; rows without are not drawn.
+    IsolatedLayer = 1 << 1,  //!< Opacity, blend mode, or isolation require an isolated layer.
+    EntityClip = 1 << 2,     //!< Has a clip path, which is resolved when drawn.
+    PatternFill = 1 << 3,    //!< The fill is a pattern whose tile subtree must be rendered.
+    PatternStroke = 1 << 4,  //!< The stroke is a pattern whose tile subtree must be rendered.
+    /// Paint and cull bounds depend on the world transform (`vector-effect:
+    /// non-scaling-stroke`), so they are recomputed for every draw instead of cached.
+    TransformDependent = 1 << 5,
+  };
+
+  /// Cached draw state of one instance, used to append rows and for instances drawn without a
+  /// compiled list.
+  struct Row {
+    uint16_t flags = None;                          //!< Combination of \ref Flags.
+    double opacity = 1.0;                           //!< Computed `opacity`.
+    MixBlendMode blendMode = MixBlendMode::Normal;  //!< Computed `mix-blend-mode`.
+    PaintParams paint;                              //!< Paint before draw-time context remaps.
+    std::optional<Box2d> cullBounds;  //!< Local drawable bounds including stroke, if known.
+  };
+
+  /// Revision of the render instances the list was compiled from, 0 if never compiled.
+  std::uint64_t instancesRevision() const { return instancesRevision_; }
+
+  /// Returns true if the list was compiled from render instances at \p instancesRevision. A
+  /// revision of 0 means the instances are untracked, and never matches.
+  bool isCompiledFrom(std::uint64_t instancesRevision) const {
+    return instancesRevision != 0 && instancesRevision == instancesRevision_;
+  }
+
+  /// Removes every row, keeping the column capacity, and records the revision the rows about to
+  /// be appended are compiled from.
+  void reset(std::uint64_t instancesRevision) {
+    instancesRevision_ = instancesRevision;
+    entities_.clear();
+    flags_.clear();
+    opacities_.clear();
+    blendModes_.clear();
+    paints_.clear();
+    cullBounds_.clear();
+    filterEntities_.clear();
+  }
+
+  /**
+   * Appends the row for \p entity.
+   *
+   * @param entity Entity holding the \ref components::RenderingInstanceComponent.
+   * @param row Draw state of the instance.
+   * @param hasFilter True if the instance references a filter, which is resolved per frame.
+   */
+  void append(Entity entity, Row&& row, bool hasFilter) {
+    entities_.push_back(entity);
+    flags_.push_back(row.flags);
+    opacities_.push_back(row.opacity);
+    blendModes_.push_back(row.blendMode);
+    paints_.push_back(std::move(row.paint));
+    cullBounds_.push_back(row.cullBounds);
+    if (hasFilter) {
+      filterEntities_.push_back(entity);
+    }
+  }
+
+  /// Number of rows.
+  std::size_t size() const { return entities_.size(); }
+
+  /// Entities in draw order, one per row.
+  std::span<const Entity> entities() const { return entities_; }
+
+  /// Entities whose instance references a filter, in draw order.
+  std::span<const Entity> filterEntities() const { return filterEntities_; }
+
+  /// Flags of row \p index, a combination of \ref Flags. Stored in their own column so a scan can
+  /// skip rows without touching their draw state.
+  uint16_t flags(std::size_t index) const { return flags_[index]; }
+
+  /// Returns a copy of row \p index.
+  Row row(std::size_t index) const {
+    return Row{flags_[index], opacities_[index], blendModes_[index], paints_[index],
+               cullBounds_[index]};
+  }
+
+private:
+  std::uint64_t instancesRevision_ = 0;
+  std::vector<Entity> entities_;
+  std::vector<uint16_t> flags_;
+  std::vector<double> opacities_;
+  std::vector<MixBlendMode> blendModes_;
+  std::vector<PaintParams> paints_;
+  std::vector<std::optional<Box2d>> cullBounds_;
+  std::vector<Entity> filterEntities_;
+};
+
+}  // namespace donner::svg
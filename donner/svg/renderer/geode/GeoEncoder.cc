@@ -3416,7 +3416,7 @@ namespace {
 /// Returns whether an image draw has a valid destination and upload-safe RGBA payload.
 bool IsValidImageDraw(const svg::ImageResource& image, const Box2d& destRect,
                       const GeodeDevice& device) {
-  if (image.data.empty() || image.width <= 0 || image.height <= 0) {
+  if (image.pixels().empty() || image.width <= 0 || image.height <= 0) {
     return false;
   }
   if (destRect.isEmpty()) {
@@ -3429,7 +3429,7 @@ bool IsValidImageDraw(const svg::ImageResource& image, const Box2d& destRect,
     return false;
   }
 
-  return svg::HasExactRgbaPayload(image.data, image.width, image.height);
+  return svg::HasExactRgbaPayload(image.pixels(), image.width, image.height);
 }
 
 /// Maps the resolved CSS image-rendering value to the Geode sampler policy.
@@ -3482,7 +3482,7 @@ void GeoEncoder::drawImage(const svg::ImageResource& image, const Box2d& destRec
   impl_->bindImagePipeline(impl_->imagePipeline->pipeline());
 
   // Interpolation happens in premultiplied space so transparent colored texels cannot fringe.
-  const std::vector<std::uint8_t> premultiplied = svg::PremultiplyRgba(image.data);
+  const std::vector<std::uint8_t> premultiplied = svg::PremultiplyRgba(image.pixels());
   wgpu::Texture texture = impl_->transientResources.retain(GeodeTextureEncoder::uploadRgba8Texture(
       *impl_->device, premultiplied.data(), static_cast<uint32_t>(image.width),
       static_cast<uint32_t>(image.height)));
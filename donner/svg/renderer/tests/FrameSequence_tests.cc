@@ -0,0 +1,171 @@
+#include "donner/svg/renderer/FrameSequence.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "donner/svg/renderer/RendererImageIO.h"
+#include "donner/svg/renderer/tests/RendererTestBackend.h"
+#include "donner/svg/tests/ParserTestUtils.h"
+
+namespace donner::svg {
+namespace {
+
+using ::testing::ElementsAre;
+
+/// Parse a fragment with experimental (animation) elements enabled, on a 16x16 canvas.
+SVGDocument ParseAnimated(std::string_view fragment) {
+  parser::SVGParser::Options options;
+  options.enableExperimental = true;
+  return instantiateSubtree(fragment, options, Vector2i(16, 16));
+}
+
+struct RecordedFrame {
+  double time = 0.0;
+  bool reused = false;
+  std::vector<uint8_t> pixels;
+};
+
+std::vector<RecordedFrame> RenderFrames(SVGDocument& document,
+                                        const FrameSequenceOptions& options,
+                                        FrameSequenceStats* outStats = nullptr) {
+  std::unique_ptr<RendererInterface> renderer = CreateRendererInstance(ActiveRendererBackend());
+  std::vector<RecordedFrame> frames;
+  const FrameSequenceStats stats =
+      RenderFrameSequence(*renderer, document, options, [&](const FrameSequenceFrame& frame) {
+        EXPECT_EQ(frame.index, frames.size());
+        frames.push_back(RecordedFrame{frame.time, frame.reused, frame.bitmap->pixels});
+        return true;
+      });
+  if (outStats) {
+    *outStats = stats;
+  }
+  return frames;
+}
+
+std::vector<bool> ReusedFlags(const std::vector<RecordedFrame>& frames) {
+  std::vector<bool> flags;
+  for (const RecordedFrame& frame : frames) {
+    flags.push_back(frame.reused);
+  }
+  return flags;
+}
+
+}  // namespace
+
+TEST(FrameSequence, RedrawsOnlyWhenAnAnimationChangesPhase) {
+  SVGDocument document = ParseAnimated(R"(
+    <rect width="16" height="16" fill="white">
+      <set attributeName="fill" to="black" begin="1s" />
+    </rect>
+  )");
+
+  FrameSequenceStats stats;
+  const std::vector<RecordedFrame> frames =
+      RenderFrames(document, {.startTime = 0.0, .endTime = 3.0, .frameRate = 2.0}, &stats);
+
+  ASSERT_EQ(frames.size(), 6u);
+  EXPECT_DOUBLE_EQ(frames[5].time, 2.5);
+  EXPECT_THAT(ReusedFlags(frames), ElementsAre(false, true, false, true, true, true));
+  EXPECT_EQ(stats.frames, 6u);
+  EXPECT_EQ(stats.renderedFrames, 2u);
+  EXPECT_EQ(stats.reusedFrames, 4u);
+
+  EXPECT_EQ(frames[0].pixels, frames[1].pixels);
+  EXPECT_NE(frames[1].pixels, frames[2].pixels);
+  EXPECT_EQ(frames[2].pixels, frames[5].pixels);
+  EXPECT_EQ(document.currentTime(), 2.5);
+}
+
+TEST(FrameSequence, RedrawsEveryFrameWhileAValueVaries) {
+  SVGDocument document = ParseAnimated(R"(
+    <rect width="4" height="16" fill="black">
+      <animate attributeName="width" from="4" to="12" begin="1s" dur="1s" fill="freeze" />
+    </rect>
+  )");
+
+  const std::vector<RecordedFrame> frames =
+      RenderFrames(document, {.startTime = 0.0, .endTime = 3.0, .frameRate = 4.0});
+
+  // Static before 1s, interpolating over [1s, 2s), frozen from 2s.
+  EXPECT_THAT(ReusedFlags(frames), ElementsAre(false, true, true, true,    //
+                                               false, false, false, false,  //
+                                               false, true, true, true));
+  EXPECT_NE(frames[4].pixels, frames[5].pixels);
+}
+
+TEST(FrameSequence, DocumentWithoutAnimationsRendersOnce) {
+  SVGDocument document = ParseAnimated(R"(<rect width="8" height="8" fill="black" />)");
+
+  FrameSequenceStats stats;
+  RenderFrames(document, {.startTime = 0.0, .endTime = 1.0, .frameRate = 30.0}, &stats);
+  EXPECT_EQ(stats.frames, 30u);
+  EXPECT_EQ(stats.renderedFrames, 1u);
+}
+
+TEST(FrameSequence, EmptyRangeYieldsOneFrameAndInvalidRateYieldsNone) {
+  SVGDocument document = ParseAnimated(R"(<rect width="8" height="8" fill="black" />)");
+
+  EXPECT_EQ(RenderFrames(document, {.startTime = 2.0, .endTime = 2.0}).size(), 1u);
+  EXPECT_TRUE(RenderFrames(document, {.startTime = 0.0, .endTime = 1.0, .frameRate = 0.0}).empty());
+}
+
+TEST(FrameSequence, StopsWhenTheCallbackReturnsFalse) {
+  SVGDocument document = ParseAnimated(R"(<rect width="8" height="8" fill="black" />)");
+  std::unique_ptr<RendererInterface> renderer = CreateRendererInstance(ActiveRendererBackend());
+
+  const FrameSequenceStats stats = RenderFrameSequence(
+      *renderer, document, {.startTime = 0.0, .endTime = 10.0, .frameRate = 1.0},
+      [](const FrameSequenceFrame& frame) { return frame.index < 2; });
+  EXPECT_EQ(stats.frames, 3u);
+}
+
+TEST(ApngEncoder, MergesExtendedFramesAndNumbersChunks) {
+  const std::vector<uint8_t> black = {0, 0, 0, 255, 0, 0, 0, 255};
+  const std::vector<uint8_t> white = {255, 255, 255, 255, 255, 255, 255, 255};
+
+  ApngEncoder encoder(2, 1, 10);
+  EXPECT_TRUE(encoder.finish().empty());
+  encoder.addFrame(black);
+  encoder.extendLastFrame();
+  encoder.extendLastFrame();
+  encoder.addFrame(white);
+  EXPECT_EQ(encoder.frameCount(), 2u);
+
+  const std::vector<uint8_t> png = encoder.finish();
+  ASSERT_GT(png.size(), 8u);
+  EXPECT_THAT(std::vector<uint8_t>(png.begin(), png.begin() + 8),
+              ElementsAre(0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'));
+
+  // Walk the chunk list: type, and for fcTL the sequence number and delay.
+  std::vector<std::string> types;
+  std::vector<uint32_t> fcTLSequence;
+  std::vector<uint16_t> delays;
+  const auto u32 = [&](size_t offset) {
+    return (uint32_t(png[offset]) << 24) | (uint32_t(png[offset + 1]) << 16) |
+           (uint32_t(png[offset + 2]) << 8) | uint32_t(png[offset + 3]);
+  };
+  for (size_t offset = 8; offset + 12 <= png.size();) {
+    const uint32_t length = u32(offset);
+    const std::string type(reinterpret_cast<const char*>(&png[offset + 4]), 4);
+    types.push_back(type);
+    if (type == "acTL") {
+      EXPECT_EQ(u32(offset + 8), 2u);  // num_frames
+    } else if (type == "fcTL") {
+      fcTLSequence.push_back(u32(offset + 8));
+      delays.push_back(static_cast<uint16_t>((png[offset + 28] << 8) | png[offset + 29]));
+    } else if (type == "fdAT") {
+      EXPECT_EQ(u32(offset + 8), 2u);
+    }
+    offset += 12 + length;
+  }
+
+  EXPECT_THAT(types, ElementsAre("IHDR", "acTL", "fcTL", "IDAT", "fcTL", "fdAT", "IEND"));
+  EXPECT_THAT(fcTLSequence, ElementsAre(0u, 1u));
+  EXPECT_THAT(delays, ElementsAre(3, 1));
+}
+
+}  // namespace donner::svg
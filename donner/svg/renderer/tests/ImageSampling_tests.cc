@@ -74,5 +74,65 @@ TEST(ImageSamplingTest, NonFiniteMappedCoordinatesStayTransparent) {
   EXPECT_THAT(std::vector<std::uint8_t>(output.end() - 4, output.end()), ElementsAre(0, 0, 0, 0));
 }
 
+TEST(ImageSamplingTest, SelectsMipLevelOnlyForSmoothMinification) {
+  // No minification, or less than 2x, samples the source.
+  EXPECT_EQ(SelectImageMipLevel(Transform2d(), 64, 64, ImageRendering::Smooth), 0);
+  EXPECT_EQ(SelectImageMipLevel(Transform2d::Scale(0.6), 64, 64, ImageRendering::Smooth), 0);
+
+  EXPECT_EQ(SelectImageMipLevel(Transform2d::Scale(0.5), 64, 64, ImageRendering::Smooth), 1);
+  EXPECT_EQ(SelectImageMipLevel(Transform2d::Scale(0.2), 64, 64, ImageRendering::Auto), 2);
+  EXPECT_EQ(SelectImageMipLevel(Transform2d::Scale(1.0 / 30.0), 6000, 4000,
+                                ImageRendering::OptimizeQuality),
+            4);
+
+  // Anisotropic scales follow the least-minified axis.
+  EXPECT_EQ(SelectImageMipLevel(Transform2d::Scale(0.1, 0.5), 64, 64, ImageRendering::Smooth), 1);
+
+  // Clamped to the last level.
+  EXPECT_EQ(SelectImageMipLevel(Transform2d::Scale(1e-6), 4, 4, ImageRendering::Smooth), 2);
+
+  // Hard-edged rendering never prefilters.
+  EXPECT_EQ(SelectImageMipLevel(Transform2d::Scale(0.1), 64, 64, ImageRendering::Pixelated), 0);
+  EXPECT_EQ(SelectImageMipLevel(Transform2d::Scale(0.1), 64, 64, ImageRendering::CrispEdges), 0);
+  EXPECT_EQ(SelectImageMipLevel(Transform2d::Scale(0.1), 64, 64, ImageRendering::OptimizeSpeed),
+            0);
+}
+
+TEST(ImageSamplingTest, MinifiedDrawWithMipChainSamplesPrefilteredLevel) {
+  // A 1-pixel checkerboard shrunk 8x, offset so output pixel centers land on source pixel
+  // centers: sampling the source directly aliases to a solid color, while the prefiltered level
+  // averages to mid gray.
+  std::vector<std::uint8_t> checkerboard;
+  for (int y = 0; y < 16; ++y) {
+    for (int x = 0; x < 16; ++x) {
+      const std::uint8_t value = ((x + y) % 2 == 0) ? 255 : 0;
+      checkerboard.insert(checkerboard.end(), {value, value, value, 255});
+    }
+  }
+
+  const Transform2d deviceFromImage =
+      Transform2d::Translate(-0.5, -0.5) * Transform2d::Scale(0.125);
+  const std::vector<std::uint8_t> aliased = RasterizeImagePremultiplied(
+      checkerboard, 16, 16, deviceFromImage, 2, 2, ImageRendering::Smooth);
+  ASSERT_EQ(aliased.size(), 16u);
+  EXPECT_EQ(aliased[0], 255);
+
+  ImageMipChain mipChain;
+  const std::vector<std::uint8_t> filtered = RasterizeImagePremultiplied(
+      checkerboard, 16, 16, deviceFromImage, 2, 2, ImageRendering::Smooth, &mipChain);
+  ASSERT_EQ(filtered.size(), 16u);
+  EXPECT_EQ(mipChain.builtLevelCount(), 3);
+  for (size_t i = 0; i < filtered.size(); i += 4) {
+    EXPECT_NEAR(filtered[i], 128, 1);
+    EXPECT_EQ(filtered[i + 3], 255);
+  }
+
+  // Pixelated draws keep nearest-neighbor sampling at level 0.
+  ImageMipChain unusedChain;
+  RasterizeImagePremultiplied(checkerboard, 16, 16, deviceFromImage, 2, 2,
+                              ImageRendering::Pixelated, &unusedChain);
+  EXPECT_EQ(unusedChain.builtLevelCount(), 0);
+}
+
 }  // namespace
 }  // namespace donner::svg
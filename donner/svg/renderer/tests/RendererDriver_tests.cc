@@ -17,6 +17,7 @@
 #include "donner/svg/components/DocumentResourceFamilyBudget.h"
 #include "donner/svg/components/IdComponent.h"
 #include "donner/svg/components/PreserveAspectRatioComponent.h"
+#include "donner/svg/components/RenderingInstanceComponent.h"
 #include "donner/svg/components/filter/ComputedFilterResourceBudget.h"
 #include "donner/svg/components/filter/FilterComponent.h"
 #include "donner/svg/components/filter/FilterGraph.h"
@@ -31,6 +32,7 @@
 #include "donner/svg/renderer/RendererInterface.h"
 #include "donner/svg/renderer/RendererUtils.h"
 #include "donner/svg/renderer/RenderingContext.h"
+#include "donner/svg/renderer/common/RenderingInstanceList.h"
 #include "donner/svg/renderer/tests/MockRendererInterface.h"
 #include "donner/svg/tests/ParserTestUtils.h"
 
@@ -1655,5 +1657,67 @@ TEST_F(RendererDriverTest, ResolvesSpanFallbackPaintFromAncestorStyle) {
   driver.draw(document);
 }
 
+TEST_F(RendererDriverTest, SteadyFramesReuseCompiledInstanceListUntilRenderTreeChanges) {
+  SVGDocument document = makeDocument(R"svg(
+    <rect id="r" width="8" height="6" fill="red" />
+  )svg");
+
+  std::vector<css::RGBA> fills;
+  EXPECT_CALL(renderer, setPaint(_)).WillRepeatedly([&fills](const PaintParams& paint) {
+    if (const auto* solid = std::get_if<PaintServer::Solid>(&paint.fill)) {
+      fills.push_back(solid->color.resolve(css::RGBA(0, 0, 0, 255), 1.0f));
+    }
+  });
+
+  driver.draw(document);
+  const auto* compiled = document.registry().ctx().find<RenderingInstanceList>();
+  ASSERT_NE(compiled, nullptr);
+  const std::uint64_t firstRevision = compiled->instancesRevision();
+  EXPECT_NE(firstRevision, 0u);
+  ASSERT_FALSE(fills.empty());
+  EXPECT_EQ(fills.back(), css::RGBA(255, 0, 0, 255));
+
+  fills.clear();
+  driver.draw(document);
+  EXPECT_EQ(compiled->instancesRevision(), firstRevision);
+  ASSERT_FALSE(fills.empty());
+  EXPECT_EQ(fills.back(), css::RGBA(255, 0, 0, 255));
+
+  // A mutation rebuilds the render tree, which must recompile the cached paint.
+  document.querySelector("#r")->setAttribute("fill", "blue");
+  fills.clear();
+  driver.draw(document);
+  EXPECT_NE(compiled->instancesRevision(), firstRevision);
+  ASSERT_FALSE(fills.empty());
+  EXPECT_EQ(fills.back(), css::RGBA(0, 0, 255, 255));
+}
+
+TEST_F(RendererDriverTest, NonScalingStrokeFollowsInPlaceTransformUpdates) {
+  SVGDocument document = makeDocument(R"svg(
+    <rect id="r" width="8" height="6" fill="none" stroke="red" stroke-width="4"
+          vector-effect="non-scaling-stroke" />
+  )svg");
+
+  std::vector<double> strokeWidths;
+  EXPECT_CALL(renderer, setPaint(_)).WillRepeatedly([&strokeWidths](const PaintParams& paint) {
+    strokeWidths.push_back(paint.strokeParams.strokeWidth);
+  });
+
+  driver.draw(document);
+  ASSERT_FALSE(strokeWidths.empty());
+  const double firstFrameWidth = strokeWidths.back();
+
+  // The compositor moves elements by patching their world transform in place, without a render
+  // tree rebuild, so the compiled list must not cache transform-dependent stroke widths.
+  const Entity entity = document.querySelector("#r")->entityHandle().entity();
+  auto& instance = document.registry().get<components::RenderingInstanceComponent>(entity);
+  instance.worldFromEntityTransform = instance.worldFromEntityTransform * Transform2d::Scale(2.0);
+
+  strokeWidths.clear();
+  driver.draw(document);
+  ASSERT_FALSE(strokeWidths.empty());
+  EXPECT_DOUBLE_EQ(strokeWidths.back(), firstFrameWidth / 2.0);
+}
+
 }  // namespace
 }  // namespace donner::svg
@@ -0,0 +1,170 @@
+/// @file
+/// Behavior of the tiny-skia backend's gradient color table cache.
+///
+/// Tables are sampled from the stops, so cached frames are compared against a renderer without
+/// the cache within the documented tolerance rather than byte for byte. Sharing is asserted
+/// through the counters: one table per distinct stop list, reused by every later draw.
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <sstream>
+#include <string_view>
+
+#include "donner/svg/parser/SVGParser.h"
+#include "donner/svg/renderer/RendererTinySkia.h"
+#include "donner/svg/tests/ParserTestUtils.h"
+
+namespace donner::svg {
+namespace {
+
+SVGDocument parseDocument(std::string_view svg) {
+  ParseWarningSink warningSink;
+  auto parsed = parser::SVGParser::ParseSVG(svg, warningSink);
+  EXPECT_FALSE(parsed.hasError()) << parsed.error();
+  return std::move(parsed).result();
+}
+
+/// Wraps a fragment in a fixed-size document.
+SVGDocument parseFragment(std::string_view fragment, int width = 96, int height = 96) {
+  std::ostringstream svg;
+  svg << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << width << "\" height=\""
+      << height << "\">" << fragment << "</svg>";
+  return parseDocument(svg.str());
+}
+
+/// Matches \ref RendererTinySkia::setGradientLutCacheEnabled's bound.
+constexpr int kMaxChannelDifference = 2;
+
+::testing::AssertionResult BitmapsClose(const RendererBitmap& lhs, const RendererBitmap& rhs) {
+  if (lhs.dimensions != rhs.dimensions || lhs.pixels.size() != rhs.pixels.size()) {
+    return ::testing::AssertionFailure()
+           << "dimensions differ: " << lhs.dimensions << " vs " << rhs.dimensions;
+  }
+
+  for (std::size_t i = 0; i < lhs.pixels.size(); ++i) {
+    if (std::abs(static_cast<int>(lhs.pixels[i]) - static_cast<int>(rhs.pixels[i])) >
+        kMaxChannelDifference) {
+      const std::size_t pixel = i / 4;
+      const int x = static_cast<int>(pixel % static_cast<std::size_t>(lhs.dimensions.x));
+      const int y = static_cast<int>(pixel / static_cast<std::size_t>(lhs.dimensions.x));
+      return ::testing::AssertionFailure()
+             << "difference at pixel (" << x << ", " << y << ") channel " << (i % 4) << ": "
+             << static_cast<int>(lhs.pixels[i]) << " vs " << static_cast<int>(rhs.pixels[i]);
+    }
+  }
+  return ::testing::AssertionSuccess();
+}
+
+RendererBitmap renderFresh(SVGDocument& document) {
+  RendererTinySkia renderer;
+  renderer.draw(document);
+  return renderer.takeSnapshot();
+}
+
+/// One four-stop gradient used by three shapes with different geometry, and one two-stop
+/// gradient, which never needs a table.
+constexpr std::string_view kChartScene = R"svg(
+    <defs>
+      <linearGradient id="bar" x1="0" y1="0" x2="0" y2="1">
+        <stop offset="0" stop-color="#2060c0"/>
+        <stop id="mid" offset="0.4" stop-color="#40c0a0" stop-opacity="0.8"/>
+        <stop offset="0.7" stop-color="#f0c020"/>
+        <stop offset="1" stop-color="#c02020" stop-opacity="0.6"/>
+      </linearGradient>
+      <linearGradient id="plain">
+        <stop offset="0" stop-color="#000000"/>
+        <stop offset="1" stop-color="#ffffff"/>
+      </linearGradient>
+    </defs>
+    <rect x="0" y="0" width="96" height="96" fill="url(#plain)"/>
+    <rect x="8" y="40" width="20" height="56" fill="url(#bar)"/>
+    <rect x="38" y="16" width="20" height="80" fill="url(#bar)"/>
+    <rect x="68" y="64" width="20" height="32" fill="url(#bar)"/>
+  )svg";
+
+}  // namespace
+
+TEST(RendererGradientLutCache, ShapesShareOneTableWithinAndAcrossFrames) {
+  SVGDocument document = parseFragment(kChartScene);
+  const RendererBitmap fresh = renderFresh(document);
+
+  RendererTinySkia renderer;
+  renderer.setGradientLutCacheEnabled(true);
+  renderer.draw(document);
+  GradientLutCacheStats stats = renderer.gradientLutCacheStats();
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.hits, 2u);
+  EXPECT_GT(stats.liveBytes, 0u);
+  EXPECT_TRUE(BitmapsClose(fresh, renderer.takeSnapshot()));
+
+  renderer.draw(document);
+  stats = renderer.gradientLutCacheStats();
+  EXPECT_EQ(stats.misses, 0u);
+  EXPECT_EQ(stats.hits, 3u);
+  EXPECT_TRUE(BitmapsClose(fresh, renderer.takeSnapshot()));
+}
+
+TEST(RendererGradientLutCache, CacheIsOffByDefault) {
+  SVGDocument document = parseFragment(kChartScene);
+
+  RendererTinySkia renderer;
+  EXPECT_FALSE(renderer.gradientLutCacheEnabled());
+  renderer.draw(document);
+  const GradientLutCacheStats stats = renderer.gradientLutCacheStats();
+  EXPECT_EQ(stats.hits + stats.misses, 0u);
+  EXPECT_EQ(stats.liveBytes, 0u);
+  EXPECT_TRUE(BitmapsClose(renderFresh(document), renderer.takeSnapshot()));
+}
+
+TEST(RendererGradientLutCache, ChangedStopsBuildANewTable) {
+  SVGDocument document = parseFragment(kChartScene);
+  auto midStop = document.querySelector("#mid");
+  ASSERT_TRUE(midStop.has_value());
+
+  RendererTinySkia renderer;
+  renderer.setGradientLutCacheEnabled(true);
+  renderer.draw(document);
+  ASSERT_EQ(renderer.gradientLutCacheStats().misses, 1u);
+
+  midStop->setAttribute("stop-color", "#ff00ff");
+  renderer.draw(document);
+  EXPECT_EQ(renderer.gradientLutCacheStats().misses, 1u);
+  EXPECT_EQ(renderer.gradientLutCacheStats().hits, 2u);
+  EXPECT_TRUE(BitmapsClose(renderFresh(document), renderer.takeSnapshot()));
+}
+
+/// Opacity is folded into the stop colors, so the same gradient under different opacities
+/// needs a table per opacity.
+TEST(RendererGradientLutCache, OpacityIsPartOfTheKey) {
+  SVGDocument document = parseFragment(R"svg(
+      <linearGradient id="g">
+        <stop offset="0" stop-color="#2060c0"/>
+        <stop offset="0.5" stop-color="#40c0a0"/>
+        <stop offset="1" stop-color="#c02020"/>
+      </linearGradient>
+      <rect x="0" y="0" width="96" height="40" fill="url(#g)"/>
+      <rect x="0" y="48" width="96" height="40" fill="url(#g)" fill-opacity="0.5"/>)svg");
+
+  RendererTinySkia renderer;
+  renderer.setGradientLutCacheEnabled(true);
+  renderer.draw(document);
+  EXPECT_EQ(renderer.gradientLutCacheStats().misses, 2u);
+  EXPECT_TRUE(BitmapsClose(renderFresh(document), renderer.takeSnapshot()));
+}
+
+TEST(RendererGradientLutCache, BudgetBoundsCachedBytes) {
+  SVGDocument document = parseFragment(kChartScene);
+
+  RendererTinySkia renderer;
+  renderer.setGradientLutCacheEnabled(true);
+  renderer.setGradientLutCacheBudgetBytes(0);
+  renderer.draw(document);
+  renderer.draw(document);
+  const GradientLutCacheStats stats = renderer.gradientLutCacheStats();
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.liveBytes, 0u);
+  EXPECT_TRUE(BitmapsClose(renderFresh(document), renderer.takeSnapshot()));
+}
+
+}  // namespace donner::svg
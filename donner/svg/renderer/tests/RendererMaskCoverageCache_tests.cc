@@ -0,0 +1,199 @@
+/// @file
+/// Behavior of the tiny-skia backend's mask coverage cache.
+///
+/// As with retained filter outputs, two properties are asserted directly: every cached frame is
+/// byte-identical to what a renderer without the cache produces, and coverage is only shared
+/// while nothing it depended on differs, which the counters make observable.
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string_view>
+
+#include "donner/svg/parser/SVGParser.h"
+#include "donner/svg/renderer/RendererTinySkia.h"
+#include "donner/svg/tests/ParserTestUtils.h"
+
+namespace donner::svg {
+namespace {
+
+SVGDocument parseDocument(std::string_view svg) {
+  ParseWarningSink warningSink;
+  auto parsed = parser::SVGParser::ParseSVG(svg, warningSink);
+  EXPECT_FALSE(parsed.hasError()) << parsed.error();
+  return std::move(parsed).result();
+}
+
+/// Wraps a fragment in a fixed-size document.
+SVGDocument parseFragment(std::string_view fragment, int width = 96, int height = 96) {
+  std::ostringstream svg;
+  svg << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << width << "\" height=\""
+      << height << "\">" << fragment << "</svg>";
+  return parseDocument(svg.str());
+}
+
+::testing::AssertionResult BitmapsEqual(const RendererBitmap& lhs, const RendererBitmap& rhs) {
+  if (lhs.dimensions != rhs.dimensions || lhs.pixels.size() != rhs.pixels.size()) {
+    return ::testing::AssertionFailure()
+           << "dimensions differ: " << lhs.dimensions << " vs " << rhs.dimensions;
+  }
+
+  for (std::size_t i = 0; i < lhs.pixels.size(); ++i) {
+    if (lhs.pixels[i] != rhs.pixels[i]) {
+      const std::size_t pixel = i / 4;
+      const int x = static_cast<int>(pixel % static_cast<std::size_t>(lhs.dimensions.x));
+      const int y = static_cast<int>(pixel / static_cast<std::size_t>(lhs.dimensions.x));
+      return ::testing::AssertionFailure()
+             << "first difference at pixel (" << x << ", " << y << ") channel " << (i % 4) << ": "
+             << static_cast<int>(lhs.pixels[i]) << " vs " << static_cast<int>(rhs.pixels[i]);
+    }
+  }
+  return ::testing::AssertionSuccess();
+}
+
+RendererBitmap renderFresh(SVGDocument& document) {
+  RendererTinySkia renderer;
+  renderer.draw(document);
+  return renderer.takeSnapshot();
+}
+
+/// One user-space mask and one clip path, each applied to three elements drawn in the same
+/// coordinate system, so every user after the first can share the first one's coverage.
+constexpr std::string_view kSharedScene = R"svg(
+    <defs>
+      <mask id="m" maskUnits="userSpaceOnUse" x="0" y="0" width="96" height="96">
+        <rect id="mr" x="8" y="8" width="80" height="80" rx="12" fill="white"/>
+        <circle cx="48" cy="48" r="20" fill="#808080"/>
+      </mask>
+      <clipPath id="c"><circle cx="48" cy="48" r="40"/></clipPath>
+    </defs>
+    <rect x="0" y="0" width="96" height="96" fill="#f0f0e0"/>
+    <rect x="0" y="0" width="44" height="44" fill="#c02020" mask="url(#m)"/>
+    <rect x="52" y="0" width="44" height="44" fill="#20a040" mask="url(#m)"/>
+    <rect x="0" y="52" width="44" height="44" fill="#2040c0" mask="url(#m)"/>
+    <rect x="52" y="52" width="44" height="44" fill="#c0a020" clip-path="url(#c)"/>
+    <path d="M 0 96 L 96 0" stroke="#000000" stroke-width="3" clip-path="url(#c)"/>
+    <ellipse cx="48" cy="20" rx="30" ry="10" fill="#8020a0" clip-path="url(#c)"/>
+  )svg";
+
+}  // namespace
+
+TEST(RendererMaskCoverageCache, UsersShareCoverageWithinAndAcrossFrames) {
+  SVGDocument document = parseFragment(kSharedScene);
+  const RendererBitmap fresh = renderFresh(document);
+
+  RendererTinySkia renderer;
+  renderer.setMaskCoverageCacheEnabled(true);
+  renderer.draw(document);
+  MaskCoverageCacheStats stats = renderer.maskCoverageCacheStats();
+  EXPECT_EQ(stats.maskMisses, 1u);
+  EXPECT_EQ(stats.maskHits, 2u);
+  EXPECT_EQ(stats.clipMisses, 1u);
+  EXPECT_EQ(stats.clipHits, 2u);
+  EXPECT_GT(stats.liveBytes, 0u);
+  EXPECT_TRUE(BitmapsEqual(fresh, renderer.takeSnapshot()));
+
+  renderer.draw(document);
+  stats = renderer.maskCoverageCacheStats();
+  EXPECT_EQ(stats.maskMisses, 0u);
+  EXPECT_EQ(stats.maskHits, 3u);
+  EXPECT_EQ(stats.clipMisses, 0u);
+  EXPECT_EQ(stats.clipHits, 3u);
+  EXPECT_TRUE(BitmapsEqual(fresh, renderer.takeSnapshot()));
+}
+
+TEST(RendererMaskCoverageCache, CacheIsOffByDefault) {
+  SVGDocument document = parseFragment(kSharedScene);
+
+  RendererTinySkia renderer;
+  EXPECT_FALSE(renderer.maskCoverageCacheEnabled());
+  renderer.draw(document);
+  renderer.draw(document);
+  const MaskCoverageCacheStats stats = renderer.maskCoverageCacheStats();
+  EXPECT_EQ(stats.maskHits + stats.maskMisses + stats.clipHits + stats.clipMisses, 0u);
+  EXPECT_EQ(stats.liveBytes, 0u);
+}
+
+TEST(RendererMaskCoverageCache, MaskContentMutationRendersTheMaskAgain) {
+  SVGDocument document = parseFragment(kSharedScene);
+  auto maskRect = document.querySelector("#mr");
+  ASSERT_TRUE(maskRect.has_value());
+
+  RendererTinySkia renderer;
+  renderer.setMaskCoverageCacheEnabled(true);
+  renderer.draw(document);
+  renderer.draw(document);
+  ASSERT_EQ(renderer.maskCoverageCacheStats().maskHits, 3u);
+
+  maskRect->setAttribute("rx", "30");
+  renderer.draw(document);
+  EXPECT_EQ(renderer.maskCoverageCacheStats().maskMisses, 1u);
+  EXPECT_TRUE(BitmapsEqual(renderFresh(document), renderer.takeSnapshot()));
+}
+
+/// `objectBoundingBox` masks resolve against each user's own bounds, so users of different sizes
+/// keep separate entries, each reused on the next frame.
+TEST(RendererMaskCoverageCache, BoundingBoxMasksAreKeyedPerUser) {
+  SVGDocument document = parseFragment(R"svg(
+      <mask id="m" maskContentUnits="objectBoundingBox">
+        <circle cx="0.5" cy="0.5" r="0.4" fill="white"/>
+      </mask>
+      <rect x="4" y="4" width="40" height="30" fill="#c02020" mask="url(#m)"/>
+      <rect x="50" y="50" width="30" height="40" fill="#2040c0" mask="url(#m)"/>)svg");
+  const RendererBitmap fresh = renderFresh(document);
+
+  RendererTinySkia renderer;
+  renderer.setMaskCoverageCacheEnabled(true);
+  renderer.draw(document);
+  EXPECT_EQ(renderer.maskCoverageCacheStats().maskMisses, 2u);
+  EXPECT_EQ(renderer.maskCoverageCacheStats().maskHits, 0u);
+
+  renderer.draw(document);
+  EXPECT_EQ(renderer.maskCoverageCacheStats().maskHits, 2u);
+  EXPECT_TRUE(BitmapsEqual(fresh, renderer.takeSnapshot()));
+}
+
+/// Mask content is drawn under the clip in effect. A clip that cuts into the mask region changes
+/// the coverage, so that mask is rendered rather than shared.
+TEST(RendererMaskCoverageCache, MasksUnderAPartialClipAreNotCached) {
+  SVGDocument document = parseFragment(R"svg(
+      <mask id="m" maskUnits="userSpaceOnUse" x="0" y="0" width="96" height="96">
+        <rect x="8" y="8" width="80" height="80" fill="white"/>
+      </mask>
+      <clipPath id="c"><circle cx="48" cy="48" r="30"/></clipPath>
+      <g clip-path="url(#c)">
+        <rect x="0" y="0" width="96" height="96" fill="#c02020" mask="url(#m)"/>
+      </g>
+      <rect x="0" y="0" width="96" height="96" fill-opacity="0.5" fill="#2040c0"
+            mask="url(#m)"/>)svg");
+  const RendererBitmap fresh = renderFresh(document);
+
+  RendererTinySkia renderer;
+  renderer.setMaskCoverageCacheEnabled(true);
+  renderer.draw(document);
+  renderer.draw(document);
+  const MaskCoverageCacheStats stats = renderer.maskCoverageCacheStats();
+  EXPECT_EQ(stats.bypassedMasks, 1u);
+  EXPECT_EQ(stats.maskHits, 1u);
+  EXPECT_TRUE(BitmapsEqual(fresh, renderer.takeSnapshot()));
+}
+
+TEST(RendererMaskCoverageCache, BudgetBoundsCachedBytes) {
+  SVGDocument document = parseFragment(kSharedScene);
+
+  RendererTinySkia renderer;
+  renderer.setMaskCoverageCacheEnabled(true);
+  renderer.draw(document);
+  const std::size_t settledBytes = renderer.maskCoverageCacheStats().liveBytes;
+  ASSERT_GT(settledBytes, 0u);
+
+  RendererTinySkia bounded;
+  bounded.setMaskCoverageCacheEnabled(true);
+  bounded.setMaskCoverageCacheBudgetBytes(settledBytes / 4);
+  bounded.draw(document);
+  bounded.draw(document);
+  EXPECT_LE(bounded.maskCoverageCacheStats().liveBytes, settledBytes / 4);
+  EXPECT_TRUE(BitmapsEqual(renderFresh(document), bounded.takeSnapshot()));
+}
+
+}  // namespace donner::svg
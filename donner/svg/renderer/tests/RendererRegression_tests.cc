@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <string>
 #include <string_view>
 
 #include "donner/base/tests/Runfiles.h"
@@ -30,6 +31,15 @@ constexpr std::string_view kBlueImageDataUri =
     "iVBORw0KGgoAAAANSUhEUgAAAAIAAAACCAIAAAD91JpzAAAAD0lEQVR4nGNgYPgPRmAKABf2A/1+6zfzAAAAAElFTkSu"
     "QmCC";
 
+/// A 128x128 one-pixel black and white checkerboard PNG as a data URI. @see kRedImageDataUri
+constexpr std::string_view kCheckerboardImageDataUri =
+    "data:image/png;base64,"
+    "iVBORw0KGgoAAAANSUhEUgAAAIAAAACACAYAAADDPmHLAAABFElEQVR42u3UsQ0AMAzDMP3/dIJ+USD0ot0Dq+ZNj9YJ"
+    "t5sTCOAEAjiDAEoAJYASQAmgBFACKAGUAEoAJYASQAmgBFACKAGUAEoAJYASQAmgBFACKAGUAEoAJYASQAmgBFACKAGU"
+    "AEoAJYASQAmgBFACKAGUAEoAJYASQAmgBFACKAGUAEoAJYASQAmgBFACKAGUAEoAJYASQAmgBFACKAGUAEoAJYASQAmg"
+    "BFACKAGUAEoAJYASQAmgBFACKAGUAEoAJQABnEAAJxDAGQRQAigBlABKACWAEkAJoARQAigBlABKACWAEkAJoARQAigB"
+    "lABKACWAEkAJoARQAigBlABKACWAEkAJoARQAigBlABKAP2mCxmZaVLyHOceAAAAAElFTkSuQmCC";
+
 ImageComparisonParams GoldenParams() {
   Params params;
   params.enableGoldenUpdateFromEnv();
@@ -216,5 +226,27 @@ TEST_F(RendererRegressionTests, ImageHrefChangeInvalidatesTinySkiaPremultipliedI
   ExpectBitmapsIdentical(afterMutation, fresh, "tiny_skia_image_cache_invalidation");
 }
 
+// Smooth images drawn below half scale sample a mip level instead of the full-resolution source.
+// A one-pixel checkerboard at 1/4 scale (level 2) and 3/8 scale (level 1) comes out a flat mid
+// grey; sampling the source instead leaves a moire of whole black and white pixels in the 1/4
+// scale copy. None of the resvg image tests minify that far, so this is the golden that moves if
+// level selection changes. Geode has no mip chain.
+TEST_F(RendererRegressionTests, MinifiedSmoothImageSamplesMipLevel) {
+  const std::string markup =
+      std::string(R"(<rect width="160" height="64" fill="#4080c0" />)"
+                  R"(<image id="checker" x="8" y="16" width="32" height="32" href=")") +
+      std::string(kCheckerboardImageDataUri) +
+      R"svg(" />)svg"
+      R"svg(<use href="#checker" transform="translate(40 -8) scale(1.5)" />)svg"
+      R"svg(<use href="#checker" x="112" style="image-rendering: pixelated" />)svg";
+  SVGDocument document = instantiateSubtree(markup, {}, Vector2i(160, 64));
+
+  Params params = Params::WithThreshold(0.02f, 0).disableBackend(
+      RendererBackend::Geode, "Mip sampling of minified images is tiny-skia only");
+  params.enableGoldenUpdateFromEnv();
+  renderAndCompare(document, "minified_smooth_image",
+                   "donner/svg/renderer/testdata/golden/image_minified_smooth.png", params);
+}
+
 }  // namespace
 }  // namespace donner::svg
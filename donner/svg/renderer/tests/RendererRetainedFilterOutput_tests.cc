@@ -0,0 +1,273 @@
+/// @file
+/// Behavior of the tiny-skia backend's retained filter outputs.
+///
+/// As with retained rasterization, two properties are asserted directly: every retained frame is
+/// byte-identical to what a renderer that never retained anything produces, and an output is only
+/// reused while nothing it depended on changed, which the counters make observable.
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+#include "donner/svg/parser/SVGParser.h"
+#include "donner/svg/renderer/RendererTinySkia.h"
+#include "donner/svg/tests/ParserTestUtils.h"
+
+namespace donner::svg {
+namespace {
+
+SVGDocument parseDocument(std::string_view svg) {
+  ParseWarningSink warningSink;
+  auto parsed = parser::SVGParser::ParseSVG(svg, warningSink);
+  EXPECT_FALSE(parsed.hasError()) << parsed.error();
+  return std::move(parsed).result();
+}
+
+/// Wraps a fragment in a fixed-size document.
+SVGDocument parseFragment(std::string_view fragment, int width = 96, int height = 96) {
+  std::ostringstream svg;
+  svg << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << width << "\" height=\""
+      << height << "\">" << fragment << "</svg>";
+  return parseDocument(svg.str());
+}
+
+::testing::AssertionResult BitmapsEqual(const RendererBitmap& lhs, const RendererBitmap& rhs) {
+  if (lhs.dimensions != rhs.dimensions || lhs.pixels.size() != rhs.pixels.size()) {
+    return ::testing::AssertionFailure()
+           << "dimensions differ: " << lhs.dimensions << " vs " << rhs.dimensions;
+  }
+
+  for (std::size_t i = 0; i < lhs.pixels.size(); ++i) {
+    if (lhs.pixels[i] != rhs.pixels[i]) {
+      const std::size_t pixel = i / 4;
+      const int x = static_cast<int>(pixel % static_cast<std::size_t>(lhs.dimensions.x));
+      const int y = static_cast<int>(pixel / static_cast<std::size_t>(lhs.dimensions.x));
+      return ::testing::AssertionFailure()
+             << "first difference at pixel (" << x << ", " << y << ") channel " << (i % 4) << ": "
+             << static_cast<int>(lhs.pixels[i]) << " vs " << static_cast<int>(rhs.pixels[i]);
+    }
+  }
+  return ::testing::AssertionSuccess();
+}
+
+RendererBitmap renderFresh(SVGDocument& document) {
+  RendererTinySkia renderer;
+  renderer.draw(document);
+  return renderer.takeSnapshot();
+}
+
+/// A blurred group with a clipped sibling layer and content after it, so a reused layer has to
+/// leave everything drawn around it untouched.
+constexpr std::string_view kFilteredScene = R"svg(
+    <defs>
+      <filter id="blur"><feGaussianBlur stdDeviation="3"/></filter>
+      <filter id="shadow"><feOffset dx="4" dy="4"/><feGaussianBlur stdDeviation="2"/></filter>
+      <clipPath id="c"><rect x="0" y="48" width="96" height="48"/></clipPath>
+    </defs>
+    <rect x="0" y="0" width="96" height="96" fill="#f0f0e0"/>
+    <g id="g" filter="url(#blur)">
+      <rect id="r" x="10" y="10" width="40" height="30" fill="#c02020"/>
+      <circle cx="60" cy="30" r="14" fill="#2040c0"/>
+    </g>
+    <rect x="20" y="50" width="50" height="30" fill="#20a040" filter="url(#shadow)"
+          clip-path="url(#c)"/>
+    <path d="M 5 90 L 90 60" stroke="#000000" stroke-width="2"/>
+  )svg";
+
+}  // namespace
+
+TEST(RendererRetainedFilterOutput, UnchangedFrameReusesFilteredLayers) {
+  SVGDocument document = parseFragment(kFilteredScene);
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  renderer.draw(document);
+  EXPECT_EQ(renderer.retainedFilterOutputStats().renderedLayers, 2u);
+  EXPECT_EQ(renderer.retainedFilterOutputStats().reusedLayers, 0u);
+
+  renderer.draw(document);
+  const RetainedFilterOutputStats stats = renderer.retainedFilterOutputStats();
+  EXPECT_EQ(stats.reusedLayers, 2u);
+  EXPECT_EQ(stats.renderedLayers, 0u);
+  EXPECT_GT(stats.liveBytes, 0u);
+  EXPECT_TRUE(BitmapsEqual(renderFresh(document), renderer.takeSnapshot()));
+}
+
+TEST(RendererRetainedFilterOutput, RetentionIsOffByDefault) {
+  SVGDocument document = parseFragment(kFilteredScene);
+
+  RendererTinySkia renderer;
+  EXPECT_FALSE(renderer.retainedFilterOutputsEnabled());
+  renderer.draw(document);
+  renderer.draw(document);
+  EXPECT_EQ(renderer.retainedFilterOutputStats().reusedLayers, 0u);
+  EXPECT_EQ(renderer.retainedFilterOutputStats().renderedLayers, 0u);
+}
+
+TEST(RendererRetainedFilterOutput, FramesAreByteIdenticalToFreshRendering) {
+  SVGDocument document = parseFragment(kFilteredScene);
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  const RendererBitmap fresh = renderFresh(document);
+  for (int i = 0; i < 3; ++i) {
+    renderer.draw(document);
+    EXPECT_TRUE(BitmapsEqual(fresh, renderer.takeSnapshot())) << "frame " << i;
+  }
+}
+
+TEST(RendererRetainedFilterOutput, SubtreeMutationRendersTheLayerAgain) {
+  SVGDocument document = parseFragment(kFilteredScene);
+  auto rect = document.querySelector("#r");
+  ASSERT_TRUE(rect.has_value());
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  renderer.draw(document);
+  renderer.draw(document);
+  ASSERT_EQ(renderer.retainedFilterOutputStats().reusedLayers, 2u);
+
+  rect->setAttribute("fill", "#00ff00");
+  renderer.draw(document);
+  const RetainedFilterOutputStats stats = renderer.retainedFilterOutputStats();
+  EXPECT_EQ(stats.reusedLayers, 0u);
+  EXPECT_GT(stats.invalidatedLayers, 0u);
+  EXPECT_TRUE(BitmapsEqual(renderFresh(document), renderer.takeSnapshot()));
+}
+
+TEST(RendererRetainedFilterOutput, FilterPrimitiveMutationRendersTheLayerAgain) {
+  SVGDocument document = parseFragment(R"svg(
+      <filter id="f"><feGaussianBlur id="b" stdDeviation="2"/></filter>
+      <rect x="20" y="20" width="50" height="50" fill="#804020" filter="url(#f)"/>)svg");
+  auto blur = document.querySelector("#b");
+  ASSERT_TRUE(blur.has_value());
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  renderer.draw(document);
+  renderer.draw(document);
+  ASSERT_EQ(renderer.retainedFilterOutputStats().reusedLayers, 1u);
+
+  blur->setAttribute("stdDeviation", "6");
+  renderer.draw(document);
+  EXPECT_EQ(renderer.retainedFilterOutputStats().reusedLayers, 0u);
+  EXPECT_TRUE(BitmapsEqual(renderFresh(document), renderer.takeSnapshot()));
+}
+
+TEST(RendererRetainedFilterOutput, CanvasResizeRendersTheLayerAgain) {
+  SVGDocument document = parseFragment(kFilteredScene);
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  renderer.draw(document);
+  renderer.draw(document);
+  ASSERT_GT(renderer.retainedFilterOutputStats().reusedLayers, 0u);
+
+  document.setCanvasSize(140, 140);
+  renderer.draw(document);
+  const RendererBitmap resized = renderer.takeSnapshot();
+  EXPECT_EQ(renderer.retainedFilterOutputStats().reusedLayers, 0u);
+  EXPECT_EQ(resized.dimensions, Vector2i(140, 140));
+  EXPECT_TRUE(BitmapsEqual(renderFresh(document), resized));
+}
+
+/// An output filtered at one precision must not stand in for the other.
+TEST(RendererRetainedFilterOutput, FilterPrecisionChangeRendersTheLayerAgain) {
+  SVGDocument document = parseFragment(kFilteredScene);
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  renderer.draw(document);
+  renderer.draw(document);
+  ASSERT_EQ(renderer.retainedFilterOutputStats().reusedLayers, 2u);
+
+  renderer.setFilterPrecision(FilterPrecision::Uint8);
+  renderer.draw(document);
+  EXPECT_EQ(renderer.retainedFilterOutputStats().reusedLayers, 0u);
+
+  RendererTinySkia reduced;
+  reduced.setFilterPrecision(FilterPrecision::Uint8);
+  reduced.draw(document);
+  EXPECT_TRUE(BitmapsEqual(reduced.takeSnapshot(), renderer.takeSnapshot()));
+}
+
+/// A filtered element inside another layer renders into a surface rebuilt every frame, so it is
+/// never retained, and the layers around it must not be skipped either.
+TEST(RendererRetainedFilterOutput, NestedLayersAreNotRetained) {
+  SVGDocument document = parseFragment(R"svg(
+      <filter id="f"><feGaussianBlur stdDeviation="2"/></filter>
+      <g opacity="0.5">
+        <rect x="20" y="20" width="50" height="50" fill="#804020" filter="url(#f)"/>
+      </g>)svg");
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  renderer.draw(document);
+  renderer.draw(document);
+  const RetainedFilterOutputStats stats = renderer.retainedFilterOutputStats();
+  EXPECT_EQ(stats.reusedLayers, 0u);
+  EXPECT_EQ(stats.bypassedLayers, 1u);
+  EXPECT_TRUE(BitmapsEqual(renderFresh(document), renderer.takeSnapshot()));
+}
+
+/// Skipping a reused layer's subtree has to skip the pattern content instantiated after the
+/// element too; drawing it as ordinary content would paint the tile onto the frame.
+TEST(RendererRetainedFilterOutput, ReusedLayerSkipsTrailingPatternContent) {
+  SVGDocument document = parseFragment(R"svg(
+      <defs>
+        <filter id="f"><feGaussianBlur stdDeviation="1"/></filter>
+        <pattern id="p" width="8" height="8" patternUnits="userSpaceOnUse">
+          <rect width="4" height="4" fill="#2020c0"/>
+        </pattern>
+      </defs>
+      <g filter="url(#f)">
+        <rect x="10" y="10" width="60" height="60" fill="url(#p)"/>
+      </g>
+      <rect x="70" y="70" width="20" height="20" fill="#c02020"/>)svg");
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  const RendererBitmap fresh = renderFresh(document);
+  renderer.draw(document);
+  renderer.draw(document);
+  EXPECT_EQ(renderer.retainedFilterOutputStats().reusedLayers, 1u);
+  EXPECT_TRUE(BitmapsEqual(fresh, renderer.takeSnapshot()));
+}
+
+TEST(RendererRetainedFilterOutput, BudgetTooSmallDisablesRetention) {
+  SVGDocument document = parseFragment(kFilteredScene);
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  renderer.draw(document);
+  const std::size_t settledBytes = renderer.retainedFilterOutputStats().liveBytes;
+  ASSERT_GT(settledBytes, 0u);
+
+  RendererTinySkia bounded;
+  bounded.setRetainedFilterOutputsEnabled(true);
+  bounded.setRetainedFilterOutputBudgetBytes(settledBytes / 4);
+  bounded.draw(document);
+  bounded.draw(document);
+  const RetainedFilterOutputStats stats = bounded.retainedFilterOutputStats();
+  EXPECT_TRUE(stats.documentDisabled);
+  EXPECT_EQ(stats.reusedLayers, 0u);
+  EXPECT_LE(stats.liveBytes, settledBytes / 4);
+  EXPECT_TRUE(BitmapsEqual(renderFresh(document), bounded.takeSnapshot()));
+}
+
+TEST(RendererRetainedFilterOutput, TurningRetentionOffHandsBackWhatTheDocumentHeld) {
+  SVGDocument document = parseFragment(kFilteredScene);
+
+  RendererTinySkia renderer;
+  renderer.setRetainedFilterOutputsEnabled(true);
+  renderer.draw(document);
+  ASSERT_FALSE(document.registry().view<RetainedFilterOutputComponent>().empty());
+
+  renderer.setRetainedFilterOutputsEnabled(false);
+  renderer.draw(document);
+  EXPECT_TRUE(document.registry().view<RetainedFilterOutputComponent>().empty());
+}
+
+}  // namespace donner::svg
@@ -1,12 +1,14 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <future>
 #include <optional>
 #include <vector>
 
+#include "donner/base/WorkerPool.h"
 #include "donner/svg/SVGRectElement.h"
 #include "donner/svg/SVGSVGElement.h"
 #include "donner/svg/components/paint/GradientComponent.h"
@@ -14,6 +16,7 @@
 #include "donner/svg/parser/SVGParser.h"
 #include "donner/svg/properties/PaintServer.h"
 #include "donner/svg/renderer/RendererDriver.h"
+#include "donner/svg/renderer/RendererTinySkia.h"
 #include "donner/svg/renderer/tests/MockRendererInterface.h"
 #include "donner/svg/tests/ParserTestUtils.h"
 
@@ -408,5 +411,199 @@ TEST(RendererSnapshotTests, TextPaintReferencesAreSnapshotOwned) {
 }
 #endif
 
+TEST(RendererSnapshotTests, TiledReplayMatchesSingleThreadedReplay) {
+  SVGDocument document = MakeDocument(R"svg(
+    <defs>
+      <linearGradient id="g">
+        <stop offset="0" stop-color="red" />
+        <stop offset="1" />
+      </linearGradient>
+      <clipPath id="c"><circle cx="100" cy="100" r="70" /></clipPath>
+      <mask id="m"><rect x="20" y="20" width="150" height="150" fill="white" opacity="0.6" /></mask>
+      <filter id="f"><feGaussianBlur stdDeviation="3" /></filter>
+      <pattern id="p" width="9" height="9" patternUnits="userSpaceOnUse">
+        <circle cx="4" cy="4" r="3" fill="navy" />
+      </pattern>
+    </defs>
+    <rect x="3.5" y="7.25" width="190" height="40" fill="url(#g)" />
+    <path d="M 10 190 L 60 60 L 110 190" fill="none" stroke="green" stroke-width="9"
+          stroke-miterlimit="10" />
+    <g opacity="0.5" style="mix-blend-mode: multiply">
+      <circle cx="120" cy="90" r="47" fill="orange" stroke="black" stroke-width="3" />
+    </g>
+    <g clip-path="url(#c)"><rect width="200" height="200" fill="url(#p)" /></g>
+    <rect x="60" y="30" width="80" height="80" fill="purple" mask="url(#m)" />
+    <ellipse cx="150" cy="160" rx="30" ry="12" fill="teal" filter="url(#f)" />
+    <line x1="0" y1="199" x2="199" y2="0" stroke="black" stroke-linecap="square" />
+  )svg",
+                                      Vector2i(200, 200));
+
+  RendererTinySkia offscreen;
+  RendererDriver driver(offscreen);
+  RenderSnapshot snapshot = driver.captureRenderSnapshot(document);
+
+  RendererTinySkia single;
+  snapshot.replay(single);
+  const RendererBitmap expected = single.takeSnapshot();
+  ASSERT_FALSE(expected.empty());
+
+  for (const TiledReplayOptions& options :
+       {TiledReplayOptions{.tileSize = 16, .threadCount = 4},
+        TiledReplayOptions{.tileSize = 64, .threadCount = 3},
+        TiledReplayOptions{.tileSize = 7, .threadCount = 8}}) {
+    const RendererBitmap tiled =
+        snapshot.replayTiled([] { return std::make_unique<RendererTinySkia>(); }, options);
+    EXPECT_EQ(tiled.dimensions, expected.dimensions);
+    EXPECT_EQ(tiled.pixels, expected.pixels)
+        << "tileSize=" << options.tileSize << " threadCount=" << options.threadCount;
+  }
+}
+
+/// Replays \p snapshot once on a single thread and returns the frame.
+RendererBitmap ReplaySingle(const RenderSnapshot& snapshot) {
+  RendererTinySkia renderer;
+  snapshot.replay(renderer);
+  return renderer.takeSnapshot();
+}
+
+/// Replays \p snapshot tile-parallel with tiny-skia workers and returns the stitched frame.
+RendererBitmap ReplayTiled(const RenderSnapshot& snapshot, const TiledReplayOptions& options) {
+  return snapshot.replayTiled([] { return std::make_unique<RendererTinySkia>(); }, options);
+}
+
+TEST(RendererSnapshotTests, TiledReplayOnTileSurfacesMatchesStraightEdgedContent) {
+  SVGDocument document = MakeDocument(R"svg(
+    <defs>
+      <linearGradient id="g" x1="0" x2="1" y1="0" y2="0.3">
+        <stop offset="0" stop-color="gold" />
+        <stop offset="1" stop-color="blue" stop-opacity="0.4" />
+      </linearGradient>
+      <clipPath id="c"><rect x="30.5" y="20.25" width="120.5" height="100.75" /></clipPath>
+      <mask id="m"><rect x="30" y="100" width="90.5" height="60.5" fill="white" opacity="0.7" /></mask>
+    </defs>
+    <rect x="1.3" y="2.7" width="197.1" height="63.4" fill="url(#g)" />
+    <g clip-path="url(#c)"><rect width="200" height="200" fill="crimson" fill-opacity="0.5" /></g>
+    <rect x="20.5" y="90.25" width="90" height="90" fill="seagreen" mask="url(#m)" />
+    <g opacity="0.6" style="mix-blend-mode: screen">
+      <rect x="90.2" y="110.7" width="100.3" height="81.9" fill="orchid" />
+    </g>
+    <rect x="5.5" y="150.5" width="60" height="40" fill="none" stroke="navy" stroke-width="3.5" />
+  )svg",
+                                      Vector2i(200, 200));
+
+  RendererTinySkia offscreen;
+  RendererDriver driver(offscreen);
+  RenderSnapshot snapshot = driver.captureRenderSnapshot(document);
+  const RendererBitmap expected = ReplaySingle(snapshot);
+  ASSERT_FALSE(expected.empty());
+
+  // Straight edges clipped at a tile boundary keep their coverage, so tile-sized surfaces are
+  // exact here, including tile sizes that do not divide the frame.
+  for (const TiledReplayOptions& options :
+       {TiledReplayOptions{.tileSize = 32, .threadCount = 4},
+        TiledReplayOptions{.tileSize = 64, .threadCount = 2},
+        TiledReplayOptions{.tileSize = 13, .threadCount = 3}}) {
+    const RendererBitmap tiled = ReplayTiled(snapshot, options);
+    EXPECT_EQ(tiled.dimensions, expected.dimensions);
+    EXPECT_EQ(tiled.pixels, expected.pixels)
+        << "tileSize=" << options.tileSize << " threadCount=" << options.threadCount;
+  }
+}
+
+TEST(RendererSnapshotTests, TiledReplayMatchesSingleReplayAlongCurves) {
+  SVGDocument document = MakeDocument(R"svg(
+    <defs>
+      <clipPath id="c"><circle cx="110" cy="70" r="61.3" /></clipPath>
+    </defs>
+    <g transform="translate(0.37 0.61) rotate(11 100 100)">
+      <path d="M 12.2 180.4 C 40 20 150 210 190.5 15.3" fill="none" stroke="black"
+            stroke-width="6.5" stroke-linejoin="round" />
+    </g>
+    <g clip-path="url(#c)"><rect width="200" height="200" fill="crimson" /></g>
+    <ellipse cx="140.2" cy="150.7" rx="50.3" ry="31.9" fill="orchid" />
+  )svg",
+                                      Vector2i(200, 200));
+
+  RendererTinySkia offscreen;
+  RendererDriver driver(offscreen);
+  RenderSnapshot snapshot = driver.captureRenderSnapshot(document);
+  const RendererBitmap expected = ReplaySingle(snapshot);
+  ASSERT_FALSE(expected.empty());
+
+  // Tile surfaces are grown to hold every curve a tile draws, so no curve is clipped at a tile
+  // edge and stepped from the clip point.
+  for (const TiledReplayOptions& options :
+       {TiledReplayOptions{.tileSize = 32, .threadCount = 4},
+        TiledReplayOptions{.tileSize = 17, .threadCount = 3}}) {
+    const RendererBitmap tiled = ReplayTiled(snapshot, options);
+    EXPECT_EQ(tiled.dimensions, expected.dimensions);
+    EXPECT_EQ(tiled.pixels, expected.pixels)
+        << "tileSize=" << options.tileSize << " threadCount=" << options.threadCount;
+  }
+}
+
+TEST(RendererSnapshotTests, TiledReplaySkipsDrawsOutsideATile) {
+  SVGDocument document = MakeDocument(R"svg(
+    <rect x="2" y="2" width="4" height="4" fill="red" />
+    <rect x="34" y="2" width="4" height="4" fill="blue" />
+  )svg",
+                                      Vector2i(40, 8));
+
+  ::testing::NiceMock<MockRendererInterface> recorder;
+  RendererDriver driver(recorder);
+  RenderSnapshot snapshot = driver.captureRenderSnapshot(document);
+
+  // Two 20px tiles side by side: each is begun at the tile's size and draws only its own rect,
+  // whichever worker renders it.
+  std::atomic<int> frames = 0;
+  std::atomic<int> draws = 0;
+  const RendererBitmap bitmap = snapshot.replayTiled(
+      [&]() {
+        auto renderer = std::make_unique<::testing::NiceMock<MockRendererInterface>>();
+        EXPECT_CALL(*renderer, beginFrame(_)).WillRepeatedly([&](const RenderViewport& viewport) {
+          EXPECT_EQ(viewport.size, Vector2d(20, 8));
+          ++frames;
+        });
+        EXPECT_CALL(*renderer, drawPath(_, _)).WillRepeatedly([&] { ++draws; });
+        return renderer;
+      },
+      TiledReplayOptions{.tileSize = 20, .threadCount = 2});
+
+  EXPECT_EQ(frames, 2);
+  EXPECT_EQ(draws, 2);
+  EXPECT_TRUE(bitmap.empty());
+}
+
+TEST(RendererSnapshotTests, TiledReplayReusesTheCallersWorkerPool) {
+  SVGDocument document = MakeDocument(R"svg(
+    <rect x="2" y="2" width="4" height="4" fill="red" />
+    <rect x="34" y="2" width="4" height="4" fill="blue" />
+  )svg",
+                                      Vector2i(40, 8));
+
+  ::testing::NiceMock<MockRendererInterface> recorder;
+  RendererDriver driver(recorder);
+  RenderSnapshot snapshot = driver.captureRenderSnapshot(document);
+
+  // The pool's threads are reused by every call. With no thread count all of them are used, and a
+  // larger thread count is capped at the pool's size.
+  WorkerPool pool(2);
+  for (const std::size_t threadCount : {std::size_t(0), std::size_t(8)}) {
+    std::atomic<int> renderers = 0;
+    std::atomic<int> draws = 0;
+    static_cast<void>(snapshot.replayTiled(
+        [&]() {
+          ++renderers;
+          auto renderer = std::make_unique<::testing::NiceMock<MockRendererInterface>>();
+          EXPECT_CALL(*renderer, drawPath(_, _)).WillRepeatedly([&] { ++draws; });
+          return renderer;
+        },
+        TiledReplayOptions{.tileSize = 20, .threadCount = threadCount, .workerPool = &pool}));
+
+    EXPECT_EQ(renderers, 2) << "threadCount=" << threadCount;
+    EXPECT_EQ(draws, 2) << "threadCount=" << threadCount;
+  }
+}
+
 }  // namespace
 }  // namespace donner::svg
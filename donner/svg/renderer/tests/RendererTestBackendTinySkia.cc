@@ -40,6 +40,20 @@ RetainedMode RequestedRetainedMode() {
   return mode;
 }
 
+/// Filter precision the environment asked the corpus to run at.
+///
+/// `DONNER_TINYSKIA_FILTER_PRECISION=uint8` runs every filter graph the reduced-precision
+/// executor covers at 8 bits per channel, so the resvg filter goldens measure what the mode costs
+/// in conformance. Anything else, including unset, keeps the default float precision.
+FilterPrecision RequestedFilterPrecision() {
+  static const FilterPrecision precision = [] {
+    const char* value = std::getenv("DONNER_TINYSKIA_FILTER_PRECISION");
+    return value != nullptr && std::string_view(value) == "uint8" ? FilterPrecision::Uint8
+                                                                   : FilterPrecision::Float;
+  }();
+  return precision;
+}
+
 /// Reports the first differing byte, so a corpus-wide failure names a pixel instead of a file.
 void ExpectBitmapsEqual(const RendererBitmap& fresh, const RendererBitmap& retained) {
   ASSERT_EQ(fresh.dimensions, retained.dimensions);
@@ -60,6 +74,7 @@ void ExpectBitmapsEqual(const RendererBitmap& fresh, const RendererBitmap& retai
 
 /// Draws `document` and returns the frame the current mode is meant to check.
 RendererBitmap RenderSettled(RendererTinySkia& renderer, SVGDocument& document) {
+  renderer.setFilterPrecision(RequestedFilterPrecision());
   const RetainedMode mode = RequestedRetainedMode();
   if (mode == RetainedMode::Off) {
     renderer.draw(document);
@@ -70,6 +85,7 @@ RendererBitmap RenderSettled(RendererTinySkia& renderer, SVGDocument& document)
   if (mode == RetainedMode::Compare) {
     RendererTinySkia freshRenderer;
     freshRenderer.setAntialias(renderer.antialias());
+    freshRenderer.setFilterPrecision(renderer.filterPrecision());
     freshRenderer.draw(document);
     fresh = freshRenderer.takeSnapshot();
   }
@@ -111,6 +127,7 @@ bool TinySkiaSupportsFeature(RendererBackendFeature feature) {
 std::unique_ptr<RendererInterface> TinySkiaCreateInstance(bool verbose) {
   auto renderer = std::make_unique<RendererTinySkia>(verbose);
   renderer->setRetainedSpansEnabled(RequestedRetainedMode() != RetainedMode::Off);
+  renderer->setFilterPrecision(RequestedFilterPrecision());
   return renderer;
 }
 
@@ -88,5 +88,33 @@ TEST(RendererTinySkiaPerfTests, MutatedPathReconvertsOnceThenSettlesAgain) {
       << "the frame after a mutation should settle back to zero conversions";
 }
 
+// Identical outlines share one conversion through their interned geometry, whether they come
+// from the same document or from two documents alive at once.
+TEST(RendererTinySkiaPerfTests, IdenticalOutlinesShareOneConversion) {
+  constexpr std::string_view kTwins = R"svg(
+      <path d="M 1.25 1 L 7 1 L 4 6.5 Z" fill="black"/>
+      <path d="M 1.25 1 L 7 1 L 4 6.5 Z" fill="red" transform="translate(8 8)"/>
+    )svg";
+
+  SVGDocument document = instantiateSubtree(kTwins, {}, Vector2i(16, 16));
+  RendererTinySkia renderer;
+  renderer.draw(document);
+  EXPECT_EQ(renderer.frameCounters().pathConversions, 1u);
+  EXPECT_EQ(renderer.frameCounters().sharedPathHits, 1u);
+
+  SVGDocument twin = instantiateSubtree(kTwins, {}, Vector2i(16, 16));
+  RendererTinySkia twinRenderer;
+  twinRenderer.draw(twin);
+  EXPECT_EQ(twinRenderer.frameCounters().pathConversions, 0u)
+      << "an outline already converted for another live document should be shared";
+  EXPECT_EQ(twinRenderer.frameCounters().sharedPathHits, 2u);
+  EXPECT_EQ(twinRenderer.takeSnapshot().pixels, renderer.takeSnapshot().pixels);
+
+  // Settled frames are served from the per-entity cache without touching the shared one.
+  twinRenderer.draw(twin);
+  EXPECT_EQ(twinRenderer.frameCounters().pathConversions, 0u);
+  EXPECT_EQ(twinRenderer.frameCounters().sharedPathHits, 0u);
+}
+
 }  // namespace
 }  // namespace donner::svg
@@ -725,17 +725,20 @@ TEST(TextEngineTest, CachedGeometryApisFilterToRequestedSubtree) {
   components::ComputedTextGeometryComponent cache;
   cache.glyphs.push_back(components::ComputedTextGeometryComponent::GlyphGeometry{
       .sourceEntity = root,
-      .path = PathBuilder().addRect(Box2d::FromXYWH(0.0, 0.0, 5.0, 5.0)).build(),
+      .outline = std::make_shared<const Path>(
+          PathBuilder().addRect(Box2d::FromXYWH(0.0, 0.0, 5.0, 5.0)).build()),
       .extent = Box2d::FromXYWH(0.0, 0.0, 5.0, 5.0),
   });
   cache.glyphs.push_back(components::ComputedTextGeometryComponent::GlyphGeometry{
       .sourceEntity = child,
-      .path = PathBuilder().addRect(Box2d::FromXYWH(10.0, 0.0, 5.0, 5.0)).build(),
+      .outline = std::make_shared<const Path>(
+          PathBuilder().addRect(Box2d::FromXYWH(10.0, 0.0, 5.0, 5.0)).build()),
       .extent = Box2d::FromXYWH(10.0, 0.0, 5.0, 5.0),
   });
   cache.glyphs.push_back(components::ComputedTextGeometryComponent::GlyphGeometry{
       .sourceEntity = outside,
-      .path = PathBuilder().addRect(Box2d::FromXYWH(100.0, 0.0, 5.0, 5.0)).build(),
+      .outline = std::make_shared<const Path>(
+          PathBuilder().addRect(Box2d::FromXYWH(100.0, 0.0, 5.0, 5.0)).build()),
       .extent = Box2d::FromXYWH(100.0, 0.0, 5.0, 5.0),
   });
   cache.characters.push_back(components::ComputedTextGeometryComponent::CharacterGeometry{
@@ -911,6 +914,81 @@ TEST(TextEngineTest, ScriptedRtlChunkYOverrideKeepsVisualGlyphsOnSameBaseline) {
                                                          GlyphYPositionIs(DoubleEq(60.0))))));
 }
 
+TEST(TextEngineTest, LayoutReshapesOnlyChangedSpans) {
+  Registry registry;
+  FontManager fontManager(registry);
+  TextEngine engine = MakeScriptedEngine(registry, fontManager);
+
+  components::ComputedTextComponent text;
+  text.spans.push_back(MakeSpan("Label "));
+  auto tail = MakeSpan("one");
+  tail.startsNewChunk = false;
+  text.spans.push_back(std::move(tail));
+
+  const TextLayoutParams params = MakeTextParams(20.0);
+  std::ignore = engine.layout(text, params);
+  EXPECT_EQ(engine.layoutCacheStats().shapedRunMisses, 2u);
+  EXPECT_EQ(engine.layoutCacheStats().shapedRunHits, 0u);
+
+  text.spans[1] = MakeSpan("two");
+  text.spans[1].startsNewChunk = false;
+  const auto runs = engine.layout(text, params);
+  EXPECT_EQ(engine.layoutCacheStats().shapedRunMisses, 3u);
+  EXPECT_EQ(engine.layoutCacheStats().shapedRunHits, 1u);
+
+  // Reused shaping produces the same layout as a cold engine.
+  TextEngine coldEngine = MakeScriptedEngine(registry, fontManager);
+  const auto coldRuns = coldEngine.layout(text, params);
+  ASSERT_EQ(runs.size(), coldRuns.size());
+  for (size_t i = 0; i < runs.size(); ++i) {
+    ASSERT_EQ(runs[i].glyphs.size(), coldRuns[i].glyphs.size());
+    for (size_t j = 0; j < runs[i].glyphs.size(); ++j) {
+      EXPECT_EQ(runs[i].glyphs[j].glyphIndex, coldRuns[i].glyphs[j].glyphIndex);
+      EXPECT_EQ(runs[i].glyphs[j].xPosition, coldRuns[i].glyphs[j].xPosition);
+      EXPECT_EQ(runs[i].glyphs[j].yPosition, coldRuns[i].glyphs[j].yPosition);
+    }
+  }
+}
+
+TEST(TextEngineTest, RepeatedChunkTextIsShapedOnceWithRebasedClusters) {
+  Registry registry;
+  FontManager fontManager(registry);
+  TextEngine engine = MakeScriptedEngine(registry, fontManager);
+
+  // An absolute x on the third character splits "abab" into two "ab" chunks.
+  components::ComputedTextComponent text;
+  auto span = MakeSpan("abab");
+  span.xList = {Lengthd(0.0, Lengthd::Unit::None), std::nullopt,
+                Lengthd(50.0, Lengthd::Unit::None)};
+  text.spans.push_back(std::move(span));
+
+  const auto runs = engine.layout(text, MakeTextParams(20.0));
+  EXPECT_EQ(engine.layoutCacheStats().shapedRunMisses, 1u);
+  EXPECT_EQ(engine.layoutCacheStats().shapedRunHits, 1u);
+
+  ASSERT_THAT(runs, ElementsAre(RunGlyphsAre(SizeIs(4))));
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(runs[0].glyphs[i].cluster, i);
+  }
+  EXPECT_EQ(runs[0].glyphs[2].glyphIndex, runs[0].glyphs[0].glyphIndex);
+  EXPECT_THAT(runs[0].glyphs[2].xPosition, DoubleEq(50.0));
+}
+
+TEST(TextEngineTest, GlyphOutlinesAreSharedPerGlyphAndSize) {
+  Registry registry;
+  FontManager fontManager(registry);
+  TextEngine engine = MakeScriptedEngine(registry, fontManager);
+  const FontHandle font = fontManager.fallbackFont();
+
+  const std::shared_ptr<const Path> first = engine.sharedGlyphOutline(font, 7, 0.02f);
+  EXPECT_EQ(engine.sharedGlyphOutline(font, 7, 0.02f), first);
+  EXPECT_NE(engine.sharedGlyphOutline(font, 7, 0.04f), first);
+  EXPECT_NE(engine.sharedGlyphOutline(font, 8, 0.02f), first);
+  EXPECT_EQ(engine.layoutCacheStats().outlineHits, 1u);
+  EXPECT_EQ(engine.layoutCacheStats().outlineMisses, 3u);
+  EXPECT_EQ(engine.glyphOutline(font, 7, 0.02f), *first);
+}
+
 TEST(TextEngineTest, UsesCoverageFallbackForArabicText) {
   Registry registry;
   FontManager fontManager(registry);
@@ -0,0 +1,23 @@
+#include "donner/svg/resources/DecodedImage.h"
+
+#include <algorithm>
+
+namespace donner::svg {
+
+bool DecodedImage::matches(std::span<const std::uint8_t> encoded) const {
+  return std::ranges::equal(encoded_, encoded);
+}
+
+bool DecodedImage::hasPremultiplied() const {
+  return hasPremultiplied_.load(std::memory_order_acquire);
+}
+
+std::span<const std::uint8_t> DecodedImage::premultiplied(const PremultiplyFn& premultiply) const {
+  std::call_once(premultipliedOnce_, [&] {
+    premultiply(pixels_, premultiplied_);
+    hasPremultiplied_.store(true, std::memory_order_release);
+  });
+  return premultiplied_;
+}
+
+}  // namespace donner::svg
@@ -0,0 +1,113 @@
+#pragma once
+/// @file
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "donner/base/ContentHash.h"
+#include "donner/svg/resources/ImageMipChain.h"
+
+namespace donner::svg {
+
+/**
+ * Immutable decoded raster image shared between every document that loaded the same encoded
+ * bytes. Owned by reference count: \ref DecodedImageCache holds one reference while the entry is
+ * resident, and each \ref ImageResource that was produced from it holds another through
+ * \ref ImageResource::shared and borrows its pixels, so an entry evicted from the cache stays
+ * valid for as long as any document still draws it.
+ *
+ * The entry keeps the encoded bytes it was decoded from next to the straight-alpha pixels, so a
+ * cache lookup can confirm that a \ref ContentHash match really is the same input before handing
+ * out the pixels. The premultiplied form that software renderers sample is derived lazily,
+ * exactly once, by the first caller of \ref premultiplied, and shared from then on, as is the
+ * \ref mipChain built over it for minified draws.
+ */
+class DecodedImage {
+public:
+  /// Converts straight-alpha RGBA into premultiplied RGBA, supplied by the renderer so this
+  /// resource-layer type does not depend on renderer pixel-format code.
+  using PremultiplyFn =
+      std::function<void(std::span<const std::uint8_t> rgba, std::vector<std::uint8_t>& out)>;
+
+  /**
+   * Construct from decoded pixels.
+   *
+   * @param key Content hash of \p encoded.
+   * @param encoded Encoded bytes the pixels were decoded from.
+   * @param pixels Decoded straight-alpha RGBA pixels.
+   * @param width Width of the image, in pixels.
+   * @param height Height of the image, in pixels.
+   */
+  DecodedImage(const ContentHash& key, std::vector<std::uint8_t> encoded,
+               std::vector<std::uint8_t> pixels, int width, int height)
+      : key_(key),
+        encoded_(std::move(encoded)),
+        pixels_(std::move(pixels)),
+        width_(width),
+        height_(height) {}
+
+  // No copy or move: entries are only ever handled through `std::shared_ptr`.
+  DecodedImage(const DecodedImage&) = delete;
+  DecodedImage(DecodedImage&&) = delete;
+  DecodedImage& operator=(const DecodedImage&) = delete;
+  DecodedImage& operator=(DecodedImage&&) = delete;
+
+  /// Content hash of the encoded bytes.
+  const ContentHash& key() const { return key_; }
+
+  /// Returns true if this entry was decoded from exactly \p encoded, not merely from bytes with
+  /// the same \ref ContentHash.
+  bool matches(std::span<const std::uint8_t> encoded) const;
+
+  /// Decoded straight-alpha RGBA pixels.
+  std::span<const std::uint8_t> pixels() const { return pixels_; }
+
+  /// Width of the image, in pixels.
+  int width() const { return width_; }
+
+  /// Height of the image, in pixels.
+  int height() const { return height_; }
+
+  /// Returns true if the premultiplied form has already been derived.
+  bool hasPremultiplied() const;
+
+  /**
+   * Returns the premultiplied pixels, deriving them with \p premultiply on first use. Safe to call
+   * concurrently; exactly one caller runs \p premultiply and the rest wait for it.
+   *
+   * @param premultiply Conversion used on the first call, ignored afterwards.
+   */
+  std::span<const std::uint8_t> premultiplied(const PremultiplyFn& premultiply) const;
+
+  /// Mip chain over the \ref premultiplied pixels, shared by every draw of this entry.
+  ImageMipChain& mipChain() const { return mipChain_; }
+
+  /**
+   * Bytes this entry is charged against a \ref DecodedImageCache budget: the encoded bytes, the
+   * straight pixels and the premultiplied pixels, counted up front whether or not they have been
+   * derived yet so that a later draw cannot push the cache over budget behind its back. A full
+   * mip chain adds at most a third of the premultiplied size on top and is charged the same way.
+   */
+  std::size_t chargedBytes() const {
+    return encoded_.size() + pixels_.size() * 2u + pixels_.size() / 3u;
+  }
+
+private:
+  ContentHash key_;
+  std::vector<std::uint8_t> encoded_;
+  std::vector<std::uint8_t> pixels_;
+  int width_;
+  int height_;
+
+  mutable std::once_flag premultipliedOnce_;
+  mutable std::vector<std::uint8_t> premultiplied_;
+  mutable std::atomic<bool> hasPremultiplied_{false};
+  mutable ImageMipChain mipChain_;
+};
+
+}  // namespace donner::svg
@@ -0,0 +1,104 @@
+#include "donner/svg/resources/DecodedImageCache.h"
+
+namespace donner::svg {
+
+DecodedImageCache& DecodedImageCache::Global() {
+  // Intentionally leaked so documents torn down during static destruction can still release
+  // their references safely.
+  static DecodedImageCache* const instance = new DecodedImageCache();
+  return *instance;
+}
+
+bool DecodedImageCache::enabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return byteBudget_ != 0;
+}
+
+void DecodedImageCache::setByteBudget(std::size_t byteBudget) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  byteBudget_ = byteBudget;
+  evictToBudgetLocked();
+}
+
+std::size_t DecodedImageCache::byteBudget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return byteBudget_;
+}
+
+std::shared_ptr<const DecodedImage> DecodedImageCache::find(const ContentHash& key,
+                                                            std::span<const std::uint8_t> encoded) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (byteBudget_ == 0) {
+    return nullptr;
+  }
+
+  const auto it = index_.find(key);
+  if (it == index_.end() || !(*it->second)->matches(encoded)) {
+    ++counters_.misses;
+    return nullptr;
+  }
+
+  ++counters_.hits;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return *it->second;
+}
+
+std::shared_ptr<const DecodedImage> DecodedImageCache::insert(
+    const ContentHash& key, std::span<const std::uint8_t> encoded,
+    std::vector<std::uint8_t> pixels, int width, int height) {
+  auto entry = std::make_shared<const DecodedImage>(
+      key, std::vector<std::uint8_t>(encoded.begin(), encoded.end()), std::move(pixels), width,
+      height);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (const auto it = index_.find(key); it != index_.end()) {
+    if ((*it->second)->matches(encoded)) {
+      // Lost a decode race with another thread; converge on the resident payload.
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return *it->second;
+    }
+
+    // A different input with a colliding hash. Keep the resident entry and hand this one back
+    // unretained; it is still correct for the caller, just not shared.
+    return entry;
+  }
+
+  const std::size_t charge = entry->chargedBytes();
+  if (charge > byteBudget_) {
+    return entry;
+  }
+
+  lru_.push_front(entry);
+  index_.emplace(key, lru_.begin());
+  residentBytes_ += charge;
+  ++counters_.insertions;
+  evictToBudgetLocked();
+  return entry;
+}
+
+void DecodedImageCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  index_.clear();
+  residentBytes_ = 0;
+}
+
+DecodedImageCache::Stats DecodedImageCache::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats result = counters_;
+  result.residentBytes = residentBytes_;
+  result.entryCount = lru_.size();
+  return result;
+}
+
+void DecodedImageCache::evictToBudgetLocked() {
+  while (residentBytes_ > byteBudget_ && !lru_.empty()) {
+    const std::shared_ptr<const DecodedImage>& coldest = lru_.back();
+    residentBytes_ -= coldest->chargedBytes();
+    index_.erase(coldest->key());
+    lru_.pop_back();
+    ++counters_.evictions;
+  }
+}
+
+}  // namespace donner::svg
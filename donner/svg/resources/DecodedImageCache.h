@@ -0,0 +1,126 @@
+#pragma once
+/// @file
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "donner/base/ContentHash.h"
+#include "donner/svg/resources/DecodedImage.h"
+
+namespace donner::svg {
+
+/**
+ * Opt-in, process-wide cache of decoded raster images keyed by the content hash of their encoded
+ * bytes.
+ *
+ * Servers that render many documents referencing the same logos and sprites otherwise decode and
+ * premultiply each image once per document. When enabled, \ref ImageLoader consults this cache
+ * before decoding and publishes new decodes into it, and the tiny-skia backend samples the
+ * entry's shared premultiplied pixels instead of keeping a per-document copy.
+ *
+ * The cache is disabled by default (byte budget of zero), in which case lookups always miss and
+ * nothing is retained. Residency is bounded by \ref setByteBudget with least-recently-used
+ * eviction, charging each entry \ref DecodedImage::chargedBytes; an entry larger than the whole
+ * budget is returned to the caller but not retained.
+ *
+ * \ref ContentHash is not collision resistant and the encoded bytes come from untrusted documents,
+ * so the hash only selects a candidate: every lookup compares the candidate's encoded bytes
+ * against the caller's before returning it, and a crafted collision misses instead of handing one
+ * document another document's pixels.
+ * All methods are thread-safe.
+ *
+ * ```cpp
+ * DecodedImageCache::Global().setByteBudget(256 * 1024 * 1024);
+ * ```
+ */
+class DecodedImageCache {
+public:
+  /// Counters describing cache effectiveness, see \ref stats.
+  struct Stats {
+    std::uint64_t hits = 0;         //!< Lookups that found a resident entry.
+    std::uint64_t misses = 0;       //!< Lookups that did not.
+    std::uint64_t insertions = 0;   //!< Entries retained by \ref insert.
+    std::uint64_t evictions = 0;    //!< Entries dropped to stay under the byte budget.
+    std::size_t residentBytes = 0;  //!< Bytes currently charged to the budget.
+    std::size_t entryCount = 0;     //!< Entries currently resident.
+  };
+
+  /// Construct a standalone cache with the given byte budget. Most callers want \ref Global.
+  explicit DecodedImageCache(std::size_t byteBudget = 0) : byteBudget_(byteBudget) {}
+
+  // No copy or move.
+  DecodedImageCache(const DecodedImageCache&) = delete;
+  DecodedImageCache(DecodedImageCache&&) = delete;
+  DecodedImageCache& operator=(const DecodedImageCache&) = delete;
+  DecodedImageCache& operator=(DecodedImageCache&&) = delete;
+
+  /// The process-wide instance used by \ref ImageLoader. Disabled until given a byte budget.
+  static DecodedImageCache& Global();
+
+  /// Returns true if the cache retains anything, i.e. the byte budget is nonzero.
+  bool enabled() const;
+
+  /**
+   * Set the maximum number of bytes retained, evicting least-recently-used entries to fit. A
+   * budget of zero disables the cache and releases every resident entry.
+   */
+  void setByteBudget(std::size_t byteBudget);
+
+  /// Current byte budget.
+  std::size_t byteBudget() const;
+
+  /**
+   * Look up the entry decoded from \p encoded, marking it most recently used.
+   *
+   * @param key Content hash of \p encoded.
+   * @param encoded Encoded image bytes, compared against the resident entry's.
+   * @return The entry, or \c nullptr on a miss or when the cache is disabled.
+   */
+  std::shared_ptr<const DecodedImage> find(const ContentHash& key,
+                                           std::span<const std::uint8_t> encoded);
+
+  /**
+   * Publish a freshly decoded image. If another thread inserted the same encoded bytes first, that
+   * entry is kept and returned instead so every caller converges on one shared payload. The pixels
+   * are moved into the entry, never copied.
+   *
+   * @param key Content hash of \p encoded.
+   * @param encoded Encoded bytes the pixels were decoded from.
+   * @param pixels Decoded straight-alpha RGBA pixels.
+   * @param width Width of the image, in pixels.
+   * @param height Height of the image, in pixels.
+   * @return The resident (or, when not retained, standalone) shared entry.
+   */
+  std::shared_ptr<const DecodedImage> insert(const ContentHash& key,
+                                             std::span<const std::uint8_t> encoded,
+                                             std::vector<std::uint8_t> pixels, int width,
+                                             int height);
+
+  /// Drop every resident entry. Entries still referenced by documents stay alive.
+  void clear();
+
+  /// Snapshot of the cache counters.
+  Stats stats() const;
+
+private:
+  /// Most recently used at the front.
+  using LruList = std::list<std::shared_ptr<const DecodedImage>>;
+
+  /// Evict from the cold end until resident bytes fit the budget. Requires `mutex_`.
+  void evictToBudgetLocked();
+
+  mutable std::mutex mutex_;
+  std::size_t byteBudget_ = 0;
+  std::size_t residentBytes_ = 0;
+  LruList lru_;
+  std::unordered_map<ContentHash, LruList::iterator> index_;
+  Stats counters_;
+};
+
+}  // namespace donner::svg
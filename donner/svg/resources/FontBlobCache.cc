@@ -0,0 +1,102 @@
+#include "donner/svg/resources/FontBlobCache.h"
+
+#include <algorithm>
+
+namespace donner::svg {
+
+bool FontBlob::matches(std::span<const uint8_t> source) const {
+  return std::ranges::equal(this->source(), source);
+}
+
+FontBlobCache& FontBlobCache::Global() {
+  // Intentionally leaked so font managers torn down during static destruction can still release
+  // their references safely.
+  static FontBlobCache* const instance = new FontBlobCache();
+  return *instance;
+}
+
+bool FontBlobCache::enabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return byteBudget_ != 0;
+}
+
+void FontBlobCache::setByteBudget(std::size_t byteBudget) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  byteBudget_ = byteBudget;
+  evictToBudgetLocked();
+}
+
+std::size_t FontBlobCache::byteBudget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return byteBudget_;
+}
+
+std::shared_ptr<const FontBlob> FontBlobCache::find(const FontBlobSource& source) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (byteBudget_ == 0) {
+    return nullptr;
+  }
+
+  const auto it = index_.find(source.key);
+  if (it == index_.end() || !(*it->second)->matches(source.bytes)) {
+    ++counters_.misses;
+    return nullptr;
+  }
+
+  ++counters_.hits;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return *it->second;
+}
+
+std::shared_ptr<const FontBlob> FontBlobCache::insert(std::shared_ptr<const FontBlob> blob) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (const auto it = index_.find(blob->key()); it != index_.end()) {
+    if (!(*it->second)->matches(blob->source())) {
+      // A different font with a colliding key; keep the resident blob.
+      return blob;
+    }
+
+    // Lost a load race with another thread; converge on the resident blob.
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return *it->second;
+  }
+
+  const std::size_t charge = blob->chargedBytes();
+  if (charge > byteBudget_) {
+    return blob;
+  }
+
+  lru_.push_front(blob);
+  index_.emplace(blob->key(), lru_.begin());
+  residentBytes_ += charge;
+  ++counters_.insertions;
+  evictToBudgetLocked();
+  return blob;
+}
+
+void FontBlobCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  index_.clear();
+  residentBytes_ = 0;
+}
+
+FontBlobCache::Stats FontBlobCache::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats result = counters_;
+  result.residentBytes = residentBytes_;
+  result.entryCount = lru_.size();
+  return result;
+}
+
+void FontBlobCache::evictToBudgetLocked() {
+  while (residentBytes_ > byteBudget_ && !lru_.empty()) {
+    const std::shared_ptr<const FontBlob>& coldest = lru_.back();
+    residentBytes_ -= coldest->chargedBytes();
+    index_.erase(coldest->key());
+    lru_.pop_back();
+    ++counters_.evictions;
+  }
+}
+
+}  // namespace donner::svg
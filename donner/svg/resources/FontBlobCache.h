@@ -0,0 +1,209 @@
+#pragma once
+/// @file
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "donner/base/ContentHash.h"
+#include "donner/base/fonts/SfntUtils.h"
+
+namespace donner::svg {
+
+/**
+ * Source bytes a font was loaded from, and their content hash: the identity under which a
+ * \ref FontBlob is published to and looked up in a \ref FontBlobCache.
+ */
+struct FontBlobSource {
+  ContentHash key;                 //!< Content hash of \ref bytes.
+  std::span<const uint8_t> bytes;  //!< Source bytes, before any WOFF decompression.
+};
+
+/**
+ * Immutable, validated sfnt font shared between every \ref FontManager that loaded the same source
+ * bytes: the decompressed sfnt byte stream plus the \ref fonts::SfntFont index built while
+ * validating it.
+ *
+ * The bytes are borrowed from an opaque owner kept alive with the blob, which may be an owned
+ * buffer (a decompressed WOFF), a document's shared `@font-face` payload, a read-only file mapping
+ * (\ref MappedFile), or nothing at all for bytes with static storage duration such as the embedded
+ * fallback font. Either way the bytes never move, so the index stays valid against them.
+ *
+ * A blob loaded from compressed (WOFF) source also keeps a copy of that source, so that
+ * \ref matches can compare a lookup's source bytes against the blob's, and it records the CFF
+ * validation work its validation cost, so that a cache hit can be charged to an untrusted
+ * document's validation budget exactly as a fresh load would be.
+ */
+class FontBlob {
+public:
+  /**
+   * Construct from already-validated font bytes.
+   *
+   * @param key Content hash of the source bytes the font was loaded from (before any WOFF
+   *   decompression), or a default hash for blobs that are never cached.
+   * @param owner Keeps \p data alive; may be null when \p data has static storage duration.
+   * @param data Validated sfnt byte stream.
+   * @param sfnt Index produced by validating \p data.
+   * @param validationWork CFF validation work spent validating \p data.
+   * @param compressedSource Source bytes when they differ from \p data, i.e. for WOFF fonts.
+   */
+  FontBlob(const ContentHash& key, std::shared_ptr<const void> owner,
+           std::span<const uint8_t> data, fonts::SfntFont sfnt, std::size_t validationWork = 0,
+           std::vector<uint8_t> compressedSource = {})
+      : key_(key),
+        owner_(std::move(owner)),
+        data_(data),
+        sfnt_(std::move(sfnt)),
+        validationWork_(validationWork),
+        compressedSource_(std::move(compressedSource)) {}
+
+  // No copy or move: blobs are only ever handled through `std::shared_ptr`.
+  FontBlob(const FontBlob&) = delete;
+  FontBlob(FontBlob&&) = delete;
+  FontBlob& operator=(const FontBlob&) = delete;
+  FontBlob& operator=(FontBlob&&) = delete;
+
+  /// Content hash of the source bytes.
+  const ContentHash& key() const { return key_; }
+
+  /// Returns true if this blob was loaded from exactly \p source, not merely from bytes with the
+  /// same \ref ContentHash.
+  bool matches(std::span<const uint8_t> source) const;
+
+  /// Validated sfnt byte stream.
+  std::span<const uint8_t> data() const { return data_; }
+
+  /// Source bytes the blob was loaded from: the compressed source for WOFF fonts, otherwise
+  /// \ref data itself.
+  std::span<const uint8_t> source() const {
+    return compressedSource_.empty() ? data_ : std::span<const uint8_t>(compressedSource_);
+  }
+
+  /// Validated table directory and outline index over \ref data.
+  const fonts::SfntFont& sfnt() const { return sfnt_; }
+
+  /// CFF validation work spent validating \ref data.
+  std::size_t validationWork() const { return validationWork_; }
+
+  /// Bytes this blob is charged against a \ref FontBlobCache budget: the font bytes, the index and
+  /// any retained compressed source.
+  std::size_t chargedBytes() const {
+    return data_.size() + sfnt_.retainedBytes() + compressedSource_.size();
+  }
+
+private:
+  ContentHash key_;
+  std::shared_ptr<const void> owner_;
+  std::span<const uint8_t> data_;
+  fonts::SfntFont sfnt_;
+  std::size_t validationWork_;
+  std::vector<uint8_t> compressedSource_;
+};
+
+/**
+ * Opt-in, process-wide cache of validated fonts keyed by the content hash of their source bytes.
+ *
+ * Each document gets its own \ref FontManager, so a server rendering thousands of documents that
+ * reference the same web fonts otherwise decompresses, validates and copies each font once per
+ * document. When enabled, \ref FontManager consults this cache before that work and references the
+ * shared \ref FontBlob instead of keeping its own copy; a hit performs no decompression and no
+ * validation, which shows up as an increment of \ref FontManager::sharedFontBlobHits.
+ *
+ * Only fonts that passed validation are cached. Validation does not depend on the trust level
+ * beyond its work limit, which never exceeds \ref fonts::kMaximumCffOutlineValidationWork, so a
+ * blob is valid for any later load of the same bytes; trust stays a per-load property. The hit
+ * still goes through the loading document's budget and trust checks, and an untrusted load is
+ * charged the blob's recorded \ref FontBlob::validationWork, so whether a document admits a font
+ * never depends on what other documents happened to load first.
+ *
+ * \ref ContentHash is not collision resistant and font bytes come from untrusted documents, so a
+ * lookup compares the resident blob's source bytes against the caller's (\ref FontBlob::matches)
+ * before returning it; a crafted collision misses.
+ *
+ * Disabled by default (byte budget of zero). Residency is bounded by \ref setByteBudget with
+ * least-recently-used eviction, charging each blob \ref FontBlob::chargedBytes; evicted blobs stay
+ * alive while any font manager still references them. All methods are thread-safe.
+ *
+ * ```cpp
+ * FontBlobCache::Global().setByteBudget(128 * 1024 * 1024);
+ * ```
+ */
+class FontBlobCache {
+public:
+  /// Counters describing cache effectiveness, see \ref stats.
+  struct Stats {
+    std::uint64_t hits = 0;         //!< Lookups that found a resident blob.
+    std::uint64_t misses = 0;       //!< Lookups that did not.
+    std::uint64_t insertions = 0;   //!< Blobs retained by \ref insert.
+    std::uint64_t evictions = 0;    //!< Blobs dropped to stay under the byte budget.
+    std::size_t residentBytes = 0;  //!< Bytes currently charged to the budget.
+    std::size_t entryCount = 0;     //!< Blobs currently resident.
+  };
+
+  /// Construct a standalone cache with the given byte budget. Most callers want \ref Global.
+  explicit FontBlobCache(std::size_t byteBudget = 0) : byteBudget_(byteBudget) {}
+
+  // No copy or move.
+  FontBlobCache(const FontBlobCache&) = delete;
+  FontBlobCache(FontBlobCache&&) = delete;
+  FontBlobCache& operator=(const FontBlobCache&) = delete;
+  FontBlobCache& operator=(FontBlobCache&&) = delete;
+
+  /// The process-wide instance used by \ref FontManager. Disabled until given a byte budget.
+  static FontBlobCache& Global();
+
+  /// Returns true if the cache retains anything, i.e. the byte budget is nonzero.
+  bool enabled() const;
+
+  /**
+   * Set the maximum number of bytes retained, evicting least-recently-used blobs to fit. A budget
+   * of zero disables the cache and releases every resident blob.
+   */
+  void setByteBudget(std::size_t byteBudget);
+
+  /// Current byte budget.
+  std::size_t byteBudget() const;
+
+  /**
+   * Look up the blob loaded from \p source, marking it most recently used.
+   *
+   * @return The blob, or \c nullptr on a miss or when the cache is disabled.
+   */
+  std::shared_ptr<const FontBlob> find(const FontBlobSource& source);
+
+  /**
+   * Publish a freshly validated blob under \ref FontBlob::key. If another thread inserted the same
+   * source first, that blob is kept and returned instead so every caller converges on one copy. A
+   * different source whose key collides with a resident blob is returned unretained.
+   *
+   * @return The resident (or, when not retained, the passed-in) blob.
+   */
+  std::shared_ptr<const FontBlob> insert(std::shared_ptr<const FontBlob> blob);
+
+  /// Drop every resident blob. Blobs still referenced by font managers stay alive.
+  void clear();
+
+  /// Snapshot of the cache counters.
+  Stats stats() const;
+
+private:
+  /// Most recently used at the front.
+  using LruList = std::list<std::shared_ptr<const FontBlob>>;
+
+  /// Evict from the cold end until resident bytes fit the budget. Requires `mutex_`.
+  void evictToBudgetLocked();
+
+  mutable std::mutex mutex_;
+  std::size_t byteBudget_ = 0;
+  std::size_t residentBytes_ = 0;
+  LruList lru_;
+  std::unordered_map<ContentHash, LruList::iterator> index_;
+  Stats counters_;
+};
+
+}  // namespace donner::svg
@@ -5,6 +5,7 @@
 
 #include "donner/base/StringUtils.h"
 #include "donner/svg/resources/EmbeddedFontProvider.h"
+#include "donner/svg/resources/FontDirectoryProvider.h"
 #include "donner/svg/resources/SystemFontProvider.h"
 
 namespace donner::svg {
@@ -24,7 +25,12 @@ std::string toLower(std::string_view value) {
 FontCatalog::FontCatalog() {
   // Order defines precedence: Embedded before System.
   providers_.push_back(std::make_unique<EmbeddedFontProvider>());
+#if defined(__linux__)
+  providers_.push_back(
+      std::make_unique<FontDirectoryProvider>(FontDirectoryProvider::DefaultOptions()));
+#else
   providers_.push_back(std::make_unique<SystemFontProvider>());
+#endif
 }
 
 FontCatalog::FontCatalog(std::vector<std::unique_ptr<FontFamilyProvider>> providers)
@@ -70,6 +76,17 @@ std::vector<uint8_t> FontCatalog::loadFamilyData(std::string_view family,
   return {};
 }
 
+std::optional<std::filesystem::path> FontCatalog::familyFilePath(
+    std::string_view family, const FontFaceRequest& request) const {
+  for (const auto& provider : providers_) {
+    if (provider->hasFamily(family)) {
+      // Only the provider that would serve loadFamilyData() may answer, so both agree on the face.
+      return provider->familyFilePath(family, request);
+    }
+  }
+  return std::nullopt;
+}
+
 std::optional<FontFamilyInfo> FontCatalog::find(std::string_view family) const {
   for (const auto& provider : providers_) {
     if (!provider->hasFamily(family)) {
@@ -13,7 +13,8 @@ namespace donner::svg {
  * resolution consume.
  *
  * A default-constructed catalog contains an embedded provider (curated Google Fonts) followed by a
- * system provider (CoreText on macOS; a no-op stub elsewhere). Providers are consulted in order, so
+ * system provider: CoreText on macOS, a \ref FontDirectoryProvider over the standard font
+ * directories on Linux, and a no-op stub elsewhere. Providers are consulted in order, so
  * resolution and `loadFace()` prefer **Embedded** families over **System** families, and
  * `families()` lists the Embedded group before the System group.
  *
@@ -64,6 +65,11 @@ public:
   std::vector<uint8_t> loadFamilyData(std::string_view family,
                                       const FontFaceRequest& request) const override;
 
+  /// On-disk file for \p family from the first provider that has it, if that provider is backed
+  /// by font files.
+  std::optional<std::filesystem::path> familyFilePath(
+      std::string_view family, const FontFaceRequest& request) const override;
+
   // Picker conveniences:
 
   /// Families from a single source (Embedded or System), sorted by name.
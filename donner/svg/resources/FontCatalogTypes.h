@@ -2,6 +2,8 @@
 /// @file
 
 #include <cstdint>
+#include <filesystem>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <string_view>
@@ -20,7 +22,7 @@ namespace donner::svg {
  */
 enum class FontSource {
   Embedded,  //!< Bundled with the build (curated Google Fonts, fetched + embedded at build time).
-  System,    //!< Discovered from the host OS (CoreText on macOS; none on other platforms).
+  System,  //!< Discovered from the host OS (CoreText on macOS, font directories on Linux).
 };
 
 /**
@@ -105,6 +107,19 @@ public:
    */
   virtual std::vector<uint8_t> loadFamilyData(std::string_view family,
                                               const FontFaceRequest& request) const = 0;
+
+  /**
+   * Path of an on-disk sfnt file holding the face \ref loadFamilyData would return, for providers
+   * backed by installed font files. \ref FontManager prefers this when available and maps the file
+   * instead of copying its bytes. The default returns std::nullopt.
+   *
+   * @param family Family name to load (case-insensitive).
+   * @param request Face within the family to prefer.
+   */
+  virtual std::optional<std::filesystem::path> familyFilePath(
+      std::string_view /*family*/, const FontFaceRequest& /*request*/) const {
+    return std::nullopt;
+  }
 };
 
 }  // namespace donner::svg
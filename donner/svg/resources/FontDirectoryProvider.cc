@@ -0,0 +1,442 @@
+#include "donner/svg/resources/FontDirectoryProvider.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <system_error>
+#include <utility>
+#include <variant>
+
+#include "donner/base/FileUtils.h"
+#include "donner/svg/resources/FontMetadata.h"
+
+#ifdef _WIN32
+#include <random>
+#else
+#include <unistd.h>
+#endif
+
+namespace donner::svg {
+
+namespace {
+
+/// First line of an index file. Bump the version whenever the record layout changes.
+constexpr std::string_view kIndexHeader = "donner-font-index 1";
+
+/// Deepest directory nesting followed by the walk, which bounds symlink cycles.
+constexpr int kMaximumDirectoryDepth = 16;
+
+constexpr uint32_t kSfntTrueType = 0x00010000;
+constexpr uint32_t kSfntCff = 0x4F54544F;    // "OTTO"
+constexpr uint32_t kSfntApple = 0x74727565;  // "true"
+
+/// ASCII-only lowercase, matching how family lookups are compared.
+std::string ToLowerAscii(std::string_view value) {
+  std::string lowered(value);
+  for (char& c : lowered) {
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+  }
+  return lowered;
+}
+
+bool IsFontFileExtension(const std::filesystem::path& path) {
+  const std::string extension = ToLowerAscii(path.extension().string());
+  return extension == ".ttf" || extension == ".otf";
+}
+
+/// Identity of a file's contents as far as the index is concerned.
+struct FileStamp {
+  std::uintmax_t size = 0;
+  std::int64_t mtime = 0;
+
+  bool operator==(const FileStamp& other) const = default;
+};
+
+/// One index record: a file's stamp and what its tables said. An empty family records a file that
+/// was read but is not a usable face, so it is not read again either.
+struct IndexRecord {
+  FileStamp stamp;
+  std::string family;
+  int weight = 400;
+  int style = 0;
+  int stretch = 5;
+};
+
+std::optional<FileStamp> StampFile(const std::filesystem::path& path) {
+  std::error_code error;
+  const std::uintmax_t size = std::filesystem::file_size(path, error);
+  if (error) {
+    return std::nullopt;
+  }
+  const std::filesystem::file_time_type mtime = std::filesystem::last_write_time(path, error);
+  if (error) {
+    return std::nullopt;
+  }
+  return FileStamp{size, static_cast<std::int64_t>(mtime.time_since_epoch().count())};
+}
+
+/// Read one face's metadata from disk. Returns a record with an empty family for files that are
+/// not single-face sfnt fonts.
+IndexRecord ReadFontFile(const std::filesystem::path& path, const FileStamp& stamp) {
+  IndexRecord record;
+  record.stamp = stamp;
+
+  FileMapResult mapped = MapFileBounded(path, FontDirectoryProvider::kMaximumFontFileSize);
+  const auto* file = std::get_if<std::shared_ptr<const MappedFile>>(&mapped);
+  if (file == nullptr || (*file)->size() < 4) {
+    return record;
+  }
+
+  const std::span<const uint8_t> bytes = (*file)->bytes();
+  const uint32_t magic = (static_cast<uint32_t>(bytes[0]) << 24) |
+                         (static_cast<uint32_t>(bytes[1]) << 16) |
+                         (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+  if (magic != kSfntTrueType && magic != kSfntCff && magic != kSfntApple) {
+    return record;
+  }
+
+  if (std::optional<FontMetadata> metadata = ParseFontMetadata(bytes)) {
+    record.family = std::move(metadata->familyName);
+    record.weight = std::clamp(metadata->fontWeight, 1, 1000);
+    record.style = metadata->fontStyle;
+    record.stretch = metadata->fontStretch;
+  }
+  return record;
+}
+
+/// Returns true if \p value can be stored in a tab-separated index field.
+bool IsIndexSafe(std::string_view value) {
+  return value.find_first_of("\t\n\r") == std::string_view::npos;
+}
+
+/// Returns true if the record for the font at \p path can be written to the index.
+bool IsIndexable(std::string_view path, const IndexRecord& record) {
+  return IsIndexSafe(path) && IsIndexSafe(record.family);
+}
+
+/**
+ * Parse an index file into path-keyed records. Lines are
+ * `size \t mtime \t weight \t style \t stretch \t family \t path`; anything malformed is skipped.
+ */
+std::unordered_map<std::string, IndexRecord> ReadIndex(const std::filesystem::path& indexPath) {
+  std::unordered_map<std::string, IndexRecord> records;
+  if (indexPath.empty()) {
+    return records;
+  }
+
+  std::ifstream input(indexPath, std::ios::binary);
+  std::string line;
+  if (!std::getline(input, line) || line != kIndexHeader) {
+    return records;
+  }
+
+  while (std::getline(input, line)) {
+    std::vector<std::string_view> fields;
+    std::string_view remaining = line;
+    for (int i = 0; i < 6; ++i) {
+      const size_t tab = remaining.find('\t');
+      if (tab == std::string_view::npos) {
+        break;
+      }
+      fields.push_back(remaining.substr(0, tab));
+      remaining.remove_prefix(tab + 1);
+    }
+    if (fields.size() != 6 || remaining.empty()) {
+      continue;
+    }
+
+    IndexRecord record;
+    std::istringstream numbers(std::string(fields[0]) + ' ' + std::string(fields[1]) + ' ' +
+                               std::string(fields[2]) + ' ' + std::string(fields[3]) + ' ' +
+                               std::string(fields[4]));
+    if (!(numbers >> record.stamp.size >> record.stamp.mtime >> record.weight >> record.style >>
+          record.stretch)) {
+      continue;
+    }
+    record.family = std::string(fields[5]);
+    records.insert_or_assign(std::string(remaining), std::move(record));
+  }
+
+  return records;
+}
+
+/// Create an empty file next to \p path that no other process writes to, returning its path or an
+/// empty path on failure.
+std::filesystem::path CreateTemporaryFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+  std::random_device random;
+  for (int attempt = 0; attempt < 8; ++attempt) {
+    std::filesystem::path candidate = path;
+    candidate += ".tmp." + std::to_string(random()) + std::to_string(random());
+    std::error_code error;
+    if (!std::filesystem::exists(candidate, error) && !error) {
+      std::ofstream(candidate, std::ios::binary);
+      return candidate;
+    }
+  }
+  return {};
+#else
+  std::string pattern = path.string() + ".tmp.XXXXXX";
+  const int fd = mkstemp(pattern.data());
+  if (fd < 0) {
+    return {};
+  }
+  close(fd);
+  return pattern;
+#endif
+}
+
+/// Write \p records to \p indexPath through a temporary file of this process's own, so readers
+/// never see a partial index and concurrent writers never interleave. Returns true on success.
+bool WriteIndex(const std::filesystem::path& indexPath,
+                const std::vector<std::pair<std::string, IndexRecord>>& records) {
+  std::error_code error;
+  if (indexPath.has_parent_path()) {
+    std::filesystem::create_directories(indexPath.parent_path(), error);
+  }
+
+  const std::filesystem::path temporary = CreateTemporaryFile(indexPath);
+  if (temporary.empty()) {
+    return false;
+  }
+  {
+    std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+    output << kIndexHeader << '\n';
+    for (const auto& [path, record] : records) {
+      if (!IsIndexable(path, record)) {
+        continue;
+      }
+      output << record.stamp.size << '\t' << record.stamp.mtime << '\t' << record.weight << '\t'
+             << record.style << '\t' << record.stretch << '\t' << record.family << '\t' << path
+             << '\n';
+    }
+    if (!output.flush()) {
+      std::filesystem::remove(temporary, error);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(temporary, indexPath, error);
+  if (error) {
+    std::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Rank \p face against \p request; lower is better. Style dominates, then stretch, then weight,
+ * with the same penalties as the `@font-face` matcher in \ref FontManager.
+ */
+int ScoreFace(int faceWeight, int faceStyle, int faceStretch, const FontFaceRequest& request) {
+  const int style = static_cast<int>(request.style);
+  const int stretch = static_cast<int>(request.stretch);
+
+  int score = 0;
+  if (faceStyle != style) {
+    // Italic and oblique substitute for each other before either falls back to normal.
+    score += ((faceStyle == 1 && style == 2) || (faceStyle == 2 && style == 1)) ? 5000 : 10000;
+  }
+
+  const int stretchDelta = faceStretch - stretch;
+  if (stretchDelta != 0) {
+    const bool preferredSide =
+        (stretch < 5 && stretchDelta < 0) || (stretch > 5 && stretchDelta > 0);
+    score += std::abs(stretchDelta) * 100 + (preferredSide ? 0 : 1000);
+  }
+
+  return score + std::abs(faceWeight - request.weight);
+}
+
+/// `$name`, or empty when unset.
+std::filesystem::path EnvironmentPath(const char* name) {
+  const char* value = std::getenv(name);
+  return value != nullptr && value[0] != '\0' ? std::filesystem::path(value)
+                                              : std::filesystem::path();
+}
+
+}  // namespace
+
+FontDirectoryProvider::FontDirectoryProvider(Options options) : options_(std::move(options)) {}
+
+FontDirectoryProvider::Options FontDirectoryProvider::DefaultOptions() {
+  Options options;
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+  const std::filesystem::path home = EnvironmentPath("HOME");
+
+  std::filesystem::path dataHome = EnvironmentPath("XDG_DATA_HOME");
+  if (dataHome.empty() && !home.empty()) {
+    dataHome = home / ".local/share";
+  }
+  if (!dataHome.empty()) {
+    options.directories.push_back(dataHome / "fonts");
+  }
+  if (!home.empty()) {
+    options.directories.push_back(home / ".fonts");
+  }
+  options.directories.emplace_back("/usr/local/share/fonts");
+  options.directories.emplace_back("/usr/share/fonts");
+
+  std::filesystem::path cacheHome = EnvironmentPath("XDG_CACHE_HOME");
+  if (cacheHome.empty() && !home.empty()) {
+    cacheHome = home / ".cache";
+  }
+  if (!cacheHome.empty()) {
+    options.indexPath = cacheHome / "donner" / "font-index";
+  }
+#endif
+  return options;
+}
+
+void FontDirectoryProvider::ensureScanned() const {
+  std::call_once(scannedOnce_, [this]() {
+    const std::unordered_map<std::string, IndexRecord> previous = ReadIndex(options_.indexPath);
+
+    // Walk every directory, reusing index records whose stamp still matches.
+    std::vector<std::pair<std::string, IndexRecord>> records;
+    std::unordered_map<std::string, bool> seenPaths;
+    bool indexChanged = false;
+    // Records the index cannot hold are never found in it, so they must not make it look stale.
+    size_t unindexableRecords = 0;
+    for (const std::filesystem::path& directory : options_.directories) {
+      std::error_code error;
+      std::filesystem::recursive_directory_iterator it(
+          directory,
+          std::filesystem::directory_options::follow_directory_symlink |
+              std::filesystem::directory_options::skip_permission_denied,
+          error);
+      for (const std::filesystem::recursive_directory_iterator end; !error && it != end;
+           it.increment(error)) {
+        if (it.depth() >= kMaximumDirectoryDepth) {
+          it.disable_recursion_pending();
+        }
+
+        const std::filesystem::path& path = it->path();
+        std::error_code statError;
+        if (!IsFontFileExtension(path) || !it->is_regular_file(statError)) {
+          continue;
+        }
+
+        std::string key = path.string();
+        if (!seenPaths.emplace(key, true).second) {
+          continue;
+        }
+        const std::optional<FileStamp> stamp = StampFile(path);
+        if (!stamp || stamp->size > kMaximumFontFileSize) {
+          continue;
+        }
+
+        ++stats_.fontFiles;
+        if (const auto found = previous.find(key);
+            found != previous.end() && found->second.stamp == *stamp) {
+          ++stats_.indexedFiles;
+          records.emplace_back(std::move(key), found->second);
+        } else {
+          ++stats_.parsedFiles;
+          IndexRecord record = ReadFontFile(path, *stamp);
+          if (IsIndexable(key, record)) {
+            indexChanged = true;
+          } else {
+            ++unindexableRecords;
+          }
+          records.emplace_back(std::move(key), std::move(record));
+        }
+      }
+    }
+    // Files that disappeared since the index was written also make it stale.
+    indexChanged = indexChanged || records.size() - unindexableRecords != previous.size();
+
+    for (const auto& [path, record] : records) {
+      if (record.family.empty()) {
+        continue;
+      }
+
+      const std::string key = ToLowerAscii(record.family);
+      auto [entry, inserted] = familyIndex_.emplace(key, families_.size());
+      if (inserted) {
+        families_.push_back(Family{record.family, {}});
+      }
+      families_[entry->second].faces.push_back(
+          Face{path, record.weight, record.style, record.stretch});
+    }
+
+    std::sort(families_.begin(), families_.end(),
+              [](const Family& a, const Family& b) { return a.name < b.name; });
+    for (size_t i = 0; i < families_.size(); ++i) {
+      familyIndex_[ToLowerAscii(families_[i].name)] = i;
+    }
+
+    if (indexChanged && !options_.indexPath.empty()) {
+      stats_.indexWritten = WriteIndex(options_.indexPath, records);
+    }
+  });
+}
+
+const FontDirectoryProvider::Family* FontDirectoryProvider::findFamily(
+    std::string_view family) const {
+  ensureScanned();
+  const auto it = familyIndex_.find(ToLowerAscii(family));
+  return it != familyIndex_.end() ? &families_[it->second] : nullptr;
+}
+
+std::vector<FontFamilyInfo> FontDirectoryProvider::families() const {
+  ensureScanned();
+  std::vector<FontFamilyInfo> result;
+  result.reserve(families_.size());
+  for (const Family& family : families_) {
+    result.push_back(FontFamilyInfo{family.name, FontSource::System, FontCategory::Unknown});
+  }
+  return result;
+}
+
+bool FontDirectoryProvider::hasFamily(std::string_view family) const {
+  return findFamily(family) != nullptr;
+}
+
+std::optional<std::filesystem::path> FontDirectoryProvider::familyFilePath(
+    std::string_view family, const FontFaceRequest& request) const {
+  const Family* entry = findFamily(family);
+  if (entry == nullptr) {
+    return std::nullopt;
+  }
+
+  const Face* best = nullptr;
+  int bestScore = std::numeric_limits<int>::max();
+  for (const Face& face : entry->faces) {
+    // Strictly better only, so the first directory to supply a face keeps it on ties.
+    const int score = ScoreFace(face.weight, face.style, face.stretch, request);
+    if (score < bestScore) {
+      bestScore = score;
+      best = &face;
+    }
+  }
+  return best != nullptr ? std::optional(best->path) : std::nullopt;
+}
+
+std::vector<uint8_t> FontDirectoryProvider::loadFamilyData(std::string_view family,
+                                                           const FontFaceRequest& request) const {
+  const std::optional<std::filesystem::path> path = familyFilePath(family, request);
+  if (!path) {
+    return {};
+  }
+
+  FileMapResult mapped = MapFileBounded(*path, kMaximumFontFileSize);
+  const auto* file = std::get_if<std::shared_ptr<const MappedFile>>(&mapped);
+  if (file == nullptr) {
+    return {};
+  }
+  return std::vector<uint8_t>((*file)->bytes().begin(), (*file)->bytes().end());
+}
+
+FontDirectoryProvider::ScanStats FontDirectoryProvider::scanStats() const {
+  ensureScanned();
+  return stats_;
+}
+
+}  // namespace donner::svg
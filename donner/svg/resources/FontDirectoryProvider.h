@@ -0,0 +1,109 @@
+#pragma once
+/// @file
+
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "donner/svg/resources/FontCatalogTypes.h"
+
+namespace donner::svg {
+
+/**
+ * \ref FontFamilyProvider backed by font files in a set of directories, the way fonts are
+ * installed on Linux (`/usr/share/fonts`, `~/.local/share/fonts`, ...).
+ *
+ * On first use the directories are walked recursively for `.ttf` and `.otf` files. Each file's
+ * family name, weight, style and stretch are read from its `name` and `OS/2` tables (\ref
+ * ParseFontMetadata), and faces are grouped into families. Faces within a family are scored
+ * against the requested weight/style/stretch with the same priorities as the `@font-face` matcher
+ * in \ref FontManager. All families report \ref FontSource::System.
+ *
+ * Reading the tables of thousands of installed fonts dominates startup, so the results can be
+ * persisted to an index file keyed by each file's path, size and modification time. Later
+ * instances only parse files that are new or changed since the index was written, and rewrite it
+ * when anything changed. The index is only a cache: entries are consulted solely for files found
+ * by the directory walk, malformed lines are ignored, and failing to read or write it only costs a
+ * rescan.
+ *
+ * Font bytes are not retained: \ref loadFamilyData memory-maps the chosen file on demand, and \ref
+ * familyFilePath lets \ref FontManager map it directly without an intermediate copy.
+ */
+class FontDirectoryProvider : public FontFamilyProvider {
+public:
+  /// Configuration for a provider.
+  struct Options {
+    /// Directories to scan recursively, in priority order: when two files claim the same face,
+    /// the one found first wins.
+    std::vector<std::filesystem::path> directories;
+
+    /// Persistent index file, or empty to rescan every file on each startup. Parent directories
+    /// are created when the index is written.
+    std::filesystem::path indexPath;
+  };
+
+  /// Counters describing the most recent scan, for diagnostics and tests.
+  struct ScanStats {
+    std::size_t fontFiles = 0;     //!< Candidate font files found by the directory walk.
+    std::size_t parsedFiles = 0;   //!< Files whose tables were read during the scan.
+    std::size_t indexedFiles = 0;  //!< Files reused from the persistent index without reading.
+    bool indexWritten = false;     //!< Whether the index was (re)written by the scan.
+  };
+
+  /// Largest font file considered, matching \ref FontManager's default per-registry byte budget.
+  static constexpr std::size_t kMaximumFontFileSize = 64 * 1024 * 1024;
+
+  /// Construct a provider; directories are not scanned until first use.
+  explicit FontDirectoryProvider(Options options);
+
+  /**
+   * Options for the host's standard font locations: on Linux and other XDG platforms the system
+   * and user font directories, with the index stored under `$XDG_CACHE_HOME` (or `~/.cache`).
+   * Empty on platforms without a conventional font directory layout.
+   */
+  static Options DefaultOptions();
+
+  std::vector<FontFamilyInfo> families() const override;
+  bool hasFamily(std::string_view family) const override;
+  std::vector<uint8_t> loadFamilyData(std::string_view family,
+                                      const FontFaceRequest& request) const override;
+  std::optional<std::filesystem::path> familyFilePath(
+      std::string_view family, const FontFaceRequest& request) const override;
+
+  /// Counters from the scan, performing it first if it has not run yet.
+  ScanStats scanStats() const;
+
+private:
+  /// One installed face.
+  struct Face {
+    std::filesystem::path path;  //!< Font file.
+    int weight = 400;            //!< CSS font-weight, 100-900.
+    int style = 0;               //!< CSS font-style, matching \ref FontStyle.
+    int stretch = 5;             //!< CSS font-stretch, matching \ref FontStretch.
+  };
+
+  /// Every face installed under one family name.
+  struct Family {
+    std::string name;         //!< Family name as declared by the first face found.
+    std::vector<Face> faces;  //!< Faces in discovery order.
+  };
+
+  /// Walk the directories and build \ref families_, at most once.
+  void ensureScanned() const;
+
+  /// Family named \p family (case-insensitive), or nullptr.
+  const Family* findFamily(std::string_view family) const;
+
+  const Options options_;
+
+  mutable std::once_flag scannedOnce_;
+  mutable std::vector<Family> families_;  //!< Sorted by name.
+  mutable std::unordered_map<std::string, std::size_t> familyIndex_;  //!< Lowercased name.
+  mutable ScanStats stats_;
+};
+
+}  // namespace donner::svg
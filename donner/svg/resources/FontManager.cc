@@ -13,6 +13,7 @@
 #include <utility>
 #include <variant>
 
+#include "donner/base/FileUtils.h"
 #include "donner/base/StringUtils.h"
 #include "donner/base/fonts/SfntUtils.h"
 #include "donner/base/fonts/WoffFont.h"
@@ -20,6 +21,7 @@
 #ifdef DONNER_TEXT_WOFF2_ENABLED
 #include "donner/base/fonts/Woff2Parser.h"
 #endif
+#include "donner/svg/resources/FontBlobCache.h"
 #include "embed_resources/PublicSansFont.h"
 
 namespace donner::svg {
@@ -177,6 +179,7 @@ struct FontManager::FontBudgetState {
   size_t usedFonts = 0;
   size_t usedValidationWork = 0;
   size_t compressedFontDecompressionAttempts = 0;
+  size_t sharedFontBlobHits = 0;
   std::unordered_map<const std::vector<uint8_t>*, std::weak_ptr<const std::vector<uint8_t>>>
       validationRejectedSources;
 };
@@ -231,19 +234,13 @@ struct FontManager::FontBudgetReservation {
 };
 
 struct FontManager::LoadedFontComponent {
-  std::vector<uint8_t> ownedData;                          // Owns reconstructed sfnt bytes.
-  std::shared_ptr<const std::vector<uint8_t>> sharedData;  // Shares raw TTF/OTF bytes.
-  fonts::SfntFont sfnt;
+  /// Validated bytes and index, possibly shared with other managers through the FontBlobCache.
+  std::shared_ptr<const FontBlob> blob;
   FontDataTrust trust = FontDataTrust::Untrusted;
   FontBudgetReservation reservation;
 
-  std::span<const uint8_t> fontData() const {
-    if (sharedData) {
-      return {sharedData->data(), sharedData->size()};
-    }
-
-    return {ownedData.data(), ownedData.size()};
-  }
+  std::span<const uint8_t> fontData() const { return blob->data(); }
+  const fonts::SfntFont& sfnt() const { return blob->sfnt(); }
 };
 
 namespace {
@@ -265,8 +262,10 @@ FontManager::FontManager(Registry& registry, size_t maximumLoadedFontBytes,
                          size_t maximumLoadedFonts, size_t maximumFontValidationWork)
     : registry_(registry),
       provider_(g_defaultFontProvider.load(std::memory_order_acquire)),
-      candidateBudgetState_(std::make_shared<FontBudgetState>(FontBudgetState{
-          maximumLoadedFontBytes, maximumLoadedFonts, maximumFontValidationWork, 0, 0, 0, {}})) {}
+      fontBlobCache_(&FontBlobCache::Global()),
+      candidateBudgetState_(std::make_shared<FontBudgetState>(
+          FontBudgetState{maximumLoadedFontBytes, maximumLoadedFonts, maximumFontValidationWork, 0,
+                          0, 0, 0, 0, {}})) {}
 FontManager::~FontManager() = default;
 
 size_t FontManager::ProviderFontKeyHash::operator()(const ProviderFontKey& key) const noexcept {
@@ -464,16 +463,25 @@ FontHandle FontManager::findFont(std::string_view family, int weight, int style,
       providerFonts_.erase(it);
     }
 
-    std::vector<uint8_t> data = provider_->loadFamilyData(family, request);
-    if (!data.empty()) {
-      const Entity entity = registry_.create();
-      if (loadFontDataIntoEntity(entity, data, FontDataTrust::Trusted)) {
-        FontHandle handle(entity);
-        providerFonts_[providerKey] = handle;
-        return cacheUnlessRetryable(handle);
-      }
-      registry_.destroy(entity);
+    // Installed font files are mapped in place; other providers hand over their bytes, which are
+    // then referenced rather than copied again.
+    const Entity entity = registry_.create();
+    bool loaded = false;
+    if (const std::optional<std::filesystem::path> path =
+            provider_->familyFilePath(family, request)) {
+      loaded = loadFontFileIntoEntity(entity, *path, FontDataTrust::Trusted);
+    } else {
+      auto data =
+          std::make_shared<const std::vector<uint8_t>>(provider_->loadFamilyData(family, request));
+      loaded = !data->empty() &&
+               loadFontDataIntoEntity(entity, *data, FontDataTrust::Trusted, data);
+    }
+    if (loaded) {
+      FontHandle handle(entity);
+      providerFonts_[providerKey] = handle;
+      return cacheUnlessRetryable(handle);
     }
+    registry_.destroy(entity);
 
     // The provider claims this family but nothing loadable came back for the requested face, which
     // a full aggregate budget alone is enough to cause. Same reasoning as a document face that
@@ -497,6 +505,30 @@ FontHandle FontManager::loadFontData(std::span<const uint8_t> data, FontDataTrus
   return FontHandle(entity);
 }
 
+FontHandle FontManager::loadFontFile(const std::filesystem::path& path, FontDataTrust trust) {
+  const Entity entity = registry_.create();
+  if (!loadFontFileIntoEntity(entity, path, trust)) {
+    registry_.destroy(entity);
+    return FontHandle();
+  }
+
+  return FontHandle(entity);
+}
+
+bool FontManager::loadFontFileIntoEntity(Entity entity, const std::filesystem::path& path,
+                                         FontDataTrust trust) {
+  FileMapResult mapped = MapFileBounded(path, budgetStateForRead()->maximumBytes);
+  if (const auto* error = std::get_if<FileReadError>(&mapped)) {
+    std::cerr << "FontManager: Failed to load font file " << path << ": "
+              << FileReadErrorMessage(*error) << "\n";
+    return false;
+  }
+
+  const std::shared_ptr<const MappedFile>& file =
+      std::get<std::shared_ptr<const MappedFile>>(mapped);
+  return loadFontDataIntoEntity(entity, file->bytes(), trust, file);
+}
+
 bool FontManager::loadFontDataSharedIntoEntity(
     Entity entity, const std::shared_ptr<const std::vector<uint8_t>>& data, FontDataTrust trust) {
   if (!data) {
@@ -523,14 +555,24 @@ bool FontManager::loadFontDataSharedIntoEntity(
     return loaded;
   };
 
+  // A cached blob needs no decompression or validation, but it is admitted under the same budget
+  // checks a fresh load would face.
+  const std::optional<FontBlobSource> blobSource = fontBlobSource(*data);
+  if (blobSource) {
+    if (const std::optional<bool> loaded =
+            loadCachedFontBlob(entity, *blobSource, trust, &workLimitExceeded)) {
+      return finishLoad(*loaded);
+    }
+  }
+
   // WOFF fonts need decompression/reconstruction, so they create new owned buffers.
   if (magic == kWoffMagic) {
-    return finishLoad(loadWoff1(entity, *data, trust, &workLimitExceeded));
+    return finishLoad(loadWoff1(entity, *data, trust, &workLimitExceeded, blobSource));
   }
 
   if (magic == kWoff2Magic) {
 #ifdef DONNER_TEXT_WOFF2_ENABLED
-    return finishLoad(loadWoff2(entity, *data, trust, &workLimitExceeded));
+    return finishLoad(loadWoff2(entity, *data, trust, &workLimitExceeded, blobSource));
 #else
     std::cerr << "FontManager: WOFF2 font encountered but WOFF2 support not enabled. "
                  "Build with --config=text-full to enable.\n";
@@ -539,7 +581,7 @@ bool FontManager::loadFontDataSharedIntoEntity(
   }
 
   // Raw TTF/OTF: share the data via shared_ptr (no copy).
-  return finishLoad(setRawFontData(entity, data, trust, &workLimitExceeded));
+  return finishLoad(setRawFontData(entity, data, *data, trust, &workLimitExceeded, blobSource));
 }
 
 bool FontManager::isValidationRejectedSource(
@@ -596,7 +638,7 @@ std::optional<FontManager::GlyphOutlineComplexity> FontManager::glyphOutlineComp
   if (!font) {
     return std::nullopt;
   }
-  const auto complexity = font->sfnt.glyphOutlineComplexity(static_cast<std::size_t>(glyphIndex));
+  const auto complexity = font->sfnt().glyphOutlineComplexity(static_cast<std::size_t>(glyphIndex));
   if (!complexity) {
     return std::nullopt;
   }
@@ -612,7 +654,7 @@ std::optional<std::span<const uint8_t>> FontManager::sfntTable(FontHandle handle
     return std::nullopt;
   }
   const auto* font = registry_.try_get<LoadedFontComponent>(handle.entity());
-  return font ? font->sfnt.findTable(font->fontData(), tag) : std::nullopt;
+  return font ? font->sfnt().findTable(font->fontData(), tag) : std::nullopt;
 }
 
 bool FontManager::isValidatedFont(FontHandle handle) const {
@@ -635,6 +677,10 @@ size_t FontManager::compressedFontDecompressionAttempts() const {
   return budgetStateForRead()->compressedFontDecompressionAttempts;
 }
 
+size_t FontManager::sharedFontBlobHits() const {
+  return budgetStateForRead()->sharedFontBlobHits;
+}
+
 size_t FontManager::numValidationRejectedSources() const {
   return budgetStateForRead()->validationRejectedSources.size();
 }
@@ -646,10 +692,18 @@ FontHandle FontManager::fallbackFont() {
 
   const Entity entity = registry_.create();
 
-  // Load the embedded Public Sans font.
-  std::vector<uint8_t> data(embedded::kPublicSansMediumOtf.begin(),
-                            embedded::kPublicSansMediumOtf.end());
-  if (!setRawFontData(entity, std::move(data), FontDataTrust::Trusted)) {
+  // Load the embedded Public Sans font. Its bytes have static storage duration, so they are
+  // referenced in place with no owner.
+  const std::span<const uint8_t> data = embedded::kPublicSansMediumOtf;
+  bool loaded = false;
+  const std::optional<FontBlobSource> blobSource = fontBlobSource(data);
+  if (blobSource) {
+    loaded = loadCachedFontBlob(entity, *blobSource, FontDataTrust::Trusted).value_or(false);
+  }
+  if (!loaded) {
+    loaded = setRawFontData(entity, nullptr, data, FontDataTrust::Trusted, nullptr, blobSource);
+  }
+  if (!loaded) {
     registry_.destroy(entity);
     std::cerr << "FontManager: Failed to load embedded fallback font (Public Sans)\n";
     return FontHandle();
@@ -661,7 +715,8 @@ FontHandle FontManager::fallbackFont() {
 
 std::optional<fonts::SfntFont> FontManager::validateSfntForLoad(
     Entity entity, std::span<const uint8_t> data, FontDataTrust trust,
-    const std::shared_ptr<FontBudgetState>& budgetState, bool* validationWorkLimitExceeded) {
+    const std::shared_ptr<FontBudgetState>& budgetState, bool* validationWorkLimitExceeded,
+    std::size_t* validationWork) {
   if (validationWorkLimitExceeded) {
     *validationWorkLimitExceeded = false;
   }
@@ -689,6 +744,9 @@ std::optional<fonts::SfntFont> FontManager::validateSfntForLoad(
     assert(metrics.cffValidationWork <= remainingValidationWork);
     budgetState->usedValidationWork += metrics.cffValidationWork;
   }
+  if (validationWork) {
+    *validationWork = metrics.cffValidationWork;
+  }
   if (metrics.cffWorkLimitExceeded) {
     if (validationWorkLimitExceeded) {
       *validationWorkLimitExceeded = true;
@@ -699,36 +757,93 @@ std::optional<fonts::SfntFont> FontManager::validateSfntForLoad(
 }
 
 bool FontManager::setRawFontData(Entity entity, std::vector<uint8_t> data, FontDataTrust trust,
-                                 bool* validationWorkLimitExceeded) {
+                                 bool* validationWorkLimitExceeded,
+                                 const std::optional<FontBlobSource>& blobSource) {
+  // Moving the vector into its owner keeps the heap buffer, so the span stays valid.
+  auto owner = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+  return setRawFontData(entity, owner, *owner, trust, validationWorkLimitExceeded, blobSource);
+}
+
+bool FontManager::setRawFontData(Entity entity, std::shared_ptr<const void> owner,
+                                 std::span<const uint8_t> data, FontDataTrust trust,
+                                 bool* validationWorkLimitExceeded,
+                                 const std::optional<FontBlobSource>& blobSource) {
   const std::shared_ptr<FontBudgetState> budgetState = budgetStateForWrite();
-  auto sfnt = validateSfntForLoad(entity, data, trust, budgetState, validationWorkLimitExceeded);
+  std::size_t validationWork = 0;
+  auto sfnt = validateSfntForLoad(entity, data, trust, budgetState, validationWorkLimitExceeded,
+                                  &validationWork);
   if (!sfnt) {
     return false;
   }
 
+  return storeFontBlob(entity, blobSource, std::move(owner), data, std::move(*sfnt),
+                       validationWork, trust);
+}
+
+bool FontManager::storeFontBlob(Entity entity, const std::optional<FontBlobSource>& blobSource,
+                                std::shared_ptr<const void> owner, std::span<const uint8_t> data,
+                                fonts::SfntFont sfnt, std::size_t validationWork,
+                                FontDataTrust trust) {
+  // WOFF sources differ from the decompressed bytes, so the blob keeps a copy to compare lookups
+  // against; raw sources are the bytes themselves.
+  std::vector<uint8_t> compressedSource;
+  if (blobSource && !std::ranges::equal(blobSource->bytes, data)) {
+    compressedSource.assign(blobSource->bytes.begin(), blobSource->bytes.end());
+  }
+  std::shared_ptr<const FontBlob> blob = std::make_shared<const FontBlob>(
+      blobSource ? blobSource->key : ContentHash{}, std::move(owner), data, std::move(sfnt),
+      validationWork, std::move(compressedSource));
+  if (blobSource && fontBlobCache_ != nullptr) {
+    // Publish even if this registry's budget turns the font away below: the blob is valid, and
+    // another registry loading the same bytes can use it.
+    blob = fontBlobCache_->insert(std::move(blob));
+  }
+
   LoadedFontComponent font;
-  font.ownedData = std::move(data);
-  font.sfnt = std::move(*sfnt);
+  font.blob = std::move(blob);
   font.trust = trust;
   return storeLoadedFont(entity, std::move(font));
 }
 
-bool FontManager::setRawFontData(Entity entity,
-                                 std::shared_ptr<const std::vector<uint8_t>> sharedData,
-                                 FontDataTrust trust, bool* validationWorkLimitExceeded) {
-  if (!sharedData) {
-    return false;
+std::optional<FontBlobSource> FontManager::fontBlobSource(std::span<const uint8_t> source) const {
+  if (fontBlobCache_ == nullptr || !fontBlobCache_->enabled()) {
+    return std::nullopt;
+  }
+  return FontBlobSource{ContentHash::Of(source), source};
+}
+
+std::optional<bool> FontManager::loadCachedFontBlob(Entity entity,
+                                                    const FontBlobSource& blobSource,
+                                                    FontDataTrust trust,
+                                                    bool* validationWorkLimitExceeded) {
+  std::shared_ptr<const FontBlob> blob = fontBlobCache_->find(blobSource);
+  if (!blob) {
+    return std::nullopt;
   }
+
+  // Mirror validateSfntForLoad: storage is checked before any work is charged, and an untrusted
+  // load pays the work its validation cost, up to what the registry has left.
   const std::shared_ptr<FontBudgetState> budgetState = budgetStateForWrite();
-  auto sfnt =
-      validateSfntForLoad(entity, *sharedData, trust, budgetState, validationWorkLimitExceeded);
-  if (!sfnt) {
+  if (!canStoreLoadedFont(entity, blob->data().size(), 0, budgetState)) {
     return false;
   }
+  if (trust == FontDataTrust::Untrusted) {
+    assert(budgetState->usedValidationWork <= budgetState->maximumValidationWork);
+    const size_t remainingValidationWork =
+        budgetState->maximumValidationWork - budgetState->usedValidationWork;
+    if (blob->validationWork() > remainingValidationWork) {
+      budgetState->usedValidationWork = budgetState->maximumValidationWork;
+      if (validationWorkLimitExceeded) {
+        *validationWorkLimitExceeded = true;
+      }
+      return false;
+    }
+    budgetState->usedValidationWork += blob->validationWork();
+  }
 
+  ++budgetState->sharedFontBlobHits;
   LoadedFontComponent font;
-  font.sharedData = std::move(sharedData);
-  font.sfnt = std::move(*sfnt);
+  font.blob = std::move(blob);
   font.trust = trust;
   return storeLoadedFont(entity, std::move(font));
 }
@@ -755,7 +870,7 @@ std::shared_ptr<FontManager::FontBudgetState> FontManager::budgetStateForWrite()
 bool FontManager::storeLoadedFont(Entity entity, LoadedFontComponent font) {
   const std::shared_ptr<FontBudgetState> budgetState = budgetStateForWrite();
   const size_t rawBytes = font.fontData().size();
-  const size_t indexBytes = font.sfnt.retainedBytes();
+  const size_t indexBytes = font.sfnt().retainedBytes();
   if (!canStoreLoadedFont(entity, rawBytes, indexBytes, budgetState)) {
     return false;
   }
@@ -794,7 +909,8 @@ bool FontManager::canStoreLoadedFont(Entity entity, size_t rawBytes, size_t inde
 }
 
 bool FontManager::loadWoff1(Entity entity, std::span<const uint8_t> data, FontDataTrust trust,
-                            bool* validationWorkLimitExceeded) {
+                            bool* validationWorkLimitExceeded,
+                            const std::optional<FontBlobSource>& blobSource) {
   const std::shared_ptr<FontBudgetState> budgetState = budgetStateForWrite();
   ++budgetState->compressedFontDecompressionAttempts;
   fonts::WoffParser::Options options;
@@ -807,11 +923,12 @@ bool FontManager::loadWoff1(Entity entity, std::span<const uint8_t> data, FontDa
 
   // Reconstruct sfnt byte stream from decompressed WOFF tables.
   std::vector<uint8_t> sfntData = reconstructSfnt(maybeFont.result());
-  return setRawFontData(entity, std::move(sfntData), trust, validationWorkLimitExceeded);
+  return setRawFontData(entity, std::move(sfntData), trust, validationWorkLimitExceeded,
+                        blobSource);
 }
 
 bool FontManager::loadFontDataIntoEntity(Entity entity, std::span<const uint8_t> data,
-                                         FontDataTrust trust) {
+                                         FontDataTrust trust, std::shared_ptr<const void> owner) {
   if (data.size() < 4) {
     return false;
   }
@@ -825,13 +942,20 @@ bool FontManager::loadFontDataIntoEntity(Entity entity, std::span<const uint8_t>
   const std::shared_ptr<FontBudgetState> budgetState = budgetStateForWrite();
   if (exhaustedValidationBudgetRejects(data, trust, budgetState)) return false;
 
+  const std::optional<FontBlobSource> blobSource = fontBlobSource(data);
+  if (blobSource) {
+    if (const std::optional<bool> loaded = loadCachedFontBlob(entity, *blobSource, trust)) {
+      return *loaded;
+    }
+  }
+
   if (magic == kWoffMagic) {
-    return loadWoff1(entity, data, trust);
+    return loadWoff1(entity, data, trust, nullptr, blobSource);
   }
 
   if (magic == kWoff2Magic) {
 #ifdef DONNER_TEXT_WOFF2_ENABLED
-    return loadWoff2(entity, data, trust);
+    return loadWoff2(entity, data, trust, nullptr, blobSource);
 #else
     std::cerr << "FontManager: WOFF2 font encountered but WOFF2 support not enabled. "
                  "Build with --config=text-full to enable.\n";
@@ -840,23 +964,27 @@ bool FontManager::loadFontDataIntoEntity(Entity entity, std::span<const uint8_t>
   }
 
   // Validate and budget the retained index before copying the untrusted byte stream.
-  auto sfnt = validateSfntForLoad(entity, data, trust, budgetState);
+  std::size_t validationWork = 0;
+  auto sfnt = validateSfntForLoad(entity, data, trust, budgetState, nullptr, &validationWork);
   if (!sfnt) {
     return false;
   }
   if (!canStoreLoadedFont(entity, data.size(), sfnt->retainedBytes(), budgetState)) {
     return false;
   }
-  LoadedFontComponent font;
-  font.ownedData.assign(data.begin(), data.end());
-  font.sfnt = std::move(*sfnt);
-  font.trust = trust;
-  return storeLoadedFont(entity, std::move(font));
+  if (!owner) {
+    auto copy = std::make_shared<const std::vector<uint8_t>>(data.begin(), data.end());
+    data = *copy;
+    owner = std::move(copy);
+  }
+  return storeFontBlob(entity, blobSource, std::move(owner), data, std::move(*sfnt),
+                       validationWork, trust);
 }
 
 #ifdef DONNER_TEXT_WOFF2_ENABLED
 bool FontManager::loadWoff2(Entity entity, std::span<const uint8_t> data, FontDataTrust trust,
-                            bool* validationWorkLimitExceeded) {
+                            bool* validationWorkLimitExceeded,
+                            const std::optional<FontBlobSource>& blobSource) {
   const std::shared_ptr<FontBudgetState> budgetState = budgetStateForWrite();
   ++budgetState->compressedFontDecompressionAttempts;
   fonts::Woff2Parser::Options options;
@@ -867,7 +995,8 @@ bool FontManager::loadWoff2(Entity entity, std::span<const uint8_t> data, FontDa
     return false;
   }
 
-  return setRawFontData(entity, std::move(result.result()), trust, validationWorkLimitExceeded);
+  return setRawFontData(entity, std::move(result.result()), trust, validationWorkLimitExceeded,
+                        blobSource);
 }
 #endif
 
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <span>
@@ -10,13 +11,16 @@
 #include <unordered_map>
 #include <vector>
 
+#include "donner/base/ContentHash.h"
 #include "donner/base/EcsRegistry.h"
 #include "donner/base/fonts/SfntUtils.h"
 #include "donner/css/FontFace.h"
+#include "donner/svg/resources/FontBlobCache.h"
 #include "donner/svg/resources/FontCatalogTypes.h"
 
 namespace donner::svg {
 
+
 /// Declares whether font bytes come from a trusted local source.
 enum class FontDataTrust {
   Untrusted,  ///< Document-provided or otherwise attacker-controlled bytes.
@@ -74,6 +78,7 @@ namespace donner::svg {
  * - Caching resolved family/style lookups to avoid repeated face scans.
  * - Falling back to the embedded Public Sans font when no match is found.
  * - Storing backend caches on the same font entity as the loaded bytes.
+ * - Sharing validated font bytes between managers through the opt-in \ref FontBlobCache.
  *
  * FontManager uses entt entities to store font data, with one entity per registered `@font-face`
  * rule or directly-loaded font. Text backends can cache parsed backend objects directly on the same
@@ -208,6 +213,20 @@ public:
   FontHandle loadFontData(std::span<const uint8_t> data,
                           FontDataTrust trust = FontDataTrust::Untrusted);
 
+  /**
+   * Load a TTF/OTF/WOFF font file from disk.
+   *
+   * Raw sfnt files are memory-mapped and referenced in place rather than copied, so fonts loaded
+   * from the same file by many managers share one set of pages. The file must not be rewritten in
+   * place while loaded (see \ref MappedFile).
+   *
+   * @param path Font file to load.
+   * @param trust Whether the source is trusted enough for length-unaware font backends.
+   * @return A valid FontHandle on success, or an invalid handle on failure.
+   */
+  FontHandle loadFontFile(const std::filesystem::path& path,
+                          FontDataTrust trust = FontDataTrust::Untrusted);
+
   /**
    * Get the raw font data bytes for a handle.
    *
@@ -250,6 +269,22 @@ public:
   /// Compressed-font decompression attempts performed for this registry.
   size_t compressedFontDecompressionAttempts() const;
 
+  /**
+   * Loads in this registry satisfied by an already-validated \ref FontBlob from the attached
+   * \ref FontBlobCache. Those loads skip decompression and validation, but untrusted ones are
+   * still charged the blob's recorded validation work in \ref fontValidationWork, so the cache
+   * never changes which fonts a registry admits.
+   */
+  size_t sharedFontBlobHits() const;
+
+  /**
+   * Use \p cache, instead of \ref FontBlobCache::Global, to share validated fonts with other
+   * managers. Pass nullptr to load every font privately. Fonts already loaded are unaffected.
+   *
+   * The cache is borrowed, not owned, and must outlive this FontManager.
+   */
+  void setFontBlobCache(FontBlobCache* cache) { fontBlobCache_ = cache; }
+
   /**
    * Get the number of registered `@font-face` rules.
    */
@@ -321,13 +356,50 @@ private:
    * Internal: load raw TTF/OTF data (not WOFF) from an owned buffer.
    *
    * @param entity Target entity.
-   * @param data Owned font data buffer. Must remain valid for the lifetime of the FontManager.
+   * @param data Owned font data buffer.
+   * @param blobSource Source bytes and their hash when the result should be published to the
+   *   \ref FontBlobCache.
    * @return True on success.
    */
   bool setRawFontData(Entity entity, std::vector<uint8_t> data, FontDataTrust trust,
-                      bool* validationWorkLimitExceeded = nullptr);
-  bool setRawFontData(Entity entity, std::shared_ptr<const std::vector<uint8_t>> sharedData,
-                      FontDataTrust trust, bool* validationWorkLimitExceeded = nullptr);
+                      bool* validationWorkLimitExceeded = nullptr,
+                      const std::optional<FontBlobSource>& blobSource = std::nullopt);
+
+  /**
+   * Internal: load raw TTF/OTF data (not WOFF) referenced in place.
+   *
+   * @param entity Target entity.
+   * @param owner Keeps \p data alive, or null when \p data has static storage duration.
+   * @param data Font bytes, never copied.
+   * @param blobSource Source bytes and their hash when the result should be published to the
+   *   \ref FontBlobCache.
+   * @return True on success.
+   */
+  bool setRawFontData(Entity entity, std::shared_ptr<const void> owner,
+                      std::span<const uint8_t> data, FontDataTrust trust,
+                      bool* validationWorkLimitExceeded = nullptr,
+                      const std::optional<FontBlobSource>& blobSource = std::nullopt);
+
+  /// Store validated bytes on \p entity as a \ref FontBlob, publishing it under \p blobSource.
+  bool storeFontBlob(Entity entity, const std::optional<FontBlobSource>& blobSource,
+                     std::shared_ptr<const void> owner, std::span<const uint8_t> data,
+                     fonts::SfntFont sfnt, std::size_t validationWork, FontDataTrust trust);
+
+  /// \p source and its content hash if a \ref FontBlobCache is attached and enabled.
+  std::optional<FontBlobSource> fontBlobSource(std::span<const uint8_t> source) const;
+
+  /**
+   * Load the cached blob for \p blobSource onto \p entity. The blob goes through the same
+   * validation-budget and storage checks as a fresh load with \p trust: an untrusted load is
+   * charged the blob's recorded validation work, and rejected if that exceeds what is left.
+   *
+   * @param validationWorkLimitExceeded Set when the blob was rejected for its validation work.
+   * @return std::nullopt on a cache miss, otherwise whether the blob was admitted to this
+   *   registry's budget.
+   */
+  std::optional<bool> loadCachedFontBlob(Entity entity, const FontBlobSource& blobSource,
+                                         FontDataTrust trust,
+                                         bool* validationWorkLimitExceeded = nullptr);
 
   /** Return the registry budget when installed, otherwise this manager's private candidate. */
   std::shared_ptr<const FontBudgetState> budgetStateForRead() const;
@@ -356,7 +428,7 @@ private:
   std::optional<fonts::SfntFont> validateSfntForLoad(
       Entity entity, std::span<const uint8_t> data, FontDataTrust trust,
       const std::shared_ptr<FontBudgetState>& budgetState,
-      bool* validationWorkLimitExceeded = nullptr);
+      bool* validationWorkLimitExceeded = nullptr, std::size_t* validationWork = nullptr);
 
   /**
    * Internal: load a WOFF 1.0 font by parsing and reconstructing the sfnt byte stream.
@@ -366,7 +438,8 @@ private:
    * @return True on success.
    */
   bool loadWoff1(Entity entity, std::span<const uint8_t> data, FontDataTrust trust,
-                 bool* validationWorkLimitExceeded = nullptr);
+                 bool* validationWorkLimitExceeded = nullptr,
+                 const std::optional<FontBlobSource>& blobSource = std::nullopt);
 
 #ifdef DONNER_TEXT_WOFF2_ENABLED
   /**
@@ -379,7 +452,8 @@ private:
    * @return True on success.
    */
   bool loadWoff2(Entity entity, std::span<const uint8_t> data, FontDataTrust trust,
-                 bool* validationWorkLimitExceeded = nullptr);
+                 bool* validationWorkLimitExceeded = nullptr,
+                 const std::optional<FontBlobSource>& blobSource = std::nullopt);
 #endif
 
   /**
@@ -387,9 +461,16 @@ private:
    *
    * @param entity Target entity.
    * @param data Raw font file bytes.
+   * @param owner When set, keeps \p data alive and raw sfnt bytes are referenced in place instead
+   *   of copied.
    * @return True on success.
    */
-  bool loadFontDataIntoEntity(Entity entity, std::span<const uint8_t> data, FontDataTrust trust);
+  bool loadFontDataIntoEntity(Entity entity, std::span<const uint8_t> data, FontDataTrust trust,
+                              std::shared_ptr<const void> owner = nullptr);
+
+  /// Internal: map the font file at \p path and load it into an existing entity.
+  bool loadFontFileIntoEntity(Entity entity, const std::filesystem::path& path,
+                              FontDataTrust trust);
 
   /// Number of immutable @font-face sources memoized after permanent validation rejection.
   size_t numValidationRejectedSources() const;
@@ -464,6 +545,9 @@ private:
   /// Optional external provider (embedded/system catalog), borrowed. May be nullptr.
   const FontFamilyProvider* provider_ = nullptr;
 
+  /// Process-shared validated font cache, borrowed. May be nullptr.
+  FontBlobCache* fontBlobCache_;
+
   /**
    * Candidate aggregate budget installed by this manager if it performs the registry's first load.
    *
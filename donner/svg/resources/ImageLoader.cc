@@ -6,6 +6,9 @@
 #include <limits>
 #include <optional>
 
+#include "donner/base/ContentHash.h"
+#include "donner/svg/resources/DecodedImageCache.h"
+
 namespace donner::svg {
 
 namespace {
@@ -83,12 +86,16 @@ std::optional<size_t> RgbaByteSize(int width, int height) {
   return widthSize * heightSize * kRgbaChannels;
 }
 
+/// Allow known formats and an empty mime type (stb_image will auto-detect).
+bool IsSupportedRasterMimeType(std::string_view mimeType) {
+  return mimeType == "" || mimeType == "image/png" || mimeType == "image/jpeg" ||
+         mimeType == "image/jpg" || mimeType == "image/gif";
+}
+
 std::variant<ImageResource, UrlLoaderError> LoadImage(std::string_view mimeType,
                                                       const std::vector<uint8_t>& fileContents,
                                                       size_t maximumDecodedImageSize) {
-  // Allow known formats and an empty mime type (stb_image will auto-detect)
-  if (mimeType != "" && mimeType != "image/png" && mimeType != "image/jpeg" &&
-      mimeType != "image/jpg" && mimeType != "image/gif") {
+  if (!IsSupportedRasterMimeType(mimeType)) {
     return UrlLoaderError::UnsupportedFormat;
   }
 
@@ -170,11 +177,41 @@ ImageLoader::Result ImageLoader::fromUri(std::string_view uri) {
   const size_t remainingDecodedBytes =
       remainingResourceBytes_ != nullptr ? *remainingResourceBytes_ : maximumDecodedImageSize_;
   const size_t decodedLimit = std::min(maximumDecodedImageSize_, remainingDecodedBytes);
+  const auto rejectTooLarge = [this] {
+    if (remainingResourceBytes_ != nullptr) {
+      *remainingResourceBytes_ = 0;
+    }
+    return UrlLoaderError::ResourceTooLarge;
+  };
+
+  // With the process-wide cache enabled, identical encoded bytes decode once per process rather
+  // than once per document, and every document borrows the one shared copy of the pixels. A hit
+  // is held to the same format and size limits as a fresh decode, so enabling the cache never
+  // lets a document load an image it would otherwise reject.
+  DecodedImageCache* const cache =
+      decodedImageCache_ != nullptr && decodedImageCache_->enabled() ? decodedImageCache_ : nullptr;
+  std::optional<ContentHash> key;
+  if (cache != nullptr && IsSupportedRasterMimeType(urlResult.mimeType)) {
+    key = ContentHash::Of(urlResult.data);
+    if (std::shared_ptr<const DecodedImage> entry = cache->find(*key, urlResult.data)) {
+      const size_t decodedSize = entry->pixels().size();
+      if (decodedSize > decodedLimit) {
+        return rejectTooLarge();
+      }
+      if (remainingResourceBytes_ != nullptr) {
+        *remainingResourceBytes_ -= decodedSize;
+      }
+      const int width = entry->width();
+      const int height = entry->height();
+      return ImageResource{{}, width, height, std::move(entry)};
+    }
+  }
+
   auto rasterResult = LoadImage(urlResult.mimeType, urlResult.data, decodedLimit);
   if (std::holds_alternative<UrlLoaderError>(rasterResult)) {
     const UrlLoaderError error = std::get<UrlLoaderError>(rasterResult);
-    if (error == UrlLoaderError::ResourceTooLarge && remainingResourceBytes_ != nullptr) {
-      *remainingResourceBytes_ = 0;
+    if (error == UrlLoaderError::ResourceTooLarge) {
+      return rejectTooLarge();
     }
     return error;
   }
@@ -184,6 +221,11 @@ ImageLoader::Result ImageLoader::fromUri(std::string_view uri) {
     // LoadImage checked this against the current budget before asking stb_image to allocate.
     *remainingResourceBytes_ -= result.data.size();
   }
+  if (key.has_value()) {
+    result.shared =
+        cache->insert(*key, urlResult.data, std::move(result.data), result.width, result.height);
+    result.data.clear();
+  }
   return result;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 /// @file
 
+#include "donner/svg/resources/DecodedImageCache.h"
 #include "donner/svg/resources/ImageResource.h"
 #include "donner/svg/resources/UrlLoader.h"
 
@@ -63,6 +64,14 @@ public:
    */
   Result fromUri(std::string_view uri);
 
+  /**
+   * Override the decoded-image cache consulted by \ref fromUri, which defaults to
+   * \ref DecodedImageCache::Global. Pass \c nullptr to always decode.
+   *
+   * @param cache Cache to use; must outlive this loader.
+   */
+  void setDecodedImageCache(DecodedImageCache* cache) { decodedImageCache_ = cache; }
+
 private:
   /// Loader used for decoding the data URL or fetching the external resources.
   UrlLoader urlLoader_;
@@ -72,6 +81,9 @@ private:
 
   /// Maximum decoded RGBA bytes returned for one raster image.
   size_t maximumDecodedImageSize_;
+
+  /// Process-wide cache of decoded pixels, only consulted while it is enabled.
+  DecodedImageCache* decodedImageCache_ = &DecodedImageCache::Global();
 };
 
 }  // namespace donner::svg
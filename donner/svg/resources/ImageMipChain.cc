@@ -0,0 +1,102 @@
+#include "donner/svg/resources/ImageMipChain.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+namespace donner::svg {
+
+ImageMipChain::ImageMipChain(ImageMipChain&& other) noexcept {
+  std::lock_guard<std::mutex> lock(other.mutex_);
+  levels_ = std::move(other.levels_);
+  other.levels_.clear();
+}
+
+ImageMipChain& ImageMipChain::operator=(ImageMipChain&& other) noexcept {
+  if (this != &other) {
+    std::scoped_lock lock(mutex_, other.mutex_);
+    levels_ = std::move(other.levels_);
+    other.levels_.clear();
+  }
+  return *this;
+}
+
+int ImageMipChain::LevelCount(int width, int height) {
+  int count = 1;
+  while (width > 1 || height > 1) {
+    width = std::max(1, (width + 1) / 2);
+    height = std::max(1, (height + 1) / 2);
+    ++count;
+  }
+  return count;
+}
+
+ImageMipChain::Level ImageMipChain::Downsample(std::span<const std::uint8_t> pixels, int width,
+                                               int height) {
+  assert(pixels.size() == static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4u);
+
+  Level result;
+  result.width = std::max(1, (width + 1) / 2);
+  result.height = std::max(1, (height + 1) / 2);
+  result.pixels.resize(static_cast<std::size_t>(result.width) *
+                       static_cast<std::size_t>(result.height) * 4u);
+
+  const std::size_t sourceStride = static_cast<std::size_t>(width) * 4u;
+  std::uint8_t* out = result.pixels.data();
+  for (int y = 0; y < result.height; ++y) {
+    const std::size_t row0 = static_cast<std::size_t>(std::min(2 * y, height - 1)) * sourceStride;
+    const std::size_t row1 =
+        static_cast<std::size_t>(std::min(2 * y + 1, height - 1)) * sourceStride;
+    for (int x = 0; x < result.width; ++x) {
+      const std::size_t col0 = static_cast<std::size_t>(std::min(2 * x, width - 1)) * 4u;
+      const std::size_t col1 = static_cast<std::size_t>(std::min(2 * x + 1, width - 1)) * 4u;
+      for (std::size_t channel = 0; channel < 4u; ++channel) {
+        const unsigned sum = pixels[row0 + col0 + channel] + pixels[row0 + col1 + channel] +
+                             pixels[row1 + col0 + channel] + pixels[row1 + col1 + channel];
+        *out++ = static_cast<std::uint8_t>((sum + 2u) / 4u);
+      }
+    }
+  }
+
+  return result;
+}
+
+const ImageMipChain::Level& ImageMipChain::level(std::span<const std::uint8_t> basePixels,
+                                                 int width, int height, int index) {
+  assert(index >= 1);
+  index = std::clamp(index, 1, std::max(1, LevelCount(width, height) - 1));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (static_cast<int>(levels_.size()) < index) {
+    if (levels_.empty()) {
+      levels_.push_back(std::make_unique<const Level>(Downsample(basePixels, width, height)));
+    } else {
+      const Level& previous = *levels_.back();
+      levels_.push_back(std::make_unique<const Level>(
+          Downsample(previous.pixels, previous.width, previous.height)));
+    }
+  }
+
+  return *levels_[static_cast<std::size_t>(index - 1)];
+}
+
+int ImageMipChain::builtLevelCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int>(levels_.size());
+}
+
+std::size_t ImageMipChain::residentBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::size_t bytes = 0;
+  for (const std::unique_ptr<const Level>& level : levels_) {
+    bytes += level->pixels.size();
+  }
+  return bytes;
+}
+
+void ImageMipChain::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  levels_.clear();
+}
+
+}  // namespace donner::svg
@@ -0,0 +1,82 @@
+#pragma once
+/// @file
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace donner::svg {
+
+/**
+ * Lazily built chain of successively half-size, box-filtered copies of a premultiplied RGBA8
+ * image, used to sample heavily minified images without aliasing and without touching every
+ * full-resolution source pixel on every draw.
+ *
+ * Level 0 is the caller's base image and is never copied; level `n` is `max(1, ceil(w / 2^n))` by
+ * `max(1, ceil(h / 2^n))`, each pixel the average of the 2x2 block beneath it (edge pixels are
+ * repeated for odd extents). Averaging premultiplied values is what makes the filter correct at
+ * partially transparent edges.
+ *
+ * The chain is stored next to the payload it derives from (the process-wide \ref DecodedImage or a
+ * renderer's per-entity image cache) so repeated draws share it. Levels are built on first request
+ * and then immutable; \ref level is safe to call concurrently, and returned levels stay valid until
+ * \ref reset or destruction.
+ */
+class ImageMipChain {
+public:
+  /// One downsampled level.
+  struct Level {
+    std::vector<std::uint8_t> pixels;  //!< Tightly packed premultiplied RGBA8.
+    int width = 0;                     //!< Width in pixels.
+    int height = 0;                    //!< Height in pixels.
+  };
+
+  /// Construct an empty chain.
+  ImageMipChain() = default;
+
+  /// Move constructor, for storage in ECS components. The source chain is left empty.
+  ImageMipChain(ImageMipChain&& other) noexcept;
+
+  /// Move assignment operator. The source chain is left empty.
+  ImageMipChain& operator=(ImageMipChain&& other) noexcept;
+
+  // No copy: levels are shared by reference to the owning payload instead.
+  ImageMipChain(const ImageMipChain&) = delete;
+  ImageMipChain& operator=(const ImageMipChain&) = delete;
+
+  /// Number of levels (including level 0) a `width` x `height` image has.
+  static int LevelCount(int width, int height);
+
+  /// Downsample one premultiplied RGBA8 image by two in each axis with a 2x2 box filter.
+  static Level Downsample(std::span<const std::uint8_t> pixels, int width, int height);
+
+  /**
+   * Returns level \p index (>= 1) of the chain over \p basePixels, building it and every level
+   * before it on first use. Every call on the same chain must pass the same base image.
+   *
+   * @param basePixels Level 0: tightly packed premultiplied RGBA8.
+   * @param width Level 0 width.
+   * @param height Level 0 height.
+   * @param index Requested level, clamped to the last level.
+   */
+  const Level& level(std::span<const std::uint8_t> basePixels, int width, int height, int index);
+
+  /// Number of levels beyond level 0 built so far.
+  int builtLevelCount() const;
+
+  /// Total bytes held by built levels.
+  std::size_t residentBytes() const;
+
+  /// Drop every built level, e.g. after the base image changed.
+  void reset();
+
+private:
+  mutable std::mutex mutex_;
+  /// `levels_[i]` is level `i + 1`. Boxed so references stay valid as the vector grows.
+  std::vector<std::unique_ptr<const Level>> levels_;
+};
+
+}  // namespace donner::svg
@@ -2,13 +2,18 @@
 /// @file
 
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <vector>
 
+#include "donner/svg/resources/DecodedImage.h"
+
 namespace donner::svg {
 
 /// Contains a decoded image resource in RGBA format.
 struct ImageResource {
-  /// Pixel data in RGBA format.
+  /// Pixel data in RGBA format owned by this resource. Empty while the pixels are borrowed from
+  /// \ref shared; read them through \ref pixels, which covers both cases.
   std::vector<uint8_t> data;
 
   /// Width of the image, in pixels.
@@ -16,6 +21,27 @@ struct ImageResource {
 
   /// Height of the image, in pixels.
   int height;
+
+  /// Process-wide shared payload whose pixels this resource borrows, set by \ref ImageLoader when
+  /// the \ref DecodedImageCache is enabled. Renderers may also sample the shared entry's derived
+  /// forms (such as its premultiplied pixels) instead of deriving their own. Code that edits the
+  /// pixels in place must call \ref detach first.
+  std::shared_ptr<const DecodedImage> shared;
+
+  /// Pixel data in RGBA format, from \ref shared when set and from \ref data otherwise.
+  std::span<const uint8_t> pixels() const {
+    return shared != nullptr ? shared->pixels() : std::span<const uint8_t>(data);
+  }
+
+  /// Copy borrowed pixels into \ref data and drop \ref shared, so the pixels can be edited without
+  /// affecting other documents. No-op if the pixels are already owned.
+  void detach() {
+    if (shared != nullptr) {
+      const std::span<const uint8_t> borrowed = shared->pixels();
+      data.assign(borrowed.begin(), borrowed.end());
+      shared.reset();
+    }
+  }
 };
 
 }  // namespace donner::svg
@@ -18,7 +18,8 @@ namespace donner::svg {
  * families report \ref FontSource::System.
  *
  * On non-Apple platforms this is a stub: it enumerates nothing and loads nothing, so the catalog
- * still compiles and behaves (embedded fonts only).
+ * still compiles and behaves (embedded fonts only). On Linux, \ref FontCatalog uses a \ref
+ * FontDirectoryProvider over the standard font directories instead.
  */
 class SystemFontProvider : public FontFamilyProvider {
 public:
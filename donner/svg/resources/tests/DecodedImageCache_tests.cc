@@ -0,0 +1,191 @@
+#include "donner/svg/resources/DecodedImageCache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace donner::svg {
+namespace {
+
+std::vector<std::uint8_t> SolidPixels(int width, int height, std::uint8_t alpha) {
+  std::vector<std::uint8_t> pixels;
+  for (int i = 0; i < width * height; ++i) {
+    pixels.insert(pixels.end(), {200, 100, 50, alpha});
+  }
+  return pixels;
+}
+
+std::span<const std::uint8_t> Bytes(std::string_view encoded) {
+  return {reinterpret_cast<const std::uint8_t*>(encoded.data()),  // NOLINT: byte view.
+          encoded.size()};
+}
+
+/// Inserts a \p width x \p height solid image as if decoded from \p encoded.
+std::shared_ptr<const DecodedImage> InsertSolid(DecodedImageCache& cache, std::string_view encoded,
+                                                int width, int height, std::uint8_t alpha = 255) {
+  return cache.insert(ContentHash::Of(encoded), Bytes(encoded), SolidPixels(width, height, alpha),
+                      width, height);
+}
+
+std::shared_ptr<const DecodedImage> Find(DecodedImageCache& cache, std::string_view encoded) {
+  return cache.find(ContentHash::Of(encoded), Bytes(encoded));
+}
+
+void HalveColorChannels(std::span<const std::uint8_t> rgba, std::vector<std::uint8_t>& out) {
+  out.assign(rgba.begin(), rgba.end());
+  for (size_t i = 0; i + 3 < out.size(); i += 4) {
+    out[i] /= 2;
+    out[i + 1] /= 2;
+    out[i + 2] /= 2;
+  }
+}
+
+TEST(DecodedImageCache, DisabledByDefault) {
+  DecodedImageCache cache;
+  EXPECT_FALSE(cache.enabled());
+
+  auto entry = InsertSolid(cache, "png bytes", 2, 2);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(Find(cache, "png bytes"), nullptr);
+  EXPECT_EQ(cache.stats().entryCount, 0u);
+}
+
+TEST(DecodedImageCache, FindReturnsSharedEntry) {
+  DecodedImageCache cache(1024);
+
+  auto inserted = InsertSolid(cache, "png bytes", 2, 2);
+  auto found = Find(cache, "png bytes");
+  EXPECT_EQ(found, inserted);
+  EXPECT_EQ(found->width(), 2);
+  EXPECT_EQ(found->pixels().size(), 16u);
+
+  EXPECT_EQ(Find(cache, "other bytes"), nullptr);
+
+  const DecodedImageCache::Stats stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.insertions, 1u);
+  EXPECT_EQ(stats.entryCount, 1u);
+  // Encoded bytes, straight plus premultiplied pixels, plus a third for the mip chain.
+  EXPECT_EQ(stats.residentBytes, 9u + 16u + 16u + 5u);
+}
+
+TEST(DecodedImageCache, DuplicateInsertConvergesOnResidentEntry) {
+  DecodedImageCache cache(1024);
+
+  auto first = InsertSolid(cache, "png bytes", 2, 2);
+  auto second = InsertSolid(cache, "png bytes", 2, 2);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(cache.stats().insertions, 1u);
+}
+
+/// The content hash is not collision resistant, so a lookup whose hash matches but whose encoded
+/// bytes differ must miss rather than return another input's pixels.
+TEST(DecodedImageCache, HashCollisionMisses) {
+  DecodedImageCache cache(1024);
+  const ContentHash key = ContentHash::Of("victim png");
+
+  auto victim = cache.insert(key, Bytes("victim png"), SolidPixels(2, 2, 255), 2, 2);
+  EXPECT_EQ(cache.find(key, Bytes("forged png")), nullptr);
+  EXPECT_EQ(cache.stats().misses, 1u);
+
+  // Publishing the colliding input neither replaces nor aliases the resident entry.
+  auto forged = cache.insert(key, Bytes("forged png"), SolidPixels(1, 1, 0), 1, 1);
+  ASSERT_NE(forged, nullptr);
+  EXPECT_NE(forged, victim);
+  EXPECT_EQ(forged->width(), 1);
+  EXPECT_EQ(cache.find(key, Bytes("victim png")), victim);
+  EXPECT_EQ(cache.stats().insertions, 1u);
+}
+
+TEST(DecodedImageCache, EvictsLeastRecentlyUsedUnderBudget) {
+  // Each 2x2 entry charges 38 bytes, so two fit.
+  DecodedImageCache cache(80);
+
+  auto entryA = InsertSolid(cache, "a", 2, 2);
+  InsertSolid(cache, "b", 2, 2);
+  // Touch `a` so `b` becomes the coldest entry.
+  EXPECT_NE(Find(cache, "a"), nullptr);
+  InsertSolid(cache, "c", 2, 2);
+
+  EXPECT_NE(Find(cache, "a"), nullptr);
+  EXPECT_EQ(Find(cache, "b"), nullptr);
+  EXPECT_NE(Find(cache, "c"), nullptr);
+  EXPECT_EQ(cache.stats().evictions, 1u);
+  EXPECT_EQ(cache.stats().residentBytes, 76u);
+
+  // Shrinking the budget evicts, but outstanding references keep the payload alive.
+  cache.setByteBudget(0);
+  EXPECT_EQ(cache.stats().entryCount, 0u);
+  EXPECT_EQ(entryA->pixels().size(), 16u);
+}
+
+TEST(DecodedImageCache, OversizedEntryIsNotRetained) {
+  DecodedImageCache cache(16);
+
+  auto entry = InsertSolid(cache, "big", 2, 2);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(Find(cache, "big"), nullptr);
+  EXPECT_EQ(cache.stats().residentBytes, 0u);
+}
+
+TEST(DecodedImageCache, PremultipliedIsDerivedOnce) {
+  DecodedImageCache cache(1024);
+  auto entry = InsertSolid(cache, "png", 1, 1, 128);
+  EXPECT_FALSE(entry->hasPremultiplied());
+
+  int conversions = 0;
+  const DecodedImage::PremultiplyFn convert = [&](std::span<const std::uint8_t> rgba,
+                                                  std::vector<std::uint8_t>& out) {
+    ++conversions;
+    HalveColorChannels(rgba, out);
+  };
+
+  const std::span<const std::uint8_t> first = entry->premultiplied(convert);
+  const std::span<const std::uint8_t> second = entry->premultiplied(convert);
+  EXPECT_EQ(conversions, 1);
+  EXPECT_TRUE(entry->hasPremultiplied());
+  EXPECT_EQ(first.data(), second.data());
+  EXPECT_EQ(std::vector<std::uint8_t>(first.begin(), first.end()),
+            (std::vector<std::uint8_t>{100, 50, 25, 128}));
+}
+
+TEST(DecodedImageCache, ConcurrentAccess) {
+  DecodedImageCache cache(1024 * 1024);
+  std::atomic<int> conversions = 0;
+  const DecodedImage::PremultiplyFn convert = [&](std::span<const std::uint8_t> rgba,
+                                                  std::vector<std::uint8_t>& out) {
+    ++conversions;
+    HalveColorChannels(rgba, out);
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 200; ++i) {
+        const std::string encoded = std::to_string(i % 16);
+        std::shared_ptr<const DecodedImage> entry = Find(cache, encoded);
+        if (!entry) {
+          entry = InsertSolid(cache, encoded, 4, 4, 128);
+        }
+        EXPECT_EQ(entry->premultiplied(convert).size(), 64u);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(cache.stats().entryCount, 16u);
+  EXPECT_EQ(conversions.load(), 16);
+}
+
+}  // namespace
+}  // namespace donner::svg
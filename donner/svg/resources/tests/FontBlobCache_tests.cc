@@ -0,0 +1,98 @@
+#include "donner/svg/resources/FontBlobCache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "embed_resources/PublicSansFont.h"
+
+namespace donner::svg {
+namespace {
+
+std::span<const uint8_t> Bytes(std::string_view source) {
+  return {reinterpret_cast<const uint8_t*>(source.data()), source.size()};  // NOLINT: byte view.
+}
+
+FontBlobSource Source(std::string_view source) {
+  return {ContentHash::Of(source), Bytes(source)};
+}
+
+/// A blob for the embedded font as if decompressed from the (compressed) bytes \p source.
+std::shared_ptr<const FontBlob> MakeBlob(std::string_view source,
+                                         std::string_view keySource = {}) {
+  const std::span<const uint8_t> data = embedded::kPublicSansMediumOtf;
+  auto sfnt = fonts::SfntFont::Validate(data);
+  EXPECT_TRUE(sfnt.has_value());
+  const std::span<const uint8_t> bytes = Bytes(source);
+  return std::make_shared<const FontBlob>(
+      ContentHash::Of(keySource.empty() ? source : keySource), nullptr, data, std::move(*sfnt), 0,
+      std::vector<uint8_t>(bytes.begin(), bytes.end()));
+}
+
+TEST(FontBlobCache, DisabledByDefault) {
+  FontBlobCache cache;
+  EXPECT_FALSE(cache.enabled());
+
+  auto blob = MakeBlob("font");
+  EXPECT_EQ(cache.insert(blob), blob);
+  EXPECT_EQ(cache.find(Source("font")), nullptr);
+  EXPECT_EQ(cache.stats().entryCount, 0u);
+}
+
+TEST(FontBlobCache, DuplicateInsertConvergesOnResidentBlob) {
+  FontBlobCache cache(16 * 1024 * 1024);
+  auto first = MakeBlob("font");
+  auto second = MakeBlob("font");
+
+  EXPECT_EQ(cache.insert(first), first);
+  EXPECT_EQ(cache.insert(second), first);
+  EXPECT_EQ(cache.find(Source("font")), first);
+  EXPECT_EQ(cache.stats().insertions, 1u);
+  EXPECT_EQ(cache.stats().residentBytes, first->chargedBytes());
+}
+
+TEST(FontBlobCache, EvictsLeastRecentlyUsedUnderBudget) {
+  auto a = MakeBlob("a");
+  auto b = MakeBlob("b");
+  auto c = MakeBlob("c");
+  FontBlobCache cache(a->chargedBytes() * 2);
+
+  cache.insert(a);
+  cache.insert(b);
+  // Touch `a` so `b` becomes the coldest blob.
+  EXPECT_NE(cache.find(Source("a")), nullptr);
+  cache.insert(c);
+
+  EXPECT_NE(cache.find(Source("a")), nullptr);
+  EXPECT_EQ(cache.find(Source("b")), nullptr);
+  EXPECT_NE(cache.find(Source("c")), nullptr);
+  EXPECT_EQ(cache.stats().evictions, 1u);
+
+  // Evicted blobs stay valid for their holders.
+  EXPECT_TRUE(b->sfnt().hasTable("CFF "));
+}
+
+/// The content hash is not collision resistant, so a hit requires the source bytes to match too.
+TEST(FontBlobCache, HashCollisionMisses) {
+  FontBlobCache cache(16 * 1024 * 1024);
+  auto victim = MakeBlob("victim font");
+  ASSERT_EQ(cache.insert(victim), victim);
+
+  const FontBlobSource forged{victim->key(), Bytes("forged font")};
+  EXPECT_EQ(cache.find(forged), nullptr);
+  EXPECT_EQ(cache.stats().misses, 1u);
+
+  // Publishing a colliding blob neither replaces nor aliases the resident one.
+  auto colliding = MakeBlob("forged font", "victim font");
+  ASSERT_EQ(colliding->key(), victim->key());
+  EXPECT_EQ(cache.insert(colliding), colliding);
+  EXPECT_EQ(cache.find(Source("victim font")), victim);
+  EXPECT_EQ(cache.stats().insertions, 1u);
+}
+
+}  // namespace
+}  // namespace donner::svg
@@ -0,0 +1,182 @@
+#include "donner/svg/resources/FontDirectoryProvider.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "donner/svg/core/FontStretch.h"
+#include "donner/svg/core/FontStyle.h"
+#include "donner/svg/resources/FontManager.h"
+
+namespace donner::svg {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr const char* kRobotoRegular = "third_party/roboto/Roboto-Regular.ttf";
+constexpr const char* kRobotoBold = "third_party/roboto/Roboto-Bold.ttf";
+
+std::vector<uint8_t> ReadFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>());
+}
+
+std::vector<std::string> FamilyNames(const std::vector<FontFamilyInfo>& infos) {
+  std::vector<std::string> names;
+  for (const FontFamilyInfo& info : infos) {
+    EXPECT_EQ(info.source, FontSource::System);
+    names.push_back(info.family);
+  }
+  return names;
+}
+
+/// A scratch font directory laid out like an installed font tree, with a nested subdirectory and
+/// files that must be skipped.
+class FontDirectoryProviderTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    root_ = std::filesystem::path(testing::TempDir()) /
+            ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::filesystem::remove_all(root_);
+    fontDir_ = root_ / "fonts";
+    std::filesystem::create_directories(fontDir_ / "truetype" / "roboto");
+    std::filesystem::copy_file(kRobotoRegular, fontDir_ / "truetype" / "roboto" / "Regular.ttf");
+    std::filesystem::copy_file(kRobotoBold, fontDir_ / "Bold.TTF");
+    std::ofstream(fontDir_ / "notes.txt") << "not a font";
+    std::ofstream(fontDir_ / "broken.ttf") << "not a font either";
+  }
+
+  void TearDown() override { std::filesystem::remove_all(root_); }
+
+  FontDirectoryProvider::Options MakeOptions() const {
+    return FontDirectoryProvider::Options{.directories = {fontDir_, root_ / "missing"},
+                                          .indexPath = root_ / "cache" / "font-index"};
+  }
+
+  std::filesystem::path root_;
+  std::filesystem::path fontDir_;
+};
+
+TEST_F(FontDirectoryProviderTest, EnumeratesFamiliesFromNameTables) {
+  FontDirectoryProvider provider(MakeOptions());
+
+  EXPECT_THAT(FamilyNames(provider.families()), ElementsAre("Roboto"));
+  EXPECT_TRUE(provider.hasFamily("roboto"));
+  EXPECT_FALSE(provider.hasFamily("Definitely Not Installed Font XYZ"));
+  EXPECT_TRUE(
+      provider.loadFamilyData("Definitely Not Installed Font XYZ", FontFaceRequest{}).empty());
+
+  const FontDirectoryProvider::ScanStats stats = provider.scanStats();
+  EXPECT_EQ(stats.fontFiles, 3u);
+  EXPECT_EQ(stats.parsedFiles, 3u);
+  EXPECT_EQ(stats.indexedFiles, 0u);
+  EXPECT_TRUE(stats.indexWritten);
+}
+
+TEST_F(FontDirectoryProviderTest, PicksTheFaceMatchingTheRequest) {
+  FontDirectoryProvider provider(MakeOptions());
+
+  EXPECT_EQ(provider.loadFamilyData("Roboto", FontFaceRequest{}), ReadFile(kRobotoRegular));
+  EXPECT_EQ(provider.loadFamilyData("Roboto", FontFaceRequest{.weight = 700}),
+            ReadFile(kRobotoBold));
+  // Neither face is italic, so an italic request still follows weight.
+  EXPECT_EQ(provider.familyFilePath("Roboto", FontFaceRequest{.weight = 800,
+                                                              .style = FontStyle::Italic}),
+            fontDir_ / "Bold.TTF");
+}
+
+TEST_F(FontDirectoryProviderTest, ReusesPersistentIndexUntilFilesChange) {
+  {
+    FontDirectoryProvider first(MakeOptions());
+    ASSERT_TRUE(first.scanStats().indexWritten);
+  }
+
+  FontDirectoryProvider second(MakeOptions());
+  FontDirectoryProvider::ScanStats stats = second.scanStats();
+  EXPECT_EQ(stats.fontFiles, 3u);
+  EXPECT_EQ(stats.parsedFiles, 0u);
+  EXPECT_EQ(stats.indexedFiles, 3u);
+  EXPECT_FALSE(stats.indexWritten);
+  EXPECT_THAT(FamilyNames(second.families()), ElementsAre("Roboto"));
+  EXPECT_EQ(second.familyFilePath("Roboto", FontFaceRequest{.weight = 700}),
+            fontDir_ / "Bold.TTF");
+
+  // Replacing a file changes its size, so only that file is read again.
+  std::filesystem::remove(fontDir_ / "broken.ttf");
+  std::filesystem::copy_file(kRobotoRegular, fontDir_ / "broken.ttf");
+  FontDirectoryProvider third(MakeOptions());
+  stats = third.scanStats();
+  EXPECT_EQ(stats.parsedFiles, 1u);
+  EXPECT_EQ(stats.indexedFiles, 2u);
+  EXPECT_TRUE(stats.indexWritten);
+}
+
+TEST_F(FontDirectoryProviderTest, IgnoresCorruptIndex) {
+  std::filesystem::create_directories(root_ / "cache");
+  std::ofstream(root_ / "cache" / "font-index")
+      << "donner-font-index 1\nnot\ta\trecord\n1\t2\t3\t4\t5\tInjected\t/nonexistent.ttf\n";
+
+  FontDirectoryProvider provider(MakeOptions());
+  EXPECT_THAT(FamilyNames(provider.families()), ElementsAre("Roboto"));
+  EXPECT_EQ(provider.scanStats().parsedFiles, 3u);
+}
+
+TEST_F(FontDirectoryProviderTest, UnindexablePathsDoNotRewriteTheIndex) {
+  // A tab cannot be stored in the tab-separated index, so this face is read on every scan.
+  std::filesystem::copy_file(kRobotoBold, fontDir_ / "tab\tname.ttf");
+  {
+    FontDirectoryProvider first(MakeOptions());
+    ASSERT_TRUE(first.scanStats().indexWritten);
+  }
+
+  FontDirectoryProvider second(MakeOptions());
+  const FontDirectoryProvider::ScanStats stats = second.scanStats();
+  EXPECT_EQ(stats.fontFiles, 4u);
+  EXPECT_EQ(stats.parsedFiles, 1u);
+  EXPECT_EQ(stats.indexedFiles, 3u);
+  EXPECT_FALSE(stats.indexWritten);
+  EXPECT_TRUE(second.hasFamily("Roboto"));
+}
+
+TEST_F(FontDirectoryProviderTest, ConcurrentScansWriteACompleteIndex) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back(
+        [this] { EXPECT_TRUE(FontDirectoryProvider(MakeOptions()).hasFamily("Roboto")); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // Each writer used a temporary file of its own, and every one was renamed into place.
+  for (const auto& entry : std::filesystem::directory_iterator(root_ / "cache")) {
+    EXPECT_EQ(entry.path().filename(), "font-index");
+  }
+  FontDirectoryProvider reader(MakeOptions());
+  EXPECT_EQ(reader.scanStats().indexedFiles, 3u);
+  EXPECT_FALSE(reader.scanStats().indexWritten);
+}
+
+TEST_F(FontDirectoryProviderTest, FontManagerMapsProviderFiles) {
+  FontDirectoryProvider provider(MakeOptions());
+  Registry registry;
+  FontManager manager(registry);
+  manager.setFontProvider(&provider);
+
+  const FontHandle bold = manager.findFont("Roboto", 700);
+  ASSERT_TRUE(static_cast<bool>(bold));
+  EXPECT_NE(bold, manager.fallbackFont());
+  EXPECT_TRUE(manager.isTrustedFont(bold));
+  const std::span<const uint8_t> data = manager.fontData(bold);
+  const std::vector<uint8_t> expected = ReadFile(kRobotoBold);
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), expected.begin(), expected.end()));
+}
+
+}  // namespace
+}  // namespace donner::svg
@@ -13,6 +13,7 @@
 #include "donner/base/fonts/SfntUtils.h"
 #include "donner/svg/core/FontStretch.h"
 #include "donner/svg/core/FontStyle.h"
+#include "donner/svg/resources/FontBlobCache.h"
 #include "embed_resources/PublicSansFont.h"
 
 using testing::Eq;
@@ -1129,6 +1130,111 @@ TEST(FontManagerTest, DefaultProviderAdoptedByNewInstances) {
   EXPECT_EQ(FontManager::DefaultFontProvider(), nullptr);
 }
 
+TEST(FontManagerTest, SharesValidatedFontsAcrossRegistriesThroughBlobCache) {
+  FontBlobCache cache(FontManager::kDefaultMaximumLoadedFontBytes);
+  const std::vector<uint8_t> cff(embedded::kPublicSansMediumOtf.begin(),
+                                 embedded::kPublicSansMediumOtf.end());
+  const std::vector<uint8_t> woff = readFile("donner/base/fonts/testdata/valid-001.woff");
+  ASSERT_FALSE(woff.empty());
+
+  Registry firstRegistry;
+  FontManager first(firstRegistry);
+  first.setFontBlobCache(&cache);
+  const FontHandle firstCff = first.loadFontData(cff);
+  const FontHandle firstWoff = first.loadFontData(woff);
+  ASSERT_TRUE(static_cast<bool>(firstCff));
+  ASSERT_TRUE(static_cast<bool>(firstWoff));
+  EXPECT_GT(first.fontValidationWork(), 0u);
+  EXPECT_EQ(first.sharedFontBlobHits(), 0u);
+  EXPECT_EQ(FontManagerTestAccess::CompressedFontDecompressionAttempts(first), 1u);
+  EXPECT_EQ(cache.stats().entryCount, 2u);
+
+  // A second document loading the same bytes reuses the validated blobs: no decompression, no
+  // validation pass, and no private copy of the bytes. The validation work is still charged to
+  // its budget, as it would be for a fresh load.
+  Registry secondRegistry;
+  FontManager second(secondRegistry);
+  second.setFontBlobCache(&cache);
+  const FontHandle secondCff = second.loadFontData(cff);
+  const FontHandle secondWoff = second.loadFontData(woff);
+  ASSERT_TRUE(static_cast<bool>(secondCff));
+  ASSERT_TRUE(static_cast<bool>(secondWoff));
+  EXPECT_EQ(second.fontValidationWork(), first.fontValidationWork());
+  EXPECT_EQ(second.sharedFontBlobHits(), 2u);
+  EXPECT_EQ(FontManagerTestAccess::CompressedFontDecompressionAttempts(second), 0u);
+  EXPECT_EQ(second.fontData(secondCff).data(), first.fontData(firstCff).data());
+  EXPECT_EQ(second.fontData(secondWoff).data(), first.fontData(firstWoff).data());
+  EXPECT_TRUE(second.sfntTable(secondWoff, "head").has_value());
+
+  // Shared bytes are still charged to each registry's own budget.
+  EXPECT_EQ(second.loadedFontBytes(), first.loadedFontBytes());
+  EXPECT_EQ(cache.stats().hits, 2u);
+}
+
+TEST(FontManagerTest, BlobCacheHitIsHeldToValidationBudget) {
+  FontBlobCache cache(FontManager::kDefaultMaximumLoadedFontBytes);
+  const std::vector<uint8_t> cff(embedded::kPublicSansMediumOtf.begin(),
+                                 embedded::kPublicSansMediumOtf.end());
+
+  Registry warmRegistry;
+  FontManager warm(warmRegistry);
+  warm.setFontBlobCache(&cache);
+  ASSERT_TRUE(static_cast<bool>(warm.loadFontData(cff)));
+  const size_t validationWork = warm.fontValidationWork();
+  ASSERT_GT(validationWork, 1u);
+
+  // An untrusted load is rejected by an exhausted or too-small validation budget whether or not
+  // another document already validated the bytes, and charged just as a fresh load would be.
+  for (const size_t maximumValidationWork : {size_t{0}, validationWork - 1}) {
+    SCOPED_TRACE(maximumValidationWork);
+    Registry cachedRegistry;
+    FontManager cached(cachedRegistry, FontManager::kDefaultMaximumLoadedFontBytes,
+                       FontManager::kDefaultMaximumLoadedFonts, maximumValidationWork);
+    cached.setFontBlobCache(&cache);
+    EXPECT_FALSE(static_cast<bool>(cached.loadFontData(cff)));
+    EXPECT_EQ(cached.sharedFontBlobHits(), 0u);
+
+    Registry uncachedRegistry;
+    FontManager uncached(uncachedRegistry, FontManager::kDefaultMaximumLoadedFontBytes,
+                         FontManager::kDefaultMaximumLoadedFonts, maximumValidationWork);
+    uncached.setFontBlobCache(nullptr);
+    EXPECT_FALSE(static_cast<bool>(uncached.loadFontData(cff)));
+    EXPECT_EQ(cached.fontValidationWork(), uncached.fontValidationWork());
+  }
+
+  // With enough budget the hit is admitted and charged the recorded work.
+  Registry registry;
+  FontManager manager(registry, FontManager::kDefaultMaximumLoadedFontBytes,
+                      FontManager::kDefaultMaximumLoadedFonts, validationWork);
+  manager.setFontBlobCache(&cache);
+  const FontHandle handle = manager.loadFontData(cff);
+  ASSERT_TRUE(static_cast<bool>(handle));
+  EXPECT_FALSE(manager.isTrustedFont(handle));
+  EXPECT_EQ(manager.fontValidationWork(), validationWork);
+  EXPECT_EQ(manager.sharedFontBlobHits(), 1u);
+
+  // Trusted loads do not spend the validation budget, cached or not.
+  EXPECT_TRUE(static_cast<bool>(manager.loadFontData(cff, FontDataTrust::Trusted)));
+  EXPECT_EQ(manager.fontValidationWork(), validationWork);
+  EXPECT_EQ(manager.sharedFontBlobHits(), 2u);
+}
+
+TEST(FontManagerTest, LoadFontFileMapsRawFont) {
+  Registry registry;
+  FontManager mgr(registry);
+
+  const std::vector<uint8_t> expected = readFile("third_party/roboto/Roboto-Regular.ttf");
+  ASSERT_FALSE(expected.empty());
+  const FontHandle handle =
+      mgr.loadFontFile("third_party/roboto/Roboto-Regular.ttf", FontDataTrust::Trusted);
+  ASSERT_TRUE(static_cast<bool>(handle));
+  EXPECT_TRUE(mgr.isTrustedFont(handle));
+  const std::span<const uint8_t> data = mgr.fontData(handle);
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), expected.begin(), expected.end()));
+
+  EXPECT_FALSE(static_cast<bool>(mgr.loadFontFile("third_party/roboto/missing.ttf")));
+}
+
 #ifdef DONNER_TEXT_WOFF2_ENABLED
 TEST(FontManagerTest, LoadWoff2Data) {
   Registry registry;
@@ -9,6 +9,7 @@
 #include <variant>
 #include <vector>
 
+#include "donner/svg/resources/DecodedImageCache.h"
 #include "donner/svg/resources/NullResourceLoader.h"
 #include "donner/svg/resources/ResourceLoaderInterface.h"
 
@@ -247,6 +248,55 @@ TEST(ImageLoader, ReturnsDataCorruptWhenInfoSucceedsButDecodeFails) {
   ExpectImageLoaderError(imageLoader.fromUri("missing-idat.png"), UrlLoaderError::DataCorrupt);
 }
 
+TEST(ImageLoader, SharesDecodesThroughEnabledCache) {
+  constexpr std::string_view kPngDataUrl =
+      "data:image/png;base64,"
+      "iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAQAAAC1HAwCAAAAC0lEQVR42mP8/x8AAwMCAO+"
+      "/p9sAAAAASUVORK5CYII=";
+  NullResourceLoader resourceLoader;
+  DecodedImageCache cache(1024);
+
+  ImageLoader firstLoader(resourceLoader);
+  firstLoader.setDecodedImageCache(&cache);
+  ImageLoader::Result first = firstLoader.fromUri(kPngDataUrl);
+  ASSERT_TRUE(std::holds_alternative<ImageResource>(first));
+  const ImageResource& firstImage = std::get<ImageResource>(first);
+  ASSERT_NE(firstImage.shared, nullptr);
+  EXPECT_EQ(cache.stats().insertions, 1u);
+
+  // A second document's loader hits the shared entry, and still charges its own budget.
+  size_t remainingBytes = 1024;
+  ImageLoader secondLoader(resourceLoader, UrlLoader::kDefaultMaximumResourceSize,
+                           &remainingBytes);
+  secondLoader.setDecodedImageCache(&cache);
+  ImageLoader::Result second = secondLoader.fromUri(kPngDataUrl);
+  ASSERT_TRUE(std::holds_alternative<ImageResource>(second));
+  const ImageResource& secondImage = std::get<ImageResource>(second);
+  EXPECT_EQ(secondImage.shared, firstImage.shared);
+  // Both documents borrow the one decoded copy of the pixels.
+  EXPECT_TRUE(firstImage.data.empty());
+  EXPECT_TRUE(secondImage.data.empty());
+  EXPECT_EQ(secondImage.pixels().data(), firstImage.pixels().data());
+  EXPECT_EQ(secondImage.pixels().size(), 4u);
+  EXPECT_EQ(secondImage.width, 1);
+  EXPECT_EQ(secondImage.height, 1);
+  EXPECT_EQ(cache.stats().hits, 1u);
+  EXPECT_LE(remainingBytes, 1024u - 4u);
+
+  // Hits are held to the same decoded-size limit as a fresh decode.
+  ImageLoader limitedLoader(resourceLoader, UrlLoader::kDefaultMaximumResourceSize, nullptr, 3);
+  limitedLoader.setDecodedImageCache(&cache);
+  ExpectImageLoaderError(limitedLoader.fromUri(kPngDataUrl), UrlLoaderError::ResourceTooLarge);
+
+  // Disabled caches are bypassed entirely.
+  DecodedImageCache disabledCache;
+  ImageLoader uncachedLoader(resourceLoader);
+  uncachedLoader.setDecodedImageCache(&disabledCache);
+  ImageLoader::Result uncached = uncachedLoader.fromUri(kPngDataUrl);
+  ASSERT_TRUE(std::holds_alternative<ImageResource>(uncached));
+  EXPECT_EQ(std::get<ImageResource>(uncached).shared, nullptr);
+}
+
 TEST(ImageLoader, ReturnsUrlLoaderErrors) {
   NullResourceLoader resourceLoader;
   ImageLoader imageLoader(resourceLoader);
@@ -0,0 +1,112 @@
+#include "donner/svg/resources/ImageMipChain.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace donner::svg {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<std::uint8_t> Checkerboard(int width, int height) {
+  std::vector<std::uint8_t> pixels;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const std::uint8_t value = ((x + y) % 2 == 0) ? 255 : 0;
+      pixels.insert(pixels.end(), {value, value, value, value});
+    }
+  }
+  return pixels;
+}
+
+TEST(ImageMipChain, LevelCount) {
+  EXPECT_EQ(ImageMipChain::LevelCount(1, 1), 1);
+  EXPECT_EQ(ImageMipChain::LevelCount(2, 1), 2);
+  EXPECT_EQ(ImageMipChain::LevelCount(4, 4), 3);
+  EXPECT_EQ(ImageMipChain::LevelCount(5, 3), 4);
+  EXPECT_EQ(ImageMipChain::LevelCount(6000, 4000), 14);
+}
+
+TEST(ImageMipChain, DownsampleAveragesPremultipliedBlocks) {
+  // Opaque white next to transparent: the premultiplied average is half-transparent white, not a
+  // darkened gray, which is what averaging straight alpha would produce.
+  const std::vector<std::uint8_t> pixels = {255, 255, 255, 255, 0, 0, 0, 0};
+  const ImageMipChain::Level level = ImageMipChain::Downsample(pixels, 2, 1);
+  EXPECT_EQ(level.width, 1);
+  EXPECT_EQ(level.height, 1);
+  EXPECT_THAT(level.pixels, ElementsAre(128, 128, 128, 128));
+}
+
+TEST(ImageMipChain, DownsampleRepeatsEdgesForOddExtents) {
+  const std::vector<std::uint8_t> pixels = {
+      0, 0, 0, 0, 100, 100, 100, 100, 200, 200, 200, 200,
+  };
+  const ImageMipChain::Level level = ImageMipChain::Downsample(pixels, 3, 1);
+  EXPECT_EQ(level.width, 2);
+  EXPECT_EQ(level.height, 1);
+  EXPECT_THAT(level.pixels, ElementsAre(50, 50, 50, 50, 200, 200, 200, 200));
+}
+
+TEST(ImageMipChain, BuildsLevelsLazilyAndReusesThem) {
+  const std::vector<std::uint8_t> base = Checkerboard(8, 8);
+  ImageMipChain chain;
+  EXPECT_EQ(chain.builtLevelCount(), 0);
+
+  const ImageMipChain::Level& level2 = chain.level(base, 8, 8, 2);
+  EXPECT_EQ(chain.builtLevelCount(), 2);
+  EXPECT_EQ(level2.width, 2);
+  EXPECT_EQ(level2.height, 2);
+  // A checkerboard filters to uniform gray.
+  for (std::uint8_t value : level2.pixels) {
+    EXPECT_EQ(value, 128);
+  }
+
+  EXPECT_EQ(&chain.level(base, 8, 8, 2), &level2);
+  const ImageMipChain::Level& level1 = chain.level(base, 8, 8, 1);
+  EXPECT_EQ(level1.width, 4);
+  EXPECT_EQ(chain.builtLevelCount(), 2);
+  EXPECT_EQ(chain.residentBytes(), (4u * 4u + 2u * 2u) * 4u);
+
+  // Requests past the end clamp to the 1x1 level.
+  const ImageMipChain::Level& last = chain.level(base, 8, 8, 10);
+  EXPECT_EQ(last.width, 1);
+  EXPECT_EQ(last.height, 1);
+
+  chain.reset();
+  EXPECT_EQ(chain.builtLevelCount(), 0);
+}
+
+TEST(ImageMipChain, MoveTransfersLevels) {
+  const std::vector<std::uint8_t> base = Checkerboard(4, 4);
+  ImageMipChain chain;
+  const ImageMipChain::Level* level = &chain.level(base, 4, 4, 1);
+
+  ImageMipChain moved(std::move(chain));
+  EXPECT_EQ(moved.builtLevelCount(), 1);
+  EXPECT_EQ(&moved.level(base, 4, 4, 1), level);
+}
+
+TEST(ImageMipChain, ConcurrentRequestsShareLevels) {
+  const std::vector<std::uint8_t> base = Checkerboard(64, 64);
+  ImageMipChain chain;
+  std::vector<const ImageMipChain::Level*> results(8, nullptr);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i] { results[i] = &chain.level(base, 64, 64, 3); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(chain.builtLevelCount(), 3);
+  for (const ImageMipChain::Level* result : results) {
+    EXPECT_EQ(result, results[0]);
+  }
+}
+
+}  // namespace
+}  // namespace donner::svg
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <string>
 
 #include "donner/base/MathUtils.h"
@@ -1206,9 +1207,9 @@ std::vector<TextRun> TextEngine::layout(const components::ComputedTextComponent&
 
     for (size_t ci = 0; ci < chunkRanges.size(); ++ci) {
       const auto& chunk = chunkRanges[ci];
-      const auto shaped =
-          backend_->shapeRun(spanFont, spanFontSizePx, spanText, chunk.byteStart,
-                             chunk.byteEnd - chunk.byteStart, vertical, span.fontVariant, false);
+      const TextBackend::ShapedRun shaped =
+          layoutCache_.shapeRun(*backend_, spanFont, spanFontSizePx, spanText, chunk.byteStart,
+                                chunk.byteEnd - chunk.byteStart, vertical, span.fontVariant, false);
 
       // ── RTL Y-override for multi-glyph chunks ─────────────────────────────────
       // When a multi-glyph RTL chunk starts because of an absolute y position on the
@@ -1705,7 +1706,12 @@ std::optional<SubSuperMetrics> TextEngine::subSuperMetrics(FontHandle font) cons
 }
 
 Path TextEngine::glyphOutline(FontHandle font, int glyphIndex, float scale) const {
-  return backend_->glyphOutline(font, glyphIndex, scale);
+  return *sharedGlyphOutline(font, glyphIndex, scale);
+}
+
+std::shared_ptr<const Path> TextEngine::sharedGlyphOutline(FontHandle font, int glyphIndex,
+                                                           float scale) const {
+  return layoutCache_.glyphOutline(*backend_, font, glyphIndex, scale);
 }
 
 bool TextEngine::isBitmapOnly(FontHandle font) const {
@@ -1857,23 +1863,26 @@ const components::ComputedTextGeometryComponent& TextEngine::ensureComputedTextG
       charGeom.advance += std::hypot(glyph.xAdvance, glyph.yAdvance);
 
       const float emScale = run.font ? scaleForEmToPixels(run.font, runFontSizePx) : 0.0f;
-      Path glyphPath = glyphOutline(run.font, glyph.glyphIndex, emScale * glyph.fontSizeScale);
-      if (!glyphPath.empty()) {
+      std::shared_ptr<const Path> outline =
+          sharedGlyphOutline(run.font, glyph.glyphIndex, emScale * glyph.fontSizeScale);
+      if (!outline->empty()) {
+        // Stretched glyphs are rare (lengthAdjust="spacingAndGlyphs") and carry a per-glyph
+        // scale, so they get their own outline rather than a shared one.
         if (glyph.stretchScaleX != 1.0f || glyph.stretchScaleY != 1.0f) {
-          glyphPath = transformPath(glyphPath,
-                                    Transform2d::Scale(glyph.stretchScaleX, glyph.stretchScaleY));
+          outline = std::make_shared<const Path>(transformPath(
+              *outline, Transform2d::Scale(glyph.stretchScaleX, glyph.stretchScaleY)));
         }
 
-        Transform2d glyphFromLocal = Transform2d::Translate(glyph.xPosition, glyph.yPosition);
+        Transform2d localFromGlyph = Transform2d::Translate(glyph.xPosition, glyph.yPosition);
         if (glyph.rotateDegrees != 0.0) {
-          glyphFromLocal =
+          localFromGlyph =
               Transform2d::Rotate(glyph.rotateDegrees * MathConstants<double>::kPi / 180.0) *
-              glyphFromLocal;
+              localFromGlyph;
         }
 
-        Path transformed = transformPath(glyphPath, glyphFromLocal);
-        const Box2d extent = transformed.bounds();
-        cache.glyphs.push_back({span.sourceEntity, std::move(transformed), extent});
+        // Same points, in the same order, as bounding the transformed path.
+        const Box2d extent = outline->transformedBounds(localFromGlyph);
+        cache.glyphs.push_back({span.sourceEntity, std::move(outline), localFromGlyph, extent});
         addBox(cache.inkBounds, hasInkBounds, extent);
         addBox(charGeom.extent, charGeom.hasExtent, extent);
       } else if (auto bitmap = bitmapGlyph(run.font, glyph.glyphIndex, emScale)) {
@@ -1897,8 +1906,8 @@ std::vector<Path> TextEngine::computedGlyphPaths(EntityHandle handle) const {
   const auto& cache = ensureComputedTextGeometryComponent(handle);
   std::vector<Path> result;
   for (const auto& glyph : cache.glyphs) {
-    if (isDescendantOf(registry_, glyph.sourceEntity, handle.entity())) {
-      result.push_back(glyph.path);
+    if (glyph.outline && isDescendantOf(registry_, glyph.sourceEntity, handle.entity())) {
+      result.push_back(transformPath(*glyph.outline, glyph.localFromGlyph));
     }
   }
   return result;
@@ -1908,8 +1917,9 @@ std::vector<TextEngine::GlyphOutline> TextEngine::computedGlyphOutlines(EntityHa
   const auto& cache = ensureComputedTextGeometryComponent(handle);
   std::vector<GlyphOutline> result;
   for (const auto& glyph : cache.glyphs) {
-    if (isDescendantOf(registry_, glyph.sourceEntity, handle.entity())) {
-      result.push_back(GlyphOutline{glyph.path, glyph.sourceEntity});
+    if (glyph.outline && isDescendantOf(registry_, glyph.sourceEntity, handle.entity())) {
+      result.push_back(
+          GlyphOutline{transformPath(*glyph.outline, glyph.localFromGlyph), glyph.sourceEntity});
     }
   }
   return result;
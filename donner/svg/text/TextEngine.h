@@ -13,6 +13,7 @@
 #include "donner/svg/components/text/ComputedTextGeometryComponent.h"
 #include "donner/svg/resources/FontManager.h"
 #include "donner/svg/text/TextBackend.h"
+#include "donner/svg/text/TextLayoutCache.h"
 #include "donner/svg/text/TextLayoutParams.h"
 #include "donner/svg/text/TextTypes.h"
 
@@ -71,6 +72,10 @@ public:
   std::optional<SubSuperMetrics> subSuperMetrics(FontHandle font) const;
   /// Return the vector outline for \p glyphIndex in \p font at the given \p scale.
   Path glyphOutline(FontHandle font, int glyphIndex, float scale) const;
+  /// Return the shared vector outline for \p glyphIndex in \p font at the given \p scale, which
+  /// is extracted from the font once and reused by every later request for it.
+  std::shared_ptr<const Path> sharedGlyphOutline(FontHandle font, int glyphIndex,
+                                                 float scale) const;
   /// Return true if \p font only contains bitmap glyphs (e.g. color emoji).
   bool isBitmapOnly(FontHandle font) const;
   /// Return a rasterized bitmap glyph for \p glyphIndex in \p font at the given \p scale.
@@ -132,11 +137,16 @@ public:
   /// Return the character index at the given point for the text subtree rooted at \p handle.
   long getCharNumAtPosition(EntityHandle handle, const Vector2d& point) const;
 
+  /// Return how often shaping and glyph outline extraction were served from the engine's caches.
+  const TextLayoutCacheStats& layoutCacheStats() const { return layoutCache_.stats(); }
+
 private:
   FontManager& fontManager_;
   Registry& registry_;
   std::unique_ptr<TextBackend> backend_;
   size_t registeredFontFaceCount_ = 0;
+  /// Shaped chunks and glyph outlines, reused across layouts of unchanged spans.
+  mutable TextLayoutCache layoutCache_;
 };
 
 }  // namespace donner::svg
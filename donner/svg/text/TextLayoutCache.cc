@@ -0,0 +1,100 @@
+#include "donner/svg/text/TextLayoutCache.h"
+
+#include <functional>
+
+namespace donner::svg {
+
+namespace {
+
+/// Boost-style hash combine.
+void HashCombine(std::size_t& seed, std::size_t value) {
+  seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+}  // namespace
+
+std::size_t TextLayoutCache::ShapedRunKeyHash::operator()(const ShapedRunKey& key) const noexcept {
+  std::size_t seed = std::hash<std::string>()(key.chunkText);
+  HashCombine(seed, std::hash<FontHandle>()(key.font));
+  HashCombine(seed, std::hash<float>()(key.fontSizePx));
+  HashCombine(seed, static_cast<std::size_t>(key.fontVariant) << 2 |
+                        static_cast<std::size_t>(key.isVertical) << 1 |
+                        static_cast<std::size_t>(key.forceLogicalOrder));
+  return seed;
+}
+
+std::size_t TextLayoutCache::GlyphOutlineKeyHash::operator()(
+    const GlyphOutlineKey& key) const noexcept {
+  std::size_t seed = std::hash<FontHandle>()(key.font);
+  HashCombine(seed, std::hash<int>()(key.glyphIndex));
+  HashCombine(seed, std::hash<float>()(key.scale));
+  return seed;
+}
+
+TextBackend::ShapedRun TextLayoutCache::shapeRun(const TextBackend& backend, FontHandle font,
+                                                 float fontSizePx, std::string_view spanText,
+                                                 std::size_t byteOffset, std::size_t byteLength,
+                                                 bool isVertical, FontVariant fontVariant,
+                                                 bool forceLogicalOrder) {
+  ShapedRunKey key{
+      .font = font,
+      .fontSizePx = fontSizePx,
+      .chunkText = std::string(spanText.substr(byteOffset, byteLength)),
+      .isVertical = isVertical,
+      .fontVariant = fontVariant,
+      .forceLogicalOrder = forceLogicalOrder,
+  };
+
+  const auto rebased = [byteOffset](TextBackend::ShapedRun run) {
+    for (TextBackend::ShapedGlyph& glyph : run.glyphs) {
+      glyph.cluster += static_cast<std::uint32_t>(byteOffset);
+    }
+    return run;
+  };
+
+  if (auto it = shapedRuns_.find(key); it != shapedRuns_.end()) {
+    ++stats_.shapedRunHits;
+    return rebased(it->second);
+  }
+
+  ++stats_.shapedRunMisses;
+  if (shapedRuns_.size() >= kMaxShapedRuns) {
+    shapedRuns_.clear();
+  }
+
+  TextBackend::ShapedRun shaped = backend.shapeRun(font, fontSizePx, spanText, byteOffset,
+                                                   byteLength, isVertical, fontVariant,
+                                                   forceLogicalOrder);
+  TextBackend::ShapedRun stored = shaped;
+  for (TextBackend::ShapedGlyph& glyph : stored.glyphs) {
+    glyph.cluster -= static_cast<std::uint32_t>(byteOffset);
+  }
+  shapedRuns_.emplace(std::move(key), std::move(stored));
+  return shaped;
+}
+
+std::shared_ptr<const Path> TextLayoutCache::glyphOutline(const TextBackend& backend,
+                                                          FontHandle font, int glyphIndex,
+                                                          float scale) {
+  const GlyphOutlineKey key{.font = font, .glyphIndex = glyphIndex, .scale = scale};
+  if (auto it = outlines_.find(key); it != outlines_.end()) {
+    ++stats_.outlineHits;
+    return it->second;
+  }
+
+  ++stats_.outlineMisses;
+  if (outlines_.size() >= kMaxGlyphOutlines) {
+    outlines_.clear();
+  }
+
+  auto outline = std::make_shared<const Path>(backend.glyphOutline(font, glyphIndex, scale));
+  outlines_.emplace(key, outline);
+  return outline;
+}
+
+void TextLayoutCache::clear() {
+  shapedRuns_.clear();
+  outlines_.clear();
+}
+
+}  // namespace donner::svg
@@ -0,0 +1,120 @@
+#pragma once
+/// @file
+/// Shaping and glyph outline caches owned by \ref donner::svg::TextEngine.
+///
+/// Any change inside a `<text>` root drops that root's computed geometry, and the next query or
+/// draw lays out every span again. Most of that cost is in two backend calls whose results only
+/// depend on their arguments: shaping a chunk of span text, and extracting a glyph outline from
+/// the font. This file owns the storage that lets unchanged spans skip both, so editing one
+/// `<tspan>` of a long label reshapes only that span, and a glyph that appears many times is
+/// extracted once and shared by every placement.
+///
+/// Keys hold every argument of the backend call except the surrounding span text, so a hit returns
+/// exactly what the backend would have. Font data never changes under a \ref FontHandle, which is
+/// what makes the entries valid for the engine's lifetime.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "donner/base/Path.h"
+#include "donner/svg/resources/FontManager.h"
+#include "donner/svg/text/TextBackend.h"
+
+namespace donner::svg {
+
+/// Cumulative counters describing how often the text layout caches avoided a backend call, for
+/// tests and benchmarks.
+struct TextLayoutCacheStats {
+  std::uint64_t shapedRunHits = 0;    ///< Chunks whose shaping was reused.
+  std::uint64_t shapedRunMisses = 0;  ///< Chunks shaped by the backend.
+  std::uint64_t outlineHits = 0;      ///< Glyph outlines reused.
+  std::uint64_t outlineMisses = 0;    ///< Glyph outlines extracted by the backend.
+};
+
+/**
+ * Memoizes \ref TextBackend::shapeRun and \ref TextBackend::glyphOutline.
+ *
+ * Both maps are capped by entry count. Reaching a cap clears that map rather than tracking
+ * recency: entries are cheap to rebuild, and outlines already handed out stay alive through
+ * their `shared_ptr`.
+ */
+class TextLayoutCache {
+public:
+  /// Shaped chunks kept before the shaping cache is cleared.
+  static constexpr std::size_t kMaxShapedRuns = 4096;
+
+  /// Glyph outlines kept before the outline cache is cleared.
+  static constexpr std::size_t kMaxGlyphOutlines = 16384;
+
+  /**
+   * Returns the result of `backend.shapeRun(...)` for these arguments, shaping only on a miss.
+   *
+   * Entries are keyed on the chunk's own bytes, `spanText.substr(byteOffset, byteLength)`, with
+   * glyph clusters stored relative to the chunk and rebased on return: both backends shape only
+   * that range, so the same chunk text shapes the same wherever it appears in a span, and a long
+   * span is not copied into the key once per chunk.
+   *
+   * @param backend Backend to shape with on a miss.
+   * @see TextBackend::shapeRun for the remaining parameters.
+   */
+  TextBackend::ShapedRun shapeRun(const TextBackend& backend, FontHandle font, float fontSizePx,
+                                  std::string_view spanText, std::size_t byteOffset,
+                                  std::size_t byteLength, bool isVertical,
+                                  FontVariant fontVariant, bool forceLogicalOrder);
+
+  /**
+   * Returns the outline of \p glyphIndex at \p scale, extracting it from \p backend only on a
+   * miss. Every caller asking for the same glyph at the same size receives the same path.
+   *
+   * @param backend Backend to extract the outline with on a miss.
+   * @param font Font containing the glyph.
+   * @param glyphIndex Backend-specific glyph ID.
+   * @param scale Design-unit to pixel scale, as passed to \ref TextBackend::glyphOutline.
+   */
+  std::shared_ptr<const Path> glyphOutline(const TextBackend& backend, FontHandle font,
+                                           int glyphIndex, float scale);
+
+  /// Drops every entry. Counters are kept.
+  void clear();
+
+  /// Returns the counters accumulated since construction.
+  const TextLayoutCacheStats& stats() const { return stats_; }
+
+private:
+  struct ShapedRunKey {
+    FontHandle font;
+    float fontSizePx = 0.0f;
+    std::string chunkText;
+    bool isVertical = false;
+    FontVariant fontVariant = FontVariant::Normal;
+    bool forceLogicalOrder = false;
+
+    bool operator==(const ShapedRunKey& other) const = default;
+  };
+
+  struct ShapedRunKeyHash {
+    std::size_t operator()(const ShapedRunKey& key) const noexcept;
+  };
+
+  struct GlyphOutlineKey {
+    FontHandle font;
+    int glyphIndex = 0;
+    float scale = 0.0f;
+
+    bool operator==(const GlyphOutlineKey& other) const = default;
+  };
+
+  struct GlyphOutlineKeyHash {
+    std::size_t operator()(const GlyphOutlineKey& key) const noexcept;
+  };
+
+  std::unordered_map<ShapedRunKey, TextBackend::ShapedRun, ShapedRunKeyHash> shapedRuns_;
+  std::unordered_map<GlyphOutlineKey, std::shared_ptr<const Path>, GlyphOutlineKeyHash> outlines_;
+  TextLayoutCacheStats stats_;
+};
+
+}  // namespace donner::svg
@@ -10,8 +10,12 @@
 #include <algorithm>
 #include <charconv>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <filesystem>
+#include <fstream>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <span>
@@ -32,6 +36,8 @@
 #include "donner/svg/SVGGeometryElement.h"
 #include "donner/svg/SVGPathElement.h"
 #include "donner/svg/SVGTextElement.h"
+#include "donner/svg/renderer/FrameSequence.h"
+#include "donner/svg/renderer/RendererImageIO.h"
 #include "donner/svg/renderer/RendererInterface.h"
 #include "donner/svg/renderer/RendererTinySkia.h"
 #include "donner/svg/renderer/TerminalImageViewer.h"
@@ -53,8 +59,16 @@ struct CliOptions {
   bool experimental = false;
   bool preview = false;
   bool interactive = false;
+  bool frameSequence = false;
+  double frameStart = 0.0;
+  double frameEnd = 0.0;
+  int fps = 30;
+  bool apng = false;
 };
 
+/// Highest accepted --fps, keeping APNG frame delays representable.
+constexpr int kMaximumFps = 1000;
+
 /** Raw terminal mode guard for interactive mouse input. */
 class ScopedTerminalRawMode {
 public:
@@ -101,7 +115,8 @@ void PrintUsage(std::ostream& out) {
   out << "donner-svg: Render SVG files to PNG and terminal previews\n\n"
       << "USAGE:\n"
       << "  donner-svg <input.svg> [--output <file.png>] [--width <px>] [--height <px>]\n"
-      << "             [--preview] [--interactive] [--quiet] [--verbose] [--experimental]\n\n"
+      << "             [--preview] [--interactive] [--quiet] [--verbose] [--experimental]\n"
+      << "             [--frames <start>:<end> [--fps <n>] [--apng]]\n\n"
       << "FLAGS:\n"
       << "  --output <png>    Output PNG filename (default: output.png)\n"
       << "  --width <px>      Override canvas width in pixels\n"
@@ -111,6 +126,10 @@ void PrintUsage(std::ostream& out) {
       << "  --quiet           Suppress parse warnings\n"
       << "  --verbose         Enable verbose renderer logging\n"
       << "  --experimental    Enable experimental parser features\n"
+      << "  --frames <s>:<e>  Render animation frames from <s> up to <e> seconds (implies\n"
+      << "                    --experimental); writes <output>_0000.png, <output>_0001.png, ...\n"
+      << "  --fps <n>         Frames per second for --frames (default: 30)\n"
+      << "  --apng            With --frames, write a single animated PNG to --output instead\n"
       << "  --help            Show this help text\n";
 }
 
@@ -139,6 +158,40 @@ bool TryParseIntWithMin(std::string_view value, int minimumValue, int* outValue)
   return true;
 }
 
+/**
+ * Parse a `<start>:<end>` time range in seconds, requiring finite values with start <= end.
+ *
+ * @param value String to parse.
+ * @param outStart Parsed start time output.
+ * @param outEnd Parsed end time output.
+ * @return True on success.
+ */
+bool TryParseTimeRange(std::string_view value, double* outStart, double* outEnd) {
+  const size_t separator = value.find(':');
+  if (separator == std::string_view::npos) {
+    return false;
+  }
+
+  const auto parseTime = [](std::string_view text, double* outTime) {
+    if (text.empty()) {
+      return false;
+    }
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), *outTime);
+    return ec == std::errc() && ptr == text.data() + text.size() && std::isfinite(*outTime);
+  };
+
+  double start = 0.0;
+  double end = 0.0;
+  if (!parseTime(value.substr(0, separator), &start) ||
+      !parseTime(value.substr(separator + 1), &end) || end < start) {
+    return false;
+  }
+
+  *outStart = start;
+  *outEnd = end;
+  return true;
+}
+
 std::string TerminalDiagnostic(const ParseDiagnostic& diagnostic) {
   std::ostringstream formatted;
   formatted << diagnostic;
@@ -191,8 +244,13 @@ bool ParseArgs(int argc, char* argv[], CliOptions* options, std::ostream& out, s
       options->interactive = true;
       continue;
     }
+    if (arg == "--apng") {
+      options->apng = true;
+      continue;
+    }
 
-    if (arg == "--output" || arg == "--width" || arg == "--height") {
+    if (arg == "--output" || arg == "--width" || arg == "--height" || arg == "--frames" ||
+        arg == "--fps") {
       if (i + 1 >= argc) {
         err << "Missing value for " << arg << "\n";
         return false;
@@ -202,6 +260,18 @@ bool ParseArgs(int argc, char* argv[], CliOptions* options, std::ostream& out, s
       if (arg == "--output") {
         options->outputFile = std::string(value);
         options->outputFileSet = true;
+      } else if (arg == "--frames") {
+        if (!TryParseTimeRange(value, &options->frameStart, &options->frameEnd)) {
+          err << "Invalid --frames value: " << EscapeTerminalText(value) << "\n";
+          return false;
+        }
+        options->frameSequence = true;
+        options->experimental = true;
+      } else if (arg == "--fps") {
+        if (!TryParseIntWithMin(value, 1, &options->fps) || options->fps > kMaximumFps) {
+          err << "Invalid --fps value: " << EscapeTerminalText(value) << "\n";
+          return false;
+        }
       } else if (arg == "--width") {
         if (!TryParseIntWithMin(value, 1, &options->width)) {
           err << "Invalid --width value: " << EscapeTerminalText(value) << "\n";
@@ -233,21 +303,34 @@ bool ParseArgs(int argc, char* argv[], CliOptions* options, std::ostream& out, s
     return false;
   }
 
+  if (options->apng && !options->frameSequence) {
+    err << "--apng requires --frames\n";
+    return false;
+  }
+  if (options->frameSequence && options->preview) {
+    err << "--frames cannot be combined with --preview or --interactive\n";
+    return false;
+  }
+
   return true;
 }
 
-/** Read an input file into memory. */
-std::optional<std::string> ReadFile(std::string_view filename) {
-  FileReadResult result =
-      ReadFileBounded(std::string(filename), parser::SVGParser::kDefaultMaximumInputSize);
-  if (!std::holds_alternative<std::string>(result)) {
-    return std::nullopt;
+/**
+ * Map an input file into memory. The tool never writes to its input, so the document can
+ * reference the mapping instead of a copy.
+ */
+std::shared_ptr<const MappedFile> MapInputFile(std::string_view filename) {
+  FileMapResult result =
+      MapFileBounded(std::string(filename), parser::SVGParser::kDefaultMaximumInputSize);
+  if (!std::holds_alternative<std::shared_ptr<const MappedFile>>(result)) {
+    return nullptr;
   }
-  return std::move(std::get<std::string>(result));
+  return std::move(std::get<std::shared_ptr<const MappedFile>>(result));
 }
 
 /** Parse SVG data into an SVGDocument. */
-std::optional<SVGDocument> ParseDocument(const CliOptions& options, const std::string& fileData,
+std::optional<SVGDocument> ParseDocument(const CliOptions& options,
+                                         const std::shared_ptr<const MappedFile>& file,
                                          std::ostream& out, std::ostream& err) {
   ParseWarningSink warningSink = options.quiet ? ParseWarningSink::Disabled() : ParseWarningSink();
   parser::SVGParser::Options parserOptions;
@@ -267,7 +350,7 @@ std::optional<SVGDocument> ParseDocument(const CliOptions& options, const std::s
   }
 
   auto result =
-      parser::SVGParser::ParseSVG(fileData, warningSink, parserOptions, std::move(settings));
+      parser::SVGParser::ParseSVG(file, warningSink, parserOptions, std::move(settings));
   if (result.hasError()) {
     err << "Parse error: " << TerminalDiagnostic(result.error()) << "\n";
     return std::nullopt;
@@ -276,7 +359,7 @@ std::optional<SVGDocument> ParseDocument(const CliOptions& options, const std::s
   if (!options.quiet && warningSink.hasWarnings()) {
     out << "Parse warnings:\n";
     const std::string formatted = DiagnosticRenderer::formatAll(
-        fileData, warningSink, {.filename = options.inputFile, .colorize = false});
+        file->view(), warningSink, {.filename = options.inputFile, .colorize = false});
     out << EscapeTerminalText(formatted, /*preserveNewlines=*/true);
   }
 
@@ -293,6 +376,106 @@ void ApplyCanvasSize(const CliOptions& options, SVGDocument* document) {
   }
 }
 
+/** Filename for frame \p index of a numbered sequence: `out.png` becomes `out_0007.png`. */
+std::filesystem::path NumberedFramePath(const std::filesystem::path& output, std::size_t index) {
+  char number[32];
+  std::snprintf(number, sizeof(number), "_%04zu", index);
+
+  std::filesystem::path path = output;
+  const std::filesystem::path extension =
+      output.has_extension() ? output.extension() : std::filesystem::path(".png");
+  path.replace_filename(output.stem().string() + number + extension.string());
+  return path;
+}
+
+/**
+ * Render the --frames time range, writing numbered PNGs or a single APNG.
+ *
+ * Frames in which no animation changed are not redrawn (see \ref RenderFrameSequence): the APNG
+ * encoder lengthens the previous frame, and numbered output copies the previous file.
+ *
+ * @return Process-style exit code.
+ */
+int RenderFrames(const CliOptions& options, SVGDocument& document, std::ostream& out,
+                 std::ostream& err) {
+  RendererTinySkia renderer(options.verbose);
+  FrameSequenceOptions sequenceOptions;
+  sequenceOptions.startTime = options.frameStart;
+  sequenceOptions.endTime = options.frameEnd;
+  sequenceOptions.frameRate = options.fps;
+
+  std::optional<ApngEncoder> apng;
+  std::filesystem::path previousPath;
+  std::optional<std::filesystem::path> failedPath;
+  Vector2i dimensions = Vector2i::Zero();
+
+  const FrameSequenceStats stats = RenderFrameSequence(
+      renderer, document, sequenceOptions, [&](const FrameSequenceFrame& frame) {
+        const RendererBitmap& bitmap = *frame.bitmap;
+        dimensions = bitmap.dimensions;
+        if (options.apng) {
+          if (bitmap.empty()) {
+            failedPath = options.outputFile;
+            return false;
+          }
+          if (!apng) {
+            apng.emplace(bitmap.dimensions.x, bitmap.dimensions.y,
+                         static_cast<std::uint16_t>(options.fps));
+          }
+          if (frame.reused) {
+            apng->extendLastFrame();
+          } else {
+            apng->addFrame(bitmap.pixels, bitmap.rowBytes / 4);
+          }
+          return true;
+        }
+
+        const std::filesystem::path path = NumberedFramePath(options.outputFile, frame.index);
+        std::error_code copyError;
+        const bool saved =
+            frame.reused
+                ? std::filesystem::copy_file(previousPath, path,
+                                             std::filesystem::copy_options::overwrite_existing,
+                                             copyError)
+                : !bitmap.empty() && RendererImageIO::writeRgbaPixelsToPngFile(
+                                         path.string().c_str(), bitmap.pixels,
+                                         bitmap.dimensions.x, bitmap.dimensions.y,
+                                         bitmap.rowBytes / 4);
+        if (!saved) {
+          failedPath = path;
+          return false;
+        }
+        previousPath = path;
+        return true;
+      });
+
+  if (!failedPath && apng) {
+    const std::vector<uint8_t> encoded = apng->finish();
+    std::ofstream file(options.outputFile, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(encoded.data()),
+               static_cast<std::streamsize>(encoded.size()));
+    if (encoded.empty() || !file.good()) {
+      failedPath = options.outputFile;
+    }
+  }
+
+  if (failedPath) {
+    err << "Failed to save PNG: "
+        << EscapeTerminalText(std::filesystem::absolute(*failedPath).string()) << "\n";
+    return 4;
+  }
+
+  const std::filesystem::path saved = options.apng
+                                          ? std::filesystem::path(options.outputFile)
+                                          : NumberedFramePath(options.outputFile, 0);
+  out << (options.apng ? "Saved APNG: " : "Saved PNG frames: ")
+      << EscapeTerminalText(std::filesystem::absolute(saved).string()) << "\n";
+  out << "Frames: " << stats.frames << " (" << stats.renderedFrames << " rendered, "
+      << stats.reusedFrames << " reused)\n";
+  out << "Rendered size: " << dimensions.x << "x" << dimensions.y << "\n";
+  return 0;
+}
+
 /** Build a TerminalImageView from a RendererBitmap. */
 TerminalImageView MakeView(const RendererBitmap& bitmap) {
   TerminalImageView view;
@@ -596,13 +779,13 @@ int RunDonnerSvgTool(int argc, char* argv[], std::ostream& out, std::ostream& er
     return 1;
   }
 
-  const auto fileData = ReadFile(options.inputFile);
-  if (!fileData) {
+  const std::shared_ptr<const MappedFile> file = MapInputFile(options.inputFile);
+  if (!file) {
     err << "Failed to read input SVG: " << EscapeTerminalText(options.inputFile) << "\n";
     return 2;
   }
 
-  auto maybeDocument = ParseDocument(options, *fileData, out, err);
+  auto maybeDocument = ParseDocument(options, file, out, err);
   if (!maybeDocument) {
     return 3;
   }
@@ -610,6 +793,10 @@ int RunDonnerSvgTool(int argc, char* argv[], std::ostream& out, std::ostream& er
   SVGDocument document = std::move(*maybeDocument);
   ApplyCanvasSize(options, &document);
 
+  if (options.frameSequence) {
+    return RenderFrames(options, document, out, err);
+  }
+
   // donner-svg always renders on the CPU (tiny-skia) backend. A one-shot
   // command-line render cannot amortize the GPU backend's fixed device and
   // shader setup cost, so the CPU raster path is strictly faster for
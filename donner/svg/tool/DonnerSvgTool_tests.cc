@@ -232,6 +232,23 @@ TEST(DonnerSvgTool, InvalidHeightReturnsUsageError) {
   EXPECT_THAT(err.str(), testing::HasSubstr("Invalid --height value: wide"));
 }
 
+TEST(DonnerSvgTool, InvalidFrameOptionsReturnUsageError) {
+  std::ostringstream out;
+  std::ostringstream err;
+
+  EXPECT_EQ(RunTool({"--frames", "2:1", "input.svg"}, &out, &err), 1);
+  EXPECT_THAT(err.str(), testing::HasSubstr("Invalid --frames value: 2:1"));
+
+  EXPECT_EQ(RunTool({"--frames", "0:1", "--fps", "0", "input.svg"}, &out, &err), 1);
+  EXPECT_THAT(err.str(), testing::HasSubstr("Invalid --fps value: 0"));
+
+  EXPECT_EQ(RunTool({"--apng", "input.svg"}, &out, &err), 1);
+  EXPECT_THAT(err.str(), testing::HasSubstr("--apng requires --frames"));
+
+  EXPECT_EQ(RunTool({"--frames", "0:1", "--preview", "input.svg"}, &out, &err), 1);
+  EXPECT_THAT(err.str(), testing::HasSubstr("--frames cannot be combined with --preview"));
+}
+
 TEST(DonnerSvgTool, RejectsMultipleInputFiles) {
   std::ostringstream out;
   std::ostringstream err;
@@ -269,6 +286,58 @@ TEST_F(DonnerSvgToolFileTest, RendersSvgToPngWithCanvasOverrides) {
               testing::ElementsAre(0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'));
 }
 
+constexpr std::string_view kAnimatedSvg =
+    R"(<svg xmlns="http://www.w3.org/2000/svg" width="4" height="3">
+         <rect width="4" height="3" fill="#ff0000">
+           <set attributeName="fill" to="#0000ff" begin="0.5s"/>
+         </rect>
+       </svg>)";
+
+TEST_F(DonnerSvgToolFileTest, FramesWritesNumberedPngsAndReusesUnchangedFrames) {
+  const std::filesystem::path inputPath = WriteSvg("animated.svg", kAnimatedSvg);
+  const std::filesystem::path outputPath = tmpDir_ / "frame.png";
+
+  std::ostringstream out;
+  std::ostringstream err;
+  EXPECT_EQ(RunTool({"--frames", "0:1", "--fps", "4", "--output", outputPath.string(),
+                     inputPath.string()},
+                    &out, &err),
+            0);
+
+  EXPECT_TRUE(err.str().empty());
+  EXPECT_THAT(out.str(), testing::HasSubstr("Saved PNG frames:"));
+  EXPECT_THAT(out.str(), testing::HasSubstr("Frames: 4 (2 rendered, 2 reused)"));
+  EXPECT_THAT(out.str(), testing::HasSubstr("Rendered size: 4x3"));
+  for (const char* name : {"frame_0000.png", "frame_0001.png", "frame_0002.png",
+                           "frame_0003.png"}) {
+    ASSERT_TRUE(std::filesystem::exists(tmpDir_ / name)) << name;
+  }
+  EXPECT_EQ(ReadFile(tmpDir_ / "frame_0000.png"), ReadFile(tmpDir_ / "frame_0001.png"));
+  EXPECT_NE(ReadFile(tmpDir_ / "frame_0001.png"), ReadFile(tmpDir_ / "frame_0002.png"));
+  EXPECT_FALSE(std::filesystem::exists(tmpDir_ / "frame_0004.png"));
+}
+
+TEST_F(DonnerSvgToolFileTest, FramesWithApngWritesOneAnimatedPng) {
+  const std::filesystem::path inputPath = WriteSvg("animated.svg", kAnimatedSvg);
+  const std::filesystem::path outputPath = tmpDir_ / "animation.png";
+
+  std::ostringstream out;
+  std::ostringstream err;
+  EXPECT_EQ(RunTool({"--frames", "0:1", "--fps", "4", "--apng", "--output", outputPath.string(),
+                     inputPath.string()},
+                    &out, &err),
+            0);
+
+  EXPECT_TRUE(err.str().empty());
+  EXPECT_THAT(out.str(), testing::HasSubstr("Saved APNG:"));
+  ASSERT_TRUE(std::filesystem::exists(outputPath));
+  EXPECT_THAT(ReadPngMagic(outputPath),
+              testing::ElementsAre(0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'));
+  const std::string data = ReadFile(outputPath);
+  EXPECT_NE(data.find("acTL"), std::string::npos);
+  EXPECT_NE(data.find("fdAT"), std::string::npos);
+}
+
 TEST_F(DonnerSvgToolFileTest, ResourcesAreSandboxedToTheInputDocumentsDirectory) {
   const std::filesystem::path untrustedDirectory = tmpDir_ / "untrusted";
   const std::filesystem::path privateDirectory = tmpDir_ / "private";
@@ -11,6 +11,16 @@
 
 namespace tiny_skia {
 
+/// Scan converter used for anti-aliased path fills.
+enum class ScanBackend : std::uint8_t {
+  /// Analytic anti-aliasing (AAA), ported from Skia. Matches the reference renderer bit for bit.
+  Analytic,
+  /// Sparse-strip rasterizer: exact per-pixel area computed over 4x4 tiles with SIMD. Faster on
+  /// paths with many short curved segments; coverage differs slightly from Analytic, and stays
+  /// within scan::sparse_strips::kMaxCoverageDifference of the true area per pixel.
+  SparseStrips,
+};
+
 /// Controls how a shape is painted (shader, blend mode, anti-aliasing).
 struct Paint {
   /// Paint shader source. Default: solid black.
@@ -28,6 +38,9 @@ struct Paint {
   /// Force the high-quality (highp) rendering pipeline. Default: false.
   bool forceHqPipeline = false;
 
+  /// Scan converter for anti-aliased fills; ignored when antiAlias is false. Default: Analytic.
+  ScanBackend scanBackend = ScanBackend::Analytic;
+
   /// Sets the shader to a solid color.
   void setColor(const Color& color) { shader = color; }
 
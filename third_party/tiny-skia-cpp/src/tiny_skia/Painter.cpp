@@ -1,5 +1,7 @@
 #include "tiny_skia/Painter.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 
@@ -11,6 +13,7 @@
 #include "tiny_skia/scan/Scan.h"
 #include "tiny_skia/scan/Path.h"
 #include "tiny_skia/scan/PathAa.h"
+#include "tiny_skia/scan/SparseStrips.h"
 
 namespace tiny_skia {
 
@@ -26,14 +29,48 @@ Blitter& selectBlitter(BlitterWrapper* wrapper, pipeline::RasterPipelineBlitter&
   return wrapper != nullptr ? wrapper->wrap(blitter, paint) : static_cast<Blitter&>(blitter);
 }
 
+/// Fills \p path with the anti-aliased scan converter \p paint selects.
+void fillPathAa(const Path& path, const Paint& paint, FillRule fillRule, const ScreenIntRect& clip,
+                Blitter& blitter) {
+  if (paint.scanBackend == ScanBackend::SparseStrips) {
+    scan::sparse_strips::fillPath(path, fillRule, clip, blitter);
+  } else {
+    scan::path_aa::fillPath(path, fillRule, clip, blitter);
+  }
+}
+
+/// Returns true if \p path is one closed contour of four points whose edges alternate between
+/// horizontal and vertical, i.e. `Path::fromRect` of its bounds up to the starting corner and
+/// direction. The analytic scan converter gives every such path the same coverage.
+bool isAxisAlignedRect(const Path& path) {
+  const auto verbs = path.verbs();
+  if (verbs.size() != 5 || verbs[0] != PathVerb::Move || verbs[1] != PathVerb::Line ||
+      verbs[2] != PathVerb::Line || verbs[3] != PathVerb::Line || verbs[4] != PathVerb::Close) {
+    return false;
+  }
+
+  const auto p = path.points();
+  return (p[0].y == p[1].y && p[1].x == p[2].x && p[2].y == p[3].y && p[3].x == p[0].x) ||
+         (p[0].x == p[1].x && p[1].y == p[2].y && p[2].x == p[3].x && p[3].y == p[0].y);
+}
+
+/// Returns true if fillPath may hand \p path to fillAxisAlignedRect's fast path. Tiled targets
+/// keep the general path, so the two never call each other in a loop. The fast path reproduces
+/// the analytic scan converter, so it is skipped when the paint selects another one.
+bool canFillAsAxisAlignedRect(const MutablePixmapView& pixmap, const Paint& paint,
+                              const Transform& transform) {
+  return paint.antiAlias && paint.scanBackend == ScanBackend::Analytic && !transform.hasSkew() &&
+         !detail::DrawTiler::required(pixmap.width(), pixmap.height());
+}
+
 }  // namespace
 
-bool detail::isTooBigForMath(const Path& path) {
+bool detail::isTooBigForMath(const Path& path) { return isTooBigForMath(path.bounds()); }
+
+bool detail::isTooBigForMath(const Rect& b) {
   constexpr float kScaleDownToAllowForSmallMultiplies = 0.25f;
   constexpr float kMax = kScalarMax * kScaleDownToAllowForSmallMultiplies;
 
-  const auto b = path.bounds();
-
   // Use ! expression so we return true if bounds contains NaN.
   return !(b.left() >= -kMax && b.top() >= -kMax && b.right() <= kMax && b.bottom() <= kMax);
 }
@@ -99,9 +136,63 @@ void Painter::fillRect(MutablePixmapView& pixmap, const Rect& rect, const Paint&
   }
 }
 
+void Painter::fillAxisAlignedRect(MutablePixmapView& pixmap, const Rect& rect, const Paint& paint,
+                                  Transform transform, const Mask* mask, BlitterWrapper* wrapper) {
+  if (!canFillAsAxisAlignedRect(pixmap, paint, transform)) {
+    Painter::fillPath(pixmap, Path::fromRect(rect), paint, FillRule::Winding, transform, mask,
+                      wrapper);
+    return;
+  }
+
+  // The device rect, mapped corner by corner exactly as Path::transform would.
+  std::array<Point, 4> corners = {Point{rect.left(), rect.top()}, Point{rect.right(), rect.top()},
+                                  Point{rect.right(), rect.bottom()},
+                                  Point{rect.left(), rect.bottom()}};
+  transform.mapPoints(corners);
+  float left = corners[0].x;
+  float top = corners[0].y;
+  float right = corners[0].x;
+  float bottom = corners[0].y;
+  for (const auto& corner : corners) {
+    if (!std::isfinite(corner.x) || !std::isfinite(corner.y)) {
+      return;
+    }
+    left = std::min(left, corner.x);
+    top = std::min(top, corner.y);
+    right = std::max(right, corner.x);
+    bottom = std::max(bottom, corner.y);
+  }
+
+  const auto deviceRect = Rect::fromLTRB(left, top, right, bottom);
+  if (!deviceRect.has_value() || isNearlyZero(deviceRect->width()) ||
+      isNearlyZero(deviceRect->height()) || detail::isTooBigForMath(*deviceRect)) {
+    return;
+  }
+
+  auto paintCopy = paint;
+  if (!transform.isIdentity()) {
+    transformShader(paintCopy.shader, transform);
+  }
+
+  const auto clipRect = pixmap.size().toScreenIntRect(0, 0);
+  auto submaskOpt = mask ? std::optional<SubMaskView>(mask->submask()) : std::nullopt;
+  auto subpix = pixmap.subpixmap();
+  auto blitter = pipeline::RasterPipelineBlitter::create(paintCopy, submaskOpt, &subpix);
+  if (!blitter.has_value()) {
+    return;
+  }
+
+  scan::path_aa::fillRect(*deviceRect, clipRect, selectBlitter(wrapper, *blitter, paintCopy));
+}
+
 void Painter::fillPath(MutablePixmapView& pixmap, const Path& path, const Paint& paint,
                        FillRule fillRule, Transform transform, const Mask* mask,
                        BlitterWrapper* wrapper) {
+  if (canFillAsAxisAlignedRect(pixmap, paint, transform) && isAxisAlignedRect(path)) {
+    Painter::fillAxisAlignedRect(pixmap, path.bounds(), paint, transform, mask, wrapper);
+    return;
+  }
+
   if (transform.isIdentity()) {
     // Skip empty paths and horizontal/vertical lines.
     const auto pathBounds = path.bounds();
@@ -141,7 +232,7 @@ void Painter::fillPath(MutablePixmapView& pixmap, const Path& path, const Paint&
 
         Blitter& target = selectBlitter(wrapper, *blitter, paintCopy);
         if (paintCopy.antiAlias) {
-          scan::path_aa::fillPath(pathCopy, fillRule, clipRect, target);
+          fillPathAa(pathCopy, paintCopy, fillRule, clipRect, target);
         } else {
           scan::fillPath(pathCopy, fillRule, clipRect, target);
         }
@@ -166,7 +257,7 @@ void Painter::fillPath(MutablePixmapView& pixmap, const Path& path, const Paint&
 
       Blitter& target = selectBlitter(wrapper, *blitter, paint);
       if (paint.antiAlias) {
-        scan::path_aa::fillPath(path, fillRule, clipRect, target);
+        fillPathAa(path, paint, fillRule, clipRect, target);
       } else {
         scan::fillPath(path, fillRule, clipRect, target);
       }
@@ -81,6 +81,10 @@ class DrawTiler {
 /// Returns true if the path's bounds are too large for fixed-point math.
 [[nodiscard]] bool isTooBigForMath(const Path& path);
 
+/// @internal
+/// Returns true if the rect is too large for fixed-point math.
+[[nodiscard]] bool isTooBigForMath(const Rect& bounds);
+
 /// @internal
 /// Determines if a stroke should be treated as a hairline.
 [[nodiscard]] std::optional<float> treatAsHairline(const Paint& paint, float strokeWidth,
@@ -103,7 +107,23 @@ class Painter {
                        Transform transform = Transform::identity(), const Mask* mask = nullptr,
                        BlitterWrapper* wrapper = nullptr);
 
-  /// Fills a path using the given fill rule.
+  /// Fills an axis-aligned rectangle with exactly the coverage fillPath produces for
+  /// `Path::fromRect(rect)`. Unlike fillRect, whose identity-transform case uses the hairline
+  /// rect filler, this matches a rectangle drawn as a path pixel for pixel.
+  ///
+  /// Anti-aliased fills with the analytic scan backend under a transform without skew skip path
+  /// construction and the edge list entirely; anything else is forwarded to fillPath.
+  ///
+  /// Rounded rects and ovals have no counterpart yet and are filled by fillPath.
+  ///
+  /// @param wrapper See fillRect.
+  static void fillAxisAlignedRect(MutablePixmapView& pixmap, const Rect& rect, const Paint& paint,
+                                  Transform transform = Transform::identity(),
+                                  const Mask* mask = nullptr, BlitterWrapper* wrapper = nullptr);
+
+  /// Fills a path using the given fill rule. A path that is a single axis-aligned rectangle is
+  /// filled through fillAxisAlignedRect. Anti-aliased fills use the scan converter selected by
+  /// Paint::scanBackend.
   ///
   /// @param wrapper See fillRect.
   static void fillPath(MutablePixmapView& pixmap, const Path& path, const Paint& paint,
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 
 // Selects the ISA branch below and pulls in the matching intrinsics header.
 #include "tiny_skia/filter/SimdVec.h"
@@ -176,69 +177,52 @@ void colorMatrix(Pixmap& pixmap, const std::array<double, 20>& matrix) {
   auto data = pixmap.data();
   const std::size_t pixelCount = data.size() / 4;
 
+  // The matrix runs through the same column vectors as the float path, with each 8-bit pixel
+  // widened on the way in and rounded on the way out, so both storages share one kernel.
+  float m[20];
+  for (int j = 0; j < 20; ++j) {
+    m[j] = static_cast<float>(matrix[j]);
+  }
+
+  const ColorMatrixColumns columns(m);
+  const auto toByte = [](float value) {
+    return static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+  };
+
   for (std::size_t i = 0; i < pixelCount; ++i) {
-    const std::size_t offset = i * 4;
-    const double pa = data[offset + 3];
-
-    if (pa == 0) {
-      // Fully transparent: only the translation components can produce non-zero output.
-      // Apply matrix to [0,0,0,0,1].
-      const double nr = matrix[4] * 255.0;
-      const double ng = matrix[9] * 255.0;
-      const double nb = matrix[14] * 255.0;
-      const double na = matrix[19] * 255.0;
-
-      const double ca = std::clamp(na, 0.0, 255.0);
-      if (ca == 0) {
-        continue;  // Still transparent.
+    std::uint8_t* px = data.data() + i * 4;
+    float out[4];
+
+    if (px[3] == 0) {
+      // Fully transparent: only the translation column can produce output.
+      const float ca = std::clamp(m[19], 0.0f, 1.0f);
+      if (ca == 0.0f) {
+        continue;
       }
-      const double alphaScale = ca / 255.0;
-      data[offset + 0] =
-          static_cast<std::uint8_t>(std::clamp(std::round(nr * alphaScale), 0.0, 255.0));
-      data[offset + 1] =
-          static_cast<std::uint8_t>(std::clamp(std::round(ng * alphaScale), 0.0, 255.0));
-      data[offset + 2] =
-          static_cast<std::uint8_t>(std::clamp(std::round(nb * alphaScale), 0.0, 255.0));
-      data[offset + 3] = static_cast<std::uint8_t>(std::round(ca));
-      continue;
+      out[0] = std::clamp(m[4] * ca, 0.0f, 1.0f);
+      out[1] = std::clamp(m[9] * ca, 0.0f, 1.0f);
+      out[2] = std::clamp(m[14] * ca, 0.0f, 1.0f);
+      out[3] = ca;
+    } else {
+      // Unpremultiply, then apply the matrix, clamp, and re-premultiply. Every output is in
+      // [0, 1], since a nonzero 8-bit alpha cannot overflow the reciprocal.
+      const float invAlpha = 1.0f / static_cast<float>(px[3]);
+      columns.apply(px[0] * invAlpha, px[1] * invAlpha, px[2] * invAlpha, px[3] / 255.0f, out);
     }
 
-    // Unpremultiply.
-    const double invAlpha = 255.0 / pa;
-    const double r = data[offset + 0] * invAlpha;
-    const double g = data[offset + 1] * invAlpha;
-    const double b = data[offset + 2] * invAlpha;
-    const double a = pa;
-
-    // Apply 5x4 matrix: [R,G,B,A,1] -> [R',G',B',A']
-    // Translation components (matrix[4], [9], [14], [19]) are in 0-1 range per SVG spec,
-    // scaled to 0-255 here.
-    const double nr = matrix[0] * r + matrix[1] * g + matrix[2] * b + matrix[3] * a +
-                      matrix[4] * 255.0;
-    const double ng = matrix[5] * r + matrix[6] * g + matrix[7] * b + matrix[8] * a +
-                      matrix[9] * 255.0;
-    const double nb = matrix[10] * r + matrix[11] * g + matrix[12] * b + matrix[13] * a +
-                      matrix[14] * 255.0;
-    const double na = matrix[15] * r + matrix[16] * g + matrix[17] * b + matrix[18] * a +
-                      matrix[19] * 255.0;
-
-    // Clamp and re-premultiply.
-    const double ca = std::clamp(na, 0.0, 255.0);
-    const double alphaScale = ca / 255.0;
-    data[offset + 0] =
-        static_cast<std::uint8_t>(std::clamp(std::round(std::clamp(nr, 0.0, 255.0) * alphaScale), 0.0, 255.0));
-    data[offset + 1] =
-        static_cast<std::uint8_t>(std::clamp(std::round(std::clamp(ng, 0.0, 255.0) * alphaScale), 0.0, 255.0));
-    data[offset + 2] =
-        static_cast<std::uint8_t>(std::clamp(std::round(std::clamp(nb, 0.0, 255.0) * alphaScale), 0.0, 255.0));
-    data[offset + 3] = static_cast<std::uint8_t>(std::round(ca));
+    for (std::size_t channel = 0; channel < 4; ++channel) {
+      px[channel] = toByte(out[channel]);
+    }
   }
 }
 
 void colorMatrix(FloatPixmap& pixmap, const std::array<double, 20>& matrix) {
-  auto data = pixmap.data();
-  const std::size_t pixelCount = data.size() / 4;
-  float* ptr = data.data();
+  colorMatrix(pixmap.data(), matrix);
+}
+
+void colorMatrix(std::span<float> pixels, const std::array<double, 20>& matrix) {
+  const std::size_t pixelCount = pixels.size() / 4;
+  float* ptr = pixels.data();
 
   // Pre-convert matrix to float for faster per-pixel math.
   float m[20];
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <span>
 
 #include "tiny_skia/Pixmap.h"
 #include "tiny_skia/filter/FloatPixmap.h"
@@ -25,6 +26,13 @@ void colorMatrix(Pixmap& pixmap, const std::array<double, 20>& matrix);
 /// Operates on [0,1] values. Translation components are in 0-1 range per SVG spec.
 void colorMatrix(FloatPixmap& pixmap, const std::array<double, 20>& matrix);
 
+/// Float-precision colorMatrix over a run of premultiplied RGBA pixels, so a caller can transform
+/// one strip of a buffer at a time. Produces the same values as the FloatPixmap overload.
+///
+/// @param pixels Pixels to transform in-place, four floats per pixel.
+/// @param matrix 20-element color matrix in row-major order.
+void colorMatrix(std::span<float> pixels, const std::array<double, 20>& matrix);
+
 /// Build a saturate color matrix (ITU-R BT.709 luminance weights).
 /// @param s Saturation coefficient. 0 = grayscale, 1 = identity.
 std::array<double, 20> saturateMatrix(double s);
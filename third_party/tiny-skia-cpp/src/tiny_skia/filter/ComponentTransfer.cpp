@@ -198,7 +198,12 @@ double evalTransferFunc(const TransferFunc& func, double c) {
 
 void componentTransfer(FloatPixmap& pixmap, const TransferFunc& funcR, const TransferFunc& funcG,
                        const TransferFunc& funcB, const TransferFunc& funcA) {
-  auto data = pixmap.data();
+  componentTransfer(pixmap.data(), funcR, funcG, funcB, funcA);
+}
+
+void componentTransfer(std::span<float> data, const TransferFunc& funcR,
+                       const TransferFunc& funcG, const TransferFunc& funcB,
+                       const TransferFunc& funcA) {
   const std::size_t pixelCount = data.size() / 4;
 
   for (std::size_t i = 0; i < pixelCount; ++i) {
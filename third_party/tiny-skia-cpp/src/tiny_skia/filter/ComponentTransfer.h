@@ -49,4 +49,11 @@ void componentTransfer(Pixmap& pixmap, const TransferFunc& funcR, const Transfer
 void componentTransfer(FloatPixmap& pixmap, const TransferFunc& funcR, const TransferFunc& funcG,
                        const TransferFunc& funcB, const TransferFunc& funcA);
 
+/// Float-precision componentTransfer over a run of premultiplied RGBA pixels, so a caller can
+/// transform one strip of a buffer at a time. Produces the same values as the FloatPixmap
+/// overload.
+void componentTransfer(std::span<float> pixels, const TransferFunc& funcR,
+                       const TransferFunc& funcG, const TransferFunc& funcB,
+                       const TransferFunc& funcA);
+
 }  // namespace tiny_skia::filter
@@ -1,12 +1,198 @@
 #include "tiny_skia/filter/Composite.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 
 #include "tiny_skia/filter/SimdVec.h"
 
 namespace tiny_skia::filter {
 
+namespace {
+
+/// Skia's div255: (v + 128 + ((v + 128) >> 8)) >> 8, exact for v <= 255*255.
+std::uint32_t div255(std::uint32_t v) { return (v + 128 + ((v + 128) >> 8)) >> 8; }
+
+/// A Porter-Duff weight in terms of one input's alpha, in 8-bit fixed point where 255 is 1.
+enum class Weight : std::uint8_t {
+  Zero,      ///< 0.
+  One,       ///< 255.
+  Alpha,     ///< The alpha.
+  InvAlpha,  ///< 255 minus the alpha.
+};
+
+/// The weights of an operator: `fa` scales `in1` and is in terms of `in2`'s alpha, `fb` scales
+/// `in2` and is in terms of `in1`'s alpha.
+struct PorterDuffWeights {
+  Weight fa = Weight::One;
+  Weight fb = Weight::Zero;
+};
+
+PorterDuffWeights porterDuffWeights(CompositeOp op) {
+  switch (op) {
+    case CompositeOp::Over: return {Weight::One, Weight::InvAlpha};
+    case CompositeOp::In: return {Weight::Alpha, Weight::Zero};
+    case CompositeOp::Out: return {Weight::InvAlpha, Weight::Zero};
+    case CompositeOp::Atop: return {Weight::Alpha, Weight::InvAlpha};
+    case CompositeOp::Xor: return {Weight::InvAlpha, Weight::InvAlpha};
+    case CompositeOp::Lighter:
+    case CompositeOp::Arithmetic: break;
+  }
+  return {Weight::One, Weight::One};
+}
+
+std::uint32_t weightValue(Weight weight, std::uint32_t alpha) {
+  switch (weight) {
+    case Weight::Zero: return 0;
+    case Weight::One: return 255;
+    case Weight::Alpha: return alpha;
+    case Weight::InvAlpha: return 255 - alpha;
+  }
+  return 0;
+}
+
+/// Porter-Duff of one 8-bit pixel pair: out = div255(in1 * Fa) + div255(in2 * Fb), saturated at
+/// 255. Each product is rounded on its own, so a weight of 255 passes its input through exactly.
+///
+/// Used directly by the scalar path and as the vector paths' tail, so both produce the same bytes
+/// for a partial group of pixels.
+void porterDuffPixel(std::uint8_t* out, const std::uint8_t* in1, const std::uint8_t* in2,
+                     PorterDuffWeights weights) {
+  const std::uint32_t fa = weightValue(weights.fa, in2[3]);
+  const std::uint32_t fb = weightValue(weights.fb, in1[3]);
+  for (std::size_t channel = 0; channel < 4; ++channel) {
+    out[channel] = static_cast<std::uint8_t>(
+        std::min(255u, div255(static_cast<std::uint32_t>(in1[channel]) * fa) +
+                           div255(static_cast<std::uint32_t>(in2[channel]) * fb)));
+  }
+}
+
+#if defined(TINY_SKIA_SIMD_NEON) || defined(TINY_SKIA_SIMD_WASM_SIMD128) || \
+    defined(TINY_SKIA_SIMD_SSE2)
+#define TINY_SKIA_FILTER_COMPOSITE_VECTOR 1
+
+/// Porter-Duff of four consecutive 8-bit pixel pairs (16 bytes each), bit-identical to
+/// `porterDuffPixel`.
+///
+/// Works on two pixels per 16-bit vector, like Merge.cpp's `mergeFourPixels`. Every product is at
+/// most 255 * 255, so the div255 intermediates stay in 16-bit range (65407), and the sum of two
+/// rounded terms is at most 510, which the saturating narrow clamps to 255 whether it reads the
+/// lanes as signed or unsigned.
+void porterDuffFourPixels(std::uint8_t* out, const std::uint8_t* in1, const std::uint8_t* in2,
+                          PorterDuffWeights weights) {
+#if defined(TINY_SKIA_SIMD_NEON)
+  const uint8x16_t px1 = vld1q_u8(in1);
+  const uint8x16_t px2 = vld1q_u8(in2);
+  const uint16x8_t w1[2] = {vmovl_u8(vget_low_u8(px1)), vmovl_u8(vget_high_u8(px1))};
+  const uint16x8_t w2[2] = {vmovl_u8(vget_low_u8(px2)), vmovl_u8(vget_high_u8(px2))};
+  const uint16x8_t full = vdupq_n_u16(255);
+
+  // Broadcast each pixel's alpha (lane 3 of its four) over that pixel's lanes.
+  const auto alphaLanes = [](uint16x8_t px) {
+    return vcombine_u16(vdup_n_u16(vgetq_lane_u16(px, 3)), vdup_n_u16(vgetq_lane_u16(px, 7)));
+  };
+  const auto weightLanes = [&](Weight weight, uint16x8_t alpha) {
+    switch (weight) {
+      case Weight::Zero: return vdupq_n_u16(0);
+      case Weight::One: return full;
+      case Weight::Alpha: return alpha;
+      case Weight::InvAlpha: return vsubq_u16(full, alpha);
+    }
+    return vdupq_n_u16(0);
+  };
+  const auto div255Lanes = [](uint16x8_t v) {
+    const uint16x8_t t = vaddq_u16(v, vdupq_n_u16(128));
+    return vshrq_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8);
+  };
+
+  uint8x8_t result[2];
+  for (int half = 0; half < 2; ++half) {
+    const uint16x8_t fa = weightLanes(weights.fa, alphaLanes(w2[half]));
+    const uint16x8_t fb = weightLanes(weights.fb, alphaLanes(w1[half]));
+    result[half] = vqmovn_u16(vaddq_u16(div255Lanes(vmulq_u16(w1[half], fa)),
+                                        div255Lanes(vmulq_u16(w2[half], fb))));
+  }
+  vst1q_u8(out, vcombine_u8(result[0], result[1]));
+
+#elif defined(TINY_SKIA_SIMD_WASM_SIMD128)
+  const v128_t px1 = wasm_v128_load(in1);
+  const v128_t px2 = wasm_v128_load(in2);
+  const v128_t w1[2] = {wasm_u16x8_extend_low_u8x16(px1), wasm_u16x8_extend_high_u8x16(px1)};
+  const v128_t w2[2] = {wasm_u16x8_extend_low_u8x16(px2), wasm_u16x8_extend_high_u8x16(px2)};
+  const v128_t full = wasm_i16x8_splat(255);
+
+  // Broadcast each pixel's alpha (lane 3 of its four) over that pixel's lanes.
+  const auto alphaLanes = [](v128_t px) {
+    return wasm_i16x8_shuffle(px, px, 3, 3, 3, 3, 7, 7, 7, 7);
+  };
+  const auto weightLanes = [&](Weight weight, v128_t alpha) {
+    switch (weight) {
+      case Weight::Zero: return wasm_i16x8_splat(0);
+      case Weight::One: return full;
+      case Weight::Alpha: return alpha;
+      case Weight::InvAlpha: return wasm_i16x8_sub(full, alpha);
+    }
+    return wasm_i16x8_splat(0);
+  };
+  // The shifts must be logical, so they use the u16 form.
+  const auto div255Lanes = [](v128_t v) {
+    const v128_t t = wasm_i16x8_add(v, wasm_i16x8_splat(128));
+    return wasm_u16x8_shr(wasm_i16x8_add(t, wasm_u16x8_shr(t, 8)), 8);
+  };
+
+  v128_t result[2];
+  for (int half = 0; half < 2; ++half) {
+    const v128_t fa = weightLanes(weights.fa, alphaLanes(w2[half]));
+    const v128_t fb = weightLanes(weights.fb, alphaLanes(w1[half]));
+    result[half] = wasm_i16x8_add(div255Lanes(wasm_i16x8_mul(w1[half], fa)),
+                                  div255Lanes(wasm_i16x8_mul(w2[half], fb)));
+  }
+  wasm_v128_store(out, wasm_u8x16_narrow_i16x8(result[0], result[1]));
+
+#elif defined(TINY_SKIA_SIMD_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i px1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1));
+  const __m128i px2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in2));
+  const __m128i w1[2] = {_mm_unpacklo_epi8(px1, zero), _mm_unpackhi_epi8(px1, zero)};
+  const __m128i w2[2] = {_mm_unpacklo_epi8(px2, zero), _mm_unpackhi_epi8(px2, zero)};
+  const __m128i full = _mm_set1_epi16(255);
+
+  // Broadcast each pixel's alpha (lane 3 of its four) over that pixel's lanes. SSE2 has no byte
+  // shuffle, so this uses the 16-bit half shuffles.
+  const auto alphaLanes = [](__m128i px) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, _MM_SHUFFLE(3, 3, 3, 3)),
+                               _MM_SHUFFLE(3, 3, 3, 3));
+  };
+  const auto weightLanes = [&](Weight weight, __m128i alpha) {
+    switch (weight) {
+      case Weight::Zero: return zero;
+      case Weight::One: return full;
+      case Weight::Alpha: return alpha;
+      case Weight::InvAlpha: return _mm_sub_epi16(full, alpha);
+    }
+    return zero;
+  };
+  // The shifts must be logical, hence _mm_srli_epi16.
+  const auto div255Lanes = [](__m128i v) {
+    const __m128i t = _mm_add_epi16(v, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+  };
+
+  __m128i result[2];
+  for (int half = 0; half < 2; ++half) {
+    const __m128i fa = weightLanes(weights.fa, alphaLanes(w2[half]));
+    const __m128i fb = weightLanes(weights.fb, alphaLanes(w1[half]));
+    result[half] = _mm_add_epi16(div255Lanes(_mm_mullo_epi16(w1[half], fa)),
+                                 div255Lanes(_mm_mullo_epi16(w2[half], fb)));
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(result[0], result[1]));
+#endif
+}
+#endif
+
+}  // namespace
+
 void composite(const Pixmap& in1, const Pixmap& in2, Pixmap& dst, CompositeOp op, double k1,
                double k2, double k3, double k4) {
   const auto src1 = in1.data();
@@ -15,63 +201,46 @@ void composite(const Pixmap& in1, const Pixmap& in2, Pixmap& dst, CompositeOp op
 
   const std::size_t pixelCount = std::min({src1.size(), src2.size(), out.size()}) / 4;
 
-  for (std::size_t i = 0; i < pixelCount; ++i) {
-    const std::size_t off = i * 4;
+  if (op != CompositeOp::Arithmetic) {
+    const PorterDuffWeights weights = porterDuffWeights(op);
+    std::size_t i = 0;
 
-    // Premultiplied RGBA values normalized to [0, 1].
-    const double r1 = src1[off + 0] / 255.0;
-    const double g1 = src1[off + 1] / 255.0;
-    const double b1 = src1[off + 2] / 255.0;
-    const double a1 = src1[off + 3] / 255.0;
-
-    const double r2 = src2[off + 0] / 255.0;
-    const double g2 = src2[off + 1] / 255.0;
-    const double b2 = src2[off + 2] / 255.0;
-    const double a2 = src2[off + 3] / 255.0;
-
-    double ro = 0.0;
-    double go = 0.0;
-    double bo = 0.0;
-    double ao = 0.0;
-
-    // Porter-Duff compositing on premultiplied values:
-    // Co = Fa * C1 + Fb * C2
-    // Ao = Fa * A1 + Fb * A2
-    auto porterDuff = [&](double fa, double fb) {
-      ro = fa * r1 + fb * r2;
-      go = fa * g1 + fb * g2;
-      bo = fa * b1 + fb * b2;
-      ao = fa * a1 + fb * a2;
-    };
-
-    switch (op) {
-      case CompositeOp::Over: porterDuff(1.0, 1.0 - a1); break;
-      case CompositeOp::In: porterDuff(a2, 0.0); break;
-      case CompositeOp::Out: porterDuff(1.0 - a2, 0.0); break;
-      case CompositeOp::Atop: porterDuff(a2, 1.0 - a1); break;
-      case CompositeOp::Xor: porterDuff(1.0 - a2, 1.0 - a1); break;
-      case CompositeOp::Lighter: porterDuff(1.0, 1.0); break;
-      case CompositeOp::Arithmetic:
-        ro = k1 * r1 * r2 + k2 * r1 + k3 * r2 + k4;
-        go = k1 * g1 * g2 + k2 * g1 + k3 * g2 + k4;
-        bo = k1 * b1 * b2 + k2 * b1 + k3 * b2 + k4;
-        ao = k1 * a1 * a2 + k2 * a1 + k3 * a2 + k4;
-        break;
+#if defined(TINY_SKIA_FILTER_COMPOSITE_VECTOR)
+    // Process 4 pixels (16 bytes) at a time.
+    const std::size_t vectorCount = pixelCount & ~std::size_t{3};
+    for (; i < vectorCount; i += 4) {
+      porterDuffFourPixels(&out[i * 4], &src1[i * 4], &src2[i * 4], weights);
     }
+#endif
 
-    out[off + 0] = static_cast<std::uint8_t>(std::clamp(ro * 255.0, 0.0, 255.0));
-    out[off + 1] = static_cast<std::uint8_t>(std::clamp(go * 255.0, 0.0, 255.0));
-    out[off + 2] = static_cast<std::uint8_t>(std::clamp(bo * 255.0, 0.0, 255.0));
-    out[off + 3] = static_cast<std::uint8_t>(std::clamp(ao * 255.0, 0.0, 255.0));
+    // Handle the remaining pixels one at a time.
+    for (; i < pixelCount; ++i) {
+      porterDuffPixel(&out[i * 4], &src1[i * 4], &src2[i * 4], weights);
+    }
+    return;
+  }
+
+  // Arithmetic coefficients are arbitrary reals, so this stays in double precision and rounds
+  // once per channel.
+  for (std::size_t i = 0; i < pixelCount; ++i) {
+    const std::size_t off = i * 4;
+    for (std::size_t channel = 0; channel < 4; ++channel) {
+      const double c1 = src1[off + channel] / 255.0;
+      const double c2 = src2[off + channel] / 255.0;
+      const double result = k1 * c1 * c2 + k2 * c1 + k3 * c2 + k4;
+      out[off + channel] =
+          static_cast<std::uint8_t>(std::round(std::clamp(result * 255.0, 0.0, 255.0)));
+    }
   }
 }
 
 void composite(const FloatPixmap& in1, const FloatPixmap& in2, FloatPixmap& dst, CompositeOp op,
                double k1, double k2, double k3, double k4) {
-  const auto src1 = in1.data();
-  const auto src2 = in2.data();
-  auto out = dst.data();
+  composite(in1.data(), in2.data(), dst.data(), op, k1, k2, k3, k4);
+}
 
+void composite(std::span<const float> src1, std::span<const float> src2, std::span<float> out,
+               CompositeOp op, double k1, double k2, double k3, double k4) {
   const std::size_t pixelCount = std::min({src1.size(), src2.size(), out.size()}) / 4;
   const float* s1 = src1.data();
   const float* s2 = src2.data();
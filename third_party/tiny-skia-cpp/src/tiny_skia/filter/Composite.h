@@ -4,6 +4,7 @@
 /// @brief Porter-Duff compositing and arithmetic combination of two pixmaps.
 
 #include <cstdint>
+#include <span>
 
 #include "tiny_skia/Pixmap.h"
 #include "tiny_skia/filter/FloatPixmap.h"
@@ -41,4 +42,11 @@ void composite(const Pixmap& in1, const Pixmap& in2, Pixmap& dst, CompositeOp op
 void composite(const FloatPixmap& in1, const FloatPixmap& in2, FloatPixmap& dst, CompositeOp op,
                double k1 = 0.0, double k2 = 0.0, double k3 = 0.0, double k4 = 0.0);
 
+/// Float-precision composite over runs of premultiplied RGBA pixels, so a caller can composite
+/// one strip of a buffer at a time. Each output pixel is written only after both of its input
+/// pixels are read, so \p dst may alias \p in1 or \p in2 for an in-place composite.
+void composite(std::span<const float> in1, std::span<const float> in2, std::span<float> dst,
+               CompositeOp op, double k1 = 0.0, double k2 = 0.0, double k3 = 0.0,
+               double k4 = 0.0);
+
 }  // namespace tiny_skia::filter
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #include "tiny_skia/filter/Blend.h"
@@ -84,6 +85,99 @@ FloatPixmap createTransparentFloat(int w, int h) {
   return std::move(*fp);
 }
 
+Pixmap createTransparentPixmap(int w, int h) {
+  auto pixmap = Pixmap::fromSize(static_cast<std::uint32_t>(w), static_cast<std::uint32_t>(h));
+  if (!pixmap.has_value()) {
+    return Pixmap();
+  }
+  return std::move(*pixmap);
+}
+
+/// A transparent black buffer of either storage.
+template <typename PixmapT>
+PixmapT createTransparent(int w, int h) {
+  if constexpr (std::is_same_v<PixmapT, FloatPixmap>) {
+    return createTransparentFloat(w, h);
+  } else {
+    return createTransparentPixmap(w, h);
+  }
+}
+
+/// Buffers for one graph execution, handed back once the last node that reads them has run.
+///
+/// Every buffer a graph works with is the size of the source graphic, so a released buffer can
+/// back any later result. Drawing from the pool bounds the graph's buffer residency by the most
+/// results live at once rather than by its node count, and each reuse saves an allocation.
+///
+/// @tparam PixmapT FloatPixmap, or Pixmap for \ref FilterPrecision::Uint8.
+template <typename PixmapT>
+class BasicBufferPool {
+ public:
+  BasicBufferPool(int width, int height) : width_(width), height_(height) {}
+
+  /// Returns a transparent black buffer.
+  PixmapT acquire() {
+    if (free_.empty()) {
+      ++allocated_;
+      return createTransparent<PixmapT>(width_, height_);
+    }
+
+    PixmapT pixmap = takeFree();
+    auto data = pixmap.data();
+    std::fill(data.begin(), data.end(), 0);
+    return pixmap;
+  }
+
+  /// Returns a buffer whose contents are unspecified, for a caller that overwrites every pixel.
+  PixmapT acquireUninitialized() {
+    if (free_.empty()) {
+      ++allocated_;
+      return createTransparent<PixmapT>(width_, height_);
+    }
+
+    return takeFree();
+  }
+
+  /// Returns a buffer holding a copy of \p source.
+  PixmapT copyOf(const PixmapT& source) {
+    if (free_.empty()) {
+      ++allocated_;
+      return PixmapT(source);
+    }
+
+    PixmapT pixmap = takeFree();
+    std::copy(source.data().begin(), source.data().end(), pixmap.data().begin());
+    return pixmap;
+  }
+
+  /// Hands \p pixmap back for reuse. Buffers of another size, including the empty buffer a move
+  /// leaves behind, are dropped.
+  void recycle(PixmapT pixmap) {
+    if (pixmap.width() == static_cast<std::uint32_t>(width_) &&
+        pixmap.height() == static_cast<std::uint32_t>(height_) &&
+        pixmap.data().size() == static_cast<std::size_t>(width_) * height_ * 4) {
+      free_.push_back(std::move(pixmap));
+    }
+  }
+
+  /// Number of buffers the pool has allocated, which is at most the number held at once.
+  [[nodiscard]] std::size_t allocated() const { return allocated_; }
+
+ private:
+  PixmapT takeFree() {
+    PixmapT pixmap = std::move(free_.back());
+    free_.pop_back();
+    return pixmap;
+  }
+
+  int width_;
+  int height_;
+  std::vector<PixmapT> free_;
+  std::size_t allocated_ = 0;
+};
+
+using BufferPool = BasicBufferPool<FloatPixmap>;
+
 std::optional<Box> computeNonTransparentBounds(const FloatPixmap& pixmap) {
   const int w = static_cast<int>(pixmap.width());
   const int h = static_cast<int>(pixmap.height());
@@ -116,6 +210,43 @@ std::optional<Box> computeNonTransparentBounds(const FloatPixmap& pixmap) {
              static_cast<double>(maxY)};
 }
 
+/// Pixel columns [x0, x1) and rows [y0, y1) an axis-aligned subregion keeps.
+struct KeptRect {
+  int x0 = 0;
+  int y0 = 0;
+  int x1 = 0;
+  int y1 = 0;
+};
+
+/// The pixels of a `w`x`h` pixmap that the axis-aligned subregion `sr` keeps.
+///
+/// Clamps the kept-rect origin to the pixmap bounds as well as the far edge: clamping x0/y0 only
+/// at the low end (max(0, ...)) leaves them able to exceed w/h when the subregion maps entirely
+/// past the right/bottom edge, and a per-row "clear the left border [0, x0)" fill would then write
+/// x0*4 floats into a w*4-float row and walk past the buffer. Clamping to [0, w]/[0, h] keeps every
+/// fill in bounds; a fully-outside subregion collapses to an empty kept rect (x0 == x1 or
+/// y0 == y1) so every pixel is cleared.
+KeptRect keptRect(const PixelRect& sr, int w, int h) {
+  return KeptRect{std::clamp(static_cast<int>(std::floor(sr.x)), 0, w),
+                  std::clamp(static_cast<int>(std::floor(sr.y)), 0, h),
+                  std::clamp(static_cast<int>(std::ceil(sr.x + sr.w)), 0, w),
+                  std::clamp(static_cast<int>(std::ceil(sr.y + sr.h)), 0, h)};
+}
+
+/// Clears the pixels of one strip of row `y`, starting at column `x0`, that `kept` excludes.
+void clearStripOutside(std::span<float> strip, int y, int x0, const KeptRect& kept) {
+  const int x1 = x0 + static_cast<int>(strip.size() / 4);
+  if (y < kept.y0 || y >= kept.y1) {
+    std::fill(strip.begin(), strip.end(), 0.0f);
+    return;
+  }
+
+  const int left = std::clamp(kept.x0, x0, x1);
+  const int right = std::clamp(kept.x1, x0, x1);
+  std::fill_n(strip.begin(), (left - x0) * 4, 0.0f);
+  std::fill(strip.begin() + (right - x0) * 4, strip.end(), 0.0f);
+}
+
 /// Apply subregion clipping on float pixmap: clear pixels outside the given rect.
 /// When filterFromDevice and userSpaceSubregion are provided, uses per-pixel point-in-rect
 /// testing for rotation-aware clipping instead of the axis-aligned bounding box.
@@ -151,16 +282,12 @@ void applySubregionClipping(FloatPixmap& output, const PixelRect& sr, int w, int
     return;
   }
 
-  // Axis-aligned fast path. Clamp the kept-rect origin to the pixmap bounds as well as the far
-  // edge: clamping rx0/ry0 only at the low end (max(0, ...)) leaves them able to exceed w/h when
-  // the subregion maps entirely past the right/bottom edge, and the per-row "clear the left border
-  // [0, rx0)" fill would then write rx0*4 bytes into a w*4-byte row and walk past the buffer.
-  // Clamping to [0, w]/[0, h] keeps every fill in bounds; a fully-outside subregion collapses to an
-  // empty kept rect (rx0 == rx1 or ry0 == ry1) so the whole pixmap is cleared.
-  const int rx0 = std::clamp(static_cast<int>(std::floor(sr.x)), 0, w);
-  const int ry0 = std::clamp(static_cast<int>(std::floor(sr.y)), 0, h);
-  const int rx1 = std::clamp(static_cast<int>(std::ceil(sr.x + sr.w)), 0, w);
-  const int ry1 = std::clamp(static_cast<int>(std::ceil(sr.y + sr.h)), 0, h);
+  // Axis-aligned fast path.
+  const KeptRect kept = keptRect(sr, w, h);
+  const int rx0 = kept.x0;
+  const int ry0 = kept.y0;
+  const int rx1 = kept.x1;
+  const int ry1 = kept.y1;
 
   auto data = output.data();
   for (int y = 0; y < ry0; ++y) {
@@ -187,6 +314,17 @@ double srgbToLinearChannel(double s) {
   return std::pow((s + 0.055) / 1.055, 2.4);
 }
 
+/// The flood color of a primitive, authored as premultiplied sRGB, in the space it interpolates
+/// in.
+std::array<float, 4> floodColorInSpace(std::uint8_t r, std::uint8_t g, std::uint8_t b,
+                                       std::uint8_t a, bool linearRGB) {
+  std::array<float, 4> color = {r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f};
+  if (linearRGB) {
+    color = srgbToLinearPixel(color);
+  }
+  return color;
+}
+
 /// Fills `pixmap` with a primitive's flood color, which is authored as premultiplied sRGB, in the
 /// space the primitive interpolates in.
 ///
@@ -196,10 +334,7 @@ double srgbToLinearChannel(double s) {
 /// pass over the whole buffer.
 void floodInSpace(FloatPixmap& pixmap, std::uint8_t r, std::uint8_t g, std::uint8_t b,
                   std::uint8_t a, bool linearRGB) {
-  std::array<float, 4> color = {r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f};
-  if (linearRGB) {
-    color = srgbToLinearPixel(color);
-  }
+  const std::array<float, 4> color = floodColorInSpace(r, g, b, a, linearRGB);
   flood(pixmap, color[0], color[1], color[2], color[3]);
 }
 
@@ -277,6 +412,10 @@ class SpacedPixmap {
   /// independent of the color space, such as moving or clearing pixels.
   [[nodiscard]] const FloatPixmap& spaceAgnostic() const { return pixmap_; }
 
+  /// Takes ownership of the stored pixels without converting, for the same space-independent
+  /// operations as \ref spaceAgnostic. The buffer must not be read afterwards.
+  FloatPixmap releaseStored() { return std::move(pixmap_); }
+
   /// Takes ownership of the pixels in the requested space, converting in place when no cached
   /// conversion exists. The buffer must not be read afterwards.
   FloatPixmap release(bool linear) {
@@ -303,6 +442,15 @@ class SpacedPixmap {
     return NodeOutput{std::move(pixmap), linear_, spaceInvariant_};
   }
 
+  /// Hands every buffer still held, including a converted twin, back to \p pool.
+  void recycle(BufferPool& pool) {
+    pool.recycle(std::move(pixmap_));
+    if (converted_.has_value()) {
+      pool.recycle(std::move(*converted_));
+      converted_.reset();
+    }
+  }
+
  private:
   FloatPixmap pixmap_;
   bool linear_ = false;
@@ -333,15 +481,638 @@ NodeInput inputOrDefault(const GraphNode& node, std::size_t index) {
   return index < node.inputs.size() ? node.inputs[index] : NodeInput();
 }
 
+/// True for primitives that generate their result without reading an input, neither its pixels
+/// nor its subregion.
+bool isGenerator(const GraphNode& node) {
+  return std::holds_alternative<graph_primitive::Flood>(node.primitive) ||
+         std::holds_alternative<graph_primitive::Turbulence>(node.primitive) ||
+         std::holds_alternative<graph_primitive::Image>(node.primitive);
+}
+
+/// The number of input slots a node reads, for its pixels or for its default subregion. A
+/// single-input primitive always reads slot 0, even when its input list is empty, and reads the
+/// subregion of every slot \ref inputSlotCount covers.
+std::size_t readSlotCount(const GraphNode& node) {
+  if (isGenerator(node)) {
+    return 0;
+  }
+
+  const std::size_t pixelSlots = std::holds_alternative<graph_primitive::Merge>(node.primitive)
+                                     ? node.inputs.size()
+                                     : std::max<std::size_t>(inputSlotCount(node), 1);
+  return std::max(pixelSlots, node.subregion.has_value() ? 0 : inputSlotCount(node));
+}
+
+/// Values are the buffers a graph reads: the four standard inputs, followed by one result per
+/// node.
+constexpr std::size_t kStandardInputCount = 4;
+
+/// The value of a standard input.
+constexpr std::size_t standardValue(StandardInput input) {
+  return static_cast<std::size_t>(input);
+}
+
+/// The value holding the result of node \p index.
+constexpr std::size_t nodeValue(std::size_t index) { return kStandardInputCount + index; }
+
+/// The interpolation space node \p node works in: true for linearRGB.
+bool nodeUsesLinearRGB(const FilterGraph& graph, const GraphNode& node) {
+  return node.useLinearRGB.value_or(graph.useLinearRGB);
+}
+
+/// True for the per-pixel primitives a fused pass can evaluate: each output pixel depends only on
+/// the same pixel of its inputs.
+bool isFusable(const GraphNode& node) {
+  return std::holds_alternative<graph_primitive::ColorMatrix>(node.primitive) ||
+         std::holds_alternative<graph_primitive::ComponentTransfer>(node.primitive) ||
+         std::holds_alternative<graph_primitive::Composite>(node.primitive) ||
+         std::holds_alternative<graph_primitive::Flood>(node.primitive);
+}
+
+/// Execution plan for a filter graph, derived from the graph's structure before any pixels are
+/// touched.
+///
+/// Every input is resolved once, up front, to the value it reads, the way the executor used to
+/// resolve it while running. With the whole read graph known, the executor skips nodes whose
+/// result never reaches the output, runs chains of per-pixel primitives as one pass, and hands a
+/// value's buffer back to the pool as soon as its last reader has run.
+struct CompiledGraph {
+  /// Per node, the value each slot read by \ref readSlotCount resolves to.
+  std::vector<std::vector<std::size_t>> slotValues;
+
+  /// Per node, true when its result reaches the graph's output.
+  std::vector<bool> live;
+
+  /// Per node, the first node of the fused pass computing its result, or the node itself.
+  std::vector<std::size_t> chainBegin;
+
+  /// Per node, the last node of the fused pass computing its result, or the node itself. Every
+  /// node before it in the pass feeds only the next one.
+  std::vector<std::size_t> chainEnd;
+
+  /// Per value, the last live node that reads it, if any.
+  std::vector<std::optional<std::size_t>> lastReader;
+
+  /// Per node, the values whose buffers are released once the pass ending at it has run.
+  std::vector<std::vector<std::size_t>> releaseAfter;
+
+  /// True if node \p index may take ownership of \p value's buffer instead of copying it:
+  /// nothing reads the value after this node, and the node reads it through a single slot.
+  [[nodiscard]] bool canConsume(std::size_t value, std::size_t index) const {
+    return lastReader[value] == index &&
+           std::count(slotValues[index].begin(), slotValues[index].end(), value) == 1;
+  }
+};
+
+/// Builds the execution plan for \p graph, which must have at least one node.
+CompiledGraph compileFilterGraph(const FilterGraph& graph) {
+  const std::size_t nodeCount = graph.nodes.size();
+  const std::size_t valueCount = kStandardInputCount + nodeCount;
+
+  CompiledGraph compiled;
+  compiled.slotValues.resize(nodeCount);
+  compiled.live.assign(nodeCount, false);
+  compiled.chainBegin.resize(nodeCount);
+  compiled.chainEnd.resize(nodeCount);
+  compiled.lastReader.assign(valueCount, std::nullopt);
+  compiled.releaseAfter.resize(nodeCount);
+
+  // Resolve each slot against the results defined so far. A name that is not defined yet falls
+  // back to the previous result, as does an unspecified input.
+  std::optional<std::size_t> previous;
+  std::map<std::string, std::size_t> names;
+  for (std::size_t i = 0; i < nodeCount; ++i) {
+    const GraphNode& node = graph.nodes[i];
+    const std::size_t previousValue =
+        previous.has_value() ? nodeValue(*previous) : standardValue(StandardInput::SourceGraphic);
+
+    for (std::size_t slot = 0; slot < readSlotCount(node); ++slot) {
+      const NodeInput input = inputOrDefault(node, slot);
+      std::size_t value = previousValue;
+      if (const auto* standard = std::get_if<StandardInput>(&input.value)) {
+        value = standardValue(*standard);
+      } else if (const auto* named = std::get_if<NodeInput::Named>(&input.value)) {
+        if (auto it = names.find(named->name); it != names.end()) {
+          value = nodeValue(it->second);
+        }
+      }
+      compiled.slotValues[i].push_back(value);
+    }
+
+    if (node.result.has_value()) {
+      names[*node.result] = i;
+    }
+    previous = i;
+  }
+
+  // Dead-node elimination: the last node is the graph's output, and a node is live if a live node
+  // reads its result.
+  compiled.live[nodeCount - 1] = true;
+  for (std::size_t i = nodeCount; i-- > 0;) {
+    if (!compiled.live[i]) {
+      continue;
+    }
+    for (const std::size_t value : compiled.slotValues[i]) {
+      if (value >= kStandardInputCount) {
+        compiled.live[value - kStandardInputCount] = true;
+      }
+    }
+  }
+
+  std::vector<std::size_t> readCount(valueCount, 0);
+  std::optional<std::size_t> firstSourceAlphaReader;
+  for (std::size_t i = 0; i < nodeCount; ++i) {
+    if (!compiled.live[i]) {
+      continue;
+    }
+    for (const std::size_t value : compiled.slotValues[i]) {
+      compiled.lastReader[value] = i;
+      ++readCount[value];
+      if (value == standardValue(StandardInput::SourceAlpha) && !firstSourceAlphaReader) {
+        firstSourceAlphaReader = i;
+      }
+    }
+  }
+
+  // SourceAlpha is built from SourceGraphic when it is first read, so the source must live until
+  // then.
+  if (firstSourceAlphaReader.has_value()) {
+    std::optional<std::size_t>& sourceReader =
+        compiled.lastReader[standardValue(StandardInput::SourceGraphic)];
+    sourceReader = std::max(sourceReader.value_or(0), *firstSourceAlphaReader);
+  }
+
+  // Pointwise fusion: node i runs inside the next node's pass when both are per-pixel primitives
+  // in the same space, the next node is the only reader of i's result, and i's subregion is
+  // axis-aligned so the pass can clip it strip by strip. A flood has no input, so it can only
+  // start a pass.
+  for (std::size_t i = 0; i < nodeCount; ++i) {
+    compiled.chainBegin[i] = i;
+  }
+  for (std::size_t i = 0; i + 1 < nodeCount; ++i) {
+    const GraphNode& node = graph.nodes[i];
+    const GraphNode& next = graph.nodes[i + 1];
+    if (!compiled.live[i] || !compiled.live[i + 1] || !isFusable(node) || !isFusable(next) ||
+        std::holds_alternative<graph_primitive::Flood>(next.primitive) ||
+        nodeUsesLinearRGB(graph, node) != nodeUsesLinearRGB(graph, next) ||
+        (graph.filterFromDevice.has_value() && node.userSpaceSubregion.has_value()) ||
+        readCount[nodeValue(i)] != 1) {
+      continue;
+    }
+
+    // A composite may read the chain through either operand; the other primitives read it as
+    // their only input.
+    const std::vector<std::size_t>& nextSlots = compiled.slotValues[i + 1];
+    const bool readsChain =
+        std::holds_alternative<graph_primitive::Composite>(next.primitive)
+            ? std::find(nextSlots.begin(), nextSlots.begin() + 2, nodeValue(i)) !=
+                  nextSlots.begin() + 2
+            : nextSlots[0] == nodeValue(i);
+    if (readsChain) {
+      compiled.chainBegin[i + 1] = compiled.chainBegin[i];
+    }
+  }
+  for (std::size_t i = nodeCount; i-- > 0;) {
+    const bool fusedWithNext =
+        i + 1 < nodeCount && compiled.chainBegin[i + 1] == compiled.chainBegin[i];
+    compiled.chainEnd[i] = fusedWithNext ? compiled.chainEnd[i + 1] : i;
+  }
+
+  // Buffer liveness: a value is released after the pass that contains its last reader.
+  for (std::size_t value = 0; value < valueCount; ++value) {
+    if (const std::optional<std::size_t>& reader = compiled.lastReader[value]) {
+      compiled.releaseAfter[compiled.chainEnd[*reader]].push_back(value);
+    }
+  }
+
+  return compiled;
+}
+
+/// The subregion of node \p index: its own, or the default the spec derives from its inputs'
+/// subregions (\p subregions, one per value), both limited to the filter region.
+Box defaultNodeSubregion(const GraphNode& node, std::size_t index, const CompiledGraph& compiled,
+                         std::span<const Box> subregions, const Box& filterRegionBox) {
+  const bool isSourceGenerator = isGenerator(node) ||
+                                 std::holds_alternative<graph_primitive::Tile>(node.primitive);
+
+  if (node.subregion.has_value()) {
+    return Box::fromPixelRect(*node.subregion).intersect(filterRegionBox);
+  }
+
+  // Walk every slot the primitive reads, so a defaulted `in2` contributes its subregion the
+  // same way an explicit one would. The test is the slot count and not the populated list: a
+  // two-input primitive with nothing filled in still reads two defaulted inputs, so its bounds
+  // come from those defaults rather than from the whole filter region.
+  const std::size_t slots = inputSlotCount(node);
+  if (slots == 0 || isSourceGenerator) {
+    return filterRegionBox;
+  }
+
+  const std::vector<std::size_t>& slotValues = compiled.slotValues[index];
+  Box inputBounds = subregions[slotValues[0]];
+  for (std::size_t i = 1; i < slots; ++i) {
+    inputBounds = inputBounds.unite(subregions[slotValues[i]]);
+  }
+
+  return std::visit(
+             [&](const auto& primitive) -> Box {
+               using T = std::decay_t<decltype(primitive)>;
+
+               if constexpr (std::is_same_v<T, graph_primitive::GaussianBlur>) {
+                 const double expandX = std::ceil(primitive.sigmaX * 3.0);
+                 const double expandY = std::ceil(primitive.sigmaY * 3.0);
+                 return inputBounds.outset(expandX, expandY);
+               } else if constexpr (std::is_same_v<T, graph_primitive::DropShadow>) {
+                 const double expandX = std::ceil(primitive.sigmaX * 3.0);
+                 const double expandY = std::ceil(primitive.sigmaY * 3.0);
+                 const Box shadowBounds = inputBounds
+                                              .translate(static_cast<double>(primitive.dx),
+                                                         static_cast<double>(primitive.dy))
+                                              .outset(expandX, expandY);
+                 return inputBounds.unite(shadowBounds);
+               } else if constexpr (std::is_same_v<T, graph_primitive::Morphology>) {
+                 if (primitive.op == MorphologyOp::Dilate) {
+                   return inputBounds.outset(static_cast<double>(primitive.radiusX),
+                                             static_cast<double>(primitive.radiusY));
+                 }
+
+                 return inputBounds;
+               } else {
+                 return inputBounds;
+               }
+             },
+             node.primitive)
+      .intersect(filterRegionBox);
+}
+
+/// One primitive of a fused pass, with its parameters prepared for the strip loop.
+struct FusedStage {
+  /// The primitive, one of the \ref isFusable types.
+  const GraphPrimitive* primitive = nullptr;
+
+  /// Operands read from buffers rather than from the pass's running value. A color matrix or
+  /// transfer that starts a pass reads its input through `in1`, unless the pass took ownership of
+  /// that buffer; a composite reads whichever operands do not come from the previous stage.
+  const FloatPixmap* in1 = nullptr;
+  const FloatPixmap* in2 = nullptr;
+
+  /// Flood color, already in the pass's space.
+  std::array<float, 4> floodColor = {};
+
+  /// Transfer functions, referring to the primitive's tables.
+  std::array<TransferFunc, 4> transfer;
+
+  /// The subregion of a stage whose result only feeds the next stage. The pass's own result is
+  /// clipped like any other node's.
+  std::optional<KeptRect> clip;
+};
+
+/// Pixels per strip of a fused pass: small enough for the running value to stay in the L1 cache
+/// between stages, large enough to amortize the per-stage dispatch.
+constexpr int kFusedStripPixels = 256;
+
+/// Runs \p stages over \p output one strip at a time, so each pixel visits every stage while it
+/// is still in cache instead of every stage making its own pass over a full buffer.
+///
+/// Every stage uses the same per-pixel arithmetic as its standalone primitive, and a stage's clip
+/// clears exactly the pixels its standalone result would have cleared, so the result is
+/// bit-identical to running the stages one after another.
+void runFusedPass(std::span<const FusedStage> stages, FloatPixmap& output) {
+  const int w = static_cast<int>(output.width());
+  const int h = static_cast<int>(output.height());
+  auto data = output.data();
+
+  for (int y = 0; y < h; ++y) {
+    for (int x0 = 0; x0 < w; x0 += kFusedStripPixels) {
+      const std::size_t offset = static_cast<std::size_t>(y * w + x0) * 4;
+      const std::size_t count = static_cast<std::size_t>(std::min(kFusedStripPixels, w - x0)) * 4;
+      const std::span<float> strip = data.subspan(offset, count);
+      const auto operand = [&](const FloatPixmap* pixmap) -> std::span<const float> {
+        return pixmap != nullptr ? pixmap->data().subspan(offset, count) : strip;
+      };
+
+      for (const FusedStage& stage : stages) {
+        VisitPrimitive(
+            [&](const auto& primitive) {
+              using T = std::decay_t<decltype(primitive)>;
+
+              if constexpr (std::is_same_v<T, graph_primitive::Flood>) {
+                for (std::size_t i = 0; i < count; i += 4) {
+                  std::copy(stage.floodColor.begin(), stage.floodColor.end(), strip.begin() + i);
+                }
+              } else if constexpr (std::is_same_v<T, graph_primitive::ColorMatrix>) {
+                if (stage.in1 != nullptr) {
+                  const std::span<const float> input = operand(stage.in1);
+                  std::copy(input.begin(), input.end(), strip.begin());
+                }
+                if (primitive.matrix != identityMatrix()) {
+                  colorMatrix(strip, primitive.matrix);
+                }
+              } else if constexpr (std::is_same_v<T, graph_primitive::ComponentTransfer>) {
+                if (stage.in1 != nullptr) {
+                  const std::span<const float> input = operand(stage.in1);
+                  std::copy(input.begin(), input.end(), strip.begin());
+                }
+                componentTransfer(strip, stage.transfer[0], stage.transfer[1], stage.transfer[2],
+                                  stage.transfer[3]);
+              } else if constexpr (std::is_same_v<T, graph_primitive::Composite>) {
+                composite(operand(stage.in1), operand(stage.in2), strip, primitive.op,
+                          primitive.k1, primitive.k2, primitive.k3, primitive.k4);
+              }
+            },
+            *stage.primitive);
+
+        if (stage.clip.has_value()) {
+          clearStripOutside(strip, y, x0, *stage.clip);
+        }
+      }
+    }
+  }
+}
+
+/// Adapts an owning transfer function to the primitive's view of it.
+TransferFunc toTransferFunc(const graph_primitive::ComponentTransfer::Func& f) {
+  TransferFunc tf;
+  tf.type = f.type;
+  tf.tableValues = f.tableValues;
+  tf.slope = f.slope;
+  tf.intercept = f.intercept;
+  tf.amplitude = f.amplitude;
+  tf.exponent = f.exponent;
+  tf.offset = f.offset;
+  return tf;
+}
+
+/// True if \ref executeUint8 covers \p graph: every node that runs is one of the primitives
+/// \ref FilterPrecision::Uint8 lists, nothing reads a paint input, no clip is rotation-aware,
+/// and every node that depends on the space works in the same one, which \p linearRGB receives.
+///
+/// A single space means the graph converts once on entry and once on exit; a graph that crosses
+/// between spaces would round its pixels through 8 bits at every crossing.
+bool supportsUint8(const FilterGraph& graph, const CompiledGraph& compiled, bool& linearRGB) {
+  if (compiled.lastReader[standardValue(StandardInput::FillPaint)].has_value() ||
+      compiled.lastReader[standardValue(StandardInput::StrokePaint)].has_value()) {
+    return false;
+  }
+
+  const bool rotationAware = graph.filterFromDevice.has_value();
+  if (rotationAware && graph.clipSourceToFilterRegion && graph.userSpaceFilterRegion.has_value()) {
+    return false;
+  }
+
+  std::optional<bool> space;
+  for (std::size_t index = 0; index < graph.nodes.size(); ++index) {
+    if (!compiled.live[index]) {
+      continue;
+    }
+
+    const GraphNode& node = graph.nodes[index];
+    const bool supported = std::visit(
+        [](const auto& primitive) {
+          using T = std::decay_t<decltype(primitive)>;
+          using namespace graph_primitive;
+          return std::is_same_v<T, GaussianBlur> || std::is_same_v<T, Flood> ||
+                 std::is_same_v<T, Offset> || std::is_same_v<T, Composite> ||
+                 std::is_same_v<T, Merge> || std::is_same_v<T, ColorMatrix> ||
+                 std::is_same_v<T, Morphology>;
+        },
+        node.primitive);
+    if (!supported || (rotationAware && node.userSpaceSubregion.has_value())) {
+      return false;
+    }
+
+    // feOffset only moves pixels, so it works in whatever space its input is in.
+    if (std::holds_alternative<graph_primitive::Offset>(node.primitive)) {
+      continue;
+    }
+
+    const bool nodeLinearRGB = nodeUsesLinearRGB(graph, node);
+    if (space.has_value() && *space != nodeLinearRGB) {
+      return false;
+    }
+    space = nodeLinearRGB;
+  }
+
+  linearRGB = space.value_or(false);
+  return true;
+}
+
+/// Clears the pixels of \p pixmap outside the axis-aligned subregion \p sr.
+void clearOutside(Pixmap& pixmap, const PixelRect& sr) {
+  const int w = static_cast<int>(pixmap.width());
+  const int h = static_cast<int>(pixmap.height());
+  const KeptRect kept = keptRect(sr, w, h);
+  auto data = pixmap.data();
+  const auto row = [&](int y) { return data.begin() + static_cast<std::ptrdiff_t>(y) * w * 4; };
+  for (int y = 0; y < h; ++y) {
+    if (y < kept.y0 || y >= kept.y1) {
+      std::fill(row(y), row(y) + w * 4, std::uint8_t{0});
+      continue;
+    }
+    std::fill(row(y), row(y) + kept.x0 * 4, std::uint8_t{0});
+    std::fill(row(y) + kept.x1 * 4, row(y) + w * 4, std::uint8_t{0});
+  }
+}
+
+/// Quantizes a [0, 1] channel to 8 bits.
+std::uint8_t toByte(float value) {
+  return static_cast<std::uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+/// Runs \p graph with premultiplied RGBA8 intermediates, for \ref FilterPrecision::Uint8. The
+/// graph must pass \ref supportsUint8.
+///
+/// Follows the float executor's plan and rules: dead nodes are skipped, every value is released
+/// after its last reader, and subregions are tracked and cleared the same way. What differs is
+/// the storage, so there is no per-node color space bookkeeping: the whole graph works in the
+/// single space \p linearRGB names, converted to on entry and back on exit.
+bool executeUint8(Pixmap& sourceGraphic, const FilterGraph& graph, const CompiledGraph& compiled,
+                  bool linearRGB, FilterGraphStats* stats) {
+  const int w = static_cast<int>(sourceGraphic.width());
+  const int h = static_cast<int>(sourceGraphic.height());
+  BasicBufferPool<Pixmap> pool(w, h);
+
+  const std::size_t sourceGraphicValue = standardValue(StandardInput::SourceGraphic);
+  const std::size_t sourceAlphaValue = standardValue(StandardInput::SourceAlpha);
+  std::vector<std::optional<Pixmap>> values(kStandardInputCount + graph.nodes.size());
+  {
+    Pixmap source = pool.copyOf(sourceGraphic);
+    if (graph.clipSourceToFilterRegion && graph.filterRegion.has_value()) {
+      clearOutside(source, *graph.filterRegion);
+    }
+    if (linearRGB) {
+      srgbToLinear(source);
+    }
+    values[sourceGraphicValue].emplace(std::move(source));
+  }
+
+  const Box fullRegion = Box::fromWH(w, h);
+  const Box filterRegionBox =
+      graph.filterRegion.has_value() ? Box::fromPixelRect(*graph.filterRegion) : fullRegion;
+  std::vector<Box> subregions(values.size(), fullRegion);
+
+  auto valueAt = [&](std::size_t value) -> Pixmap& {
+    std::optional<Pixmap>& stored = values[value];
+    if (!stored.has_value()) {
+      // Only SourceAlpha is built on first read; supportsUint8 rules out the paint inputs.
+      Pixmap alphaOnly = pool.copyOf(*values[sourceGraphicValue]);
+      auto data = alphaOnly.data();
+      for (std::size_t i = 0; i < data.size(); i += 4) {
+        data[i + 0] = 0;
+        data[i + 1] = 0;
+        data[i + 2] = 0;
+      }
+      stored.emplace(std::move(alphaOnly));
+    }
+    return *stored;
+  };
+
+  // The same ownership rule as the float executor: the source stays intact while a node from
+  // this one on may still build SourceAlpha from it.
+  auto canConsume = [&](std::size_t value, std::size_t index) {
+    return compiled.canConsume(value, index) &&
+           (value != sourceGraphicValue || !(compiled.lastReader[sourceAlphaValue] >= index));
+  };
+
+  // The pixels of slot 0 of node `index`, as a buffer the node may overwrite.
+  auto takeInput = [&](std::size_t index) -> Pixmap {
+    const std::size_t value = compiled.slotValues[index][0];
+    if (canConsume(value, index)) {
+      Pixmap pixmap = std::move(valueAt(value));
+      values[value].reset();
+      return pixmap;
+    }
+    return pool.copyOf(valueAt(value));
+  };
+
+  for (std::size_t index = 0; index < graph.nodes.size(); ++index) {
+    if (!compiled.live[index]) {
+      continue;
+    }
+
+    const GraphNode& node = graph.nodes[index];
+    const std::vector<std::size_t>& slots = compiled.slotValues[index];
+    const Box nodeSubregion =
+        defaultNodeSubregion(node, index, compiled, subregions, filterRegionBox);
+    subregions[nodeValue(index)] = nodeSubregion;
+
+    Pixmap output = VisitPrimitive(
+        [&](const auto& primitive) -> Pixmap {
+          using T = std::decay_t<decltype(primitive)>;
+          using namespace graph_primitive;
+
+          if constexpr (std::is_same_v<T, GaussianBlur>) {
+            Pixmap pixmap = takeInput(index);
+            gaussianBlur(pixmap, primitive.sigmaX, primitive.sigmaY, primitive.edgeMode);
+            return pixmap;
+
+          } else if constexpr (std::is_same_v<T, Flood>) {
+            const std::array<float, 4> color = floodColorInSpace(
+                primitive.r, primitive.g, primitive.b, primitive.a, linearRGB);
+            Pixmap pixmap = pool.acquireUninitialized();
+            flood(pixmap, toByte(color[0]), toByte(color[1]), toByte(color[2]),
+                  toByte(color[3]));
+            return pixmap;
+
+          } else if constexpr (std::is_same_v<T, Offset>) {
+            Pixmap pixmap = pool.acquireUninitialized();
+            filter::offset(valueAt(slots[0]), pixmap, primitive.dx, primitive.dy);
+            return pixmap;
+
+          } else if constexpr (std::is_same_v<T, Composite>) {
+            Pixmap pixmap = pool.acquireUninitialized();
+            composite(valueAt(slots[0]), valueAt(slots[1]), pixmap, primitive.op, primitive.k1,
+                      primitive.k2, primitive.k3, primitive.k4);
+            return pixmap;
+
+          } else if constexpr (std::is_same_v<T, Merge>) {
+            std::vector<const Pixmap*> layers;
+            layers.reserve(slots.size());
+            for (const std::size_t mergeInput : slots) {
+              layers.push_back(&valueAt(mergeInput));
+            }
+            Pixmap pixmap = pool.acquireUninitialized();
+            merge(std::span<const Pixmap* const>(layers), pixmap);
+            return pixmap;
+
+          } else if constexpr (std::is_same_v<T, ColorMatrix>) {
+            Pixmap pixmap = takeInput(index);
+            if (primitive.matrix != identityMatrix()) {
+              colorMatrix(pixmap, primitive.matrix);
+            }
+            return pixmap;
+
+          } else if constexpr (std::is_same_v<T, Morphology>) {
+            // A negative radius, or zero on both axes, disables the effect; see the float
+            // executor.
+            const bool disabled = primitive.radiusX < 0 || primitive.radiusY < 0 ||
+                                  (primitive.radiusX == 0 && primitive.radiusY == 0);
+            if (disabled) {
+              return takeInput(index);
+            }
+            Pixmap pixmap = pool.acquire();
+            morphology(valueAt(slots[0]), pixmap, primitive.op, primitive.radiusX,
+                       primitive.radiusY);
+            return pixmap;
+
+          } else {
+            // Unreachable: supportsUint8 admits only the primitives above.
+            return pool.acquire();
+          }
+        },
+        node.primitive);
+
+    clearOutside(output, PixelRect{nodeSubregion.x0, nodeSubregion.y0,
+                                   nodeSubregion.x1 - nodeSubregion.x0,
+                                   nodeSubregion.y1 - nodeSubregion.y0});
+    values[nodeValue(index)].emplace(std::move(output));
+
+    for (const std::size_t value : compiled.releaseAfter[index]) {
+      if (value == sourceGraphicValue && compiled.lastReader[sourceAlphaValue] > index) {
+        valueAt(sourceAlphaValue);
+      }
+      if (values[value].has_value()) {
+        pool.recycle(std::move(*values[value]));
+        values[value].reset();
+      }
+    }
+  }
+
+  if (stats != nullptr) {
+    stats->liveNodes =
+        static_cast<std::size_t>(std::count(compiled.live.begin(), compiled.live.end(), true));
+    stats->fusedNodes = 0;
+    stats->allocatedBuffers = pool.allocated();
+    stats->precision = FilterPrecision::Uint8;
+  }
+
+  Pixmap& result = *values[nodeValue(graph.nodes.size() - 1)];
+  if (linearRGB) {
+    linearToSrgb(result);
+  }
+  auto srcData = result.data();
+  auto dstData = sourceGraphic.data();
+  std::copy(srcData.begin(), srcData.end(), dstData.begin());
+  return true;
+}
+
 }  // namespace
 
-bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
+bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph, FilterGraphStats* stats) {
   const int w = static_cast<int>(sourceGraphic.width());
   const int h = static_cast<int>(sourceGraphic.height());
   if (w <= 0 || h <= 0 || graph.nodes.empty()) {
     return false;
   }
 
+  const CompiledGraph compiled = compileFilterGraph(graph);
+  bool linearRGB = false;
+  if (graph.precision == FilterPrecision::Uint8 && supportsUint8(graph, compiled, linearRGB)) {
+    return executeUint8(sourceGraphic, graph, compiled, linearRGB, stats);
+  }
+
+  BufferPool pool(w, h);
+
   // Float intermediate storage avoids uint8 quantization between nodes. Every buffer is
   // float [0,1] premultiplied, tagged with the color space it holds (see SpacedPixmap). The
   // graph's pixel data therefore crosses between sRGB and linearRGB only where two adjacent
@@ -358,192 +1129,196 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
     }
   }
 
-  // The source graphic and the paint inputs arrive as uint8 sRGB.
-  SpacedPixmap sourceFloat(std::move(sourceFloatPixels), /*linear=*/false);
-  std::optional<SpacedPixmap> fillPaintStorage =
-      graph.fillPaintInput.has_value()
-          ? std::make_optional(SpacedPixmap(FloatPixmap::fromPixmap(*graph.fillPaintInput),
-                                            /*linear=*/false))
-          : std::nullopt;
-  std::optional<SpacedPixmap> strokePaintStorage =
-      graph.strokePaintInput.has_value()
-          ? std::make_optional(SpacedPixmap(FloatPixmap::fromPixmap(*graph.strokePaintInput),
-                                            /*linear=*/false))
-          : std::nullopt;
-
-  // Buffer management.
-  SpacedPixmap* source = &sourceFloat;
-  SpacedPixmap* fillPaint = fillPaintStorage.has_value() ? &*fillPaintStorage : nullptr;
-  SpacedPixmap* strokePaint = strokePaintStorage.has_value() ? &*strokePaintStorage : nullptr;
-  std::optional<SpacedPixmap> transparentPaintInput;
-  std::optional<SpacedPixmap> sourceAlpha;
-  // A node's result is one buffer even when it is reachable under two names, as `result="x"` is
-  // also the implicit input of the next primitive. Sharing the object rather than copying it
-  // keeps a converted twin shared too, so a result consumed in both spaces converts once no
-  // matter which reference asks first.
-  std::shared_ptr<SpacedPixmap> previousOutput;
-  std::map<std::string, std::shared_ptr<SpacedPixmap>> namedBuffers;
-
-  // Subregion tracking.
+  // One buffer per value. A node's result is stored when the node runs, SourceAlpha and an absent
+  // paint input when first read, and every value is released after its last reader. The source
+  // graphic and the paint inputs arrive as uint8 sRGB.
+  const std::size_t sourceGraphicValue = standardValue(StandardInput::SourceGraphic);
+  const std::size_t fillPaintValue = standardValue(StandardInput::FillPaint);
+  const std::size_t strokePaintValue = standardValue(StandardInput::StrokePaint);
+  std::vector<std::optional<SpacedPixmap>> values(kStandardInputCount + graph.nodes.size());
+  values[sourceGraphicValue].emplace(std::move(sourceFloatPixels), /*linear=*/false);
+  if (graph.fillPaintInput.has_value()) {
+    values[fillPaintValue].emplace(FloatPixmap::fromPixmap(*graph.fillPaintInput),
+                                   /*linear=*/false);
+  }
+  if (graph.strokePaintInput.has_value()) {
+    values[strokePaintValue].emplace(FloatPixmap::fromPixmap(*graph.strokePaintInput),
+                                     /*linear=*/false);
+  }
+
+  // Subregion tracking, one box per value.
   const Box fullRegion = Box::fromWH(w, h);
   const Box filterRegionBox =
       graph.filterRegion.has_value() ? Box::fromPixelRect(*graph.filterRegion) : fullRegion;
-  Box previousOutputSubregion = fullRegion;
+  std::vector<Box> subregions(values.size(), fullRegion);
   // Alpha coverage does not depend on the color space, so the paint bounds can read the stored
   // pixels directly.
-  const std::optional<Box> fillPaintSubregion =
-      fillPaint != nullptr ? computeNonTransparentBounds(fillPaint->spaceAgnostic()) : std::nullopt;
-  const std::optional<Box> strokePaintSubregion =
-      strokePaint != nullptr ? computeNonTransparentBounds(strokePaint->spaceAgnostic())
-                             : std::nullopt;
-  std::map<std::string, Box> namedSubregions;
-
-  auto getTransparentPaintInput = [&]() -> SpacedPixmap* {
-    if (!transparentPaintInput.has_value()) {
-      transparentPaintInput = SpacedPixmap::alphaOnly(createTransparentFloat(w, h));
-    }
-    return &*transparentPaintInput;
-  };
+  for (const std::size_t paintValue : {fillPaintValue, strokePaintValue}) {
+    if (values[paintValue].has_value()) {
+      subregions[paintValue] =
+          computeNonTransparentBounds(values[paintValue]->spaceAgnostic()).value_or(fullRegion);
+    }
+  }
 
-  auto getSourceAlpha = [&]() -> SpacedPixmap* {
-    if (!sourceAlpha.has_value()) {
+  auto valueAt = [&](std::size_t value) -> SpacedPixmap* {
+    std::optional<SpacedPixmap>& stored = values[value];
+    if (stored.has_value()) {
+      return &*stored;
+    }
+
+    if (value == standardValue(StandardInput::SourceAlpha)) {
       // Zeroing RGB makes the buffer read the same in either space, so SourceAlpha never needs a
       // conversion pass regardless of which space the consuming primitive works in.
-      FloatPixmap alphaOnly(source->spaceAgnostic());
+      FloatPixmap alphaOnly = pool.copyOf(values[sourceGraphicValue]->spaceAgnostic());
       auto data = alphaOnly.data();
       for (int i = 0; i < w * h; ++i) {
         data[i * 4 + 0] = 0.0f;
         data[i * 4 + 1] = 0.0f;
         data[i * 4 + 2] = 0.0f;
       }
-      sourceAlpha = SpacedPixmap::alphaOnly(std::move(alphaOnly));
+      stored = SpacedPixmap::alphaOnly(std::move(alphaOnly));
+    } else {
+      // A paint input the caller did not provide reads as transparent black.
+      stored = SpacedPixmap::alphaOnly(pool.acquire());
     }
-    return &sourceAlpha.value();
+    return &*stored;
   };
 
-  auto resolveInput = [&](const NodeInput& input) -> SpacedPixmap* {
-    return std::visit(
-        [&](const auto& v) -> SpacedPixmap* {
-          using V = std::decay_t<decltype(v)>;
-          if constexpr (std::is_same_v<V, NodeInput::Previous>) {
-            return previousOutput ? previousOutput.get() : source;
-          } else if constexpr (std::is_same_v<V, StandardInput>) {
-            if (v == StandardInput::SourceGraphic) {
-              return source;
-            }
-            if (v == StandardInput::SourceAlpha) {
-              return getSourceAlpha();
-            }
-            if (v == StandardInput::FillPaint) {
-              return fillPaint != nullptr ? fillPaint : getTransparentPaintInput();
-            }
-            if (v == StandardInput::StrokePaint) {
-              return strokePaint != nullptr ? strokePaint : getTransparentPaintInput();
-            }
-            return source;
-          } else if constexpr (std::is_same_v<V, NodeInput::Named>) {
-            auto it = namedBuffers.find(v.name);
-            if (it != namedBuffers.end()) {
-              return it->second.get();
-            }
-            return previousOutput ? previousOutput.get() : source;
-          } else {
-            return source;
-          }
-        },
-        input.value);
+  // True if node `index` may overwrite `value`'s buffer. SourceAlpha is built from the source on
+  // first read, so the source stays intact while any node from this one on reads SourceAlpha.
+  auto canConsume = [&](std::size_t value, std::size_t index) {
+    return compiled.canConsume(value, index) &&
+           (value != sourceGraphicValue ||
+            !(compiled.lastReader[standardValue(StandardInput::SourceAlpha)] >= index));
   };
 
-  auto resolveInputSubregion = [&](const NodeInput& input) -> Box {
-    return std::visit(
-        [&](const auto& v) -> Box {
-          using V = std::decay_t<decltype(v)>;
-          if constexpr (std::is_same_v<V, NodeInput::Previous>) {
-            return previousOutputSubregion;
-          } else if constexpr (std::is_same_v<V, NodeInput::Named>) {
-            auto it = namedSubregions.find(v.name);
-            if (it != namedSubregions.end()) {
-              return it->second;
-            }
-            return previousOutputSubregion;
-          } else if constexpr (std::is_same_v<V, StandardInput>) {
-            if (v == StandardInput::FillPaint) {
-              return fillPaintSubregion.value_or(fullRegion);
-            }
-            if (v == StandardInput::StrokePaint) {
-              return strokePaintSubregion.value_or(fullRegion);
-            }
-            return fullRegion;
-          } else {
-            return fullRegion;
-          }
-        },
-        input.value);
+  // The pixels of slot 0 of node `index` in `linear` space, as a buffer the node may overwrite:
+  // the input's own buffer when nothing reads it afterwards, otherwise a pooled copy.
+  auto takeInput = [&](std::size_t index, bool linear) -> FloatPixmap {
+    const std::size_t value = compiled.slotValues[index][0];
+    if (canConsume(value, index)) {
+      return valueAt(value)->release(linear);
+    }
+    return pool.copyOf(valueAt(value)->in(linear));
   };
 
-  auto defaultNodeSubregion = [&](const GraphNode& node) -> Box {
-    const bool isSourceGenerator =
-        std::holds_alternative<graph_primitive::Flood>(node.primitive) ||
-        std::holds_alternative<graph_primitive::Turbulence>(node.primitive) ||
-        std::holds_alternative<graph_primitive::Image>(node.primitive) ||
-        std::holds_alternative<graph_primitive::Tile>(node.primitive);
-
-    if (node.subregion.has_value()) {
-      return Box::fromPixelRect(*node.subregion).intersect(filterRegionBox);
-    }
-
-    // Walk every slot the primitive reads, so a defaulted `in2` contributes its subregion the
-    // same way an explicit one would. The test is the slot count and not the populated list: a
-    // two-input primitive with nothing filled in still reads two defaulted inputs, so its bounds
-    // come from those defaults rather than from the whole filter region.
-    const std::size_t slots = inputSlotCount(node);
-    if (slots == 0 || isSourceGenerator) {
-      return filterRegionBox;
-    }
-
-    Box inputBounds = resolveInputSubregion(inputOrDefault(node, 0));
-    for (std::size_t i = 1; i < slots; ++i) {
-      inputBounds = inputBounds.unite(resolveInputSubregion(inputOrDefault(node, i)));
-    }
-
-    return std::visit(
-               [&](const auto& primitive) -> Box {
-                 using T = std::decay_t<decltype(primitive)>;
-
-                 if constexpr (std::is_same_v<T, graph_primitive::GaussianBlur>) {
-                   const double expandX = std::ceil(primitive.sigmaX * 3.0);
-                   const double expandY = std::ceil(primitive.sigmaY * 3.0);
-                   return inputBounds.outset(expandX, expandY);
-                 } else if constexpr (std::is_same_v<T, graph_primitive::DropShadow>) {
-                   const double expandX = std::ceil(primitive.sigmaX * 3.0);
-                   const double expandY = std::ceil(primitive.sigmaY * 3.0);
-                   const Box shadowBounds = inputBounds
-                                                .translate(static_cast<double>(primitive.dx),
-                                                           static_cast<double>(primitive.dy))
-                                                .outset(expandX, expandY);
-                   return inputBounds.unite(shadowBounds);
-                 } else if constexpr (std::is_same_v<T, graph_primitive::Morphology>) {
-                   if (primitive.op == MorphologyOp::Dilate) {
-                     return inputBounds.outset(static_cast<double>(primitive.radiusX),
-                                               static_cast<double>(primitive.radiusY));
-                   }
-
-                   return inputBounds;
-                 } else {
-                   return inputBounds;
-                 }
-               },
-               node.primitive)
-        .intersect(filterRegionBox);
+  // The input of node `index`, unchanged and in its own space, for a primitive that passes it
+  // through.
+  auto passThrough = [&](std::size_t index) -> NodeOutput {
+    const std::size_t value = compiled.slotValues[index][0];
+    SpacedPixmap* input = valueAt(value);
+    if (canConsume(value, index)) {
+      return input->describe(input->releaseStored());
+    }
+    return input->describe(pool.copyOf(input->spaceAgnostic()));
   };
 
-  for (const GraphNode& node : graph.nodes) {
-    const bool nodeLinearRGB = node.useLinearRGB.value_or(graph.useLinearRGB);
+  // Clips the result of node `index` to its subregion and stores it, then releases every value
+  // whose last reader has now run.
+  auto publish = [&](std::size_t index, const PixelRect& clipRect, NodeOutput output) {
+    const GraphNode& node = graph.nodes[index];
+    const AffineTransform* xform =
+        (graph.filterFromDevice.has_value() && node.userSpaceSubregion.has_value())
+            ? &*graph.filterFromDevice
+            : nullptr;
+    const PixelRect* usrSub = xform ? &*node.userSpaceSubregion : nullptr;
+    // Clearing pixels is the same operation in either space, so it runs before the result is
+    // published and no conversion is involved.
+    applySubregionClipping(output.pixmap, clipRect, w, h, xform, usrSub);
+    values[nodeValue(index)].emplace(std::move(output));
+
+    const std::size_t sourceAlphaValue = standardValue(StandardInput::SourceAlpha);
+    for (const std::size_t value : compiled.releaseAfter[index]) {
+      // A node may read SourceAlpha's subregion before any node reads its pixels, so the source
+      // can be released first. SourceAlpha is built from it now if a later node still reads it.
+      if (value == sourceGraphicValue && compiled.lastReader[sourceAlphaValue] > index) {
+        valueAt(sourceAlphaValue);
+      }
+      if (values[value].has_value()) {
+        values[value]->recycle(pool);
+        values[value].reset();
+      }
+    }
+  };
+
+  // Stages of the fused pass being collected, and the buffer it writes.
+  std::vector<FusedStage> fusedStages;
+  FloatPixmap fusedOutput;
+  std::size_t fusedNodes = 0;
+
+  for (std::size_t index = 0; index < graph.nodes.size(); ++index) {
+    // Nothing reads a dead node's result, so it is skipped outright.
+    if (!compiled.live[index]) {
+      continue;
+    }
+
+    const GraphNode& node = graph.nodes[index];
+    const std::vector<std::size_t>& slots = compiled.slotValues[index];
+    const bool nodeLinearRGB = nodeUsesLinearRGB(graph, node);
+    const Box nodeSubregion =
+        defaultNodeSubregion(node, index, compiled, subregions, filterRegionBox);
+    subregions[nodeValue(index)] = nodeSubregion;
+    const PixelRect clipRect{nodeSubregion.x0, nodeSubregion.y0,
+                             nodeSubregion.x1 - nodeSubregion.x0,
+                             nodeSubregion.y1 - nodeSubregion.y0};
+
+    const std::size_t chainBegin = compiled.chainBegin[index];
+    const std::size_t chainEnd = compiled.chainEnd[index];
+    if (chainBegin != chainEnd) {
+      // A member of a fused pass contributes its stage, and the pass runs once the last member
+      // has been reached. The pass's running value stands in for every member's result but the
+      // last, and its first stage decides which buffer the pass writes.
+      FusedStage stage;
+      stage.primitive = &node.primitive;
+      if (index != chainEnd) {
+        stage.clip = keptRect(clipRect, w, h);
+      }
+
+      const bool first = index == chainBegin;
+      const auto operand = [&](std::size_t slot) -> const FloatPixmap* {
+        const bool readsChain = !first && slots[slot] == nodeValue(index - 1);
+        return readsChain ? nullptr : &valueAt(slots[slot])->in(nodeLinearRGB);
+      };
+      if (const auto* flood = std::get_if<graph_primitive::Flood>(&node.primitive)) {
+        stage.floodColor =
+            floodColorInSpace(flood->r, flood->g, flood->b, flood->a, nodeLinearRGB);
+        fusedOutput = pool.acquireUninitialized();
+      } else if (std::holds_alternative<graph_primitive::Composite>(node.primitive)) {
+        stage.in1 = operand(0);
+        stage.in2 = operand(1);
+        if (first) {
+          fusedOutput = pool.acquireUninitialized();
+        }
+      } else {
+        if (const auto* transfer =
+                std::get_if<graph_primitive::ComponentTransfer>(&node.primitive)) {
+          stage.transfer = {toTransferFunc(transfer->funcR), toTransferFunc(transfer->funcG),
+                            toTransferFunc(transfer->funcB), toTransferFunc(transfer->funcA)};
+        }
+        if (first && canConsume(slots[0], index)) {
+          fusedOutput = valueAt(slots[0])->release(nodeLinearRGB);
+        } else if (first) {
+          stage.in1 = operand(0);
+          fusedOutput = pool.acquireUninitialized();
+        }
+      }
+      fusedStages.push_back(std::move(stage));
+
+      if (index != chainEnd) {
+        continue;
+      }
+
+      runFusedPass(fusedStages, fusedOutput);
+      fusedNodes += fusedStages.size();
+      fusedStages.clear();
+      publish(index, clipRect, NodeOutput{std::move(fusedOutput), nodeLinearRGB});
+      continue;
+    }
 
     // Each buffer knows its own color space, so a node asks its inputs for the space it works in
     // and tags its result with that same space. `in()` is a no-op whenever the producer already
-    // agreed with this node, which is the common case.
-    SpacedPixmap* input = resolveInput(inputOrDefault(node, 0));
+    // agreed with this node, which is the common case. Generators read no input.
+    SpacedPixmap* input = slots.empty() ? nullptr : valueAt(slots[0]);
 
     std::optional<NodeOutput> output;
 
@@ -553,80 +1328,67 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
           using namespace graph_primitive;
 
           if constexpr (std::is_same_v<T, GaussianBlur>) {
-            const bool canConsumeSource = graph.nodes.size() == 1 && input == source;
-            auto fp = canConsumeSource ? input->release(nodeLinearRGB)
-                                       : FloatPixmap(input->in(nodeLinearRGB));
+            auto fp = takeInput(index, nodeLinearRGB);
             gaussianBlur(fp, primitive.sigmaX, primitive.sigmaY, primitive.edgeMode);
             output = NodeOutput{std::move(fp), nodeLinearRGB};
 
           } else if constexpr (std::is_same_v<T, Flood>) {
-            auto fp = createTransparentFloat(w, h);
+            auto fp = pool.acquire();
             floodInSpace(fp, primitive.r, primitive.g, primitive.b, primitive.a, nodeLinearRGB);
             output = NodeOutput{std::move(fp), nodeLinearRGB};
 
           } else if constexpr (std::is_same_v<T, graph_primitive::Offset>) {
             // Pure pixel mover: the result is the input's pixels in the input's space, so it
             // needs no conversion in either direction.
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             filter::offset(input->spaceAgnostic(), fpOut, primitive.dx, primitive.dy);
             output = input->describe(std::move(fpOut));
 
           } else if constexpr (std::is_same_v<T, graph_primitive::Composite>) {
-            SpacedPixmap* input2 = resolveInput(inputOrDefault(node, 1));
+            SpacedPixmap* input2 = valueAt(slots[1]);
             const FloatPixmap& in1 = input->in(nodeLinearRGB);
             const FloatPixmap& in2 = input2->in(nodeLinearRGB);
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             composite(in1, in2, fpOut, primitive.op, primitive.k1, primitive.k2, primitive.k3,
                       primitive.k4);
             output = NodeOutput{std::move(fpOut), nodeLinearRGB};
 
           } else if constexpr (std::is_same_v<T, graph_primitive::Blend>) {
-            SpacedPixmap* input2 = resolveInput(inputOrDefault(node, 1));
+            SpacedPixmap* input2 = valueAt(slots[1]);
             const FloatPixmap& in1 = input->in(nodeLinearRGB);
             const FloatPixmap& in2 = input2->in(nodeLinearRGB);
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             blend(in2, in1, fpOut, primitive.mode);
             output = NodeOutput{std::move(fpOut), nodeLinearRGB};
 
           } else if constexpr (std::is_same_v<T, graph_primitive::Merge>) {
             std::vector<const FloatPixmap*> layers;
-            layers.reserve(node.inputs.size());
-            for (const auto& mergeInput : node.inputs) {
-              layers.push_back(&resolveInput(mergeInput)->in(nodeLinearRGB));
+            layers.reserve(slots.size());
+            for (const std::size_t mergeInput : slots) {
+              layers.push_back(&valueAt(mergeInput)->in(nodeLinearRGB));
             }
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             merge(std::span<const FloatPixmap* const>(layers), fpOut);
             output = NodeOutput{std::move(fpOut), nodeLinearRGB};
 
           } else if constexpr (std::is_same_v<T, graph_primitive::ColorMatrix>) {
             if (primitive.matrix == identityMatrix()) {
               // Identity matrix: pass through, which is independent of the color space.
-              output = input->describe(FloatPixmap(input->spaceAgnostic()));
+              output = passThrough(index);
             } else {
-              auto fp = FloatPixmap(input->in(nodeLinearRGB));
+              auto fp = takeInput(index, nodeLinearRGB);
               colorMatrix(fp, primitive.matrix);
               output = NodeOutput{std::move(fp), nodeLinearRGB};
             }
 
           } else if constexpr (std::is_same_v<T, graph_primitive::ComponentTransfer>) {
-            auto toFunc = [](const graph_primitive::ComponentTransfer::Func& f) {
-              TransferFunc tf;
-              tf.type = f.type;
-              tf.tableValues = f.tableValues;
-              tf.slope = f.slope;
-              tf.intercept = f.intercept;
-              tf.amplitude = f.amplitude;
-              tf.exponent = f.exponent;
-              tf.offset = f.offset;
-              return tf;
-            };
-            auto fp = FloatPixmap(input->in(nodeLinearRGB));
-            componentTransfer(fp, toFunc(primitive.funcR), toFunc(primitive.funcG),
-                              toFunc(primitive.funcB), toFunc(primitive.funcA));
+            auto fp = takeInput(index, nodeLinearRGB);
+            componentTransfer(fp, toTransferFunc(primitive.funcR), toTransferFunc(primitive.funcG),
+                              toTransferFunc(primitive.funcB), toTransferFunc(primitive.funcA));
             output = NodeOutput{std::move(fp), nodeLinearRGB};
 
           } else if constexpr (std::is_same_v<T, graph_primitive::ConvolveMatrix>) {
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             const bool usable =
                 primitive.orderX > 0 && primitive.orderY > 0 &&
                 static_cast<int>(primitive.kernel.size()) == primitive.orderX * primitive.orderY &&
@@ -660,9 +1422,9 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
                                   (primitive.radiusX == 0 && primitive.radiusY == 0);
             if (disabled) {
               // Pass-through, which is independent of the color space.
-              output = input->describe(FloatPixmap(input->spaceAgnostic()));
+              output = passThrough(index);
             } else {
-              auto fpOut = createTransparentFloat(w, h);
+              auto fpOut = pool.acquire();
               morphology(input->in(nodeLinearRGB), fpOut, primitive.op, primitive.radiusX,
                          primitive.radiusY);
               output = NodeOutput{std::move(fpOut), nodeLinearRGB};
@@ -670,8 +1432,8 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
 
           } else if constexpr (std::is_same_v<T, graph_primitive::Tile>) {
             // Pure pixel mover, so the result stays in the input's space with no conversion.
-            auto fpOut = createTransparentFloat(w, h);
-            const Box inputSubregion = resolveInputSubregion(inputOrDefault(node, 0));
+            auto fpOut = pool.acquire();
+            const Box inputSubregion = subregions[slots[0]];
             const int tileX = std::max(0, static_cast<int>(std::floor(inputSubregion.x0)));
             const int tileY = std::max(0, static_cast<int>(std::floor(inputSubregion.y0)));
             const int tileR = std::min(w, static_cast<int>(std::ceil(inputSubregion.x1)));
@@ -685,21 +1447,21 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
 
           } else if constexpr (std::is_same_v<T, graph_primitive::Turbulence>) {
             // Turbulence generates noise directly in the node's interpolation space.
-            auto fp = createTransparentFloat(w, h);
+            auto fp = pool.acquire();
             turbulence(fp, primitive.params);
             output = NodeOutput{std::move(fp), nodeLinearRGB};
 
           } else if constexpr (std::is_same_v<T, graph_primitive::DisplacementMap>) {
-            SpacedPixmap* input2 = resolveInput(inputOrDefault(node, 1));
+            SpacedPixmap* input2 = valueAt(slots[1]);
             const FloatPixmap& in1 = input->in(nodeLinearRGB);
             const FloatPixmap& in2 = input2->in(nodeLinearRGB);
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             displacementMap(in1, in2, fpOut, primitive.scale, primitive.xChannel,
                             primitive.yChannel);
             output = NodeOutput{std::move(fpOut), nodeLinearRGB};
 
           } else if constexpr (std::is_same_v<T, graph_primitive::DiffuseLighting>) {
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             auto params = primitive.params;
             if (nodeLinearRGB) {
               // The light color is authored in sRGB, so it follows the pixels into linearRGB.
@@ -713,7 +1475,7 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
           } else if constexpr (std::is_same_v<T, graph_primitive::SpecularLighting>) {
             // Per SVG spec, specularExponent must be in [1, 128].
             // Values < 1: produce transparent output. Values > 128: clamp to 128.
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             const bool lit = primitive.params.specularExponent >= 1.0;
             if (lit) {
               auto params = primitive.params;
@@ -734,7 +1496,7 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
             // node's own interpolation space. Only the flood color needs converting, because it
             // is authored as premultiplied sRGB; the alpha the shadow is cut from carries no
             // color.
-            auto floodBuf = createTransparentFloat(w, h);
+            auto floodBuf = pool.acquire();
             floodInSpace(floodBuf, primitive.r, primitive.g, primitive.b, primitive.a,
                          nodeLinearRGB);
 
@@ -747,18 +1509,21 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
             // neither transfer function touches alpha, so the stored pixels serve whichever
             // space they are tagged with and no conversion pass belongs here. The merge below
             // still asks the input for this node's space, because that layer does carry color.
-            auto compositeBuf = createTransparentFloat(w, h);
+            auto compositeBuf = pool.acquire();
             composite(floodBuf, input->spaceAgnostic(), compositeBuf, CompositeOp::In);
 
-            auto offsetBuf = createTransparentFloat(w, h);
+            auto offsetBuf = pool.acquire();
             filter::offset(compositeBuf, offsetBuf, primitive.dx, primitive.dy);
 
             gaussianBlur(offsetBuf, primitive.sigmaX, primitive.sigmaY);
 
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             const std::vector<const FloatPixmap*> layers = {&offsetBuf, &input->in(nodeLinearRGB)};
             merge(std::span<const FloatPixmap* const>(layers), fpOut);
             output = NodeOutput{std::move(fpOut), nodeLinearRGB};
+            pool.recycle(std::move(floodBuf));
+            pool.recycle(std::move(compositeBuf));
+            pool.recycle(std::move(offsetBuf));
 
           } else if constexpr (std::is_same_v<T, graph_primitive::Image>) {
             // Image data is sRGB uint8, and the resampling below runs on those sRGB values, so
@@ -775,7 +1540,7 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
             // hard color edges), which is exactly what the resvg goldens encode. Matching the
             // kernel removes the upscale-ramp pixel diffs the goldens flag (verified to be a
             // bit-for-bit match against resvg's feImage subregion goldens).
-            auto fpOut = createTransparentFloat(w, h);
+            auto fpOut = pool.acquire();
             if (!primitive.pixels.empty() && primitive.width > 0 && primitive.height > 0) {
               const double tx = primitive.targetRect.has_value() ? primitive.targetRect->x : 0.0;
               const double ty = primitive.targetRect.has_value() ? primitive.targetRect->y : 0.0;
@@ -940,43 +1705,30 @@ bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph) {
         node.primitive);
 
     if (output.has_value()) {
-      const Box nodeSubregion = defaultNodeSubregion(node);
-
-      // Clip output pixels to the computed subregion.
-      const PixelRect clipRect{nodeSubregion.x0, nodeSubregion.y0,
-                               nodeSubregion.x1 - nodeSubregion.x0,
-                               nodeSubregion.y1 - nodeSubregion.y0};
-      const AffineTransform* xform =
-          (graph.filterFromDevice.has_value() && node.userSpaceSubregion.has_value())
-              ? &*graph.filterFromDevice
-              : nullptr;
-      const PixelRect* usrSub = xform ? &*node.userSpaceSubregion : nullptr;
-      // Clearing pixels is the same operation in either space, so it runs before the result is
-      // published and no conversion is involved.
-      applySubregionClipping(output->pixmap, clipRect, w, h, xform, usrSub);
-
-      auto produced = std::make_shared<SpacedPixmap>(std::move(*output));
-      if (node.result.has_value()) {
-        namedBuffers[*node.result] = produced;
-        namedSubregions[*node.result] = nodeSubregion;
-      }
-      previousOutput = std::move(produced);
-      previousOutputSubregion = nodeSubregion;
+      publish(index, clipRect, std::move(*output));
     }
   }
 
+  if (stats != nullptr) {
+    stats->liveNodes =
+        static_cast<std::size_t>(std::count(compiled.live.begin(), compiled.live.end(), true));
+    stats->fusedNodes = fusedNodes;
+    stats->allocatedBuffers = pool.allocated();
+    stats->precision = FilterPrecision::Float;
+  }
+
   // The graph's result leaves in sRGB: this is the single exit conversion, and it is skipped
-  // entirely when the last node already worked in sRGB.
-  if (previousOutput) {
-    // Nothing reads the graph's buffers after this point, so the last result can be converted in
-    // place and handed over even though other names may still refer to it.
-    Pixmap result = previousOutput->release(/*linear=*/false).toPixmap();
-    auto srcData = result.data();
-    auto dstData = sourceGraphic.data();
-    std::copy(srcData.begin(), srcData.end(), dstData.begin());
-    return true;
-  }
-  return false;
+  // entirely when the last node already worked in sRGB. The last node always runs, so there is
+  // always a result.
+  //
+  // Nothing reads the graph's buffers after this point, so the last result can be converted in
+  // place and handed over.
+  Pixmap result =
+      values[nodeValue(graph.nodes.size() - 1)]->release(/*linear=*/false).toPixmap();
+  auto srcData = result.data();
+  auto dstData = sourceGraphic.data();
+  std::copy(srcData.begin(), srcData.end(), dstData.begin());
+  return true;
 }
 
 }  // namespace tiny_skia::filter
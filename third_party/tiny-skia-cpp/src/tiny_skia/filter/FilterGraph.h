@@ -9,6 +9,7 @@
 /// parameters before building the graph.
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -256,6 +257,20 @@ struct GraphNode {
 };
 
 /// Complete filter graph specification ready for execution.
+/// Storage the executor keeps intermediate results in.
+enum class FilterPrecision : std::uint8_t {
+  /// Four floats per pixel. Results match the reference filter math.
+  Float,
+  /// Premultiplied RGBA8, the same format as the source graphic: a quarter of the memory traffic
+  /// of Float, at the cost of rounding every intermediate result to 8 bits. Linear RGB values
+  /// lose the most, since 8 bits are spread evenly over a curve that favors dark values.
+  ///
+  /// Covers feGaussianBlur, feOffset, feFlood, feComposite, feMerge, feColorMatrix and
+  /// feMorphology. A graph that uses any other primitive, a paint input, rotation-aware clipping,
+  /// or more than one interpolation space runs at Float instead.
+  Uint8,
+};
+
 struct FilterGraph {
   std::vector<GraphNode> nodes;           ///< Nodes in execution order.
   bool useLinearRGB = true;               ///< Convert to linearRGB for processing.
@@ -272,6 +287,28 @@ struct FilterGraph {
 
   /// Inverse transform (pixel -> filter/user space) for rotation-aware subregion clipping.
   std::optional<AffineTransform> filterFromDevice;
+
+  /// Requested storage for intermediate results. Float unless the caller opts into less.
+  FilterPrecision precision = FilterPrecision::Float;
+};
+
+/// What the executor did with a graph, for tests and benchmarks.
+struct FilterGraphStats {
+  /// Nodes whose result reaches the graph's output. The others are skipped without running.
+  std::size_t liveNodes = 0;
+
+  /// Nodes evaluated inside a fused per-pixel pass shared with a neighboring node, instead of in
+  /// a pass over a full buffer of their own.
+  std::size_t fusedNodes = 0;
+
+  /// Buffers allocated for results and temporaries, in the storage \ref precision names. A buffer
+  /// is reused once its last reader has run, so this is at most the number of such buffers held
+  /// at once.
+  std::size_t allocatedBuffers = 0;
+
+  /// Storage the graph actually ran at, which is Float when the requested precision did not
+  /// cover the graph.
+  FilterPrecision precision = FilterPrecision::Float;
 };
 
 /// Execute a filter graph on a source pixmap.
@@ -279,9 +316,19 @@ struct FilterGraph {
 /// The source pixmap is modified in place with the filter result. All spatial parameters
 /// in the graph (sigma, offset, radius, subregion) must already be in pixel space.
 ///
+/// The graph is compiled before it runs: nodes whose result never reaches the output are skipped,
+/// chains of per-pixel primitives (feColorMatrix, feComponentTransfer, feComposite, and a leading
+/// feFlood) run as one pass, and each intermediate buffer returns to a pool after its last reader
+/// so later nodes reuse it. None of this changes the result.
+///
+/// \ref FilterGraph::precision selects the storage for intermediate results; reduced precision
+/// changes the result within the rounding it introduces.
+///
 /// @param sourceGraphic The rendered element content. Modified in-place on success.
 /// @param graph The filter graph to execute.
+/// @param stats If not null, receives what the executor did with the graph.
 /// @return true if a filter result was produced, false if the graph produced no output.
-bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph);
+bool executeFilterGraph(Pixmap& sourceGraphic, const FilterGraph& graph,
+                        FilterGraphStats* stats = nullptr);
 
 }  // namespace tiny_skia::filter
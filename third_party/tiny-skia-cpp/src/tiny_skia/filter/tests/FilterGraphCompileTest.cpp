@@ -0,0 +1,285 @@
+/// Tests for the execution plan `executeFilterGraph` compiles a filter graph into.
+///
+/// Compilation changes how a graph runs but never what it produces. These tests pin both halves:
+///   - a node whose result never reaches the output does not run;
+///   - adjacent per-pixel primitives run as one strip-mined pass, bit-identical to running the
+///     primitives one after another, including a subregion cleared between two of them;
+///   - buffers return to a pool after their last reader, so a chain does not allocate one buffer
+///     per node.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tiny_skia/Pixmap.h"
+#include "tiny_skia/filter/ColorMatrix.h"
+#include "tiny_skia/filter/ColorSpace.h"
+#include "tiny_skia/filter/ComponentTransfer.h"
+#include "tiny_skia/filter/Composite.h"
+#include "tiny_skia/filter/FilterGraph.h"
+#include "tiny_skia/filter/FloatPixmap.h"
+#include "tiny_skia/filter/Flood.h"
+#include "tiny_skia/filter/GaussianBlur.h"
+
+namespace tiny_skia::filter {
+namespace {
+
+/// Wider than one fused strip, so a pass covers a row in more than one strip.
+constexpr int kWidth = 300;
+constexpr int kHeight = 8;
+constexpr double kSigma = 1.5;
+
+/// A saturating color matrix, far from the identity the executor short-circuits.
+std::array<double, 20> saturateMatrix() {
+  return {0.8, 0.3, -0.1, 0.0, 0.0,  //
+          0.1, 0.9, 0.0,  0.0, 0.0,  //
+          0.0, 0.2, 0.7,  0.0, 0.0,  //
+          0.0, 0.0, 0.0,  1.0, 0.0};
+}
+
+/// Gamma on the color channels and a linear ramp on alpha, so every channel changes.
+graph_primitive::ComponentTransfer gammaTransfer() {
+  graph_primitive::ComponentTransfer transfer;
+  for (auto* func : {&transfer.funcR, &transfer.funcG, &transfer.funcB}) {
+    func->type = TransferFuncType::Gamma;
+    func->amplitude = 1.1;
+    func->exponent = 0.6;
+    func->offset = 0.02;
+  }
+  transfer.funcA.type = TransferFuncType::Linear;
+  transfer.funcA.slope = 0.9;
+  transfer.funcA.intercept = 0.05;
+  return transfer;
+}
+
+/// The transfer functions of \ref gammaTransfer as the primitive functions take them.
+std::array<TransferFunc, 4> gammaTransferFuncs(const graph_primitive::ComponentTransfer& owner) {
+  std::array<TransferFunc, 4> funcs;
+  const graph_primitive::ComponentTransfer::Func* sources[] = {&owner.funcR, &owner.funcG,
+                                                                &owner.funcB, &owner.funcA};
+  for (std::size_t i = 0; i < funcs.size(); ++i) {
+    funcs[i].type = sources[i]->type;
+    funcs[i].tableValues = sources[i]->tableValues;
+    funcs[i].slope = sources[i]->slope;
+    funcs[i].intercept = sources[i]->intercept;
+    funcs[i].amplitude = sources[i]->amplitude;
+    funcs[i].exponent = sources[i]->exponent;
+    funcs[i].offset = sources[i]->offset;
+  }
+  return funcs;
+}
+
+/// A source graphic with varied colors and partial alpha.
+Pixmap makeSourceGraphic() {
+  auto maybePixmap = Pixmap::fromSize(kWidth, kHeight);
+  EXPECT_TRUE(maybePixmap.has_value());
+  Pixmap pixmap = std::move(*maybePixmap);
+
+  auto data = pixmap.data();
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const auto alpha = static_cast<std::uint8_t>(40 + (x * 9 + y * 3) % 216);
+      const auto scale = [&](int value) { return static_cast<std::uint8_t>(value * alpha / 255); };
+
+      const std::size_t offset = static_cast<std::size_t>((y * kWidth + x) * 4);
+      data[offset + 0] = scale((x * 11) % 256);
+      data[offset + 1] = scale((y * 7 + 3) % 256);
+      data[offset + 2] = scale((x * 5 + y * 13) % 256);
+      data[offset + 3] = alpha;
+    }
+  }
+
+  return pixmap;
+}
+
+GraphNode node(GraphPrimitive primitive, std::vector<NodeInput> inputs) {
+  GraphNode result;
+  result.primitive = std::move(primitive);
+  result.inputs = std::move(inputs);
+  return result;
+}
+
+bool samePixels(const Pixmap& actual, const Pixmap& expected) {
+  return std::ranges::equal(actual.data(), expected.data());
+}
+
+/// Clears every pixel of \p pixmap outside the integer rectangle, as a subregion does.
+void clearOutside(FloatPixmap& pixmap, int x0, int y0, int x1, int y1) {
+  auto data = pixmap.data();
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      if (x < x0 || x >= x1 || y < y0 || y >= y1) {
+        const std::size_t offset = static_cast<std::size_t>((y * kWidth + x) * 4);
+        for (int c = 0; c < 4; ++c) {
+          data[offset + c] = 0.0f;
+        }
+      }
+    }
+  }
+}
+
+// A result nothing reads is skipped, and skipping it leaves the output unchanged.
+TEST(FilterGraphCompile, UnusedResultDoesNotRun) {
+  const Pixmap source = makeSourceGraphic();
+
+  FilterGraph graph;
+  graph.useLinearRGB = true;
+  graph.nodes = {
+      node(graph_primitive::GaussianBlur{kSigma, kSigma, BlurEdgeMode::None}, {NodeInput()}),
+      node(graph_primitive::ColorMatrix{saturateMatrix()},
+           {NodeInput(StandardInput::SourceGraphic)}),
+  };
+  graph.nodes[0].result = "unused";
+
+  Pixmap actual = source;
+  FilterGraphStats stats;
+  ASSERT_TRUE(executeFilterGraph(actual, graph, &stats));
+  EXPECT_EQ(stats.liveNodes, 1u);
+
+  FilterGraph live;
+  live.useLinearRGB = true;
+  live.nodes = {graph.nodes[1]};
+  Pixmap expected = source;
+  ASSERT_TRUE(executeFilterGraph(expected, live));
+  EXPECT_TRUE(samePixels(actual, expected));
+}
+
+// Color matrix, transfer, and composite with the source run as one pass, and the pass matches
+// the primitives run over whole buffers, including the transfer's subregion cleared between the
+// stages.
+TEST(FilterGraphCompile, PointwiseChainFusesBitIdentically) {
+  const Pixmap source = makeSourceGraphic();
+  const graph_primitive::ComponentTransfer transfer = gammaTransfer();
+
+  FilterGraph graph;
+  graph.useLinearRGB = true;
+  graph.nodes = {
+      node(graph_primitive::ColorMatrix{saturateMatrix()}, {NodeInput()}),
+      node(transfer, {NodeInput()}),
+      node(graph_primitive::Composite{CompositeOp::Over},
+           {NodeInput(), NodeInput(StandardInput::SourceGraphic)}),
+  };
+  graph.nodes[1].subregion = PixelRect{10, 2, 250, 4};
+
+  Pixmap actual = source;
+  FilterGraphStats stats;
+  ASSERT_TRUE(executeFilterGraph(actual, graph, &stats));
+  EXPECT_EQ(stats.liveNodes, 3u);
+  EXPECT_EQ(stats.fusedNodes, 3u);
+
+  FloatPixmap sourceLinear = FloatPixmap::fromPixmap(source);
+  srgbToLinear(sourceLinear);
+  FloatPixmap fp = sourceLinear;
+  colorMatrix(fp, saturateMatrix());
+  const std::array<TransferFunc, 4> funcs = gammaTransferFuncs(transfer);
+  componentTransfer(fp, funcs[0], funcs[1], funcs[2], funcs[3]);
+  clearOutside(fp, 10, 2, 260, 6);
+  FloatPixmap composited = *FloatPixmap::fromSize(kWidth, kHeight);
+  composite(fp, sourceLinear, composited, CompositeOp::Over);
+  linearToSrgb(composited);
+
+  EXPECT_TRUE(samePixels(actual, composited.toPixmap()));
+}
+
+// A flood starts a pass, and the composite reading it with SourceAlpha joins that pass.
+TEST(FilterGraphCompile, FloodFusesIntoComposite) {
+  const Pixmap source = makeSourceGraphic();
+
+  FilterGraph graph;
+  graph.useLinearRGB = false;
+  graph.nodes = {
+      node(graph_primitive::Flood{40, 20, 10, 128}, {}),
+      node(graph_primitive::Composite{CompositeOp::In},
+           {NodeInput(), NodeInput(StandardInput::SourceAlpha)}),
+  };
+
+  Pixmap actual = source;
+  FilterGraphStats stats;
+  ASSERT_TRUE(executeFilterGraph(actual, graph, &stats));
+  EXPECT_EQ(stats.fusedNodes, 2u);
+
+  FloatPixmap sourceAlpha = FloatPixmap::fromPixmap(source);
+  auto data = sourceAlpha.data();
+  for (std::size_t i = 0; i < data.size(); i += 4) {
+    data[i + 0] = data[i + 1] = data[i + 2] = 0.0f;
+  }
+  FloatPixmap flooded = *FloatPixmap::fromSize(kWidth, kHeight);
+  flood(flooded, 40 / 255.0f, 20 / 255.0f, 10 / 255.0f, 128 / 255.0f);
+  FloatPixmap composited = *FloatPixmap::fromSize(kWidth, kHeight);
+  composite(flooded, sourceAlpha, composited, CompositeOp::In);
+
+  EXPECT_TRUE(samePixels(actual, composited.toPixmap()));
+}
+
+// A chain of blurs consumes each result in place, so it needs a fixed number of buffers no
+// matter how long it is.
+TEST(FilterGraphCompile, ChainReusesBuffers) {
+  const Pixmap source = makeSourceGraphic();
+
+  FilterGraph graph;
+  for (int i = 0; i < 6; ++i) {
+    graph.nodes.push_back(
+        node(graph_primitive::GaussianBlur{kSigma, kSigma, BlurEdgeMode::None}, {NodeInput()}));
+  }
+
+  Pixmap actual = source;
+  FilterGraphStats stats;
+  ASSERT_TRUE(executeFilterGraph(actual, graph, &stats));
+  EXPECT_EQ(stats.liveNodes, 6u);
+  EXPECT_EQ(stats.fusedNodes, 0u);
+  EXPECT_LE(stats.allocatedBuffers, 1u);
+
+  FloatPixmap fp = FloatPixmap::fromPixmap(source);
+  srgbToLinear(fp);
+  for (int i = 0; i < 6; ++i) {
+    gaussianBlur(fp, kSigma, kSigma, BlurEdgeMode::None);
+  }
+  linearToSrgb(fp);
+  EXPECT_TRUE(samePixels(actual, fp.toPixmap()));
+}
+
+// A result read by two later nodes stays alive until the second one, and the source stays intact
+// for a SourceAlpha built after the source's last direct reader.
+TEST(FilterGraphCompile, SharedResultsSurviveUntilTheirLastReader) {
+  const Pixmap source = makeSourceGraphic();
+
+  FilterGraph graph;
+  graph.useLinearRGB = false;
+  graph.nodes = {
+      node(graph_primitive::GaussianBlur{kSigma, kSigma, BlurEdgeMode::None}, {NodeInput()}),
+      node(graph_primitive::ColorMatrix{saturateMatrix()}, {NodeInput()}),
+      node(graph_primitive::Composite{CompositeOp::In},
+           {NodeInput(NodeInput::Named{"blur"}), NodeInput(StandardInput::SourceAlpha)}),
+      node(graph_primitive::Composite{CompositeOp::Over},
+           {NodeInput(), NodeInput(NodeInput::Named{"matrix"})}),
+  };
+  graph.nodes[0].result = "blur";
+  graph.nodes[1].result = "matrix";
+
+  Pixmap actual = source;
+  ASSERT_TRUE(executeFilterGraph(actual, graph));
+
+  const FloatPixmap sourceFloat = FloatPixmap::fromPixmap(source);
+  FloatPixmap blurred = sourceFloat;
+  gaussianBlur(blurred, kSigma, kSigma, BlurEdgeMode::None);
+  FloatPixmap matrix = blurred;
+  colorMatrix(matrix, saturateMatrix());
+  FloatPixmap sourceAlpha = sourceFloat;
+  auto data = sourceAlpha.data();
+  for (std::size_t i = 0; i < data.size(); i += 4) {
+    data[i + 0] = data[i + 1] = data[i + 2] = 0.0f;
+  }
+  FloatPixmap masked = *FloatPixmap::fromSize(kWidth, kHeight);
+  composite(blurred, sourceAlpha, masked, CompositeOp::In);
+  FloatPixmap result = *FloatPixmap::fromSize(kWidth, kHeight);
+  composite(masked, matrix, result, CompositeOp::Over);
+
+  EXPECT_TRUE(samePixels(actual, result.toPixmap()));
+}
+
+}  // namespace
+}  // namespace tiny_skia::filter
@@ -0,0 +1,200 @@
+/// Tests for `FilterPrecision`, the storage `executeFilterGraph` keeps intermediate results in.
+///
+/// Reduced precision trades exactness for memory traffic, so the tests pin the trade itself:
+///   - Float stays the default, and a graph that only asks for Float never changes;
+///   - a Uint8 graph stays within a stated error of the same graph at Float, per primitive and
+///     per interpolation space;
+///   - a graph the Uint8 executor does not cover runs at Float, byte-identical to asking for it.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tiny_skia/Pixmap.h"
+#include "tiny_skia/filter/FilterGraph.h"
+
+namespace tiny_skia::filter {
+namespace {
+
+constexpr int kWidth = 67;
+constexpr int kHeight = 41;
+
+/// Premultiplied content with hard edges, smooth ramps and partial alpha, so rounding shows up
+/// wherever a primitive has somewhere to lose it.
+Pixmap makeSource() {
+  Pixmap pixmap = *Pixmap::fromSize(kWidth, kHeight);
+  auto data = pixmap.data();
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const bool inside = x >= 12 && x < 50 && y >= 8 && y < 32;
+      const int alpha = inside ? 255 : (x * 3 + y * 2) % 160;
+      const auto off = static_cast<std::size_t>((y * kWidth + x) * 4);
+      data[off + 0] = static_cast<std::uint8_t>(alpha * ((x * 4) % 256) / 255);
+      data[off + 1] = static_cast<std::uint8_t>(alpha * ((y * 6) % 256) / 255);
+      data[off + 2] = static_cast<std::uint8_t>(alpha * 96 / 255);
+      data[off + 3] = static_cast<std::uint8_t>(alpha);
+    }
+  }
+  return pixmap;
+}
+
+GraphNode node(GraphPrimitive primitive, std::vector<NodeInput> inputs = {}) {
+  GraphNode result;
+  result.primitive = std::move(primitive);
+  result.inputs = std::move(inputs);
+  return result;
+}
+
+/// A drop shadow: blurred, offset SourceAlpha, tinted with a flood, merged under the source.
+FilterGraph dropShadowGraph() {
+  FilterGraph graph;
+  graph.nodes.push_back(node(graph_primitive::GaussianBlur{2.5, 2.5},
+                             {NodeInput(StandardInput::SourceAlpha)}));
+  graph.nodes.push_back(node(graph_primitive::Offset{3, 2}));
+  graph.nodes.back().result = "offset";
+  graph.nodes.push_back(node(graph_primitive::Flood{40, 20, 60, 160}));
+  graph.nodes.push_back(node(graph_primitive::Composite{CompositeOp::In},
+                             {NodeInput(), NodeInput(NodeInput::Named{"offset"})}));
+  graph.nodes.back().result = "shadow";
+  graph.nodes.push_back(node(graph_primitive::Merge{}, {NodeInput(NodeInput::Named{"shadow"}),
+                                                         NodeInput(StandardInput::SourceGraphic)}));
+  return graph;
+}
+
+/// One graph per primitive the Uint8 executor covers.
+std::vector<std::pair<std::string, FilterGraph>> primitiveGraphs() {
+  std::vector<std::pair<std::string, FilterGraph>> graphs;
+  const auto single = [&](std::string name, GraphPrimitive primitive) {
+    FilterGraph graph;
+    graph.nodes.push_back(node(std::move(primitive)));
+    graphs.emplace_back(std::move(name), std::move(graph));
+  };
+
+  single("blur", graph_primitive::GaussianBlur{1.5, 3.0});
+  single("offset", graph_primitive::Offset{-4, 5});
+  single("flood", graph_primitive::Flood{120, 60, 30, 200});
+  single("colorMatrix", graph_primitive::ColorMatrix{{0.8, 0.3, -0.1, 0.0, 0.05,  //
+                                                      0.1, 0.9, 0.0, 0.0, 0.0,    //
+                                                      0.0, 0.2, 0.7, 0.0, 0.1,    //
+                                                      0.0, 0.0, 0.0, 0.9, 0.0}});
+  single("dilate", graph_primitive::Morphology{MorphologyOp::Dilate, 2, 1});
+  single("erode", graph_primitive::Morphology{MorphologyOp::Erode, 1, 2});
+
+  FilterGraph composite;
+  composite.nodes.push_back(node(graph_primitive::Offset{6, 3}));
+  composite.nodes.push_back(node(graph_primitive::Composite{CompositeOp::Xor},
+                                 {NodeInput(StandardInput::SourceGraphic), NodeInput()}));
+  graphs.emplace_back("composite", std::move(composite));
+
+  graphs.emplace_back("dropShadow", dropShadowGraph());
+  return graphs;
+}
+
+struct Execution {
+  Pixmap pixmap;
+  FilterGraphStats stats;
+};
+
+Execution run(FilterGraph graph, FilterPrecision precision) {
+  graph.precision = precision;
+  Execution result{makeSource(), {}};
+  EXPECT_TRUE(executeFilterGraph(result.pixmap, graph, &result.stats));
+  return result;
+}
+
+int maxChannelError(const Pixmap& lhs, const Pixmap& rhs) {
+  int error = 0;
+  for (std::size_t i = 0; i < lhs.data().size(); ++i) {
+    error = std::max(error, std::abs(static_cast<int>(lhs.data()[i]) - rhs.data()[i]));
+  }
+  return error;
+}
+
+TEST(FilterGraphPrecisionTest, FloatIsTheDefault) {
+  FilterGraph graph = dropShadowGraph();
+  EXPECT_EQ(graph.precision, FilterPrecision::Float);
+
+  Pixmap pixmap = makeSource();
+  FilterGraphStats stats;
+  stats.precision = FilterPrecision::Uint8;
+  ASSERT_TRUE(executeFilterGraph(pixmap, graph, &stats));
+  EXPECT_EQ(stats.precision, FilterPrecision::Float);
+}
+
+/// In sRGB the only loss is rounding each intermediate to 8 bits, so every covered primitive
+/// stays within a few levels of the float result.
+TEST(FilterGraphPrecisionTest, Uint8StaysCloseToFloatInSrgb) {
+  for (auto& [name, graph] : primitiveGraphs()) {
+    SCOPED_TRACE(name);
+    graph.useLinearRGB = false;
+    const Execution reference = run(graph, FilterPrecision::Float);
+    const Execution reduced = run(graph, FilterPrecision::Uint8);
+    EXPECT_EQ(reduced.stats.precision, FilterPrecision::Uint8);
+    EXPECT_LE(maxChannelError(reference.pixmap, reduced.pixmap), 2);
+  }
+}
+
+/// linearRGB spends its 8 bits evenly over a curve that needs them at the dark end, so dark
+/// colors round coarsely on the way in and back out. The bound is the documented cost of the
+/// mode, not a defect; alpha is unaffected.
+TEST(FilterGraphPrecisionTest, Uint8StaysCloseToFloatInLinearRgb) {
+  for (auto& [name, graph] : primitiveGraphs()) {
+    SCOPED_TRACE(name);
+    graph.useLinearRGB = true;
+    const Execution reference = run(graph, FilterPrecision::Float);
+    const Execution reduced = run(graph, FilterPrecision::Uint8);
+    EXPECT_EQ(reduced.stats.precision, FilterPrecision::Uint8);
+    EXPECT_LE(maxChannelError(reference.pixmap, reduced.pixmap), 10);
+  }
+}
+
+TEST(FilterGraphPrecisionTest, Uint8SkipsDeadNodesAndPoolsBuffers) {
+  FilterGraph graph = dropShadowGraph();
+  // Nothing reads this node, so neither executor runs it.
+  graph.nodes.insert(graph.nodes.begin(),
+                     node(graph_primitive::Morphology{MorphologyOp::Dilate, 4, 4}));
+  const Execution reference = run(graph, FilterPrecision::Float);
+  const Execution reduced = run(graph, FilterPrecision::Uint8);
+  EXPECT_EQ(reduced.stats.liveNodes, reference.stats.liveNodes);
+  EXPECT_EQ(reduced.stats.liveNodes, graph.nodes.size() - 1);
+  EXPECT_LT(reduced.stats.allocatedBuffers, graph.nodes.size());
+}
+
+/// A graph the Uint8 executor does not cover runs exactly as if it had asked for Float.
+TEST(FilterGraphPrecisionTest, UncoveredGraphsRunAtFloat) {
+  std::vector<std::pair<std::string, FilterGraph>> graphs;
+
+  FilterGraph transfer;
+  transfer.nodes.push_back(node(graph_primitive::ComponentTransfer{}));
+  graphs.emplace_back("uncovered primitive", std::move(transfer));
+
+  FilterGraph mixedSpaces = dropShadowGraph();
+  mixedSpaces.nodes.back().useLinearRGB = false;
+  graphs.emplace_back("mixed color spaces", std::move(mixedSpaces));
+
+  FilterGraph paint;
+  paint.fillPaintInput = *Pixmap::fromSize(kWidth, kHeight);
+  paint.nodes.push_back(node(graph_primitive::Merge{}, {NodeInput(StandardInput::FillPaint),
+                                                         NodeInput(StandardInput::SourceGraphic)}));
+  graphs.emplace_back("paint input", std::move(paint));
+
+  FilterGraph rotated = dropShadowGraph();
+  rotated.filterFromDevice = AffineTransform{0.8, 0.6, -0.6, 0.8, 0.0, 0.0};
+  rotated.nodes.front().userSpaceSubregion = PixelRect{0, 0, 30, 30};
+  graphs.emplace_back("rotation-aware subregion", std::move(rotated));
+
+  for (auto& [name, graph] : graphs) {
+    SCOPED_TRACE(name);
+    const Execution reference = run(graph, FilterPrecision::Float);
+    const Execution requested = run(graph, FilterPrecision::Uint8);
+    EXPECT_EQ(requested.stats.precision, FilterPrecision::Float);
+    EXPECT_EQ(maxChannelError(reference.pixmap, requested.pixmap), 0);
+  }
+}
+
+}  // namespace
+}  // namespace tiny_skia::filter
@@ -5,6 +5,7 @@
 /// test, so the same assertions run against the vector branch in native mode
 /// and against the fallback in scalar mode.
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cmath>
@@ -18,6 +19,7 @@
 #include "gtest/gtest.h"
 #include "tiny_skia/Pixmap.h"
 #include "tiny_skia/filter/ColorMatrix.h"
+#include "tiny_skia/filter/Composite.h"
 #include "tiny_skia/filter/FloatPixmap.h"
 #include "tiny_skia/filter/Merge.h"
 #include "tiny_skia/filter/SimdVec.h"
@@ -378,6 +380,117 @@ TEST(ColorMatrixFloatTest, DenormalAlphaProducesNanThatTheClampPassesThrough) {
   }
 }
 
+// ---------------------------------------------------------------------------
+// ColorMatrix (uint8)
+// ---------------------------------------------------------------------------
+
+/// Longhand double-precision reference for the 8-bit color matrix, as the byte
+/// path computed it before it shared the float kernel: unpremultiply, apply the
+/// matrix with the translation column scaled to bytes, clamp, and re-premultiply
+/// with rounding. Transparent pixels only see the translation column, which is
+/// premultiplied before it is clamped, like the float path's shortcut.
+std::array<std::uint8_t, 4> referenceColorMatrixBytes(const std::uint8_t* pixel,
+                                                      const std::array<double, 20>& m) {
+  const double pa = pixel[3];
+  if (pa == 0.0) {
+    const double ca = std::clamp(m[19] * 255.0, 0.0, 255.0);
+    const auto translated = [&](double value) {
+      return static_cast<std::uint8_t>(std::clamp(std::round(value * 255.0 * ca / 255.0), 0.0,
+                                                  255.0));
+    };
+    return {translated(m[4]), translated(m[9]), translated(m[14]),
+            static_cast<std::uint8_t>(std::round(ca))};
+  }
+
+  const double r = pixel[0] * 255.0 / pa;
+  const double g = pixel[1] * 255.0 / pa;
+  const double b = pixel[2] * 255.0 / pa;
+  const auto row = [&](std::size_t i) {
+    return m[i] * r + m[i + 1] * g + m[i + 2] * b + m[i + 3] * pa + m[i + 4] * 255.0;
+  };
+  const double ca = std::clamp(row(15), 0.0, 255.0);
+  const auto premultiplied = [&](double value) {
+    return static_cast<std::uint8_t>(std::round(std::clamp(value, 0.0, 255.0) * ca / 255.0));
+  };
+  return {premultiplied(row(0)), premultiplied(row(5)), premultiplied(row(10)),
+          static_cast<std::uint8_t>(std::round(ca))};
+}
+
+/// Premultiplied bytes covering the whole alpha range, with every color channel
+/// at or below its alpha.
+std::vector<std::uint8_t> makePremultipliedBytes(std::size_t pixelCount) {
+  std::vector<std::uint8_t> bytes(pixelCount * 4);
+  for (std::size_t i = 0; i < pixelCount; ++i) {
+    const std::uint8_t alpha = static_cast<std::uint8_t>(i * 255u / (pixelCount - 1));
+    bytes[i * 4 + 3] = alpha;
+    for (std::size_t channel = 0; channel < 3; ++channel) {
+      bytes[i * 4 + channel] =
+          static_cast<std::uint8_t>(sampleByte(i * 3 + channel) * alpha / 255u);
+    }
+  }
+  return bytes;
+}
+
+TEST(ColorMatrixUint8Test, MatchesDoubleReferenceWithinOneStep) {
+  constexpr std::size_t kPixelCount = 523;
+  const std::vector<std::uint8_t> source = makePremultipliedBytes(kPixelCount);
+
+  for (std::size_t matrixIndex = 0; matrixIndex < colorMatrixSampleMatrices().size();
+       ++matrixIndex) {
+    SCOPED_TRACE(testing::Message() << "matrix=" << matrixIndex);
+    const std::array<double, 20>& matrix = colorMatrixSampleMatrices()[matrixIndex];
+
+    Pixmap pixmap = *Pixmap::fromVec(source, IntSize::fromWH(kPixelCount, 1).value());
+    colorMatrix(pixmap, matrix);
+
+    const auto out = pixmap.data();
+    for (std::size_t i = 0; i < kPixelCount; ++i) {
+      const std::array<std::uint8_t, 4> expected =
+          referenceColorMatrixBytes(source.data() + i * 4, matrix);
+      for (std::size_t channel = 0; channel < 4; ++channel) {
+        SCOPED_TRACE(testing::Message() << "pixel=" << i << " channel=" << channel);
+        EXPECT_LE(std::abs(int{out[i * 4 + channel]} - int{expected[channel]}), 1);
+        // The output stays premultiplied.
+        EXPECT_LE(out[i * 4 + channel], out[i * 4 + 3]);
+      }
+    }
+  }
+}
+
+TEST(ColorMatrixUint8Test, IdentityLeavesEveryPixelUnchanged) {
+  constexpr std::size_t kPixelCount = 256;
+  const std::vector<std::uint8_t> source = makePremultipliedBytes(kPixelCount);
+
+  Pixmap pixmap = *Pixmap::fromVec(source, IntSize::fromWH(kPixelCount, 1).value());
+  colorMatrix(pixmap, identityMatrix());
+
+  EXPECT_THAT(std::vector<std::uint8_t>(pixmap.data().begin(), pixmap.data().end()),
+              ElementsAreArray(source));
+}
+
+TEST(ColorMatrixUint8Test, TranslationOnlyMatrixReachesTransparentPixels) {
+  const std::array<double, 20> matrix = {0, 0, 0, 0, 0.75,  //
+                                         0, 0, 0, 0, 0.25,  //
+                                         0, 0, 0, 0, 1.5,   //
+                                         0, 0, 0, 0, 0.5};
+
+  Pixmap pixmap = *Pixmap::fromSize(1, 1);
+  colorMatrix(pixmap, matrix);
+
+  const std::uint8_t transparent[4] = {0, 0, 0, 0};
+  const std::array<std::uint8_t, 4> expected = referenceColorMatrixBytes(transparent, matrix);
+  for (std::size_t channel = 0; channel < 4; ++channel) {
+    SCOPED_TRACE(testing::Message() << "channel=" << channel);
+    EXPECT_LE(std::abs(int{pixmap.data()[channel]} - int{expected[channel]}), 1);
+  }
+
+  // Without a translation column, transparent pixels are left untouched.
+  Pixmap untouched = *Pixmap::fromSize(1, 1);
+  colorMatrix(untouched, identityMatrix());
+  EXPECT_THAT(std::vector<std::uint8_t>(untouched.data().begin(), untouched.data().end()),
+              ElementsAreArray({0, 0, 0, 0}));
+}
+
 // ---------------------------------------------------------------------------
 // Merge (uint8)
 // ---------------------------------------------------------------------------
@@ -476,6 +589,90 @@ TEST(MergeUint8Test, SaturatesAndRoundsAtTheExtremes) {
   EXPECT_THAT(dst.data(), ElementsAreArray(referenceMerge({bottom, top}, bottom.size())));
 }
 
+// ---------------------------------------------------------------------------
+// Composite (uint8)
+// ---------------------------------------------------------------------------
+
+/// Longhand scalar Porter-Duff reference for the 8-bit composite: each input
+/// scaled by its weight with its own div255, then summed and saturated.
+std::vector<std::uint8_t> referencePorterDuff(const std::vector<std::uint8_t>& in1,
+                                              const std::vector<std::uint8_t>& in2,
+                                              CompositeOp op) {
+  const auto scale = [](std::uint32_t value, std::uint32_t weight) {
+    const std::uint32_t product = value * weight;
+    return (product + 128 + ((product + 128) >> 8)) >> 8;
+  };
+
+  std::vector<std::uint8_t> out(in1.size(), 0);
+  for (std::size_t off = 0; off + 4 <= in1.size(); off += 4) {
+    const std::uint32_t a1 = in1[off + 3];
+    const std::uint32_t a2 = in2[off + 3];
+    std::uint32_t fa = 255;
+    std::uint32_t fb = 255;
+    switch (op) {
+      case CompositeOp::Over: fb = 255 - a1; break;
+      case CompositeOp::In: fa = a2; fb = 0; break;
+      case CompositeOp::Out: fa = 255 - a2; fb = 0; break;
+      case CompositeOp::Atop: fa = a2; fb = 255 - a1; break;
+      case CompositeOp::Xor: fa = 255 - a2; fb = 255 - a1; break;
+      case CompositeOp::Lighter:
+      case CompositeOp::Arithmetic: break;
+    }
+
+    for (std::size_t channel = 0; channel < 4; ++channel) {
+      const std::uint32_t sum = scale(in1[off + channel], fa) + scale(in2[off + channel], fb);
+      out[off + channel] = static_cast<std::uint8_t>(sum < 255u ? sum : 255u);
+    }
+  }
+
+  return out;
+}
+
+TEST(CompositeUint8Test, PorterDuffMatchesScalarReferenceAcrossVectorStepAndTail) {
+  constexpr std::array<CompositeOp, 6> kOps = {CompositeOp::Over, CompositeOp::In,
+                                               CompositeOp::Out,  CompositeOp::Atop,
+                                               CompositeOp::Xor,  CompositeOp::Lighter};
+  for (const CompositeOp op : kOps) {
+    // Pixel counts sweep the 4-pixel vector step and every tail remainder.
+    for (std::size_t pixelCount = 1; pixelCount <= 11; ++pixelCount) {
+      SCOPED_TRACE(testing::Message() << "op=" << static_cast<int>(op)
+                                      << " pixelCount=" << pixelCount);
+
+      const std::vector<std::uint8_t> bytes1 = makeLayerBytes(pixelCount, 3);
+      const std::vector<std::uint8_t> bytes2 = makeLayerBytes(pixelCount, 41);
+      const IntSize size = IntSize::fromWH(static_cast<std::uint32_t>(pixelCount), 1).value();
+      const Pixmap in1 = *Pixmap::fromVec(bytes1, size);
+      const Pixmap in2 = *Pixmap::fromVec(bytes2, size);
+
+      Pixmap dst = *Pixmap::fromSize(static_cast<std::uint32_t>(pixelCount), 1);
+      composite(in1, in2, dst, op);
+
+      EXPECT_THAT(dst.data(), ElementsAreArray(referencePorterDuff(bytes1, bytes2, op)));
+    }
+  }
+}
+
+TEST(CompositeUint8Test, FullWeightPassesInputThroughAndLighterSaturates) {
+  // Over with an opaque top returns the top unchanged, and Lighter of two
+  // bright pixels saturates. Four pixels is exactly one vector step.
+  const std::vector<std::uint8_t> top = {10, 20, 30, 255, 200, 200, 200, 200,
+                                         0,  0,  0,  0,   1,   2,   3,   3};
+  const std::vector<std::uint8_t> bottom = {90, 80, 70, 255, 100, 150, 200, 250,
+                                            4,  5,  6,  7,   255, 255, 255, 255};
+  const IntSize size = IntSize::fromWH(4, 1).value();
+  const Pixmap topPixmap = *Pixmap::fromVec(top, size);
+  const Pixmap bottomPixmap = *Pixmap::fromVec(bottom, size);
+
+  Pixmap over = *Pixmap::fromSize(4, 1);
+  composite(topPixmap, bottomPixmap, over, CompositeOp::Over);
+  EXPECT_THAT(std::span(over.data().data(), 4), ElementsAreArray({10, 20, 30, 255}));
+  EXPECT_THAT(over.data(), ElementsAreArray(referencePorterDuff(top, bottom, CompositeOp::Over)));
+
+  Pixmap lighter = *Pixmap::fromSize(4, 1);
+  composite(topPixmap, bottomPixmap, lighter, CompositeOp::Lighter);
+  EXPECT_THAT(std::span(lighter.data().data() + 4, 4), ElementsAreArray({255, 255, 255, 255}));
+}
+
 // ---------------------------------------------------------------------------
 // Turbulence lattice blend
 // ---------------------------------------------------------------------------
@@ -959,6 +959,21 @@ void gradient(Pipeline& pipeline) {
   pipeline.nextStage();
 }
 
+void gradientLut(Pipeline& pipeline) {
+  const auto& ctx = pipeline.ctx->gradientLut;
+  constexpr float kLastIndex = static_cast<float>(kGradientLutSize - 1);
+  for (std::size_t i = 0; i < kStageWidth; ++i) {
+    // Pad is applied here as well: t outside [0,1] takes the end colors.
+    const auto index = static_cast<std::size_t>(normalize(pipeline.r[i]) * kLastIndex + 0.5f);
+    const GradientColor& color = ctx.colors[index];
+    pipeline.r[i] = color.r;
+    pipeline.g[i] = color.g;
+    pipeline.b[i] = color.b;
+    pipeline.a[i] = color.a;
+  }
+  pipeline.nextStage();
+}
+
 void xyToUnitAngle(Pipeline& pipeline) {
   for (std::size_t i = 0; i < kStageWidth; ++i) {
     const float x = pipeline.r[i];
@@ -1667,6 +1682,7 @@ const std::array<StageFn, kStagesCount> STAGES = {
     fusedLinearGradient2Stop,
     fusedRadialGradient2Stop,
     fusedBilinearPattern,
+    gradientLut,
 };
 
 }  // namespace tiny_skia::pipeline::highp
@@ -1254,6 +1254,33 @@ void gradient(Pipeline& pipeline) {
   pipeline.nextStage();
 }
 
+void gradientLut(Pipeline& pipeline) {
+  const auto& ctx = pipeline.ctx->gradientLut;
+  constexpr float kLastIndex = static_cast<float>(kGradientLutSize - 1);
+  const auto t = join(pipeline.r, pipeline.g);
+  const auto tLo = t.lo().lanes();
+  const auto tHi = t.hi().lanes();
+
+  std::array<std::uint16_t, 16> r{}, g{}, b{}, a{};
+  for (std::size_t i = 0; i < 16; ++i) {
+    // Pad is applied here as well: t outside [0,1] takes the end colors.
+    const float ti = i < 8 ? tLo[i] : tHi[i - 8];
+    const auto index =
+        static_cast<std::size_t>(std::max(0.0f, std::min(1.0f, ti)) * kLastIndex + 0.5f);
+    const auto& color = ctx.colorsU16[index];
+    r[i] = color[0];
+    g[i] = color[1];
+    b[i] = color[2];
+    a[i] = color[3];
+  }
+
+  pipeline.r = U16x16T(r);
+  pipeline.g = U16x16T(g);
+  pipeline.b = U16x16T(b);
+  pipeline.a = U16x16T(a);
+  pipeline.nextStage();
+}
+
 void xyToRadius(Pipeline& pipeline) {
   auto x = join(pipeline.r, pipeline.g);
   auto y = join(pipeline.b, pipeline.a);
@@ -2076,6 +2103,7 @@ const std::array<StageFn, kStagesCount> STAGES = {
     fusedLinearGradient2Stop,
     fusedRadialGradient2Stop,
     fusedBilinearPattern,
+    gradientLut,
 };
 
 const std::array<StageFn, kStagesCount> STAGES_TAIL = [] {
@@ -9,7 +9,7 @@
 
 namespace tiny_skia::pipeline {
 
-static_assert(kStagesCount == 84);
+static_assert(kStagesCount == 85);
 static_assert(sizeof(GradientColor) == sizeof(float) * 4);
 
 namespace {
@@ -101,6 +101,7 @@ namespace {
     case Stage::FusedLinearGradient2Stop:
     case Stage::FusedRadialGradient2Stop:
     case Stage::FusedBilinearPattern:
+    case Stage::GradientLut:
       return true;
   }
   return false;  // unreachable; satisfies -Wreturn-type
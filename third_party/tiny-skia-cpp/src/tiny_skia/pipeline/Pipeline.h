@@ -130,10 +130,11 @@ enum class Stage : std::uint8_t {
   FusedLinearGradient2Stop,  ///< SeedShader+Transform+PadX1+EvenlySpaced2StopGradient+Premultiply
   FusedRadialGradient2Stop,  ///< Same as above but for simple radial (xy_to_radius path)
   FusedBilinearPattern,      ///< SeedShader+Transform+BilinearRepeat pattern sampling
+  GradientLut,               ///< Gradient+Premultiply as a lookup into a precomputed color table
 };
 
 /// @internal
-inline constexpr std::size_t kStagesCount = 1 + static_cast<std::size_t>(Stage::FusedBilinearPattern);
+inline constexpr std::size_t kStagesCount = 1 + static_cast<std::size_t>(Stage::GradientLut);
 /// @internal
 inline constexpr std::size_t kMaxStages = 32;
 
@@ -264,6 +265,18 @@ struct FusedBilinearPatternCtx {
   std::int8_t opaqueCheckResult = -1;  ///< -1 = unchecked, 0 = has transparency, 1 = all opaque
 };
 
+/// @internal
+/// Entries in a gradient color table, sampled at evenly spaced t values from 0 to 1.
+inline constexpr std::size_t kGradientLutSize = 1024;
+
+/// @internal
+/// Premultiplied gradient colors for the GradientLut stage, kGradientLutSize entries each.
+/// Points into the shader's table, which outlives the pipeline like a pattern's pixels do.
+struct GradientLutCtx {
+  const GradientColor* colors = nullptr;                ///< Highp: float components.
+  const std::array<std::uint16_t, 4>* colorsU16 = nullptr;  ///< Lowp: 0..255 components.
+};
+
 /// @internal
 struct TwoPointConicalGradientCtx {
   std::array<std::uint32_t, 8> mask = {};
@@ -298,6 +311,7 @@ struct Context {
     }
   } gradient;
 
+  GradientLutCtx gradientLut;
   TwoPointConicalGradientCtx twoPointConicalGradient;
   TileCtx limitX;
   TileCtx limitY;
@@ -95,6 +95,16 @@ class AdditiveBlitter {
 
   AdditiveBlitter(Blitter& realBlitter, std::int32_t left, std::int32_t width, std::int32_t top,
                   std::int32_t height)
+      : AdditiveBlitter(realBlitter, left, width, top,
+                        // Match Skia: small paths use MaskAdditiveBlitter which doesn't snap alpha.
+                        width <= kMaskMaxWidth &&
+                            static_cast<std::int64_t>(width) * height <= kMaskMaxStorage) {}
+
+  // Row buffer covering only [left, left + width), with the alpha snapping mode chosen by the
+  // caller. fillRect uses this to size the buffer to the rect while keeping the mode fillPath
+  // would have picked from the clip.
+  AdditiveBlitter(Blitter& realBlitter, std::int32_t left, std::int32_t width, std::int32_t top,
+                  bool useMaskMode)
       : realBlitter_(realBlitter),
         left_(left),
         width_(width),
@@ -103,9 +113,7 @@ class AdditiveBlitter {
         dirtyMin_(width),
         dirtyMax_(-1),
         row_(static_cast<std::size_t>(width) + 2, 0),
-        // Match Skia: small paths use MaskAdditiveBlitter which doesn't snap alpha.
-        useMaskMode_(width <= kMaskMaxWidth &&
-                     static_cast<std::int64_t>(width) * height <= kMaskMaxStorage) {}
+        useMaskMode_(useMaskMode) {}
 
   ~AdditiveBlitter() { flush(); }
 
@@ -632,6 +640,78 @@ bool isSmoothEnough(AnalyticEdge* leftE, AnalyticEdge* riteE, AnalyticEdge* curr
   return isSmoothEnough(leftE, currE, stopY) && isSmoothEnough(riteE, nextCurrE, stopY);
 }
 
+// ── Axis-aligned band ───────────────────────────────────────────────────────
+// Blits the band between two vertical edges at `left` and `rite`, from `y` down to
+// `localBotFixed`. Shared by the convex walker's zero-slope case and fillRect, which
+// must produce identical coverage.
+
+void blitAxisAlignedBand(AdditiveBlitter& blitter, FDot16 y, FDot16 localBotFixed, FDot16 left,
+                         FDot16 rite) {
+  int fullLeft = fdot16::ceilToI32(left);
+  int fullRite = fdot16::floorToI32(rite);
+  FDot16 partialLeft = intToFixed(fullLeft) - left;
+  FDot16 partialRite = rite - intToFixed(fullRite);
+  int fullTop = fdot16::ceilToI32(y);
+  int fullBot = fdot16::floorToI32(localBotFixed);
+  FDot16 partialTop = intToFixed(fullTop) - y;
+  FDot16 partialBot = localBotFixed - intToFixed(fullBot);
+  if (fullTop > fullBot) {
+    partialTop -= (fdot16::one - partialBot);
+    partialBot = 0;
+  }
+
+  if (fullRite >= fullLeft) {
+    if (partialTop > 0) {
+      if (partialLeft > 0) {
+        blitter.blitAntiH(fullLeft - 1, fullTop - 1,
+                          fixedToAlpha(fdot16::mul(partialTop, partialLeft)));
+      }
+      blitter.blitAntiH(fullLeft, fullTop - 1, fullRite - fullLeft, fixedToAlpha(partialTop));
+      if (partialRite > 0) {
+        blitter.blitAntiH(fullRite, fullTop - 1,
+                          fixedToAlpha(fdot16::mul(partialTop, partialRite)));
+      }
+      blitter.flushIfYChanged(y, y + partialTop);
+    }
+
+    if (fullBot > fullTop && (fullRite > fullLeft || fixedToAlpha(partialLeft) > 0 ||
+                              fixedToAlpha(partialRite) > 0)) {
+      blitter.getRealBlitter().blitAntiRect(fullLeft - 1, fullTop, fullRite - fullLeft,
+                                            fullBot - fullTop, fixedToAlpha(partialLeft),
+                                            fixedToAlpha(partialRite));
+    }
+
+    if (partialBot > 0) {
+      if (partialLeft > 0) {
+        blitter.blitAntiH(fullLeft - 1, fullBot,
+                          fixedToAlpha(fdot16::mul(partialBot, partialLeft)));
+      }
+      blitter.blitAntiH(fullLeft, fullBot, fullRite - fullLeft, fixedToAlpha(partialBot));
+      if (partialRite > 0) {
+        blitter.blitAntiH(fullRite, fullBot, fixedToAlpha(fdot16::mul(partialBot, partialRite)));
+      }
+    }
+  } else {
+    FDot16 width = rite - left;
+    if (width > 0) {
+      if (partialTop > 0) {
+        blitter.blitAntiH(fullLeft - 1, fullTop - 1, 1,
+                          fixedToAlpha(fdot16::mul(partialTop, width)));
+        blitter.flushIfYChanged(y, y + partialTop);
+      }
+      if (fullBot > fullTop) {
+        blitter.getRealBlitter().blitV(static_cast<std::uint32_t>(fullLeft - 1),
+                                       static_cast<std::uint32_t>(fullTop),
+                                       static_cast<LengthU32>(fullBot - fullTop),
+                                       fixedToAlpha(width));
+      }
+      if (partialBot > 0) {
+        blitter.blitAntiH(fullLeft - 1, fullBot, 1, fixedToAlpha(fdot16::mul(partialBot, width)));
+      }
+    }
+  }
+}
+
 // ── Convex edge walker ──────────────────────────────────────────────────────
 // Optimized walker for convex paths: only tracks two edges (left/right).
 // Matches Skia's aaa_walk_convex_edges for bit-exact coverage.
@@ -690,74 +770,7 @@ void aaaWalkConvexEdges(AnalyticEdge* prevHead, AdditiveBlitter& blitter, int st
 
     if (0 == (dLeft | dRite)) {
       // Zero-slope case: axis-aligned rect optimization.
-      int fullLeft = fdot16::ceilToI32(left);
-      int fullRite = fdot16::floorToI32(rite);
-      FDot16 partialLeft = intToFixed(fullLeft) - left;
-      FDot16 partialRite = rite - intToFixed(fullRite);
-      int fullTop = fdot16::ceilToI32(y);
-      int fullBot = fdot16::floorToI32(localBotFixed);
-      FDot16 partialTop = intToFixed(fullTop) - y;
-      FDot16 partialBot = localBotFixed - intToFixed(fullBot);
-      if (fullTop > fullBot) {
-        partialTop -= (fdot16::one - partialBot);
-        partialBot = 0;
-      }
-
-      if (fullRite >= fullLeft) {
-        if (partialTop > 0) {
-          if (partialLeft > 0) {
-            blitter.blitAntiH(fullLeft - 1, fullTop - 1,
-                              fixedToAlpha(fdot16::mul(partialTop, partialLeft)));
-          }
-          blitter.blitAntiH(fullLeft, fullTop - 1, fullRite - fullLeft,
-                            fixedToAlpha(partialTop));
-          if (partialRite > 0) {
-            blitter.blitAntiH(fullRite, fullTop - 1,
-                              fixedToAlpha(fdot16::mul(partialTop, partialRite)));
-          }
-          blitter.flushIfYChanged(y, y + partialTop);
-        }
-
-        if (fullBot > fullTop &&
-            (fullRite > fullLeft || fixedToAlpha(partialLeft) > 0 ||
-             fixedToAlpha(partialRite) > 0)) {
-          blitter.getRealBlitter().blitAntiRect(fullLeft - 1, fullTop, fullRite - fullLeft,
-                                                fullBot - fullTop, fixedToAlpha(partialLeft),
-                                                fixedToAlpha(partialRite));
-        }
-
-        if (partialBot > 0) {
-          if (partialLeft > 0) {
-            blitter.blitAntiH(fullLeft - 1, fullBot,
-                              fixedToAlpha(fdot16::mul(partialBot, partialLeft)));
-          }
-          blitter.blitAntiH(fullLeft, fullBot, fullRite - fullLeft, fixedToAlpha(partialBot));
-          if (partialRite > 0) {
-            blitter.blitAntiH(fullRite, fullBot,
-                              fixedToAlpha(fdot16::mul(partialBot, partialRite)));
-          }
-        }
-      } else {
-        FDot16 width = rite - left;
-        if (width > 0) {
-          if (partialTop > 0) {
-            blitter.blitAntiH(fullLeft - 1, fullTop - 1, 1,
-                              fixedToAlpha(fdot16::mul(partialTop, width)));
-            blitter.flushIfYChanged(y, y + partialTop);
-          }
-          if (fullBot > fullTop) {
-            blitter.getRealBlitter().blitV(static_cast<std::uint32_t>(fullLeft - 1),
-                                           static_cast<std::uint32_t>(fullTop),
-                                           static_cast<LengthU32>(fullBot - fullTop),
-                                           fixedToAlpha(width));
-          }
-          if (partialBot > 0) {
-            blitter.blitAntiH(fullLeft - 1, fullBot, 1,
-                              fixedToAlpha(fdot16::mul(partialBot, width)));
-          }
-        }
-      }
-
+      blitAxisAlignedBand(blitter, y, localBotFixed, left, rite);
       y = localBotFixed;
     } else {
       // Non-zero slope: row-by-row trapezoid blitting with X snapping.
@@ -1270,6 +1283,57 @@ void fillPathImpl(const Path& path, FillRule fillRule, const IntRect& bounds,
   aaaFillPath(path, fillRule, clipRect, additiveBlitter, startY, stopY, pathContainedInClip);
 }
 
+void fillRect(const Rect& rect, const ScreenIntRect& clip, Blitter& blitter) {
+  const auto boundsOpt = rect.roundOut();
+  if (!boundsOpt) return;
+
+  const auto clipped = boundsOpt->intersect(clip.toIntRect());
+  if (!clipped) return;
+
+  if (clip.right() > 32767 || clip.bottom() > 32767) return;
+
+  // Edges crossing the clip are split by the edge clipper, which only fillPath does.
+  const auto boundsScreen = boundsOpt->toScreenIntRect();
+  if (!boundsScreen.has_value() || !clip.contains(boundsScreen.value())) {
+    fillPath(Path::fromRect(rect), FillRule::Winding, clip, blitter);
+    return;
+  }
+
+  // The two edges buildAnalyticEdges keeps for Path::fromRect; the horizontal ones are dropped
+  // by setLine.
+  AnalyticEdge riteE;
+  AnalyticEdge leftE;
+  if (!riteE.setLine(Point{rect.right(), rect.top()}, Point{rect.right(), rect.bottom()}) ||
+      !leftE.setLine(Point{rect.left(), rect.bottom()}, Point{rect.left(), rect.top()})) {
+    return;
+  }
+
+  // What aaaWalkConvexEdges does with exactly these two edges: a single zero-slope band.
+  const int stopY = static_cast<int>(boundsOpt->y() + boundsOpt->height());
+  const FDot16 y = std::max(leftE.upperY, riteE.upperY);
+  if (fdot16::floorToI32(y) >= stopY) return;
+
+  const FDot16 localBotFixed =
+      std::min(std::min(leftE.lowerY, riteE.lowerY), intToFixed(static_cast<std::int32_t>(stopY)));
+  const FDot16 left = std::max(intToFixed(static_cast<std::int32_t>(clip.x())), leftE.x);
+  const FDot16 rite = std::min(intToFixed(static_cast<std::int32_t>(clip.right())), riteE.x);
+
+  // Coverage lands inside the rounded-out bounds, so the row buffer only needs those columns
+  // (plus one either side, for fixed-point rounding). Alpha snapping still follows the clip.
+  const auto bufferLeft =
+      std::max(static_cast<std::int32_t>(clip.x()), static_cast<std::int32_t>(boundsOpt->x()) - 1);
+  const auto bufferRight = std::min(static_cast<std::int32_t>(clip.right()),
+                                    static_cast<std::int32_t>(boundsOpt->right()) + 1);
+  const auto clipWidth = static_cast<std::int32_t>(clip.width());
+  const bool useMaskMode =
+      clipWidth <= AdditiveBlitter::kMaskMaxWidth &&
+      static_cast<std::int64_t>(clipWidth) * clip.height() <= AdditiveBlitter::kMaskMaxStorage;
+
+  AdditiveBlitter additiveBlitter(blitter, bufferLeft, bufferRight - bufferLeft,
+                                  static_cast<std::int32_t>(clip.y()), useMaskMode);
+  blitAxisAlignedBand(additiveBlitter, y, localBotFixed, left, rite);
+}
+
 }  // namespace scan::path_aa
 
 }  // namespace tiny_skia
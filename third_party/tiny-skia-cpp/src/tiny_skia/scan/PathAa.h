@@ -13,6 +13,10 @@ namespace path_aa {
 
 void fillPath(const Path& path, FillRule fillRule, const ScreenIntRect& clip, Blitter& blitter);
 
+/// Fills \p rect with the same coverage fillPath produces for `Path::fromRect(rect)` and
+/// FillRule::Winding, without building, sorting or walking an edge list.
+void fillRect(const Rect& rect, const ScreenIntRect& clip, Blitter& blitter);
+
 void fillPathImpl(const Path& path, FillRule fillRule, const IntRect& bounds,
                   const ScreenIntRect& clipRect, std::int32_t startY, std::int32_t stopY,
                   std::int32_t shiftEdgesUp, bool pathContainedInClip, Blitter& blitter);
@@ -0,0 +1,1202 @@
+// Sparse-strip coverage rasterizer.
+//
+// Three passes over the path:
+//   1. Flatten curves to lines, clipping each line to the clip rectangle. Parts left of the clip
+//      are moved onto its left edge, which keeps their winding for every visible pixel.
+//   2. Bin each line into the 4x4 tiles it crosses, as one sortable 64-bit key per tile.
+//   3. Walk the sorted tiles row by row. Tiles holding edges get exact area coverage, computed
+//      for two pixel rows of four pixels per 8-lane operation; the runs between them take their
+//      coverage from the winding accumulated so far (the backdrop).
+//
+// Averaging a pixel's winding and then applying the fill rule is only exact while the winding
+// inside the pixel stays on one linear piece of the rule, such as 0 and 1, or 1 and 2 for
+// nonzero. A pixel row of a tile where more than one line is active, or whose backdrop changes
+// partway down, can break that: overlapping contours put windings 0 and 2 into one pixel. Those
+// rows are redone by cutting the row into strips at every line end and crossing, ordering the
+// lines within each strip, and applying the fill rule to the integer winding between them.
+// Most of them turn out to be exact already, which the chains their lines belong to usually
+// show: lines that follow each other in y without turning can never overlap.
+
+#include "tiny_skia/scan/SparseStrips.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "tiny_skia/EdgeBuilder.h"
+#include "tiny_skia/wide/backend/Aarch64NeonF32x8T.h"
+#include "tiny_skia/wide/backend/ScalarF32x8T.h"
+#include "tiny_skia/wide/backend/WasmSimd128F32x8T.h"
+#include "tiny_skia/wide/backend/X86Avx2FmaF32x8T.h"
+
+namespace tiny_skia {
+
+namespace {
+
+// The coverage kernel runs once per line per tile, so like Lowp it calls the active wide
+// backend's inline functions instead of going through wide::F32x8T's out-of-line dispatch,
+// which costs a call per operation.
+#if defined(TINYSKIA_CFG_IF_SIMD_NATIVE) && defined(__AVX2__) && defined(__FMA__) && \
+    (defined(__x86_64__) || defined(__i386__))
+namespace f32x8 = wide::backend::x86_avx2_fma;
+#elif defined(TINYSKIA_CFG_IF_SIMD_NATIVE) && defined(__aarch64__) && defined(__ARM_NEON)
+namespace f32x8 = wide::backend::aarch64_neon;
+#elif defined(TINYSKIA_CFG_IF_SIMD_NATIVE) && defined(__wasm_simd128__)
+namespace f32x8 = wide::backend::wasm_simd128;
+#else
+namespace f32x8 = wide::backend::scalar;
+#endif
+
+/// Eight float lanes with the handful of operations the kernel needs.
+struct F32x8 {
+  std::array<float, 8> lanes;
+
+  static F32x8 splat(float n) { return F32x8{{n, n, n, n, n, n, n, n}}; }
+  /// Four lanes of \p a followed by four of \p b: one value per pixel row.
+  static F32x8 rows(float a, float b) { return F32x8{{a, a, a, a, b, b, b, b}}; }
+
+  F32x8 operator+(const F32x8& rhs) const { return F32x8{f32x8::f32x8Add(lanes, rhs.lanes)}; }
+  F32x8 operator-(const F32x8& rhs) const { return F32x8{f32x8::f32x8Sub(lanes, rhs.lanes)}; }
+  F32x8 operator*(const F32x8& rhs) const { return F32x8{f32x8::f32x8Mul(lanes, rhs.lanes)}; }
+  F32x8 min(const F32x8& rhs) const { return F32x8{f32x8::f32x8Min(lanes, rhs.lanes)}; }
+  F32x8 max(const F32x8& rhs) const { return F32x8{f32x8::f32x8Max(lanes, rhs.lanes)}; }
+  F32x8 abs() const { return F32x8{f32x8::f32x8Abs(lanes)}; }
+  F32x8 floor() const { return F32x8{f32x8::f32x8Floor(lanes)}; }
+};
+
+/// Rows of a tile handled by one F32x8: two rows of kTileSize pixels.
+constexpr std::int32_t kRowsPerVector = 8 / scan::sparse_strips::kTileSize;
+
+/// Upper bound on the lines one curve is flattened into.
+constexpr int kMaxCurveSegments = 512;
+
+/// Lines whose horizontal extent within one pixel row is below this are treated as vertical.
+/// Dividing the area difference by a smaller extent loses more to cancellation than the
+/// vertical approximation does.
+constexpr float kVerticalEpsilon = 1.0f / 1024.0f;
+
+/// Larger than any x a line can have.
+constexpr float kNoX = 1e9f;
+
+/// A chain no line belongs to, standing for lines of more than one chain, or for none.
+constexpr std::uint32_t kNoChain = UINT32_MAX;
+
+/// One flattened, clipped line, stored top to bottom.
+struct Line {
+  float x0 = 0.0f;
+  float y0 = 0.0f;
+  float x1 = 0.0f;
+  float y1 = 0.0f;
+  /// Horizontal change per unit of y.
+  float slope = 0.0f;
+  /// +1 if the original line pointed down, -1 if up.
+  float winding = 0.0f;
+  /// Lines of one chain share a winding and follow each other in y, so no two of them are
+  /// ever active at the same height.
+  std::uint32_t chain = 0;
+
+  [[nodiscard]] float xAt(float y) const { return x0 + (y - y0) * slope; }
+};
+
+/// Tile keys sort by tile row, then tile column, then line. The low bit marks the rightmost
+/// tile a line touches in its tile row, after which the line's winding joins the backdrop.
+std::uint64_t makeTileKey(std::uint32_t tileY, std::uint32_t tileX, std::uint32_t line,
+                          bool last) {
+  return (static_cast<std::uint64_t>(tileY) << 48) | (static_cast<std::uint64_t>(tileX) << 32) |
+         (static_cast<std::uint64_t>(line) << 1) | (last ? 1u : 0u);
+}
+
+std::uint32_t tileKeyY(std::uint64_t key) { return static_cast<std::uint32_t>(key >> 48); }
+std::uint32_t tileKeyX(std::uint64_t key) { return static_cast<std::uint32_t>(key >> 32) & 0xFFFF; }
+std::uint32_t tileKeyLine(std::uint64_t key) {
+  return static_cast<std::uint32_t>(key & 0xFFFFFFFFu) >> 1;
+}
+bool tileKeyLast(std::uint64_t key) { return (key & 1u) != 0; }
+
+/// Flattens path edges into clipped lines.
+class LineBuilder {
+ public:
+  explicit LineBuilder(const ScreenIntRect& clip)
+      : left_(static_cast<float>(clip.left())),
+        top_(static_cast<float>(clip.top())),
+        right_(static_cast<float>(clip.right())),
+        bottom_(static_cast<float>(clip.bottom())) {}
+
+  void addEdge(const PathEdge& edge) {
+    switch (edge.type) {
+      case PathEdgeType::LineTo:
+        addLine(edge.points[0], edge.points[1]);
+        break;
+      case PathEdgeType::QuadTo:
+        addQuad(edge.points[0], edge.points[1], edge.points[2]);
+        break;
+      case PathEdgeType::CubicTo:
+        addCubic(edge.points[0], edge.points[1], edge.points[2], edge.points[3]);
+        break;
+    }
+  }
+
+  void reserve(std::size_t lines) { lines_.reserve(lines); }
+
+  [[nodiscard]] std::vector<Line>& lines() { return lines_; }
+
+ private:
+  /// Returns true if no part of the hull of \p points can reach a visible pixel with anything
+  /// but its winding, so the chord alone gives the same coverage.
+  [[nodiscard]] bool canReplaceWithChord(std::span<const Point> points) const {
+    bool above = true;
+    bool below = true;
+    bool leftOf = true;
+    bool rightOf = true;
+    for (const Point& p : points) {
+      above = above && p.y <= top_;
+      below = below && p.y >= bottom_;
+      leftOf = leftOf && p.x <= left_;
+      rightOf = rightOf && p.x >= right_;
+    }
+    return above || below || leftOf || rightOf;
+  }
+
+  void addQuad(Point p0, Point p1, Point p2) {
+    const std::array<Point, 3> points = {p0, p1, p2};
+    if (canReplaceWithChord(points)) {
+      addLine(p0, p2);
+      return;
+    }
+
+    // The distance from a quad to its chord over a parameter step of 1/n is at most
+    // |p0 - 2 p1 + p2| / (4 n^2).
+    const float ddx = p0.x - 2.0f * p1.x + p2.x;
+    const float ddy = p0.y - 2.0f * p1.y + p2.y;
+    const int n = segmentCount(std::sqrt(ddx * ddx + ddy * ddy) * 0.25f);
+
+    Point prev = p0;
+    for (int i = 1; i < n; ++i) {
+      const float t = static_cast<float>(i) / static_cast<float>(n);
+      const float mt = 1.0f - t;
+      const Point next = Point::fromXY(mt * mt * p0.x + 2.0f * mt * t * p1.x + t * t * p2.x,
+                                       mt * mt * p0.y + 2.0f * mt * t * p1.y + t * t * p2.y);
+      addLine(prev, next);
+      prev = next;
+    }
+    addLine(prev, p2);
+  }
+
+  void addCubic(Point p0, Point p1, Point p2, Point p3) {
+    const std::array<Point, 4> points = {p0, p1, p2, p3};
+    if (canReplaceWithChord(points)) {
+      addLine(p0, p3);
+      return;
+    }
+
+    // Wang's bound for a cubic: 3/4 of the largest second difference over n^2.
+    const float ddx0 = p0.x - 2.0f * p1.x + p2.x;
+    const float ddy0 = p0.y - 2.0f * p1.y + p2.y;
+    const float ddx1 = p1.x - 2.0f * p2.x + p3.x;
+    const float ddy1 = p1.y - 2.0f * p2.y + p3.y;
+    const float dd = std::sqrt(std::max(ddx0 * ddx0 + ddy0 * ddy0, ddx1 * ddx1 + ddy1 * ddy1));
+    const int n = segmentCount(dd * 0.75f);
+
+    Point prev = p0;
+    for (int i = 1; i < n; ++i) {
+      const float t = static_cast<float>(i) / static_cast<float>(n);
+      const float mt = 1.0f - t;
+      const float a = mt * mt * mt;
+      const float b = 3.0f * mt * mt * t;
+      const float c = 3.0f * mt * t * t;
+      const float d = t * t * t;
+      const Point next = Point::fromXY(a * p0.x + b * p1.x + c * p2.x + d * p3.x,
+                                       a * p0.y + b * p1.y + c * p2.y + d * p3.y);
+      addLine(prev, next);
+      prev = next;
+    }
+    addLine(prev, p3);
+  }
+
+  /// Returns the segment count that keeps a curve whose error is `errorScale / n^2` within
+  /// kFlattenTolerance.
+  [[nodiscard]] static int segmentCount(float errorScale) {
+    const float n = std::ceil(std::sqrt(errorScale / scan::sparse_strips::kFlattenTolerance));
+    if (!(n > 1.0f)) {
+      return 1;
+    }
+    return n >= static_cast<float>(kMaxCurveSegments) ? kMaxCurveSegments : static_cast<int>(n);
+  }
+
+  void addLine(Point p0, Point p1) {
+    if (p0.y == p1.y) {
+      return;
+    }
+
+    float winding = 1.0f;
+    if (p0.y > p1.y) {
+      std::swap(p0, p1);
+      winding = -1.0f;
+    }
+
+    if (p1.y <= top_ || p0.y >= bottom_) {
+      return;
+    }
+
+    const float slope = (p1.x - p0.x) / (p1.y - p0.y);
+    if (p0.y < top_) {
+      p0 = Point::fromXY(p0.x + (top_ - p0.y) * slope, top_);
+    }
+    if (p1.y > bottom_) {
+      p1 = Point::fromXY(p1.x - (p1.y - bottom_) * slope, bottom_);
+    }
+
+    if (std::min(p0.x, p1.x) >= left_ && std::max(p0.x, p1.x) <= right_) {
+      pushLine(Line{p0.x, p0.y, p1.x, p1.y, slope, winding});
+      return;
+    }
+
+    // Split where the line crosses the left and right clip edges. At most two splits, and
+    // crossings are visited in y order because the line is monotonic in y.
+    std::array<float, 4> ys = {p0.y, p1.y, p1.y, p1.y};
+    std::size_t count = 1;
+    if (slope != 0.0f) {
+      std::array<float, 2> crossings = {p0.y + (left_ - p0.x) / slope,
+                                        p0.y + (right_ - p0.x) / slope};
+      if (crossings[0] > crossings[1]) {
+        std::swap(crossings[0], crossings[1]);
+      }
+      for (const float y : crossings) {
+        if (y > ys[count - 1] && y < p1.y) {
+          ys[count++] = y;
+        }
+      }
+    }
+    ys[count] = p1.y;
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const float ya = ys[i];
+      const float yb = ys[i + 1];
+      if (!(yb > ya)) {
+        continue;
+      }
+
+      float xa = i == 0 ? p0.x : p0.x + (ya - p0.y) * slope;
+      float xb = i + 1 == count ? p1.x : p0.x + (yb - p0.y) * slope;
+      const float mid = 0.5f * (xa + xb);
+      if (mid >= right_) {
+        // Only pixels right of the clip are right of this part.
+        continue;
+      }
+      if (mid <= left_) {
+        xa = left_;
+        xb = left_;
+      } else {
+        xa = std::clamp(xa, left_, right_);
+        xb = std::clamp(xb, left_, right_);
+      }
+
+      pushLine(Line{xa, ya, xb, yb, (xb - xa) / (yb - ya), winding});
+    }
+  }
+
+  /// Appends \p line, continuing the previous line's chain if it carries on in the same y
+  /// direction from where that line stopped.
+  void pushLine(Line line) {
+    if (!lines_.empty()) {
+      const Line& previous = lines_.back();
+      const bool continues =
+          line.winding == previous.winding &&
+          (line.winding > 0.0f ? line.y0 >= previous.y1 : line.y1 <= previous.y0);
+      line.chain = continues ? previous.chain : previous.chain + 1;
+    }
+    lines_.push_back(line);
+  }
+
+  float left_;
+  float top_;
+  float right_;
+  float bottom_;
+  std::vector<Line> lines_;
+};
+
+/// Appends the tiles \p line crosses, one key per tile.
+void binLine(const Line& line, std::uint32_t index, std::vector<std::uint64_t>& tiles) {
+  constexpr float kTile = static_cast<float>(scan::sparse_strips::kTileSize);
+  constexpr float kInvTile = 1.0f / kTile;
+
+  const auto firstRow = static_cast<std::int32_t>(std::floor(line.y0 * kInvTile));
+  const auto lastRow = static_cast<std::int32_t>(std::ceil(line.y1 * kInvTile)) - 1;
+  for (std::int32_t row = firstRow; row <= lastRow; ++row) {
+    const float rowTop = static_cast<float>(row) * kTile;
+    const float ya = std::max(line.y0, rowTop);
+    const float yb = std::min(line.y1, rowTop + kTile);
+    if (!(yb > ya)) {
+      continue;
+    }
+
+    const float xa = line.xAt(ya);
+    const float xb = line.xAt(yb);
+    const auto firstColumn =
+        static_cast<std::int32_t>(std::floor(std::max(std::min(xa, xb), 0.0f) * kInvTile));
+    // A line exactly on a tile's left edge leaves that tile to the backdrop.
+    const auto lastColumn = std::max(
+        firstColumn, static_cast<std::int32_t>(std::ceil(std::max(xa, xb) * kInvTile)) - 1);
+    for (std::int32_t column = firstColumn; column <= lastColumn; ++column) {
+      tiles.push_back(makeTileKey(static_cast<std::uint32_t>(row),
+                                  static_cast<std::uint32_t>(column), index,
+                                  column == lastColumn));
+    }
+  }
+}
+
+/// Sorts \p tiles by key. Keys are bucketed by tile row first, which is linear, so the
+/// comparison sort only ever sees one row's tiles.
+void sortTiles(std::vector<std::uint64_t>& tiles, std::uint32_t rowCount) {
+  std::vector<std::uint32_t> rowStart(rowCount + 1, 0);
+  for (const std::uint64_t key : tiles) {
+    ++rowStart[tileKeyY(key) + 1];
+  }
+  for (std::uint32_t row = 0; row < rowCount; ++row) {
+    rowStart[row + 1] += rowStart[row];
+  }
+
+  std::vector<std::uint64_t> sorted(tiles.size());
+  std::vector<std::uint32_t> next(rowStart.begin(), rowStart.end() - 1);
+  for (const std::uint64_t key : tiles) {
+    sorted[next[tileKeyY(key)]++] = key;
+  }
+  for (std::uint32_t row = 0; row < rowCount; ++row) {
+    std::sort(sorted.begin() + rowStart[row], sorted.begin() + rowStart[row + 1]);
+  }
+  tiles = std::move(sorted);
+}
+
+/// Converts a winding number to coverage under \p fillRule.
+float windingToCoverage(float winding, FillRule fillRule) {
+  const float w = std::abs(winding);
+  if (fillRule == FillRule::Winding) {
+    return std::min(w, 1.0f);
+  }
+  const float folded = w - 2.0f * std::floor(w * 0.5f);
+  return std::min(folded, 2.0f - folded);
+}
+
+AlphaU8 coverageToAlpha(float coverage) {
+  return static_cast<AlphaU8>(coverage * 255.0f + 0.5f);
+}
+
+/// Vector form of windingToCoverage followed by coverageToAlpha.
+std::array<float, 8> windingToAlpha(const F32x8& winding, FillRule fillRule) {
+  const F32x8 one = F32x8::splat(1.0f);
+  const F32x8 w = winding.abs();
+  F32x8 coverage;
+  if (fillRule == FillRule::Winding) {
+    coverage = w.min(one);
+  } else {
+    const F32x8 two = F32x8::splat(2.0f);
+    const F32x8 folded = w - two * (w * F32x8::splat(0.5f)).floor();
+    coverage = folded.min(two - folded);
+  }
+  return (coverage * F32x8::splat(255.0f) + F32x8::splat(0.5f)).lanes;
+}
+
+/// Collects one pixel row of coverage as runs of equal alpha, then hands it to the blitter the
+/// way path_aa's AdditiveBlitter does: blitH for full coverage and blitAntiH2 for single partial
+/// pixels, whose solid-color fast paths skip the pipeline. Only longer partial runs, such as
+/// the row under a horizontal edge, go through blitAntiH.
+class RowRuns {
+ public:
+  explicit RowRuns(std::size_t capacity) : alpha_(capacity + 1), runs_(capacity + 1) {}
+
+  void reset() {
+    count_ = 0;
+    lastRun_ = 0;
+  }
+
+  /// Appends \p length pixels of \p alpha, merging with the previous run when equal. Leading
+  /// transparent pixels are skipped, so the row starts at its first covered pixel.
+  void append(std::uint32_t x, std::uint32_t length, AlphaU8 alpha) {
+    if (count_ == 0) {
+      if (alpha == 0) {
+        return;
+      }
+      startX_ = x;
+    } else if (alpha_[lastRun_] == alpha) {
+      runs_[lastRun_] = static_cast<std::uint16_t>(*runs_[lastRun_] + length);
+      count_ += length;
+      return;
+    }
+    lastRun_ = count_;
+    alpha_[count_] = alpha;
+    runs_[count_] = static_cast<std::uint16_t>(length);
+    count_ += length;
+  }
+
+  void flush(std::uint32_t y, Blitter& blitter) {
+    std::size_t i = 0;
+    while (i < count_) {
+      const auto x = startX_ + static_cast<std::uint32_t>(i);
+      const std::size_t length = *runs_[i];
+      const AlphaU8 alpha = alpha_[i];
+      if (alpha == 0xFF) {
+        blitter.blitH(x, y, static_cast<LengthU32>(length));
+      } else if (length > 2) {
+        std::array<std::uint8_t, 1> runAlpha = {alpha};
+        std::array<AlphaRun, 2> run = {static_cast<std::uint16_t>(length), std::nullopt};
+        blitter.blitAntiH(x, y, runAlpha, run);
+      } else if (alpha != 0) {
+        // Pair with the next pixel when it is partial as well.
+        AlphaU8 next = length == 2 ? alpha : 0;
+        std::size_t consumed = length;
+        if (length == 1 && i + 1 < count_ && *runs_[i + 1] == 1 && alpha_[i + 1] != 0xFF) {
+          next = alpha_[i + 1];
+          consumed = 2;
+        }
+        blitter.blitAntiH2(x, y, alpha, next);
+        i += consumed;
+        continue;
+      }
+      i += length;
+    }
+    reset();
+  }
+
+ private:
+  std::vector<std::uint8_t> alpha_;
+  std::vector<AlphaRun> runs_;
+  std::uint32_t startX_ = 0;
+  std::size_t count_ = 0;
+  std::size_t lastRun_ = 0;
+};
+
+/// Part of a line within one pixel row of a tile.
+struct RowSegment {
+  const Line* line;
+  float lo;
+  float hi;
+};
+
+/// The lines of one chain active in one pixel row of a tile.
+struct ChainSpan {
+  std::uint32_t chain = kNoChain;
+  float winding = 0.0f;
+  /// Extent in y, and the summed height of the lines, which falls short of it if the chain
+  /// leaves the tile and comes back.
+  float lo = 0.0f;
+  float hi = 0.0f;
+  float height = 0.0f;
+  /// Extent in x.
+  float left = 0.0f;
+  float right = 0.0f;
+
+  [[nodiscard]] bool contiguous() const {
+    // Lines of a chain meet at shared points, so only rounding separates the two.
+    return height >= hi - lo - 1.0f / 65536.0f;
+  }
+};
+
+/// Summary of the lines active in one pixel row of a tile: how many, and the extents of the
+/// first two chains among them.
+struct RowLines {
+  std::uint32_t count = 0;
+  std::array<ChainSpan, 2> chains;
+  /// Set if a third chain is active.
+  bool more = false;
+
+  void add(const Line& line, float lo, float hi, float xa, float xb) {
+    ++count;
+    for (ChainSpan& span : chains) {
+      if (span.chain == kNoChain) {
+        span = ChainSpan{line.chain, line.winding, lo, hi, hi - lo, std::min(xa, xb),
+                         std::max(xa, xb)};
+        return;
+      }
+      if (span.chain == line.chain) {
+        span.lo = std::min(span.lo, lo);
+        span.hi = std::max(span.hi, hi);
+        span.height += hi - lo;
+        span.left = std::min({span.left, xa, xb});
+        span.right = std::max({span.right, xa, xb});
+        return;
+      }
+    }
+    more = true;
+  }
+};
+
+using TileRows = std::array<RowLines, scan::sparse_strips::kTileSize>;
+
+/// Accumulates the signed area \p line covers in each pixel of the tile at (\p tileX,
+/// \p tileY) into \p acc, and adds it to \p rows for each pixel row it is active in.
+void accumulateLine(const Line& line, float tileX, float tileY, std::array<F32x8, 2>& acc,
+                    TileRows& rows) {
+  constexpr std::int32_t kTileSize = scan::sparse_strips::kTileSize;
+
+  // Per pixel row: the line's x where it enters and leaves the row, relative to the tile, the
+  // signed height it spans, and whether it is treated as vertical.
+  std::array<float, kTileSize> xa{};
+  std::array<float, kTileSize> xb{};
+  std::array<float, kTileSize> height{};
+  std::array<float, kTileSize> invDx{};
+  std::array<float, kTileSize> vertical{};
+  for (std::int32_t r = 0; r < kTileSize; ++r) {
+    const float rowTop = tileY + static_cast<float>(r);
+    const float lo = std::max(line.y0, rowTop);
+    const float hi = std::min(line.y1, rowTop + 1.0f);
+    if (!(hi > lo)) {
+      continue;
+    }
+
+    const float a = line.xAt(lo) - tileX;
+    const float b = line.xAt(hi) - tileX;
+    height[r] = (hi - lo) * line.winding;
+    rows[r].add(line, lo, hi, a, b);
+    if (std::abs(b - a) < kVerticalEpsilon) {
+      xa[r] = xb[r] = 0.5f * (a + b);
+      vertical[r] = 1.0f;
+    } else {
+      xa[r] = a;
+      xb[r] = b;
+      invDx[r] = 1.0f / (b - a);
+    }
+  }
+
+  // Pixel column c covers [c, c + 1). Its coverage from a segment running from xa to xb is the
+  // average over the segment of clamp(c + 1 - x, 0, 1), which integrates to
+  // (F(c + 1 - xa) - F(c + 1 - xb)) / (xb - xa) with F(u) = clamp(u)^2 / 2 + max(u - 1, 0).
+  const F32x8 zero = F32x8::splat(0.0f);
+  const F32x8 one = F32x8::splat(1.0f);
+  const F32x8 half = F32x8::splat(0.5f);
+  const F32x8 columnRight{{1.0f, 2.0f, 3.0f, 4.0f, 1.0f, 2.0f, 3.0f, 4.0f}};
+  const auto integral = [&](const F32x8& u) {
+    const F32x8 c = u.max(zero).min(one);
+    return c * c * half + (u - one).max(zero);
+  };
+
+  for (std::int32_t v = 0; v < kRowsPerVector; ++v) {
+    const std::int32_t r0 = v * kRowsPerVector;
+    const std::int32_t r1 = r0 + 1;
+    if (height[r0] == 0.0f && height[r1] == 0.0f) {
+      continue;
+    }
+
+    const auto perRow = [r0, r1](const std::array<float, kTileSize>& values) {
+      return F32x8::rows(values[r0], values[r1]);
+    };
+
+    const F32x8 ua = columnRight - perRow(xa);
+    const F32x8 ub = columnRight - perRow(xb);
+    const F32x8 sloped = (integral(ua) - integral(ub)) * perRow(invDx);
+    const F32x8 straight = ua.max(zero).min(one) * perRow(vertical);
+    acc[v] = acc[v] + (sloped + straight) * perRow(height);
+  }
+}
+
+/// Scalar form of accumulateLine's per-pixel term: the area of pixel column [c, c + 1), with
+/// \p columnRight = c + 1, that lies right of a segment running from \p xa to \p xb over
+/// \p height rows.
+float areaRightOf(float xa, float xb, float height, float columnRight) {
+  const auto integral = [](float u) {
+    const float c = std::clamp(u, 0.0f, 1.0f);
+    return c * c * 0.5f + std::max(u - 1.0f, 0.0f);
+  };
+  if (std::abs(xb - xa) < kVerticalEpsilon) {
+    return height * std::clamp(columnRight - 0.5f * (xa + xb), 0.0f, 1.0f);
+  }
+  return height * (integral(columnRight - xa) - integral(columnRight - xb)) / (xb - xa);
+}
+
+/// Winding of one pixel row left of the current tile, from the lines already passed. It is a
+/// step function of y: lines that end partway down the row add a step where they end. The
+/// steps of two lines meeting at a vertex cancel, so there are rarely any left.
+class RowBackdrop {
+ public:
+  void reset(float rowTop) {
+    rowTop_ = rowTop;
+    top_ = 0.0f;
+    average_ = 0.0f;
+    steps_.clear();
+    chain_ = kNoChain;
+    pendingChain_ = kNoChain;
+  }
+
+  /// Adds \p line, spanning [\p lo, \p hi] of the row. A line continuing the previous one's
+  /// chain only extends it, so the pair of steps where they meet is never stored. Call flush()
+  /// before reading the backdrop.
+  void add(const Line& line, float lo, float hi) {
+    if (line.chain == pendingChain_ && (lo == pendingHi_ || hi == pendingLo_)) {
+      pendingLo_ = std::min(pendingLo_, lo);
+      pendingHi_ = std::max(pendingHi_, hi);
+      return;
+    }
+    flush();
+    pendingChain_ = line.chain;
+    pendingWinding_ = line.winding;
+    pendingLo_ = lo;
+    pendingHi_ = hi;
+  }
+
+  void flush() {
+    if (pendingChain_ == kNoChain) {
+      return;
+    }
+    const float winding = pendingWinding_;
+    const float lo = pendingLo_;
+    const float hi = pendingHi_;
+    average_ += (hi - lo) * winding;
+    if (lo != rowTop_ || hi != rowTop_ + 1.0f) {
+      chain_ = steps_.empty() || chain_ == pendingChain_ ? pendingChain_ : kNoChain;
+    }
+    pendingChain_ = kNoChain;
+    if (lo == rowTop_) {
+      top_ += winding;
+    } else {
+      addStep(lo, winding);
+    }
+    if (hi != rowTop_ + 1.0f) {
+      addStep(hi, -winding);
+    }
+  }
+
+  /// Winding averaged over the row's height.
+  [[nodiscard]] float average() const { return average_; }
+
+  /// True if the winding is the same all the way down the row.
+  [[nodiscard]] bool uniform() const { return steps_.empty(); }
+
+  /// The chain of every line behind the steps, if they all come from one.
+  [[nodiscard]] std::optional<std::uint32_t> stepChain() const {
+    return chain_ == kNoChain ? std::nullopt : std::optional(chain_);
+  }
+
+  /// Lowest and highest winding anywhere in the row.
+  [[nodiscard]] std::pair<float, float> range() const {
+    float winding = top_;
+    float lowest = winding;
+    float highest = winding;
+    for (const auto& [stepY, delta] : steps_) {
+      winding += delta;
+      lowest = std::min(lowest, winding);
+      highest = std::max(highest, winding);
+    }
+    return {lowest, highest};
+  }
+
+  /// Winding at \p y, which must not be on a step.
+  [[nodiscard]] float at(float y) const {
+    float winding = top_;
+    for (const auto& [stepY, delta] : steps_) {
+      if (stepY > y) {
+        break;
+      }
+      winding += delta;
+    }
+    return winding;
+  }
+
+  [[nodiscard]] std::span<const std::pair<float, float>> steps() const { return steps_; }
+
+  /// Coverage of the row under \p fillRule, applied to the winding between each pair of steps.
+  [[nodiscard]] float coverage(FillRule fillRule) const {
+    if (steps_.empty()) {
+      return windingToCoverage(top_, fillRule);
+    }
+    float result = 0.0f;
+    float winding = top_;
+    float y = rowTop_;
+    for (const auto& [stepY, delta] : steps_) {
+      result += windingToCoverage(winding, fillRule) * (stepY - y);
+      winding += delta;
+      y = stepY;
+    }
+    return result + windingToCoverage(winding, fillRule) * (rowTop_ + 1.0f - y);
+  }
+
+ private:
+  void addStep(float y, float delta) {
+    // Rows rarely hold more than a couple of steps, and the two steps where consecutive lines
+    // meet cancel, so a linear scan beats a binary search and vector insert here.
+    std::size_t i = 0;
+    while (i < steps_.size() && steps_[i].first < y) {
+      ++i;
+    }
+    if (i < steps_.size() && steps_[i].first == y) {
+      steps_[i].second += delta;
+      if (steps_[i].second == 0.0f) {
+        for (; i + 1 < steps_.size(); ++i) {
+          steps_[i] = steps_[i + 1];
+        }
+        steps_.pop_back();
+      }
+      return;
+    }
+    steps_.emplace_back();
+    for (std::size_t j = steps_.size() - 1; j > i; --j) {
+      steps_[j] = steps_[j - 1];
+    }
+    steps_[i] = {y, delta};
+  }
+
+  float rowTop_ = 0.0f;
+  float top_ = 0.0f;
+  float average_ = 0.0f;
+  std::uint32_t chain_ = kNoChain;
+  /// Span of consecutive lines of one chain not yet added.
+  std::uint32_t pendingChain_ = kNoChain;
+  float pendingWinding_ = 0.0f;
+  float pendingLo_ = 0.0f;
+  float pendingHi_ = 0.0f;
+  /// (y, winding change) sorted by y, strictly inside the row.
+  std::vector<std::pair<float, float>> steps_;
+};
+
+/// Computes the coverage of one pixel row of a tile with the fill rule applied to the exact
+/// winding, for rows where averaging first would be wrong. Keeps its scratch buffers between
+/// rows.
+class ExactRow {
+ public:
+  /// Returns true if the averaged coverage is exact for the usual rows, judging only from the
+  /// summary of the row's lines. The most common is one contour passing through, where every
+  /// line of the row, and every line behind a backdrop step, is from one chain. At most one of
+  /// them is active at any height, so the winding is the backdrop's base or one step past it.
+  static bool chainIsExact(const RowLines& lines, const RowBackdrop& backdrop,
+                           FillRule fillRule) {
+    const auto [lowest, highest] = backdrop.range();
+    if (lines.count == 0) {
+      return onOnePiece(lowest, highest, fillRule);
+    }
+    const ChainSpan& first = lines.chains[0];
+    const ChainSpan& second = lines.chains[1];
+    if (second.chain == kNoChain) {
+      if (!backdrop.uniform() && backdrop.stepChain() != first.chain) {
+        return false;
+      }
+      const float base = first.winding > 0.0f ? lowest : highest;
+      return onOnePiece(std::min(base, base + first.winding),
+                        std::max(base, base + first.winding), fillRule);
+    }
+
+    // Two chains of opposite winding, one left of the other, as at the top or bottom of a
+    // shape. If the right one is only active where the left one is, the winding steps one way
+    // across the left chain and back across the right, and never goes past the backdrop the
+    // other way.
+    if (lines.more || !backdrop.uniform() || first.winding == second.winding) {
+      return false;
+    }
+    const bool firstLeft = first.right <= second.left;
+    if (!firstLeft && second.right > first.left) {
+      return false;
+    }
+    const ChainSpan& left = firstLeft ? first : second;
+    const ChainSpan& right = firstLeft ? second : first;
+    if (!left.contiguous() || right.lo < left.lo || right.hi > left.hi) {
+      return false;
+    }
+    return onOnePiece(std::min(lowest, lowest + left.winding),
+                      std::max(lowest, lowest + left.winding), fillRule);
+  }
+
+  /// Gathers the parts of the lines of \p tileKeys within the row [\p rowTop, \p rowTop + 1).
+  std::span<const RowSegment> collect(std::span<const std::uint64_t> tileKeys,
+                                      const std::vector<Line>& lines, float rowTop) {
+    segments_.clear();
+    for (const std::uint64_t key : tileKeys) {
+      const Line& line = lines[tileKeyLine(key)];
+      const float lo = std::max(line.y0, rowTop);
+      const float hi = std::min(line.y1, rowTop + 1.0f);
+      if (hi > lo) {
+        segments_.push_back(RowSegment{&line, lo, hi});
+      }
+    }
+    return segments_;
+  }
+
+  /// Returns true if the averaged coverage of the row is already exact: at every height in the
+  /// row, the windings between the lines, taken left to right, stay on one linear piece of
+  /// \p fillRule. That holds for most rows chainIsExact turns down: the two sides of a thin
+  /// shape or of a vertex at its top or bottom, or a backdrop step continued by a line of
+  /// another chain.
+  bool averageIsExact(std::span<const RowSegment> segments, const RowBackdrop& backdrop,
+                      float rowTop, FillRule fillRule) {
+    // Without ordering the lines per strip, it is enough to know that every line of one
+    // winding is left of every line of the other, as for the two sides of a shape near its top
+    // or bottom. Going right, the winding then moves one way across the left group and back
+    // across the right group, whatever the order within each group.
+    float minUp = kNoX;
+    float maxUp = -kNoX;
+    float minDown = kNoX;
+    float maxDown = -kNoX;
+    for (const RowSegment& segment : segments) {
+      const float xa = segment.line->xAt(segment.lo);
+      const float xb = segment.line->xAt(segment.hi);
+      if (segment.line->winding > 0.0f) {
+        minDown = std::min({minDown, xa, xb});
+        maxDown = std::max({maxDown, xa, xb});
+      } else {
+        minUp = std::min({minUp, xa, xb});
+        maxUp = std::max({maxUp, xa, xb});
+      }
+    }
+    const bool downLeft = maxDown <= minUp;
+    if (downLeft || maxUp <= minDown) {
+      // Sweep down the row, tracking the backdrop and the winding of each group.
+      const float leftWinding = downLeft ? 1.0f : -1.0f;
+      events_.clear();
+      for (const auto& [stepY, delta] : backdrop.steps()) {
+        events_.push_back({stepY, delta, 0.0f, 0.0f});
+      }
+      for (const RowSegment& segment : segments) {
+        const float winding = segment.line->winding;
+        const float left = winding == leftWinding ? winding : 0.0f;
+        const float right = winding - left;
+        events_.push_back({segment.lo, 0.0f, left, right});
+        events_.push_back({segment.hi, 0.0f, -left, -right});
+      }
+      std::sort(events_.begin(), events_.end(),
+                [](const Event& a, const Event& b) { return a.y < b.y; });
+
+      float backdropWinding = backdrop.at(rowTop);
+      float left = 0.0f;
+      float right = 0.0f;
+      float lowest = backdropWinding;
+      float highest = backdropWinding;
+      for (std::size_t k = 0; k < events_.size();) {
+        const float y = events_[k].y;
+        for (; k < events_.size() && events_[k].y == y; ++k) {
+          backdropWinding += events_[k].backdrop;
+          left += events_[k].left;
+          right += events_[k].right;
+        }
+        if (y >= rowTop + 1.0f) {
+          break;
+        }
+        const float afterLeft = backdropWinding + left;
+        const float afterRight = afterLeft + right;
+        lowest = std::min({lowest, backdropWinding, afterLeft, afterRight});
+        highest = std::max({highest, backdropWinding, afterLeft, afterRight});
+      }
+      if (onOnePiece(lowest, highest, fillRule)) {
+        return true;
+      }
+    }
+
+    // Otherwise order the active lines in each strip between line ends.
+    cuts_.clear();
+    cuts_.push_back(rowTop);
+    cuts_.push_back(rowTop + 1.0f);
+    for (const auto& [stepY, delta] : backdrop.steps()) {
+      cuts_.push_back(stepY);
+    }
+    for (const RowSegment& segment : segments) {
+      cuts_.push_back(segment.lo);
+      cuts_.push_back(segment.hi);
+    }
+    std::sort(cuts_.begin(), cuts_.end());
+
+    float lowest = 0.0f;
+    float highest = 0.0f;
+    bool first = true;
+    for (std::size_t k = 0; k + 1 < cuts_.size(); ++k) {
+      const float ya = cuts_[k];
+      const float yb = cuts_[k + 1];
+      if (!(yb > ya)) {
+        continue;
+      }
+      const float mid = 0.5f * (ya + yb);
+      sortActive(segments, mid);
+      float winding = backdrop.at(mid);
+      lowest = first ? winding : std::min(lowest, winding);
+      highest = first ? winding : std::max(highest, winding);
+      first = false;
+      for (std::size_t j = 0; j < active_.size(); ++j) {
+        const Line& line = *active_[j].second;
+        // Lines crossing within the strip change order, which only the exact pass handles.
+        if (j > 0) {
+          const Line& prev = *active_[j - 1].second;
+          if (prev.xAt(ya) > line.xAt(ya) || prev.xAt(yb) > line.xAt(yb)) {
+            return false;
+          }
+        }
+        winding += line.winding;
+        lowest = std::min(lowest, winding);
+        highest = std::max(highest, winding);
+      }
+    }
+    return onOnePiece(lowest, highest, fillRule);
+  }
+
+  /// Coverage of the tile's pixels in the row [\p rowTop, \p rowTop + 1), given the row's
+  /// \p backdrop at \p tileX and every line of the tile that is active in the row.
+  std::array<float, scan::sparse_strips::kTileSize> coverage(std::span<const RowSegment> segments,
+                                                             const RowBackdrop& backdrop,
+                                                             float rowTop, float tileX,
+                                                             FillRule fillRule) {
+    constexpr std::int32_t kTileSize = scan::sparse_strips::kTileSize;
+
+    // Cut the row wherever the set of active lines, their order, or the backdrop changes.
+    cuts_.clear();
+    cuts_.push_back(rowTop);
+    cuts_.push_back(rowTop + 1.0f);
+    for (const auto& [stepY, delta] : backdrop.steps()) {
+      cuts_.push_back(stepY);
+    }
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+      const RowSegment& a = segments[i];
+      cuts_.push_back(a.lo);
+      cuts_.push_back(a.hi);
+      for (std::size_t j = i + 1; j < segments.size(); ++j) {
+        const RowSegment& b = segments[j];
+        const float lo = std::max(a.lo, b.lo);
+        const float hi = std::min(a.hi, b.hi);
+        if (!(hi > lo)) {
+          continue;
+        }
+        const float dLo = a.line->xAt(lo) - b.line->xAt(lo);
+        const float dHi = a.line->xAt(hi) - b.line->xAt(hi);
+        if ((dLo < 0.0f && dHi > 0.0f) || (dLo > 0.0f && dHi < 0.0f)) {
+          cuts_.push_back(lo + (hi - lo) * (dLo / (dLo - dHi)));
+        }
+      }
+    }
+    std::sort(cuts_.begin(), cuts_.end());
+
+    std::array<float, kTileSize> result{};
+    for (std::size_t k = 0; k + 1 < cuts_.size(); ++k) {
+      const float ya = cuts_[k];
+      const float yb = cuts_[k + 1];
+      if (!(yb > ya)) {
+        continue;
+      }
+
+      // Within the strip no line starts, ends or crosses another, so walking the lines left to
+      // right gives the integer winding of every gap between them. Each line then contributes
+      // the area right of it, weighted by how much it changes the covered fraction.
+      const float mid = 0.5f * (ya + yb);
+      sortActive(segments, mid);
+
+      const float height = yb - ya;
+      float winding = backdrop.at(mid);
+      float covered = windingToCoverage(winding, fillRule);
+      for (std::int32_t c = 0; c < kTileSize; ++c) {
+        result[c] += covered * height;
+      }
+      for (const auto& [x, line] : active_) {
+        winding += line->winding;
+        const float next = windingToCoverage(winding, fillRule);
+        const float change = next - covered;
+        covered = next;
+        if (change == 0.0f) {
+          continue;
+        }
+        const float xa = line->xAt(ya) - tileX;
+        const float xb = line->xAt(yb) - tileX;
+        for (std::int32_t c = 0; c < kTileSize; ++c) {
+          result[c] += change * areaRightOf(xa, xb, height, static_cast<float>(c + 1));
+        }
+      }
+    }
+    return result;
+  }
+
+ private:
+  /// Returns true if every winding in [\p lowest, \p highest] is on one linear piece of
+  /// \p fillRule, so averaging them before applying the rule is exact.
+  static bool onOnePiece(float lowest, float highest, FillRule fillRule) {
+    if (highest - lowest <= 1.0f) {
+      return true;
+    }
+    // Nonzero covers every winding of at least 1 in magnitude fully.
+    return fillRule == FillRule::Winding && (lowest >= 1.0f || highest <= -1.0f);
+  }
+
+  /// Fills active_ with the lines of \p segments active at \p y, ordered by x there.
+  void sortActive(std::span<const RowSegment> segments, float y) {
+    // Insertion sort: rarely more than a few lines are active at once.
+    active_.clear();
+    for (const RowSegment& segment : segments) {
+      if (segment.lo < y && segment.hi > y) {
+        const float x = segment.line->xAt(y);
+        active_.emplace_back(x, segment.line);
+        std::size_t j = active_.size() - 1;
+        for (; j > 0 && active_[j - 1].first > x; --j) {
+          active_[j] = active_[j - 1];
+        }
+        active_[j] = {x, segment.line};
+      }
+    }
+  }
+
+  /// Where the backdrop or a group's winding changes going down the row.
+  struct Event {
+    float y;
+    float backdrop;
+    float left;
+    float right;
+  };
+
+  std::vector<RowSegment> segments_;
+  std::vector<Event> events_;
+  std::vector<float> cuts_;
+  std::vector<std::pair<float, const Line*>> active_;
+};
+
+}  // namespace
+
+namespace scan {
+namespace sparse_strips {
+
+void fillPath(const Path& path, FillRule fillRule, const ScreenIntRect& clip, Blitter& blitter) {
+  const auto boundsOpt = path.bounds().roundOut();
+  if (!boundsOpt) return;
+
+  const auto clipped = boundsOpt->intersect(clip.toIntRect());
+  if (!clipped) return;
+
+  if (clip.right() > 32767 || clip.bottom() > 32767) return;
+
+  LineBuilder builder(clip);
+  builder.reserve(path.points().size() * 2);
+  auto iter = pathIter(path);
+  while (auto edge = iter.next()) {
+    builder.addEdge(*edge);
+  }
+
+  const std::vector<Line>& lines = builder.lines();
+  if (lines.empty()) {
+    return;
+  }
+
+  std::vector<std::uint64_t> tiles;
+  tiles.reserve(lines.size() * 2);
+  for (std::size_t i = 0; i < lines.size(); ++i) {
+    binLine(lines[i], static_cast<std::uint32_t>(i), tiles);
+  }
+  sortTiles(tiles, (clip.bottom() + kTileSize - 1) / kTileSize);
+
+  const std::uint32_t clipLeft = clip.left();
+  const std::uint32_t clipRight = clip.right();
+  const std::uint32_t clipTop = clip.top();
+  const std::uint32_t clipBottom = clip.bottom();
+
+  std::array<RowRuns, kTileSize> rows = {
+      RowRuns(clip.width()), RowRuns(clip.width()), RowRuns(clip.width()), RowRuns(clip.width())};
+  std::array<RowBackdrop, kTileSize> backdrops;
+  TileRows tileRows;
+  ExactRow exactRow;
+
+  std::size_t i = 0;
+  while (i < tiles.size()) {
+    const std::uint32_t tileY = tileKeyY(tiles[i]);
+    const std::uint32_t rowTop = tileY * kTileSize;
+    for (std::int32_t r = 0; r < kTileSize; ++r) {
+      backdrops[r].reset(static_cast<float>(rowTop + static_cast<std::uint32_t>(r)));
+    }
+    std::uint32_t nextX = clipLeft;
+
+    // Covers [nextX, end) of every row with the backdrop's coverage.
+    const auto fillGap = [&](std::uint32_t end) {
+      if (end <= nextX) {
+        return;
+      }
+      for (std::int32_t r = 0; r < kTileSize; ++r) {
+        rows[r].append(nextX, end - nextX, coverageToAlpha(backdrops[r].coverage(fillRule)));
+      }
+      nextX = end;
+    };
+
+    while (i < tiles.size() && tileKeyY(tiles[i]) == tileY) {
+      const std::uint32_t tileX = tileKeyX(tiles[i]);
+      const std::uint32_t tileLeft = tileX * kTileSize;
+      fillGap(std::min(std::max(tileLeft, clipLeft), clipRight));
+
+      std::array<F32x8, 2> acc = {F32x8::rows(backdrops[0].average(), backdrops[1].average()),
+                                  F32x8::rows(backdrops[2].average(), backdrops[3].average())};
+      tileRows = {};
+      const std::size_t tileBegin = i;
+      for (; i < tiles.size() && tileKeyX(tiles[i]) == tileX && tileKeyY(tiles[i]) == tileY;
+           ++i) {
+        accumulateLine(lines[tileKeyLine(tiles[i])], static_cast<float>(tileLeft),
+                       static_cast<float>(rowTop), acc, tileRows);
+      }
+      const std::span<const std::uint64_t> tileKeys(tiles.data() + tileBegin, i - tileBegin);
+
+      const std::uint32_t begin = std::max(tileLeft, nextX);
+      const std::uint32_t end = std::min(tileLeft + kTileSize, clipRight);
+      if (begin < end) {
+        for (std::int32_t v = 0; v < kRowsPerVector; ++v) {
+          std::array<float, 8> alpha = windingToAlpha(acc[v], fillRule);
+          for (std::int32_t row = 0; row < kRowsPerVector; ++row) {
+            const std::int32_t r = v * kRowsPerVector + row;
+            // One line over a uniform backdrop only ever separates two adjacent windings, so
+            // the averaged coverage is already exact.
+            const RowBackdrop& backdrop = backdrops[r];
+            if ((tileRows[r].count > 1 || !backdrop.uniform()) &&
+                !ExactRow::chainIsExact(tileRows[r], backdrop, fillRule)) {
+              const auto y = static_cast<float>(rowTop + static_cast<std::uint32_t>(r));
+              const std::span<const RowSegment> segments = exactRow.collect(tileKeys, lines, y);
+              if (!exactRow.averageIsExact(segments, backdrop, y, fillRule)) {
+                const auto coverage = exactRow.coverage(segments, backdrop, y,
+                                                        static_cast<float>(tileLeft), fillRule);
+                for (std::int32_t c = 0; c < kTileSize; ++c) {
+                  alpha[row * kTileSize + c] =
+                      std::clamp(coverage[c], 0.0f, 1.0f) * 255.0f + 0.5f;
+                }
+              }
+            }
+
+            RowRuns& runs = rows[r];
+            for (std::uint32_t x = begin; x < end; ++x) {
+              runs.append(x, 1, static_cast<AlphaU8>(alpha[row * kTileSize + (x - tileLeft)]));
+            }
+          }
+        }
+        nextX = end;
+      }
+
+      for (const std::uint64_t key : tileKeys) {
+        if (!tileKeyLast(key)) {
+          continue;
+        }
+        const Line& line = lines[tileKeyLine(key)];
+        for (std::int32_t r = 0; r < kTileSize; ++r) {
+          const auto y = static_cast<float>(rowTop + static_cast<std::uint32_t>(r));
+          const float lo = std::max(line.y0, y);
+          const float hi = std::min(line.y1, y + 1.0f);
+          if (hi > lo) {
+            backdrops[r].add(line, lo, hi);
+          }
+        }
+      }
+      for (RowBackdrop& backdrop : backdrops) {
+        backdrop.flush();
+      }
+    }
+
+    // Winding left over here comes from edges right of the clip, which were dropped. A
+    // transparent remainder is left out rather than blitted.
+    if (nextX < clipRight) {
+      for (std::int32_t r = 0; r < kTileSize; ++r) {
+        const AlphaU8 alpha = coverageToAlpha(backdrops[r].coverage(fillRule));
+        if (alpha != 0) {
+          rows[r].append(nextX, clipRight - nextX, alpha);
+        }
+      }
+    }
+
+    for (std::int32_t r = 0; r < kTileSize; ++r) {
+      const std::uint32_t y = rowTop + static_cast<std::uint32_t>(r);
+      if (y >= clipTop && y < clipBottom) {
+        rows[r].flush(y, blitter);
+      } else {
+        rows[r].reset();
+      }
+    }
+  }
+}
+
+}  // namespace sparse_strips
+}  // namespace scan
+
+}  // namespace tiny_skia
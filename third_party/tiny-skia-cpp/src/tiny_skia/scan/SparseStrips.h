@@ -0,0 +1,55 @@
+#pragma once
+
+/// @file SparseStrips.h
+/// @brief Sparse-strip coverage rasterizer, an alternative to the analytic (AAA) scan converter.
+///
+/// The path is flattened to lines and each line is binned into the 4x4 pixel tiles it crosses.
+/// After sorting the tiles by row and column, every tile that holds an edge gets exact area
+/// coverage computed eight pixels at a time, and the stretches between edge tiles are resolved
+/// from the accumulated winding as solid spans. Only tiles that an edge passes through cost
+/// per-pixel work, so large flat interiors are as cheap as with AAA while paths with many short
+/// curved segments avoid AAA's per-scanline edge walking.
+///
+/// Coverage is the exact area of each pixel inside the flattened path, which is not
+/// bit-identical to AAA. @see kMaxCoverageDifference.
+
+#include <cstdint>
+
+#include "tiny_skia/Blitter.h"
+#include "tiny_skia/Geom.h"
+#include "tiny_skia/Path.h"
+
+namespace tiny_skia {
+
+namespace scan {
+namespace sparse_strips {
+
+/// Width and height, in pixels, of the tiles edges are binned into.
+constexpr std::int32_t kTileSize = 4;
+
+/// Curves are flattened until no point is further than this from the curve, in pixels.
+constexpr float kFlattenTolerance = 0.1f;
+
+/// Largest per-pixel difference from the true area of the path, in 1/255 steps, for any path
+/// under either fill rule, including self-overlapping ones. Pixels are accumulated as signed
+/// area, and where overlapping edges put windings from different pieces of the fill rule into
+/// one pixel, the fill rule is applied to each winding rather than to their average, so the only
+/// error left is flattening: a line moves at most kFlattenTolerance from the curve, which
+/// changes a pixel's area by at most kFlattenTolerance times the length of the line inside it,
+/// under sqrt(2). That is 36 steps, plus one for rounding.
+///
+/// The difference from path_aa::fillPath is larger: AAA approximates the area with fixed-point
+/// trapezoids per scanline and is itself up to about 90 steps off on shallow edges, tight curves
+/// and overlapping edges. The two agree exactly on pixel-aligned edges.
+constexpr int kMaxCoverageDifference = 37;
+
+/// Fills \p path into \p blitter, clipped to \p clip.
+///
+/// Drives the blitter the same way path_aa::fillPath does: fully covered runs go to blitH and
+/// everything else to blitAntiH, one call per pixel row of each tile row.
+void fillPath(const Path& path, FillRule fillRule, const ScreenIntRect& clip, Blitter& blitter);
+
+}  // namespace sparse_strips
+}  // namespace scan
+
+}  // namespace tiny_skia
@@ -1,6 +1,7 @@
 #include "tiny_skia/shaders/Gradient.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "tiny_skia/Math.h"
 
@@ -147,6 +148,7 @@ bool Gradient::pushStages(
   }
 
   // Two-stop optimization.
+  const bool usesLut = stops_.size() != 2 && lutMatches(cs);
   if (stops_.size() == 2) {
     const auto c0 = expandColor(cs, stops_[0].color);
     const auto c1 = expandColor(cs, stops_[1].color);
@@ -157,74 +159,148 @@ bool Gradient::pushStages(
         .bias = pipeline::GradientColor{c0.red(), c0.green(), c0.blue(), c0.alpha()}};
 
     p.push(Stage::EvenlySpaced2StopGradient);
+  } else if (usesLut) {
+    p.ctx().gradientLut = pipeline::GradientLutCtx{
+        .colors = lut_->colors.data(),
+        .colorsU16 = lut_->colorsU16.data(),
+    };
+    p.push(Stage::GradientLut);
   } else {
-    pipeline::Context::GradientCtx ctx;
-
-    ctx.factors.reserve(std::max(stops_.size() + 1, std::size_t{16}));
-    ctx.biases.reserve(std::max(stops_.size() + 1, std::size_t{16}));
-    ctx.tValues.reserve(stops_.size() + 1);
-
-    // Remove dummy stops for the search (matching Rust logic).
-    std::size_t firstStop, lastStop;
-    if (stops_.size() > 2) {
-      firstStop = (stops_[0].color != stops_[1].color) ? 0 : 1;
-      const auto len = stops_.size();
-      lastStop = (stops_[len - 2].color != stops_[len - 1].color) ? len - 1 : len - 2;
-    } else {
-      firstStop = 0;
-      lastStop = 1;
-    }
+    p.push(Stage::Gradient);
+    p.ctx().gradient = makeGradientCtx(cs);
+  }
 
-    float tL = stops_[firstStop].position.get();
-    auto cL = ([&] {
-      const auto c = expandColor(cs, stops_[firstStop].color);
-      return pipeline::GradientColor{c.red(), c.green(), c.blue(), c.alpha()};
-    }());
-    ctx.pushConstColor(cL);
-    ctx.tValues.push_back(0.0f);
-
-    for (std::size_t i = firstStop; i < lastStop; ++i) {
-      const float tR = stops_[i + 1].position.get();
-      const auto cExpanded = expandColor(cs, stops_[i + 1].color);
-      const auto cR = pipeline::GradientColor{cExpanded.red(), cExpanded.green(), cExpanded.blue(),
-                                              cExpanded.alpha()};
-
-      if (tL < tR) {
-        const float invDt = 1.0f / (tR - tL);
-        const auto f = pipeline::GradientColor{(cR.r - cL.r) * invDt, (cR.g - cL.g) * invDt,
-                                               (cR.b - cL.b) * invDt, (cR.a - cL.a) * invDt};
-        ctx.factors.push_back(f);
-        ctx.biases.push_back(pipeline::GradientColor{cL.r - f.r * tL, cL.g - f.g * tL,
-                                                     cL.b - f.b * tL, cL.a - f.a * tL});
-        ctx.tValues.push_back(bound(0.0f, tL, 1.0f));
-      }
+  // A color table is already premultiplied.
+  if (!colorsAreOpaque_ && !usesLut) {
+    p.push(Stage::Premultiply);
+  }
 
-      tL = tR;
-      cL = cR;
-    }
+  pushStagesPost(p);
 
-    ctx.pushConstColor(cL);
-    ctx.tValues.push_back(bound(0.0f, tL, 1.0f));
+  return true;
+}
+
+pipeline::Context::GradientCtx Gradient::makeGradientCtx(ColorSpace cs) const {
+  pipeline::Context::GradientCtx ctx;
+
+  ctx.factors.reserve(std::max(stops_.size() + 1, std::size_t{16}));
+  ctx.biases.reserve(std::max(stops_.size() + 1, std::size_t{16}));
+  ctx.tValues.reserve(stops_.size() + 1);
 
-    ctx.len = ctx.factors.size();
+  // Remove dummy stops for the search (matching Rust logic).
+  std::size_t firstStop, lastStop;
+  if (stops_.size() > 2) {
+    firstStop = (stops_[0].color != stops_[1].color) ? 0 : 1;
+    const auto len = stops_.size();
+    lastStop = (stops_[len - 2].color != stops_[len - 1].color) ? len - 1 : len - 2;
+  } else {
+    firstStop = 0;
+    lastStop = 1;
+  }
 
-    // Pad to 16 for lowp F32x16 alignment.
-    while (ctx.factors.size() < 16) {
-      ctx.factors.push_back(pipeline::GradientColor{});
-      ctx.biases.push_back(pipeline::GradientColor{});
+  float tL = stops_[firstStop].position.get();
+  auto cL = ([&] {
+    const auto c = expandColor(cs, stops_[firstStop].color);
+    return pipeline::GradientColor{c.red(), c.green(), c.blue(), c.alpha()};
+  }());
+  ctx.pushConstColor(cL);
+  ctx.tValues.push_back(0.0f);
+
+  for (std::size_t i = firstStop; i < lastStop; ++i) {
+    const float tR = stops_[i + 1].position.get();
+    const auto cExpanded = expandColor(cs, stops_[i + 1].color);
+    const auto cR = pipeline::GradientColor{cExpanded.red(), cExpanded.green(), cExpanded.blue(),
+                                            cExpanded.alpha()};
+
+    if (tL < tR) {
+      const float invDt = 1.0f / (tR - tL);
+      const auto f = pipeline::GradientColor{(cR.r - cL.r) * invDt, (cR.g - cL.g) * invDt,
+                                             (cR.b - cL.b) * invDt, (cR.a - cL.a) * invDt};
+      ctx.factors.push_back(f);
+      ctx.biases.push_back(pipeline::GradientColor{cL.r - f.r * tL, cL.g - f.g * tL,
+                                                   cL.b - f.b * tL, cL.a - f.a * tL});
+      ctx.tValues.push_back(bound(0.0f, tL, 1.0f));
     }
 
-    p.push(Stage::Gradient);
-    p.ctx().gradient = std::move(ctx);
+    tL = tR;
+    cL = cR;
   }
 
-  if (!colorsAreOpaque_) {
-    p.push(Stage::Premultiply);
+  ctx.pushConstColor(cL);
+  ctx.tValues.push_back(bound(0.0f, tL, 1.0f));
+
+  ctx.len = ctx.factors.size();
+
+  // Pad to 16 for lowp F32x16 alignment.
+  while (ctx.factors.size() < 16) {
+    ctx.factors.push_back(pipeline::GradientColor{});
+    ctx.biases.push_back(pipeline::GradientColor{});
   }
 
-  pushStagesPost(p);
+  return ctx;
+}
 
-  return true;
+bool Gradient::lutMatches(ColorSpace cs) const {
+  return lut_ != nullptr && lut_->colorSpace == cs && std::ranges::equal(lut_->stops, stops_);
+}
+
+std::shared_ptr<const GradientLut> Gradient::buildLut(ColorSpace cs) const {
+  if (stops_.size() <= 2) {
+    return nullptr;
+  }
+
+  for (std::size_t i = 0; i + 1 < stops_.size(); ++i) {
+    if (stops_[i].position == stops_[i + 1].position && stops_[i].color != stops_[i + 1].color) {
+      return nullptr;
+    }
+  }
+
+  // Evaluate exactly what the Gradient and Premultiply stages would at each sample.
+  const pipeline::Context::GradientCtx ctx = makeGradientCtx(cs);
+
+  // Half a table step may change a component by at most one 8-bit level.
+  constexpr float kLastIndex = static_cast<float>(pipeline::kGradientLutSize - 1);
+  constexpr float kMaximumSlope = 2.0f * kLastIndex / 255.0f;
+  for (std::size_t i = 0; i < ctx.len; ++i) {
+    const pipeline::GradientColor& factor = ctx.factors[i];
+    if (std::max({std::abs(factor.r), std::abs(factor.g), std::abs(factor.b),
+                  std::abs(factor.a)}) > kMaximumSlope) {
+      return nullptr;
+    }
+  }
+
+  auto lut = std::make_shared<GradientLut>();
+  lut->colorSpace = cs;
+  lut->stops = stops_;
+
+  const auto toU8 = [](float v) {
+    return static_cast<std::uint16_t>(bound(0.0f, v, 1.0f) * 255.0f + 0.5f);
+  };
+  for (std::size_t i = 0; i < pipeline::kGradientLutSize; ++i) {
+    const float t = static_cast<float>(i) / kLastIndex;
+    std::size_t index = 0;
+    for (std::size_t s = 1; s < ctx.len; ++s) {
+      if (t >= ctx.tValues[s]) {
+        index += 1;
+      }
+    }
+    const auto& factor = ctx.factors[index];
+    const auto& bias = ctx.biases[index];
+    const pipeline::GradientColor color{t * factor.r + bias.r, t * factor.g + bias.g,
+                                        t * factor.b + bias.b, t * factor.a + bias.a};
+
+    lut->colors[i] = pipeline::GradientColor{color.r * color.a, color.g * color.a,
+                                             color.b * color.a, color.a};
+
+    // Lowp rounds the unpremultiplied color to 8 bits and then premultiplies with div255.
+    const std::uint16_t alpha = toU8(color.a);
+    const auto premultiply = [alpha](std::uint16_t v) {
+      return static_cast<std::uint16_t>(((v * alpha + 128) * 257) >> 16);
+    };
+    lut->colorsU16[i] = {premultiply(toU8(color.r)), premultiply(toU8(color.g)),
+                         premultiply(toU8(color.b)), alpha};
+  }
+  return lut;
 }
 
 void Gradient::applyOpacity(float opacity) {
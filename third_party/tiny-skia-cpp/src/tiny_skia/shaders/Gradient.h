@@ -3,8 +3,11 @@
 /// @file shaders/Gradient.h
 /// @brief Base gradient data and gradient stop type.
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <span>
 #include <vector>
 
@@ -30,6 +33,30 @@ struct GradientStop {
   friend bool operator==(const GradientStop&, const GradientStop&) = default;
 };
 
+/// Premultiplied colors of a multi-stop gradient, sampled at pipeline::kGradientLutSize evenly
+/// spaced t values, so the pipeline evaluates it with one table lookup per pixel instead of a
+/// search over the stop intervals. Built by Gradient::buildLut and shared by every gradient
+/// with the same stops; immutable once built.
+///
+/// Nearest-entry lookup moves t by at most half a table step, 1/2046 of the gradient's length.
+/// Tables are only built where that changes each component by at most one 8-bit level before
+/// premultiplying: no stop interval may change a component by more than its length times eight,
+/// e.g. a full black to white ramp must span at least 1/8 of the gradient. A hard stop, two stops
+/// at one offset, would move by up to half an entry with a full-intensity error, so gradients
+/// with one keep searching the stop intervals.
+struct GradientLut {
+  ColorSpace colorSpace = ColorSpace::Linear;  ///< Color space the stops were expanded in.
+  std::vector<GradientStop> stops;             ///< Stops the table was sampled from.
+  std::array<pipeline::GradientColor, pipeline::kGradientLutSize> colors;  ///< For highp.
+  /// For lowp, rounded to 0..255 before premultiplying, as the lowp stages do.
+  std::array<std::array<std::uint16_t, 4>, pipeline::kGradientLutSize> colorsU16;
+
+  /// Returns the bytes the table occupies, for a caller that bounds how many it keeps.
+  [[nodiscard]] std::size_t byteSize() const {
+    return sizeof(GradientLut) + stops.size() * sizeof(GradientStop);
+  }
+};
+
 /// @internal
 /// Base gradient data shared by all gradient types.
 class Gradient {
@@ -56,6 +83,19 @@ class Gradient {
 
   void applyOpacity(float opacity);
 
+  /// Samples this gradient's stops into a color table for \p cs. Returns nullptr for two-stop
+  /// gradients, which already interpolate with a single multiply-add, and for gradients the table
+  /// cannot resolve: a hard stop, or an interval steeper than GradientLut allows.
+  [[nodiscard]] std::shared_ptr<const GradientLut> buildLut(ColorSpace cs) const;
+
+  /// Makes pushStages evaluate colors from \p lut. The table is only used while its stops and
+  /// color space match what the pipeline would otherwise compute, so a table that no longer
+  /// matches, e.g. after applyOpacity, is ignored rather than misapplied.
+  void setLut(std::shared_ptr<const GradientLut> lut) { lut_ = std::move(lut); }
+
+  /// Returns the attached color table, if any.
+  [[nodiscard]] const std::shared_ptr<const GradientLut>& lut() const { return lut_; }
+
   /// Returns the color stops, in the order the pipeline stages read them.
   [[nodiscard]] std::span<const GradientStop> stops() const { return stops_; }
 
@@ -67,18 +107,22 @@ class Gradient {
   /// which is what lets a caller decide that a shader it built earlier still describes the
   /// paint it wants now. Floats compare with IEEE semantics: a stop or transform holding a NaN
   /// is never equal even to itself, so such a gradient is never reused, and positive and
-  /// negative zero compare equal, which the stages cannot distinguish either. An unequal
-  /// result is at worst a missed reuse.
+  /// negative zero compare equal, which the stages cannot distinguish either. Attached color
+  /// tables compare by identity. An unequal result is at worst a missed reuse.
   friend bool operator==(const Gradient&, const Gradient&) = default;
 
   Transform transform;
 
  private:
+  [[nodiscard]] pipeline::Context::GradientCtx makeGradientCtx(ColorSpace cs) const;
+  [[nodiscard]] bool lutMatches(ColorSpace cs) const;
+
   std::vector<GradientStop> stops_;
   SpreadMode tileMode_ = SpreadMode::Pad;
   Transform pointsToUnit_;
   bool colorsAreOpaque_ = true;
   bool hasUniformStops_ = true;
+  std::shared_ptr<const GradientLut> lut_;
 };
 
 }  // namespace tiny_skia
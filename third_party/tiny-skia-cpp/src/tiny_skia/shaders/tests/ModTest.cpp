@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 
 #include "tiny_skia/Color.h"
+#include "tiny_skia/Geom.h"
 #include "tiny_skia/Math.h"
+#include "tiny_skia/Paint.h"
+#include "tiny_skia/Painter.h"
+#include "tiny_skia/Pixmap.h"
 #include "tiny_skia/Point.h"
 #include "tiny_skia/pipeline/Pipeline.h"
 #include "tiny_skia/shaders/Shaders.h"
@@ -827,4 +833,120 @@ TEST(PatternTest, ShaderVariantDispatch) {
   tiny_skia::applyShaderOpacity(shader, 0.5f);
 }
 
+// ---------------------------------------------------------------------------
+// Gradient color tables
+// ---------------------------------------------------------------------------
+
+/// A translucent four-stop gradient, repeating across a 200px row.
+LinearGradient makeFourStopGradient() {
+  auto result = LinearGradient::create(
+      Point::fromXY(10, 0), Point::fromXY(110, 0),
+      {GradientStop::create(0.0f, Color::fromRgba8(255, 0, 0, 255)),
+       GradientStop::create(0.25f, Color::fromRgba8(20, 200, 90, 160)),
+       GradientStop::create(0.6f, Color::fromRgba8(0, 40, 255, 220)),
+       GradientStop::create(0.85f, Color::fromRgba8(250, 250, 0, 90))},
+      SpreadMode::Repeat, Transform::identity());
+  return std::get<LinearGradient>(*result);
+}
+
+tiny_skia::Pixmap renderGradient(const LinearGradient& gradient, bool forceHqPipeline,
+                                 std::uint32_t width = 200) {
+  auto pixmap = tiny_skia::Pixmap::fromSize(width, 4);
+  auto view = pixmap->mutableView();
+  tiny_skia::Paint paint;
+  paint.shader = gradient;
+  paint.forceHqPipeline = forceHqPipeline;
+  tiny_skia::Painter::fillRect(
+      view, *tiny_skia::Rect::fromLTRB(0, 0, static_cast<float>(width), 4), paint);
+  return std::move(*pixmap);
+}
+
+int maxChannelDifference(const tiny_skia::Pixmap& lhs, const tiny_skia::Pixmap& rhs) {
+  int result = 0;
+  for (std::size_t i = 0; i < lhs.data().size(); ++i) {
+    result = std::max(result, std::abs(static_cast<int>(lhs.data()[i]) - rhs.data()[i]));
+  }
+  return result;
+}
+
+TEST(GradientLutTest, OnlyBuiltForMultiStopGradients) {
+  const auto twoStop = LinearGradient::create(
+      Point::fromXY(0, 0), Point::fromXY(100, 0),
+      {GradientStop::create(0.0f, Color::white), GradientStop::create(1.0f, Color::black)},
+      SpreadMode::Pad, Transform::identity());
+  ASSERT_TRUE(twoStop.has_value());
+  EXPECT_EQ(std::get<LinearGradient>(*twoStop).base_.buildLut(ColorSpace::Linear), nullptr);
+
+  const auto lut = makeFourStopGradient().base_.buildLut(ColorSpace::Linear);
+  ASSERT_NE(lut, nullptr);
+  // The ends hold the first and last stop colors, premultiplied.
+  EXPECT_FLOAT_EQ(lut->colors.front().r, 1.0f);
+  EXPECT_FLOAT_EQ(lut->colors.back().a, 90.0f / 255.0f);
+  EXPECT_EQ(lut->colorsU16.front(), (std::array<std::uint16_t, 4>{255, 0, 0, 255}));
+  EXPECT_EQ(lut->colorsU16.back()[3], 90);
+}
+
+/// Table lookups stay close to searching the stop intervals in both pipelines. Lowp may differ by two: the color and the alpha can each round one level the
+/// other way before they are multiplied.
+TEST(GradientLutTest, LookupMatchesStopSearch) {
+  LinearGradient gradient = makeFourStopGradient();
+  const tiny_skia::Pixmap lowp = renderGradient(gradient, false);
+  const tiny_skia::Pixmap highp = renderGradient(gradient, true);
+
+  gradient.base_.setLut(gradient.base_.buildLut(ColorSpace::Linear));
+  tiny_skia::pipeline::RasterPipelineBuilder builder;
+  ASSERT_TRUE(gradient.pushStages(ColorSpace::Linear, builder));
+  EXPECT_EQ(builder.ctx().gradient.len, 0u);
+
+  EXPECT_LE(maxChannelDifference(lowp, renderGradient(gradient, false)), 2);
+  EXPECT_LE(maxChannelDifference(highp, renderGradient(gradient, true)), 1);
+}
+
+/// A hard stop would move by up to half a table entry, which on a 4000px gradient is two pixels at
+/// full intensity, and a steep interval would be off by more than a level. Neither gets a table.
+TEST(GradientLutTest, HardAndSteepStopsKeepTheStopSearch) {
+  const auto create = [](float secondOffset) {
+    auto result = LinearGradient::create(
+        Point::fromXY(0, 0), Point::fromXY(4000, 0),
+        {GradientStop::create(0.0f, Color::fromRgba8(255, 0, 0, 255)),
+         GradientStop::create(0.5f, Color::fromRgba8(255, 0, 0, 255)),
+         GradientStop::create(secondOffset, Color::fromRgba8(0, 0, 255, 255)),
+         GradientStop::create(1.0f, Color::fromRgba8(0, 0, 255, 255))},
+        SpreadMode::Pad, Transform::identity());
+    return std::get<LinearGradient>(*result);
+  };
+
+  for (const float secondOffset : {0.5f, 0.51f}) {
+    LinearGradient gradient = create(secondOffset);
+    const tiny_skia::Pixmap lowp = renderGradient(gradient, false, 4000);
+    const tiny_skia::Pixmap highp = renderGradient(gradient, true, 4000);
+
+    ASSERT_EQ(gradient.base_.buildLut(ColorSpace::Linear), nullptr);
+    gradient.base_.setLut(gradient.base_.buildLut(ColorSpace::Linear));
+    EXPECT_EQ(maxChannelDifference(lowp, renderGradient(gradient, false, 4000)), 0);
+    EXPECT_EQ(maxChannelDifference(highp, renderGradient(gradient, true, 4000)), 0);
+
+    // The edge sits exactly at the stop offset: the pixel centered just before 2000 is red.
+    EXPECT_EQ(lowp.data()[1999 * 4], 255);
+    EXPECT_EQ(lowp.data()[1999 * 4 + 2], 0);
+  }
+
+  // The same ramp spread over an eighth of the gradient is resolved by the table.
+  EXPECT_NE(create(0.625f).base_.buildLut(ColorSpace::Linear), nullptr);
+}
+
+TEST(GradientLutTest, StaleTableIsIgnored) {
+  LinearGradient gradient = makeFourStopGradient();
+  const auto lut = gradient.base_.buildLut(ColorSpace::Linear);
+  gradient.base_.applyOpacity(0.5f);
+  const tiny_skia::Pixmap expected = renderGradient(gradient, false);
+
+  gradient.base_.setLut(lut);
+  EXPECT_EQ(maxChannelDifference(expected, renderGradient(gradient, false)), 0);
+
+  // A table for another color space is ignored as well.
+  gradient.base_.setLut(gradient.base_.buildLut(ColorSpace::SimpleSRGB));
+  EXPECT_EQ(maxChannelDifference(expected, renderGradient(gradient, false)), 0);
+}
+
 }  // namespace
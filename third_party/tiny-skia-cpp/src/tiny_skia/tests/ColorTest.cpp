@@ -193,7 +193,7 @@ TEST(ColorTest, ColorSpaceTransforms) {
 TEST(ColorTest, PipelineStageOrderingMatchesRustReference) {
   using tiny_skia::pipeline::Stage;
 
-  constexpr std::array<Stage, 84> kExpectedOrder{Stage::MoveSourceToDestination,
+  constexpr std::array<Stage, 85> kExpectedOrder{Stage::MoveSourceToDestination,
                                                  Stage::MoveDestinationToSource,
                                                  Stage::Clamp0,
                                                  Stage::ClampA,
@@ -276,9 +276,10 @@ TEST(ColorTest, PipelineStageOrderingMatchesRustReference) {
                                                  Stage::PremultiplyDestination,
                                                  Stage::FusedLinearGradient2Stop,
                                                  Stage::FusedRadialGradient2Stop,
-                                                 Stage::FusedBilinearPattern};
+                                                 Stage::FusedBilinearPattern,
+                                                 Stage::GradientLut};
 
-  EXPECT_EQ(static_cast<std::size_t>(84), tiny_skia::pipeline::kStagesCount);
+  EXPECT_EQ(static_cast<std::size_t>(85), tiny_skia::pipeline::kStagesCount);
   EXPECT_EQ(tiny_skia::pipeline::kStagesCount, kExpectedOrder.size());
 
   for (std::size_t i = 0; i < kExpectedOrder.size(); ++i) {
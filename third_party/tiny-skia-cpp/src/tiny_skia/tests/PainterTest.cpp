@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 #include "tiny_skia/Color.h"
 #include "tiny_skia/Geom.h"
 #include "tiny_skia/Mask.h"
@@ -7,7 +10,9 @@
 #include "tiny_skia/Path.h"
 #include "tiny_skia/PathBuilder.h"
 #include "tiny_skia/Pixmap.h"
+#include "tiny_skia/pipeline/Blitter.h"
 #include "tiny_skia/pipeline/Pipeline.h"
+#include "tiny_skia/scan/PathAa.h"
 #include "tiny_skia/shaders/Shaders.h"
 
 namespace {
@@ -443,6 +448,78 @@ TEST(FillPathTest, WithTransform) {
   EXPECT_EQ(outer->red(), 0u);
 }
 
+// ---- Axis-aligned rect fast path ----
+
+/// Draws into a fresh \p width x \p height pixmap with an opaque paint, so every coverage value
+/// the scan converter produces lands in the pixels unchanged.
+template <typename DrawFn>
+Pixmap renderCoverage(std::uint32_t width, std::uint32_t height, DrawFn&& draw) {
+  auto pixmap = Pixmap::fromSize(width, height);
+  EXPECT_TRUE(pixmap.has_value());
+  auto mut = pixmap->mutableView();
+  auto subpix = mut.subpixmap();
+
+  Paint paint;
+  paint.setColor(Color::fromRgba8(20, 40, 200, 255));
+  auto blitter = tiny_skia::pipeline::RasterPipelineBlitter::create(paint, std::nullopt, &subpix);
+  EXPECT_TRUE(blitter.has_value());
+  draw(*blitter, pixmap->size().toScreenIntRect(0, 0), mut);
+  return std::move(*pixmap);
+}
+
+/// Random rects with fractional edges, including slivers thinner than a pixel and rects
+/// crossing the clip, against a small clip (unsnapped alpha) and a large one (snapped alpha).
+TEST(FillAxisAlignedRectTest, MatchesPathCoverageExactly) {
+  std::mt19937 rng(47);
+  for (const std::uint32_t size : {24u, 200u}) {
+    std::uniform_real_distribution<float> position(-4.0f, static_cast<float>(size) + 2.0f);
+    std::uniform_real_distribution<float> extent(0.05f, static_cast<float>(size) * 0.5f);
+    std::uniform_real_distribution<float> sliver(0.01f, 1.0f);
+    for (int i = 0; i < 400; ++i) {
+      const float left = position(rng);
+      const float top = position(rng);
+      const float width = (i % 5 == 0) ? sliver(rng) : extent(rng);
+      const float height = (i % 7 == 0) ? sliver(rng) : extent(rng);
+      const auto rect = Rect::fromXYWH(left, top, width, height);
+      ASSERT_TRUE(rect.has_value());
+
+      const Pixmap expected = renderCoverage(size, size, [&](auto& blitter, auto clip, auto&) {
+        tiny_skia::scan::path_aa::fillPath(Path::fromRect(*rect), FillRule::Winding, clip,
+                                           blitter);
+      });
+      const Pixmap actual = renderCoverage(size, size, [&](auto& blitter, auto clip, auto&) {
+        tiny_skia::scan::path_aa::fillRect(*rect, clip, blitter);
+      });
+      ASSERT_TRUE(std::ranges::equal(expected.data(), actual.data()))
+          << "size " << size << " rect " << left << "," << top << " " << width << "x" << height;
+    }
+  }
+}
+
+/// Rect-shaped paths reach the fast path from fillPath under any transform without skew,
+/// including flips, and must look exactly as they did through the general path.
+TEST(FillAxisAlignedRectTest, FillPathRoutesRectsWithoutChangingPixels) {
+  const auto rect = Rect::fromLTRB(2.3f, 1.7f, 19.6f, 11.2f);
+  ASSERT_TRUE(rect.has_value());
+  for (const Transform& transform :
+       {Transform::identity(), Transform::fromRow(1.5f, 0.0f, 0.0f, 2.25f, 3.1f, 0.4f),
+        Transform::fromRow(-1.0f, 0.0f, 0.0f, 1.0f, 40.2f, 5.5f)}) {
+    const auto devicePath = Path::fromRect(*rect).transform(transform);
+    ASSERT_TRUE(devicePath.has_value());
+
+    const Pixmap expected = renderCoverage(48, 32, [&](auto& blitter, auto clip, auto&) {
+      tiny_skia::scan::path_aa::fillPath(*devicePath, FillRule::Winding, clip, blitter);
+    });
+    const Pixmap actual = renderCoverage(48, 32, [&](auto&, auto, MutablePixmapView& view) {
+      Paint paint;
+      paint.setColor(Color::fromRgba8(20, 40, 200, 255));
+      tiny_skia::Painter::fillPath(view, Path::fromRect(*rect), paint, FillRule::Winding,
+                                   transform);
+    });
+    EXPECT_TRUE(std::ranges::equal(expected.data(), actual.data()));
+  }
+}
+
 // ---- drawPixmap integration test ----
 
 TEST(DrawPixmapTest, DrawOntoPixmapDoesNotCrash) {
@@ -0,0 +1,363 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "tiny_skia/Color.h"
+#include "tiny_skia/EdgeBuilder.h"
+#include "tiny_skia/Geom.h"
+#include "tiny_skia/Paint.h"
+#include "tiny_skia/Painter.h"
+#include "tiny_skia/Path.h"
+#include "tiny_skia/PathBuilder.h"
+#include "tiny_skia/Pixmap.h"
+#include "tiny_skia/pipeline/Blitter.h"
+#include "tiny_skia/scan/SparseStrips.h"
+
+namespace {
+
+using tiny_skia::Color;
+using tiny_skia::FillRule;
+using tiny_skia::MutablePixmapView;
+using tiny_skia::Paint;
+using tiny_skia::Path;
+using tiny_skia::PathBuilder;
+using tiny_skia::Pixmap;
+using tiny_skia::Rect;
+using tiny_skia::ScanBackend;
+using tiny_skia::Transform;
+
+namespace sparse_strips = tiny_skia::scan::sparse_strips;
+
+/// Scan converts with \p fill into a fresh \p width x \p height pixmap through an opaque white
+/// paint, so each pixel's alpha is the coverage the scan converter produced.
+template <typename FillFn>
+Pixmap renderCoverage(std::uint32_t width, std::uint32_t height, FillFn&& fill) {
+  auto pixmap = Pixmap::fromSize(width, height);
+  EXPECT_TRUE(pixmap.has_value());
+  auto mut = pixmap->mutableView();
+  auto subpix = mut.subpixmap();
+
+  Paint paint;
+  paint.setColor(Color::white);
+  auto blitter = tiny_skia::pipeline::RasterPipelineBlitter::create(paint, std::nullopt, &subpix);
+  EXPECT_TRUE(blitter.has_value());
+  fill(*blitter, pixmap->size().toScreenIntRect(0, 0));
+  return std::move(*pixmap);
+}
+
+Pixmap renderSparse(std::uint32_t width, std::uint32_t height, const Path& path,
+                    FillRule fillRule) {
+  return renderCoverage(width, height, [&](auto& blitter, auto clip) {
+    sparse_strips::fillPath(path, fillRule, clip, blitter);
+  });
+}
+
+/// Coverage of \p path computed independently of both scan converters: curves are split into
+/// 256 lines each, and every pixel row is cut into 64 sub-rows whose covered intervals come from
+/// the sorted crossings and the fill rule, so it measures distance from the true area rather than
+/// from another approximation. Returns alpha as 0..255 per pixel, row-major.
+std::vector<int> renderReference(int width, int height, const Path& path, FillRule fillRule) {
+  constexpr int kCurveSteps = 256;
+  constexpr int kSubRows = 64;
+  struct Segment {
+    float x0, y0, x1, y1;
+  };
+
+  std::vector<std::vector<Segment>> rows(static_cast<std::size_t>(height));
+  auto addSegment = [&](tiny_skia::Point a, tiny_skia::Point b) {
+    if (a.y == b.y) {
+      return;
+    }
+    const int first = std::max(0, static_cast<int>(std::floor(std::min(a.y, b.y))));
+    const int last = std::min(height - 1, static_cast<int>(std::floor(std::max(a.y, b.y))));
+    for (int y = first; y <= last; ++y) {
+      rows[static_cast<std::size_t>(y)].push_back({a.x, a.y, b.x, b.y});
+    }
+  };
+
+  auto iter = tiny_skia::pathIter(path);
+  while (const auto edge = iter.next()) {
+    const auto& p = edge->points;
+    if (edge->type == tiny_skia::PathEdgeType::LineTo) {
+      addSegment(p[0], p[1]);
+      continue;
+    }
+    tiny_skia::Point previous = p[0];
+    for (int i = 1; i <= kCurveSteps; ++i) {
+      const double t = static_cast<double>(i) / kCurveSteps;
+      const double u = 1.0 - t;
+      tiny_skia::Point point{};
+      if (edge->type == tiny_skia::PathEdgeType::QuadTo) {
+        point.x = static_cast<float>(u * u * p[0].x + 2 * u * t * p[1].x + t * t * p[2].x);
+        point.y = static_cast<float>(u * u * p[0].y + 2 * u * t * p[1].y + t * t * p[2].y);
+      } else {
+        point.x = static_cast<float>(u * u * u * p[0].x + 3 * u * u * t * p[1].x +
+                                     3 * u * t * t * p[2].x + t * t * t * p[3].x);
+        point.y = static_cast<float>(u * u * u * p[0].y + 3 * u * u * t * p[1].y +
+                                     3 * u * t * t * p[2].y + t * t * t * p[3].y);
+      }
+      addSegment(previous, point);
+      previous = point;
+    }
+  }
+
+  std::vector<double> area(static_cast<std::size_t>(width));
+  std::vector<int> alpha(static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+  std::vector<std::pair<double, int>> crossings;
+  for (int y = 0; y < height; ++y) {
+    std::fill(area.begin(), area.end(), 0.0);
+    for (int sub = 0; sub < kSubRows; ++sub) {
+      const double sampleY = y + (sub + 0.5) / kSubRows;
+      crossings.clear();
+      for (const Segment& s : rows[static_cast<std::size_t>(y)]) {
+        if ((sampleY >= s.y0) == (sampleY >= s.y1)) {
+          continue;
+        }
+        const double t = (sampleY - s.y0) / (static_cast<double>(s.y1) - s.y0);
+        crossings.emplace_back(s.x0 + t * (static_cast<double>(s.x1) - s.x0), s.y1 > s.y0 ? 1 : -1);
+      }
+      std::sort(crossings.begin(), crossings.end());
+
+      int winding = 0;
+      for (std::size_t i = 0; i + 1 < crossings.size(); ++i) {
+        winding += crossings[i].second;
+        const bool inside = fillRule == FillRule::Winding ? winding != 0 : (winding & 1) != 0;
+        const double lo = std::clamp(crossings[i].first, 0.0, static_cast<double>(width));
+        const double hi = std::clamp(crossings[i + 1].first, 0.0, static_cast<double>(width));
+        if (!inside || lo >= hi) {
+          continue;
+        }
+        for (int x = static_cast<int>(lo); x < width && x < hi; ++x) {
+          area[static_cast<std::size_t>(x)] +=
+              std::min(hi, x + 1.0) - std::max(lo, static_cast<double>(x));
+        }
+      }
+    }
+    for (int x = 0; x < width; ++x) {
+      alpha[static_cast<std::size_t>(y) * width + x] =
+          static_cast<int>(area[static_cast<std::size_t>(x)] / kSubRows * 255.0 + 0.5);
+    }
+  }
+  return alpha;
+}
+
+int alphaAt(const Pixmap& pixmap, std::uint32_t x, std::uint32_t y) {
+  return pixmap.data()[(static_cast<std::size_t>(y) * pixmap.width() + x) * 4 + 3];
+}
+
+int maxDifferenceFromReference(const Pixmap& pixmap, const std::vector<int>& reference) {
+  int result = 0;
+  for (std::size_t i = 0; i < reference.size(); ++i) {
+    result = std::max(result, std::abs(static_cast<int>(pixmap.data()[i * 4 + 3]) - reference[i]));
+  }
+  return result;
+}
+
+/// A closed outline of cubics around (\p cx, \p cy) whose radius wobbles, so it has concave
+/// stretches, nearly horizontal and vertical tangents, and corners, without crossing itself.
+Path makeBlob(std::mt19937& rng, float cx, float cy, float radius, int lobes) {
+  std::uniform_real_distribution<float> wobble(0.75f, 1.1f);
+  PathBuilder pb;
+  const float step = 6.2831853f / static_cast<float>(lobes);
+  auto pointAt = [&](float angle, float r) {
+    return std::pair{cx + r * std::cos(angle), cy + r * std::sin(angle)};
+  };
+  const auto [sx, sy] = pointAt(0.0f, radius);
+  pb.moveTo(sx, sy);
+  for (int i = 0; i < lobes; ++i) {
+    const float a0 = step * static_cast<float>(i);
+    const auto [c1x, c1y] = pointAt(a0 + step / 3.0f, radius * wobble(rng));
+    const auto [c2x, c2y] = pointAt(a0 + 2.0f * step / 3.0f, radius * wobble(rng));
+    const auto [ex, ey] = pointAt(a0 + step, i + 1 == lobes ? radius : radius * wobble(rng));
+    pb.cubicTo(c1x, c1y, c2x, c2y, ex, ey);
+  }
+  pb.close();
+  return *pb.finish();
+}
+
+/// A five-pointed star, whose center is wound twice.
+Path makeStar(float cx, float cy, float radius) {
+  PathBuilder pb;
+  for (int i = 0; i < 5; ++i) {
+    const float angle = -1.5707963f + static_cast<float>(i * 2) * 6.2831853f / 5.0f;
+    const float x = cx + radius * std::cos(angle);
+    const float y = cy + radius * std::sin(angle);
+    if (i == 0) {
+      pb.moveTo(x, y);
+    } else {
+      pb.lineTo(x, y);
+    }
+  }
+  pb.close();
+  return *pb.finish();
+}
+
+}  // namespace
+
+TEST(SparseStripsTest, PixelAlignedRectIsExact) {
+  const auto rect = Rect::fromLTRB(2.0f, 3.0f, 13.0f, 9.0f);
+  ASSERT_TRUE(rect.has_value());
+  const Pixmap pixmap = renderSparse(16, 12, Path::fromRect(*rect), FillRule::Winding);
+
+  for (std::uint32_t y = 0; y < 12; ++y) {
+    for (std::uint32_t x = 0; x < 16; ++x) {
+      const bool inside = x >= 2 && x < 13 && y >= 3 && y < 9;
+      EXPECT_EQ(alphaAt(pixmap, x, y), inside ? 255 : 0) << x << "," << y;
+    }
+  }
+}
+
+TEST(SparseStripsTest, CoverageIsPixelArea) {
+  // Edges through pixel centers cover half of each edge pixel and a quarter of each corner.
+  const auto rect = Rect::fromLTRB(2.5f, 1.5f, 9.5f, 6.5f);
+  ASSERT_TRUE(rect.has_value());
+  const Pixmap pixmap = renderSparse(12, 8, Path::fromRect(*rect), FillRule::Winding);
+
+  EXPECT_EQ(alphaAt(pixmap, 5, 3), 255);
+  EXPECT_EQ(alphaAt(pixmap, 2, 3), 128);
+  EXPECT_EQ(alphaAt(pixmap, 9, 3), 128);
+  EXPECT_EQ(alphaAt(pixmap, 5, 1), 128);
+  EXPECT_EQ(alphaAt(pixmap, 5, 6), 128);
+  EXPECT_EQ(alphaAt(pixmap, 2, 1), 64);
+  EXPECT_EQ(alphaAt(pixmap, 9, 6), 64);
+  EXPECT_EQ(alphaAt(pixmap, 1, 3), 0);
+  EXPECT_EQ(alphaAt(pixmap, 10, 3), 0);
+
+  // A triangle over exactly half of a 4x4 block.
+  PathBuilder pb;
+  pb.moveTo(4.0f, 0.0f);
+  pb.lineTo(8.0f, 4.0f);
+  pb.lineTo(4.0f, 4.0f);
+  pb.close();
+  const Pixmap triangle = renderSparse(12, 8, *pb.finish(), FillRule::Winding);
+  int total = 0;
+  for (std::uint32_t y = 0; y < 4; ++y) {
+    for (std::uint32_t x = 4; x < 8; ++x) {
+      total += alphaAt(triangle, x, y);
+    }
+    // Pixels the diagonal passes through are exactly half covered.
+    EXPECT_EQ(alphaAt(triangle, 4 + y, y), 128);
+  }
+  EXPECT_NEAR(total, 8 * 255, 4);
+}
+
+TEST(SparseStripsTest, FillRules) {
+  const Path star = makeStar(20.0f, 20.0f, 18.0f);
+  const Pixmap winding = renderSparse(40, 40, star, FillRule::Winding);
+  const Pixmap evenOdd = renderSparse(40, 40, star, FillRule::EvenOdd);
+
+  EXPECT_EQ(alphaAt(winding, 20, 20), 255);
+  EXPECT_EQ(alphaAt(evenOdd, 20, 20), 0);
+  // A point of the star is wound once under either rule.
+  EXPECT_EQ(alphaAt(winding, 20, 5), 255);
+  EXPECT_EQ(alphaAt(evenOdd, 20, 5), 255);
+}
+
+/// Contours that overlap put windings 0 and 2 into the same edge pixels. The fill rule has to
+/// see those windings, not their average, or nonzero doubles the edge coverage and even-odd
+/// fills the edges of a shape that cancels itself out.
+TEST(SparseStripsTest, FillRuleSeesWindingOfOverlappingContours) {
+  const auto rect = Rect::fromLTRB(2.5f, 1.3f, 9.7f, 6.5f);
+  ASSERT_TRUE(rect.has_value());
+  const Path single = Path::fromRect(*rect);
+  PathBuilder pb;
+  pb.pushRect(*rect);
+  pb.pushRect(*rect);
+  const Path doubled = *pb.finish();
+
+  const Pixmap expected = renderSparse(12, 8, single, FillRule::Winding);
+  EXPECT_TRUE(std::ranges::equal(renderSparse(12, 8, doubled, FillRule::Winding).data(),
+                                 expected.data()));
+  EXPECT_TRUE(std::ranges::all_of(renderSparse(12, 8, doubled, FillRule::EvenOdd).data(),
+                                  [](std::uint8_t value) { return value == 0; }));
+
+  // A blob drawn over itself shifted by a fraction of a pixel: wound twice where the copies
+  // overlap, once in the crescents between their edges.
+  std::mt19937 rng(4800);
+  const Path blob = makeBlob(rng, 40.0f, 40.0f, 30.0f, 7);
+  PathBuilder overlapBuilder;
+  overlapBuilder.pushPath(blob);
+  overlapBuilder.pushPath(*blob.transform(Transform::fromTranslate(0.4f, 0.3f)));
+  const Path overlap = *overlapBuilder.finish();
+  for (const FillRule fillRule : {FillRule::Winding, FillRule::EvenOdd}) {
+    EXPECT_LE(maxDifferenceFromReference(renderSparse(80, 80, overlap, fillRule),
+                                         renderReference(80, 80, overlap, fillRule)),
+              sparse_strips::kMaxCoverageDifference)
+        << (fillRule == FillRule::Winding ? "nonzero" : "even-odd");
+  }
+}
+
+/// Paths crossing every side of the clip, including ones that wrap around it, must fill the
+/// visible part as if the clip were not there.
+TEST(SparseStripsTest, ClipMatchesLargerSurface) {
+  std::mt19937 rng(48);
+  for (int i = 0; i < 40; ++i) {
+    const Path blob = makeBlob(rng, 30.0f, 26.0f, 28.0f + static_cast<float>(i), 7);
+    const auto shifted = blob.transform(Transform::fromTranslate(40.0f, 40.0f));
+    ASSERT_TRUE(shifted.has_value());
+
+    const Pixmap clipped = renderSparse(61, 53, blob, FillRule::Winding);
+    const Pixmap large = renderSparse(160, 160, *shifted, FillRule::Winding);
+    for (std::uint32_t y = 0; y < 53; ++y) {
+      for (std::uint32_t x = 0; x < 61; ++x) {
+        ASSERT_NEAR(alphaAt(clipped, x, y), alphaAt(large, x + 40, y + 40), 1)
+            << "blob " << i << " at " << x << "," << y;
+      }
+    }
+  }
+}
+
+/// The documented bound on the difference from the true area, over curved and clipped paths,
+/// alone and overlapping a shifted copy of themselves, under both fill rules.
+TEST(SparseStripsTest, StaysWithinBoundOfTrueArea) {
+  std::mt19937 rng(4848);
+  std::uniform_real_distribution<float> center(-10.0f, 110.0f);
+  std::uniform_real_distribution<float> radius(0.5f, 60.0f);
+  std::uniform_real_distribution<float> shift(-3.0f, 3.0f);
+  for (int i = 0; i < 200; ++i) {
+    const Path blob = makeBlob(rng, center(rng), center(rng), radius(rng), 3 + i % 9);
+    PathBuilder pb;
+    pb.pushPath(blob);
+    if (i % 2 == 1) {
+      pb.pushPath(*blob.transform(Transform::fromTranslate(shift(rng), shift(rng))));
+    }
+    const Path path = *pb.finish();
+    for (const FillRule fillRule : {FillRule::Winding, FillRule::EvenOdd}) {
+      const int difference = maxDifferenceFromReference(renderSparse(100, 100, path, fillRule),
+                                                        renderReference(100, 100, path, fillRule));
+      ASSERT_LE(difference, sparse_strips::kMaxCoverageDifference) << "path " << i;
+    }
+  }
+}
+
+TEST(SparseStripsTest, PainterUsesPaintScanBackend) {
+  std::mt19937 rng(480);
+  const Path blob = makeBlob(rng, 32.0f, 32.0f, 24.0f, 6);
+
+  const Pixmap expected = renderSparse(64, 64, blob, FillRule::Winding);
+  auto actual = Pixmap::fromSize(64, 64);
+  ASSERT_TRUE(actual.has_value());
+  auto mut = actual->mutableView();
+  Paint paint;
+  paint.setColor(Color::white);
+  paint.scanBackend = ScanBackend::SparseStrips;
+  tiny_skia::Painter::fillPath(mut, blob, paint, FillRule::Winding, Transform::identity());
+  EXPECT_TRUE(std::ranges::equal(expected.data(), actual->data()));
+
+  // Rect-shaped paths skip the analytic-only rect fast path, so they use the selected
+  // backend as well.
+  const auto rect = Rect::fromLTRB(3.3f, 4.6f, 50.2f, 40.7f);
+  ASSERT_TRUE(rect.has_value());
+  const Pixmap expectedRect = renderSparse(64, 64, Path::fromRect(*rect), FillRule::Winding);
+  actual->fill(Color::transparent);
+  auto rectMut = actual->mutableView();
+  tiny_skia::Painter::fillPath(rectMut, Path::fromRect(*rect), paint, FillRule::Winding,
+                               Transform::identity());
+  EXPECT_TRUE(std::ranges::equal(expectedRect.data(), actual->data()));
+}
@@ -644,12 +644,14 @@ void BM_FilterGraph_SevenPrimitives_LinearRGB(benchmark::State& state) {
   const Pixmap src = makeRandomPixmap(size, size);
   const tiny_skia::filter::FilterGraph graph = makeSevenPrimitiveStack(/*linearRGB=*/true);
 
+  tiny_skia::filter::FilterGraphStats stats;
   for (auto _ : state) {
     Pixmap copy = src;
-    benchmark::DoNotOptimize(tiny_skia::filter::executeFilterGraph(copy, graph));
+    benchmark::DoNotOptimize(tiny_skia::filter::executeFilterGraph(copy, graph, &stats));
     benchmark::DoNotOptimize(copy.data().data());
   }
   setCounters(state, size);
+  state.counters["allocatedBuffers"] = static_cast<double>(stats.allocatedBuffers);
 }
 
 void BM_FilterGraph_SevenPrimitives_Srgb(benchmark::State& state) {
@@ -657,12 +659,125 @@ void BM_FilterGraph_SevenPrimitives_Srgb(benchmark::State& state) {
   const Pixmap src = makeRandomPixmap(size, size);
   const tiny_skia::filter::FilterGraph graph = makeSevenPrimitiveStack(/*linearRGB=*/false);
 
+  tiny_skia::filter::FilterGraphStats stats;
   for (auto _ : state) {
     Pixmap copy = src;
-    benchmark::DoNotOptimize(tiny_skia::filter::executeFilterGraph(copy, graph));
+    benchmark::DoNotOptimize(tiny_skia::filter::executeFilterGraph(copy, graph, &stats));
     benchmark::DoNotOptimize(copy.data().data());
   }
   setCounters(state, size);
+  state.counters["allocatedBuffers"] = static_cast<double>(stats.allocatedBuffers);
+}
+
+// ---------------------------------------------------------------------------
+// Graph compilation benchmarks
+// ---------------------------------------------------------------------------
+//
+// Graphs shaped to exercise the executor's compilation step: a chain of per-pixel primitives that
+// runs as one fused pass, the flood-and-cut shape of a hand-written shadow, and a graph whose
+// first result is never read. `allocatedBuffers` reports how many float buffers one execution
+// allocated for node results, which bounds the graph's peak float-buffer residency.
+
+/// Builds a graph node reading the previous result, in linearRGB.
+tiny_skia::filter::GraphNode makeLinearNode(tiny_skia::filter::GraphPrimitive primitive) {
+  tiny_skia::filter::GraphNode node;
+  node.primitive = std::move(primitive);
+  node.inputs = {tiny_skia::filter::NodeInput()};
+  node.useLinearRGB = true;
+  return node;
+}
+
+/// feColorMatrix -> feComponentTransfer -> feComposite(over SourceGraphic).
+tiny_skia::filter::FilterGraph makePointwiseChain() {
+  using tiny_skia::filter::NodeInput;
+  using tiny_skia::filter::StandardInput;
+  namespace primitives = tiny_skia::filter::graph_primitive;
+
+  primitives::ComponentTransfer transfer;
+  transfer.funcR.type = tiny_skia::filter::TransferFuncType::Linear;
+  transfer.funcR.slope = 0.9;
+  transfer.funcR.intercept = 0.05;
+  transfer.funcA.type = tiny_skia::filter::TransferFuncType::Gamma;
+  transfer.funcA.amplitude = 1.0;
+  transfer.funcA.exponent = 0.8;
+
+  tiny_skia::filter::GraphNode composite =
+      makeLinearNode(primitives::Composite{tiny_skia::filter::CompositeOp::Over});
+  composite.inputs = {NodeInput(), NodeInput(StandardInput::SourceGraphic)};
+
+  tiny_skia::filter::FilterGraph graph;
+  graph.nodes.push_back(
+      makeLinearNode(primitives::ColorMatrix{tiny_skia::filter::saturateMatrix(1.6)}));
+  graph.nodes.push_back(makeLinearNode(std::move(transfer)));
+  graph.nodes.push_back(std::move(composite));
+  return graph;
+}
+
+/// feFlood -> feComposite(in SourceAlpha) -> feMerge(with SourceGraphic).
+tiny_skia::filter::FilterGraph makeFloodCompositeMerge() {
+  using tiny_skia::filter::NodeInput;
+  using tiny_skia::filter::StandardInput;
+  namespace primitives = tiny_skia::filter::graph_primitive;
+
+  tiny_skia::filter::GraphNode composite =
+      makeLinearNode(primitives::Composite{tiny_skia::filter::CompositeOp::In});
+  composite.inputs = {NodeInput(), NodeInput(StandardInput::SourceAlpha)};
+
+  tiny_skia::filter::GraphNode merge = makeLinearNode(primitives::Merge{});
+  merge.inputs = {NodeInput(), NodeInput(StandardInput::SourceGraphic)};
+
+  tiny_skia::filter::FilterGraph graph;
+  graph.nodes.push_back(makeLinearNode(primitives::Flood{40, 20, 10, 128}));
+  graph.nodes.push_back(std::move(composite));
+  graph.nodes.push_back(std::move(merge));
+  return graph;
+}
+
+/// A blur whose `result` nothing reads, followed by a color matrix on SourceGraphic.
+tiny_skia::filter::FilterGraph makeUnusedResult() {
+  using tiny_skia::filter::NodeInput;
+  using tiny_skia::filter::StandardInput;
+  namespace primitives = tiny_skia::filter::graph_primitive;
+
+  tiny_skia::filter::GraphNode blur =
+      makeLinearNode(primitives::GaussianBlur{4.0, 4.0, BlurEdgeMode::None});
+  blur.result = "unused";
+
+  tiny_skia::filter::GraphNode matrix =
+      makeLinearNode(primitives::ColorMatrix{tiny_skia::filter::hueRotateMatrix(90.0)});
+  matrix.inputs = {NodeInput(StandardInput::SourceGraphic)};
+
+  tiny_skia::filter::FilterGraph graph;
+  graph.nodes.push_back(std::move(blur));
+  graph.nodes.push_back(std::move(matrix));
+  return graph;
+}
+
+/// Runs \p graph over a random \p size square source on every iteration.
+void runFilterGraph(benchmark::State& state, const tiny_skia::filter::FilterGraph& graph) {
+  const auto size = static_cast<std::uint32_t>(state.range(0));
+  const Pixmap src = makeRandomPixmap(size, size);
+
+  tiny_skia::filter::FilterGraphStats stats;
+  for (auto _ : state) {
+    Pixmap copy = src;
+    benchmark::DoNotOptimize(tiny_skia::filter::executeFilterGraph(copy, graph, &stats));
+    benchmark::DoNotOptimize(copy.data().data());
+  }
+  setCounters(state, size);
+  state.counters["allocatedBuffers"] = static_cast<double>(stats.allocatedBuffers);
+}
+
+void BM_FilterGraph_PointwiseChain(benchmark::State& state) {
+  runFilterGraph(state, makePointwiseChain());
+}
+
+void BM_FilterGraph_FloodCompositeMerge(benchmark::State& state) {
+  runFilterGraph(state, makeFloodCompositeMerge());
+}
+
+void BM_FilterGraph_UnusedResult(benchmark::State& state) {
+  runFilterGraph(state, makeUnusedResult());
 }
 
 BENCHMARK(BM_GaussianBlur_Float)->Args({512, 3})->Args({512, 6})->Args({512, 20})->Args({1024, 6});
@@ -727,4 +842,9 @@ BENCHMARK(BM_Tile_Uint8)->Arg(512);
 BENCHMARK(BM_FilterGraph_SevenPrimitives_LinearRGB)->Arg(512);
 BENCHMARK(BM_FilterGraph_SevenPrimitives_Srgb)->Arg(512);
 
+// Whole graph, shaped for dead-node elimination, pointwise fusion, and buffer reuse.
+BENCHMARK(BM_FilterGraph_PointwiseChain)->Arg(512);
+BENCHMARK(BM_FilterGraph_FloodCompositeMerge)->Arg(512);
+BENCHMARK(BM_FilterGraph_UnusedResult)->Arg(512);
+
 }  // namespace
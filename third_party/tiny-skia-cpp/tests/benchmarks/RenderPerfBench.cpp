@@ -3,6 +3,7 @@
 #include <array>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 #include "tiny_skia/Color.h"
 #include "tiny_skia/Geom.h"
@@ -13,6 +14,8 @@
 #include "tiny_skia/Point.h"
 #include "tiny_skia/SpanCapture.h"
 #include "tiny_skia/Stroke.h"
+#include "tiny_skia/pipeline/Blitter.h"
+#include "tiny_skia/scan/PathAa.h"
 #include "tiny_skia/shaders/Gradient.h"
 #include "tiny_skia/shaders/LinearGradient.h"
 #include "tiny_skia/wide/backend/BackendConfig.h"
@@ -549,6 +552,106 @@ void BM_FillPath_Replay_Cpp(benchmark::State& state) {
   recordThroughput(state, state.range(0));
 }
 
+/// A dashboard-like scene: kManyRectCount small rects with fractional edges, laid out on a
+/// grid across the pixmap so most of them overlap a neighbour by a partial pixel.
+constexpr std::int64_t kManyRectCount = 100000;
+
+std::vector<Rect> createManyRects(float d) {
+  std::vector<Rect> rects;
+  rects.reserve(static_cast<std::size_t>(kManyRectCount));
+  const float cell = d / 316.0f;
+  for (std::int64_t i = 0; i < kManyRectCount; ++i) {
+    const auto col = static_cast<float>(i % 316);
+    const auto row = static_cast<float>(i / 316);
+    const float jitter = 0.13f * static_cast<float>(i % 7);
+    if (auto rect = Rect::fromXYWH(col * cell + jitter, row * cell + jitter,
+                                   cell * (1.2f + 0.35f * static_cast<float>(i % 5)),
+                                   cell * (0.9f + 0.25f * static_cast<float>(i % 3)))) {
+      rects.push_back(*rect);
+    }
+  }
+  return rects;
+}
+
+/// Records `rects` per iteration as fills per second.
+void recordFills(benchmark::State& state, std::size_t rects) {
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rects));
+  state.counters["fillsPerSecond"] = benchmark::Counter(
+      static_cast<double>(rects), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/// The 100k-rect scene through the general analytic path scan converter, which is what every
+/// rect took before fillPath recognized rectangles. Paths are built once, outside the loop,
+/// as a renderer with cached outlines would.
+void BM_FillManyRects_PathScan_Cpp(benchmark::State& state) {
+  const auto dim = static_cast<std::uint32_t>(state.range(0));
+  auto pixmap = Pixmap::fromSize(dim, dim);
+  if (!pixmap.has_value()) {
+    state.SkipWithError("Failed to allocate C++ pixmap");
+    return;
+  }
+
+  std::vector<Path> paths;
+  for (const Rect& rect : createManyRects(static_cast<float>(dim))) {
+    paths.push_back(Path::fromRect(rect));
+  }
+
+  const Paint paint = createPaint();
+  const Color clearColor = Color::fromRgba8(0, 0, 0, 0);
+
+  for (auto _ : state) {
+    pixmap->fill(clearColor);
+    auto mut = pixmap->mutableView();
+    const auto clip = pixmap->size().toScreenIntRect(0, 0);
+    for (const Path& path : paths) {
+      // One blitter per fill, as Painter::fillPath creates.
+      auto subpix = mut.subpixmap();
+      auto blitter =
+          tiny_skia::pipeline::RasterPipelineBlitter::create(paint, std::nullopt, &subpix);
+      if (!blitter.has_value()) {
+        state.SkipWithError("Failed to create blitter");
+        return;
+      }
+      tiny_skia::scan::path_aa::fillPath(path, FillRule::Winding, clip, *blitter);
+    }
+    benchmark::DoNotOptimize(pixmap->data().data());
+    benchmark::ClobberMemory();
+  }
+
+  recordFills(state, paths.size());
+}
+
+/// The same scene through Painter::fillPath, which now sends rect-shaped paths to the
+/// axis-aligned rect coverage generator. Pixels are identical to BM_FillManyRects_PathScan_Cpp.
+void BM_FillManyRects_Cpp(benchmark::State& state) {
+  const auto dim = static_cast<std::uint32_t>(state.range(0));
+  auto pixmap = Pixmap::fromSize(dim, dim);
+  if (!pixmap.has_value()) {
+    state.SkipWithError("Failed to allocate C++ pixmap");
+    return;
+  }
+
+  std::vector<Path> paths;
+  for (const Rect& rect : createManyRects(static_cast<float>(dim))) {
+    paths.push_back(Path::fromRect(rect));
+  }
+
+  const Paint paint = createPaint();
+  const Color clearColor = Color::fromRgba8(0, 0, 0, 0);
+
+  for (auto _ : state) {
+    pixmap->fill(clearColor);
+    auto mut = pixmap->mutableView();
+    for (const Path& path : paths) {
+      tiny_skia::Painter::fillPath(mut, path, paint, FillRule::Winding, Transform::identity());
+    }
+    benchmark::DoNotOptimize(pixmap->data().data());
+    benchmark::ClobberMemory();
+  }
+
+  recordFills(state, paths.size());
+}
+
 [[maybe_unused]] const bool kBenchmarkContextInitialized = []() {
 #if defined(TINYSKIA_CFG_IF_SIMD_NATIVE)
   benchmark::AddCustomContext("simdMode", "native");
@@ -570,5 +673,7 @@ BENCHMARK(BM_FillPath_LinearGradient_Cpp)->Arg(kSceneSize);
 BENCHMARK(BM_FillPath_Opaque_Cpp)->Arg(kSceneSize);
 BENCHMARK(BM_FillPath_Capture_Cpp)->Arg(kSceneSize);
 BENCHMARK(BM_FillPath_Replay_Cpp)->Arg(kSceneSize);
+BENCHMARK(BM_FillManyRects_PathScan_Cpp)->Arg(kSceneSize)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FillManyRects_Cpp)->Arg(kSceneSize)->Unit(benchmark::kMillisecond);
 
 }  // namespace